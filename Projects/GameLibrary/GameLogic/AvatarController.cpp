@@ -151,4 +151,5 @@ void GameLibrary::ControlAvatarTask::DefineContract( Helium::TaskContract &rCont
 {
 	rContract.ExecuteAfter<GameLibrary::ApplyPlayerInputToAvatarTask>();
 	rContract.ExecuteBefore<Helium::StandardDependencies::ProcessPhysics>();
+	rContract.ExecuteOnMainThread();
 }
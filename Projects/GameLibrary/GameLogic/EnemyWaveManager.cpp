@@ -156,6 +156,12 @@ void EnemyWaveManager::SpawnWave( EnemyWaveDefinition *pWave, ParameterSet_Actio
 	WaveState *pWaveState = m_ActiveWaves.New();
 	pWaveState->m_Entities.Reserve(pParameters->m_Count);
 
+	// Build every entity's parameters first so the whole wave can be spawned in one batch
+	DynamicArray< ParameterSetPtr > parameterSets;
+	DynamicArray< ParameterSet * > parameterSetPointers;
+	parameterSets.Reserve(pParameters->m_Count);
+	parameterSetPointers.Reserve(pParameters->m_Count);
+
 	for (int i = 0; i < pParameters->m_Count; ++i)
 	{
 		HELIUM_ASSERT(pWave->m_Formation);
@@ -170,11 +176,38 @@ void EnemyWaveManager::SpawnWave( EnemyWaveDefinition *pWave, ParameterSet_Actio
 		ParameterSet_InitLocated *pInitLocated = builder.AddParameterSet<ParameterSet_InitLocated>();
 		pInitLocated->m_Position = location;
 
-		HELIUM_ASSERT( pWave->m_Entity );
-		Entity *pEntity = m_pWorld->GetRootSlice()->CreateEntity(pWave->m_Entity, builder.GetSet());
+		parameterSets.Push( builder.GetSet() );
+		parameterSetPointers.Push( builder.GetSet() );
+	}
+
+	DynamicArray< Entity * > entities;
+	entities.Resize( parameterSetPointers.GetSize() );
+
+	HELIUM_ASSERT( pWave->m_Entity );
+	size_t entityCount = m_pWorld->GetRootSlice()->CreateEntities(
+		pWave->m_Entity, parameterSetPointers.GetSize(), parameterSetPointers.GetData(), entities.GetData() );
+
+	// CreateEntities() trims the batch when the component pools are full
+	if (entityCount < parameterSetPointers.GetSize())
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"EnemyWaveManager::SpawnWave - Only %" PRIuSZ " of %" PRIuSZ " enemies in the wave could be spawned.\n",
+			entityCount,
+			parameterSetPointers.GetSize());
+
+		if (!entityCount)
+		{
+			// Don't track an empty wave, GetPercentAlive() divides by its entity count
+			m_ActiveWaves.Pop();
+			return;
+		}
+	}
 
+	for (size_t i = 0; i < entityCount; ++i)
+	{
 		WaveEntityState *pEntityState = pWaveState->m_Entities.New();
-		pEntityState->m_Entity = pEntity;
+		pEntityState->m_Entity = entities[i];
 	}
 }
 
@@ -240,6 +273,7 @@ void DoUpdateEnemyWaveManager( EnemyWaveManagerComponent *c )
 void TaskUpdateEnemyWaveManager::DefineContract( TaskContract &rContract )
 {
 	rContract.ExecutesWithin<StandardDependencies::PostPhysicsGameplay>();
+	rContract.ExecuteOnMainThread();
 }
 
 HELIUM_DEFINE_TASK( TaskUpdateEnemyWaveManager, (ForEachWorld< QueryComponents< EnemyWaveManagerComponent, DoUpdateEnemyWaveManager > >), TickTypes::Gameplay );
\ No newline at end of file
@@ -128,4 +128,5 @@ void GameLibrary::GatherInputForPlayers::DefineContract( Helium::TaskContract &r
 {
 	rContract.ExecuteAfter<Helium::StandardDependencies::ReceiveInput>();
 	rContract.ExecuteBefore<Helium::StandardDependencies::ProcessPhysics>();
+	rContract.ExecuteOnMainThread();
 }
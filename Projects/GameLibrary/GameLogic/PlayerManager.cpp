@@ -64,4 +64,5 @@ HELIUM_DEFINE_TASK(PlayerManagerTick, ( ForEachWorld< TickPlayers > ), TickTypes
 void PlayerManagerTick::DefineContract( TaskContract &rContract )
 {
 	rContract.ExecuteBefore<Helium::StandardDependencies::ReceiveInput>();
+	rContract.ExecuteOnMainThread();
 }
\ No newline at end of file
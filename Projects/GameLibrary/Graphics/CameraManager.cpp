@@ -298,4 +298,5 @@ void CameraManagerTick::DefineContract( TaskContract &rContract )
 {
 	rContract.ExecutesWithin<Helium::StandardDependencies::Render>();
 	rContract.ExecuteBefore<Helium::GraphicsManagerDrawTask>();
+	rContract.ExecuteOnMainThread();
 }
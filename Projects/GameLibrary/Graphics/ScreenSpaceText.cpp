@@ -87,4 +87,5 @@ HELIUM_DEFINE_TASK( DrawScreenSpaceTextTask, (ForEachWorld< DrawScreenSpaceText
 void GameLibrary::DrawScreenSpaceTextTask::DefineContract( Helium::TaskContract &rContract )
 {
 	rContract.ExecutesWithin<Helium::StandardDependencies::Render>();
+	rContract.ExecuteOnMainThread();
 }
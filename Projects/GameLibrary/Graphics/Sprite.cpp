@@ -82,7 +82,7 @@ void GameLibrary::SpriteComponent::Render( Helium::BufferedDrawer &rBufferedDraw
 	Helium::Simd::Matrix44 composite =
 		scaling * matrix;
 
-	rBufferedDrawer.DrawTexturedQuad(
+	rBufferedDrawer.DrawSprite(
 		m_Texture->GetRenderResource2d(),
 		composite,
 		m_UvTopLeft,
@@ -182,4 +182,5 @@ HELIUM_DEFINE_TASK( DrawSpritesTask, (ForEachWorld< DrawSprites >), TickTypes::R
 void GameLibrary::DrawSpritesTask::DefineContract( Helium::TaskContract &rContract )
 {
 	rContract.ExecutesWithin<Helium::StandardDependencies::Render>();
+	rContract.ExecuteOnMainThread();
 }
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------------------------------------------------
 
 //! @sysselect_v SKINNING NONE SKINNING_SMOOTH SKINNING_RIGID
+//! @systoggle_v INSTANCING
 
 #include "Common.inl"
 
@@ -20,6 +21,11 @@ struct VertexInput
 #endif
 	float4 blendIndices : BLENDINDICES;
 #endif
+#if INSTANCING
+	float4 instanceTransform0 : TEXCOORD4;
+	float4 instanceTransform1 : TEXCOORD5;
+	float4 instanceTransform2 : TEXCOORD6;
+#endif
 };
 
 cbuffer ViewGlobalData
@@ -46,6 +52,9 @@ float4 main( VertexInput vIn ) : POSITION
 #endif
 
 	matrix worldMatrix = matrix( partialSkinningMatrix, float4( 0, 0, 0, 1 ) );
+#elif INSTANCING
+	matrix worldMatrix = matrix(
+		vIn.instanceTransform0, vIn.instanceTransform1, vIn.instanceTransform2, float4( 0, 0, 0, 1 ) );
 #else
     matrix worldMatrix = matrix( InstanceGlobalData.transform, float4( 0, 0, 0, 1 ) );
 #endif
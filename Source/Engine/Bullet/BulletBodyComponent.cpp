@@ -181,10 +181,11 @@ void DoPostProcessPhysics( BulletBodyComponent *pBodyComponent, Helium::Transfor
 	pTransformComponent->SetRotation(rotation);
 };
 
-HELIUM_DEFINE_TASK( PostProcessPhysics, (ForEachWorld< QueryComponents< BulletBodyComponent, TransformComponent, DoPostProcessPhysics > >), TickTypes::Gameplay )
+HELIUM_DEFINE_TASK( PostProcessPhysics, (ForEachWorld< ParallelQueryComponents< BulletBodyComponent, TransformComponent, DoPostProcessPhysics > >), TickTypes::Gameplay )
 
 void PostProcessPhysics::DefineContract( Helium::TaskContract &rContract )
 {
 	rContract.ExecutesWithin<Helium::StandardDependencies::ProcessPhysics>();
 	rContract.ExecuteAfter<Helium::ProcessPhysics>();
+	rContract.ExecuteQueriesInParallel();
 }
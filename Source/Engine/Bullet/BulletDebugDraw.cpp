@@ -215,4 +215,5 @@ void DrawDebugPhysics::DefineContract( Helium::TaskContract &rContract )
 {
 	rContract.ExecuteAfter<Helium::StandardDependencies::ProcessPhysics>();
 	rContract.ExecuteBefore<Helium::StandardDependencies::Render>();
+	rContract.ExecuteOnMainThread();
 }
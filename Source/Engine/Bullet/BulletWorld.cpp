@@ -42,20 +42,28 @@ void InternalTickCallback(btDynamicsWorld *world, btScalar timeStep)
 			{
 				if ( trackACollisions )
 				{
+					// Null if the contacts component pool is full
 					HasPhysicalContactsComponent *pContacts = pBodyComponentA->GetOrCreateHasPhysicalContactsComponent();
-					pContacts->m_EverTouchedThisFrame.Insert( pBodyComponentB->GetEntity() );
+					if ( pContacts )
+					{
+						pContacts->m_EverTouchedThisFrame.Insert( pBodyComponentB->GetEntity() );
 
-					// TODO: Only need to do this on last subtick really
-					pContacts->m_EndFrameTouching.Insert( pBodyComponentB->GetEntity() );
+						// TODO: Only need to do this on last subtick really
+						pContacts->m_EndFrameTouching.Insert( pBodyComponentB->GetEntity() );
+					}
 				}
 
 				if ( trackBCollisions )
 				{
+					// Null if the contacts component pool is full
 					HasPhysicalContactsComponent *pContacts = pBodyComponentB->GetOrCreateHasPhysicalContactsComponent();
-					pContacts->m_EverTouchedThisFrame.Insert( pBodyComponentA->GetEntity() );
+					if ( pContacts )
+					{
+						pContacts->m_EverTouchedThisFrame.Insert( pBodyComponentA->GetEntity() );
 
-					// TODO: Only need to do this on last subtick really
-					pContacts->m_EndFrameTouching.Insert( pBodyComponentA->GetEntity() );
+						// TODO: Only need to do this on last subtick really
+						pContacts->m_EndFrameTouching.Insert( pBodyComponentA->GetEntity() );
+					}
 				}
 			}
 
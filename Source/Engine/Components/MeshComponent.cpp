@@ -24,6 +24,8 @@ void MeshComponent::Initialize( const MeshComponentDefinition& definition )
 	{
 		m_Mesh = definition.m_Mesh;
 	}
+
+	m_Animation = definition.m_Animation;
 }
 
 void MeshComponent::Finalize( const MeshComponentDefinition& definition )
@@ -49,11 +51,13 @@ void MeshComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
 {
 	comp.AddField(&MeshComponentDefinition::m_Mesh, "m_Mesh");
 	comp.AddField(&MeshComponentDefinition::m_OverrideMaterials, "m_OverrideMaterials");
+	comp.AddField(&MeshComponentDefinition::m_Animation, "m_Animation");
 }
 
 /// Constructor.
 MeshComponent::MeshComponent()
-: m_graphicsSceneObjectId( Invalid< size_t >() )
+: m_AnimationBlendSeconds( 0.0f )
+, m_graphicsSceneObjectId( Invalid< size_t >() )
 {
 }
 
@@ -139,6 +143,36 @@ void MeshComponent::SetMesh( Mesh* pMesh )
 	}
 }
 
+/// Set the animation played on this entity's mesh.
+///
+/// Animations only affect skinned meshes, and take effect at the next full graphics scene object update.
+///
+/// @param[in] pAnimation    Animation to play, or null to hold the mesh's reference pose.
+/// @param[in] blendSeconds  Time over which to blend from the animation currently playing, in seconds.
+///
+/// @see GetAnimation()
+void MeshComponent::SetAnimation( Animation* pAnimation, float32_t blendSeconds )
+{
+	if( m_Animation.Get() != pAnimation )
+	{
+		m_Animation = pAnimation;
+		m_AnimationBlendSeconds = blendSeconds;
+
+		if( m_MeshSceneObjectTransformComponent.IsGood() )
+		{
+			m_MeshSceneObjectTransformComponent->Update( GraphicsSceneObject::UPDATE_FULL );
+		}
+		else
+		{
+			TransformComponent *pTransform = GetComponentCollection()->GetFirst<TransformComponent>();
+			if( pTransform )
+			{
+				SetNeedsGraphicsSceneObjectUpdate( pTransform );
+			}
+		}
+	}
+}
+
 /// Flag the graphics scene object as requiring an update if one exists.
 ///
 /// This is safe to call by an entity during its pre-update.  It should only ever be called by the entity itself.
@@ -156,8 +190,12 @@ void MeshComponent::SetNeedsGraphicsSceneObjectUpdate(
 		}
 		else
 		{
+			// Allocation fails if the pool is full; try again on the next update
 			m_MeshSceneObjectTransformComponent = AllocateSiblingComponent<MeshSceneObjectTransform>();
-			m_MeshSceneObjectTransformComponent->Setup(pTransform, this, updateMode, m_graphicsSceneObjectId);
+			if (m_MeshSceneObjectTransformComponent.IsGood())
+			{
+				m_MeshSceneObjectTransformComponent->Setup(pTransform, this, updateMode, m_graphicsSceneObjectId);
+			}
 		}
 	}
 }
@@ -200,7 +238,7 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 			worldBounds.TransformBy( transform );
 		}
 
-		pSceneObject->SetWorldBounds( worldBounds );
+		pScene->SetSceneObjectWorldBounds( graphicsSceneObjectId, worldBounds );
 
 		return;
 	}
@@ -216,7 +254,7 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		worldBounds.TransformBy( transform );
 	}
 
-	pSceneObject->SetWorldBounds( worldBounds );
+	pScene->SetSceneObjectWorldBounds( graphicsSceneObjectId, worldBounds );
 
 	const DynamicArray< size_t >& rSubMeshDataIds = pThis->m_graphicsSceneObjectSubMeshDataIds;
 	size_t subMeshCount = rSubMeshDataIds.GetSize();
@@ -248,6 +286,22 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		pSceneObject->SetVertexData( pVertexBuffer, pVertexDescription, vertexStride );
 		pSceneObject->SetIndexBuffer( pIndexBuffer );
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+		// Skinned meshes are animated by the scene, which supplies a fresh bone palette each update.
+		const Simd::Matrix44* pInverseReferencePose = pMesh->GetInverseReferencePose();
+		if( pMesh->IsSkinned() && pInverseReferencePose )
+		{
+			pSceneObject->SetBoneData( pInverseReferencePose, pMesh->GetBoneCount() );
+			pScene->SetSceneObjectAnimation(
+				graphicsSceneObjectId, pMesh, pThis->m_Animation, pThis->m_AnimationBlendSeconds );
+		}
+		else
+		{
+			pSceneObject->SetBoneData( NULL, 0 );
+			pScene->ClearSceneObjectAnimation( graphicsSceneObjectId );
+		}
+#endif
+
 		meshSectionCount = pMesh->GetSectionCount();
 		if( meshSectionCount > subMeshCount )
 		{
@@ -369,6 +423,7 @@ void Helium::UpdateMeshComponentsTask::DefineContract( TaskContract &rContract )
 {
 	rContract.ExecuteBefore<StandardDependencies::Render>();
 	rContract.ExecuteAfter<StandardDependencies::ProcessPhysics>();
+	rContract.ExecuteOnMainThread();
 }
 
 HELIUM_DEFINE_TASK( UpdateMeshComponentsTask, (ForEachWorld< UpdateMeshComponents >), TickTypes::Render );
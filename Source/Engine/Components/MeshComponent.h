@@ -6,6 +6,7 @@
 #include "Foundation/DynamicArray.h"
 #include "Framework/ComponentDefinition.h"
 #include "Framework/TaskScheduler.h"
+#include "Graphics/Animation.h"
 #include "Graphics/Mesh.h"
 #include "Graphics/Material.h"
 #include "Graphics/GraphicsScene.h"
@@ -46,6 +47,12 @@ namespace Helium
 		inline Material* GetMaterial( size_t index ) const;
 		//@}
 
+		/// @name Animation
+		//@{
+		void SetAnimation( Animation* pAnimation, float32_t blendSeconds = 0.0f );
+		inline Animation* GetAnimation() const;
+		//@}
+
 		void Update( class GraphicsScene *pGraphicsScene, class TransformComponent *pTransform );
 		
 		/// @name Scene GameObject Synchronization Callback
@@ -63,6 +70,10 @@ namespace Helium
 		StrongPtr< Mesh > m_Mesh;
 		/// Override material set.
 		DynamicArray< MaterialPtr > m_OverrideMaterials;
+		/// Animation played on the mesh (skinned meshes only).
+		StrongPtr< Animation > m_Animation;
+		/// Time over which to blend to the animation most recently set, in seconds.
+		float32_t m_AnimationBlendSeconds;
 
 		/// ID of the scene object representing this entity in the graphics scene.
 		size_t m_graphicsSceneObjectId;
@@ -92,6 +103,7 @@ namespace Helium
 				
 		StrongPtr<Mesh> m_Mesh;
 		DynamicArray< MaterialPtr > m_OverrideMaterials;
+		StrongPtr<Animation> m_Animation;
 	};
 	typedef StrongPtr<MeshComponentDefinition> MeshComponentDefinitionPtr;
 	
@@ -6,6 +6,16 @@ Helium::Mesh* Helium::MeshComponent::GetMesh() const
     return m_Mesh;
 }
 
+/// Get the animation played on the assigned mesh.
+///
+/// @return  Assigned animation.
+///
+/// @see SetAnimation()
+Helium::Animation* Helium::MeshComponent::GetAnimation() const
+{
+    return m_Animation;
+}
+
 /// Get the number of override materials assigned to this entity.
 ///
 /// @return  Override material count.
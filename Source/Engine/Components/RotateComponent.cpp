@@ -89,6 +89,7 @@ void Helium::UpdateRotateComponentsTask::DefineContract( TaskContract &rContract
 {
 	rContract.ExecuteBefore<StandardDependencies::ProcessPhysics>();
 	rContract.ExecuteAfter<StandardDependencies::ReceiveInput>();
+	rContract.ExecuteQueriesInParallel();
 }
 
-HELIUM_DEFINE_TASK( UpdateRotateComponentsTask, (ForEachWorld< QueryComponents< RotateComponent, TransformComponent, UpdateRotateComponents > >), TickTypes::Gameplay )
+HELIUM_DEFINE_TASK( UpdateRotateComponentsTask, (ForEachWorld< ParallelQueryComponents< RotateComponent, TransformComponent, UpdateRotateComponents > >), TickTypes::Gameplay )
@@ -19,6 +19,107 @@ HELIUM_IMPLEMENT_ASSET( Helium::AnimationResourceHandler, EditorSupport, 0 );
 
 using namespace Helium;
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+/// Largest quantized sample component value.
+static const float32_t QUANTIZED_COMPONENT_MAX = 65535.0f;
+/// Largest difference from a unit scale that is still treated as unscaled.
+static const float32_t UNIT_SCALE_TOLERANCE = 1.0e-4f;
+
+/// Quantize a value to 16 bits over a given range.
+///
+/// @param[in] value    Value to quantize.
+/// @param[in] minimum  Smallest value in the range.
+/// @param[in] range    Size of the range.
+///
+/// @return  Quantized value.
+static uint16_t QuantizeComponent( float32_t value, float32_t minimum, float32_t range )
+{
+    if( range <= 0.0f )
+    {
+        return 0;
+    }
+
+    float32_t normalized = Clamp( ( value - minimum ) / range, 0.0f, 1.0f );
+
+    return static_cast< uint16_t >( normalized * QUANTIZED_COMPONENT_MAX + 0.5f );
+}
+
+/// Compute the range covered by a vector track component and quantize its samples.
+///
+/// @param[in]  rTracks          Source animation tracks.
+/// @param[in]  sampleCount      Number of samples to store for each track.
+/// @param[in]  bScale           True to quantize the scale of each key, false to quantize the translation.
+/// @param[out] rMinimums        Smallest value in each track (three components per track).
+/// @param[out] rRanges          Range covered by each track (three components per track).
+/// @param[out] rSamples         Quantized samples, stored frame by frame.
+static void QuantizeVectorTracks(
+    const DynamicArray< FbxSupport::AnimTrackData >& rTracks,
+    size_t sampleCount,
+    bool bScale,
+    DynamicArray< float32_t >& rMinimums,
+    DynamicArray< float32_t >& rRanges,
+    DynamicArray< uint16_t >& rSamples )
+{
+    size_t trackCount = rTracks.GetSize();
+    rMinimums.Resize( trackCount * Animation::VECTOR_COMPONENT_COUNT );
+    rRanges.Resize( trackCount * Animation::VECTOR_COMPONENT_COUNT );
+    rSamples.Resize( sampleCount * trackCount * Animation::VECTOR_COMPONENT_COUNT );
+
+    for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+    {
+        const DynamicArray< FbxSupport::Key >& rKeys = rTracks[ trackIndex ].keys;
+        size_t keyCount = rKeys.GetSize();
+
+        for( size_t component = 0; component < Animation::VECTOR_COMPONENT_COUNT; ++component )
+        {
+            float32_t minimum = ( bScale ? 1.0f : 0.0f );
+            float32_t maximum = minimum;
+            for( size_t keyIndex = 0; keyIndex < keyCount; ++keyIndex )
+            {
+                const FbxSupport::Key& rKey = rKeys[ keyIndex ];
+                float32_t value = ( bScale ? rKey.scale : rKey.translation ).GetElement( component );
+                if( keyIndex == 0 )
+                {
+                    minimum = value;
+                    maximum = value;
+                }
+                else
+                {
+                    minimum = Min( minimum, value );
+                    maximum = Max( maximum, value );
+                }
+            }
+
+            size_t rangeIndex = trackIndex * Animation::VECTOR_COMPONENT_COUNT + component;
+            rMinimums[ rangeIndex ] = minimum;
+            rRanges[ rangeIndex ] = maximum - minimum;
+        }
+
+        // Tracks with fewer keys than the longest track hold their last key.
+        for( size_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex )
+        {
+            uint16_t* pSample =
+                rSamples.GetData() + ( sampleIndex * trackCount + trackIndex ) * Animation::VECTOR_COMPONENT_COUNT;
+            if( keyCount == 0 )
+            {
+                MemoryZero( pSample, sizeof( uint16_t ) * Animation::VECTOR_COMPONENT_COUNT );
+
+                continue;
+            }
+
+            const FbxSupport::Key& rKey = rKeys[ Min( sampleIndex, keyCount - 1 ) ];
+            const Simd::Vector3& rValue = ( bScale ? rKey.scale : rKey.translation );
+            for( size_t component = 0; component < Animation::VECTOR_COMPONENT_COUNT; ++component )
+            {
+                size_t rangeIndex = trackIndex * Animation::VECTOR_COMPONENT_COUNT + component;
+                pSample[ component ] =
+                    QuantizeComponent( rValue.GetElement( component ), rMinimums[ rangeIndex ], rRanges[ rangeIndex ] );
+            }
+        }
+    }
+}
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
+
 /// Constructor.
 AnimationResourceHandler::AnimationResourceHandler()
 : m_rFbxSupport( FbxSupport::StaticAcquire() )
@@ -68,14 +169,111 @@ bool AnimationResourceHandler::CacheResource(
 
     return bCacheResult;
 #else
-    HELIUM_UNREF( pAssetPreprocessor );
-    HELIUM_UNREF( rSourceFilePath );
+    StrongPtr< Animation::PersistentResourceData > persistentResourceData( new Animation::PersistentResourceData() );
+    persistentResourceData->GetRefCountProxy()->AddStrongRef();
+
+    // Load the animation tracks, with one key per frame.
+    DynamicArray< FbxSupport::AnimTrackData > tracks;
+    uint_fast32_t samplesPerSecond = 0;
+    bool bLoadSuccess = m_rFbxSupport.LoadAnimation( rSourceFilePath, 1, tracks, samplesPerSecond );
+    if( !bLoadSuccess )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            "AnimationResourceHandler::CacheResource(): Failed to load animation from source file \"%s\".\n",
+            *rSourceFilePath );
 
+        return false;
+    }
+
+    size_t trackCount = tracks.GetSize();
+    size_t sampleCount = 0;
+    bool bScaled = false;
+    for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+    {
+        const DynamicArray< FbxSupport::Key >& rKeys = tracks[ trackIndex ].keys;
+        sampleCount = Max( sampleCount, rKeys.GetSize() );
+
+        for( size_t keyIndex = 0; keyIndex < rKeys.GetSize() && !bScaled; ++keyIndex )
+        {
+            const Simd::Vector3& rScale = rKeys[ keyIndex ].scale;
+            for( size_t component = 0; component < Animation::VECTOR_COMPONENT_COUNT; ++component )
+            {
+                if( Abs( rScale.GetElement( component ) - 1.0f ) > UNIT_SCALE_TOLERANCE )
+                {
+                    bScaled = true;
+                }
+            }
+        }
+    }
+
+    HELIUM_ASSERT( sampleCount <= UINT32_MAX );
+    persistentResourceData->m_sampleCount = static_cast< uint32_t >( sampleCount );
+    persistentResourceData->m_samplesPerSecond = static_cast< float32_t >( samplesPerSecond );
+
+    persistentResourceData->m_trackNames.Resize( trackCount );
+    for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+    {
+        persistentResourceData->m_trackNames[ trackIndex ] = tracks[ trackIndex ].name;
+    }
+
+    // Quantize rotations over the full range of a unit quaternion's components.
+    DynamicArray< uint16_t >& rRotations = persistentResourceData->m_rotations;
+    rRotations.Resize( sampleCount * trackCount * Animation::ROTATION_COMPONENT_COUNT );
+    for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+    {
+        const DynamicArray< FbxSupport::Key >& rKeys = tracks[ trackIndex ].keys;
+        size_t keyCount = rKeys.GetSize();
+        for( size_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex )
+        {
+            Simd::Quat rotation( 0.0f, 0.0f, 0.0f, 1.0f );
+            if( keyCount != 0 )
+            {
+                rotation = rKeys[ Min( sampleIndex, keyCount - 1 ) ].rotation;
+                rotation.Normalize();
+            }
+
+            uint16_t* pSample =
+                rRotations.GetData() + ( sampleIndex * trackCount + trackIndex ) * Animation::ROTATION_COMPONENT_COUNT;
+            for( size_t component = 0; component < Animation::ROTATION_COMPONENT_COUNT; ++component )
+            {
+                pSample[ component ] = QuantizeComponent( rotation.GetElement( component ), -1.0f, 2.0f );
+            }
+        }
+    }
+
+    QuantizeVectorTracks(
+        tracks,
+        sampleCount,
+        false,
+        persistentResourceData->m_translationMinimums,
+        persistentResourceData->m_translationRanges,
+        persistentResourceData->m_translations );
+
+    if( bScaled )
+    {
+        QuantizeVectorTracks(
+            tracks,
+            sampleCount,
+            true,
+            persistentResourceData->m_scaleMinimums,
+            persistentResourceData->m_scaleRanges,
+            persistentResourceData->m_scales );
+    }
+
+    // Cache the data for each supported platform.
     for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
     {
+        PlatformPreprocessor* pPreprocessor = pAssetPreprocessor->GetPlatformPreprocessor(
+            static_cast< Cache::EPlatform >( platformIndex ) );
+        if( !pPreprocessor )
+        {
+            continue;
+        }
+
         Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
             static_cast< Cache::EPlatform >( platformIndex ) );
-        rPreprocessedData.persistentDataBuffer.Clear();
+        Cache::WriteCacheObjectToBuffer( persistentResourceData.Get(), rPreprocessedData.persistentDataBuffer );
         rPreprocessedData.subDataBuffers.Clear();
         rPreprocessedData.bLoaded = true;
     }
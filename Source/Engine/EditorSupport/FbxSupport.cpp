@@ -288,8 +288,8 @@ void FbxSupport::Release()
 ///
 /// @param[in]  rSourceFilePath         FilePath name of the source file from which to load the mesh.
 /// @param[out] rVertices               Mesh vertices.
-/// @param[out] rIndices                Triangle vertex indices.
-/// @param[in]  rSectionVertexCounts    Number of vertices addressed by each mesh section.
+/// @param[out] rIndices                Triangle vertex indices (relative to the first vertex of each mesh section).
+/// @param[out] rSectionVertexCounts    Number of vertices addressed by each mesh section.
 /// @param[out] rSectionTriangleCounts  Number of triangles per mesh section.
 /// @param[out] rBones                  Information about each bone in the mesh (if the mesh contains skinning
 ///                                     data).
@@ -303,8 +303,8 @@ void FbxSupport::Release()
 bool FbxSupport::LoadMesh(
 						  const String& rSourceFilePath,
 						  DynamicArray< StaticMeshVertex< 1 > >& rVertices,
-						  DynamicArray< uint16_t >& rIndices,
-						  DynamicArray< uint16_t >& rSectionVertexCounts,
+						  DynamicArray< uint32_t >& rIndices,
+						  DynamicArray< uint32_t >& rSectionVertexCounts,
 						  DynamicArray< uint32_t >& rSectionTriangleCounts,
 						  DynamicArray< BoneData >& rBones,
 						  DynamicArray< BlendData >& rVertexBlendData,
@@ -550,7 +550,7 @@ void FbxSupport::BuildSkinningInformation(
 	FbxMesh* pMesh,
 	FbxNode* pSkeletonRootNode,
 	const DynamicArray< int >& rControlPointIndices,
-	const DynamicArray< uint16_t >& rSectionVertexCounts,
+	const DynamicArray< uint32_t >& rSectionVertexCounts,
 	DynamicArray< BoneData >& rBones,
 	DynamicArray< BlendData >& rVertexBlendData,
 	DynamicArray< uint8_t >& rSkinningPaletteMap,
@@ -1119,9 +1119,13 @@ void FbxSupport::RecursiveAddAnimationSkeletonData(
 
 /// Parse the specified scene and extract the mesh data from it.
 ///
+/// Polygon vertices sharing the same attributes within a mesh section are welded into a single vertex using a hash
+/// table keyed on those attributes, so building the mesh takes linear time in the number of polygon vertices.
+///
 /// @param[in]  pScene                  Scene to parse.
 /// @param[out] rVertices               Mesh vertices.
-/// @param[out] rIndices                Mesh vertex indices (three per triangle).
+/// @param[out] rIndices                Mesh vertex indices (three per triangle, relative to the first vertex of each
+///                                     mesh section).
 /// @param[out] rSectionVertexCounts    Number of vertices addressed by each mesh section.
 /// @param[out] rSectionTriangleCounts  Number of triangles per mesh section.
 /// @param[out] rBones                  Information about each bone in the mesh (if the mesh contains skinning
@@ -1136,8 +1140,8 @@ void FbxSupport::RecursiveAddAnimationSkeletonData(
 bool FbxSupport::BuildMeshFromScene(
 									FbxScene* pScene,
 									DynamicArray< StaticMeshVertex< 1 > >& rVertices,
-									DynamicArray< uint16_t >& rIndices,
-									DynamicArray< uint16_t >& rSectionVertexCounts,
+									DynamicArray< uint32_t >& rIndices,
+									DynamicArray< uint32_t >& rSectionVertexCounts,
 									DynamicArray< uint32_t >& rSectionTriangleCounts,
 									DynamicArray< BoneData >& rBones,
 									DynamicArray< BlendData >& rVertexBlendData,
@@ -1298,9 +1302,14 @@ bool FbxSupport::BuildMeshFromScene(
 	}
 
 	DynamicArray< DynamicArray< StaticMeshVertex< 1 > > > sectionVertices;
-	DynamicArray< DynamicArray< uint16_t > > sectionVertexIndices;
+	DynamicArray< DynamicArray< uint32_t > > sectionVertexIndices;
 	DynamicArray< DynamicArray< int > > sectionControlPointIndices;
 
+	// Index of each unique vertex within its section, keyed on the vertex attributes.
+	HashMap< WeldVertexKey, uint32_t, WeldVertexKeyHash > weldedVertexIndices;
+	WeldVertexKey weldKey;
+	MemoryZero( &weldKey, sizeof( weldKey ) );
+
 	size_t totalVertexCount = 0;
 	size_t totalTriangleCount = 0;
 
@@ -1333,8 +1342,8 @@ bool FbxSupport::BuildMeshFromScene(
 			++polygonsTriangulated;
 		}
 
-		uint16_t vertexIndex0 = 0;
-		uint16_t vertexIndexPrev = 0;
+		uint32_t vertexIndex0 = 0;
+		uint32_t vertexIndexPrev = 0;
 
 		// Only use the material from the first vertex for the whole polygon.
 		int sectionIndex = 0;
@@ -1362,7 +1371,7 @@ bool FbxSupport::BuildMeshFromScene(
 		}
 
 		DynamicArray< StaticMeshVertex< 1 > >& rCurrentSectionVertices = sectionVertices[ sectionIndex ];
-		DynamicArray< uint16_t >& rCurrentSectionIndices = sectionVertexIndices[ sectionIndex ];
+		DynamicArray< uint32_t >& rCurrentSectionIndices = sectionVertexIndices[ sectionIndex ];
 		DynamicArray< int >& rCurrentSectionControlPointIndices = sectionControlPointIndices[ sectionIndex ];
 
 		for( int_fast32_t polygonVertexIndex = 0;
@@ -1423,26 +1432,24 @@ bool FbxSupport::BuildMeshFromScene(
 				vertex.texCoords[ 0 ][ 1 ] = Float32To16( packedFloat );
 			}
 
-			size_t vertexCount = rCurrentSectionVertices.GetSize();
-			size_t vertexIndex;
-			for( vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
-			{
-				const StaticMeshVertex< 1 >& rVertex = rCurrentSectionVertices[ vertexIndex ];
-				if( rCurrentSectionControlPointIndices[ vertexIndex ] == controlPointIndex &&
-					rVertex.normal[ 0 ] == vertex.normal[ 0 ] &&
-					rVertex.normal[ 1 ] == vertex.normal[ 1 ] &&
-					rVertex.normal[ 2 ] == vertex.normal[ 2 ] &&
-					rVertex.color == vertex.color &&
-					rVertex.texCoords[ 0 ][ 0 ].packed == vertex.texCoords[ 0 ][ 0 ].packed &&
-					rVertex.texCoords[ 0 ][ 1 ].packed == vertex.texCoords[ 0 ][ 1 ].packed )
-				{
-					break;
-				}
-			}
+			weldKey.sectionIndex = sectionIndex;
+			weldKey.controlPointIndex = controlPointIndex;
+			weldKey.normal[ 0 ] = vertex.normal[ 0 ];
+			weldKey.normal[ 1 ] = vertex.normal[ 1 ];
+			weldKey.normal[ 2 ] = vertex.normal[ 2 ];
+			MemoryCopy( weldKey.color, vertex.color, sizeof( weldKey.color ) );
+			weldKey.texCoords[ 0 ] = vertex.texCoords[ 0 ][ 0 ].packed;
+			weldKey.texCoords[ 1 ] = vertex.texCoords[ 0 ][ 1 ].packed;
 
-			HELIUM_ASSERT( vertexIndex <= vertexCount );
-			HELIUM_ASSERT( vertexIndex <= UINT16_MAX );
-			if( vertexIndex >= vertexCount )
+			size_t vertexCount = rCurrentSectionVertices.GetSize();
+			HELIUM_ASSERT( vertexCount < UINT32_MAX );
+
+			HashMap< WeldVertexKey, uint32_t, WeldVertexKeyHash >::Iterator weldIterator;
+			if( weldedVertexIndices.Insert(
+				weldIterator,
+				HashMap< WeldVertexKey, uint32_t, WeldVertexKeyHash >::ValueType(
+					weldKey,
+					static_cast< uint32_t >( vertexCount ) ) ) )
 			{
 				// Note that when getting the position, we need to flip vertices across the x-axis manually since
 				// FbxAxisSystem::ConvertScene() doesn't actually modify the mesh data.
@@ -1457,32 +1464,35 @@ bool FbxSupport::BuildMeshFromScene(
 				++totalVertexCount;
 			}
 
-			uint16_t vertexIndex16 = static_cast< uint16_t >( vertexIndex );
+			uint32_t vertexIndex = weldIterator->Second();
+			HELIUM_ASSERT( vertexIndex <= vertexCount );
 
 			if( polygonVertexIndex > 1 )
 			{
 				// Reverse the triangle ordering when building the index list since we flipped the mesh across the
 				// x-axis.
 				rCurrentSectionIndices.Push( vertexIndex0 );
-				rCurrentSectionIndices.Push( vertexIndex16 );
+				rCurrentSectionIndices.Push( vertexIndex );
 				rCurrentSectionIndices.Push( vertexIndexPrev );
 
-				vertexIndexPrev = vertexIndex16;
+				vertexIndexPrev = vertexIndex;
 
 				++totalTriangleCount;
 			}
 			else if( polygonVertexIndex == 0 )
 			{
-				vertexIndex0 = vertexIndex16;
+				vertexIndex0 = vertexIndex;
 			}
 			else
 			{
 				HELIUM_ASSERT( polygonVertexIndex == 1 );
-				vertexIndexPrev = vertexIndex16;
+				vertexIndexPrev = vertexIndex;
 			}
 		}
 	}
 
+	weldedVertexIndices.Clear();
+
 	if ( polygonsTriangulated > 0 )
 	{
 		HELIUM_TRACE(
@@ -1509,15 +1519,15 @@ bool FbxSupport::BuildMeshFromScene(
 	for( size_t sectionIndex = 0; sectionIndex < meshSectionCount; ++sectionIndex )
 	{
 		const DynamicArray< StaticMeshVertex< 1 > >& rCurrentSectionVertices = sectionVertices[ sectionIndex ];
-		const DynamicArray< uint16_t >& rCurrentSectionIndices = sectionVertexIndices[ sectionIndex ];
+		const DynamicArray< uint32_t >& rCurrentSectionIndices = sectionVertexIndices[ sectionIndex ];
 		const DynamicArray< int >& rCurrentSectionControlPointIndices = sectionControlPointIndices[ sectionIndex ];
 
 		size_t sectionVertexCount = rCurrentSectionVertices.GetSize();
 		HELIUM_ASSERT( rCurrentSectionControlPointIndices.GetSize() == sectionVertexCount );
 		rVertices.AddArray( rCurrentSectionVertices.GetData(), sectionVertexCount );
 		controlPointIndices.AddArray( rCurrentSectionControlPointIndices.GetData(), sectionVertexCount );
-		HELIUM_ASSERT( sectionVertexCount <= UINT16_MAX );
-		rSectionVertexCounts.Push( static_cast< uint16_t >( sectionVertexCount ) );
+		HELIUM_ASSERT( sectionVertexCount <= UINT32_MAX );
+		rSectionVertexCounts.Push( static_cast< uint32_t >( sectionVertexCount ) );
 
 		size_t sectionIndexCount = rCurrentSectionIndices.GetSize();
 		rIndices.AddArray( rCurrentSectionIndices.GetData(), sectionIndexCount );
@@ -1571,12 +1581,26 @@ bool FbxSupport::BuildMeshFromScene(
 	Simd::Vector3 tangentFallback( 1.0f, 0.0f, 0.0f );
 	Simd::Vector3 binormalFallback( 0.0f, 1.0f, 0.0f );
 
+	// Indices are relative to the start of each section, so track the section containing each triangle.
 	size_t indexCount = rIndices.GetSize();
+	size_t sectionIndex = 0;
+	size_t sectionStartVertex = 0;
+	size_t sectionEndIndex = ( meshSectionCount != 0 ? rSectionTriangleCounts[ 0 ] * 3 : indexCount );
 	for( size_t indexIndex = 0; indexIndex < indexCount; indexIndex += 3 )
 	{
-		size_t vertexIndex0 = rIndices[ indexIndex ];
-		size_t vertexIndex1 = rIndices[ indexIndex + 1 ];
-		size_t vertexIndex2 = rIndices[ indexIndex + 2 ];
+		while( indexIndex >= sectionEndIndex && sectionIndex + 1 < meshSectionCount )
+		{
+			sectionStartVertex += rSectionVertexCounts[ sectionIndex ];
+			++sectionIndex;
+			sectionEndIndex += rSectionTriangleCounts[ sectionIndex ] * 3;
+		}
+
+		size_t vertexIndex0 = sectionStartVertex + rIndices[ indexIndex ];
+		size_t vertexIndex1 = sectionStartVertex + rIndices[ indexIndex + 1 ];
+		size_t vertexIndex2 = sectionStartVertex + rIndices[ indexIndex + 2 ];
+		HELIUM_ASSERT( vertexIndex0 < vertexCount );
+		HELIUM_ASSERT( vertexIndex1 < vertexCount );
+		HELIUM_ASSERT( vertexIndex2 < vertexCount );
 
 		const StaticMeshVertex< 1 >& rVertex0 = rVertices[ vertexIndex0 ];
 		const StaticMeshVertex< 1 >& rVertex1 = rVertices[ vertexIndex1 ];
@@ -1668,6 +1692,53 @@ bool FbxSupport::BuildMeshFromScene(
 	return true;
 }
 
+/// Compare two vertex welding keys.
+///
+/// @param[in] rOther  Key with which to compare.
+///
+/// @return  True if both keys identify the same vertex, false if not.
+bool FbxSupport::WeldVertexKey::operator==( const WeldVertexKey& rOther ) const
+{
+	return sectionIndex == rOther.sectionIndex &&
+		controlPointIndex == rOther.controlPointIndex &&
+		normal[ 0 ] == rOther.normal[ 0 ] &&
+		normal[ 1 ] == rOther.normal[ 1 ] &&
+		normal[ 2 ] == rOther.normal[ 2 ] &&
+		color[ 0 ] == rOther.color[ 0 ] &&
+		color[ 1 ] == rOther.color[ 1 ] &&
+		color[ 2 ] == rOther.color[ 2 ] &&
+		color[ 3 ] == rOther.color[ 3 ] &&
+		texCoords[ 0 ] == rOther.texCoords[ 0 ] &&
+		texCoords[ 1 ] == rOther.texCoords[ 1 ];
+}
+
+/// Compute the hash of a vertex welding key.
+///
+/// @param[in] rKey  Key to hash.
+///
+/// @return  Hash value.
+size_t FbxSupport::WeldVertexKeyHash::operator()( const WeldVertexKey& rKey ) const
+{
+	uint64_t position =
+		static_cast< uint64_t >( static_cast< uint32_t >( rKey.controlPointIndex ) ) |
+		( static_cast< uint64_t >( static_cast< uint32_t >( rKey.sectionIndex ) ) << 32 );
+	uint64_t attributes =
+		static_cast< uint64_t >( rKey.normal[ 0 ] ) |
+		( static_cast< uint64_t >( rKey.normal[ 1 ] ) << 8 ) |
+		( static_cast< uint64_t >( rKey.normal[ 2 ] ) << 16 ) |
+		( static_cast< uint64_t >( rKey.color[ 0 ] ^ rKey.color[ 1 ] ^ rKey.color[ 2 ] ^ rKey.color[ 3 ] ) << 24 ) |
+		( static_cast< uint64_t >( rKey.texCoords[ 0 ] ) << 32 ) |
+		( static_cast< uint64_t >( rKey.texCoords[ 1 ] ) << 48 );
+
+	// Mix the bits so that neighboring control points and similar attributes spread across the table.
+	uint64_t hash = position * 0x9e3779b97f4a7c15ULL ^ attributes;
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+
+	return static_cast< size_t >( hash );
+}
+
 /// Parse the specified scene and extract the animation data from it.
 ///
 /// @param[in]  pScene             Scene to parse.
@@ -4,6 +4,7 @@
 
 #if HELIUM_TOOLS
 
+#include "Foundation/HashMap.h"
 #include "MathSimd/Matrix44.h"
 #include "MathSimd/Quat.h"
 #include "GraphicsTypes/VertexTypes.h"
@@ -114,8 +115,8 @@ namespace Helium
         /// @name Resource Loading
         //@{
         bool LoadMesh(
-            const String& rSourceFilePath, DynamicArray< StaticMeshVertex< 1 > >& rVertices, DynamicArray< uint16_t >& rIndices,
-            DynamicArray< uint16_t >& rSectionVertexCounts, DynamicArray< uint32_t >& rSectionTriangleCounts,
+            const String& rSourceFilePath, DynamicArray< StaticMeshVertex< 1 > >& rVertices, DynamicArray< uint32_t >& rIndices,
+            DynamicArray< uint32_t >& rSectionVertexCounts, DynamicArray< uint32_t >& rSectionTriangleCounts,
             DynamicArray< BoneData >& rBones, DynamicArray< BlendData >& rVertexBlendData,
             DynamicArray< uint8_t >& rSkinningPaletteMap, bool bStripNamespaces = true );
         bool LoadAnimation(
@@ -151,6 +152,36 @@ namespace Helium
             uint8_t parentIndex;
         };
 
+        /// Attributes distinguishing each unique vertex within a mesh section while welding mesh vertices.
+        struct WeldVertexKey
+        {
+            /// Mesh section index.
+            int sectionIndex;
+            /// Index of the control point providing the vertex position.
+            int controlPointIndex;
+            /// Packed normal.
+            uint8_t normal[ 3 ];
+            /// Packed color.
+            uint8_t color[ 4 ];
+            /// Packed texture coordinates.
+            uint16_t texCoords[ 2 ];
+
+            /// @name Overloaded Operators
+            //@{
+            bool operator==( const WeldVertexKey& rOther ) const;
+            //@}
+        };
+
+        /// Hash function for vertex welding keys.
+        class WeldVertexKeyHash
+        {
+        public:
+            /// @name Overloaded Operators
+            //@{
+            size_t operator()( const WeldVertexKey& rKey ) const;
+            //@}
+        };
+
         /// FBX SDK manager instance.
         FbxManager* m_pSdkManager;
         /// IO settings instance.
@@ -181,7 +212,7 @@ namespace Helium
 
         void BuildSkinningInformation(
             FbxScene* pScene, FbxMesh* pMesh, FbxNode* pSkeletonRootNode,
-            const DynamicArray< int >& rControlPointIndices, const DynamicArray< uint16_t >& rSectionVertexCounts,
+            const DynamicArray< int >& rControlPointIndices, const DynamicArray< uint32_t >& rSectionVertexCounts,
             DynamicArray< BoneData >& rBones, DynamicArray< BlendData >& rVertexBlendData,
             DynamicArray< uint8_t >& rSkinningPaletteMap, bool bStripNamespaces );
 
@@ -194,8 +225,8 @@ namespace Helium
             DynamicArray< WorkingTrackData >& rWorkingTracks, bool bStripNamespaces );
 
         bool BuildMeshFromScene(
-            FbxScene* pScene, DynamicArray< StaticMeshVertex< 1 > >& rVertices, DynamicArray< uint16_t >& rIndices,
-            DynamicArray< uint16_t >& rSectionVertexCounts, DynamicArray< uint32_t >& rSectionTriangleCounts,
+            FbxScene* pScene, DynamicArray< StaticMeshVertex< 1 > >& rVertices, DynamicArray< uint32_t >& rIndices,
+            DynamicArray< uint32_t >& rSectionVertexCounts, DynamicArray< uint32_t >& rSectionTriangleCounts,
             DynamicArray< BoneData >& rBones, DynamicArray< BlendData >& rVertexBlendData,
             DynamicArray< uint8_t >& rSkinningPaletteMap, bool bStripNamespaces );
         bool BuildAnimationFromScene(
@@ -0,0 +1,1005 @@
+#include "Precompile.h"
+
+#if HELIUM_TOOLS
+
+#include "EditorSupport/MeshOptimizer.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/Vector3.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Helium;
+
+// Vertex cache optimization scoring parameters (see Tom Forsyth, "Linear-Speed Vertex Cache Optimisation").
+static const float32_t CACHE_DECAY_POWER = 1.5f;
+static const float32_t LAST_TRIANGLE_SCORE = 0.75f;
+static const float32_t VALENCE_BOOST_SCALE = 2.0f;
+static const float32_t VALENCE_BOOST_POWER = 0.5f;
+
+// Symmetric 4x4 error quadric accumulating the squared distance to a set of planes.
+struct ErrorQuadric
+{
+    float64_t a2, b2, c2, ab, ac, bc, ad, bd, cd, d2;
+};
+
+// Pending edge collapse for mesh simplification.
+struct EdgeCollapse
+{
+    float64_t cost;
+    uint32_t from;
+    uint32_t to;
+
+    bool operator<( const EdgeCollapse& rOther ) const
+    {
+        if( cost != rOther.cost )
+        {
+            return cost < rOther.cost;
+        }
+
+        return ( from != rOther.from ? from < rOther.from : to < rOther.to );
+    }
+};
+
+// Sort key for a triangle cluster when optimizing for overdraw.
+struct ClusterSortKey
+{
+    float32_t key;
+    uint32_t cluster;
+
+    bool operator<( const ClusterSortKey& rOther ) const
+    {
+        // Clusters facing away from the mesh center are drawn first, as they are the most likely to occlude others.
+        return ( key != rOther.key ? key > rOther.key : cluster < rOther.cluster );
+    }
+};
+
+/// Build the list of triangles referencing each vertex.
+///
+/// @param[in]  pIndices            Triangle list indices.
+/// @param[in]  indexCount          Number of indices.
+/// @param[in]  vertexCount         Number of vertices addressed by the triangle list.
+/// @param[out] rOffsets            Offset of the first triangle referencing each vertex in the adjacent triangle
+///                                 list (an additional entry holds the size of the list).
+/// @param[out] rTriangles          Indices of the triangles referencing each vertex.
+static void BuildTriangleAdjacency(
+    const uint32_t* pIndices,
+    size_t indexCount,
+    size_t vertexCount,
+    DynamicArray< uint32_t >& rOffsets,
+    DynamicArray< uint32_t >& rTriangles )
+{
+    rOffsets.Resize( vertexCount + 1 );
+    MemoryZero( rOffsets.GetData(), sizeof( uint32_t ) * ( vertexCount + 1 ) );
+
+    for( size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex )
+    {
+        HELIUM_ASSERT( pIndices[ indexIndex ] < vertexCount );
+        ++rOffsets[ pIndices[ indexIndex ] + 1 ];
+    }
+
+    for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+    {
+        rOffsets[ vertexIndex + 1 ] += rOffsets[ vertexIndex ];
+    }
+
+    DynamicArray< uint32_t > cursors;
+    cursors.Resize( vertexCount );
+    MemoryCopy( cursors.GetData(), rOffsets.GetData(), sizeof( uint32_t ) * vertexCount );
+
+    rTriangles.Resize( indexCount );
+    for( size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex )
+    {
+        rTriangles[ cursors[ pIndices[ indexIndex ] ]++ ] = static_cast< uint32_t >( indexIndex / 3 );
+    }
+}
+
+/// Compute the score of a vertex when optimizing for the post-transform vertex cache.
+///
+/// @param[in] cachePosition           Position of the vertex in the simulated cache, or -1 if not cached.
+/// @param[in] remainingTriangleCount  Number of triangles referencing the vertex that have yet to be emitted.
+///
+/// @return  Vertex score.
+static float32_t ComputeVertexCacheScore( int32_t cachePosition, uint32_t remainingTriangleCount )
+{
+    if( remainingTriangleCount == 0 )
+    {
+        return -1.0f;
+    }
+
+    float32_t score = 0.0f;
+    if( cachePosition >= 0 )
+    {
+        if( cachePosition < 3 )
+        {
+            // Vertices used by the last triangle get a fixed score so the optimizer doesn't favor strips.
+            score = LAST_TRIANGLE_SCORE;
+        }
+        else
+        {
+            float32_t scale = 1.0f / static_cast< float32_t >( MeshOptimizer::VERTEX_CACHE_SIZE - 3 );
+            score = powf( 1.0f - static_cast< float32_t >( cachePosition - 3 ) * scale, CACHE_DECAY_POWER );
+        }
+    }
+
+    // Boost vertices with few remaining triangles so they get finished off instead of lingering.
+    score += VALENCE_BOOST_SCALE * powf( static_cast< float32_t >( remainingTriangleCount ), -VALENCE_BOOST_POWER );
+
+    return score;
+}
+
+/// Get the position of a vertex.
+///
+/// @param[in] rVertex  Vertex.
+///
+/// @return  Vertex position.
+static Simd::Vector3 GetVertexPosition( const StaticMeshVertex< 1 >& rVertex )
+{
+    return Simd::Vector3( rVertex.position[ 0 ], rVertex.position[ 1 ], rVertex.position[ 2 ] );
+}
+
+/// Add a plane to an error quadric.
+///
+/// @param[in] rQuadric  Quadric to update.
+/// @param[in] rNormal   Plane normal (unit length).
+/// @param[in] distance  Plane distance term.
+static void AddQuadricPlane( ErrorQuadric& rQuadric, const Simd::Vector3& rNormal, float32_t distance )
+{
+    float64_t a = rNormal.GetElement( 0 );
+    float64_t b = rNormal.GetElement( 1 );
+    float64_t c = rNormal.GetElement( 2 );
+    float64_t d = distance;
+
+    rQuadric.a2 += a * a;
+    rQuadric.b2 += b * b;
+    rQuadric.c2 += c * c;
+    rQuadric.ab += a * b;
+    rQuadric.ac += a * c;
+    rQuadric.bc += b * c;
+    rQuadric.ad += a * d;
+    rQuadric.bd += b * d;
+    rQuadric.cd += c * d;
+    rQuadric.d2 += d * d;
+}
+
+/// Add one error quadric to another.
+///
+/// @param[in] rQuadric  Quadric to update.
+/// @param[in] rOther    Quadric to add.
+static void AddQuadric( ErrorQuadric& rQuadric, const ErrorQuadric& rOther )
+{
+    rQuadric.a2 += rOther.a2;
+    rQuadric.b2 += rOther.b2;
+    rQuadric.c2 += rOther.c2;
+    rQuadric.ab += rOther.ab;
+    rQuadric.ac += rOther.ac;
+    rQuadric.bc += rOther.bc;
+    rQuadric.ad += rOther.ad;
+    rQuadric.bd += rOther.bd;
+    rQuadric.cd += rOther.cd;
+    rQuadric.d2 += rOther.d2;
+}
+
+/// Evaluate the combined error of two quadrics at a given position.
+///
+/// @param[in] rQuadric0  First quadric.
+/// @param[in] rQuadric1  Second quadric.
+/// @param[in] rPosition  Position at which to evaluate the error.
+///
+/// @return  Sum of the squared distances from the position to each plane in both quadrics.
+static float64_t EvaluateQuadrics(
+    const ErrorQuadric& rQuadric0,
+    const ErrorQuadric& rQuadric1,
+    const Simd::Vector3& rPosition )
+{
+    float64_t x = rPosition.GetElement( 0 );
+    float64_t y = rPosition.GetElement( 1 );
+    float64_t z = rPosition.GetElement( 2 );
+
+    float64_t error =
+        ( rQuadric0.a2 + rQuadric1.a2 ) * x * x +
+        ( rQuadric0.b2 + rQuadric1.b2 ) * y * y +
+        ( rQuadric0.c2 + rQuadric1.c2 ) * z * z +
+        2.0 * ( ( rQuadric0.ab + rQuadric1.ab ) * x * y +
+                ( rQuadric0.ac + rQuadric1.ac ) * x * z +
+                ( rQuadric0.bc + rQuadric1.bc ) * y * z +
+                ( rQuadric0.ad + rQuadric1.ad ) * x +
+                ( rQuadric0.bd + rQuadric1.bd ) * y +
+                ( rQuadric0.cd + rQuadric1.cd ) * z ) +
+        ( rQuadric0.d2 + rQuadric1.d2 );
+
+    return ( error > 0.0 ? error : 0.0 );
+}
+
+/// Reorder triangles to improve post-transform vertex cache reuse.
+///
+/// Triangles are emitted greedily, always picking the triangle with the highest combined vertex score, where vertices
+/// score higher the more recently they entered the simulated cache and the fewer triangles remain to use them.
+///
+/// @param[in,out] pIndices     Triangle list indices to reorder.
+/// @param[in]     indexCount   Number of indices.
+/// @param[in]     vertexCount  Number of vertices addressed by the triangle list.
+void MeshOptimizer::OptimizeVertexCache( uint32_t* pIndices, size_t indexCount, size_t vertexCount )
+{
+    HELIUM_ASSERT( pIndices || indexCount == 0 );
+    HELIUM_ASSERT( indexCount % 3 == 0 );
+
+    size_t triangleCount = indexCount / 3;
+    if( triangleCount <= 1 )
+    {
+        return;
+    }
+
+    DynamicArray< uint32_t > sourceIndices;
+    sourceIndices.Resize( indexCount );
+    MemoryCopy( sourceIndices.GetData(), pIndices, sizeof( uint32_t ) * indexCount );
+
+    // The first remainingCounts[ v ] entries of each vertex's adjacency list are the triangles yet to be emitted.
+    DynamicArray< uint32_t > adjacencyOffsets;
+    DynamicArray< uint32_t > adjacentTriangles;
+    BuildTriangleAdjacency( pIndices, indexCount, vertexCount, adjacencyOffsets, adjacentTriangles );
+
+    DynamicArray< uint32_t > remainingCounts;
+    DynamicArray< int32_t > cachePositions;
+    DynamicArray< float32_t > vertexScores;
+    remainingCounts.Resize( vertexCount );
+    cachePositions.Resize( vertexCount );
+    vertexScores.Resize( vertexCount );
+    for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+    {
+        remainingCounts[ vertexIndex ] = adjacencyOffsets[ vertexIndex + 1 ] - adjacencyOffsets[ vertexIndex ];
+        cachePositions[ vertexIndex ] = -1;
+        vertexScores[ vertexIndex ] = ComputeVertexCacheScore( -1, remainingCounts[ vertexIndex ] );
+    }
+
+    DynamicArray< uint8_t > triangleEmitted;
+    triangleEmitted.Resize( triangleCount );
+    MemoryZero( triangleEmitted.GetData(), triangleCount );
+
+    // Start with the highest scoring triangle overall.
+    uint32_t bestTriangle = 0;
+    float32_t bestScore = -1.0f;
+    for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+    {
+        const uint32_t* pTriangle = &sourceIndices[ triangleIndex * 3 ];
+        float32_t score =
+            vertexScores[ pTriangle[ 0 ] ] + vertexScores[ pTriangle[ 1 ] ] + vertexScores[ pTriangle[ 2 ] ];
+        if( score > bestScore )
+        {
+            bestScore = score;
+            bestTriangle = static_cast< uint32_t >( triangleIndex );
+        }
+    }
+
+    uint32_t cache[ VERTEX_CACHE_SIZE + 3 ];
+    uint32_t newCache[ VERTEX_CACHE_SIZE + 3 ];
+    size_t cacheCount = 0;
+
+    size_t searchStart = 0;
+    for( size_t emitIndex = 0; emitIndex < triangleCount; ++emitIndex )
+    {
+        if( IsInvalid( bestTriangle ) )
+        {
+            // None of the triangles using cached vertices remain, so continue from the next unemitted triangle.
+            while( triangleEmitted[ searchStart ] )
+            {
+                ++searchStart;
+            }
+
+            bestTriangle = static_cast< uint32_t >( searchStart );
+        }
+
+        HELIUM_ASSERT( !triangleEmitted[ bestTriangle ] );
+        triangleEmitted[ bestTriangle ] = 1;
+
+        const uint32_t* pTriangle = &sourceIndices[ bestTriangle * 3 ];
+        pIndices[ emitIndex * 3 ] = pTriangle[ 0 ];
+        pIndices[ emitIndex * 3 + 1 ] = pTriangle[ 1 ];
+        pIndices[ emitIndex * 3 + 2 ] = pTriangle[ 2 ];
+
+        // Push the triangle's vertices to the front of the cache and remove the triangle from their adjacency lists.
+        size_t newCacheCount = 0;
+        for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+        {
+            uint32_t vertexIndex = pTriangle[ cornerIndex ];
+
+            uint32_t* pAdjacent = &adjacentTriangles[ adjacencyOffsets[ vertexIndex ] ];
+            uint32_t remainingCount = remainingCounts[ vertexIndex ];
+            for( uint32_t adjacentIndex = 0; adjacentIndex < remainingCount; ++adjacentIndex )
+            {
+                if( pAdjacent[ adjacentIndex ] == bestTriangle )
+                {
+                    pAdjacent[ adjacentIndex ] = pAdjacent[ remainingCount - 1 ];
+                    pAdjacent[ remainingCount - 1 ] = bestTriangle;
+                    --remainingCounts[ vertexIndex ];
+
+                    break;
+                }
+            }
+
+            size_t cacheIndex;
+            for( cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex )
+            {
+                if( newCache[ cacheIndex ] == vertexIndex )
+                {
+                    break;
+                }
+            }
+
+            if( cacheIndex == newCacheCount )
+            {
+                newCache[ newCacheCount++ ] = vertexIndex;
+            }
+        }
+
+        for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+        {
+            uint32_t vertexIndex = cache[ cacheIndex ];
+            if( vertexIndex != pTriangle[ 0 ] && vertexIndex != pTriangle[ 1 ] && vertexIndex != pTriangle[ 2 ] )
+            {
+                newCache[ newCacheCount++ ] = vertexIndex;
+            }
+        }
+
+        // Update the scores of all vertices whose cache position changed, including those pushed out of the cache.
+        for( size_t cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex )
+        {
+            uint32_t vertexIndex = newCache[ cacheIndex ];
+            int32_t cachePosition = ( cacheIndex < VERTEX_CACHE_SIZE ? static_cast< int32_t >( cacheIndex ) : -1 );
+            cachePositions[ vertexIndex ] = cachePosition;
+            vertexScores[ vertexIndex ] = ComputeVertexCacheScore( cachePosition, remainingCounts[ vertexIndex ] );
+        }
+
+        cacheCount = Min< size_t >( newCacheCount, VERTEX_CACHE_SIZE );
+        MemoryCopy( cache, newCache, sizeof( uint32_t ) * cacheCount );
+
+        // Pick the next triangle from those using the updated vertices.
+        bestTriangle = Invalid< uint32_t >();
+        bestScore = -1.0f;
+        for( size_t cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex )
+        {
+            uint32_t vertexIndex = newCache[ cacheIndex ];
+
+            const uint32_t* pAdjacent = &adjacentTriangles[ adjacencyOffsets[ vertexIndex ] ];
+            uint32_t remainingCount = remainingCounts[ vertexIndex ];
+            for( uint32_t adjacentIndex = 0; adjacentIndex < remainingCount; ++adjacentIndex )
+            {
+                uint32_t triangleIndex = pAdjacent[ adjacentIndex ];
+                const uint32_t* pAdjacentTriangle = &sourceIndices[ triangleIndex * 3 ];
+                float32_t score =
+                    vertexScores[ pAdjacentTriangle[ 0 ] ] +
+                    vertexScores[ pAdjacentTriangle[ 1 ] ] +
+                    vertexScores[ pAdjacentTriangle[ 2 ] ];
+                if( score > bestScore )
+                {
+                    bestScore = score;
+                    bestTriangle = triangleIndex;
+                }
+            }
+        }
+    }
+}
+
+/// Reorder clusters of triangles to reduce overdraw without significantly reducing vertex cache efficiency.
+///
+/// The triangle list (which should already be optimized for the vertex cache) is split into clusters wherever the
+/// simulated vertex cache effectively restarts, and again wherever the cache miss ratio so far is within the given
+/// threshold of the ratio for the enclosing cluster.  Clusters are then sorted so that those facing away from the
+/// center of the mesh, which are the most likely to occlude others, are drawn first.
+///
+/// @param[in,out] pIndices     Triangle list indices to reorder.
+/// @param[in]     indexCount   Number of indices.
+/// @param[in]     pVertices    Vertices addressed by the triangle list.
+/// @param[in]     vertexCount  Number of vertices.
+/// @param[in]     threshold    Maximum ratio by which the cache miss ratio of a cluster can exceed that of the
+///                             cluster from which it was split (1.05 is a reasonable default).
+void MeshOptimizer::OptimizeOverdraw(
+    uint32_t* pIndices,
+    size_t indexCount,
+    const StaticMeshVertex< 1 >* pVertices,
+    size_t vertexCount,
+    float32_t threshold )
+{
+    HELIUM_ASSERT( pIndices || indexCount == 0 );
+    HELIUM_ASSERT( pVertices || vertexCount == 0 );
+    HELIUM_ASSERT( indexCount % 3 == 0 );
+
+    size_t triangleCount = indexCount / 3;
+    if( triangleCount <= 1 )
+    {
+        return;
+    }
+
+    // Vertices with a timestamp more than the cache size behind the current time are no longer cached.
+    DynamicArray< uint32_t > timestamps;
+    timestamps.Resize( vertexCount );
+    MemoryZero( timestamps.GetData(), sizeof( uint32_t ) * vertexCount );
+    uint32_t time = VERTEX_CACHE_SIZE + 1;
+
+    // Hard cluster boundaries fall on triangles for which every vertex misses the cache.
+    DynamicArray< uint32_t > hardClusters;
+    for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+    {
+        uint32_t missCount = 0;
+        for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+        {
+            uint32_t vertexIndex = pIndices[ triangleIndex * 3 + cornerIndex ];
+            if( time - timestamps[ vertexIndex ] > VERTEX_CACHE_SIZE )
+            {
+                timestamps[ vertexIndex ] = time++;
+                ++missCount;
+            }
+        }
+
+        if( triangleIndex == 0 || missCount == 3 )
+        {
+            hardClusters.Push( static_cast< uint32_t >( triangleIndex ) );
+        }
+    }
+
+    hardClusters.Push( static_cast< uint32_t >( triangleCount ) );
+
+    // Split the hard clusters further while the cache miss ratio stays within the threshold.
+    DynamicArray< uint32_t > clusters;
+    size_t hardClusterCount = hardClusters.GetSize() - 1;
+    for( size_t hardClusterIndex = 0; hardClusterIndex < hardClusterCount; ++hardClusterIndex )
+    {
+        uint32_t clusterStart = hardClusters[ hardClusterIndex ];
+        uint32_t clusterEnd = hardClusters[ hardClusterIndex + 1 ];
+
+        time += VERTEX_CACHE_SIZE + 1;
+        uint32_t clusterMissCount = 0;
+        for( uint32_t indexIndex = clusterStart * 3; indexIndex < clusterEnd * 3; ++indexIndex )
+        {
+            uint32_t vertexIndex = pIndices[ indexIndex ];
+            if( time - timestamps[ vertexIndex ] > VERTEX_CACHE_SIZE )
+            {
+                timestamps[ vertexIndex ] = time++;
+                ++clusterMissCount;
+            }
+        }
+
+        float32_t clusterThreshold =
+            threshold * static_cast< float32_t >( clusterMissCount ) /
+            static_cast< float32_t >( clusterEnd - clusterStart );
+
+        time += VERTEX_CACHE_SIZE + 1;
+        clusters.Push( clusterStart );
+
+        uint32_t runMissCount = 0;
+        uint32_t runTriangleCount = 0;
+        for( uint32_t triangleIndex = clusterStart; triangleIndex < clusterEnd; ++triangleIndex )
+        {
+            for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+            {
+                uint32_t vertexIndex = pIndices[ triangleIndex * 3 + cornerIndex ];
+                if( time - timestamps[ vertexIndex ] > VERTEX_CACHE_SIZE )
+                {
+                    timestamps[ vertexIndex ] = time++;
+                    ++runMissCount;
+                }
+            }
+
+            ++runTriangleCount;
+
+            if( triangleIndex + 1 < clusterEnd &&
+                static_cast< float32_t >( runMissCount ) <=
+                    clusterThreshold * static_cast< float32_t >( runTriangleCount ) )
+            {
+                clusters.Push( triangleIndex + 1 );
+                runMissCount = 0;
+                runTriangleCount = 0;
+                time += VERTEX_CACHE_SIZE + 1;
+            }
+        }
+    }
+
+    clusters.Push( static_cast< uint32_t >( triangleCount ) );
+
+    // Compute the area-weighted centroid of the mesh.
+    Simd::Vector3 meshCentroid( 0.0f );
+    float32_t meshArea = 0.0f;
+    for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+    {
+        Simd::Vector3 position0 = GetVertexPosition( pVertices[ pIndices[ triangleIndex * 3 ] ] );
+        Simd::Vector3 position1 = GetVertexPosition( pVertices[ pIndices[ triangleIndex * 3 + 1 ] ] );
+        Simd::Vector3 position2 = GetVertexPosition( pVertices[ pIndices[ triangleIndex * 3 + 2 ] ] );
+
+        float32_t area = ( position1 - position0 ).Cross( position2 - position0 ).GetMagnitude();
+        meshCentroid += ( position0 + position1 + position2 ) * area;
+        meshArea += area * 3.0f;
+    }
+
+    if( meshArea > HELIUM_EPSILON )
+    {
+        meshCentroid *= 1.0f / meshArea;
+    }
+
+    // Sort the clusters by how far they face away from the mesh centroid.  Vertex normals are used rather than the
+    // triangle winding so the result doesn't depend on the handedness of the source data.
+    size_t clusterCount = clusters.GetSize() - 1;
+    DynamicArray< ClusterSortKey > sortKeys;
+    sortKeys.Resize( clusterCount );
+    for( size_t clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex )
+    {
+        Simd::Vector3 clusterCentroid( 0.0f );
+        Simd::Vector3 clusterNormal( 0.0f );
+        float32_t clusterArea = 0.0f;
+        for( uint32_t triangleIndex = clusters[ clusterIndex ];
+            triangleIndex < clusters[ clusterIndex + 1 ];
+            ++triangleIndex )
+        {
+            const StaticMeshVertex< 1 >& rVertex0 = pVertices[ pIndices[ triangleIndex * 3 ] ];
+            const StaticMeshVertex< 1 >& rVertex1 = pVertices[ pIndices[ triangleIndex * 3 + 1 ] ];
+            const StaticMeshVertex< 1 >& rVertex2 = pVertices[ pIndices[ triangleIndex * 3 + 2 ] ];
+
+            Simd::Vector3 position0 = GetVertexPosition( rVertex0 );
+            Simd::Vector3 position1 = GetVertexPosition( rVertex1 );
+            Simd::Vector3 position2 = GetVertexPosition( rVertex2 );
+
+            float32_t area = ( position1 - position0 ).Cross( position2 - position0 ).GetMagnitude();
+            clusterCentroid += ( position0 + position1 + position2 ) * area;
+            clusterArea += area * 3.0f;
+
+            Simd::Vector3 normal(
+                static_cast< float32_t >( rVertex0.normal[ 0 ] ) + static_cast< float32_t >( rVertex1.normal[ 0 ] ) +
+                static_cast< float32_t >( rVertex2.normal[ 0 ] ) - 3.0f * 128.0f,
+                static_cast< float32_t >( rVertex0.normal[ 1 ] ) + static_cast< float32_t >( rVertex1.normal[ 1 ] ) +
+                static_cast< float32_t >( rVertex2.normal[ 1 ] ) - 3.0f * 128.0f,
+                static_cast< float32_t >( rVertex0.normal[ 2 ] ) + static_cast< float32_t >( rVertex1.normal[ 2 ] ) +
+                static_cast< float32_t >( rVertex2.normal[ 2 ] ) - 3.0f * 128.0f );
+            clusterNormal += normal * area;
+        }
+
+        float32_t key = 0.0f;
+        if( clusterArea > HELIUM_EPSILON )
+        {
+            clusterCentroid *= 1.0f / clusterArea;
+
+            float32_t normalMagnitude = clusterNormal.GetMagnitude();
+            if( normalMagnitude > HELIUM_EPSILON )
+            {
+                key = ( clusterCentroid - meshCentroid ).Dot( clusterNormal ) / normalMagnitude;
+            }
+        }
+
+        sortKeys[ clusterIndex ].key = key;
+        sortKeys[ clusterIndex ].cluster = static_cast< uint32_t >( clusterIndex );
+    }
+
+    std::sort( sortKeys.GetData(), sortKeys.GetData() + clusterCount );
+
+    DynamicArray< uint32_t > sourceIndices;
+    sourceIndices.Resize( indexCount );
+    MemoryCopy( sourceIndices.GetData(), pIndices, sizeof( uint32_t ) * indexCount );
+
+    size_t destinationIndex = 0;
+    for( size_t sortIndex = 0; sortIndex < clusterCount; ++sortIndex )
+    {
+        uint32_t clusterIndex = sortKeys[ sortIndex ].cluster;
+        size_t clusterIndexStart = static_cast< size_t >( clusters[ clusterIndex ] ) * 3;
+        size_t clusterIndexCount = static_cast< size_t >( clusters[ clusterIndex + 1 ] ) * 3 - clusterIndexStart;
+        MemoryCopy(
+            pIndices + destinationIndex,
+            sourceIndices.GetData() + clusterIndexStart,
+            sizeof( uint32_t ) * clusterIndexCount );
+        destinationIndex += clusterIndexCount;
+    }
+
+    HELIUM_ASSERT( destinationIndex == indexCount );
+}
+
+/// Compute a vertex order that improves vertex fetch locality for a triangle list.
+///
+/// Vertices are ordered by their first use in the triangle list, with any unused vertices placed at the end, and the
+/// triangle list indices are updated to match.  The caller is responsible for moving each vertex to its new location.
+///
+/// @param[in,out] pIndices     Triangle list indices to update.
+/// @param[in]     indexCount   Number of indices.
+/// @param[in]     vertexCount  Number of vertices addressed by the triangle list.
+/// @param[out]    pRemap       New index of each vertex (must hold @c vertexCount entries).
+void MeshOptimizer::OptimizeVertexFetch( uint32_t* pIndices, size_t indexCount, size_t vertexCount, uint32_t* pRemap )
+{
+    HELIUM_ASSERT( pIndices || indexCount == 0 );
+    HELIUM_ASSERT( pRemap || vertexCount == 0 );
+
+    for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+    {
+        SetInvalid( pRemap[ vertexIndex ] );
+    }
+
+    uint32_t nextVertex = 0;
+    for( size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex )
+    {
+        uint32_t& rIndex = pIndices[ indexIndex ];
+        HELIUM_ASSERT( rIndex < vertexCount );
+
+        uint32_t& rRemap = pRemap[ rIndex ];
+        if( IsInvalid( rRemap ) )
+        {
+            rRemap = nextVertex++;
+        }
+
+        rIndex = rRemap;
+    }
+
+    for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+    {
+        if( IsInvalid( pRemap[ vertexIndex ] ) )
+        {
+            pRemap[ vertexIndex ] = nextVertex++;
+        }
+    }
+
+    HELIUM_ASSERT( nextVertex == vertexCount );
+}
+
+/// Simplify a triangle list by collapsing edges.
+///
+/// Each pass collapses the edges with the lowest quadric error metric cost, moving one end of the edge onto the other
+/// so that the vertex buffer itself is left untouched.  Vertices on mesh borders and on attribute seams (vertices that
+/// share a position with another vertex) are never moved, which prevents holes from opening up at the expense of
+/// limiting how far heavily seamed meshes can be reduced.
+///
+/// @param[out] pDestination      Simplified triangle list indices (must hold @c indexCount entries, and may be the
+///                               same as @c pIndices).
+/// @param[in]  pIndices          Triangle list indices to simplify.
+/// @param[in]  indexCount        Number of indices.
+/// @param[in]  pVertices         Vertices addressed by the triangle list.
+/// @param[in]  vertexCount       Number of vertices.
+/// @param[in]  targetIndexCount  Number of indices at which to stop simplifying.
+/// @param[in]  maxError          Maximum error introduced by each collapse, relative to the size of the mesh.
+///
+/// @return  Number of indices in the simplified triangle list.
+size_t MeshOptimizer::Simplify(
+    uint32_t* pDestination,
+    const uint32_t* pIndices,
+    size_t indexCount,
+    const StaticMeshVertex< 1 >* pVertices,
+    size_t vertexCount,
+    size_t targetIndexCount,
+    float32_t maxError )
+{
+    HELIUM_ASSERT( pDestination || indexCount == 0 );
+    HELIUM_ASSERT( pIndices || indexCount == 0 );
+    HELIUM_ASSERT( pVertices || vertexCount == 0 );
+    HELIUM_ASSERT( indexCount % 3 == 0 );
+
+    if( pDestination != pIndices )
+    {
+        MemoryCopy( pDestination, pIndices, sizeof( uint32_t ) * indexCount );
+    }
+
+    if( indexCount <= targetIndexCount || vertexCount == 0 )
+    {
+        return indexCount;
+    }
+
+    // Lock vertices on attribute seams.
+    DynamicArray< uint8_t > vertexLocked;
+    vertexLocked.Resize( vertexCount );
+    MemoryZero( vertexLocked.GetData(), vertexCount );
+
+    DynamicArray< uint32_t > positionOrder;
+    positionOrder.Resize( vertexCount );
+    for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+    {
+        positionOrder[ vertexIndex ] = static_cast< uint32_t >( vertexIndex );
+    }
+
+    std::sort(
+        positionOrder.GetData(),
+        positionOrder.GetData() + vertexCount,
+        [pVertices]( uint32_t vertexIndex0, uint32_t vertexIndex1 ) -> bool
+        {
+            const float32_t* pPosition0 = pVertices[ vertexIndex0 ].position;
+            const float32_t* pPosition1 = pVertices[ vertexIndex1 ].position;
+            if( pPosition0[ 0 ] != pPosition1[ 0 ] )
+            {
+                return pPosition0[ 0 ] < pPosition1[ 0 ];
+            }
+            if( pPosition0[ 1 ] != pPosition1[ 1 ] )
+            {
+                return pPosition0[ 1 ] < pPosition1[ 1 ];
+            }
+
+            return pPosition0[ 2 ] < pPosition1[ 2 ];
+        } );
+
+    for( size_t orderIndex = 1; orderIndex < vertexCount; ++orderIndex )
+    {
+        const float32_t* pPosition0 = pVertices[ positionOrder[ orderIndex - 1 ] ].position;
+        const float32_t* pPosition1 = pVertices[ positionOrder[ orderIndex ] ].position;
+        if( pPosition0[ 0 ] == pPosition1[ 0 ] && pPosition0[ 1 ] == pPosition1[ 1 ] &&
+            pPosition0[ 2 ] == pPosition1[ 2 ] )
+        {
+            vertexLocked[ positionOrder[ orderIndex - 1 ] ] = 1;
+            vertexLocked[ positionOrder[ orderIndex ] ] = 1;
+        }
+    }
+
+    // Lock vertices on border and non-manifold edges (edges not shared by exactly two triangles).
+    DynamicArray< uint64_t > edges;
+    edges.Resize( indexCount );
+    for( size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex )
+    {
+        uint32_t vertexIndex0 = pIndices[ indexIndex ];
+        uint32_t vertexIndex1 = pIndices[ indexIndex - indexIndex % 3 + ( indexIndex + 1 ) % 3 ];
+        edges[ indexIndex ] =
+            ( static_cast< uint64_t >( Min( vertexIndex0, vertexIndex1 ) ) << 32 ) | Max( vertexIndex0, vertexIndex1 );
+    }
+
+    std::sort( edges.GetData(), edges.GetData() + indexCount );
+
+    for( size_t edgeStart = 0; edgeStart < indexCount; )
+    {
+        size_t edgeEnd = edgeStart + 1;
+        while( edgeEnd < indexCount && edges[ edgeEnd ] == edges[ edgeStart ] )
+        {
+            ++edgeEnd;
+        }
+
+        if( edgeEnd - edgeStart != 2 )
+        {
+            vertexLocked[ static_cast< uint32_t >( edges[ edgeStart ] >> 32 ) ] = 1;
+            vertexLocked[ static_cast< uint32_t >( edges[ edgeStart ] ) ] = 1;
+        }
+
+        edgeStart = edgeEnd;
+    }
+
+    // Accumulate the plane of each triangle into the quadrics of its vertices, and compute the size of the mesh.
+    DynamicArray< ErrorQuadric > quadrics;
+    quadrics.Resize( vertexCount );
+    MemoryZero( quadrics.GetData(), sizeof( ErrorQuadric ) * vertexCount );
+
+    size_t triangleCount = indexCount / 3;
+    for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+    {
+        const uint32_t* pTriangle = pIndices + triangleIndex * 3;
+        Simd::Vector3 position0 = GetVertexPosition( pVertices[ pTriangle[ 0 ] ] );
+        Simd::Vector3 position1 = GetVertexPosition( pVertices[ pTriangle[ 1 ] ] );
+        Simd::Vector3 position2 = GetVertexPosition( pVertices[ pTriangle[ 2 ] ] );
+
+        Simd::Vector3 normal = ( position1 - position0 ).Cross( position2 - position0 );
+        float32_t normalMagnitude = normal.GetMagnitude();
+        if( normalMagnitude <= HELIUM_EPSILON )
+        {
+            continue;
+        }
+
+        normal *= 1.0f / normalMagnitude;
+        float32_t distance = -normal.Dot( position0 );
+
+        AddQuadricPlane( quadrics[ pTriangle[ 0 ] ], normal, distance );
+        AddQuadricPlane( quadrics[ pTriangle[ 1 ] ], normal, distance );
+        AddQuadricPlane( quadrics[ pTriangle[ 2 ] ], normal, distance );
+    }
+
+    Simd::Vector3 boundsMin = GetVertexPosition( pVertices[ 0 ] );
+    Simd::Vector3 boundsMax = boundsMin;
+    for( size_t vertexIndex = 1; vertexIndex < vertexCount; ++vertexIndex )
+    {
+        const float32_t* pPosition = pVertices[ vertexIndex ].position;
+        for( size_t axisIndex = 0; axisIndex < 3; ++axisIndex )
+        {
+            boundsMin.SetElement( axisIndex, Min( boundsMin.GetElement( axisIndex ), pPosition[ axisIndex ] ) );
+            boundsMax.SetElement( axisIndex, Max( boundsMax.GetElement( axisIndex ), pPosition[ axisIndex ] ) );
+        }
+    }
+
+    Simd::Vector3 extents = boundsMax - boundsMin;
+    float64_t meshSize = Max( extents.GetElement( 0 ), Max( extents.GetElement( 1 ), extents.GetElement( 2 ) ) );
+    float64_t maxCost = static_cast< float64_t >( maxError ) * meshSize;
+    maxCost *= maxCost;
+
+    DynamicArray< uint32_t > adjacencyOffsets;
+    DynamicArray< uint32_t > adjacentTriangles;
+    DynamicArray< EdgeCollapse > collapses;
+    DynamicArray< uint32_t > remap;
+    DynamicArray< uint8_t > vertexTouched;
+    remap.Resize( vertexCount );
+    vertexTouched.Resize( vertexCount );
+
+    size_t currentIndexCount = indexCount;
+    while( currentIndexCount > targetIndexCount )
+    {
+        BuildTriangleAdjacency( pDestination, currentIndexCount, vertexCount, adjacencyOffsets, adjacentTriangles );
+
+        // Gather every possible collapse of each edge onto one of its end points.
+        collapses.Resize( 0 );
+        for( size_t indexIndex = 0; indexIndex < currentIndexCount; ++indexIndex )
+        {
+            uint32_t vertexIndex0 = pDestination[ indexIndex ];
+            uint32_t vertexIndex1 = pDestination[ indexIndex - indexIndex % 3 + ( indexIndex + 1 ) % 3 ];
+
+            const ErrorQuadric& rQuadric0 = quadrics[ vertexIndex0 ];
+            const ErrorQuadric& rQuadric1 = quadrics[ vertexIndex1 ];
+
+            if( !vertexLocked[ vertexIndex0 ] )
+            {
+                EdgeCollapse* pCollapse = collapses.New();
+                HELIUM_ASSERT( pCollapse );
+                pCollapse->cost = EvaluateQuadrics( rQuadric0, rQuadric1, GetVertexPosition( pVertices[ vertexIndex1 ] ) );
+                pCollapse->from = vertexIndex0;
+                pCollapse->to = vertexIndex1;
+            }
+
+            if( !vertexLocked[ vertexIndex1 ] )
+            {
+                EdgeCollapse* pCollapse = collapses.New();
+                HELIUM_ASSERT( pCollapse );
+                pCollapse->cost = EvaluateQuadrics( rQuadric0, rQuadric1, GetVertexPosition( pVertices[ vertexIndex0 ] ) );
+                pCollapse->from = vertexIndex1;
+                pCollapse->to = vertexIndex0;
+            }
+        }
+
+        std::sort( collapses.GetData(), collapses.GetData() + collapses.GetSize() );
+
+        // Each collapse of an interior edge removes two triangles.
+        size_t collapseLimit = Max< size_t >( ( currentIndexCount - targetIndexCount ) / 6, 1 );
+
+        for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+        {
+            remap[ vertexIndex ] = static_cast< uint32_t >( vertexIndex );
+        }
+
+        MemoryZero( vertexTouched.GetData(), vertexCount );
+
+        size_t collapseCount = 0;
+        size_t candidateCount = collapses.GetSize();
+        for( size_t candidateIndex = 0; candidateIndex < candidateCount && collapseCount < collapseLimit; ++candidateIndex )
+        {
+            const EdgeCollapse& rCollapse = collapses[ candidateIndex ];
+            if( rCollapse.cost > maxCost )
+            {
+                break;
+            }
+
+            // Only collapse edges whose neighborhoods haven't been modified by another collapse in this pass.
+            uint32_t from = rCollapse.from;
+            uint32_t to = rCollapse.to;
+            if( vertexTouched[ from ] || vertexTouched[ to ] )
+            {
+                continue;
+            }
+
+            // Reject collapses that would flip any of the remaining triangles around the vertex being moved.
+            Simd::Vector3 targetPosition = GetVertexPosition( pVertices[ to ] );
+
+            const uint32_t* pAdjacent = &adjacentTriangles[ adjacencyOffsets[ from ] ];
+            uint32_t adjacentCount = adjacencyOffsets[ from + 1 ] - adjacencyOffsets[ from ];
+
+            bool bFlipped = false;
+            for( uint32_t adjacentIndex = 0; adjacentIndex < adjacentCount && !bFlipped; ++adjacentIndex )
+            {
+                const uint32_t* pTriangle = pDestination + static_cast< size_t >( pAdjacent[ adjacentIndex ] ) * 3;
+                if( pTriangle[ 0 ] == to || pTriangle[ 1 ] == to || pTriangle[ 2 ] == to )
+                {
+                    continue;
+                }
+
+                Simd::Vector3 positions[ 3 ];
+                Simd::Vector3 movedPositions[ 3 ];
+                for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+                {
+                    positions[ cornerIndex ] = GetVertexPosition( pVertices[ pTriangle[ cornerIndex ] ] );
+                    movedPositions[ cornerIndex ] =
+                        ( pTriangle[ cornerIndex ] == from ? targetPosition : positions[ cornerIndex ] );
+                }
+
+                Simd::Vector3 normal = ( positions[ 1 ] - positions[ 0 ] ).Cross( positions[ 2 ] - positions[ 0 ] );
+                Simd::Vector3 movedNormal =
+                    ( movedPositions[ 1 ] - movedPositions[ 0 ] ).Cross( movedPositions[ 2 ] - movedPositions[ 0 ] );
+                bFlipped = ( normal.Dot( movedNormal ) <= 0.0f );
+            }
+
+            if( bFlipped )
+            {
+                continue;
+            }
+
+            remap[ from ] = to;
+            AddQuadric( quadrics[ to ], quadrics[ from ] );
+
+            for( uint32_t adjacentIndex = 0; adjacentIndex < adjacentCount; ++adjacentIndex )
+            {
+                const uint32_t* pTriangle = pDestination + static_cast< size_t >( pAdjacent[ adjacentIndex ] ) * 3;
+                vertexTouched[ pTriangle[ 0 ] ] = 1;
+                vertexTouched[ pTriangle[ 1 ] ] = 1;
+                vertexTouched[ pTriangle[ 2 ] ] = 1;
+            }
+
+            ++collapseCount;
+        }
+
+        if( collapseCount == 0 )
+        {
+            break;
+        }
+
+        // Apply the collapses and drop the triangles that became degenerate.
+        size_t writeIndex = 0;
+        for( size_t indexIndex = 0; indexIndex < currentIndexCount; indexIndex += 3 )
+        {
+            uint32_t vertexIndex0 = remap[ pDestination[ indexIndex ] ];
+            uint32_t vertexIndex1 = remap[ pDestination[ indexIndex + 1 ] ];
+            uint32_t vertexIndex2 = remap[ pDestination[ indexIndex + 2 ] ];
+            if( vertexIndex0 != vertexIndex1 && vertexIndex1 != vertexIndex2 && vertexIndex0 != vertexIndex2 )
+            {
+                pDestination[ writeIndex ] = vertexIndex0;
+                pDestination[ writeIndex + 1 ] = vertexIndex1;
+                pDestination[ writeIndex + 2 ] = vertexIndex2;
+                writeIndex += 3;
+            }
+        }
+
+        currentIndexCount = writeIndex;
+    }
+
+    return currentIndexCount;
+}
+
+/// Simulate a FIFO post-transform vertex cache to measure the efficiency of a triangle list.
+///
+/// @param[in] pIndices     Triangle list indices.
+/// @param[in] indexCount   Number of indices.
+/// @param[in] vertexCount  Number of vertices addressed by the triangle list.
+/// @param[in] cacheSize    Number of entries in the simulated cache.
+///
+/// @return  Vertex cache statistics.
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(
+    const uint32_t* pIndices,
+    size_t indexCount,
+    size_t vertexCount,
+    uint32_t cacheSize )
+{
+    HELIUM_ASSERT( pIndices || indexCount == 0 );
+    HELIUM_ASSERT( indexCount % 3 == 0 );
+    HELIUM_ASSERT( cacheSize != 0 );
+
+    VertexCacheStatistics statistics;
+    MemoryZero( &statistics, sizeof( statistics ) );
+
+    DynamicArray< uint32_t > timestamps;
+    timestamps.Resize( vertexCount );
+    MemoryZero( timestamps.GetData(), sizeof( uint32_t ) * vertexCount );
+    uint32_t time = cacheSize + 1;
+
+    for( size_t indexIndex = 0; indexIndex < indexCount; ++indexIndex )
+    {
+        uint32_t vertexIndex = pIndices[ indexIndex ];
+        HELIUM_ASSERT( vertexIndex < vertexCount );
+
+        uint32_t& rTimestamp = timestamps[ vertexIndex ];
+        if( rTimestamp == 0 )
+        {
+            ++statistics.vertexCount;
+        }
+
+        if( time - rTimestamp > cacheSize )
+        {
+            rTimestamp = time++;
+            ++statistics.transformCount;
+        }
+    }
+
+    statistics.triangleCount = static_cast< uint32_t >( indexCount / 3 );
+    if( statistics.triangleCount != 0 )
+    {
+        statistics.acmr =
+            static_cast< float32_t >( statistics.transformCount ) / static_cast< float32_t >( statistics.triangleCount );
+    }
+
+    if( statistics.vertexCount != 0 )
+    {
+        statistics.atvr =
+            static_cast< float32_t >( statistics.transformCount ) / static_cast< float32_t >( statistics.vertexCount );
+    }
+
+    return statistics;
+}
+
+#endif  // HELIUM_TOOLS
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "EditorSupport/EditorSupport.h"
+
+#if HELIUM_TOOLS
+
+#include "GraphicsTypes/VertexTypes.h"
+
+namespace Helium
+{
+    /// Triangle and vertex order optimization for cached mesh data.
+    ///
+    /// Each function operates on the triangle list of a single mesh section, with indices relative to the first vertex
+    /// of the section.
+    class HELIUM_EDITOR_SUPPORT_API MeshOptimizer
+    {
+    public:
+        /// Number of entries in the FIFO post-transform vertex cache simulated when optimizing and analyzing triangle
+        /// order.
+        static const uint32_t VERTEX_CACHE_SIZE = 16;
+
+        /// Post-transform vertex cache statistics.
+        struct VertexCacheStatistics
+        {
+            /// Number of vertices transformed.
+            uint32_t transformCount;
+            /// Number of triangles drawn.
+            uint32_t triangleCount;
+            /// Number of unique vertices referenced.
+            uint32_t vertexCount;
+
+            /// Average cache miss ratio (vertices transformed per triangle, 0.5 is optimal for large meshes).
+            float32_t acmr;
+            /// Average transform to vertex ratio (vertices transformed per referenced vertex, 1.0 is optimal).
+            float32_t atvr;
+        };
+
+        /// @name Optimization
+        //@{
+        static void OptimizeVertexCache( uint32_t* pIndices, size_t indexCount, size_t vertexCount );
+        static void OptimizeOverdraw(
+            uint32_t* pIndices, size_t indexCount, const StaticMeshVertex< 1 >* pVertices, size_t vertexCount,
+            float32_t threshold );
+        static void OptimizeVertexFetch( uint32_t* pIndices, size_t indexCount, size_t vertexCount, uint32_t* pRemap );
+
+        static size_t Simplify(
+            uint32_t* pDestination, const uint32_t* pIndices, size_t indexCount, const StaticMeshVertex< 1 >* pVertices,
+            size_t vertexCount, size_t targetIndexCount, float32_t maxError );
+        //@}
+
+        /// @name Analysis
+        //@{
+        static VertexCacheStatistics AnalyzeVertexCache(
+            const uint32_t* pIndices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = VERTEX_CACHE_SIZE );
+        //@}
+    };
+}
+
+#endif  // HELIUM_TOOLS
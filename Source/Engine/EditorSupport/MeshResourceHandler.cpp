@@ -11,11 +11,235 @@
 #include "PcSupport/AssetPreprocessor.h"
 #include "PcSupport/PlatformPreprocessor.h"
 #include "EditorSupport/FbxSupport.h"
+#include "EditorSupport/MeshOptimizer.h"
 
 HELIUM_IMPLEMENT_ASSET( Helium::MeshResourceHandler, EditorSupport, 0 );
 
 using namespace Helium;
 
+/// Maximum increase in the vertex cache miss ratio allowed when reordering triangles to reduce overdraw.
+static const float32_t OVERDRAW_CACHE_THRESHOLD = 1.05f;
+
+/// Add the vertex cache statistics of a mesh section to the totals for a mesh.
+///
+/// @param[in,out] rTotal    Statistics for the entire mesh.
+/// @param[in]     rSection  Statistics for a single mesh section.
+static void AccumulateVertexCacheStatistics(
+	MeshOptimizer::VertexCacheStatistics& rTotal,
+	const MeshOptimizer::VertexCacheStatistics& rSection )
+{
+	rTotal.transformCount += rSection.transformCount;
+	rTotal.triangleCount += rSection.triangleCount;
+	rTotal.vertexCount += rSection.vertexCount;
+
+	rTotal.acmr = ( rTotal.triangleCount != 0
+		? static_cast< float32_t >( rTotal.transformCount ) / static_cast< float32_t >( rTotal.triangleCount )
+		: 0.0f );
+	rTotal.atvr = ( rTotal.vertexCount != 0
+		? static_cast< float32_t >( rTotal.transformCount ) / static_cast< float32_t >( rTotal.vertexCount )
+		: 0.0f );
+}
+
+/// Optimize the triangle and vertex order of each mesh section and generate any requested levels of detail.
+///
+/// Each optimization pass logs the average cache miss ratio (ACMR) and average transform to vertex ratio (ATVR) of
+/// the mesh before and after the pass.
+///
+/// @param[in]     pMesh                      Mesh being cached.
+/// @param[in]     rSourceFilePath            Path of the mesh source file.
+/// @param[in,out] rVertices                  Mesh vertices.
+/// @param[in,out] rVertexBlendData           Vertex blend data (empty if the mesh is not skinned).
+/// @param[in,out] rIndices                   Mesh indices.  Indices for each generated level of detail are appended.
+/// @param[in]     rSectionVertexCounts       Number of vertices addressed by each mesh section.
+/// @param[in]     rSectionTriangleCounts     Number of triangles in each mesh section.
+/// @param[out]    rLodSectionTriangleCounts  Number of triangles in each mesh section for each level of detail.
+static void OptimizeMesh(
+	const Mesh* pMesh,
+	const String& rSourceFilePath,
+	DynamicArray< StaticMeshVertex< 1 > >& rVertices,
+	DynamicArray< FbxSupport::BlendData >& rVertexBlendData,
+	DynamicArray< uint32_t >& rIndices,
+	const DynamicArray< uint32_t >& rSectionVertexCounts,
+	const DynamicArray< uint32_t >& rSectionTriangleCounts,
+	DynamicArray< uint32_t >& rLodSectionTriangleCounts )
+{
+	HELIUM_ASSERT( pMesh );
+
+	static const char* passNames[] = { "Vertex cache", "Overdraw", "Vertex fetch" };
+	MeshOptimizer::VertexCacheStatistics passStatistics[ HELIUM_ARRAY_COUNT( passNames ) + 1 ];
+	MemoryZero( passStatistics, sizeof( passStatistics ) );
+
+	bool bSkinned = ( !rVertexBlendData.IsEmpty() );
+	HELIUM_ASSERT( !bSkinned || rVertexBlendData.GetSize() == rVertices.GetSize() );
+
+	DynamicArray< uint32_t > vertexRemap;
+	DynamicArray< StaticMeshVertex< 1 > > sectionVertices;
+	DynamicArray< FbxSupport::BlendData > sectionBlendData;
+
+	size_t sectionCount = rSectionTriangleCounts.GetSize();
+	HELIUM_ASSERT( rSectionVertexCounts.GetSize() == sectionCount );
+
+	size_t sectionStartVertex = 0;
+	size_t sectionStartIndex = 0;
+	for( size_t sectionIndex = 0; sectionIndex < sectionCount; ++sectionIndex )
+	{
+		size_t vertexCount = rSectionVertexCounts[ sectionIndex ];
+		size_t indexCount = static_cast< size_t >( rSectionTriangleCounts[ sectionIndex ] ) * 3;
+		HELIUM_ASSERT( sectionStartVertex + vertexCount <= rVertices.GetSize() );
+		HELIUM_ASSERT( sectionStartIndex + indexCount <= rIndices.GetSize() );
+
+		uint32_t* pIndices = rIndices.GetData() + sectionStartIndex;
+		StaticMeshVertex< 1 >* pVertices = rVertices.GetData() + sectionStartVertex;
+
+		AccumulateVertexCacheStatistics(
+			passStatistics[ 0 ],
+			MeshOptimizer::AnalyzeVertexCache( pIndices, indexCount, vertexCount ) );
+
+		MeshOptimizer::OptimizeVertexCache( pIndices, indexCount, vertexCount );
+		AccumulateVertexCacheStatistics(
+			passStatistics[ 1 ],
+			MeshOptimizer::AnalyzeVertexCache( pIndices, indexCount, vertexCount ) );
+
+		MeshOptimizer::OptimizeOverdraw( pIndices, indexCount, pVertices, vertexCount, OVERDRAW_CACHE_THRESHOLD );
+		AccumulateVertexCacheStatistics(
+			passStatistics[ 2 ],
+			MeshOptimizer::AnalyzeVertexCache( pIndices, indexCount, vertexCount ) );
+
+		// Reorder the section's vertices by first use.
+		vertexRemap.Resize( vertexCount );
+		MeshOptimizer::OptimizeVertexFetch( pIndices, indexCount, vertexCount, vertexRemap.GetData() );
+
+		sectionVertices.Resize( vertexCount );
+		for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+		{
+			sectionVertices[ vertexRemap[ vertexIndex ] ] = pVertices[ vertexIndex ];
+		}
+
+		MemoryCopy( pVertices, sectionVertices.GetData(), sizeof( StaticMeshVertex< 1 > ) * vertexCount );
+
+		if( bSkinned )
+		{
+			FbxSupport::BlendData* pBlendData = rVertexBlendData.GetData() + sectionStartVertex;
+
+			sectionBlendData.Resize( vertexCount );
+			for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+			{
+				sectionBlendData[ vertexRemap[ vertexIndex ] ] = pBlendData[ vertexIndex ];
+			}
+
+			MemoryCopy( pBlendData, sectionBlendData.GetData(), sizeof( FbxSupport::BlendData ) * vertexCount );
+		}
+
+		AccumulateVertexCacheStatistics(
+			passStatistics[ 3 ],
+			MeshOptimizer::AnalyzeVertexCache( pIndices, indexCount, vertexCount ) );
+
+		sectionStartVertex += vertexCount;
+		sectionStartIndex += indexCount;
+	}
+
+	for( size_t passIndex = 0; passIndex < HELIUM_ARRAY_COUNT( passNames ); ++passIndex )
+	{
+		const MeshOptimizer::VertexCacheStatistics& rBefore = passStatistics[ passIndex ];
+		const MeshOptimizer::VertexCacheStatistics& rAfter = passStatistics[ passIndex + 1 ];
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			"MeshResourceHandler::CacheResource(): %s optimization for \"%s\": ACMR %.3f -> %.3f, ATVR %.3f -> %.3f.\n",
+			passNames[ passIndex ],
+			*rSourceFilePath,
+			rBefore.acmr,
+			rAfter.acmr,
+			rBefore.atvr,
+			rAfter.atvr );
+	}
+
+	// Generate each level of detail by simplifying the previous level.
+	rLodSectionTriangleCounts.Resize( 0 );
+
+	uint32_t lodGenerationCount = pMesh->GetLodGenerationCount();
+	float32_t lodTriangleRatio = Clamp( pMesh->GetLodTriangleRatio(), 0.0f, 1.0f );
+	float32_t lodMaxError = pMesh->GetLodMaxError();
+
+	uint32_t baseTriangleCount = passStatistics[ 0 ].triangleCount;
+	uint32_t previousTriangleCount = baseTriangleCount;
+	size_t previousLevelStartIndex = 0;
+
+	DynamicArray< uint32_t > lodIndices;
+	for( uint32_t lodIndex = 0; lodIndex < lodGenerationCount && previousTriangleCount != 0; ++lodIndex )
+	{
+		MeshOptimizer::VertexCacheStatistics lodStatistics;
+		MemoryZero( &lodStatistics, sizeof( lodStatistics ) );
+
+		lodIndices.Resize( 0 );
+
+		sectionStartVertex = 0;
+		sectionStartIndex = previousLevelStartIndex;
+		for( size_t sectionIndex = 0; sectionIndex < sectionCount; ++sectionIndex )
+		{
+			size_t vertexCount = rSectionVertexCounts[ sectionIndex ];
+			size_t sourceTriangleCount = ( lodIndex == 0
+				? rSectionTriangleCounts[ sectionIndex ]
+				: rLodSectionTriangleCounts[ ( lodIndex - 1 ) * sectionCount + sectionIndex ] );
+			size_t indexCount = sourceTriangleCount * 3;
+			size_t targetIndexCount =
+				static_cast< size_t >( static_cast< float32_t >( sourceTriangleCount ) * lodTriangleRatio ) * 3;
+
+			size_t lodStartIndex = lodIndices.GetSize();
+			lodIndices.Resize( lodStartIndex + indexCount );
+			uint32_t* pLodIndices = lodIndices.GetData() + lodStartIndex;
+
+			size_t lodIndexCount = MeshOptimizer::Simplify(
+				pLodIndices,
+				rIndices.GetData() + sectionStartIndex,
+				indexCount,
+				rVertices.GetData() + sectionStartVertex,
+				vertexCount,
+				targetIndexCount,
+				lodMaxError );
+			lodIndices.Resize( lodStartIndex + lodIndexCount );
+
+			MeshOptimizer::OptimizeVertexCache( pLodIndices, lodIndexCount, vertexCount );
+			AccumulateVertexCacheStatistics(
+				lodStatistics,
+				MeshOptimizer::AnalyzeVertexCache( pLodIndices, lodIndexCount, vertexCount ) );
+
+			rLodSectionTriangleCounts.Push( static_cast< uint32_t >( lodIndexCount / 3 ) );
+
+			sectionStartVertex += vertexCount;
+			sectionStartIndex += indexCount;
+		}
+
+		if( lodStatistics.triangleCount >= previousTriangleCount )
+		{
+			// Nothing left to simplify within the error limit, so further levels would be identical.
+			rLodSectionTriangleCounts.Resize( lodIndex * sectionCount );
+
+			HELIUM_TRACE(
+				TraceLevels::Info,
+				"MeshResourceHandler::CacheResource(): Stopped generating levels of detail for \"%s\" after %" PRIu32 " level(s), as no further simplification was possible.\n",
+				*rSourceFilePath,
+				lodIndex );
+
+			break;
+		}
+
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			"MeshResourceHandler::CacheResource(): Level of detail %" PRIu32 " for \"%s\": %" PRIu32 " triangles (%.1f%% of full detail), ACMR %.3f, ATVR %.3f.\n",
+			lodIndex + 1,
+			*rSourceFilePath,
+			lodStatistics.triangleCount,
+			100.0f * static_cast< float32_t >( lodStatistics.triangleCount ) /
+				static_cast< float32_t >( baseTriangleCount ),
+			lodStatistics.acmr,
+			lodStatistics.atvr );
+
+		previousLevelStartIndex = rIndices.GetSize();
+		previousTriangleCount = lodStatistics.triangleCount;
+		rIndices.AddArray( lodIndices.GetData(), lodIndices.GetSize() );
+	}
+}
+
 /// Constructor.
 MeshResourceHandler::MeshResourceHandler()
 : m_rFbxSupport( FbxSupport::StaticAcquire() )
@@ -57,13 +281,15 @@ bool MeshResourceHandler::CacheResource(
 
 	// Load and parse the mesh data.
 	DynamicArray< StaticMeshVertex< 1 > > vertices;
-	DynamicArray< uint16_t > indices;
-	//DynamicArray< uint16_t > sectionVertexCounts;
+	DynamicArray< uint32_t > indices;
+	//DynamicArray< uint32_t > sectionVertexCounts;
 	//DynamicArray< uint32_t > sectionTriangleCounts;
 	DynamicArray< FbxSupport::BoneData > bones;
 	DynamicArray< FbxSupport::BlendData > vertexBlendData;
 	//DynamicArray< uint8_t > skinningPaletteMap;
 
+	Mesh* pMesh = Reflect::AssertCast< Mesh >( pResource );
+
 	bool bLoadSuccess = m_rFbxSupport.LoadMesh(
 		rSourceFilePath,
 		vertices,
@@ -94,6 +320,46 @@ bool MeshResourceHandler::CacheResource(
 	HELIUM_ASSERT( triangleCountActual <= UINT32_MAX );
 	persistentResourceData->m_triangleCount = static_cast< uint32_t >( triangleCountActual );
 
+	OptimizeMesh(
+		pMesh,
+		rSourceFilePath,
+		vertices,
+		vertexBlendData,
+		indices,
+		persistentResourceData->m_sectionVertexCounts,
+		persistentResourceData->m_sectionTriangleCounts,
+		persistentResourceData->m_lodSectionTriangleCounts );
+
+	// Levels of detail are stored after the full detail indices.
+	size_t cachedIndexCount = indices.GetSize();
+
+	// Indices are relative to the start of each mesh section, so 16-bit indices can be used as long as no single
+	// section addresses more vertices than they can reference.
+	bool bUses32BitIndices = false;
+	size_t meshSectionCount = persistentResourceData->m_sectionVertexCounts.GetSize();
+	for( size_t sectionIndex = 0; sectionIndex < meshSectionCount; ++sectionIndex )
+	{
+		if( persistentResourceData->m_sectionVertexCounts[ sectionIndex ] > UINT16_MAX )
+		{
+			bUses32BitIndices = true;
+
+			break;
+		}
+	}
+
+	persistentResourceData->m_bUses32BitIndices = bUses32BitIndices;
+
+	DynamicArray< uint16_t > indices16;
+	if( !bUses32BitIndices )
+	{
+		indices16.Resize( cachedIndexCount );
+		for( size_t indexIndex = 0; indexIndex < cachedIndexCount; ++indexIndex )
+		{
+			HELIUM_ASSERT( indices[ indexIndex ] <= UINT16_MAX );
+			indices16[ indexIndex ] = static_cast< uint16_t >( indices[ indexIndex ] );
+		}
+	}
+
 	size_t boneCountActual = bones.GetSize();
 	HELIUM_ASSERT( boneCountActual <= UINT8_MAX );
 	persistentResourceData->m_boneCount = static_cast< uint8_t >( boneCountActual );
@@ -241,9 +507,14 @@ bool MeshResourceHandler::CacheResource(
 			}
 		}
 		
-		size_t indexDataSize = indexCount * sizeof(uint16_t);
+		size_t indexDataSize = cachedIndexCount * ( bUses32BitIndices ? sizeof( uint32_t ) : sizeof( uint16_t ) );
 		rSubDataBuffers[ 1 ].Resize(indexDataSize);
-		MemoryCopy(rSubDataBuffers[1].GetData(), indices.GetData(), indexDataSize);
+		MemoryCopy(
+			rSubDataBuffers[1].GetData(),
+			( bUses32BitIndices
+			  ? static_cast< const void* >( indices.GetData() )
+			  : static_cast< const void* >( indices16.GetData() ) ),
+			indexDataSize);
 
 		// Platform data is now loaded.
 		rPreprocessedData.bLoaded = true;
@@ -119,6 +119,9 @@ Asset::ChildNameInstanceIndexMap* Asset::sm_pNameInstanceIndexMap = NULL;
 Pair< AssetPath, Asset::NameInstanceIndexMap >* Asset::sm_pEmptyNameInstanceIndexMap = NULL;
 Pair< Name, Asset::InstanceIndexSet >* Asset::sm_pEmptyInstanceIndexSet = NULL;
 
+Asset::PathObjectMap* Asset::sm_pPathObjectMap = NULL;
+Asset::ChildObjectMap* Asset::sm_pChildObjectMap = NULL;
+
 ReadWriteLock Asset::sm_objectListLock;
 
 DynamicArray< uint8_t > Asset::sm_serializationBuffer;
@@ -308,23 +311,24 @@ bool Asset::Rename( const RenameParameters& rParameters )
 			}
 			else
 			{
-				// Check each child of the new owner for a name clash.
-				for( Asset* pChild = rwpOwnerFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
+				// Check the child object lookup for a name clash with the new owner.
+				if( FindChildOf( pOwner, name, instanceIndex ) )
 				{
-					if( pChild->m_name == name && pChild->m_instanceIndex == instanceIndex )
-					{
-						HELIUM_TRACE(
-							TraceLevels::Error,
-							"Asset::Rename(): Object already exists with the specified owner (%s) and name (%s).\n",
-							pOwner ? *pOwner->GetPath().ToString() : "none",
-							*name );
+					HELIUM_TRACE(
+						TraceLevels::Error,
+						"Asset::Rename(): Object already exists with the specified owner (%s) and name (%s).\n",
+						pOwner ? *pOwner->GetPath().ToString() : "none",
+						*name );
 
-						return false;
-					}
+					return false;
 				}
 			}
 		}
 
+		// Remove this object and its children from the object lookup maps, as their paths are about to change
+		// (UpdatePath() will add them back under their new paths).
+		RemoveFromLookupMaps();
+
 		// Remove any old instance index tracking for the old path name.
 		if( IsValid( m_instanceIndex ) )
 		{
@@ -794,6 +798,17 @@ void Asset::ReplaceAsset( Asset* pNewAsset, const AssetPath &objectToReplace )
 	Helium::Swap( pOldAsset->m_spOwner, pNewAsset->m_spOwner );
 	Helium::Swap( pOldAsset->m_wpFirstChild, pNewAsset->m_wpFirstChild );
 	Helium::Swap( pOldAsset->m_wpNextSibling, pNewAsset->m_wpNextSibling );
+
+	// The assets have traded names, so point their lookup map entries at the objects now holding each name.
+	if( !pNewAsset->m_name.IsEmpty() )
+	{
+		pNewAsset->AddToLookupMaps();
+	}
+
+	if( !pOldAsset->m_name.IsEmpty() )
+	{
+		pOldAsset->AddToLookupMaps();
+	}
 }
 
 #endif  // HELIUM_TOOLS
@@ -1005,42 +1020,20 @@ Asset* Asset::FindObject( AssetPath path )
 		return NULL;
 	}
 
-	// Assemble a list of object names and instance indices, from the top level on down.
-	size_t pathDepth = 0;
-	size_t packageDepth = 0;
-	for( AssetPath testPath = path; !testPath.IsEmpty(); testPath = testPath.GetParent() )
+	// No objects have been named yet if the lookup map hasn't been created.
+	PathObjectMap* pPathObjectMap = sm_pPathObjectMap;
+	if( !pPathObjectMap )
 	{
-		++pathDepth;
-
-		if( testPath.IsPackage() )
-		{
-			++packageDepth;
-		}
+		return NULL;
 	}
 
-	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
-	StackMemoryHeap<>::Marker stackMarker( rStackHeap );
-
-	Name* pPathNames = static_cast< Name* >( rStackHeap.Allocate( sizeof( Name ) * pathDepth ) );
-	HELIUM_ASSERT( pPathNames );
-
-	uint32_t* pInstanceIndices = static_cast< uint32_t* >( rStackHeap.Allocate( sizeof( uint32_t ) * pathDepth ) );
-	HELIUM_ASSERT( pInstanceIndices );
-
-	size_t pathIndex = pathDepth;
-	for( AssetPath testPath = path; !testPath.IsEmpty(); testPath = testPath.GetParent() )
+	PathObjectMap::ConstAccessor objectAccessor;
+	if( !pPathObjectMap->Find( objectAccessor, path ) )
 	{
-		HELIUM_ASSERT( pathIndex != 0 );
-		--pathIndex;
-
-		pPathNames[ pathIndex ] = testPath.GetName();
-		pInstanceIndices[ pathIndex ] = testPath.GetInstanceIndex();
+		return NULL;
 	}
 
-	HELIUM_ASSERT( pathIndex == 0 );
-
-	// Search from the root.
-	return FindChildOf( NULL, pPathNames, pInstanceIndices, pathDepth, packageDepth );
+	return objectAccessor->Second();
 }
 
 /// Search for a direct child of the specified object with the given name.
@@ -1058,19 +1051,24 @@ Asset* Asset::FindChildOf( const Asset* pObject, Name name, uint32_t instanceInd
 		return NULL;
 	}
 
-	ScopeReadLock scopeLock( sm_objectListLock );
+	ChildObjectMap* pChildObjectMap = sm_pChildObjectMap;
+	if( !pChildObjectMap )
+	{
+		return NULL;
+	}
 
-	for( Asset* pChild = ( pObject ? pObject->m_wpFirstChild : sm_wpFirstTopLevelObject );
-		 pChild != NULL;
-		 pChild = pChild->m_wpNextSibling )
+	ChildKey key;
+	key.ownerPath = ( pObject ? pObject->m_path : AssetPath( NULL_NAME ) );
+	key.name = name;
+	key.instanceIndex = instanceIndex;
+
+	ChildObjectMap::ConstAccessor childAccessor;
+	if( !pChildObjectMap->Find( childAccessor, key ) )
 	{
-		if( pChild->GetName() == name && pChild->GetInstanceIndex() == instanceIndex )
-		{
-			return pChild;
-		}
+		return NULL;
 	}
 
-	return NULL;
+	return childAccessor->Second();
 }
 
 /// Search for a child or grandchild of the given object with a relative path dictated by the given parameters.
@@ -1278,6 +1276,12 @@ void Asset::Shutdown()
 	delete sm_pEmptyInstanceIndexSet;
 	sm_pEmptyInstanceIndexSet = NULL;
 
+	delete sm_pPathObjectMap;
+	sm_pPathObjectMap = NULL;
+
+	delete sm_pChildObjectMap;
+	sm_pChildObjectMap = NULL;
+
 	sm_serializationBuffer.Clear();
 }
 
@@ -1386,6 +1390,12 @@ void Asset::UpdatePath()
 		( m_spOwner ? m_spOwner->m_path : AssetPath( NULL_NAME ) ),
 		m_instanceIndex ) );
 
+	// Objects with no name information are not tracked in the lookup maps.
+	if( !m_name.IsEmpty() )
+	{
+		AddToLookupMaps();
+	}
+
 	// Update the path of each child object.
 	for( Asset* pChild = m_wpFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
 	{
@@ -1393,6 +1403,67 @@ void Asset::UpdatePath()
 	}
 }
 
+/// Add this object to the object lookup maps under its current path.
+///
+/// Any existing entries with the same keys are replaced.  This object must have valid name information, and the
+/// object list write lock must be held.
+void Asset::AddToLookupMaps()
+{
+	HELIUM_ASSERT( !m_name.IsEmpty() );
+
+	AssetWPtr wpThis( this );
+
+	PathObjectMap::Accessor objectAccessor;
+	if( !GetPathObjectMap().Insert( objectAccessor, KeyValue< AssetPath, AssetWPtr >( m_path, wpThis ) ) )
+	{
+		objectAccessor->Second() = wpThis;
+	}
+
+	ChildKey key;
+	key.ownerPath = ( m_spOwner ? m_spOwner->m_path : AssetPath( NULL_NAME ) );
+	key.name = m_name;
+	key.instanceIndex = m_instanceIndex;
+
+	ChildObjectMap::Accessor childAccessor;
+	if( !GetChildObjectMap().Insert( childAccessor, KeyValue< ChildKey, AssetWPtr >( key, wpThis ) ) )
+	{
+		childAccessor->Second() = wpThis;
+	}
+}
+
+/// Remove this object and all of its children from the object lookup maps.
+///
+/// This must be called while the current paths of this object and its owner are still set, and the object list write
+/// lock must be held.
+void Asset::RemoveFromLookupMaps()
+{
+	// Objects with no name information are not tracked in the lookup maps, and neither are their children.
+	if( m_name.IsEmpty() )
+	{
+		return;
+	}
+
+	if( sm_pPathObjectMap )
+	{
+		sm_pPathObjectMap->Remove( m_path );
+	}
+
+	if( sm_pChildObjectMap )
+	{
+		ChildKey key;
+		key.ownerPath = ( m_spOwner ? m_spOwner->m_path : AssetPath( NULL_NAME ) );
+		key.name = m_name;
+		key.instanceIndex = m_instanceIndex;
+
+		sm_pChildObjectMap->Remove( key );
+	}
+
+	for( Asset* pChild = m_wpFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
+	{
+		pChild->RemoveFromLookupMaps();
+	}
+}
+
 /// Custom destroy callback for objects created using CreateObject().
 ///
 /// @param[in] pObject  Asset to destroy.
@@ -1430,6 +1501,64 @@ Asset::ChildNameInstanceIndexMap& Asset::GetNameInstanceIndexMap()
 	return *sm_pNameInstanceIndexMap;
 }
 
+/// Get the static object path lookup map, creating it if necessary.
+///
+/// @return  Reference to the object path lookup map.
+///
+/// @see GetNameInstanceIndexMap()
+Asset::PathObjectMap& Asset::GetPathObjectMap()
+{
+	if( !sm_pPathObjectMap )
+	{
+		sm_pPathObjectMap = new PathObjectMap;
+		HELIUM_ASSERT( sm_pPathObjectMap );
+	}
+
+	return *sm_pPathObjectMap;
+}
+
+/// Get the static child object lookup map, creating it if necessary.
+///
+/// @return  Reference to the child object lookup map.
+///
+/// @see GetNameInstanceIndexMap()
+Asset::ChildObjectMap& Asset::GetChildObjectMap()
+{
+	if( !sm_pChildObjectMap )
+	{
+		sm_pChildObjectMap = new ChildObjectMap;
+		HELIUM_ASSERT( sm_pChildObjectMap );
+	}
+
+	return *sm_pChildObjectMap;
+}
+
+/// Equality comparison.
+///
+/// @param[in] rOther  Child key with which to compare.
+///
+/// @return  True if this key is equal to the given key, false if not.
+bool Asset::ChildKey::operator==( const ChildKey& rOther ) const
+{
+	return ( ownerPath == rOther.ownerPath && name == rOther.name && instanceIndex == rOther.instanceIndex );
+}
+
+/// Compute a hash value for the given child key.
+///
+/// @param[in] rKey  Child object key.
+///
+/// @return  Hash value for the given key.
+size_t Asset::ChildKeyHash::operator()( const ChildKey& rKey ) const
+{
+	size_t hash = rKey.ownerPath.ComputeHash();
+
+	// Names are pooled, so the string pointer uniquely identifies the name.
+	hash = ( ( hash * 33 ) ^ reinterpret_cast< uintptr_t >( rKey.name.Get() ) );
+	hash = ( ( hash * 33 ) ^ rKey.instanceIndex );
+
+	return hash;
+}
+
 AssetRegistrar< Asset, void > Asset::s_Registrar("Helium::Asset");
 
 
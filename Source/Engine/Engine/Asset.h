@@ -382,6 +382,37 @@ namespace Helium
 		/// Child object name instance lookup map type.
 		typedef ConcurrentHashMap< AssetPath, NameInstanceIndexMap > ChildNameInstanceIndexMap;
 
+		/// Child object lookup key.
+		struct ChildKey
+		{
+			/// Owner path (empty for top-level objects).
+			AssetPath ownerPath;
+			/// Object name.
+			Name name;
+			/// Object instance index.
+			uint32_t instanceIndex;
+
+			/// @name Overloaded Operators
+			//@{
+			bool operator==( const ChildKey& rOther ) const;
+			//@}
+		};
+
+		/// Child object lookup key hasher.
+		class ChildKeyHash
+		{
+		public:
+			/// @name Hash Calculation
+			//@{
+			size_t operator()( const ChildKey& rKey ) const;
+			//@}
+		};
+
+		/// Object lookup map type (by full path).
+		typedef ConcurrentHashMap< AssetPath, AssetWPtr > PathObjectMap;
+		/// Child object lookup map type (by owner path, name, and instance index).
+		typedef ConcurrentHashMap< ChildKey, AssetWPtr, ChildKeyHash > ChildObjectMap;
+
 		/// Object name.
 		Name m_name;
 		/// Instance index.
@@ -419,6 +450,11 @@ namespace Helium
 		/// Empty name instance index lookup set.
 		static Pair< Name, InstanceIndexSet >* sm_pEmptyInstanceIndexSet;
 
+		/// Object lookup by full path.
+		static PathObjectMap* sm_pPathObjectMap;
+		/// Object lookup by owner path, name, and instance index.
+		static ChildObjectMap* sm_pChildObjectMap;
+
 		/// Read-write lock for synchronizing access to the object lists.
 		static ReadWriteLock sm_objectListLock;
 
@@ -428,6 +464,9 @@ namespace Helium
 		/// @name Private Utility Functions
 		//@{
 		void UpdatePath();
+
+		void AddToLookupMaps();
+		void RemoveFromLookupMaps();
 		//@}
 
 		/// @name Reference Counting Support, Private
@@ -438,6 +477,8 @@ namespace Helium
 		/// @name Static Asset Management
 		//@{
 		static ChildNameInstanceIndexMap& GetNameInstanceIndexMap();
+		static PathObjectMap& GetPathObjectMap();
+		static ChildObjectMap& GetChildObjectMap();
 		//@}
 	};
 
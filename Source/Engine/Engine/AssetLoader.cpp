@@ -2,7 +2,10 @@
 #include "Engine/AssetLoader.h"
 
 #include "Platform/Thread.h"
+#include "Platform/Timer.h"
 #include "Engine/Asset.h"
+#include "Engine/AsyncDeserializer.h"
+#include "Engine/AsyncLoader.h"
 #include "Engine/PackageLoader.h"
 #include "Engine/FileLocations.h"
 
@@ -10,6 +13,9 @@
 
 using namespace Helium;
 
+/// Longest time FinishLoad() sleeps waiting for load work to complete before checking for progress again.
+static const uint32_t FINISH_LOAD_WAIT_MILLISECONDS = 10;
+
 static uint32_t g_AssetLoaderInitCount = 0;
 AssetLoader* AssetLoader::sm_pInstance = NULL;
 
@@ -21,6 +27,9 @@ AssetTracker* AssetTracker::sm_pInstance = NULL;
 /// Constructor.
 AssetLoader::AssetLoader()
 : m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
+, m_pollCompletionCount( 0 )
+, m_tickingCounter( 0 )
+, m_tickBudget( 0.0f )
 {
 }
 
@@ -99,6 +108,9 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 		(pAsset->GetFlags() & Asset::FLAG_BROKEN ? LOAD_FLAG_FULLY_LOADED | LOAD_FLAG_ERROR : LOAD_FLAG_FULLY_LOADED ) : 
 		0;
 	pRequest->requestCount = 1;
+	pRequest->scheduledStateFlags = pRequest->stateFlags;
+	SetInvalid( pRequest->blockingRequestId );
+	HELIUM_ASSERT( pRequest->waitingRequests.IsEmpty() );
 	HELIUM_ASSERT( !pRequest->spObject );
 	pRequest->spObject = pAsset;
 	pRequest->forceReload = forceReload;
@@ -106,9 +118,20 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 	ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor requestAccessor;
 	if( m_loadRequestMap.Insert( requestAccessor, KeyValue< AssetPath, LoadRequest* >( path, pRequest ) ) )
 	{
-		// New load request was created, so tick it once to get the load process running.
+		// New load request was created, so tick it once to get the load process running.  The tick queues hold a
+		// reference to the request until it has fully loaded.
+		AtomicIncrementRelease( pRequest->requestCount );
 		requestAccessor.Release();
-		TickLoadRequest( pRequest );
+
+		if( TickLoadRequest( pRequest ) )
+		{
+			AtomicDecrementRelease( pRequest->requestCount );
+		}
+		else
+		{
+			MutexScopeLock scopeLock( m_newRequestLock );
+			m_newRequests.Push( pRequest );
+		}
 	}
 	else
 	{
@@ -173,6 +196,8 @@ bool AssetLoader::TryFinishLoad( size_t id, AssetPtr& rspObject )
 	int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
 	if( newRequestCount == 0 )
 	{
+		HELIUM_ASSERT( pRequest->waitingRequests.IsEmpty() );
+
 		pRequest->spObject.Release();
 		pRequest->resolver.Clear();
 
@@ -206,10 +231,22 @@ bool AssetLoader::TryFinishLoad( size_t id, AssetPtr& rspObject )
 /// @see TryFinishLoad(), BeginLoadObject(), BeginPreloadPackage()
 void AssetLoader::FinishLoad( size_t id, AssetPtr& rspObject )
 {
+	AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+
 	while( !TryFinishLoad( id, rspObject ) )
 	{
-		Tick();
-		Thread::Yield();
+		// Read the completion count before updating, so that work completing during the update isn't waited for.
+		int32_t completionCount = ( pAsyncLoader ? pAsyncLoader->GetCompletionCount() : 0 );
+
+		// Update without any time budget, as this thread can't do anything else until the load completes.
+		TickPackageLoaders();
+		if( !TickRequests( 0.0f ) && pAsyncLoader )
+		{
+			// Nothing made progress, so sleep until more load work completes (file I/O, deserialization, package
+			// loader updates, or load requests updated on another thread).  The wait is bounded so that progress
+			// made without a completion signal, or a signal consumed by another waiting thread, is still picked up.
+			pAsyncLoader->WaitForCompletion( completionCount, FINISH_LOAD_WAIT_MILLISECONDS );
+		}
 	}
 }
 
@@ -265,63 +302,43 @@ bool AssetLoader::CacheObject( Asset* /*pObject*/, bool /*bEvictPlatformPreproce
 #endif  // HELIUM_TOOLS
 
 /// Update object loading.
+///
+/// Requests are only updated once they are ready to make progress: requests waiting on another load request are
+/// parked until that request's loading status changes, while requests waiting on file I/O or package loader work are
+/// polled again (after all other ready requests) only once the AsyncLoader signals that more load work has completed.  If a tick budget has been set, updating stops once the budget is exceeded and resumes from the same
+/// point on the next tick.
+///
+/// @see SetTickBudget(), FinishLoad()
 void AssetLoader::Tick()
 {
 	// Tick package loaders first.
 	TickPackageLoaders();
 
-	// Build the list of object load requests to update this tick, incrementing the request count on each to prevent
-	// them from being released while we don't have a lock on the request hash map.
-	//HELIUM_ASSERT( m_loadRequestTickArray.IsEmpty() );
-	/// List of load requests to update in the current tick.
-	DynamicArray< LoadRequest* > m_loadRequestTickArray;
-
-	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor loadRequestConstAccessor;
-	if( m_loadRequestMap.First( loadRequestConstAccessor ) )
-	{
-		do
-		{
-			LoadRequest* pRequest = loadRequestConstAccessor->Second();
-			HELIUM_ASSERT( pRequest );
-			AtomicIncrementUnsafe( pRequest->requestCount );
-			m_loadRequestTickArray.Add( pRequest );
-
-			++loadRequestConstAccessor;
-		} while( loadRequestConstAccessor.IsValid() );
-	}
-
-	// Tick object load requests.
-	size_t loadRequestCount = m_loadRequestTickArray.GetSize();
-	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
-	{
-		LoadRequest* pRequest = m_loadRequestTickArray[ requestIndex ];
-		HELIUM_ASSERT( pRequest );
-
-		TickLoadRequest( pRequest );
-
-		int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
-		if( newRequestCount == 0 )
-		{
-			ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
-			if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
-			{
-				pRequest = loadRequestAccessor->Second();
-				HELIUM_ASSERT( pRequest );
-				if( pRequest->requestCount == 0 )
-				{
-					HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
-
-					pRequest->spObject.Release();
-					pRequest->resolver.Clear();
+	TickRequests( m_tickBudget );
+}
 
-					m_loadRequestMap.Remove( loadRequestAccessor );
-					m_loadRequestPool.Release( pRequest );
-				}
-			}
-		}
-	}
+/// Set the maximum amount of time to spend updating load requests during each Tick() call.
+///
+/// Note that at least one request is always updated per tick, and that package loader updates are not included in
+/// the budget.
+///
+/// @param[in] milliseconds  Tick budget, in milliseconds, or zero to update all ready requests each tick.
+///
+/// @see GetTickBudget()
+void AssetLoader::SetTickBudget( float32_t milliseconds )
+{
+	HELIUM_ASSERT( milliseconds >= 0.0f );
+	m_tickBudget = milliseconds;
+}
 
-	//m_loadRequestTickArray.Resize( 0 );
+/// Get the maximum amount of time to spend updating load requests during each Tick() call.
+///
+/// @return  Tick budget, in milliseconds, or zero if there is no limit.
+///
+/// @see SetTickBudget()
+float32_t AssetLoader::GetTickBudget() const
+{
+	return m_tickBudget;
 }
 
 /// Get the global object loader instance.
@@ -379,6 +396,207 @@ void AssetLoader::OnLoadComplete( const AssetPath & /*path*/, Asset* /*pObject*/
 {
 }
 
+/// Update load requests from the tick queues.
+///
+/// @param[in] budget  Maximum amount of time to spend updating requests, in milliseconds, or zero for no limit.
+///
+/// @return  True if the loading status of any request changed, false if not.
+///
+/// @see Tick()
+bool AssetLoader::TickRequests( float32_t budget )
+{
+	// Only one thread can update the tick queues at a time, and this can be re-entered if a load step synchronously
+	// loads another object.  In either case, fall back to polling every request directly.
+	if( AtomicExchangeAcquire( m_tickingCounter, 1 ) != 0 )
+	{
+		return TickAllRequests();
+	}
+
+	{
+		MutexScopeLock scopeLock( m_newRequestLock );
+		m_readyRequests.AddArray( m_newRequests.GetData(), m_newRequests.GetSize() );
+		m_newRequests.Resize( 0 );
+	}
+
+	// Requests still waiting on file I/O or package loader work are checked after all other requests, but only if
+	// some load work has completed since they were last checked.  The completion count is read before any requests
+	// are updated so that work completing during this tick gets them checked again on the next one.
+	AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+	int32_t completionCount = ( pAsyncLoader ? pAsyncLoader->GetCompletionCount() : m_pollCompletionCount + 1 );
+	if( completionCount != m_pollCompletionCount )
+	{
+		m_pollCompletionCount = completionCount;
+
+		m_readyRequests.AddArray( m_pollRequests.GetData(), m_pollRequests.GetSize() );
+		m_pollRequests.Resize( 0 );
+	}
+
+	uint64_t startTicks = Timer::GetTickCount();
+	bool bProgress = false;
+
+	// Note that requests woken up during the loop are appended to the ready list and updated within the same tick.
+	size_t requestIndex = 0;
+	for( ; requestIndex < m_readyRequests.GetSize(); ++requestIndex )
+	{
+		// Always update at least one request so that loading can't stall regardless of the budget.
+		if( budget > 0.0f &&
+			requestIndex != 0 &&
+			Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) >= budget )
+		{
+			break;
+		}
+
+		LoadRequest* pRequest = m_readyRequests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+
+		SetInvalid( pRequest->blockingRequestId );
+		bool bFinished = TickLoadRequest( pRequest );
+
+		// Wake any requests waiting on this one if its status has changed, either here or outside the tick queues.
+		int32_t stateFlags = pRequest->stateFlags & ~LOAD_FLAG_IN_TICK;
+		if( stateFlags != pRequest->scheduledStateFlags )
+		{
+			pRequest->scheduledStateFlags = stateFlags;
+			WakeWaitingRequests( pRequest );
+
+			bProgress = true;
+		}
+
+		if( bFinished )
+		{
+			ReleaseRequest( pRequest );
+
+			continue;
+		}
+
+		LoadRequest* pBlockingRequest = NULL;
+		if( IsValid( pRequest->blockingRequestId ) )
+		{
+			pBlockingRequest = m_loadRequestPool.GetObject( pRequest->blockingRequestId );
+			HELIUM_ASSERT( pBlockingRequest );
+		}
+
+		if( pBlockingRequest && pBlockingRequest != pRequest )
+		{
+			// Park the request until the request it depends on makes progress.
+			pBlockingRequest->waitingRequests.Push( pRequest );
+		}
+		else
+		{
+			m_pollRequests.Push( pRequest );
+		}
+	}
+
+	// Any requests not reached within the budget are updated first on the next tick.
+	m_readyRequests.Remove( 0, requestIndex );
+
+	AtomicExchangeRelease( m_tickingCounter, 0 );
+
+	// Let requests waiting for load work completion (including those being finished on other threads) check again.
+	if( bProgress && pAsyncLoader )
+	{
+		pAsyncLoader->SignalCompletion();
+	}
+
+	return bProgress;
+}
+
+/// Update every outstanding load request directly, bypassing the tick queues.
+///
+/// This is only used when the tick queues are already being updated higher up the call stack or on another thread.
+///
+/// @return  True if the loading status of any request changed, false if not.
+bool AssetLoader::TickAllRequests()
+{
+	// Build the list of object load requests to update, incrementing the request count on each to prevent them from
+	// being released while we don't have a lock on the request hash map.
+	DynamicArray< LoadRequest* > loadRequests;
+
+	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor loadRequestConstAccessor;
+	if( m_loadRequestMap.First( loadRequestConstAccessor ) )
+	{
+		do
+		{
+			LoadRequest* pRequest = loadRequestConstAccessor->Second();
+			HELIUM_ASSERT( pRequest );
+			AtomicIncrementUnsafe( pRequest->requestCount );
+			loadRequests.Add( pRequest );
+
+			++loadRequestConstAccessor;
+		} while( loadRequestConstAccessor.IsValid() );
+	}
+
+	bool bProgress = false;
+
+	size_t loadRequestCount = loadRequests.GetSize();
+	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
+	{
+		LoadRequest* pRequest = loadRequests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+
+		int32_t previousStateFlags = pRequest->stateFlags & ~LOAD_FLAG_IN_TICK;
+		TickLoadRequest( pRequest );
+		if( ( pRequest->stateFlags & ~LOAD_FLAG_IN_TICK ) != previousStateFlags )
+		{
+			bProgress = true;
+		}
+
+		ReleaseRequest( pRequest );
+	}
+
+	if( bProgress )
+	{
+		AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+		if( pAsyncLoader )
+		{
+			pAsyncLoader->SignalCompletion();
+		}
+	}
+
+	return bProgress;
+}
+
+/// Move all requests waiting on the given request back to the ready list.
+///
+/// @param[in] pRequest  Load request whose status has changed.
+void AssetLoader::WakeWaitingRequests( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	m_readyRequests.AddArray( pRequest->waitingRequests.GetData(), pRequest->waitingRequests.GetSize() );
+	pRequest->waitingRequests.Resize( 0 );
+}
+
+/// Release a reference to a load request, freeing the request if it is no longer referenced.
+///
+/// @param[in] pRequest  Load request to release.
+void AssetLoader::ReleaseRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
+	if( newRequestCount == 0 )
+	{
+		ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
+		if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
+		{
+			pRequest = loadRequestAccessor->Second();
+			HELIUM_ASSERT( pRequest );
+			if( pRequest->requestCount == 0 )
+			{
+				HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+				HELIUM_ASSERT( pRequest->waitingRequests.IsEmpty() );
+
+				pRequest->spObject.Release();
+				pRequest->resolver.Clear();
+
+				m_loadRequestMap.Remove( loadRequestAccessor );
+				m_loadRequestPool.Release( pRequest );
+			}
+		}
+	}
+}
+
 /// Update the given load request.
 ///
 /// @param[in] pRequest  Load request to update.
@@ -500,7 +718,11 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 			return false;
 		}
 
-		// Add an object load request.
+		// Add an object load request.  If objects may be deserialized on worker threads, any assets they reference
+		// are not requested until preloading completes.
+		AsyncDeserializer* pAsyncDeserializer = AsyncDeserializer::GetInstance();
+		pRequest->resolver.SetDeferLoadRequests( pAsyncDeserializer && pAsyncDeserializer->GetWorkerCount() != 0 );
+
 		AssetPath path = pRequest->path;
 		pRequest->packageLoadRequestId = pPackageLoader->BeginLoadObject( path, &pRequest->resolver, pRequest->forceReload );
 		if( IsInvalid( pRequest->packageLoadRequestId ) )
@@ -548,6 +770,8 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 	// Preload complete.
 	SetInvalid( pRequest->packageLoadRequestId );
 
+	pRequest->resolver.BeginDeferredLoadRequests();
+
 	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PRELOADED );
 
 	return true;
@@ -565,7 +789,7 @@ bool AssetLoader::TickLink( LoadRequest* pRequest )
 
 	if ( pRequest->spObject.ReferencesObject() )
 	{
-		if( !pRequest->resolver.ReadyToApplyFixups() )
+		if( !pRequest->resolver.ReadyToApplyFixups( &pRequest->blockingRequestId ) )
 		{
 			return false;
 		}
@@ -595,7 +819,7 @@ bool AssetLoader::TickPrecache( LoadRequest* pRequest )
 	if( pAsset )
 	{
 		// TODO: SHouldn't this be in the linking phase?
-		if ( !pRequest->resolver.TryFinishPrecachingDependencies() )
+		if ( !pRequest->resolver.TryFinishPrecachingDependencies( &pRequest->blockingRequestId ) )
 		{
 			return false;
 		}
@@ -706,6 +930,11 @@ bool Helium::AssetIdentifier::Identify( const Reflect::ObjectPtr& object, Name*
 	return false;
 }
 
+Helium::AssetResolver::AssetResolver()
+	: m_DeferLoadRequests( false )
+{
+}
+
 bool Helium::AssetResolver::Resolve( const Name& identity, Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass )
 {
 	// Paths begin with /
@@ -716,8 +945,16 @@ bool Helium::AssetResolver::Resolve( const Name& identity, Reflect::ObjectPtr& p
 		AssetPath p;
 		p.Set(*identity);
 
-		size_t loadRequestId = AssetLoader::GetInstance()->BeginLoadObject(p);
-		m_Fixups.Push( Fixup( pointer, pointerClass, loadRequestId ) );
+		if ( m_DeferLoadRequests )
+		{
+			// The asset loader isn't safe to call from deserialization workers, so just record the path for now.
+			m_Fixups.Push( Fixup( pointer, pointerClass, p ) );
+		}
+		else
+		{
+			size_t loadRequestId = AssetLoader::GetInstance()->BeginLoadObject(p);
+			m_Fixups.Push( Fixup( pointer, pointerClass, loadRequestId ) );
+		}
 
 		return true;
 	}
@@ -744,7 +981,25 @@ bool Helium::AssetResolver::Resolve( const Name& identity, Reflect::ObjectPtr& p
 	return false;
 }
 
-bool Helium::AssetResolver::ReadyToApplyFixups()
+void Helium::AssetResolver::SetDeferLoadRequests( bool bDefer )
+{
+	m_DeferLoadRequests = bDefer;
+}
+
+void Helium::AssetResolver::BeginDeferredLoadRequests()
+{
+	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
+		iter != m_Fixups.End(); ++iter)
+	{
+		if ( !iter->m_DeferredPath.IsEmpty() )
+		{
+			iter->m_LoadRequestId = AssetLoader::GetInstance()->BeginLoadObject( iter->m_DeferredPath );
+			iter->m_DeferredPath.Clear();
+		}
+	}
+}
+
+bool Helium::AssetResolver::ReadyToApplyFixups( size_t* pBlockingLoadRequestId )
 {
 	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
 		iter != m_Fixups.End(); ++iter)
@@ -754,6 +1009,11 @@ bool Helium::AssetResolver::ReadyToApplyFixups()
 
 		if ( !( pRequest->stateFlags & AssetLoader::LOAD_FLAG_PRELOADED ) )
 		{
+			if ( pBlockingLoadRequestId )
+			{
+				*pBlockingLoadRequestId = iter->m_LoadRequestId;
+			}
+
 			return false;
 		}
 	}
@@ -782,9 +1042,10 @@ void Helium::AssetResolver::ApplyFixups()
 void Helium::AssetResolver::Clear()
 {
 	m_Fixups.Clear();
+	m_DeferLoadRequests = false;
 }
 
-bool Helium::AssetResolver::TryFinishPrecachingDependencies()
+bool Helium::AssetResolver::TryFinishPrecachingDependencies( size_t* pBlockingLoadRequestId )
 {
 	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
 		iter != m_Fixups.End(); ++iter)
@@ -794,6 +1055,11 @@ bool Helium::AssetResolver::TryFinishPrecachingDependencies()
 			AssetPtr asset;
 			if( !AssetLoader::GetInstance()->TryFinishLoad( iter->m_LoadRequestId, asset ) )
 			{
+				if ( pBlockingLoadRequestId )
+				{
+					*pBlockingLoadRequestId = iter->m_LoadRequestId;
+				}
+
 				return false;
 			}
 		
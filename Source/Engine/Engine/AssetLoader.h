@@ -2,6 +2,7 @@
 
 #include "Engine/Engine.h"
 
+#include "Platform/Locks.h"
 #include "Reflect/Translator.h"
 #include "Foundation/ConcurrentHashMap.h"
 #include "Foundation/ObjectPool.h"
@@ -24,13 +25,17 @@ namespace Helium
 	class HELIUM_ENGINE_API AssetResolver : public Reflect::ObjectResolver
 	{
 	public:
+		AssetResolver();
+
 		// Reflect::ObjectResolver interface
 		virtual bool Resolve( const Name& identity, Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass );
 
 		// Called by AssetLoader
-		bool ReadyToApplyFixups();
+		void SetDeferLoadRequests( bool bDefer );
+		void BeginDeferredLoadRequests();
+		bool ReadyToApplyFixups( size_t* pBlockingLoadRequestId = NULL );
 		void ApplyFixups();
-		bool TryFinishPrecachingDependencies();
+		bool TryFinishPrecachingDependencies( size_t* pBlockingLoadRequestId = NULL );
 		void Clear();
 
 		// Internal fixups that must be completed
@@ -40,6 +45,7 @@ namespace Helium
 				: m_Pointer( rhs.m_Pointer )
 				, m_PointerClass( rhs.m_PointerClass )
 				, m_LoadRequestId( rhs.m_LoadRequestId )
+				, m_DeferredPath( rhs.m_DeferredPath )
 			{}
 
 			Fixup( Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass, size_t loadRequestId )
@@ -48,11 +54,22 @@ namespace Helium
 				, m_LoadRequestId( loadRequestId )
 			{}
 
+			Fixup( Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass, AssetPath deferredPath )
+				: m_Pointer( pointer )
+				, m_PointerClass( pointerClass )
+				, m_LoadRequestId( Invalid< size_t >() )
+				, m_DeferredPath( deferredPath )
+			{}
+
 			Reflect::ObjectPtr&       m_Pointer;
 			const Reflect::MetaClass* m_PointerClass;
 			size_t                    m_LoadRequestId;
+			AssetPath                 m_DeferredPath; // Path to load once deferred load requests are begun
 		};
 		DynamicArray< Fixup >  m_Fixups;
+
+		// If set, load requests are not begun while resolving, as deserialization may be running on a worker thread
+		bool m_DeferLoadRequests;
 	};
 
 	/// Asynchronous object loading interface
@@ -96,6 +113,9 @@ namespace Helium
 #endif
 
 		virtual void Tick();
+
+		void SetTickBudget( float32_t milliseconds );
+		float32_t GetTickBudget() const;
 		//@}
 
 		/// @name Static Access
@@ -151,9 +171,17 @@ namespace Helium
 			/// Loading status flags.
 			volatile int32_t stateFlags;
 
-			/// Number of load requests for this specific object.
+			/// Number of load requests for this specific object (including one held by the tick queues until the load
+			/// completes).
 			volatile int32_t requestCount;
 
+			/// Loading status flags as of the last time this request was updated from the tick queues.
+			int32_t scheduledStateFlags;
+			/// ID of the load request on which this request is waiting, or invalid if it is waiting on file I/O.
+			size_t blockingRequestId;
+			/// Requests waiting for the loading status of this request to change.
+			DynamicArray< LoadRequest* > waitingRequests;
+
 			AssetResolver resolver;
 
 			bool forceReload;
@@ -177,6 +205,30 @@ namespace Helium
 		//@}
 
 	private:
+		/// Requests to update in upcoming ticks, in the order in which they became ready.
+		DynamicArray< LoadRequest* > m_readyRequests;
+		/// Requests still waiting on file I/O or package loader work, to be updated again (after all requests in
+		/// m_readyRequests) only once more load work has completed.
+		DynamicArray< LoadRequest* > m_pollRequests;
+		/// AsyncLoader completion count as of the last time m_pollRequests was moved back to m_readyRequests.
+		int32_t m_pollCompletionCount;
+		/// Requests created since the last tick.
+		DynamicArray< LoadRequest* > m_newRequests;
+		/// Synchronization for m_newRequests, which can be updated from any thread.
+		Mutex m_newRequestLock;
+
+		/// Non-zero while load requests are being updated from the tick queues.
+		volatile int32_t m_tickingCounter;
+		/// Maximum amount of time to spend updating load requests each tick, in milliseconds (zero for no limit).
+		float32_t m_tickBudget;
+
+		/// @name Load Request Scheduling
+		//@{
+		bool TickRequests( float32_t budget );
+		bool TickAllRequests();
+		void WakeWaitingRequests( LoadRequest* pRequest );
+		void ReleaseRequest( LoadRequest* pRequest );
+		//@}
 
 		/// @name Load Process Updating
 		//@{
@@ -1,6 +1,7 @@
 #include "Precompile.h"
 #include "Engine/AssetPath.h"
 
+#include "Platform/Atomic.h"
 #include "Foundation/FilePath.h"
 
 #include "Foundation/ReferenceCounting.h"
@@ -17,7 +18,9 @@ struct Helium::AssetPath::PendingLink
 
 using namespace Helium;
 
-AssetPath::TableBucket* AssetPath::sm_pTable = NULL;
+AssetPath::Table* volatile AssetPath::sm_pTable = NULL;
+size_t AssetPath::sm_entryCount = 0;
+Mutex* AssetPath::sm_pTableMutex = NULL;
 StackMemoryHeap<>* AssetPath::sm_pEntryMemoryHeap = NULL;
 ObjectPool<AssetPath::PendingLink> *AssetPath::sm_pPendingLinksPool = NULL;
 
@@ -500,8 +503,20 @@ void AssetPath::Shutdown()
 {
 	HELIUM_TRACE( TraceLevels::Info, "Shutting down AssetPath table.\n" );
 
-	delete [] sm_pTable;
+	Table* pTable = sm_pTable;
+	while( pTable )
+	{
+		Table* pPreviousTable = pTable->pPrevious;
+		delete [] pTable->ppSlots;
+		delete pTable;
+		pTable = pPreviousTable;
+	}
+
 	sm_pTable = NULL;
+	sm_entryCount = 0;
+
+	delete sm_pTableMutex;
+	sm_pTableMutex = NULL;
 
 	delete sm_pEntryMemoryHeap;
 	sm_pEntryMemoryHeap = NULL;
@@ -841,8 +856,27 @@ bool AssetPath::Parse(
 	return true;
 }
 
+/// Get the index of the first table slot to check for an entry with the given hash.
+///
+/// @param[in] hash       Entry hash.
+/// @param[in] slotCount  Number of table slots (must be a power of two).
+///
+/// @return  Table slot index.
+static size_t GetTableSlotIndex( size_t hash, size_t slotCount )
+{
+	// Mix the upper bits of the hash into the lower bits used for indexing, as the hash is built from a chain of
+	// multiplications that leave the low bits poorly distributed.
+	uint64_t mixedHash = static_cast< uint64_t >( hash ) * 0x9e3779b97f4a7c15ULL;
+	mixedHash ^= mixedHash >> 32;
+
+	return static_cast< size_t >( mixedHash ) & ( slotCount - 1 );
+}
+
 /// Look up a table entry, adding it if it does not exist.
 ///
+/// Existing entries are located without taking any locks.  Adding a new entry is serialized with a mutex, which also
+/// covers growing the table once it becomes too full.
+///
 /// This also handles lazy initialization of the path table and allocator.
 ///
 /// @param[in] rEntry  Entry to locate or add.
@@ -860,29 +894,163 @@ AssetPath::Entry* AssetPath::Add( const Entry& rEntry )
 		sm_pPendingLinksPool = new ObjectPool<PendingLink>( PENDING_LINKS_POOL_BLOCK_SIZE );
 		HELIUM_ASSERT( sm_pPendingLinksPool );
 
+		sm_pTableMutex = new Mutex;
+		HELIUM_ASSERT( sm_pTableMutex );
+
 		HELIUM_ASSERT( !sm_pTable );
-		sm_pTable = new TableBucket [ TABLE_BUCKET_COUNT ];
-		HELIUM_ASSERT( sm_pTable );
+		Table* pTable = new Table;
+		HELIUM_ASSERT( pTable );
+		pTable->ppSlots = new Entry* volatile [ TABLE_SLOT_COUNT_MIN ];
+		HELIUM_ASSERT( pTable->ppSlots );
+		MemoryZero( const_cast< Entry** >( pTable->ppSlots ), sizeof( Entry* ) * TABLE_SLOT_COUNT_MIN );
+		pTable->slotCount = TABLE_SLOT_COUNT_MIN;
+		pTable->pPrevious = NULL;
+
+		sm_pTable = pTable;
 	}
 
-	HELIUM_ASSERT( sm_pTable );
+	size_t hash = ComputeEntryStringHash( rEntry );
 
-	// Compute the entry's hash table index and retrieve the corresponding bucket.
-	uint32_t bucketIndex = ComputeEntryStringHash( rEntry ) % TABLE_BUCKET_COUNT;
-	TableBucket& rBucket = sm_pTable[ bucketIndex ];
+	// Locate the entry in the table without locking.
+	Table* pTable = sm_pTable;
+	HELIUM_ASSERT( pTable );
 
-	// Locate the entry in the table.  If it does not exist, add it.
-	size_t entryCount = 0;
-	Entry* pTableEntry = rBucket.Find( rEntry, entryCount );
-	if( !pTableEntry )
+	Entry* pTableEntry = FindEntry( *pTable, rEntry, hash );
+	if( pTableEntry )
 	{
-		pTableEntry = rBucket.Add( rEntry, entryCount );
-		HELIUM_ASSERT( pTableEntry );
+		return pTableEntry;
 	}
 
+	// The entry was not found, so check again with the table locked in case another thread added it (or replaced the
+	// table) in the meantime, and add it if it still does not exist.
+	MutexScopeLock scopeLock( *sm_pTableMutex );
+
+	pTable = sm_pTable;
+	HELIUM_ASSERT( pTable );
+
+	pTableEntry = FindEntry( *pTable, rEntry, hash );
+	if( pTableEntry )
+	{
+		return pTableEntry;
+	}
+
+	if( ( sm_entryCount + 1 ) * TABLE_SLOTS_PER_ENTRY_MIN > pTable->slotCount )
+	{
+		pTable = GrowTable( pTable );
+		HELIUM_ASSERT( pTable );
+	}
+
+	HELIUM_ASSERT( sm_pEntryMemoryHeap );
+	pTableEntry = static_cast< Entry* >( sm_pEntryMemoryHeap->Allocate( sizeof( Entry ) ) );
+	HELIUM_ASSERT( pTableEntry );
+	new( pTableEntry ) Entry( rEntry );
+	pTableEntry->hash = hash;
+
+	InsertEntry( *pTable, pTableEntry );
+	++sm_entryCount;
+
 	return pTableEntry;
 }
 
+/// Find an existing object path entry in a hash table.
+///
+/// This is safe to call without locking, even while entries are being added to the table.
+///
+/// @param[in] rTable  Table to search.
+/// @param[in] rEntry  Externally defined entry to match.
+/// @param[in] hash    Hash of the entry contents.
+///
+/// @return  Table entry if found, null if not found.
+///
+/// @see InsertEntry()
+AssetPath::Entry* AssetPath::FindEntry( const Table& rTable, const Entry& rEntry, size_t hash )
+{
+	HELIUM_ASSERT( rTable.ppSlots );
+
+	size_t slotMask = rTable.slotCount - 1;
+	for( size_t slotIndex = GetTableSlotIndex( hash, rTable.slotCount ); ; slotIndex = ( slotIndex + 1 ) & slotMask )
+	{
+		Entry* pTableEntry = rTable.ppSlots[ slotIndex ];
+		if( !pTableEntry )
+		{
+			return NULL;
+		}
+
+		if( pTableEntry->hash == hash && EntryContentsMatch( rEntry, *pTableEntry ) )
+		{
+			return pTableEntry;
+		}
+	}
+}
+
+/// Insert an entry into the first free slot for its hash in a hash table.
+///
+/// The table mutex must be locked (or the table not yet visible to other threads) when calling this function.
+///
+/// @param[in] rTable  Table in which to insert the entry.
+/// @param[in] pEntry  Entry to insert (with its hash already set).
+///
+/// @see FindEntry()
+void AssetPath::InsertEntry( Table& rTable, Entry* pEntry )
+{
+	HELIUM_ASSERT( rTable.ppSlots );
+	HELIUM_ASSERT( pEntry );
+
+	size_t slotMask = rTable.slotCount - 1;
+	size_t slotIndex = GetTableSlotIndex( pEntry->hash, rTable.slotCount );
+	while( rTable.ppSlots[ slotIndex ] )
+	{
+		slotIndex = ( slotIndex + 1 ) & slotMask;
+	}
+
+	// Publish the entry only once it has been fully initialized, as lookups may be reading the table concurrently.
+	AtomicExchangeRelease( rTable.ppSlots[ slotIndex ], pEntry );
+}
+
+/// Replace the current hash table with one twice as large.
+///
+/// The table mutex must be locked when calling this function.
+///
+/// @param[in] pTable  Current hash table.
+///
+/// @return  New hash table.
+AssetPath::Table* AssetPath::GrowTable( Table* pTable )
+{
+	HELIUM_ASSERT( pTable );
+	HELIUM_ASSERT( pTable == sm_pTable );
+
+	size_t slotCount = pTable->slotCount * 2;
+
+	Table* pNewTable = new Table;
+	HELIUM_ASSERT( pNewTable );
+	pNewTable->ppSlots = new Entry* volatile [ slotCount ];
+	HELIUM_ASSERT( pNewTable->ppSlots );
+	MemoryZero( const_cast< Entry** >( pNewTable->ppSlots ), sizeof( Entry* ) * slotCount );
+	pNewTable->slotCount = slotCount;
+	pNewTable->pPrevious = pTable;
+
+	size_t oldSlotCount = pTable->slotCount;
+	for( size_t slotIndex = 0; slotIndex < oldSlotCount; ++slotIndex )
+	{
+		Entry* pEntry = pTable->ppSlots[ slotIndex ];
+		if( pEntry )
+		{
+			InsertEntry( *pNewTable, pEntry );
+		}
+	}
+
+	// Lookups that already started on the old table can still safely finish with it, as it is never modified again.
+	AtomicExchangeRelease( sm_pTable, pNewTable );
+
+	HELIUM_TRACE(
+		TraceLevels::Debug,
+		"AssetPath: Grew path table to %" PRIuSZ " slots (%" PRIuSZ " entries).\n",
+		slotCount,
+		sm_entryCount );
+
+	return pNewTable;
+}
+
 /// Recursive function for building the string representation of an object path entry.
 ///
 /// @param[in]  rEntry   FilePath entry.
@@ -929,6 +1097,8 @@ void AssetPath::EntryToFilePathString( const Entry& rEntry, String& rString )
 /// Compute a hash value for an object path entry based on the contents of the name strings (slow, should only be
 /// used internally when a string comparison is needed).
 ///
+/// The parent entry must already be in the path table, as its cached hash is used instead of recomputing it.
+///
 /// @param[in] rEntry  Asset path entry.
 ///
 /// @return  Hash value.
@@ -944,8 +1114,7 @@ size_t AssetPath::ComputeEntryStringHash( const Entry& rEntry )
 	Entry* pParent = rEntry.pParent;
 	if( pParent )
 	{
-		size_t parentHash = ComputeEntryStringHash( *pParent );
-		hash = ( ( hash * 33 ) ^ parentHash );
+		hash = ( ( hash * 33 ) ^ pParent->hash );
 	}
 
 	return hash;
@@ -964,73 +1133,3 @@ bool AssetPath::EntryContentsMatch( const Entry& rEntry0, const Entry& rEntry1 )
 		( rEntry0.bPackage ? rEntry1.bPackage : !rEntry1.bPackage ) &&
 		rEntry0.pParent == rEntry1.pParent );
 }
-
-/// Find an existing object path entry in this table.
-///
-/// @param[in]  rEntry       Externally defined entry to match.
-/// @param[out] rEntryCount  Number of entries in this bucket when the search was performed.
-///
-/// @return  Table entry if found, null if not found.
-///
-/// @see Add()
-AssetPath::Entry* AssetPath::TableBucket::Find( const Entry& rEntry, size_t& rEntryCount )
-{
-	ScopeReadLock readLock( m_lock );
-
-	Entry* const * ppTableEntries = m_entries.GetData();
-	size_t entryCount = m_entries.GetSize();
-	HELIUM_ASSERT( ppTableEntries || entryCount == 0 );
-
-	rEntryCount = entryCount;
-
-	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
-	{
-		Entry* pTableEntry = ppTableEntries[ entryIndex ];
-		HELIUM_ASSERT( pTableEntry );
-		if( EntryContentsMatch( rEntry, *pTableEntry ) )
-		{
-			return pTableEntry;
-		}
-	}
-
-	return NULL;
-}
-
-/// Add an object path entry to this table if it does not already exist.
-///
-/// @param[in] rEntry              Externally defined entry to locate or add.
-/// @param[in] previousEntryCount  Number of entries already checked during a previous Find() call (existing entries
-///                                are not expected to change).  In other words, the entry index from which to start
-///                                checking for any additional string entries that may have been added since the
-///                                previous Find() call.
-///
-/// @return  Pointer to the object path table entry.
-///
-/// @see Find()
-AssetPath::Entry* AssetPath::TableBucket::Add( const Entry& rEntry, size_t previousEntryCount )
-{
-	ScopeWriteLock writeLock( m_lock );
-
-	Entry* const * ppTableEntries = m_entries.GetData();
-	size_t entryCount = m_entries.GetSize();
-	HELIUM_ASSERT( ppTableEntries || entryCount == 0 );
-	HELIUM_ASSERT( previousEntryCount <= entryCount );
-	for( size_t entryIndex = previousEntryCount; entryIndex < entryCount; ++entryIndex )
-	{
-		Entry* pTableEntry = ppTableEntries[ entryIndex ];
-		HELIUM_ASSERT( pTableEntry );
-		if( EntryContentsMatch( rEntry, *pTableEntry ) )
-		{
-			return pTableEntry;
-		}
-	}
-
-	HELIUM_ASSERT( sm_pEntryMemoryHeap );
-	Entry* pNewEntry = static_cast< Entry* >( sm_pEntryMemoryHeap->Allocate( sizeof( Entry ) ) );
-	HELIUM_ASSERT( pNewEntry );
-	new( pNewEntry ) Entry( rEntry );
-
-	m_entries.Push( pNewEntry );
-
-	return pNewEntry;
-}
@@ -35,8 +35,10 @@ namespace Helium
 	class HELIUM_ENGINE_API AssetPath
 	{
 	public:
-		/// Number of object path hash table buckets (prime numbers are recommended).
-		static const size_t TABLE_BUCKET_COUNT = 37;
+		/// Initial number of object path hash table slots (must be a power of two).
+		static const size_t TABLE_SLOT_COUNT_MIN = 1024;
+		/// Ratio of hash table slots to entries below which the table is grown.
+		static const size_t TABLE_SLOTS_PER_ENTRY_MIN = 2;
 		/// Asset path stack memory heap block size.
 		static const size_t STACK_HEAP_BLOCK_SIZE = sizeof( char ) * 8192;
 		/// Block size for pool of pending links
@@ -112,30 +114,35 @@ namespace Helium
 			uint32_t instanceIndex;
 			/// True if the object is a package.
 			bool bPackage;
+			/// Hash of the entry contents (only valid for entries in the path table).
+			size_t hash;
 		};
 
-		/// Asset path hash table bucket.
-		class TableBucket
+		/// Asset path hash table.
+		///
+		/// Entries are stored using open addressing with linear probing.  Slots are only ever filled in, never cleared,
+		/// so lookups can safely walk a table without locking while another thread adds entries to it.  When a table
+		/// grows, its entries are copied to a new table that replaces it, and the old table is kept around until
+		/// shutdown for any lookups still in progress.
+		struct Table
 		{
-		public:
-			/// @name Access
-			//@{
-			Entry* Find( const Entry& rEntry, size_t& rEntryCount );
-			Entry* Add( const Entry& rEntry, size_t previousEntryCount );
-			//@}
-
-		private:
-			/// Array of entry pointers.
-			DynamicArray< Entry* > m_entries;
-			/// Read-write lock for synchronizing access.
-			ReadWriteLock m_lock;
+			/// Table slots (null for empty slots).
+			Entry* volatile* ppSlots;
+			/// Number of table slots (always a power of two).
+			size_t slotCount;
+			/// Table replaced by this table when the table was last grown.
+			Table* pPrevious;
 		};
 
 		/// Asset path entry.
 		Entry* m_pEntry;
 
-		/// Asset path hash table.
-		static TableBucket* sm_pTable;
+		/// Current asset path hash table.
+		static Table* volatile sm_pTable;
+		/// Number of entries in the asset path hash table.
+		static size_t sm_entryCount;
+		/// Mutex synchronizing the addition of entries to the asset path hash table.
+		static Mutex* sm_pTableMutex;
 		/// Stack-based memory heap for object path entry allocations.
 		static StackMemoryHeap<>* sm_pEntryMemoryHeap;
 		static ObjectPool<PendingLink> *sm_pPendingLinksPool;
@@ -152,6 +159,9 @@ namespace Helium
 			size_t& rNameCount, size_t& rPackageCount );
 
 		static Entry* Add( const Entry& rEntry );
+		static Entry* FindEntry( const Table& rTable, const Entry& rEntry, size_t hash );
+		static void InsertEntry( Table& rTable, Entry* pEntry );
+		static Table* GrowTable( Table* pTable );
 
 		static void EntryToString( const Entry& rEntry, String& rString );
 		static void EntryToFilePathString( const Entry& rEntry, String& rString );
@@ -0,0 +1,199 @@
+#include "Engine/AssetPath.h"
+
+#include "Foundation/Log.h"
+#include "Platform/Thread.h"
+#include "Platform/Timer.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+namespace
+{
+	/// Number of unique paths interned by the correctness test.
+	const size_t PATH_COUNT = 4096;
+	/// Number of threads interning paths at once in the correctness test.
+	const size_t THREAD_COUNT = 4;
+	/// Number of unique paths interned by the benchmark.
+	const size_t BENCHMARK_PATH_COUNT = 1024 * 1024;
+	/// Largest number of threads interning paths at once in the benchmark.
+	const size_t BENCHMARK_THREAD_COUNT_MAX = 16;
+	/// Number of assets in each generated package.
+	const size_t ASSETS_PER_PACKAGE = 256;
+
+	/// Interns every thread-count-th path string, starting at the thread's index.
+	class InternWorker : public Runnable
+	{
+	public:
+		InternWorker( const DynamicArray< String >& rStrings, DynamicArray< AssetPath >& rPaths, size_t firstIndex, size_t stride )
+			: m_rStrings( rStrings )
+			, m_rPaths( rPaths )
+			, m_firstIndex( firstIndex )
+			, m_stride( stride )
+		{
+		}
+
+		virtual void Run()
+		{
+			size_t pathCount = m_rStrings.GetSize();
+			for( size_t pathIndex = m_firstIndex; pathIndex < pathCount; pathIndex += m_stride )
+			{
+				HELIUM_VERIFY( m_rPaths[ pathIndex ].Set( m_rStrings[ pathIndex ] ) );
+			}
+		}
+
+	private:
+		const DynamicArray< String >& m_rStrings;
+		DynamicArray< AssetPath >& m_rPaths;
+		size_t m_firstIndex;
+		size_t m_stride;
+	};
+
+	/// Generates path strings for each test and releases the path and name tables afterwards.
+	class AssetPathInternTest : public testing::Test
+	{
+	protected:
+		virtual void TearDown()
+		{
+			m_paths.Clear();
+
+			AssetPath::Shutdown();
+			Name::Shutdown();
+		}
+
+		/// Generate path strings for the given number of assets.
+		///
+		/// @param[in] pathCount  Number of unique paths to generate.
+		void GeneratePaths( size_t pathCount )
+		{
+			m_strings.Reserve( pathCount );
+			for( size_t pathIndex = 0; pathIndex < pathCount; ++pathIndex )
+			{
+				String pathString;
+				pathString.Format(
+					"/Benchmark/Package%" PRIuSZ ":Asset%" PRIuSZ,
+					pathIndex / ASSETS_PER_PACKAGE,
+					pathIndex % ASSETS_PER_PACKAGE );
+				m_strings.Push( pathString );
+			}
+
+			m_paths.Resize( pathCount );
+		}
+
+		/// Empty the path table and the paths interned by previous runs.
+		void ResetPaths()
+		{
+			size_t pathCount = m_paths.GetSize();
+			m_paths.Clear();
+			m_paths.Resize( pathCount );
+			AssetPath::Shutdown();
+
+			// Create one path before spawning threads, since the table itself is lazily created without locking.
+			AssetPath rootPath( "/Benchmark" );
+			EXPECT_FALSE( rootPath.IsEmpty() );
+		}
+
+		/// Intern all paths using the given number of threads.
+		///
+		/// @param[in] threadCount  Number of threads to use.
+		///
+		/// @return  Elapsed time, in milliseconds.
+		float64_t Intern( size_t threadCount )
+		{
+			DynamicArray< InternWorker* > workers;
+			DynamicArray< RunnableThread* > threads;
+			workers.Reserve( threadCount );
+			threads.Reserve( threadCount );
+
+			uint64_t startTicks = Timer::GetTickCount();
+
+			for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+			{
+				InternWorker* pWorker = new InternWorker( m_strings, m_paths, threadIndex, threadCount );
+				HELIUM_ASSERT( pWorker );
+				workers.Push( pWorker );
+
+				RunnableThread* pThread = new RunnableThread( pWorker );
+				HELIUM_ASSERT( pThread );
+				HELIUM_VERIFY( pThread->Start( "AssetPathInternTest - intern" ) );
+				threads.Push( pThread );
+			}
+
+			for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+			{
+				threads[ threadIndex ]->Join();
+				delete threads[ threadIndex ];
+				delete workers[ threadIndex ];
+			}
+
+			return static_cast< float64_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+		}
+
+		/// Count the interned paths that do not match a path set from the same string on this thread.
+		size_t CountMismatches() const
+		{
+			size_t mismatchCount = 0;
+			for( size_t pathIndex = 0; pathIndex < m_paths.GetSize(); ++pathIndex )
+			{
+				AssetPath path;
+				HELIUM_VERIFY( path.Set( m_strings[ pathIndex ] ) );
+				if( path != m_paths[ pathIndex ] || path.ToString() != m_strings[ pathIndex ] )
+				{
+					++mismatchCount;
+				}
+			}
+
+			return mismatchCount;
+		}
+
+		DynamicArray< String > m_strings;
+		DynamicArray< AssetPath > m_paths;
+	};
+}
+
+TEST_F( AssetPathInternTest, InternsSamePathsFromManyThreads )
+{
+	GeneratePaths( PATH_COUNT );
+	ResetPaths();
+
+	// The first pass inserts every path, the second looks up the entries that now exist.
+	Intern( THREAD_COUNT );
+	EXPECT_EQ( 0u, CountMismatches() );
+
+	Intern( THREAD_COUNT );
+	EXPECT_EQ( 0u, CountMismatches() );
+
+	// Equal paths share one table entry, so paths interned for the same package compare equal to their parent.
+	EXPECT_EQ( m_paths[ 0 ].GetParent(), m_paths[ ASSETS_PER_PACKAGE - 1 ].GetParent() );
+	EXPECT_NE( m_paths[ 0 ].GetParent(), m_paths[ ASSETS_PER_PACKAGE ].GetParent() );
+}
+
+// Timing run, skipped by default.  Use --gtest_also_run_disabled_tests to run it.
+TEST_F( AssetPathInternTest, DISABLED_BenchmarkInterning )
+{
+	GeneratePaths( BENCHMARK_PATH_COUNT );
+
+	// Intern every path once up front so that name table growth is not part of the timings below.
+	ResetPaths();
+	Intern( 1 );
+
+	for( size_t threadCount = 1; threadCount <= BENCHMARK_THREAD_COUNT_MAX; threadCount *= 2 )
+	{
+		// Start each run from an empty path table, so the first pass measures locked inserts and table growth and the
+		// second pass measures lock-free lookups of existing entries.
+		ResetPaths();
+
+		float64_t insertMilliseconds = Intern( threadCount );
+		float64_t lookupMilliseconds = Intern( threadCount );
+
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			"AssetPath interning, %" PRIuSZ " paths, %" PRIuSZ " thread(s): insert %.2f ms, lookup %.2f ms\n",
+			BENCHMARK_PATH_COUNT,
+			threadCount,
+			insertMilliseconds,
+			lookupMilliseconds );
+
+		EXPECT_EQ( 0u, CountMismatches() );
+	}
+}
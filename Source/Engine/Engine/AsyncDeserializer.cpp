@@ -0,0 +1,323 @@
+#include "Precompile.h"
+#include "Engine/AsyncDeserializer.h"
+
+#include "Platform/Atomic.h"
+#include "Engine/AsyncLoader.h"
+
+#include <thread>
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+AsyncDeserializer* AsyncDeserializer::sm_pInstance = NULL;
+
+/// Constructor.
+AsyncDeserializer::AsyncDeserializer()
+	: m_requestPool( REQUEST_POOL_BLOCK_SIZE )
+	, m_requestQueueHead( 0 )
+	, m_wakeUpCondition( false, false )
+	, m_stopCounter( 0 )
+{
+}
+
+/// Destructor.
+AsyncDeserializer::~AsyncDeserializer()
+{
+	Cleanup();
+}
+
+/// Initialize the async deserializer.
+///
+/// @param[in] workerCount  Number of deserialization worker threads to start.  If this is zero, no requests can be
+///                         queued, and package loaders will deserialize objects on the thread ticking them.
+///
+/// @return  True if initialization was sucessful, false if not.
+///
+/// @see Cleanup()
+bool AsyncDeserializer::Initialize( size_t workerCount )
+{
+	Cleanup();
+
+	AtomicExchangeRelease( m_stopCounter, 0 );
+
+	m_workers.Reserve( workerCount );
+	m_threads.Reserve( workerCount );
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		Worker* pWorker = new Worker( this );
+		HELIUM_ASSERT( pWorker );
+		m_workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		HELIUM_VERIFY( pThread->Start( "AsyncDeserializer - object deserialization" ) );
+		m_threads.Push( pThread );
+	}
+
+	return true;
+}
+
+/// Shut down the async deserializer.
+///
+/// Any requests still queued are processed before the workers exit.
+///
+/// @see Initialize()
+void AsyncDeserializer::Cleanup()
+{
+	// Workers pass the wake-up signal along as they exit, so a single signal stops all of them.
+	AtomicExchangeRelease( m_stopCounter, 1 );
+	m_wakeUpCondition.Signal();
+
+	size_t threadCount = m_threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		RunnableThread* pThread = m_threads[ threadIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
+	}
+
+	m_threads.Clear();
+
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		delete m_workers[ workerIndex ];
+	}
+
+	m_workers.Clear();
+
+	HELIUM_ASSERT( m_requestQueueHead == m_requestQueue.GetSize() );
+	m_requestQueue.Clear();
+	m_requestQueueHead = 0;
+
+	m_wakeUpCondition.Reset();
+}
+
+/// Queue a deserialization request.
+///
+/// @param[in] pCallback  Callback to execute on a worker thread.
+/// @param[in] pData      Data to pass to the callback.  This must remain valid until the request has been synced.
+///
+/// @return  ID identifying the request if queued successfully, invalid index if no workers are running.
+///
+/// @see SyncRequest(), TrySyncRequest()
+size_t AsyncDeserializer::QueueRequest( DESERIALIZE_CALLBACK pCallback, void* pData )
+{
+	HELIUM_ASSERT( pCallback );
+
+	if( m_workers.IsEmpty() )
+	{
+		return Invalid< size_t >();
+	}
+
+	Request* pRequest = m_requestPool.Allocate();
+	HELIUM_ASSERT( pRequest );
+	pRequest->pCallback = pCallback;
+	pRequest->pData = pData;
+
+	AtomicExchangeRelease( pRequest->processedCounter, 0 );
+	pRequest->processedCondition.Reset();
+
+	size_t requestIndex = m_requestPool.GetIndex( pRequest );
+	HELIUM_ASSERT( IsValid( requestIndex ) );
+
+	{
+		MutexScopeLock scopeLock( m_queueLock );
+		m_requestQueue.Push( pRequest );
+	}
+
+	m_wakeUpCondition.Signal();
+
+	return requestIndex;
+}
+
+/// Block the current thread until the request with the specified ID has been processed and release the request
+/// information.
+///
+/// After calling this function, the given ID will no longer be valid.
+///
+/// @param[in] id  Request ID.
+///
+/// @see QueueRequest(), TrySyncRequest()
+void AsyncDeserializer::SyncRequest( size_t id )
+{
+	HELIUM_ASSERT( IsValid( id ) );
+
+	Request* pRequest = m_requestPool.GetObject( id );
+	HELIUM_ASSERT( pRequest );
+
+	// The condition is signaled just before the processed counter is set, so we may briefly need to wait again.
+	while( pRequest->processedCounter == 0 )
+	{
+		pRequest->processedCondition.Wait();
+	}
+
+	m_requestPool.Release( pRequest );
+}
+
+/// Check whether the request with the specified ID has been processed without blocking the current thread, releasing
+/// the request information if it has.
+///
+/// After this function returns true, the given ID will no longer be valid.
+///
+/// @param[in] id  Request ID.
+///
+/// @return  True if the request has been processed and was released, false if it is still pending or in progress.
+///
+/// @see QueueRequest(), SyncRequest()
+bool AsyncDeserializer::TrySyncRequest( size_t id )
+{
+	HELIUM_ASSERT( IsValid( id ) );
+
+	Request* pRequest = m_requestPool.GetObject( id );
+	HELIUM_ASSERT( pRequest );
+	if( pRequest->processedCounter == 0 )
+	{
+		return false;
+	}
+
+	m_requestPool.Release( pRequest );
+
+	return true;
+}
+
+/// Get the singleton AsyncDeserializer instance.
+///
+/// @return  Pointer to the AsyncDeserializer instance.
+///
+/// @see Startup(), Shutdown()
+AsyncDeserializer* AsyncDeserializer::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton AsyncDeserializer instance.
+///
+/// @param[in] workerCount  Number of worker threads to start, zero to always deserialize on the calling thread, or an
+///                         invalid index to start one worker for each hardware thread other than the calling thread
+///                         (up to DEFAULT_WORKER_COUNT_MAX).
+///
+/// @see GetInstance()
+void AsyncDeserializer::Startup( size_t workerCount )
+{
+	if ( ++g_InitCount == 1 )
+	{
+		if( IsInvalid( workerCount ) )
+		{
+			size_t hardwareThreadCount = static_cast< size_t >( std::thread::hardware_concurrency() );
+			workerCount = Min< size_t >( hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0, DEFAULT_WORKER_COUNT_MAX );
+		}
+
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new AsyncDeserializer;
+		HELIUM_ASSERT( sm_pInstance );
+		if ( !HELIUM_VERIFY( sm_pInstance->Initialize( workerCount ) ) )
+		{
+			Shutdown();
+		}
+	}
+}
+
+/// Destroy the singleton AsyncDeserializer instance.
+///
+/// @see GetInstance()
+void AsyncDeserializer::Shutdown()
+{
+	if ( --g_InitCount == 0 )
+	{
+		HELIUM_ASSERT( sm_pInstance );
+		sm_pInstance->Cleanup();
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
+
+/// Pop the next request to process.
+///
+/// @return  Next request in the queue, or null if the queue is empty.
+AsyncDeserializer::Request* AsyncDeserializer::PopRequest()
+{
+	MutexScopeLock scopeLock( m_queueLock );
+
+	size_t queueSize = m_requestQueue.GetSize();
+	if( m_requestQueueHead == queueSize )
+	{
+		return NULL;
+	}
+
+	Request* pRequest = m_requestQueue[ m_requestQueueHead ];
+	HELIUM_ASSERT( pRequest );
+
+	// Reset the queue once drained instead of shifting the remaining entries down on each pop.
+	if( ++m_requestQueueHead == queueSize )
+	{
+		m_requestQueue.Resize( 0 );
+		m_requestQueueHead = 0;
+	}
+	else
+	{
+		// Wake up another worker, as there is still work left to do.
+		m_wakeUpCondition.Signal();
+	}
+
+	return pRequest;
+}
+
+/// Constructor.
+AsyncDeserializer::Request::Request()
+	: processedCondition( true, false )
+{
+}
+
+/// Constructor.
+///
+/// @param[in] pDeserializer  Deserializer from which requests will be processed.
+AsyncDeserializer::Worker::Worker( AsyncDeserializer* pDeserializer )
+	: m_pDeserializer( pDeserializer )
+{
+	HELIUM_ASSERT( pDeserializer );
+}
+
+/// Destructor.
+AsyncDeserializer::Worker::~Worker()
+{
+}
+
+/// Execute the deserialization work.
+void AsyncDeserializer::Worker::Run()
+{
+	for( ; ; )
+	{
+		Request* pRequest = m_pDeserializer->PopRequest();
+		if( !pRequest )
+		{
+			// Only stop once the queue has been drained, as package loaders may be waiting on queued requests.
+			if( m_pDeserializer->m_stopCounter != 0 )
+			{
+				break;
+			}
+
+			m_pDeserializer->m_wakeUpCondition.Wait();
+
+			continue;
+		}
+
+		pRequest->pCallback( pRequest->pData );
+
+		// Note that the request can be released by another thread as soon as its processed counter is set, so it must
+		// not be accessed afterwards.
+		pRequest->processedCondition.Signal();
+		AtomicExchangeRelease( pRequest->processedCounter, 1 );
+
+		// Wake up any thread waiting on load progress in general (such as AssetLoader::FinishLoad()).
+		AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+		if( pAsyncLoader )
+		{
+			pAsyncLoader->SignalCompletion();
+		}
+	}
+
+	// Pass the stop request on to any other workers.
+	m_pDeserializer->m_wakeUpCondition.Signal();
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/ObjectPool.h"
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	/// Async object deserialization manager.
+	///
+	/// Package loaders hand off deserialization of object data that has finished loading to a set of worker threads,
+	/// while object creation, linking, and load finalization remain on the thread ticking the asset loader.  Requests
+	/// are serviced in the order in which they are queued.  If no workers are running, requests cannot be queued, and
+	/// package loaders deserialize objects on the calling thread instead.
+	class HELIUM_ENGINE_API AsyncDeserializer : NonCopyable
+	{
+	public:
+		/// Deserialization callback.
+		///
+		/// @param[in] pData  Request data.
+		typedef void ( *DESERIALIZE_CALLBACK )( void* pData );
+
+		/// Request pool block size.
+		static const size_t REQUEST_POOL_BLOCK_SIZE = 64;
+		/// Maximum number of worker threads started by default.
+		static const size_t DEFAULT_WORKER_COUNT_MAX = 8;
+
+		/// @name Initialization
+		//@{
+		bool Initialize( size_t workerCount );
+		void Cleanup();
+		//@}
+
+		/// @name Deserialization Request Management
+		//@{
+		size_t QueueRequest( DESERIALIZE_CALLBACK pCallback, void* pData );
+		void SyncRequest( size_t id );
+		bool TrySyncRequest( size_t id );
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline size_t GetWorkerCount() const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static AsyncDeserializer* GetInstance();
+		static void Startup( size_t workerCount = Invalid< size_t >() );
+		static void Shutdown();
+		//@}
+
+	private:
+		/// Deserialization request data.
+		struct Request
+		{
+			/// Callback to execute.
+			DESERIALIZE_CALLBACK pCallback;
+			/// Data to pass to the callback.
+			void* pData;
+
+			/// Set to a non-zero value once this request has been processed.
+			volatile int32_t processedCounter;
+			/// Condition signaled once this request has been processed.
+			Condition processedCondition;
+
+			/// @name Construction/Destruction
+			//@{
+			Request();
+			//@}
+		};
+
+		/// Deserialization thread runnable.
+		class Worker : public Runnable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			explicit Worker( AsyncDeserializer* pDeserializer );
+			virtual ~Worker();
+			//@}
+
+			/// @name Runnable Interface
+			//@{
+			virtual void Run();
+			//@}
+
+		private:
+			/// Deserializer that owns this worker.
+			AsyncDeserializer* m_pDeserializer;
+		};
+
+		/// Pool of deserialization request objects.
+		ObjectPool< Request > m_requestPool;
+
+		/// Pending requests, in the order in which they were queued.
+		DynamicArray< Request* > m_requestQueue;
+		/// Index of the first pending request in the request queue.
+		size_t m_requestQueueHead;
+		/// Synchronization for the request queue.
+		Mutex m_queueLock;
+
+		/// Condition used to wake up a worker thread when requests are queued (or when workers should shut down).
+		Condition m_wakeUpCondition;
+
+		/// Non-zero if the worker threads should stop when next possible, zero if they should continue.
+		volatile int32_t m_stopCounter;
+
+		/// Deserialization thread workers.
+		DynamicArray< Worker* > m_workers;
+		/// Deserialization threads.
+		DynamicArray< RunnableThread* > m_threads;
+
+		/// Singleton instance.
+		static AsyncDeserializer* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		AsyncDeserializer();
+		~AsyncDeserializer();
+		//@}
+
+		/// @name Worker Support
+		//@{
+		Request* PopRequest();
+		//@}
+	};
+}
+
+#include "Engine/AsyncDeserializer.inl"
@@ -0,0 +1,7 @@
+/// Get the number of deserialization worker threads running.
+///
+/// @return  Worker thread count.
+size_t Helium::AsyncDeserializer::GetWorkerCount() const
+{
+	return m_workers.GetSize();
+}
@@ -1,6 +1,7 @@
 #include "Precompile.h"
 #include "Engine/AsyncLoader.h"
 
+#include "Platform/Timer.h"
 #include "Engine/FileLocations.h"
 #include "Foundation/FileStream.h"
 
@@ -12,9 +13,17 @@ AsyncLoader* AsyncLoader::sm_pInstance = NULL;
 /// Constructor.
 AsyncLoader::AsyncLoader()
 	: m_requestPool( REQUEST_POOL_BLOCK_SIZE )
-	, m_pThread( NULL )
-	, m_pWorker( NULL )
+	, m_activeRequestCount( 0 )
+	, m_wakeUpCondition( false, false )
+	, m_idleCondition( true, true )
+	, m_completionCondition( false, false )
+	, m_completionCounter( 0 )
+	, m_stopCounter( 0 )
 {
+	for( size_t priorityIndex = 0; priorityIndex < PRIORITY_MAX; ++priorityIndex )
+	{
+		m_requestQueueHeads[ priorityIndex ] = 0;
+	}
 }
 
 /// Destructor.
@@ -25,20 +34,33 @@ AsyncLoader::~AsyncLoader()
 
 /// Initialize the async loader.
 ///
+/// @param[in] workerCount  Number of load worker threads to start.
+///
 /// @return  True if initialization was sucessful, false if not.
 ///
 /// @see Cleanup()
-bool AsyncLoader::Initialize()
+bool AsyncLoader::Initialize( size_t workerCount )
 {
+	HELIUM_ASSERT( workerCount != 0 );
+
 	Cleanup();
 
-	// Start up the async loading thread.
-	m_pWorker = new LoadWorker;
-	HELIUM_ASSERT( m_pWorker );
+	AtomicExchangeRelease( m_stopCounter, 0 );
 
-	m_pThread = new RunnableThread( m_pWorker );
-	HELIUM_ASSERT( m_pThread );
-	HELIUM_VERIFY( m_pThread->Start( "AsyncLoader - file loading" ) );
+	// Start up the async loading threads.
+	m_workers.Reserve( workerCount );
+	m_threads.Reserve( workerCount );
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		LoadWorker* pWorker = new LoadWorker( this );
+		HELIUM_ASSERT( pWorker );
+		m_workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		HELIUM_VERIFY( pThread->Start( "AsyncLoader - file loading" ) );
+		m_threads.Push( pThread );
+	}
 
 	return true;
 }
@@ -48,20 +70,30 @@ bool AsyncLoader::Initialize()
 /// @see Initialize()
 void AsyncLoader::Cleanup()
 {
-	if( m_pWorker )
+	// Workers pass the wake-up signal along as they exit, so a single signal stops all of them.
+	AtomicExchangeRelease( m_stopCounter, 1 );
+	m_wakeUpCondition.Signal();
+
+	size_t threadCount = m_threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
 	{
-		m_pWorker->Stop();
+		RunnableThread* pThread = m_threads[ threadIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
 	}
 
-	if( m_pThread )
+	m_threads.Clear();
+
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
 	{
-		m_pThread->Join();
-		delete m_pThread;
-		m_pThread = NULL;
+		delete m_workers[ workerIndex ];
 	}
 
-	delete m_pWorker;
-	m_pWorker = NULL;
+	m_workers.Clear();
+
+	m_wakeUpCondition.Reset();
 }
 
 /// Queue an async load request.
@@ -70,7 +102,9 @@ void AsyncLoader::Cleanup()
 /// @param[in] rFileName  FilePath name of the file from which to load.
 /// @param[in] offset     Byte offset within the file from which to load.
 /// @param[in] size       Number of bytes to read.
-/// @param[in] priority   Load priority.
+/// @param[in] priority   Load priority.  Requests with a higher priority are always serviced before requests with a
+///                       lower priority, while requests with the same priority are serviced in the order in which they
+///                       are queued.
 ///
 /// @return  ID identifying the load request if queued successfully, invalid index if the request queue failed.
 ///
@@ -85,8 +119,8 @@ size_t AsyncLoader::QueueRequest(
 	HELIUM_ASSERT( pBuffer );
 	HELIUM_ASSERT( static_cast< size_t >( priority ) < static_cast< size_t >( PRIORITY_MAX ) );
 
-	// Make sure the load worker is running.
-	if( !m_pWorker )
+	// Make sure the load workers are running.
+	if( m_workers.IsEmpty() )
 	{
 		return Invalid< size_t >();
 	}
@@ -96,18 +130,33 @@ size_t AsyncLoader::QueueRequest(
 	HELIUM_ASSERT( pRequest );
 	pRequest->pBuffer = pBuffer;
 	pRequest->fileName = rFileName;
+	pRequest->fileId = Name( rFileName );
 	pRequest->offset = offset;
 	pRequest->size = size;
 	pRequest->priority = priority;
+	pRequest->queueTicks = Timer::GetTickCount();
 
 	pRequest->bytesRead = 0;
 	AtomicExchangeRelease( pRequest->processedCounter, 0 );
-
-	m_pWorker->QueueRequest( pRequest );
+	pRequest->processedCondition.Reset();
 
 	size_t requestIndex = m_requestPool.GetIndex( pRequest );
 	HELIUM_ASSERT( IsValid( requestIndex ) );
 
+	{
+		// Prevent access to the load queue while an exclusive write lock is held.
+		ScopeReadLock nonExclusiveLock( m_writeLock );
+
+		MutexScopeLock scopeLock( m_queueLock );
+		m_requestQueues[ priority ].Push( pRequest );
+		if( m_activeRequestCount++ == 0 )
+		{
+			m_idleCondition.Reset();
+		}
+	}
+
+	m_wakeUpCondition.Signal();
+
 	return requestIndex;
 }
 
@@ -129,9 +178,10 @@ size_t AsyncLoader::SyncRequest( size_t id )
 	Request* pRequest = m_requestPool.GetObject( id );
 	HELIUM_ASSERT( pRequest );
 
+	// The condition is signaled just before the processed counter is set, so we may briefly need to wait again.
 	while( pRequest->processedCounter == 0 )
 	{
-		Thread::Yield();
+		pRequest->processedCondition.Wait();
 	}
 
 	size_t bytesRead = pRequest->bytesRead;
@@ -176,20 +226,31 @@ bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
 /// pending requests in order to free any associated resources.
 void AsyncLoader::Flush()
 {
-	if( m_pWorker )
+	if( !m_workers.IsEmpty() )
 	{
-		m_pWorker->Flush();
+		m_idleCondition.Wait();
 	}
 }
 
 /// Lock async loading for writing to files that may be in use.
 ///
+/// This flushes all pending requests and closes all files held open by the load workers.
+///
 /// @see Unlock()
 void AsyncLoader::Lock()
 {
-	if( m_pWorker )
+	// Prevent other threads from queueing requests or writing out data while we have a write lock.
+	m_writeLock.LockWrite();
+
+	Flush();
+
+	// Workers only touch their open files while processing requests, so they can be safely closed from here.
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
 	{
-		m_pWorker->Lock();
+		LoadWorker* pWorker = m_workers[ workerIndex ];
+		HELIUM_ASSERT( pWorker );
+		pWorker->CloseFileStreams();
 	}
 }
 
@@ -198,10 +259,85 @@ void AsyncLoader::Lock()
 /// @see Lock()
 void AsyncLoader::Unlock()
 {
-	if( m_pWorker )
+	m_writeLock.UnlockWrite();
+}
+
+/// Signal that load work has completed.
+///
+/// This is called each time the load workers finish a set of requests, and should also be called by any other code
+/// that finishes load work in the background (such as object deserialization on worker threads) or otherwise allows
+/// pending loads to make progress, so that threads waiting on load progress are woken up.
+///
+/// @see GetCompletionCount(), WaitForCompletion()
+void AsyncLoader::SignalCompletion()
+{
+	// Update the counter first so that a woken thread sees the new count.
+	AtomicIncrementRelease( m_completionCounter );
+	m_completionCondition.Signal();
+}
+
+/// Get the number of times load work completion has been signaled.
+///
+/// Comparing values returned by this function can be used to check whether any load work has completed in the
+/// meantime.
+///
+/// @return  Completion signal count (wraps around on overflow).
+///
+/// @see SignalCompletion()
+int32_t AsyncLoader::GetCompletionCount() const
+{
+	return m_completionCounter;
+}
+
+/// Block the current thread until load work completion is signaled, or until a timeout expires.
+///
+/// This returns immediately if the completion count no longer matches the given value, so callers should read
+/// GetCompletionCount() before checking for progress, and pass that value here to avoid missing completions
+/// signaled in the meantime.  The completion condition only wakes one waiting thread per signal, so other waiters
+/// rely on the timeout to notice the updated count.
+///
+/// @param[in] completionCount       Completion count previously returned by GetCompletionCount().
+/// @param[in] timeoutMilliseconds  Longest time to wait for completion, in milliseconds.
+///
+/// @return  True if load work completion was signaled since the given count was read, false if the wait timed out.
+///
+/// @see SignalCompletion(), GetCompletionCount()
+bool AsyncLoader::WaitForCompletion( int32_t completionCount, uint32_t timeoutMilliseconds )
+{
+	uint64_t startTicks = Timer::GetTickCount();
+	while( m_completionCounter == completionCount )
 	{
-		m_pWorker->Unlock();
+		uint64_t elapsedMilliseconds =
+			static_cast< uint64_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+		if( elapsedMilliseconds >= timeoutMilliseconds )
+		{
+			return false;
+		}
+
+		m_completionCondition.Wait( static_cast< uint32_t >( timeoutMilliseconds - elapsedMilliseconds ) );
 	}
+
+	return true;
+}
+
+/// Get the load statistics accumulated since the loader was created or the statistics were last reset.
+///
+/// @param[out] rStatistics  Load statistics.
+///
+/// @see ResetStatistics()
+void AsyncLoader::GetStatistics( Statistics& rStatistics ) const
+{
+	MutexScopeLock scopeLock( m_statisticsLock );
+	rStatistics = m_statistics;
+}
+
+/// Reset all load statistics to zero.
+///
+/// @see GetStatistics()
+void AsyncLoader::ResetStatistics()
+{
+	MutexScopeLock scopeLock( m_statisticsLock );
+	m_statistics.Reset();
 }
 
 /// Get the singleton AsyncLoader instance.
@@ -245,138 +381,419 @@ void AsyncLoader::Shutdown()
 	}
 }
 
-/// Constructor.
-AsyncLoader::LoadWorker::LoadWorker()
-	: m_wakeUpCondition( false, false )
-	, m_stopCounter( 0 )
-	, m_processingCounter( 0 )
+/// Pop the next request to process from the highest priority queue, along with any other queued requests that
+/// continue reading from where it ends in the same file.
+///
+/// @param[out] rRequests  Requests to process, in file order.
+///
+/// @return  True if any requests were popped, false if all queues are empty.
+///
+/// @see FinishRequests()
+bool AsyncLoader::PopRequests( DynamicArray< Request* >& rRequests )
 {
-}
+	rRequests.Resize( 0 );
 
-/// Destructor.
-AsyncLoader::LoadWorker::~LoadWorker()
-{
-}
+	MutexScopeLock scopeLock( m_queueLock );
 
-/// Execute the async loading work.
-void AsyncLoader::LoadWorker::Run()
-{
-	BufferedStream* pBufferedStream = new BufferedStream;
-	HELIUM_ASSERT( pBufferedStream );
+	// Queues are trimmed after every pop, so the head of a non-empty queue is always a pending request.
+	Request* pRequest = NULL;
+	for( size_t priorityIndex = PRIORITY_MAX; priorityIndex-- > 0; )
+	{
+		DynamicArray< Request* >& rQueue = m_requestQueues[ priorityIndex ];
+		if( !rQueue.IsEmpty() )
+		{
+			size_t& rHead = m_requestQueueHeads[ priorityIndex ];
+			pRequest = rQueue[ rHead ];
+			rQueue[ rHead ] = NULL;
+			TrimRequestQueue( priorityIndex );
 
-	while( m_stopCounter == 0 )
+			break;
+		}
+	}
+
+	if( !pRequest )
 	{
-		AtomicExchangeAcquire( m_processingCounter, 1 );
+		return false;
+	}
 
-		Request* pRequest;
+	HELIUM_ASSERT( pRequest );
+	rRequests.Push( pRequest );
+
+	uint64_t endOffset = pRequest->offset + pRequest->size;
+	bool bFoundAdjacent = true;
+	while( bFoundAdjacent && rRequests.GetSize() < COALESCED_REQUEST_LIMIT )
+	{
+		bFoundAdjacent = false;
+		for( size_t priorityIndex = PRIORITY_MAX; priorityIndex-- > 0 && !bFoundAdjacent; )
 		{
-			Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-			pRequest = handle->IsEmpty() ? NULL : handle->Pop();
+			DynamicArray< Request* >& rQueue = m_requestQueues[ priorityIndex ];
+			size_t queueSize = rQueue.GetSize();
+			for( size_t queueIndex = m_requestQueueHeads[ priorityIndex ]; queueIndex < queueSize; ++queueIndex )
+			{
+				Request* pAdjacentRequest = rQueue[ queueIndex ];
+				if( pAdjacentRequest && pAdjacentRequest->offset == endOffset && pAdjacentRequest->fileId == pRequest->fileId )
+				{
+					rQueue[ queueIndex ] = NULL;
+					TrimRequestQueue( priorityIndex );
+
+					rRequests.Push( pAdjacentRequest );
+					endOffset += pAdjacentRequest->size;
+					bFoundAdjacent = true;
+
+					break;
+				}
+			}
 		}
-		if( !pRequest )
+	}
+
+	// Wake up another worker if there is still work left to do.
+	for( size_t priorityIndex = 0; priorityIndex < PRIORITY_MAX; ++priorityIndex )
+	{
+		if( !m_requestQueues[ priorityIndex ].IsEmpty() )
 		{
-			// Queue is empty, so sleep until notified.
-			AtomicExchangeRelease( m_processingCounter, 0 );
-			m_wakeUpCondition.Wait();
+			m_wakeUpCondition.Signal();
 
-			continue;
+			break;
 		}
+	}
 
-		HELIUM_ASSERT( pRequest );
+	return true;
+}
 
-		FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
-		if( !pFileStream )
-		{
-			SetInvalid( pRequest->bytesRead );
-		}
-		else
-		{
-			pRequest->bytesRead = 0;
+/// Advance the head of a request queue past requests that have already been popped.
+///
+/// The queue is emptied once all of its requests have been popped, and popped entries are discarded once they make up
+/// more than half of the queue, so popping requests takes amortized constant time.  This must be called with the
+/// queue lock held.
+///
+/// @param[in] priorityIndex  Priority of the queue to trim.
+///
+/// @see PopRequests()
+void AsyncLoader::TrimRequestQueue( size_t priorityIndex )
+{
+	DynamicArray< Request* >& rQueue = m_requestQueues[ priorityIndex ];
+	size_t& rHead = m_requestQueueHeads[ priorityIndex ];
 
-			pBufferedStream->Open( pFileStream );
-			int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::Begin );
-			if( static_cast< uint64_t >( offset ) == pRequest->offset )
-			{
-				pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
-			}
+	size_t queueSize = rQueue.GetSize();
+	while( rHead < queueSize && !rQueue[ rHead ] )
+	{
+		++rHead;
+	}
+
+	if( rHead == queueSize )
+	{
+		rQueue.Resize( 0 );
+		rHead = 0;
+	}
+	else if( rHead > queueSize / 2 )
+	{
+		rQueue.Remove( 0, rHead );
+		rHead = 0;
+	}
+}
+
+/// Mark a set of requests popped using PopRequests() as processed and update the load statistics.
+///
+/// @param[in] rRequests    Processed requests.
+/// @param[in] rStatistics  Statistics for the read pass (request counts and latencies are filled in here).
+///
+/// @see PopRequests()
+void AsyncLoader::FinishRequests( const DynamicArray< Request* >& rRequests, const Statistics& rStatistics )
+{
+	uint64_t finishTicks = Timer::GetTickCount();
 
-			pBufferedStream->Open( NULL );
+	size_t requestCount = rRequests.GetSize();
+	{
+		MutexScopeLock scopeLock( m_statisticsLock );
+
+		m_statistics.requestCount += requestCount;
+		m_statistics.coalescedRequestCount += rStatistics.coalescedRequestCount;
+		m_statistics.failedRequestCount += rStatistics.failedRequestCount;
+		m_statistics.fileOpenCount += rStatistics.fileOpenCount;
+		m_statistics.bytesRead += rStatistics.bytesRead;
+		m_statistics.readTicks += rStatistics.readTicks;
+
+		for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+		{
+			const Request* pRequest = rRequests[ requestIndex ];
+			HELIUM_ASSERT( pRequest );
 
-			delete pFileStream;
+			EPriority priority = pRequest->priority;
+			uint64_t latencyTicks = finishTicks - pRequest->queueTicks;
+
+			++m_statistics.priorityRequestCounts[ priority ];
+			m_statistics.priorityLatencyTicks[ priority ] += latencyTicks;
+			m_statistics.priorityMaxLatencyTicks[ priority ] =
+				Max( m_statistics.priorityMaxLatencyTicks[ priority ], latencyTicks );
 		}
+	}
 
+	// Note that a request can be released by another thread as soon as its processed counter is set, so it must not be
+	// accessed afterwards.
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		Request* pRequest = rRequests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+		pRequest->processedCondition.Signal();
 		AtomicExchangeRelease( pRequest->processedCounter, 1 );
+	}
+
+	SignalCompletion();
 
-		Thread::Yield();
+	MutexScopeLock scopeLock( m_queueLock );
+	HELIUM_ASSERT( m_activeRequestCount >= requestCount );
+	m_activeRequestCount -= requestCount;
+	if( m_activeRequestCount == 0 )
+	{
+		m_idleCondition.Signal();
 	}
+}
 
-	AtomicExchangeRelease( m_processingCounter, 0 );
+/// Constructor.
+AsyncLoader::Statistics::Statistics()
+{
+	Reset();
+}
 
-	delete pBufferedStream;
+/// Reset all statistics to zero.
+void AsyncLoader::Statistics::Reset()
+{
+	requestCount = 0;
+	coalescedRequestCount = 0;
+	failedRequestCount = 0;
+	fileOpenCount = 0;
+
+	bytesRead = 0;
+	readTicks = 0;
+
+	MemoryZero( priorityRequestCounts, sizeof( priorityRequestCounts ) );
+	MemoryZero( priorityLatencyTicks, sizeof( priorityLatencyTicks ) );
+	MemoryZero( priorityMaxLatencyTicks, sizeof( priorityMaxLatencyTicks ) );
 }
 
-/// Request the load worker to stop processing and return at the next possible opportunity.
-void AsyncLoader::LoadWorker::Stop()
+/// Get the average time between queueing and completion of requests with the given priority.
+///
+/// @param[in] priority  Request priority.
+///
+/// @return  Average request latency, in milliseconds.
+///
+/// @see GetMaxLatency()
+float32_t AsyncLoader::Statistics::GetAverageLatency( EPriority priority ) const
 {
-	AtomicExchangeRelease( m_stopCounter, 1 );
-	m_wakeUpCondition.Signal();
+	HELIUM_ASSERT( static_cast< size_t >( priority ) < static_cast< size_t >( PRIORITY_MAX ) );
+
+	uint64_t count = priorityRequestCounts[ priority ];
+	if( count == 0 )
+	{
+		return 0.0f;
+	}
+
+	return static_cast< float32_t >( Timer::TicksToMilliseconds( priorityLatencyTicks[ priority ] / count ) );
 }
 
-/// Queue an async load request.
+/// Get the maximum time between queueing and completion of a request with the given priority.
 ///
-/// @param[in] pRequest  Request to queue.  Note that the @c processedCounter value should be set to 0 prior to
-///                      calling this function (the worker thread will set it to 1 once the request has been
-///                      processed).
+/// @param[in] priority  Request priority.
 ///
-/// @see Flush()
-void AsyncLoader::LoadWorker::QueueRequest( Request* pRequest )
+/// @return  Maximum request latency, in milliseconds.
+///
+/// @see GetAverageLatency()
+float32_t AsyncLoader::Statistics::GetMaxLatency( EPriority priority ) const
 {
-	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( pRequest->processedCounter == 0 );
+	HELIUM_ASSERT( static_cast< size_t >( priority ) < static_cast< size_t >( PRIORITY_MAX ) );
 
-	// Prevent access to the load queue while an exclusive write lock is held.
-	ScopeReadLock nonExclusiveLock( m_writeLock );
+	return static_cast< float32_t >( Timer::TicksToMilliseconds( priorityMaxLatencyTicks[ priority ] ) );
+}
 
+/// Get the average read throughput of a single load worker.
+///
+/// @return  Number of bytes read per second of time spent reading.
+float64_t AsyncLoader::Statistics::GetThroughput() const
+{
+	float64_t readMilliseconds = static_cast< float64_t >( Timer::TicksToMilliseconds( readTicks ) );
+	if( readMilliseconds <= 0.0 )
 	{
-		Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-		handle->Push( pRequest );
+		return 0.0;
 	}
 
-	m_wakeUpCondition.Signal();
+	return static_cast< float64_t >( bytesRead ) * 1000.0 / readMilliseconds;
 }
 
-/// Block the current thread until all pending load requests have completed.
+/// Constructor.
+AsyncLoader::Request::Request()
+	: processedCondition( true, false )
+{
+}
+
+/// Constructor.
 ///
-/// @see QueueRequest()
-void AsyncLoader::LoadWorker::Flush()
+/// @param[in] pLoader  Loader from which requests will be processed.
+AsyncLoader::LoadWorker::LoadWorker( AsyncLoader* pLoader )
+	: m_pLoader( pLoader )
+	, m_openFileCount( 0 )
+	, m_useCounter( 0 )
 {
-	bool isEmpty;
+	HELIUM_ASSERT( pLoader );
+}
+
+/// Destructor.
+AsyncLoader::LoadWorker::~LoadWorker()
+{
+	CloseFileStreams();
+}
+
+/// Execute the async loading work.
+void AsyncLoader::LoadWorker::Run()
+{
+	Statistics statistics;
+
+	while( m_pLoader->m_stopCounter == 0 )
 	{
-		Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-		isEmpty = handle->IsEmpty();
+		if( !m_pLoader->PopRequests( m_requests ) )
+		{
+			// Queues are empty, so sleep until notified.
+			m_pLoader->m_wakeUpCondition.Wait();
+
+			continue;
+		}
+
+		statistics.Reset();
+		ProcessRequests( statistics );
+		m_pLoader->FinishRequests( m_requests, statistics );
 	}
 
-	while( m_processingCounter != 0 && !isEmpty )
+	// Pass the stop request on to any other workers.
+	m_pLoader->m_wakeUpCondition.Signal();
+
+	CloseFileStreams();
+}
+
+/// Close all files held open by this worker.
+void AsyncLoader::LoadWorker::CloseFileStreams()
+{
+	for( size_t fileIndex = 0; fileIndex < m_openFileCount; ++fileIndex )
 	{
-		Thread::Yield();
+		OpenFile& rOpenFile = m_openFiles[ fileIndex ];
+		delete rOpenFile.pStream;
+		rOpenFile.pStream = NULL;
+		rOpenFile.fileName.Clear();
 	}
+
+	m_openFileCount = 0;
 }
 
-/// Acquire an exclusive lock for writing to files and flush the async loader queue.
+/// Read the data for the requests popped for the current read pass.
 ///
-/// @see Unlock()
-void AsyncLoader::LoadWorker::Lock()
+/// All requests are for the same file, and are sorted such that each starts where the previous one ends, so the file
+/// only needs to be looked up and seeked once.
+///
+/// @param[in,out] rStatistics  Statistics to update.
+void AsyncLoader::LoadWorker::ProcessRequests( Statistics& rStatistics )
 {
-	// Prevent other threads from queueing requests or writing out data while we have a write lock.
-	m_writeLock.LockWrite();
+	size_t requestCount = m_requests.GetSize();
+	HELIUM_ASSERT( requestCount != 0 );
 
-	Flush();
+	uint64_t startTicks = Timer::GetTickCount();
+
+	OpenFile* pOpenFile = AcquireFile( m_requests[ 0 ]->fileName, rStatistics );
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		Request* pRequest = m_requests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+
+		if( !pOpenFile )
+		{
+			SetInvalid( pRequest->bytesRead );
+			++rStatistics.failedRequestCount;
+
+			continue;
+		}
+
+		FileStream* pStream = pOpenFile->pStream;
+		HELIUM_ASSERT( pStream );
+
+		pRequest->bytesRead = 0;
+
+		if( pOpenFile->position != pRequest->offset )
+		{
+			int64_t offset = pStream->Seek( static_cast< int64_t >( pRequest->offset ), SeekOrigins::Begin );
+			if( static_cast< uint64_t >( offset ) != pRequest->offset )
+			{
+				// Force a seek for the next request, as we don't know where the stream ended up.
+				SetInvalid( pOpenFile->position );
+
+				continue;
+			}
+
+			pOpenFile->position = pRequest->offset;
+		}
+
+		size_t bytesRead = pStream->Read( pRequest->pBuffer, 1, pRequest->size );
+		pRequest->bytesRead = bytesRead;
+		pOpenFile->position += bytesRead;
+
+		rStatistics.bytesRead += bytesRead;
+	}
+
+	rStatistics.coalescedRequestCount += requestCount - 1;
+	rStatistics.readTicks += Timer::GetTickCount() - startTicks;
 }
 
-/// Release an exclusive lock for writing to files.
+/// Get a cached open file stream for the given file, opening the file if necessary.
 ///
-/// @see Lock()
-void AsyncLoader::LoadWorker::Unlock()
+/// If the maximum number of files are already open, the least recently used file is closed.
+///
+/// @param[in]     rFileName    Name of the file to open.
+/// @param[in,out] rStatistics  Statistics to update.
+///
+/// @return  Open file information, or null if the file could not be opened.
+AsyncLoader::LoadWorker::OpenFile* AsyncLoader::LoadWorker::AcquireFile(
+	const String& rFileName,
+	Statistics& rStatistics )
 {
-	m_writeLock.UnlockWrite();
+	++m_useCounter;
+
+	size_t evictIndex = 0;
+	for( size_t fileIndex = 0; fileIndex < m_openFileCount; ++fileIndex )
+	{
+		OpenFile& rOpenFile = m_openFiles[ fileIndex ];
+		if( rOpenFile.fileName == rFileName )
+		{
+			rOpenFile.lastUse = m_useCounter;
+
+			return &rOpenFile;
+		}
+
+		if( rOpenFile.lastUse < m_openFiles[ evictIndex ].lastUse )
+		{
+			evictIndex = fileIndex;
+		}
+	}
+
+	FileStream* pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_READ );
+	if( !pStream )
+	{
+		return NULL;
+	}
+
+	++rStatistics.fileOpenCount;
+
+	size_t fileIndex = evictIndex;
+	if( m_openFileCount < FILE_STREAM_LIMIT )
+	{
+		fileIndex = m_openFileCount;
+		++m_openFileCount;
+	}
+	else
+	{
+		delete m_openFiles[ fileIndex ].pStream;
+	}
+
+	OpenFile& rOpenFile = m_openFiles[ fileIndex ];
+	rOpenFile.fileName = rFileName;
+	rOpenFile.pStream = pStream;
+	rOpenFile.position = 0;
+	rOpenFile.lastUse = m_useCounter;
+
+	return &rOpenFile;
 }
@@ -5,6 +5,7 @@
 #include "Platform/Thread.h"
 
 #include "Foundation/DynamicArray.h"
+#include "Foundation/Name.h"
 #include "Foundation/ObjectPool.h"
 #include "Foundation/String.h"
 
@@ -12,14 +13,24 @@
 
 namespace Helium
 {
+	class FileStream;
+
 	/// Async loading manager.
+	///
+	/// Requests are queued per priority and serviced in FIFO order within each priority by a set of load worker
+	/// threads.  When a worker picks up a request, any other queued requests for data immediately following it in the
+	/// same file are read in the same pass, and each worker keeps recently used files open while requests remain.
 	class HELIUM_ENGINE_API AsyncLoader : NonCopyable
 	{
 	public:
 		/// Request pool block size.
 		static const size_t REQUEST_POOL_BLOCK_SIZE = 128;
-		/// Maximum number of open file streams.
+		/// Maximum number of file streams kept open by each load worker.
 		static const size_t FILE_STREAM_LIMIT = 16;
+		/// Default number of load worker threads.
+		static const size_t DEFAULT_WORKER_COUNT = 2;
+		/// Maximum number of adjacent requests serviced in a single read pass.
+		static const size_t COALESCED_REQUEST_LIMIT = 16;
 
 		/// Load request priority.
 		enum EPriority
@@ -35,9 +46,48 @@ namespace Helium
 			PRIORITY_LAST = PRIORITY_MAX - 1
 		};
 
+		/// Load statistics.
+		struct HELIUM_ENGINE_API Statistics
+		{
+			/// Number of requests completed.
+			uint64_t requestCount;
+			/// Number of requests serviced as part of a read pass started by an adjacent request in the same file.
+			uint64_t coalescedRequestCount;
+			/// Number of requests for which the file could not be opened.
+			uint64_t failedRequestCount;
+			/// Number of times a file was opened.
+			uint64_t fileOpenCount;
+
+			/// Total number of bytes read.
+			uint64_t bytesRead;
+			/// Total time spent by all load workers opening and reading files, in timer ticks.
+			uint64_t readTicks;
+
+			/// Number of requests completed for each priority.
+			uint64_t priorityRequestCounts[ PRIORITY_MAX ];
+			/// Sum of the time between queueing and completion of each request, for each priority, in timer ticks.
+			uint64_t priorityLatencyTicks[ PRIORITY_MAX ];
+			/// Maximum time between queueing and completion of a single request, for each priority, in timer ticks.
+			uint64_t priorityMaxLatencyTicks[ PRIORITY_MAX ];
+
+			/// @name Construction/Destruction
+			//@{
+			Statistics();
+			//@}
+
+			/// @name Data Access
+			//@{
+			void Reset();
+
+			float32_t GetAverageLatency( EPriority priority ) const;
+			float32_t GetMaxLatency( EPriority priority ) const;
+			float64_t GetThroughput() const;
+			//@}
+		};
+
 		/// @name Initialization
 		//@{
-		bool Initialize();
+		bool Initialize( size_t workerCount = DEFAULT_WORKER_COUNT );
 		void Cleanup();
 		//@}
 
@@ -55,6 +105,19 @@ namespace Helium
 		void Unlock();
 		//@}
 
+		/// @name Load Completion Notification
+		//@{
+		void SignalCompletion();
+		int32_t GetCompletionCount() const;
+		bool WaitForCompletion( int32_t completionCount, uint32_t timeoutMilliseconds );
+		//@}
+
+		/// @name Statistics
+		//@{
+		void GetStatistics( Statistics& rStatistics ) const;
+		void ResetStatistics();
+		//@}
+
 		/// @name Static Access
 		//@{
 		static AsyncLoader* GetInstance();
@@ -70,17 +133,28 @@ namespace Helium
 			void* pBuffer;
 			/// File name.
 			String fileName;
+			/// Interned file name, used to find requests for the same file without comparing strings.
+			Name fileId;
 			/// Offset from which to begin reading.
 			uint64_t offset;
 			/// Number of bytes to read.
 			size_t size;
 			/// Priority.
 			EPriority priority;
+			/// Timer tick count at which the request was queued.
+			uint64_t queueTicks;
 
 			/// Number of bytes read.
 			volatile size_t bytesRead;
 			/// Set to a non-zero value once this request has been processed.
 			volatile int32_t processedCounter;
+			/// Condition signaled once this request has been processed.
+			Condition processedCondition;
+
+			/// @name Construction/Destruction
+			//@{
+			Request();
+			//@}
 		};
 
 		/// Async loading thread runnable.
@@ -89,7 +163,7 @@ namespace Helium
 		public:
 			/// @name Construction/Destruction
 			//@{
-			LoadWorker();
+			explicit LoadWorker( AsyncLoader* pLoader );
 			virtual ~LoadWorker();
 			//@}
 
@@ -98,42 +172,82 @@ namespace Helium
 			virtual void Run();
 			//@}
 
-			/// @name External Thread Control
+			/// @name File Stream Caching
 			//@{
-			void Stop();
+			void CloseFileStreams();
 			//@}
 
-			/// @name External Request Queue Control
-			//@{
-			void QueueRequest( Request* pRequest );
-			void Flush();
+		private:
+			/// Cached open file.
+			struct OpenFile
+			{
+				/// File name.
+				String fileName;
+				/// File stream.
+				FileStream* pStream;
+				/// Current stream position.
+				uint64_t position;
+				/// Value of the worker's use counter when the file was last used (for eviction).
+				uint64_t lastUse;
+			};
 
-			void Lock();
-			void Unlock();
-			//@}
+			/// Loader that owns this worker.
+			AsyncLoader* m_pLoader;
 
-		private:
-			/// Async load request queue.
-			Locker< DynamicArray< Request* >, SpinLock > m_requestQueue;
-			/// Condition used to wake up the worker thread when load requests are queued (or when it should shut down).
-			Condition m_wakeUpCondition;
-
-			/// Read-write lock used for synchronization of external file writes.
-			ReadWriteLock m_writeLock;
-
-			/// Non-zero if this thread should stop when next possible, zero if it should continue.
-			volatile int32_t m_stopCounter;
-			/// Non-zero if this thread is currently processing a load request.
-			volatile int32_t m_processingCounter;
+			/// Cached open files.
+			OpenFile m_openFiles[ FILE_STREAM_LIMIT ];
+			/// Number of cached open files.
+			size_t m_openFileCount;
+			/// Counter incremented each time a file is used.
+			uint64_t m_useCounter;
+
+			/// Requests being serviced in the current read pass.
+			DynamicArray< Request* > m_requests;
+
+			/// @name Request Processing
+			//@{
+			void ProcessRequests( Statistics& rStatistics );
+			OpenFile* AcquireFile( const String& rFileName, Statistics& rStatistics );
+			//@}
 		};
 
 		/// Pool of async load request objects.
 		ObjectPool< Request > m_requestPool;
 
-		/// Async loading thread.
-		RunnableThread* m_pThread;
-		/// Async loading thread worker.
-		LoadWorker* m_pWorker;
+		/// Pending requests for each priority, in the order in which they were queued.  Requests before the queue's head
+		/// index have been popped, and requests popped out of order are set to null.
+		DynamicArray< Request* > m_requestQueues[ PRIORITY_MAX ];
+		/// Index of the first pending request in each queue.
+		size_t m_requestQueueHeads[ PRIORITY_MAX ];
+		/// Number of requests queued or being processed.
+		size_t m_activeRequestCount;
+		/// Synchronization for the request queues and active request count.
+		Mutex m_queueLock;
+
+		/// Condition used to wake up a worker thread when load requests are queued (or when workers should shut down).
+		Condition m_wakeUpCondition;
+		/// Condition signaled while no requests are queued or being processed.
+		Condition m_idleCondition;
+		/// Condition signaled each time a set of requests has been processed or SignalCompletion() is called.
+		Condition m_completionCondition;
+		/// Number of times m_completionCondition has been signaled.
+		volatile int32_t m_completionCounter;
+
+		/// Read-write lock used for synchronization of external file writes.
+		ReadWriteLock m_writeLock;
+
+		/// Non-zero if the worker threads should stop when next possible, zero if they should continue.
+		volatile int32_t m_stopCounter;
+
+		/// Async loading thread workers.
+		DynamicArray< LoadWorker* > m_workers;
+		/// Async loading threads.
+		DynamicArray< RunnableThread* > m_threads;
+
+		/// Load statistics.
+		Statistics m_statistics;
+		/// Synchronization for load statistics.
+		mutable Mutex m_statisticsLock;
 
 		/// Singleton instance.
 		static AsyncLoader* sm_pInstance;
@@ -143,5 +257,12 @@ namespace Helium
 		AsyncLoader();
 		~AsyncLoader();
 		//@}
+
+		/// @name Worker Support
+		//@{
+		bool PopRequests( DynamicArray< Request* >& rRequests );
+		void TrimRequestQueue( size_t priorityIndex );
+		void FinishRequests( const DynamicArray< Request* >& rRequests, const Statistics& rStatistics );
+		//@}
 	};
 }
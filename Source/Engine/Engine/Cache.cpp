@@ -9,6 +9,13 @@
 #include "Engine/FileLocations.h"
 #include "Engine/AsyncLoader.h"
 
+#if !HELIUM_OS_WIN
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define USE_BSON_FOR_CACHE_FORMAT 0
 #define USE_JSON_FOR_CACHE_FORMAT 1
 
@@ -43,6 +50,8 @@ Cache::Cache()
 , m_asyncLoadId( Invalid< size_t >() )
 , m_pTocBuffer( NULL )
 , m_tocSize( Invalid< uint32_t >() )
+, m_pMappedCacheData( NULL )
+, m_mappedCacheSize( 0 )
 , m_pEntryPool( NULL )
 {
 }
@@ -110,6 +119,8 @@ bool Cache::Initialize( Name name, EPlatform platform, const char* pTocFileName,
 /// @see Initialize()
 void Cache::Shutdown()
 {
+	UnmapCacheFile();
+
 	m_name = NULL_NAME;
 	m_platform = PLATFORM_INVALID;
 
@@ -304,6 +315,205 @@ void Cache::EnforceTocLoad()
 	}
 }
 
+/// Map a read-only view of the entire cache file into memory.
+///
+/// While mapped, entry data can be accessed in place using GetMappedEntryData() instead of being read into a separate
+/// buffer, avoiding both a file open and a copy for each entry loaded.  The cache cannot be modified using CacheEntry()
+/// while the file is mapped.
+///
+/// This should only be called from the main thread.
+///
+/// @return  True if the cache file is mapped, false if mapping failed (in which case entry data should be read using
+///          the AsyncLoader instead).
+///
+/// @see UnmapCacheFile(), IsCacheFileMapped(), GetMappedEntryData()
+bool Cache::MapCacheFile()
+{
+	if( m_pMappedCacheData )
+	{
+		return true;
+	}
+
+	if( m_cacheFileName.IsEmpty() )
+	{
+		HELIUM_TRACE( TraceLevels::Error, "Cache::MapCacheFile(): Called without having initialized the cache.\n" );
+
+		return false;
+	}
+
+	void* pMapping = NULL;
+	uint64_t fileSize = 0;
+
+#if HELIUM_OS_WIN
+	HANDLE hFile = CreateFileA(
+		*m_cacheFileName,
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		NULL,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+		NULL );
+	if( hFile == INVALID_HANDLE_VALUE )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"Cache::MapCacheFile(): Failed to open cache file \"%s\" for mapping.\n",
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	LARGE_INTEGER fileSizeWin;
+	if( GetFileSizeEx( hFile, &fileSizeWin ) )
+	{
+		fileSize = static_cast< uint64_t >( fileSizeWin.QuadPart );
+	}
+
+	if( fileSize != 0 && fileSize <= static_cast< uint64_t >( SIZE_MAX ) )
+	{
+		HANDLE hMapping = CreateFileMappingA( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+		if( hMapping )
+		{
+			pMapping = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+			// The view holds its own reference to the mapping object and file.
+			CloseHandle( hMapping );
+		}
+	}
+
+	CloseHandle( hFile );
+#else
+	int fileDescriptor = open( *m_cacheFileName, O_RDONLY );
+	if( fileDescriptor == -1 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"Cache::MapCacheFile(): Failed to open cache file \"%s\" for mapping.\n",
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	struct stat fileStatus;
+	if( fstat( fileDescriptor, &fileStatus ) == 0 )
+	{
+		fileSize = static_cast< uint64_t >( fileStatus.st_size );
+	}
+
+	if( fileSize != 0 && fileSize <= static_cast< uint64_t >( SIZE_MAX ) )
+	{
+		pMapping = mmap( NULL, static_cast< size_t >( fileSize ), PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+		if( pMapping == MAP_FAILED )
+		{
+			pMapping = NULL;
+		}
+	}
+
+	// The mapping remains valid after the file descriptor is closed.
+	close( fileDescriptor );
+#endif
+
+	if( !pMapping )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"Cache::MapCacheFile(): Failed to map cache file \"%s\" (%" PRIu64 " bytes) into memory.\n",
+			*m_cacheFileName,
+			fileSize );
+
+		return false;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		"Cache::MapCacheFile(): Mapped cache file \"%s\" (%" PRIu64 " bytes).\n",
+		*m_cacheFileName,
+		fileSize );
+
+	m_pMappedCacheData = static_cast< const uint8_t* >( pMapping );
+	m_mappedCacheSize = fileSize;
+
+	return true;
+}
+
+/// Unmap the cache file view created by MapCacheFile().
+///
+/// Any pointers previously returned by GetMappedEntryData() are invalid once this has been called.
+///
+/// @see MapCacheFile(), IsCacheFileMapped()
+void Cache::UnmapCacheFile()
+{
+	if( !m_pMappedCacheData )
+	{
+		return;
+	}
+
+#if HELIUM_OS_WIN
+	HELIUM_VERIFY( UnmapViewOfFile( m_pMappedCacheData ) );
+#else
+	HELIUM_VERIFY( munmap( const_cast< uint8_t* >( m_pMappedCacheData ), static_cast< size_t >( m_mappedCacheSize ) ) == 0 );
+#endif
+
+	m_pMappedCacheData = NULL;
+	m_mappedCacheSize = 0;
+}
+
+/// Get a pointer to the data for the given entry within the mapped cache file.
+///
+/// @param[in] rEntry  Cache entry.
+///
+/// @return  Pointer to the start of the entry data, or a null pointer if the cache file is not mapped or the entry
+///          extends past the end of the mapped file.
+///
+/// @see PrefetchMappedEntryData(), MapCacheFile()
+const uint8_t* Cache::GetMappedEntryData( const Entry& rEntry ) const
+{
+	if( !m_pMappedCacheData ||
+		rEntry.offset > m_mappedCacheSize ||
+		rEntry.size > m_mappedCacheSize - rEntry.offset )
+	{
+		return NULL;
+	}
+
+	return m_pMappedCacheData + rEntry.offset;
+}
+
+/// Hint to the operating system that the data for the given entry within the mapped cache file will be accessed soon.
+///
+/// This returns immediately, with the entry's pages read in the background so that the data is ideally resident by
+/// the time it is deserialized.
+///
+/// @param[in] rEntry  Cache entry.
+///
+/// @see GetMappedEntryData()
+void Cache::PrefetchMappedEntryData( const Entry& rEntry ) const
+{
+	const uint8_t* pEntryData = GetMappedEntryData( rEntry );
+	if( !pEntryData || rEntry.size == 0 )
+	{
+		return;
+	}
+
+#if HELIUM_OS_WIN
+#if _WIN32_WINNT >= 0x0602
+	WIN32_MEMORY_RANGE_ENTRY memoryRange;
+	memoryRange.VirtualAddress = const_cast< uint8_t* >( pEntryData );
+	memoryRange.NumberOfBytes = rEntry.size;
+	PrefetchVirtualMemory( GetCurrentProcess(), 1, &memoryRange, 0 );
+#endif
+#else
+	// madvise() requires a page-aligned start address.
+	uintptr_t pageSize = static_cast< uintptr_t >( sysconf( _SC_PAGESIZE ) );
+	uintptr_t entryStart = reinterpret_cast< uintptr_t >( pEntryData );
+	uintptr_t pageStart = entryStart & ~( pageSize - 1 );
+
+	madvise(
+		reinterpret_cast< void* >( pageStart ),
+		static_cast< size_t >( entryStart - pageStart ) + rEntry.size,
+		MADV_WILLNEED );
+#endif
+}
+
 /// Search for a cache entry with the given object path name.
 ///
 /// @param[in] path          Asset path.
@@ -346,6 +556,17 @@ bool Cache::CacheEntry(
 {
 	HELIUM_ASSERT( pData || size == 0 );
 
+	if( m_pMappedCacheData )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"Cache: Cannot cache \"%s\" while cache \"%s\" is mapped into memory.\n",
+			*path.ToString(),
+			*m_cacheFileName );
+
+		return false;
+	}
+
 	Status status;
 	status.Read( m_cacheFileName.GetData() );
 	int64_t cacheFileSize = status.m_Size;
@@ -8,6 +8,12 @@
 #include "Engine/AssetPath.h"
 #include "Reflect/Object.h"
 
+/// Non-zero to read cache entries directly from a memory-mapped view of the cache file when possible.  Caches can be
+/// modified at runtime in tools builds, so mapping is disabled there.
+#ifndef HELIUM_CACHE_MEMORY_MAPPING
+#define HELIUM_CACHE_MEMORY_MAPPING ( !HELIUM_TOOLS )
+#endif
+
 namespace Helium
 {
 	/// Serialization cache interface.
@@ -72,6 +78,16 @@ namespace Helium
 		void EnforceTocLoad();
 		//@}
 
+		/// @name Memory Mapping
+		//@{
+		bool MapCacheFile();
+		void UnmapCacheFile();
+		inline bool IsCacheFileMapped() const;
+
+		const uint8_t* GetMappedEntryData( const Entry& rEntry ) const;
+		void PrefetchMappedEntryData( const Entry& rEntry ) const;
+		//@}
+
 		/// @name Data Access
 		//@{
 		inline Name GetName() const;
@@ -145,6 +161,11 @@ namespace Helium
 		/// Size of the TOC, in bytes.
 		uint32_t m_tocSize;
 
+		/// Base address of the read-only view of the cache file, if mapped.
+		const uint8_t* m_pMappedCacheData;
+		/// Size of the mapped cache file view, in bytes.
+		uint64_t m_mappedCacheSize;
+
 		/// Cache entry pool.
 		ObjectPool< Entry >* m_pEntryPool;
 		/// Cache entry information.
@@ -8,6 +8,16 @@ bool Helium::Cache::IsTocLoaded() const
     return m_bTocLoaded;
 }
 
+/// Get whether the cache file is currently mapped into memory.
+///
+/// @return  True if the cache file is mapped, false if not.
+///
+/// @see MapCacheFile(), UnmapCacheFile(), GetMappedEntryData()
+bool Helium::Cache::IsCacheFileMapped() const
+{
+    return ( m_pMappedCacheData != NULL );
+}
+
 /// Get the name used to identify this cache.
 ///
 /// @return  Cache name.
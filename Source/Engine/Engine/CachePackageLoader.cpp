@@ -3,6 +3,7 @@
 
 #include "Engine/Asset.h"
 #include "Engine/AssetLoader.h"
+#include "Engine/AsyncDeserializer.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/CacheManager.h"
 #include "Engine/Resource.h"
@@ -13,6 +14,7 @@ using namespace Helium;
 CachePackageLoader::CachePackageLoader()
 : m_pCache( NULL )
 , m_bFinishedCacheTocLoad( false )
+, m_bCacheFileMapped( false )
 , m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
 {
 }
@@ -76,6 +78,16 @@ void CachePackageLoader::Shutdown()
 				pAsyncLoader->SyncRequest( pRequest->asyncLoadId );
 			}
 
+			if( IsValid( pRequest->deserializeId ) )
+			{
+				AsyncDeserializer* pAsyncDeserializer = AsyncDeserializer::GetInstance();
+				HELIUM_ASSERT( pAsyncDeserializer );
+				pAsyncDeserializer->SyncRequest( pRequest->deserializeId );
+			}
+
+			pRequest->spCachedObject.Release();
+			pRequest->spCachedResourceData.Release();
+
 			allocator.Free( pRequest->pAsyncLoadBuffer );
 
 			m_loadRequestPool.Release( pRequest );
@@ -86,6 +98,7 @@ void CachePackageLoader::Shutdown()
 
 	m_pCache = NULL;
 	m_bFinishedCacheTocLoad = false;
+	m_bCacheFileMapped = false;
 }
 
 /// Begin asynchronous loading of the cache table of contents.
@@ -102,7 +115,11 @@ bool CachePackageLoader::BeginPreload()
 	bool bResult = m_pCache->IsTocLoaded();
 	m_bFinishedCacheTocLoad = bResult;
 
-	if( !bResult )
+	if( bResult )
+	{
+		FinishPreload();
+	}
+	else
 	{
 		bResult = m_pCache->BeginLoadToc();
 	}
@@ -120,6 +137,11 @@ bool CachePackageLoader::TryFinishPreload()
 	{
 		bResult = ( m_pCache->IsTocLoaded() || m_pCache->TryFinishLoadToc() );
 		m_bFinishedCacheTocLoad = bResult;
+
+		if( bResult )
+		{
+			FinishPreload();
+		}
 	}
 
 	return bResult;
@@ -149,10 +171,14 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 
 		SetInvalid( pRequest->asyncLoadId );
 		pRequest->pAsyncLoadBuffer = NULL;
+		pRequest->pCacheData = NULL;
 		pRequest->pPropertyDataBegin = NULL;
 		pRequest->pPropertyDataEnd = NULL;
 		pRequest->pPersistentResourceDataBegin = NULL;
 		pRequest->pPersistentResourceDataEnd = NULL;
+		SetInvalid( pRequest->deserializeId );
+		HELIUM_ASSERT( !pRequest->spCachedObject );
+		HELIUM_ASSERT( !pRequest->spCachedResourceData );
 		SetInvalid( pRequest->ownerLoadIndex );
 		HELIUM_ASSERT( !pRequest->spOwner );
 		pRequest->forceReload = forceReload;
@@ -206,10 +232,14 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	HELIUM_ASSERT( !pRequest->spObject );
 	SetInvalid( pRequest->asyncLoadId );
 	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->pCacheData = NULL;
 	pRequest->pPropertyDataBegin = NULL;
 	pRequest->pPropertyDataEnd = NULL;
 	pRequest->pPersistentResourceDataBegin = NULL;
 	pRequest->pPersistentResourceDataEnd = NULL;
+	SetInvalid( pRequest->deserializeId );
+	HELIUM_ASSERT( !pRequest->spCachedObject );
+	HELIUM_ASSERT( !pRequest->spCachedResourceData );
 	SetInvalid( pRequest->ownerLoadIndex );
 	HELIUM_ASSERT( !pRequest->spOwner );
 	pRequest->forceReload = forceReload;
@@ -234,24 +264,44 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	{
 		HELIUM_ASSERT( !pObject || !pObject->GetAnyFlagSet( Asset::FLAG_LOADED | Asset::FLAG_LINKED ) );
 
-		HELIUM_TRACE(
-			TraceLevels::Debug,
-			"CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n",
-			*path.ToString() );
+		// Read the object data in place if the cache file is mapped, prefetching its pages so that they are ideally
+		// resident by the time the request is ticked.
+		if( m_bCacheFileMapped )
+		{
+			pRequest->pCacheData = m_pCache->GetMappedEntryData( *pEntry );
+		}
 
-		size_t entrySize = pEntry->size;
-		pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
-		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+		if( pRequest->pCacheData )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				"CachePackageLoader::BeginLoadObject(): Prefetching mapped property data for \"%s\".\n",
+				*path.ToString() );
 
-		AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
-		HELIUM_ASSERT( pAsyncLoader );
+			m_pCache->PrefetchMappedEntryData( *pEntry );
+		}
+		else
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				"CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n",
+				*path.ToString() );
+
+			size_t entrySize = pEntry->size;
+			pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
+			HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+			pRequest->pCacheData = pRequest->pAsyncLoadBuffer;
 
-		pRequest->asyncLoadId = pAsyncLoader->QueueRequest(
-			pRequest->pAsyncLoadBuffer,
-			m_pCache->GetCacheFileName(),
-			pEntry->offset,
-			entrySize );
-		HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+			AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+			HELIUM_ASSERT( pAsyncLoader );
+
+			pRequest->asyncLoadId = pAsyncLoader->QueueRequest(
+				pRequest->pAsyncLoadBuffer,
+				m_pCache->GetCacheFileName(),
+				pEntry->offset,
+				entrySize );
+			HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+		}
 	}
 
 	size_t requestId = m_loadRequests.Add( pRequest );
@@ -333,6 +383,8 @@ bool CachePackageLoader::TryFinishLoadObject( size_t requestId, AssetPtr& rspObj
 /// Update this package loader.
 void CachePackageLoader::Tick()
 {
+	bool bPreloadedRequest = false;
+
 	// Process pending load requests.
 	size_t loadRequestSize = m_loadRequests.GetSize();
 	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestSize; ++loadRequestIndex )
@@ -347,7 +399,7 @@ void CachePackageLoader::Tick()
 
 		if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
 		{
-			if( IsValid( pRequest->asyncLoadId ) )
+			if( !( pRequest->flags & LOAD_FLAG_CACHE_DATA_READ ) )
 			{
 				if( !TickCacheLoad( pRequest ) )
 				{
@@ -363,11 +415,24 @@ void CachePackageLoader::Tick()
 					continue;
 				}
 			}
+
+			bPreloadedRequest = true;
 		}
 
 		HELIUM_ASSERT( IsInvalid( pRequest->asyncLoadId ) );
 		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer == NULL );
 	}
+
+	// Objects read from the mapped cache file or waiting on their owner or template can finish preloading here without
+	// any async work completing, so wake up anything waiting on load progress.
+	if( bPreloadedRequest )
+	{
+		AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+		if( pAsyncLoader )
+		{
+			pAsyncLoader->SignalCompletion();
+		}
+	}
 }
 
 /// @copydoc PackageLoader::GetObjectCount()
@@ -399,16 +464,26 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
 
-	AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
-	HELIUM_ASSERT( pAsyncLoader );
-
 	size_t bytesRead = 0;
-	if( !pAsyncLoader->TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+	if( IsValid( pRequest->asyncLoadId ) )
 	{
-		return false;
-	}
+		AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+		HELIUM_ASSERT( pAsyncLoader );
 
-	SetInvalid( pRequest->asyncLoadId );
+		if( !pAsyncLoader->TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->asyncLoadId );
+	}
+	else
+	{
+		// Data is read directly from the mapped cache file, so the entire entry is already available.
+		HELIUM_ASSERT( pRequest->pEntry );
+		HELIUM_ASSERT( pRequest->pCacheData );
+		bytesRead = pRequest->pEntry->size;
+	}
 
 	if( bytesRead == 0 || IsInvalid( bytesRead ) )
 	{
@@ -421,12 +496,21 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 	}
 	else
 	{
-		uint8_t* pBufferEnd = pRequest->pAsyncLoadBuffer + bytesRead;
+		const uint8_t* pBufferEnd = pRequest->pCacheData + bytesRead;
 		pRequest->pPropertyDataEnd = pBufferEnd;
 		pRequest->pPersistentResourceDataEnd = pBufferEnd;
 
 		if( ReadCacheData( pRequest ) )
 		{
+			pRequest->flags |= LOAD_FLAG_CACHE_DATA_READ;
+
+			// Deserialize the object on a worker thread while its owner loads, if any workers are available.
+			AsyncDeserializer* pAsyncDeserializer = AsyncDeserializer::GetInstance();
+			if( pAsyncDeserializer )
+			{
+				pRequest->deserializeId = pAsyncDeserializer->QueueRequest( &DeserializeCallback, pRequest );
+			}
+
 			return true;
 		}
 	}
@@ -435,6 +519,7 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 	// else will be done with the object itself from here on out).
 	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
 	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->pCacheData = NULL;
 
 	Asset* pObject = pRequest->spObject;
 	if( pObject )
@@ -463,6 +548,28 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	const Cache::Entry* pCacheEntry = pRequest->pEntry;
 	HELIUM_ASSERT( pCacheEntry );
 
+	// Wait for the object data to be deserialized (deserializing it here if no workers are available).
+	if( !( pRequest->flags & LOAD_FLAG_DESERIALIZED ) )
+	{
+		if( IsValid( pRequest->deserializeId ) )
+		{
+			AsyncDeserializer* pAsyncDeserializer = AsyncDeserializer::GetInstance();
+			HELIUM_ASSERT( pAsyncDeserializer );
+			if( !pAsyncDeserializer->TrySyncRequest( pRequest->deserializeId ) )
+			{
+				return false;
+			}
+
+			SetInvalid( pRequest->deserializeId );
+		}
+		else
+		{
+			DeserializeCacheData( pRequest );
+		}
+
+		pRequest->flags |= LOAD_FLAG_DESERIALIZED;
+	}
+
 	// Wait for the template and owner objects to load.
 	AssetLoader* pAssetLoader = AssetLoader::GetInstance();
 	HELIUM_ASSERT( pAssetLoader );
@@ -486,6 +593,10 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 
 			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
 			pRequest->pAsyncLoadBuffer = NULL;
+			pRequest->pCacheData = NULL;
+
+			pRequest->spCachedObject.Release();
+			pRequest->spCachedResourceData.Release();
 
 			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -497,11 +608,8 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 
 	HELIUM_ASSERT( !pOwner || pOwner->IsFullyLoaded() );
 	
-	Reflect::ObjectPtr cached_object = Cache::ReadCacheObjectFromBuffer(
-		pRequest->pPropertyDataBegin, 
-		0, 
-		pRequest->pPropertyDataEnd - pRequest->pPropertyDataBegin, 
-		pRequest->pResolver);
+	Reflect::ObjectPtr cached_object = pRequest->spCachedObject;
+	pRequest->spCachedObject.Release();
 
 	AssetPtr assetPtr = Reflect::AssertCast<Asset>(cached_object);
 
@@ -538,11 +646,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 			Resource* pResource = Reflect::SafeCast< Resource >( pObject );
 			if( pResource )
 			{
-				Reflect::ObjectPtr cached_prd = Cache::ReadCacheObjectFromBuffer(
-					pRequest->pPersistentResourceDataBegin, 
-					0, 
-					(pRequest->pPersistentResourceDataEnd - pRequest->pPersistentResourceDataBegin),
-					pRequest->pResolver);
+				Reflect::ObjectPtr cached_prd = pRequest->spCachedResourceData;
 
 				if (!cached_prd.ReferencesObject())
 				{
@@ -561,6 +665,9 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 
 	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
 	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->pCacheData = NULL;
+
+	pRequest->spCachedResourceData.Release();
 
 	pObject->SetFlags( Asset::FLAG_PRELOADED );
 
@@ -570,6 +677,17 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	return true;
 }
 
+/// Set up object loading once the cache table of contents has been loaded.
+void CachePackageLoader::FinishPreload()
+{
+	HELIUM_ASSERT( m_pCache );
+
+#if HELIUM_CACHE_MEMORY_MAPPING
+	// Read object data directly from a mapping of the cache file if possible, falling back to async reads if not.
+	m_bCacheFileMapped = m_pCache->MapCacheFile();
+#endif
+}
+
 /// Recursive function for resolving a package request.
 ///
 /// @param[out] rspPackage   Resolved package.
@@ -608,8 +726,8 @@ bool CachePackageLoader::ReadCacheData( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
 
-	uint8_t* pBufferCurrent = pRequest->pAsyncLoadBuffer;
-	uint8_t* pPropertyDataEnd = pRequest->pPropertyDataEnd;
+	const uint8_t* pBufferCurrent = pRequest->pCacheData;
+	const uint8_t* pPropertyDataEnd = pRequest->pPropertyDataEnd;
 	HELIUM_ASSERT( pBufferCurrent );
 	HELIUM_ASSERT( pPropertyDataEnd );
 	HELIUM_ASSERT( pBufferCurrent <= pPropertyDataEnd );
@@ -679,3 +797,40 @@ bool CachePackageLoader::ReadCacheData( LoadRequest* pRequest )
 
 	return true;
 }
+
+/// Deserialize the property and persistent resource data streams for an object load.
+///
+/// This may be run on a deserialization worker thread, so it must not touch anything outside of the request itself.
+/// Creation of the object within the object hierarchy is left to TickDeserialize().
+///
+/// @param[in] pRequest  Load request data.
+void CachePackageLoader::DeserializeCacheData( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->flags & LOAD_FLAG_CACHE_DATA_READ );
+
+	pRequest->spCachedObject = Cache::ReadCacheObjectFromBuffer(
+		pRequest->pPropertyDataBegin, 
+		0, 
+		pRequest->pPropertyDataEnd - pRequest->pPropertyDataBegin, 
+		pRequest->pResolver);
+
+	// Whether the persistent resource data is needed is only known once the object is set up, but it is cheap to
+	// deserialize it ahead of time for default templates as well.
+	if( pRequest->spCachedObject && pRequest->spCachedObject->IsA( Reflect::GetMetaClass< Resource >() ) )
+	{
+		pRequest->spCachedResourceData = Cache::ReadCacheObjectFromBuffer(
+			pRequest->pPersistentResourceDataBegin, 
+			0, 
+			(pRequest->pPersistentResourceDataEnd - pRequest->pPersistentResourceDataBegin),
+			pRequest->pResolver);
+	}
+}
+
+/// AsyncDeserializer callback for deserializing cache data on a worker thread.
+///
+/// @param[in] pData  Load request data.
+void CachePackageLoader::DeserializeCallback( void* pData )
+{
+	DeserializeCacheData( static_cast< LoadRequest* >( pData ) );
+}
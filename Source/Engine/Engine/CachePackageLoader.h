@@ -52,7 +52,11 @@ namespace Helium
 			/// Set once object preloading has completed.
 			LOAD_FLAG_PRELOADED = 1 << 0,
 			/// Set when an error has occurred in the load process.
-			LOAD_FLAG_ERROR = 1 << 1
+			LOAD_FLAG_ERROR = 1 << 1,
+			/// Set once the cache data for the object has been read and its streams located.
+			LOAD_FLAG_CACHE_DATA_READ = 1 << 2,
+			/// Set once the object property and persistent resource data streams have been deserialized.
+			LOAD_FLAG_DESERIALIZED = 1 << 3
 		};
 
 		/// Asset load request data.
@@ -67,17 +71,26 @@ namespace Helium
 
 			/// Async load ID.
 			size_t asyncLoadId;
-			/// Async load buffer.
+			/// Async load buffer (null if the data is read from the memory-mapped cache file).
 			uint8_t* pAsyncLoadBuffer;
+			/// Cache data for the object (either pAsyncLoadBuffer or a view into the memory-mapped cache file).
+			const uint8_t* pCacheData;
 
-			/// Pointer to where the property data begins within the pAsyncLoadBuffer
-			uint8_t* pPropertyDataBegin;
+			/// Pointer to where the property data begins within the pCacheData
+			const uint8_t* pPropertyDataBegin;
 			/// End of the property data
-			uint8_t* pPropertyDataEnd;
-			/// Pointer to where the persistent resource data begins within the pAsyncLoadBuffer
-			uint8_t* pPersistentResourceDataBegin;
+			const uint8_t* pPropertyDataEnd;
+			/// Pointer to where the persistent resource data begins within the pCacheData
+			const uint8_t* pPersistentResourceDataBegin;
 			/// End of the persistent resource data.
-			uint8_t* pPersistentResourceDataEnd;
+			const uint8_t* pPersistentResourceDataEnd;
+
+			/// Async deserialization ID.
+			size_t deserializeId;
+			/// Object deserialized from the property data.
+			Reflect::ObjectPtr spCachedObject;
+			/// Object deserialized from the persistent resource data.
+			Reflect::ObjectPtr spCachedResourceData;
 
 			// Load index for the owning asset
 			size_t ownerLoadIndex;
@@ -95,6 +108,8 @@ namespace Helium
 		Cache* m_pCache;
 		/// True if we've synced the cache TOC load process.
 		bool m_bFinishedCacheTocLoad;
+		/// True if object data is read directly from the memory-mapped cache file.
+		bool m_bCacheFileMapped;
 
 		/// Pending load requests.
 		SparseArray< LoadRequest* > m_loadRequests;
@@ -107,10 +122,17 @@ namespace Helium
 		bool TickDeserialize( LoadRequest* pRequest );
 		//@}
 
+		/// @name Private Utility Functions
+		//@{
+		void FinishPreload();
+		//@}
+
 		/// @name Static Private Utility Functions
 		//@{
 		static void ResolvePackage( AssetPtr& spPackage, AssetPath packagePath );
 		static bool ReadCacheData( LoadRequest* pRequest );
+		static void DeserializeCacheData( LoadRequest* pRequest );
+		static void DeserializeCallback( void* pData );
 		//@}
 	};
 }
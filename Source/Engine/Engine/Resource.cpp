@@ -171,3 +171,26 @@ bool Resource::TryFinishLoadSubData( size_t loadId )
 
 	return bFinished;
 }
+
+/// Block until an asynchronous sub-data load request has completed.
+///
+/// @param[in] loadId  ID associated with the load request.
+///
+/// @see TryFinishLoadSubData()
+void Resource::FinishLoadSubData( size_t loadId )
+{
+	HELIUM_ASSERT( IsValid( loadId ) );
+
+#if HELIUM_TOOLS
+	// In-memory requests are performed immediately.
+	if( loadId == static_cast< size_t >( -2 ) )
+	{
+		return;
+	}
+#endif
+
+	AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+	HELIUM_ASSERT( pAsyncLoader );
+
+	pAsyncLoader->SyncRequest( loadId );
+}
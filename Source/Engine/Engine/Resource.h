@@ -66,6 +66,7 @@ namespace Helium
 		size_t GetSubDataSize( uint32_t subDataIndex ) const;
 		size_t BeginLoadSubData( void* pBuffer, uint32_t subDataIndex, size_t loadSizeMax = Invalid< size_t >() );
 		bool TryFinishLoadSubData( size_t loadId );
+		void FinishLoadSubData( size_t loadId );
 		//@}
 
 	private:
@@ -4,6 +4,7 @@
 #include "Foundation/Functions.h"
 #include "EngineJobs/EngineJobs.h"
 #include "EngineJobs/EngineJobsTypes.h"
+#include "EngineJobs/JobManager.h"
 
 namespace Helium
 {
@@ -54,7 +55,70 @@ private:
     Parameters m_parameters;
 };
 
+/// Parallel least-significant-digit radix sort of 64-bit keys with associated values.
+///
+/// Keys are sorted in ascending order eight bits at a time, and elements with equal keys keep their relative order.
+/// Each pass splits the array into contiguous blocks that are counted and scattered by separate jobs.  Passes over
+/// digits that are the same for every key are skipped, so keys that only use some of their bits cost no more than
+/// their significant digits.
+template< typename T >
+class RadixSortJob : Helium::NonCopyable
+{
+public:
+    /// Number of key bits sorted by each pass.
+    static const uint32_t DIGIT_BITS = 8;
+    /// Number of possible digit values in each pass.
+    static const size_t DIGIT_VALUE_COUNT = 1 << DIGIT_BITS;
+    /// Maximum number of blocks into which each pass is split.
+    static const size_t BLOCK_COUNT_MAX = 64;
+
+    class Parameters
+    {
+    public:
+        /// [inout] Pointer to the first key to sort.
+        uint64_t* pKeys;
+        /// [inout] Pointer to the first value to reorder along with its key.
+        T* pValues;
+        /// [in] Scratch space for at least "count" keys.
+        uint64_t* pScratchKeys;
+        /// [in] Scratch space for at least "count" values.
+        T* pScratchValues;
+        /// [in] Number of elements to sort.
+        size_t count;
+        /// [in] Minimum number of elements to process within each job.
+        size_t singleJobCount;
+
+        /// @name Construction/Destruction
+        //@{
+        inline Parameters();
+        //@}
+    };
+
+    /// @name Construction/Destruction
+    //@{
+    inline RadixSortJob();
+    inline ~RadixSortJob();
+    //@}
+
+    /// @name Parameters
+    //@{
+    inline Parameters& GetParameters();
+    inline const Parameters& GetParameters() const;
+    inline void SetParameters( const Parameters& rParameters );
+    //@}
+
+    /// @name Job Execution
+    //@{
+    void Run();
+    inline static void RunCallback( void* pJob );
+    //@}
+
+private:
+    Parameters m_parameters;
+};
+
 }  // namespace Helium
 
 #include "EngineJobs/EngineJobsInterface.inl"
 #include "EngineJobs/SortJob.inl"
+#include "EngineJobs/RadixSortJob.inl"
@@ -64,5 +64,71 @@ namespace Helium
 	{
 	}
 
-}  // namespace Helium
+	/// Constructor.
+	template< typename T >
+	RadixSortJob< T >::RadixSortJob()
+	{
+	}
+
+	/// Destructor.
+	template< typename T >
+	RadixSortJob< T >::~RadixSortJob()
+	{
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	template< typename T >
+	typename RadixSortJob< T >::Parameters& RadixSortJob< T >::GetParameters()
+	{
+		return m_parameters;
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Constant reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	template< typename T >
+	const typename RadixSortJob< T >::Parameters& RadixSortJob< T >::GetParameters() const
+	{
+		return m_parameters;
+	}
+
+	/// Set the job parameters.
+	///
+	/// @param[in] rParameters  MetaStruct containing the job parameters.
+	///
+	/// @see GetParameters()
+	template< typename T >
+	void RadixSortJob< T >::SetParameters( const Parameters& rParameters )
+	{
+		m_parameters = rParameters;
+	}
 
+	/// Callback executed to run the job.
+	///
+	/// @param[in] pJob  Job to run.
+	template< typename T >
+	void RadixSortJob< T >::RunCallback( void* pJob )
+	{
+		HELIUM_ASSERT( pJob );
+		static_cast< RadixSortJob* >( pJob )->Run();
+	}
+
+	/// Constructor.
+	template< typename T >
+	RadixSortJob< T >::Parameters::Parameters()
+		: pKeys( NULL )
+		, pValues( NULL )
+		, pScratchKeys( NULL )
+		, pScratchValues( NULL )
+		, count( 0 )
+		, singleJobCount( 1024 )
+	{
+	}
+
+}  // namespace Helium
@@ -0,0 +1,673 @@
+#include "Precompile.h"
+#include "EngineJobs/JobManager.h"
+
+#include "Platform/Atomic.h"
+#include "Platform/Trace.h"
+
+#include <thread>
+
+/// Time (in milliseconds) an idle worker sleeps before checking the job queues again if it is not signaled.
+static const uint32_t WORKER_IDLE_TIMEOUT = 1;
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+JobManager* JobManager::sm_pInstance = NULL;
+
+/// Constructor.
+JobManager::JobManager()
+	: m_pJobPool( NULL )
+	, m_jobAllocationCounter( 0 )
+	, m_pQueues( NULL )
+	, m_queueCount( 0 )
+	, m_wakeUpCondition( false, false )
+	, m_idleWorkerCount( 0 )
+	, m_stopCounter( 0 )
+{
+}
+
+/// Destructor.
+JobManager::~JobManager()
+{
+	Cleanup();
+}
+
+/// Initialize the job manager and start its worker threads.
+///
+/// @param[in] workerCount  Number of worker threads to start.  If zero, jobs will only be executed by threads
+///                         calling Wait().
+///
+/// @return  True if initialization was successful, false if not.
+///
+/// @see Cleanup()
+bool JobManager::Initialize( uint32_t workerCount )
+{
+	Cleanup();
+
+	if( workerCount > WORKER_COUNT_MAX )
+	{
+		workerCount = WORKER_COUNT_MAX;
+	}
+
+	// Allocate and clear the job pool.
+	m_pJobPool = static_cast< Job* >( DefaultAllocator().AllocateAligned( 16, sizeof( Job ) * JOB_POOL_SIZE ) );
+	HELIUM_ASSERT( m_pJobPool );
+	MemoryZero( m_pJobPool, sizeof( Job ) * JOB_POOL_SIZE );
+	AtomicExchangeRelease( m_jobAllocationCounter, 0 );
+
+	// Allocate the external job queue along with one queue for each worker.
+	m_queueCount = workerCount + 1;
+	m_pQueues = new JobQueue [ m_queueCount ];
+	HELIUM_ASSERT( m_pQueues );
+
+	// Start up the worker threads.
+	AtomicExchangeRelease( m_stopCounter, 0 );
+
+	for( uint32_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		Worker* pWorker = new Worker( this, workerIndex + 1 );
+		HELIUM_ASSERT( pWorker );
+		m_workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		HELIUM_VERIFY( pThread->Start( "JobManager - job worker" ) );
+		m_workerThreads.Push( pThread );
+	}
+
+	HELIUM_TRACE( TraceLevels::Info, "JobManager: Started %" PRIu32 " job worker threads.\n", workerCount );
+
+	return true;
+}
+
+/// Stop all worker threads and release the job pool.
+///
+/// All outstanding jobs must have completed before this is called.
+///
+/// @see Initialize()
+void JobManager::Cleanup()
+{
+	AtomicExchangeRelease( m_stopCounter, 1 );
+
+	size_t workerCount = m_workerThreads.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_wakeUpCondition.Signal();
+	}
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		RunnableThread* pThread = m_workerThreads[ workerIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
+
+		delete m_workers[ workerIndex ];
+	}
+
+	m_workerThreads.Clear();
+	m_workers.Clear();
+
+	delete [] m_pQueues;
+	m_pQueues = NULL;
+	m_queueCount = 0;
+
+	if( m_pJobPool )
+	{
+		DefaultAllocator().FreeAligned( m_pJobPool );
+		m_pJobPool = NULL;
+	}
+}
+
+/// Create a job that runs a callback on a copy of the given data.
+///
+/// The job is not queued for execution until Run() is called.
+///
+/// @param[in] pCallback  Callback to execute.  This is passed a pointer to the copy of the job data.
+/// @param[in] pData      Job data to copy into the job slot (can be null if @c dataSize is zero).
+/// @param[in] dataSize   Size of the job data, in bytes.  This cannot exceed Job::DATA_SIZE.
+/// @param[in] parent     Optional parent job that will not complete until this job has completed.
+///
+/// @return  Handle to the created job.
+///
+/// @see Run(), Wait()
+JobHandle JobManager::CreateJob( JOB_CALLBACK pCallback, const void* pData, size_t dataSize, JobHandle parent )
+{
+	HELIUM_ASSERT( pCallback );
+	HELIUM_ASSERT( pData || dataSize == 0 );
+	HELIUM_ASSERT( dataSize <= Job::DATA_SIZE );
+
+	Job* pJob = AllocateJob( parent );
+	HELIUM_ASSERT( pJob );
+
+	if( dataSize != 0 )
+	{
+		MemoryCopy( pJob->data, pData, dataSize );
+	}
+
+	pJob->pCallback = pCallback;
+
+	JobHandle handle;
+	handle.m_pJob = pJob;
+	handle.m_generation = pJob->generation;
+
+	return handle;
+}
+
+/// Create an empty job used to group other jobs.
+///
+/// Jobs created with the group as their parent keep the group from completing until they have completed, so
+/// running and waiting on the group waits on all of its children.
+///
+/// @param[in] parent  Optional parent job that will not complete until this group has completed.
+///
+/// @return  Handle to the created group job.
+///
+/// @see JobGroup
+JobHandle JobManager::CreateGroup( JobHandle parent )
+{
+	Job* pJob = AllocateJob( parent );
+	HELIUM_ASSERT( pJob );
+
+	JobHandle handle;
+	handle.m_pJob = pJob;
+	handle.m_generation = pJob->generation;
+
+	return handle;
+}
+
+/// Add a job to run once another job has completed.
+///
+/// This must be called before the job is passed to Run(), and the continuation job must not be run explicitly.
+///
+/// @param[in] job           Job on which the continuation depends.
+/// @param[in] continuation  Job to queue once @c job has completed.
+///
+/// @return  True if the continuation was added, false if the job already has the maximum number of continuations.
+bool JobManager::AddContinuation( JobHandle job, JobHandle continuation )
+{
+	HELIUM_ASSERT( job.IsValid() );
+	HELIUM_ASSERT( continuation.IsValid() );
+	HELIUM_ASSERT( !IsComplete( job ) );
+
+	Job* pJob = job.m_pJob;
+
+	int32_t continuationIndex = AtomicIncrementAcquire( pJob->continuationCount ) - 1;
+	if( continuationIndex >= static_cast< int32_t >( Job::CONTINUATION_MAX ) )
+	{
+		AtomicDecrementRelease( pJob->continuationCount );
+
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"JobManager::AddContinuation(): Job already has the maximum of %" PRIu32 " continuations.\n",
+			Job::CONTINUATION_MAX );
+
+		return false;
+	}
+
+	pJob->pContinuations[ continuationIndex ] = continuation.m_pJob;
+
+	return true;
+}
+
+/// Queue a job for execution.
+///
+/// @param[in] job  Job to run.
+///
+/// @see Wait(), IsComplete()
+void JobManager::Run( JobHandle job )
+{
+	HELIUM_ASSERT( job.IsValid() );
+	HELIUM_ASSERT( job.m_pJob->generation == job.m_generation );
+
+	Job* pJob = job.m_pJob;
+
+	// Groups have no work of their own, so they can be marked as finished without going through a queue.
+	if( !pJob->pCallback )
+	{
+		Finish( pJob );
+
+		return;
+	}
+
+	Enqueue( pJob );
+}
+
+/// Block until a job and all of its children have completed.
+///
+/// Rather than sleeping, the calling thread executes other pending jobs while it waits.
+///
+/// @param[in] job  Job to wait on.
+///
+/// @see Run(), IsComplete()
+void JobManager::Wait( JobHandle job )
+{
+	uint32_t queueIndex = GetCurrentQueueIndex();
+
+	while( !IsComplete( job ) )
+	{
+		Job* pJob = GetNextJob( queueIndex );
+		if( pJob )
+		{
+			Execute( pJob );
+		}
+		else
+		{
+			Thread::Yield();
+		}
+	}
+}
+
+/// Check whether a job and all of its children have completed.
+///
+/// @param[in] job  Job to check.
+///
+/// @return  True if the job has completed (or the handle is null), false if it is still pending or in progress.
+///
+/// @see Run(), Wait()
+bool JobManager::IsComplete( JobHandle job ) const
+{
+	if( !job.IsValid() )
+	{
+		return true;
+	}
+
+	const Job* pJob = job.m_pJob;
+	if( pJob->generation != job.m_generation )
+	{
+		return true;
+	}
+
+	return ( pJob->unfinishedCount == 0 );
+}
+
+/// Execute a single pending job on the calling thread, if any jobs are queued.
+///
+/// This allows threads that are waiting on something other than a job handle to help with queued work.
+///
+/// @return  True if a job was executed, false if no jobs were queued.
+///
+/// @see Wait()
+bool JobManager::ExecutePendingJob()
+{
+	Job* pJob = GetNextJob( GetCurrentQueueIndex() );
+	if( !pJob )
+	{
+		return false;
+	}
+
+	Execute( pJob );
+
+	return true;
+}
+
+/// Get the singleton JobManager instance.
+///
+/// @return  Pointer to the JobManager instance, or null if the job manager has not been started.
+///
+/// @see Startup(), Shutdown()
+JobManager* JobManager::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton JobManager instance.
+///
+/// @param[in] workerCount  Number of worker threads to start, or zero to start one worker thread for each hardware
+///                         thread other than the calling thread.
+///
+/// @see GetInstance()
+void JobManager::Startup( uint32_t workerCount )
+{
+	if ( ++g_InitCount == 1 )
+	{
+		if( workerCount == 0 )
+		{
+			uint32_t hardwareThreadCount = static_cast< uint32_t >( std::thread::hardware_concurrency() );
+			workerCount = ( hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0 );
+		}
+
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new JobManager;
+		HELIUM_ASSERT( sm_pInstance );
+		if ( !HELIUM_VERIFY( sm_pInstance->Initialize( workerCount ) ) )
+		{
+			Shutdown();
+		}
+	}
+}
+
+/// Destroy the singleton JobManager instance.
+///
+/// @see GetInstance()
+void JobManager::Shutdown()
+{
+	if ( --g_InitCount == 0 )
+	{
+		HELIUM_ASSERT( sm_pInstance );
+		sm_pInstance->Cleanup();
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
+
+/// Allocate and initialize a job slot.
+///
+/// @param[in] parent  Optional parent job.
+///
+/// @return  Job slot.
+Job* JobManager::AllocateJob( JobHandle parent )
+{
+	HELIUM_ASSERT( m_pJobPool );
+
+	uint32_t allocationIndex = static_cast< uint32_t >( AtomicIncrementAcquire( m_jobAllocationCounter ) ) - 1;
+	Job* pJob = m_pJobPool + ( allocationIndex & ( JOB_POOL_SIZE - 1 ) );
+	HELIUM_ASSERT_MSG(
+		pJob->unfinishedCount == 0,
+		"Job pool exhausted. More than %" PRIu32 " jobs are in flight.",
+		JOB_POOL_SIZE );
+
+	Job* pParent = NULL;
+	if( parent.IsValid() )
+	{
+		HELIUM_ASSERT( !IsComplete( parent ) );
+		pParent = parent.m_pJob;
+		AtomicIncrementRelease( pParent->unfinishedCount );
+	}
+
+	pJob->pCallback = NULL;
+	pJob->pDestroyCallback = NULL;
+	pJob->pParent = pParent;
+	AtomicExchangeRelease( pJob->continuationCount, 0 );
+	AtomicIncrementRelease( pJob->generation );
+	AtomicExchangeRelease( pJob->unfinishedCount, 1 );
+
+	return pJob;
+}
+
+/// Get the index of the job queue owned by the calling thread.
+///
+/// @return  Job queue index (zero for threads that are not job workers).
+uint32_t JobManager::GetCurrentQueueIndex() const
+{
+	return static_cast< uint32_t >( reinterpret_cast< uintptr_t >( m_queueIndexTls.GetPointer() ) );
+}
+
+/// Get the next job to execute, stealing from other queues if the given queue is empty.
+///
+/// @param[in] queueIndex  Index of the queue owned by the calling thread.
+///
+/// @return  Job to execute, or null if no jobs are queued.
+Job* JobManager::GetNextJob( uint32_t queueIndex )
+{
+	HELIUM_ASSERT( queueIndex < m_queueCount );
+
+	Job* pJob = m_pQueues[ queueIndex ].Pop();
+	if( pJob )
+	{
+		return pJob;
+	}
+
+	for( uint32_t queueOffset = 1; queueOffset < m_queueCount; ++queueOffset )
+	{
+		pJob = m_pQueues[ ( queueIndex + queueOffset ) % m_queueCount ].Steal();
+		if( pJob )
+		{
+			return pJob;
+		}
+	}
+
+	return NULL;
+}
+
+/// Execute a job on the calling thread.
+///
+/// @param[in] pJob  Job to execute.
+void JobManager::Execute( Job* pJob )
+{
+	HELIUM_ASSERT( pJob );
+
+	if( pJob->pCallback )
+	{
+		pJob->pCallback( pJob->data );
+	}
+
+	if( pJob->pDestroyCallback )
+	{
+		pJob->pDestroyCallback( pJob->data );
+	}
+
+	Finish( pJob );
+}
+
+/// Mark one unit of work for a job as finished, queueing its continuations and notifying its parent once all of its
+/// work has finished.
+///
+/// @param[in] pJob  Job to update.
+void JobManager::Finish( Job* pJob )
+{
+	HELIUM_ASSERT( pJob );
+
+	int32_t unfinishedCount = AtomicDecrementRelease( pJob->unfinishedCount );
+	HELIUM_ASSERT( unfinishedCount >= 0 );
+	if( unfinishedCount != 0 )
+	{
+		return;
+	}
+
+	int32_t continuationCount = pJob->continuationCount;
+	for( int32_t continuationIndex = 0; continuationIndex < continuationCount; ++continuationIndex )
+	{
+		Job* pContinuation = pJob->pContinuations[ continuationIndex ];
+		HELIUM_ASSERT( pContinuation );
+		if( pContinuation->pCallback )
+		{
+			Enqueue( pContinuation );
+		}
+		else
+		{
+			Finish( pContinuation );
+		}
+	}
+
+	Job* pParent = pJob->pParent;
+	if( pParent )
+	{
+		Finish( pParent );
+	}
+}
+
+/// Push a job onto the queue owned by the calling thread and wake up an idle worker.
+///
+/// If the queue is full, the job is executed immediately on the calling thread.
+///
+/// @param[in] pJob  Job to queue.
+void JobManager::Enqueue( Job* pJob )
+{
+	HELIUM_ASSERT( pJob );
+	HELIUM_ASSERT( m_pQueues );
+
+	uint32_t queueIndex = GetCurrentQueueIndex();
+	if( !m_pQueues[ queueIndex ].Push( pJob ) )
+	{
+		Execute( pJob );
+
+		return;
+	}
+
+	if( m_idleWorkerCount != 0 )
+	{
+		m_wakeUpCondition.Signal();
+	}
+}
+
+/// Constructor.
+JobManager::JobQueue::JobQueue()
+	: m_ppJobs( new Job* [ QUEUE_CAPACITY ] )
+	, m_head( 0 )
+	, m_tail( 0 )
+{
+	HELIUM_ASSERT( m_ppJobs );
+}
+
+/// Destructor.
+JobManager::JobQueue::~JobQueue()
+{
+	delete [] m_ppJobs;
+}
+
+/// Push a job onto the back of this queue.
+///
+/// @param[in] pJob  Job to push.
+///
+/// @return  True if the job was queued, false if the queue is full.
+bool JobManager::JobQueue::Push( Job* pJob )
+{
+	HELIUM_ASSERT( pJob );
+
+	m_lock.Lock();
+
+	if( m_tail - m_head >= QUEUE_CAPACITY )
+	{
+		m_lock.Unlock();
+
+		return false;
+	}
+
+	m_ppJobs[ m_tail & ( QUEUE_CAPACITY - 1 ) ] = pJob;
+	++m_tail;
+
+	m_lock.Unlock();
+
+	return true;
+}
+
+/// Pop the most recently pushed job from the back of this queue.
+///
+/// This is used by the thread owning the queue, as the most recently pushed job is the most likely to still have its
+/// data in cache.
+///
+/// @return  Popped job, or null if the queue is empty.
+Job* JobManager::JobQueue::Pop()
+{
+	Job* pJob = NULL;
+
+	m_lock.Lock();
+
+	if( m_head != m_tail )
+	{
+		--m_tail;
+		pJob = m_ppJobs[ m_tail & ( QUEUE_CAPACITY - 1 ) ];
+	}
+
+	m_lock.Unlock();
+
+	return pJob;
+}
+
+/// Steal the oldest job from the front of this queue.
+///
+/// This is used by threads other than the one owning the queue.  The oldest jobs tend to be the largest subdivisions
+/// of work, which keeps the number of steals low.
+///
+/// @return  Stolen job, or null if the queue is empty.
+Job* JobManager::JobQueue::Steal()
+{
+	Job* pJob = NULL;
+
+	m_lock.Lock();
+
+	if( m_head != m_tail )
+	{
+		pJob = m_ppJobs[ m_head & ( QUEUE_CAPACITY - 1 ) ];
+		++m_head;
+	}
+
+	m_lock.Unlock();
+
+	return pJob;
+}
+
+/// Constructor.
+///
+/// @param[in] pManager    Owning job manager.
+/// @param[in] queueIndex  Index of the job queue owned by this worker.
+JobManager::Worker::Worker( JobManager* pManager, uint32_t queueIndex )
+	: m_pManager( pManager )
+	, m_queueIndex( queueIndex )
+{
+	HELIUM_ASSERT( pManager );
+	HELIUM_ASSERT( queueIndex != 0 );
+}
+
+/// Destructor.
+JobManager::Worker::~Worker()
+{
+}
+
+/// Execute jobs until the job manager is shut down.
+void JobManager::Worker::Run()
+{
+	JobManager* pManager = m_pManager;
+	HELIUM_ASSERT( pManager );
+
+	pManager->m_queueIndexTls.SetPointer( reinterpret_cast< void* >( static_cast< uintptr_t >( m_queueIndex ) ) );
+
+	while( pManager->m_stopCounter == 0 )
+	{
+		Job* pJob = pManager->GetNextJob( m_queueIndex );
+		if( pJob )
+		{
+			pManager->Execute( pJob );
+
+			continue;
+		}
+
+		// No work is available, so sleep until notified.  The wait is bounded in case a job is queued between the
+		// queue check and the idle count update.
+		AtomicIncrementAcquire( pManager->m_idleWorkerCount );
+		pManager->m_wakeUpCondition.Wait( WORKER_IDLE_TIMEOUT );
+		AtomicDecrementRelease( pManager->m_idleWorkerCount );
+	}
+}
+
+/// Constructor.
+///
+/// @param[in] parent  Optional parent job that will not complete until this group has completed.
+JobGroup::JobGroup( JobHandle parent )
+	: m_pManager( JobManager::GetInstance() )
+	, m_bWaited( false )
+{
+	if( m_pManager )
+	{
+		m_handle = m_pManager->CreateGroup( parent );
+	}
+}
+
+/// Destructor.
+///
+/// Waits for all jobs in the group to complete if Wait() was not already called.
+JobGroup::~JobGroup()
+{
+	Wait();
+}
+
+/// Block until all jobs spawned as part of this group have completed.
+///
+/// The calling thread executes pending jobs while it waits.  No jobs can be spawned through this group after this
+/// has been called.
+void JobGroup::Wait()
+{
+	if( m_bWaited )
+	{
+		return;
+	}
+
+	m_bWaited = true;
+
+	if( m_pManager )
+	{
+		m_pManager->Run( m_handle );
+		m_pManager->Wait( m_handle );
+	}
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/MemoryHeap.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/DynamicArray.h"
+
+#include "EngineJobs/EngineJobs.h"
+
+namespace Helium
+{
+	/// Job execution callback.
+	///
+	/// @param[in] pJob  Job data to run.
+	typedef void ( *JOB_CALLBACK )( void* pJob );
+
+	/// Job slot managed by the JobManager.
+	HELIUM_ALIGN_PRE( 16 ) struct Job
+	{
+		/// Size of the job data stored inline with each job.
+		static const size_t DATA_SIZE = 192;
+		/// Maximum number of continuations per job.
+		static const uint32_t CONTINUATION_MAX = 8;
+
+		/// Inline job data (aligned to 16 bytes for SIMD types contained in job parameters).
+		uint8_t data[ DATA_SIZE ];
+
+		/// Callback to execute (null for jobs that only group other jobs).
+		JOB_CALLBACK pCallback;
+		/// Callback used to destroy the inline job data after execution (null for plain data).
+		JOB_CALLBACK pDestroyCallback;
+		/// Parent job.
+		Job* pParent;
+		/// Continuation jobs to run once this job has completed.
+		Job* pContinuations[ CONTINUATION_MAX ];
+
+		/// Number of outstanding units of work (the job itself plus each incomplete child).
+		volatile int32_t unfinishedCount;
+		/// Number of continuation jobs.
+		volatile int32_t continuationCount;
+		/// Slot generation, incremented each time the slot is reused.
+		volatile int32_t generation;
+	} HELIUM_ALIGN_POST( 16 );
+
+	/// Reference to a job created through the JobManager.
+	///
+	/// Handles are lightweight and can be copied freely.  Each handle records the generation of the job slot it
+	/// references, so a handle that outlives its job (once the job pool wraps around) simply reports the job as
+	/// complete instead of referencing an unrelated job.
+	class HELIUM_ENGINE_JOBS_API JobHandle
+	{
+		friend class JobManager;
+
+	public:
+		/// @name Construction/Destruction
+		//@{
+		inline JobHandle();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline bool IsValid() const;
+		//@}
+
+	private:
+		/// Job slot.
+		Job* m_pJob;
+		/// Generation of the job slot at the time this handle was created.
+		int32_t m_generation;
+	};
+
+	/// Work-stealing job scheduler.
+	///
+	/// One worker thread is created for each available hardware thread (minus the thread calling Startup()).  Each
+	/// worker owns a job queue; jobs spawned from a worker are pushed to and popped from the back of its own queue,
+	/// while idle workers steal from the front of other queues.  Threads that are not job workers (such as the main
+	/// thread) share a single external queue.
+	///
+	/// Jobs can be parented to other jobs, in which case the parent is not considered complete until all of its
+	/// children have completed, and can have continuation jobs that are run automatically once they complete.
+	/// Wait() executes pending jobs on the calling thread while the awaited job is still in flight, so it is safe to
+	/// wait from within a running job.
+	class HELIUM_ENGINE_JOBS_API JobManager : NonCopyable
+	{
+	public:
+		/// Maximum number of worker threads.
+		static const uint32_t WORKER_COUNT_MAX = 64;
+		/// Number of job slots in the job pool (must be a power of two).
+		static const uint32_t JOB_POOL_SIZE = 8192;
+		/// Maximum number of jobs that can be queued in a single job queue (must be a power of two).
+		static const uint32_t QUEUE_CAPACITY = 4096;
+
+		/// @name Initialization
+		//@{
+		bool Initialize( uint32_t workerCount );
+		void Cleanup();
+		//@}
+
+		/// @name Job Creation
+		//@{
+		JobHandle CreateJob(
+			JOB_CALLBACK pCallback, const void* pData, size_t dataSize, JobHandle parent = JobHandle() );
+		template< typename T > JobHandle CreateJob(
+			const typename T::Parameters& rParameters, JobHandle parent = JobHandle() );
+		JobHandle CreateGroup( JobHandle parent = JobHandle() );
+
+		bool AddContinuation( JobHandle job, JobHandle continuation );
+		//@}
+
+		/// @name Job Execution
+		//@{
+		void Run( JobHandle job );
+		void Wait( JobHandle job );
+		bool IsComplete( JobHandle job ) const;
+		bool ExecutePendingJob();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline uint32_t GetWorkerCount() const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static JobManager* GetInstance();
+		static void Startup( uint32_t workerCount = 0 );
+		static void Shutdown();
+		//@}
+
+	private:
+		/// Lock-protected double-ended job queue.
+		class JobQueue : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			JobQueue();
+			~JobQueue();
+			//@}
+
+			/// @name Queue Operations
+			//@{
+			bool Push( Job* pJob );
+			Job* Pop();
+			Job* Steal();
+			//@}
+
+		private:
+			/// Ring buffer of queued jobs.
+			Job** m_ppJobs;
+			/// Index of the first queued job.
+			uint32_t m_head;
+			/// Index one past the last queued job.
+			uint32_t m_tail;
+			/// Queue access lock.
+			SpinLock m_lock;
+		};
+
+		/// Job worker thread runnable.
+		class Worker : public Runnable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			Worker( JobManager* pManager, uint32_t queueIndex );
+			virtual ~Worker();
+			//@}
+
+			/// @name Runnable Interface
+			//@{
+			virtual void Run();
+			//@}
+
+		private:
+			/// Owning job manager.
+			JobManager* m_pManager;
+			/// Index of the queue owned by this worker.
+			uint32_t m_queueIndex;
+		};
+
+		/// Job slot pool.
+		Job* m_pJobPool;
+		/// Running count of job slot allocations.
+		volatile int32_t m_jobAllocationCounter;
+
+		/// Job queues (index zero is shared by all threads that are not job workers).
+		JobQueue* m_pQueues;
+		/// Number of job queues.
+		uint32_t m_queueCount;
+
+		/// Worker runnables.
+		DynamicArray< Worker* > m_workers;
+		/// Worker threads.
+		DynamicArray< RunnableThread* > m_workerThreads;
+
+		/// Condition used to wake up idle workers when jobs are queued.
+		Condition m_wakeUpCondition;
+		/// Number of workers currently waiting for jobs.
+		volatile int32_t m_idleWorkerCount;
+		/// Non-zero if worker threads should stop when next possible.
+		volatile int32_t m_stopCounter;
+
+		/// Queue index of the current thread, offset by one (zero for threads that are not job workers).
+		ThreadLocalPointer m_queueIndexTls;
+
+		/// Singleton instance.
+		static JobManager* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		JobManager();
+		~JobManager();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		Job* AllocateJob( JobHandle parent );
+		uint32_t GetCurrentQueueIndex() const;
+		Job* GetNextJob( uint32_t queueIndex );
+		void Execute( Job* pJob );
+		void Finish( Job* pJob );
+		void Enqueue( Job* pJob );
+		//@}
+
+		/// @name Static Private Utility Functions
+		//@{
+		template< typename T > static void DestroyCallback( void* pJob );
+		//@}
+	};
+
+	/// Set of jobs spawned together and awaited as a unit.
+	///
+	/// If the JobManager has not been started, jobs spawned through a group are run immediately on the calling
+	/// thread, so code using job groups behaves identically (albeit serially) in tools and other applications that do
+	/// not run job workers.
+	class HELIUM_ENGINE_JOBS_API JobGroup : NonCopyable
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		explicit JobGroup( JobHandle parent = JobHandle() );
+		~JobGroup();
+		//@}
+
+		/// @name Job Execution
+		//@{
+		template< typename T > void Spawn( const typename T::Parameters& rParameters );
+		void Wait();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline JobHandle GetHandle() const;
+		//@}
+
+	private:
+		/// Job manager instance (null if jobs are run inline).
+		JobManager* m_pManager;
+		/// Group job handle.
+		JobHandle m_handle;
+		/// True if Wait() has been called.
+		bool m_bWaited;
+	};
+}
+
+#include "EngineJobs/JobManager.inl"
@@ -0,0 +1,103 @@
+namespace Helium
+{
+	/// Constructor.
+	JobHandle::JobHandle()
+		: m_pJob( NULL )
+		, m_generation( 0 )
+	{
+	}
+
+	/// Get whether this handle references a job.
+	///
+	/// @return  True if this handle was created for a job, false if it is a null handle.
+	bool JobHandle::IsValid() const
+	{
+		return ( m_pJob != NULL );
+	}
+
+	/// Get the number of worker threads running jobs.
+	///
+	/// @return  Worker thread count.
+	uint32_t JobManager::GetWorkerCount() const
+	{
+		return static_cast< uint32_t >( m_workers.GetSize() );
+	}
+
+	/// Create a job for the given job type.
+	///
+	/// The job object is constructed in place within the job slot and its parameters are copied from the given
+	/// parameter structure.  The job is not queued for execution until Run() is called.
+	///
+	/// @param[in] rParameters  Job parameters.
+	/// @param[in] parent       Optional parent job that will not complete until this job has completed.
+	///
+	/// @return  Handle to the created job.
+	///
+	/// @see Run(), Wait()
+	template< typename T >
+	JobHandle JobManager::CreateJob( const typename T::Parameters& rParameters, JobHandle parent )
+	{
+		HELIUM_COMPILE_ASSERT( sizeof( T ) <= Job::DATA_SIZE );
+
+		Job* pJob = AllocateJob( parent );
+		HELIUM_ASSERT( pJob );
+
+		T* pJobObject = new( pJob->data ) T;
+		pJobObject->SetParameters( rParameters );
+
+		pJob->pCallback = &T::RunCallback;
+		pJob->pDestroyCallback = &DestroyCallback< T >;
+
+		JobHandle handle;
+		handle.m_pJob = pJob;
+		handle.m_generation = pJob->generation;
+
+		return handle;
+	}
+
+	/// Destroy a job object constructed within a job slot.
+	///
+	/// @param[in] pJob  Job object to destroy.
+	template< typename T >
+	void JobManager::DestroyCallback( void* pJob )
+	{
+		HELIUM_ASSERT( pJob );
+		static_cast< T* >( pJob )->~T();
+	}
+
+	/// Spawn a job as part of this group.
+	///
+	/// The job starts running immediately on a worker thread (or inline on the calling thread if the JobManager is
+	/// not running).
+	///
+	/// @param[in] rParameters  Job parameters.
+	///
+	/// @see Wait()
+	template< typename T >
+	void JobGroup::Spawn( const typename T::Parameters& rParameters )
+	{
+		HELIUM_ASSERT( !m_bWaited );
+
+		if( m_pManager )
+		{
+			m_pManager->Run( m_pManager->CreateJob< T >( rParameters, m_handle ) );
+		}
+		else
+		{
+			T job;
+			job.SetParameters( rParameters );
+			job.Run();
+		}
+	}
+
+	/// Get the handle of the job representing this group.
+	///
+	/// This can be used as the parent of jobs spawned through other groups (so that a group does not complete until
+	/// a nested group has completed) or to attach continuations.  The handle is null if the JobManager is not running.
+	///
+	/// @return  Group job handle.
+	JobHandle JobGroup::GetHandle() const
+	{
+		return m_handle;
+	}
+}
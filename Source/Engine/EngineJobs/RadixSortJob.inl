@@ -0,0 +1,245 @@
+namespace Helium
+{
+    /// Radix sort digit counting job data.
+    struct _RadixSortCountBlock
+    {
+        /// Keys in this block.
+        const uint64_t* pKeys;
+        /// Number of keys in this block.
+        size_t count;
+        /// Shift applied to each key to extract the current digit.
+        uint32_t shift;
+        /// Count of each digit value in this block (RadixSortJob::DIGIT_VALUE_COUNT entries, cleared in advance).
+        size_t* pCounts;
+    };
+
+    /// Radix sort scatter job data.
+    template< typename T >
+    struct _RadixSortScatterBlock
+    {
+        /// Source keys in this block.
+        const uint64_t* pSourceKeys;
+        /// Source values in this block.
+        const T* pSourceValues;
+        /// Destination key array.
+        uint64_t* pDestinationKeys;
+        /// Destination value array.
+        T* pDestinationValues;
+        /// Number of elements in this block.
+        size_t count;
+        /// Shift applied to each key to extract the current digit.
+        uint32_t shift;
+        /// Destination index of the first element of this block with each digit value.
+        size_t* pOffsets;
+    };
+
+    /// Count the occurrences of each digit value within a block of keys.
+    ///
+    /// @param[in] pData  Block to process.
+    inline void _RadixSortCount( void* pData )
+    {
+        HELIUM_ASSERT( pData );
+        const _RadixSortCountBlock& rBlock = *static_cast< const _RadixSortCountBlock* >( pData );
+
+        size_t* pCounts = rBlock.pCounts;
+        const uint64_t* pKeys = rBlock.pKeys;
+        size_t count = rBlock.count;
+        uint32_t shift = rBlock.shift;
+        for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+        {
+            ++pCounts[ static_cast< uint8_t >( pKeys[ keyIndex ] >> shift ) ];
+        }
+    }
+
+    /// Move each element in a block to its sorted location for the current digit.
+    ///
+    /// @param[in] pData  Block to process.
+    template< typename T >
+    static void _RadixSortScatter( void* pData )
+    {
+        HELIUM_ASSERT( pData );
+        const _RadixSortScatterBlock< T >& rBlock = *static_cast< const _RadixSortScatterBlock< T >* >( pData );
+
+        const uint64_t* pSourceKeys = rBlock.pSourceKeys;
+        const T* pSourceValues = rBlock.pSourceValues;
+        uint64_t* pDestinationKeys = rBlock.pDestinationKeys;
+        T* pDestinationValues = rBlock.pDestinationValues;
+        size_t* pOffsets = rBlock.pOffsets;
+        size_t count = rBlock.count;
+        uint32_t shift = rBlock.shift;
+        for( size_t elementIndex = 0; elementIndex < count; ++elementIndex )
+        {
+            uint64_t key = pSourceKeys[ elementIndex ];
+            size_t destinationIndex = pOffsets[ static_cast< uint8_t >( key >> shift ) ]++;
+            pDestinationKeys[ destinationIndex ] = key;
+            pDestinationValues[ destinationIndex ] = pSourceValues[ elementIndex ];
+        }
+    }
+
+    /// Run a job for each block of a radix sort pass and wait for them to complete.
+    ///
+    /// The first block is processed on the calling thread.
+    ///
+    /// @param[in] pCallback   Callback to run for each block.
+    /// @param[in] pBlocks     Job data for each block.
+    /// @param[in] blockCount  Number of blocks.
+    template< typename Block >
+    static void _RadixSortRunBlocks( JOB_CALLBACK pCallback, Block* pBlocks, size_t blockCount )
+    {
+        HELIUM_ASSERT( pCallback );
+        HELIUM_ASSERT( pBlocks );
+
+        JobManager* pJobManager = JobManager::GetInstance();
+        if( !pJobManager || blockCount <= 1 )
+        {
+            for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+            {
+                pCallback( &pBlocks[ blockIndex ] );
+            }
+
+            return;
+        }
+
+        JobHandle group = pJobManager->CreateGroup();
+        for( size_t blockIndex = 1; blockIndex < blockCount; ++blockIndex )
+        {
+            pJobManager->Run( pJobManager->CreateJob( pCallback, &pBlocks[ blockIndex ], sizeof( Block ), group ) );
+        }
+
+        pJobManager->Run( group );
+        pCallback( &pBlocks[ 0 ] );
+        pJobManager->Wait( group );
+    }
+
+    /// Sort an array of keys and values.
+    ///
+    /// Each pass counts the digit values in every block in parallel, converts the counts into the destination of each
+    /// block's first element with each digit value, then scatters every block in parallel between the key and value
+    /// arrays and their scratch space.  If an odd number of passes is performed, the sorted elements are copied back
+    /// from the scratch space once sorting is complete.
+    template< typename T >
+    void RadixSortJob< T >::Run()
+    {
+        size_t count = m_parameters.count;
+        if( count <= 1 )
+        {
+            return;
+        }
+
+        uint64_t* pKeys = m_parameters.pKeys;
+        T* pValues = m_parameters.pValues;
+        uint64_t* pScratchKeys = m_parameters.pScratchKeys;
+        T* pScratchValues = m_parameters.pScratchValues;
+        HELIUM_ASSERT( pKeys );
+        HELIUM_ASSERT( pValues );
+        HELIUM_ASSERT( pScratchKeys );
+        HELIUM_ASSERT( pScratchValues );
+
+        // Find the bits that differ between keys.  Passes over digits with no differing bits would leave the order of
+        // all elements unchanged, so they can be skipped entirely.
+        uint64_t keyBitsSet = 0;
+        uint64_t keyBitsClear = 0;
+        for( size_t keyIndex = 0; keyIndex < count; ++keyIndex )
+        {
+            uint64_t key = pKeys[ keyIndex ];
+            keyBitsSet |= key;
+            keyBitsClear |= ~key;
+        }
+
+        uint64_t differingBits = keyBitsSet & keyBitsClear;
+        if( !differingBits )
+        {
+            return;
+        }
+
+        // Split the array into one block per worker (plus the calling thread), limited by the minimum number of
+        // elements each job should process.
+        size_t blockCount = 1;
+        JobManager* pJobManager = JobManager::GetInstance();
+        if( pJobManager )
+        {
+            size_t singleJobCount = Max< size_t >( m_parameters.singleJobCount, 1 );
+            blockCount = ( count + singleJobCount - 1 ) / singleJobCount;
+            blockCount = Min< size_t >( blockCount, static_cast< size_t >( pJobManager->GetWorkerCount() ) + 1 );
+            blockCount = Min< size_t >( blockCount, BLOCK_COUNT_MAX );
+            blockCount = Max< size_t >( blockCount, 1 );
+        }
+
+        size_t blockSize = ( count + blockCount - 1 ) / blockCount;
+        blockCount = ( count + blockSize - 1 ) / blockSize;
+
+        DynamicArray< size_t > blockCounts;
+        blockCounts.Resize( blockCount * DIGIT_VALUE_COUNT );
+
+        _RadixSortCountBlock countBlocks[ BLOCK_COUNT_MAX ];
+        _RadixSortScatterBlock< T > scatterBlocks[ BLOCK_COUNT_MAX ];
+
+        uint64_t* pSourceKeys = pKeys;
+        T* pSourceValues = pValues;
+        uint64_t* pDestinationKeys = pScratchKeys;
+        T* pDestinationValues = pScratchValues;
+
+        for( uint32_t shift = 0; shift < 64; shift += DIGIT_BITS )
+        {
+            if( !( ( differingBits >> shift ) & ( DIGIT_VALUE_COUNT - 1 ) ) )
+            {
+                continue;
+            }
+
+            for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+            {
+                size_t blockStart = blockIndex * blockSize;
+
+                _RadixSortCountBlock& rCountBlock = countBlocks[ blockIndex ];
+                rCountBlock.pKeys = pSourceKeys + blockStart;
+                rCountBlock.count = Min( blockSize, count - blockStart );
+                rCountBlock.shift = shift;
+                rCountBlock.pCounts = blockCounts.GetData() + blockIndex * DIGIT_VALUE_COUNT;
+            }
+
+            MemoryZero( blockCounts.GetData(), sizeof( size_t ) * blockCounts.GetSize() );
+            _RadixSortRunBlocks( &_RadixSortCount, countBlocks, blockCount );
+
+            // Elements are ordered by digit value first, then by block, so elements with the same digit keep their
+            // existing relative order.
+            size_t offset = 0;
+            for( size_t digitValue = 0; digitValue < DIGIT_VALUE_COUNT; ++digitValue )
+            {
+                for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+                {
+                    size_t& rBlockCount = blockCounts[ blockIndex * DIGIT_VALUE_COUNT + digitValue ];
+                    size_t digitCount = rBlockCount;
+                    rBlockCount = offset;
+                    offset += digitCount;
+                }
+            }
+
+            HELIUM_ASSERT( offset == count );
+
+            for( size_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+            {
+                size_t blockStart = blockIndex * blockSize;
+
+                _RadixSortScatterBlock< T >& rScatterBlock = scatterBlocks[ blockIndex ];
+                rScatterBlock.pSourceKeys = pSourceKeys + blockStart;
+                rScatterBlock.pSourceValues = pSourceValues + blockStart;
+                rScatterBlock.pDestinationKeys = pDestinationKeys;
+                rScatterBlock.pDestinationValues = pDestinationValues;
+                rScatterBlock.count = Min( blockSize, count - blockStart );
+                rScatterBlock.shift = shift;
+                rScatterBlock.pOffsets = blockCounts.GetData() + blockIndex * DIGIT_VALUE_COUNT;
+            }
+
+            _RadixSortRunBlocks( &_RadixSortScatter< T >, scatterBlocks, blockCount );
+
+            Swap( pSourceKeys, pDestinationKeys );
+            Swap( pSourceValues, pDestinationValues );
+        }
+
+        if( pSourceKeys != pKeys )
+        {
+            MemoryCopy( pKeys, pSourceKeys, sizeof( uint64_t ) * count );
+            MemoryCopy( pValues, pSourceValues, sizeof( T ) * count );
+        }
+    }
+}
@@ -66,11 +66,12 @@ namespace Helium
 
     /// Recursively sort an array of elements.
     ///
-    /// @param[in] pContext  Context in which this job is running.
+    /// Each partition step spawns a child job for the lower partition and continues sorting the upper partition on
+    /// the current thread, until partitions are small enough to be sorted within a single job.
     template< typename T, typename CompareFunction >
     void SortJob< T, CompareFunction >::Run()
     {
-		size_t count = m_parameters.count;
+        size_t count = m_parameters.count;
         if( count <= 1 )
         {
             return;
@@ -80,7 +81,38 @@ namespace Helium
         HELIUM_ASSERT( pBase );
 
         CompareFunction& rCompare = m_parameters.compare;
-        
-		_Quicksort( pBase, count, rCompare );
+
+        if( count <= 2 || count <= m_parameters.singleJobCount || !JobManager::GetInstance() )
+        {
+            _Quicksort( pBase, count, rCompare );
+
+            return;
+        }
+
+        size_t pivotIndex = _Partition( pBase, count, rCompare );
+
+        JobGroup jobGroup;
+
+        if( pivotIndex > 1 )
+        {
+            Parameters lowerParameters = m_parameters;
+            lowerParameters.count = pivotIndex;
+            jobGroup.Spawn< SortJob >( lowerParameters );
+        }
+
+        size_t startIndex = pivotIndex + 1;
+        HELIUM_ASSERT( startIndex <= count );
+        size_t partitionSize = count - startIndex;
+        if( partitionSize > 1 )
+        {
+            SortJob upperJob;
+            Parameters& rUpperParameters = upperJob.GetParameters();
+            rUpperParameters = m_parameters;
+            rUpperParameters.pBase = pBase + startIndex;
+            rUpperParameters.count = partitionSize;
+            upperJob.Run();
+        }
+
+        jobGroup.Wait();
     }
 }
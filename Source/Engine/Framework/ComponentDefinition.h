@@ -30,6 +30,15 @@ namespace Helium
 		// Gets the component that this definition generated previously
 		inline Helium::Component *GetCreatedComponent() const;
 
+		// Implemented by child classes to report the type of component they allocate, so that spawners can check pool
+		// capacity up front. Returns an invalid type id if unknown.
+		inline virtual Components::TypeId GetComponentTypeId() const;
+
+		// Spawn templates deploy one shared instance of each definition for every entity, so definitions must not be
+		// modified once FinalizeComponent() has run. Types that keep per-entity state in their definition override this
+		// to return true, and get a private clone for each entity instead.
+		inline virtual bool ClonePerEntity() const;
+
 		void Clear() const { m_Instance.Reset(NULL); }
 
 	private:
@@ -43,10 +52,18 @@ namespace Helium
 	>
 	class ComponentDefinitionHelper : public Helium::ComponentDefinition
 	{
+		Components::TypeId GetComponentTypeId() const
+		{
+			return Components::GetType<ComponentT>();
+		}
+
 		Helium::Component *CreateComponentInternal(struct Components::IHasComponents &rHasComponents) const
 		{
 			ComponentT *c = rHasComponents.VirtualGetComponentManager()->Allocate<ComponentT>(&rHasComponents, rHasComponents.VirtualGetComponents());
-			c->Initialize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
+			if (c)
+			{
+				c->Initialize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
+			}
 			return c;
 		}
 
@@ -62,18 +79,30 @@ namespace Helium
 	>
 	class ComponentDefinitionHelperWithFinalize : public Helium::ComponentDefinition
 	{
+		Components::TypeId GetComponentTypeId() const
+		{
+			return Components::GetType<ComponentT>();
+		}
+
 		Helium::Component *CreateComponentInternal(struct Components::IHasComponents &rHasComponents) const
 		{
 			ComponentT *c = rHasComponents.VirtualGetComponentManager()->Allocate<ComponentT>(&rHasComponents, rHasComponents.VirtualGetComponents());
-			c->Initialize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
+			if (c)
+			{
+				c->Initialize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
+			}
 			return c;
 		}
 
 		virtual void FinalizeComponent() const
 		{
+			// Null if the component's pool was full when it was created
 			Component *c = GetCreatedComponent();
-			ComponentT *pComponent = static_cast<ComponentT *>(c);
-			pComponent->Finalize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
+			if (c)
+			{
+				ComponentT *pComponent = static_cast<ComponentT *>(c);
+				pComponent->Finalize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
+			}
 		}
 	};
 
@@ -83,6 +112,11 @@ namespace Helium
 	>
 	class ComponentDefinitionHelperFinalizeOnly : public Helium::ComponentDefinition
 	{
+		Components::TypeId GetComponentTypeId() const
+		{
+			return Components::GetType<ComponentT>();
+		}
+
 		Helium::Component *CreateComponentInternal(struct Components::IHasComponents &rHasComponents) const
 		{
 			ComponentT *c = rHasComponents.VirtualGetComponentManager()->Allocate<ComponentT>(&rHasComponents, rHasComponents.VirtualGetComponents());
@@ -91,9 +125,13 @@ namespace Helium
 
 		virtual void FinalizeComponent() const
 		{
+			// Null if the component's pool was full when it was created
 			Component *c = GetCreatedComponent();
-			ComponentT *pComponent = static_cast<ComponentT *>(c);
-			pComponent->Finalize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
+			if (c)
+			{
+				ComponentT *pComponent = static_cast<ComponentT *>(c);
+				pComponent->Finalize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
+			}
 		}
 	};
 	
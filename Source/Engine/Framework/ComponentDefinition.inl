@@ -21,4 +21,14 @@ namespace Helium
     { 
         return m_Instance.Get(); 
     }
+
+    Components::TypeId ComponentDefinition::GetComponentTypeId() const
+    {
+        return Invalid< Components::TypeId >();
+    }
+
+    bool ComponentDefinition::ClonePerEntity() const
+    {
+        return false;
+    }
 }
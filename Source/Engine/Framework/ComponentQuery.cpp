@@ -1,103 +1,335 @@
-
 #include "Precompile.h"
 #include "Framework/ComponentQuery.h"
-#include <limits>
-#include <vector>
+#include "Framework/TaskScheduler.h"
+#include "EngineJobs/JobManager.h"
+#include <algorithm>
 
 using namespace Helium;
 
-struct FoundComponentList
+// Amount of component data each job of a parallel query should touch, chosen to stay within a worker's L1 cache
+static const size_t PARALLEL_QUERY_CHUNK_BYTES = 32 * 1024;
+// Fewest tuples worth the overhead of a job
+static const size_t PARALLEL_QUERY_CHUNK_TUPLES_MIN = 16;
+// Most jobs a single parallel query will spawn
+static const size_t PARALLEL_QUERY_CHUNK_COUNT_MAX = 1024;
+
+struct ParallelQueryJobData
 {
-	Component *m_Component;
-	size_t m_TypeIndex;
-	size_t m_Count;
-	Components::TypeId m_TypeId;
+	Component * const *m_pTuples;
+	size_t m_TypesCount;
+	size_t m_TupleCount;
+	ComponentTupleCallback m_Callback;
 };
 
-bool SortFoundComponentList(const FoundComponentList &lhs, const FoundComponentList &rhs)
+ComponentQueryCache::ComponentQueryCache(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount)
+	: m_Manager(rManager)
+	, m_spSnapshot(new ComponentTupleSnapshot)
 {
-	return lhs.m_Count < rhs.m_Count;
+	HELIUM_ASSERT(typesCount);
+
+	m_Types.Resize(typesCount);
+	m_CandidateComponents.Resize(typesCount);
+	m_CurrentTuple.Resize(typesCount);
+	for (size_t index = 0; index < typesCount; ++index)
+	{
+		m_Types[index] = types[index];
+	}
+
+	// Pick the type with the fewest instances to find the collections that might produce tuples
+	size_t rarest_type_index = 0;
+	size_t rarest_type_count = rManager.CountAllocatedComponentsThatImplement(types[0]);
+	for (size_t index = 1; index < typesCount; ++index)
+	{
+		size_t count = rManager.CountAllocatedComponentsThatImplement(types[index]);
+		if (count < rarest_type_count)
+		{
+			rarest_type_index = index;
+			rarest_type_count = count;
+		}
+	}
+
+	// Treat every component of that type as newly allocated so the first refresh builds the full tuple list
+	if (rarest_type_count)
+	{
+		const DynamicArray< Components::TypeId > &implementing_types = Components::GetTypeData( types[rarest_type_index] )->m_ImplementingTypes;
+		for ( ComponentIteratorBase iterator(rManager, implementing_types); iterator.GetBaseComponent(); iterator.Advance() )
+		{
+			OnComponentAllocated(iterator.GetBaseComponent());
+		}
+	}
 }
 
-void EmitTuples(DynamicArray<Component *> &tuple, std::vector<FoundComponentList> &found_components, size_t type_index, ComponentTupleCallback emit_tuple_callback)
+bool ComponentQueryCache::Matches(const Components::TypeId *types, size_t typesCount) const
 {
-	Component *c = found_components[ type_index ].m_Component;
-	HELIUM_ASSERT( c );
-	do
+	if (typesCount != m_Types.GetSize())
 	{
-		tuple[found_components[type_index].m_TypeIndex] = c;
-		
-		if (type_index < found_components.size() - 1)
+		return false;
+	}
+
+	for (size_t index = 0; index < typesCount; ++index)
+	{
+		if (m_Types[index] != types[index])
 		{
-			EmitTuples(tuple, found_components, ++type_index, emit_tuple_callback);
+			return false;
 		}
-		else
+	}
+
+	return true;
+}
+
+bool ComponentQueryCache::ImplementsQueriedType(Components::TypeId typeId) const
+{
+	const DynamicArray< Components::TypeId > &implemented_types = Components::GetTypeData( typeId )->m_ImplementedTypes;
+	for (DynamicArray< Components::TypeId >::ConstIterator iter = implemented_types.Begin(); iter != implemented_types.End(); ++iter)
+	{
+		for (size_t index = 0; index < m_Types.GetSize(); ++index)
 		{
-			emit_tuple_callback(tuple);
+			if (m_Types[index] == *iter)
+			{
+				return true;
+			}
 		}
-	} 
-	while ( ( c = c->GetNextComponent() ) );
+	}
+
+	return false;
 }
 
-void Helium::QueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback emit_tuple_callback)
+void ComponentQueryCache::OnComponentAllocated(Component *pComponent)
 {
-	// If no types to query, do nothing
-	if (!typesCount)
+	AddedComponent added;
+	added.m_Component = pComponent;
+	added.m_Generation = pComponent->GetInlineData().m_Generation;
+
+	m_PendingChangesLock.Lock();
+	m_AddedComponents.Push(added);
+	m_PendingChangesLock.Unlock();
+}
+
+void ComponentQueryCache::OnComponentFreed(Component *pComponent)
+{
+	m_PendingChangesLock.Lock();
+	m_FreedComponents.Push(pComponent);
+	m_PendingChangesLock.Unlock();
+}
+
+void ComponentQueryCache::Refresh()
+{
+	MutexScopeLock scopeLock( m_RefreshLock );
+
+	m_PendingChangesLock.Lock();
+	if (m_AddedComponents.IsEmpty() && m_FreedComponents.IsEmpty())
 	{
+		m_PendingChangesLock.Unlock();
 		return;
 	}
-	
-	// Prepare the structure that will help us emit all permutations of found components
-	std::vector<FoundComponentList> found_components;
-	found_components.resize(typesCount);
-	
-	// Find the component with the least instances
-	for (size_t index = 0; index < typesCount; ++index)
+
+	// Collections that gained a component are rebuilt from scratch. Components that were freed again since being
+	// allocated (or whose slot was reused) are skipped, as their collection may no longer exist.
+	m_AffectedCollections.Resize(0);
+	for (DynamicArray<AddedComponent>::Iterator iter = m_AddedComponents.Begin(); iter != m_AddedComponents.End(); ++iter)
 	{
-		found_components[index].m_TypeIndex = index;
-		found_components[index].m_TypeId = types[index];
-		found_components[index].m_Count = rManager.CountAllocatedComponentsThatImplement(types[index]);
-		
-		// Bail if any component type doesn't exist
-		if (!found_components[index].m_Count)
+		Components::Pool *pPool = Components::Pool::GetPool( iter->m_Component );
+		ComponentCollection *pCollection = pPool->GetComponentCollection( iter->m_Component );
+		if (pCollection && iter->m_Component->GetInlineData().m_Generation == iter->m_Generation)
 		{
-			return;
+			m_AffectedCollections.Push(pCollection);
 		}
 	}
+	m_AddedComponents.Resize(0);
+
+	Component **pFreedBegin = m_FreedComponents.GetData();
+	Component **pFreedEnd = pFreedBegin + m_FreedComponents.GetSize();
+	std::sort(pFreedBegin, pFreedEnd);
+
+	ComponentCollection **pAffectedBegin = m_AffectedCollections.GetData();
+	ComponentCollection **pAffectedEnd = pAffectedBegin + m_AffectedCollections.GetSize();
+	std::sort(pAffectedBegin, pAffectedEnd);
+	pAffectedEnd = std::unique(pAffectedBegin, pAffectedEnd);
+
+	// Copy the tuples that don't reference a freed component or belong to a collection that will be rebuilt into a
+	// new snapshot. The current one may still be iterated by other queries, so it is left as it is. Stale collection
+	// pointers are only compared, never dereferenced. Only Refresh() replaces m_spSnapshot, so reading it here under
+	// m_RefreshLock alone is safe.
+	ComponentTupleSnapshotPtr spPrevious = m_spSnapshot;
+	ComponentTupleSnapshotPtr spSnapshot( new ComponentTupleSnapshot );
 
-	// Sort the types by commonality
-	std::sort(found_components.begin(), found_components.end(), SortFoundComponentList);
-	
-	const DynamicArray< Components::TypeId > &implementing_types = Components::GetTypeData( found_components[0].m_TypeId )->m_ImplementingTypes;
-	
-	// For every component
-	for ( ComponentIteratorBase iterator(rManager, implementing_types); iterator.GetBaseComponent(); iterator.Advance() )
+	const size_t types_count = m_Types.GetSize();
+	const size_t tuple_count = spPrevious->GetTupleCount();
+	spSnapshot->m_Tuples.Reserve(spPrevious->m_Tuples.GetSize());
+	spSnapshot->m_TupleCollections.Reserve(tuple_count);
+	for (size_t tuple_index = 0; tuple_index < tuple_count; ++tuple_index)
 	{
-		Component *outer_component = iterator.GetBaseComponent();
+		Component * const *pTuple = spPrevious->GetTuples() + tuple_index * types_count;
 
-		found_components[0].m_Component = outer_component;
+		bool keep = !std::binary_search(pAffectedBegin, pAffectedEnd, spPrevious->m_TupleCollections[tuple_index]);
+		for (size_t type_index = 0; keep && type_index < types_count; ++type_index)
+		{
+			keep = !std::binary_search(pFreedBegin, pFreedEnd, pTuple[type_index]);
+		}
+
+		if (!keep)
+		{
+			continue;
+		}
 
-		ComponentCollection *collection = outer_component->GetComponentCollection();
-		HELIUM_ASSERT(collection);
-		
-		// Walk the other types we need components of
-		bool emit_tuples = true;
-		for (size_t type_index = 1; type_index < found_components.size(); ++type_index)
+		for (size_t type_index = 0; type_index < types_count; ++type_index)
 		{
-			found_components[type_index].m_Component = collection->GetFirst( found_components[type_index].m_TypeId );
-			if ( !found_components[type_index].m_Component )
+			spSnapshot->m_Tuples.Push(pTuple[type_index]);
+		}
+		spSnapshot->m_TupleCollections.Push(spPrevious->m_TupleCollections[tuple_index]);
+	}
+
+	m_AffectedCollections.Resize(pAffectedEnd - pAffectedBegin);
+	m_FreedComponents.Resize(0);
+
+	m_PendingChangesLock.Unlock();
+
+	for (DynamicArray<ComponentCollection *>::Iterator iter = m_AffectedCollections.Begin(); iter != m_AffectedCollections.End(); ++iter)
+	{
+		EmitTuples(*spSnapshot, *iter);
+	}
+
+	// The previous snapshot is released outside the lock, by whichever query holds the last reference to it
+	m_SnapshotLock.Lock();
+	m_spSnapshot = spSnapshot;
+	m_SnapshotLock.Unlock();
+}
+
+ComponentTupleSnapshotPtr ComponentQueryCache::GetSnapshot() const
+{
+	m_SnapshotLock.Lock();
+	ComponentTupleSnapshotPtr spSnapshot = m_spSnapshot;
+	m_SnapshotLock.Unlock();
+
+	return spSnapshot;
+}
+
+void ComponentQueryCache::EmitTuples(ComponentTupleSnapshot &rSnapshot, ComponentCollection *pCollection)
+{
+	for (size_t type_index = 0; type_index < m_Types.GetSize(); ++type_index)
+	{
+		DynamicArray<Component *> &candidates = m_CandidateComponents[type_index];
+		candidates.Resize(0);
+		pCollection->GetAllThatImplement(m_Types[type_index], candidates);
+
+		// Collection is missing one of the types, so it contributes no tuples
+		if (candidates.IsEmpty())
+		{
+			return;
+		}
+	}
+
+	EmitTuples(rSnapshot, pCollection, 0);
+}
+
+void ComponentQueryCache::EmitTuples(ComponentTupleSnapshot &rSnapshot, ComponentCollection *pCollection, size_t typeIndex)
+{
+	const DynamicArray<Component *> &candidates = m_CandidateComponents[typeIndex];
+	for (DynamicArray<Component *>::ConstIterator iter = candidates.Begin(); iter != candidates.End(); ++iter)
+	{
+		m_CurrentTuple[typeIndex] = *iter;
+
+		if (typeIndex < m_Types.GetSize() - 1)
+		{
+			EmitTuples(rSnapshot, pCollection, typeIndex + 1);
+		}
+		else
+		{
+			for (size_t index = 0; index < m_CurrentTuple.GetSize(); ++index)
 			{
-				emit_tuples = false;
-				break;
+				rSnapshot.m_Tuples.Push(m_CurrentTuple[index]);
 			}
+			rSnapshot.m_TupleCollections.Push(pCollection);
 		}
-		
-		if (emit_tuples)
+	}
+}
+
+void Helium::QueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback emit_tuple_callback)
+{
+	// If no types to query, do nothing
+	if (!typesCount)
+	{
+		return;
+	}
+
+	ComponentQueryCache &rCache = rManager.GetQueryCache(types, typesCount);
+	rCache.Refresh();
+
+	// Hold on to the snapshot so a concurrent refresh can't free the tuples out from under the callbacks
+	ComponentTupleSnapshotPtr spSnapshot = rCache.GetSnapshot();
+	const size_t tuple_count = spSnapshot->GetTupleCount();
+	Component * const *pTuple = spSnapshot->GetTuples();
+	for (size_t tuple_index = 0; tuple_index < tuple_count; ++tuple_index, pTuple += typesCount)
+	{
+		emit_tuple_callback(pTuple);
+	}
+}
+
+static void RunParallelQueryChunkCallback(void *pData)
+{
+	HELIUM_ASSERT(pData);
+	ParallelQueryJobData *pJobData = static_cast<ParallelQueryJobData *>(pData);
+
+	Component * const *pTuple = pJobData->m_pTuples;
+	for (size_t tuple_index = 0; tuple_index < pJobData->m_TupleCount; ++tuple_index, pTuple += pJobData->m_TypesCount)
+	{
+		pJobData->m_Callback(pTuple);
+	}
+}
+
+// Same as QueryComponentsInternal(), but when called from a task that declared TaskFlags::ParallelQueries the tuples
+// are split into chunks that run across the job workers. The calling thread helps process chunks and returns once
+// every tuple has been handled.
+void Helium::ParallelQueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback emit_tuple_callback)
+{
+	// If no types to query, do nothing
+	if (!typesCount)
+	{
+		return;
+	}
+
+	ComponentQueryCache &rCache = rManager.GetQueryCache(types, typesCount);
+	rCache.Refresh();
+
+	// The snapshot stays referenced until every chunk job has finished with it
+	ComponentTupleSnapshotPtr spSnapshot = rCache.GetSnapshot();
+	const size_t tuple_count = spSnapshot->GetTupleCount();
+	Component * const *pTuples = spSnapshot->GetTuples();
+
+	// Size chunks by the amount of component data a tuple touches
+	size_t tuple_bytes = sizeof(Component *) * typesCount;
+	for (size_t type_index = 0; type_index < typesCount; ++type_index)
+	{
+		tuple_bytes += Components::GetTypeData(types[type_index])->GetSize();
+	}
+
+	size_t chunk_tuple_count = Max(PARALLEL_QUERY_CHUNK_BYTES / tuple_bytes, PARALLEL_QUERY_CHUNK_TUPLES_MIN);
+	chunk_tuple_count = Max(chunk_tuple_count, (tuple_count + PARALLEL_QUERY_CHUNK_COUNT_MAX - 1) / PARALLEL_QUERY_CHUNK_COUNT_MAX);
+
+	const TaskDefinition *pTask = TaskScheduler::GetCurrentTask();
+	JobManager *pJobManager = JobManager::GetInstance();
+	if (!pJobManager || tuple_count <= chunk_tuple_count || !pTask || !(pTask->m_Contract.m_Flags & TaskFlags::ParallelQueries))
+	{
+		for (size_t tuple_index = 0; tuple_index < tuple_count; ++tuple_index, pTuples += typesCount)
 		{
-			DynamicArray<Component *> tuple;
-			tuple.Resize(typesCount);
-			tuple[found_components[0].m_TypeIndex] = outer_component;
-			EmitTuples(tuple, found_components, 1, emit_tuple_callback);
+			emit_tuple_callback(pTuples);
 		}
+
+		return;
 	}
+
+	JobHandle group = pJobManager->CreateGroup();
+	for (size_t first_tuple = 0; first_tuple < tuple_count; first_tuple += chunk_tuple_count)
+	{
+		ParallelQueryJobData jobData;
+		jobData.m_pTuples = pTuples + first_tuple * typesCount;
+		jobData.m_TypesCount = typesCount;
+		jobData.m_TupleCount = Min(chunk_tuple_count, tuple_count - first_tuple);
+		jobData.m_Callback = emit_tuple_callback;
+
+		pJobManager->Run(pJobManager->CreateJob(&RunParallelQueryChunkCallback, &jobData, sizeof(jobData), group));
+	}
+
+	pJobManager->Run(group);
+	pJobManager->Wait(group);
 }
@@ -1,30 +1,109 @@
-
 #pragma once
 
 #include "Framework/Framework.h"
 #include "Foundation/DynamicArray.h"
 #include "Framework/Components.h"
+#include "Platform/Locks.h"
+#include "Foundation/ReferenceCounting.h"
+#include "Foundation/SmartPtr.h"
 
 namespace Helium
 {
-	typedef void (*ComponentTupleCallback)(DynamicArray<Component *> &tuple);
-	
+	// Tuples are passed as an array of components in the order the types were given to the query
+	typedef void (*ComponentTupleCallback)(Component * const *tuple);
+
+	// Tuples produced by one refresh of a ComponentQueryCache. A snapshot is never modified once published, so a query
+	// can iterate it (or hand chunks of it to jobs) while another thread refreshes the cache and publishes a new one.
+	class HELIUM_FRAMEWORK_API ComponentTupleSnapshot : public AtomicRefCountBase< ComponentTupleSnapshot >
+	{
+	public:
+		inline size_t GetTupleCount() const { return m_TupleCollections.GetSize(); }
+		inline Component * const *GetTuples() const { return m_Tuples.GetData(); }
+
+		// Published tuples, replaced (never modified) by Refresh()
+		ComponentTupleSnapshotPtr m_spSnapshot;
+		mutable SpinLock m_SnapshotLock;
+	};
+	typedef Helium::SmartPtr< ComponentTupleSnapshot > ComponentTupleSnapshotPtr;
+
+	// Persistent result of a component query for a single ComponentManager. Every ComponentCollection that has at least
+	// one component implementing each of the queried types contributes a tuple for every permutation of those
+	// components. Tuples are stored densely (m_TypesCount components per tuple) and kept up to date incrementally: the
+	// owning ComponentManager reports components allocated and freed by its pools, and only the collections affected by
+	// those changes are re-examined the next time the query is refreshed.
+	//
+	// Queries iterate the snapshot returned by GetSnapshot() rather than the cache itself. Refresh() builds a new
+	// snapshot from the previous one instead of compacting it in place, so a refresh on another thread (or a nested
+	// query of the same types) never touches tuples that are being iterated.
+	//
+	// Components allocated or freed while the tuples are being iterated are not reflected until the next Refresh(), so
+	// query callbacks should use deferred destruction (Entity::DeferredDestroy(), Component::FreeComponentDeferred())
+	// rather than freeing components that may appear later in the tuple list.
+	class HELIUM_FRAMEWORK_API ComponentQueryCache
+	{
+	public:
+		ComponentQueryCache(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount);
+
+		bool Matches(const Components::TypeId *types, size_t typesCount) const;
+		bool ImplementsQueriedType(Components::TypeId typeId) const;
+
+		void OnComponentAllocated(Component *pComponent);
+		void OnComponentFreed(Component *pComponent);
+
+		void Refresh();
+
+		// Tuples as of the last refresh; callers keep the returned reference for as long as they use the tuples
+		ComponentTupleSnapshotPtr GetSnapshot() const;
+
+		inline size_t GetTypesCount() const { return m_Types.GetSize(); }
+
+	private:
+		struct AddedComponent
+		{
+			Component *m_Component;
+			Components::GenerationIndex m_Generation;
+		};
+
+		void EmitTuples(ComponentTupleSnapshot &rSnapshot, ComponentCollection *pCollection);
+		void EmitTuples(ComponentTupleSnapshot &rSnapshot, ComponentCollection *pCollection, size_t typeIndex);
+
+		ComponentManager &m_Manager;
+		DynamicArray<Components::TypeId> m_Types;
+
+		// Published tuples, replaced (never modified) by Refresh()
+		ComponentTupleSnapshotPtr m_spSnapshot;
+		mutable SpinLock m_SnapshotLock;
+
+		// Changes since the last refresh
+		DynamicArray<AddedComponent> m_AddedComponents;
+		DynamicArray<Component *> m_FreedComponents;
+		SpinLock m_PendingChangesLock;
+
+		// Scratch space reused between refreshes
+		DynamicArray<ComponentCollection *> m_AffectedCollections;
+		DynamicArray< DynamicArray<Component *> > m_CandidateComponents;
+		DynamicArray<Component *> m_CurrentTuple;
+
+		Mutex m_RefreshLock;
+	};
+
 	void HELIUM_FRAMEWORK_API QueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback callback);
-	
+	void HELIUM_FRAMEWORK_API ParallelQueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback callback);
+
 	template <class A, class B, void (*F)(A *, B *)>
-	void TupleHandler(DynamicArray<Component *> &components)
+	void TupleHandler(Component * const *components)
 	{
 		F(
-			static_cast<A *>(components[0]), 
+			static_cast<A *>(components[0]),
 			static_cast<B *>(components[1]));
 	}
-	
+
 	template <class A, class B, class C, void (*F)(A *, B *, C *)>
-	void TupleHandler(DynamicArray<Component *> &components)
+	void TupleHandler(Component * const *components)
 	{
 		F(
-			static_cast<A *>(components[0]), 
-			static_cast<B *>(components[1]), 
+			static_cast<A *>(components[0]),
+			static_cast<B *>(components[1]),
 			static_cast<C *>(components[2]));
 	}
 }
@@ -40,6 +40,8 @@ namespace Helium
 			const Helium::ComponentSet &components, 
 			const ParameterSet *parameters);
 
+		friend class SpawnTemplate;
+
 	private:
 
 		struct NameDefinitionPair : Reflect::Struct
@@ -1,6 +1,7 @@
 
 #include "Precompile.h"
 #include "Framework/Components.h"
+#include "Framework/ComponentQuery.h"
 #include "Framework/SystemDefinition.h"
 
 #include "Foundation/Numeric.h"
@@ -45,7 +46,22 @@ void Components::Startup( SystemDefinition *pSystemDefinition )
 					TypeData &rTypeData = **componentTypeIter;
 					if (rTypeData.m_Name == configIter->m_ComponentTypeName)
 					{
-						rTypeData.m_DefaultCount = configIter->m_PoolSize;
+						// The last index is reserved as the invalid index
+						uint32_t poolSize = configIter->m_PoolSize;
+						if (poolSize >= NumericLimits<ComponentIndex>::Maximum)
+						{
+							HELIUM_TRACE(
+								TraceLevels::Warning,
+								"Components::Initialize - SystemDefinition requests %" PRIu32 " instances of component type '%s', but at most %" PRIu32 " are supported. "
+								"Build with HELIUM_COMPONENT_INDEX_32 to allow larger pools.\n",
+								poolSize,
+								*configIter->m_ComponentTypeName,
+								static_cast<uint32_t>(NumericLimits<ComponentIndex>::Maximum - 1));
+
+							poolSize = NumericLimits<ComponentIndex>::Maximum - 1;
+						}
+
+						rTypeData.m_DefaultCount = static_cast<ComponentIndex>(poolSize);
 						found = true;
 						break;
 					}
@@ -90,7 +106,7 @@ TypeId Components::RegisterType(
 	const Reflect::MetaStruct *pStructure, 
 	TypeData &rTypeData, 
 	TypeData *pBaseType, 
-	uint16_t defaultCount )
+	ComponentIndex defaultCount )
 {
 	// Some validation of parameters/state
 	HELIUM_ASSERT( pStructure );
@@ -167,7 +183,7 @@ Pool* Pool::CreatePool( ComponentManager *pComponentManager, const TypeData &rTy
 	componentSize = PAD_VALUE(componentSize, HELIUM_SIMD_ALIGNMENT);
 
 	size_t poolSize = PAD_VALUE( sizeof( Components::Pool ), HELIUM_SIMD_ALIGNMENT );
-	size_t memoryRequried = poolSize + componentSize * count;
+	size_t memoryRequried = poolSize + static_cast<size_t>(componentSize) * count;
 	Pool *pool = (Pool *)g_ComponentAllocator.AllocateAligned( POOL_ALIGN_SIZE, memoryRequried );
 	new(pool) Pool();
 	
@@ -183,15 +199,15 @@ Pool* Pool::CreatePool( ComponentManager *pComponentManager, const TypeData &rTy
 		
 	pool->m_Roster.Resize( count );
 
-	for (uint16_t i = 0; i < count; ++i)
+	for (ComponentIndex i = 0; i < count; ++i)
 	{
 		Component *component = pool->GetComponent( i );
 		pool->m_Roster[i] = component;
 
 		uintptr_t offset = (static_cast<uintptr_t>(reinterpret_cast<uintptr_t>(component) & POOL_ALIGN_SIZE_MASK) - reinterpret_cast<uintptr_t>(pool)) / HELIUM_COMPONENT_POOL_ALIGN_SIZE;
-		HELIUM_ASSERT(offset <= NumericLimits<uint16_t>::Maximum);
+		HELIUM_ASSERT(offset <= NumericLimits<PoolOffset>::Maximum);
 		HELIUM_ASSERT(offset);
-		component->m_InlineData.m_OffsetToPoolStart = static_cast<uint16_t>(offset);
+		component->m_InlineData.m_OffsetToPoolStart = static_cast<PoolOffset>(offset);
 			
 		component->m_InlineData.m_Owner = NULL;
 		component->m_InlineData.m_Next = Invalid<ComponentIndex>();
@@ -245,7 +261,7 @@ void Pool::InsertIntoChain(Component *_insertee, ComponentIndex _insertee_index,
 		_insertee->m_InlineData.m_Previous = previous_index;
 
 		// Fix previous component's next pointer
-		if (previous_index != Invalid<uint16_t>())
+		if (previous_index != Invalid<ComponentIndex>())
 		{
 			GetComponent( previous_index )->m_InlineData.m_Next = _insertee_index;
 		}
@@ -273,7 +289,7 @@ void Pool::RemoveFromChain(Component *_component, ComponentIndex index)
 	{
 		GetComponent( previous_index )->m_InlineData.m_Next = _component->m_InlineData.m_Next;
 	}
-	else if ( _component->m_InlineData.m_Next != Invalid<uint16_t>() )
+	else if ( _component->m_InlineData.m_Next != Invalid<ComponentIndex>() )
 	{
 		//m_ParallelData[ index ].m_Collection->m_Components[m_TypeId] = GetComponent( _component->m_InlineData.m_Next );
 		m_ParallelData[ index ].m_Collection->m_Components[m_TypeId] = pNextComponent;
@@ -284,16 +300,16 @@ void Pool::RemoveFromChain(Component *_component, ComponentIndex index)
 	}
 
 	// If we have a next node, repoint its previous pointer to our previous pointer
-	if ( _component->m_InlineData.m_Next != Invalid<uint16_t>() )
+	if ( _component->m_InlineData.m_Next != Invalid<ComponentIndex>() )
 	{
 		//m_ParallelData[ _component->m_InlineData.m_Next ].m_Previous = m_ParallelData[ index ].m_Previous;
 		pNextComponent->m_InlineData.m_Previous = _component->m_InlineData.m_Previous;
 	}
 
 	// wipe our node
-	_component->m_InlineData.m_Next = Invalid<uint16_t>();
-	//m_ParallelData[ index ].m_Previous = Invalid<uint16_t>();
-	_component->m_InlineData.m_Previous = Invalid<uint16_t>();
+	_component->m_InlineData.m_Next = Invalid<ComponentIndex>();
+	//m_ParallelData[ index ].m_Previous = Invalid<ComponentIndex>();
+	_component->m_InlineData.m_Previous = Invalid<ComponentIndex>();
 }
 
 Component* Pool::Allocate( IHasComponents *owner, ComponentCollection &collection )
@@ -303,11 +319,14 @@ Component* Pool::Allocate( IHasComponents *owner, ComponentCollection &collectio
 	// Do we have a free component to allocate?
 	if (m_FirstUnallocatedIndex >= m_Roster.GetSize())
 	{
-		// Could not allocate the component because we ran out..
-		HELIUM_ASSERT_MSG( false, "Could not allocate component of type %s for host %x. No free instances are available. Maximum instances: %d", 
+		// Could not allocate the component because we ran out. Callers must handle the null result, since content can
+		// spawn more components than a pool was sized for.
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"Components::Pool::Allocate - Could not allocate component of type %s for host %p. No free instances are available. Maximum instances: %" PRIuSZ "\n",
 			g_ComponentTypes[ m_TypeId ]->m_Structure->m_Name,
 			owner,
-			m_Roster.GetSize());
+			static_cast< size_t >( m_Roster.GetSize() ) );
 		return NULL;
 	}
 
@@ -337,6 +356,8 @@ Component* Pool::Allocate( IHasComponents *owner, ComponentCollection &collectio
 	m_Type->Construct( component );
 	HELIUM_ASSERT( component->m_InlineData.m_OffsetToPoolStart);
 
+	m_ComponentManager->OnComponentAllocated( m_TypeId, component );
+
 	return component;
 }
 
@@ -347,6 +368,8 @@ void Pool::Free( Component *component )
 	// Component is already freed or component doesn't have a good handle for some reason
 	HELIUM_ASSERT( m_ParallelData[ index ].m_Collection );
 
+	m_ComponentManager->OnComponentFreed( m_TypeId, component );
+
 	m_Type->Destruct( component );
 	RemoveFromChain( component, index );
 	
@@ -418,6 +441,8 @@ Helium::ComponentManager::ComponentManager(World *pWorld)
 
 		m_Pools.New( Pool::CreatePool( this, type_data, type_data.m_DefaultCount ) );
 	}
+
+	m_QueryCachesByType.Resize( g_ComponentTypes.GetSize() );
 }
 
 Helium::ComponentManager::~ComponentManager()
@@ -443,6 +468,80 @@ Helium::ComponentManager::~ComponentManager()
 	}
 
 	m_Pools.Clear();
+
+	for (DynamicArray<ComponentQueryCache *>::Iterator iter = m_QueryCaches.Begin();
+		iter != m_QueryCaches.End(); ++iter)
+	{
+		delete *iter;
+	}
+
+	m_QueryCaches.Clear();
+	m_QueryCachesByType.Clear();
+}
+
+ComponentQueryCache& Helium::ComponentManager::GetQueryCache( const Components::TypeId *types, size_t typesCount )
+{
+	{
+		ScopeReadLock readLock( m_QueryCachesLock );
+
+		for (DynamicArray<ComponentQueryCache *>::Iterator iter = m_QueryCaches.Begin();
+			iter != m_QueryCaches.End(); ++iter)
+		{
+			if ( (*iter)->Matches( types, typesCount ) )
+			{
+				return **iter;
+			}
+		}
+	}
+
+	ScopeWriteLock writeLock( m_QueryCachesLock );
+
+	// Another thread may have created the cache while we were waiting for the write lock
+	for (DynamicArray<ComponentQueryCache *>::Iterator iter = m_QueryCaches.Begin();
+		iter != m_QueryCaches.End(); ++iter)
+	{
+		if ( (*iter)->Matches( types, typesCount ) )
+		{
+			return **iter;
+		}
+	}
+
+	// First time this query has been run against this manager, so build its cache and have it track every type that
+	// could affect its results
+	ComponentQueryCache *pCache = new ComponentQueryCache( *this, types, typesCount );
+	m_QueryCaches.Push( pCache );
+
+	for (TypeId typeId = 0; typeId < m_QueryCachesByType.GetSize(); ++typeId)
+	{
+		if ( pCache->ImplementsQueriedType( typeId ) )
+		{
+			m_QueryCachesByType[ typeId ].Push( pCache );
+		}
+	}
+
+	return *pCache;
+}
+
+void Helium::ComponentManager::OnComponentAllocated( Components::TypeId typeId, Component *pComponent )
+{
+	ScopeReadLock readLock( m_QueryCachesLock );
+
+	DynamicArray<ComponentQueryCache *> &caches = m_QueryCachesByType[ typeId ];
+	for (DynamicArray<ComponentQueryCache *>::Iterator iter = caches.Begin(); iter != caches.End(); ++iter)
+	{
+		(*iter)->OnComponentAllocated( pComponent );
+	}
+}
+
+void Helium::ComponentManager::OnComponentFreed( Components::TypeId typeId, Component *pComponent )
+{
+	ScopeReadLock readLock( m_QueryCachesLock );
+
+	DynamicArray<ComponentQueryCache *> &caches = m_QueryCachesByType[ typeId ];
+	for (DynamicArray<ComponentQueryCache *>::Iterator iter = caches.Begin(); iter != caches.End(); ++iter)
+	{
+		(*iter)->OnComponentFreed( pComponent );
+	}
 }
 
 void Helium::Components::Tick()
@@ -7,6 +7,7 @@
 #include "Reflect/Object.h"
 #include "Foundation/Map.h"
 #include "Foundation/SmartPtr.h"
+#include "Platform/Locks.h"
 #include "Framework/Framework.h"
 
 
@@ -55,6 +56,12 @@
 	Helium::Components::ComponentRegistrar<__Type, __Type::ComponentBase> __Type::s_ComponentRegistrar(#__Type, __Count); \
 	HELIUM_DEFINE_DERIVED_STRUCT( __Type )
 
+/// Non-zero to use 32-bit component indices. Pools are limited to 65,535 components of a type per world with 16-bit
+/// indices; 32-bit indices lift that limit at the cost of 8 more bytes of bookkeeping per component.
+#ifndef HELIUM_COMPONENT_INDEX_32
+#define HELIUM_COMPONENT_INDEX_32 0
+#endif
+
 #define HELIUM_COMPONENT_PTR_CHECK_FREQUENCY (256)
 #define HELIUM_COMPONENT_POOL_ALIGN_SIZE (32)
 #define HELIUM_COMPONENT_POOL_ALIGN_SIZE_MASK (~(POOL_ALIGN_SIZE-1))
@@ -63,6 +70,7 @@ namespace Helium
 {
 	class ComponentManager;
 	class ComponentCollection;
+	class ComponentQueryCache;
 	class Component;
 	class World;
 	class ComponentPtrBase;
@@ -87,7 +95,13 @@ namespace Helium
 	{
 		//! Component type id (not the same as the reflect class id).
 		typedef uint16_t TypeId;
+#if HELIUM_COMPONENT_INDEX_32
+		typedef uint32_t ComponentIndex;
+		typedef uint32_t PoolOffset;             //< Offset from a component back to its pool, in POOL_ALIGN_SIZE units
+#else
 		typedef uint16_t ComponentIndex;
+		typedef uint16_t PoolOffset;             //< Offset from a component back to its pool, in POOL_ALIGN_SIZE units
+#endif
 		typedef uint16_t ComponentSizeType;
 		typedef uint8_t GenerationIndex;
 
@@ -155,7 +169,7 @@ namespace Helium
 		struct HELIUM_FRAMEWORK_API DataInline
 		{
 			IHasComponents*  m_Owner;
-			uint16_t         m_OffsetToPoolStart;
+			PoolOffset       m_OffsetToPoolStart;
 			ComponentIndex   m_Next;
 			ComponentIndex   m_Previous;
 			GenerationIndex  m_Generation;
@@ -194,6 +208,7 @@ namespace Helium
 			inline ComponentIndex      GetPreviousIndex(ComponentIndex index) const;
 			inline GenerationIndex     GetGeneration(ComponentIndex index) const;
 			inline ComponentIndex      GetAllocatedCount() const;
+			inline ComponentIndex      GetCapacity() const;
 			inline Component * const * GetAllocatedComponents() const;
 			inline Component *         GetComponentByRosterIndex(ComponentIndex index) const;
 
@@ -229,7 +244,7 @@ namespace Helium
 			const Reflect::MetaStruct *_structure, 
 			TypeData&                 _type_data, 
 			TypeData*                 _base_type_data, 
-			uint16_t                  _count);
+			ComponentIndex            _count);
 		HELIUM_FRAMEWORK_API const TypeData*     GetTypeData( TypeId type );
 
 		HELIUM_FRAMEWORK_API ComponentManagerPtr   CreateManager( World *pWorld );
@@ -249,17 +264,29 @@ namespace Helium
 		inline Component*        Allocate(Components::TypeId type, Components::IHasComponents *pOwner, ComponentCollection &rCollection);
 		inline size_t            CountAllocatedComponents( Components::TypeId typeId ) const;
 		size_t                   CountAllocatedComponentsThatImplement( Components::TypeId typeId ) const;
+		inline size_t            CountAvailableComponents( Components::TypeId typeId ) const;
 
 		template < class T > T*        Allocate( Components::IHasComponents *pOwner, ComponentCollection &rCollection );
 		template < class T > size_t    CountAllocatedComponents();
 		template < class T > size_t    CountAllocatedComponentsThatImplement();
 
+		ComponentQueryCache&     GetQueryCache( const Components::TypeId *types, size_t typesCount );
+
 	private:
 		friend ComponentManagerPtr Helium::Components::CreateManager( World *pWorld );
+		friend Components::Pool;
 		ComponentManager(World *pWorld);
 
+		void                     OnComponentAllocated( Components::TypeId typeId, Component *pComponent );
+		void                     OnComponentFreed( Components::TypeId typeId, Component *pComponent );
+
 		World *m_World;
 		DynamicArray<Components::Pool *> m_Pools;
+
+		// Persistent query results, and the queries interested in each component type (indexed by type id)
+		DynamicArray<ComponentQueryCache *> m_QueryCaches;
+		DynamicArray< DynamicArray<ComponentQueryCache *> > m_QueryCachesByType;
+		ReadWriteLock m_QueryCachesLock;
 	};
 
 
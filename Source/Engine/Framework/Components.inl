@@ -41,7 +41,7 @@ namespace Helium
 		}
 
 		template< class ClassT, class BaseT >
-		ComponentRegistrar<ClassT, BaseT>::ComponentRegistrar( const char* name, uint16_t _count ) 
+		ComponentRegistrar<ClassT, BaseT>::ComponentRegistrar( const char* name, ComponentIndex _count ) 
 			: Reflect::MetaStructRegistrar<ClassT, BaseT>(name)
 			, m_Count(_count)
 		{
@@ -185,6 +185,11 @@ namespace Helium
 		{
 			return m_FirstUnallocatedIndex;
 		}
+
+		ComponentIndex Pool::GetCapacity() const
+		{
+			return static_cast< ComponentIndex >( m_Roster.GetSize() );
+		}
 		
 		Component * const * Pool::GetAllocatedComponents() const
 		{
@@ -337,15 +342,24 @@ namespace Helium
 		this->ResetToBeginning();
 	}
 	
+	// Returns null if the type's pool is full, or if no instances of the type were configured
 	Component* ComponentManager::Allocate( Components::TypeId type, Components::IHasComponents *pOwner, ComponentCollection &rCollection )
 	{
-		return m_Pools[ type ]->Allocate( pOwner, rCollection );
+		Components::Pool *pPool = m_Pools[ type ];
+		return pPool ? pPool->Allocate( pOwner, rCollection ) : NULL;
 	}
 
 	size_t ComponentManager::CountAllocatedComponents( Components::TypeId typeId ) const
 	{
 		return m_Pools[ typeId ]->GetAllocatedCount();
 	}
+
+	// Number of components of the given type that can still be allocated before the type's pool runs out
+	size_t ComponentManager::CountAvailableComponents( Components::TypeId typeId ) const
+	{
+		const Components::Pool *pPool = m_Pools[ typeId ];
+		return pPool ? pPool->GetCapacity() - pPool->GetAllocatedCount() : 0;
+	}
 	
 	World * ComponentManager::GetWorld() const
 	{
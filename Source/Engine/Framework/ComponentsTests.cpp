@@ -0,0 +1,152 @@
+#include "Framework/Components.h"
+
+#include "Foundation/Log.h"
+#include "Platform/Timer.h"
+#include "Reflect/Registry.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+namespace
+{
+	/// Pool size, and components allocated per benchmark round.  This fits in a pool with either index width, so a
+	/// 16-bit and a 32-bit build run the same workload and only differ in the size of the bookkeeping data.
+	const size_t COMPONENT_COUNT = 60000;
+	/// Components allocated per round by the correctness test.
+	const size_t TEST_COMPONENT_COUNT = 1024;
+	/// Components that share a collection, and therefore a chain of next/previous indices.
+	const size_t COMPONENTS_PER_COLLECTION = 16;
+	/// Number of allocate/iterate/free rounds run by the correctness test.
+	const size_t TEST_ROUND_COUNT = 2;
+	/// Number of allocate/iterate/free rounds timed by the benchmark.
+	const size_t BENCHMARK_ROUND_COUNT = 16;
+	/// Stride used to pick the order components are freed in, so most frees swap roster entries.
+	const size_t FREE_STRIDE = 7919;
+}
+
+class ComponentIndexBenchmarkComponent : public Component
+{
+	HELIUM_DECLARE_COMPONENT( ComponentIndexBenchmarkComponent, Helium::Component );
+	static void PopulateMetaType( Reflect::MetaStruct& comp ) { }
+
+	uint32_t m_Value;
+};
+
+HELIUM_DEFINE_COMPONENT( ComponentIndexBenchmarkComponent, COMPONENT_COUNT );
+
+namespace
+{
+	/// Starts up reflection and the component system for each test.
+	class ComponentIndexTest : public testing::Test
+	{
+	protected:
+		virtual void SetUp()
+		{
+			Reflect::Startup();
+			Components::Startup( NULL );
+
+			m_allocateTicks = 0;
+			m_iterateTicks = 0;
+			m_freeTicks = 0;
+		}
+
+		virtual void TearDown()
+		{
+			Components::Shutdown();
+			Reflect::Shutdown();
+		}
+
+		/// Allocate, iterate and free components, checking the pool contents after each step.
+		///
+		/// @param[in] componentCount  Number of components allocated per round.
+		/// @param[in] roundCount      Number of rounds to run.
+		void RunRounds( size_t componentCount, size_t roundCount )
+		{
+			// Nothing here needs a world, so the manager is created without one.
+			ComponentManagerPtr spManager;
+			spManager = Components::CreateManager( NULL );
+			ASSERT_TRUE( spManager.Ptr() != NULL );
+
+			DynamicArray< ComponentCollection > collections;
+			collections.Resize( ( componentCount + COMPONENTS_PER_COLLECTION - 1 ) / COMPONENTS_PER_COLLECTION );
+
+			DynamicArray< ComponentIndexBenchmarkComponent* > components;
+			components.Reserve( componentCount );
+
+			for( size_t roundIndex = 0; roundIndex < roundCount; ++roundIndex )
+			{
+				components.Resize( 0 );
+
+				uint64_t startTicks = Timer::GetTickCount();
+
+				for( size_t componentIndex = 0; componentIndex < componentCount; ++componentIndex )
+				{
+					ComponentIndexBenchmarkComponent* pComponent = spManager->Allocate< ComponentIndexBenchmarkComponent >(
+						NULL,
+						collections[ componentIndex / COMPONENTS_PER_COLLECTION ] );
+					ASSERT_TRUE( pComponent != NULL );
+					pComponent->m_Value = static_cast< uint32_t >( componentIndex );
+					components.Push( pComponent );
+				}
+
+				m_allocateTicks += Timer::GetTickCount() - startTicks;
+				ASSERT_EQ( componentCount, spManager->CountAllocatedComponents< ComponentIndexBenchmarkComponent >() );
+
+				startTicks = Timer::GetTickCount();
+
+				uint64_t valueSum = 0;
+				size_t visitCount = 0;
+				for( ComponentIteratorT< ComponentIndexBenchmarkComponent > iter( *spManager ); *iter; iter.Advance() )
+				{
+					valueSum += ( *iter )->m_Value;
+					++visitCount;
+				}
+
+				m_iterateTicks += Timer::GetTickCount() - startTicks;
+				EXPECT_EQ( componentCount, visitCount );
+				EXPECT_EQ( static_cast< uint64_t >( componentCount ) * ( componentCount - 1 ) / 2, valueSum );
+
+				startTicks = Timer::GetTickCount();
+
+				// The stride is a prime that divides neither count, so this frees every component exactly once.
+				for( size_t freeIndex = 0; freeIndex < componentCount; ++freeIndex )
+				{
+					components[ ( freeIndex * FREE_STRIDE ) % componentCount ]->FreeComponent();
+				}
+
+				m_freeTicks += Timer::GetTickCount() - startTicks;
+				ASSERT_EQ( 0u, spManager->CountAllocatedComponents< ComponentIndexBenchmarkComponent >() );
+			}
+		}
+
+		uint64_t m_allocateTicks;
+		uint64_t m_iterateTicks;
+		uint64_t m_freeTicks;
+	};
+}
+
+TEST_F( ComponentIndexTest, AllocatesIteratesAndFreesComponents )
+{
+	RunRounds( TEST_COMPONENT_COUNT, TEST_ROUND_COUNT );
+}
+
+// Timing run over a full pool, skipped by default.  Use --gtest_also_run_disabled_tests to run it.
+TEST_F( ComponentIndexTest, DISABLED_BenchmarkFullPool )
+{
+	RunRounds( COMPONENT_COUNT, BENCHMARK_ROUND_COUNT );
+
+	// Index width is a build option, so compare by running this test in a default build and in one generated with
+	// --component-index-32.
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		"Components, %" PRIuSZ "-bit index (%" PRIuSZ "-byte inline data), %" PRIuSZ " components x %" PRIuSZ " rounds: "
+		"allocate %.2f ms, iterate %.2f ms, free %.2f ms\n",
+		sizeof( Components::ComponentIndex ) * 8,
+		sizeof( Components::DataInline ),
+		COMPONENT_COUNT,
+		BENCHMARK_ROUND_COUNT,
+		static_cast< float64_t >( Timer::TicksToMilliseconds( m_allocateTicks ) ),
+		static_cast< float64_t >( Timer::TicksToMilliseconds( m_iterateTicks ) ),
+		static_cast< float64_t >( Timer::TicksToMilliseconds( m_freeTicks ) ) );
+}
@@ -61,6 +61,65 @@ void Entity::ClearSliceInfo()
 	SetInvalid( m_sliceIndex );
 }
 
+/// Queue this entity to be destroyed by its world at the end of the frame.
+///
+/// The entity is only marked for destruction once it has been queued, so calling this on an entity that is not bound
+/// to a world has no effect and can be repeated after the entity has been added to one.
+///
+/// @see IsDeferredDestroySet(), World::DeferDestroyEntity()
+void Entity::DeferredDestroy()
+{
+	if ( m_DeferredDestroy )
+	{
+		return;
+	}
+
+	World *pWorld = GetWorld();
+	if ( !pWorld )
+	{
+		return;
+	}
+
+	pWorld->DeferDestroyEntity( this );
+	m_DeferredDestroy = true;
+}
+
+/// Set a flag on this entity.  The entity must be bound to a slice.
+///
+/// @param[in] flag  Flag to set.
+///
+/// @see ClearFlag(), HasFlag()
+void Entity::SetFlag( EntityFlag flag )
+{
+	HELIUM_ASSERT( m_spSlice );
+	m_spSlice->GetEntityFlags().Set( m_sliceIndex, flag );
+}
+
+/// Clear a flag on this entity.
+///
+/// @param[in] flag  Flag to clear.
+///
+/// @see SetFlag(), HasFlag()
+void Entity::ClearFlag( EntityFlag flag )
+{
+	if ( m_spSlice )
+	{
+		m_spSlice->GetEntityFlags().Clear( m_sliceIndex, flag );
+	}
+}
+
+/// Check whether a flag is set on this entity.
+///
+/// @param[in] flag  Flag to test.
+///
+/// @return  True if the flag is set, false if not (or if the entity is not bound to a slice).
+///
+/// @see SetFlag(), ClearFlag()
+bool Entity::HasFlag( EntityFlag flag ) const
+{
+	return m_spSlice && m_spSlice->GetEntityFlags().Test( m_sliceIndex, flag );
+}
+
 ComponentCollection& Helium::Entity::VirtualGetComponents()
 {
 	return GetComponents();
@@ -56,8 +56,16 @@ namespace Helium
 		void ClearSliceInfo();
 		//@}
 
-		void DeferredDestroy() { m_DeferredDestroy = true; }
+		// Queue the entity to be destroyed by its world at the end of the frame
+		void DeferredDestroy();
 		bool IsDeferredDestroySet() { return m_DeferredDestroy; }
+
+		/// @name Entity Flags
+		//@{
+		void SetFlag( EntityFlag flag );
+		void ClearFlag( EntityFlag flag );
+		bool HasFlag( EntityFlag flag ) const;
+		//@}
 		
 	private:
 		// Avoid using these vfuncs if you can! Use GetComponents() and GetWorld
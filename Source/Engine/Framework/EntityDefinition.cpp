@@ -25,9 +25,36 @@ EntityDefinition::~EntityDefinition()
 {
 }
 
+/// @copydoc Asset::FinalizeLoad()
+void Helium::EntityDefinition::FinalizeLoad()
+{
+	Base::FinalizeLoad();
+
+	// The definitions may have been reloaded in place
+	InvalidateSpawnTemplate();
+}
+
+#if HELIUM_TOOLS
+/// @copydoc Asset::PostSave()
+void Helium::EntityDefinition::PostSave()
+{
+	Base::PostSave();
+
+	// Saving from the editor means the definitions may have been edited
+	InvalidateSpawnTemplate();
+}
+#endif
+
 void Helium::EntityDefinition::AddComponentDefinition( Helium::Name name, Helium::ComponentDefinition *pComponentDefinition )
 {
 	m_ComponentSet.AddComponentDefinition(name, pComponentDefinition);
+	InvalidateSpawnTemplate();
+}
+
+Helium::ComponentSet &Helium::EntityDefinition::GetComponentDefinitions()
+{
+	InvalidateSpawnTemplate();
+	return m_ComponentSet;
 }
 
 Helium::EntityPtr Helium::EntityDefinition::CreateEntity()
@@ -38,7 +65,28 @@ Helium::EntityPtr Helium::EntityDefinition::CreateEntity()
 void Helium::EntityDefinition::FinalizeEntity( Entity *pEntity, const ParameterSet *pParameterSet )
 {
 	HELIUM_ASSERT(pEntity);
-	
-	pEntity->DeployComponents(m_Components);
-	pEntity->DeployComponents(m_ComponentSet, pParameterSet);
+
+	SpawnTemplatePtr spSpawnTemplate = GetSpawnTemplate();
+	spSpawnTemplate->Deploy(*pEntity, pParameterSet);
+}
+
+Helium::SpawnTemplatePtr Helium::EntityDefinition::GetSpawnTemplate()
+{
+	MutexScopeLock lock( m_SpawnTemplateLock );
+	if (!m_spSpawnTemplate)
+	{
+		// Build before publishing, so other threads never see a partially built template
+		SpawnTemplatePtr spSpawnTemplate = new SpawnTemplate();
+		spSpawnTemplate->Build(m_Components, m_ComponentSet);
+		m_spSpawnTemplate = spSpawnTemplate;
+	}
+
+	return m_spSpawnTemplate;
+}
+
+void Helium::EntityDefinition::InvalidateSpawnTemplate()
+{
+	// Callers still holding the old template keep it alive until they are done with it
+	MutexScopeLock lock( m_SpawnTemplateLock );
+	m_spSpawnTemplate.Release();
 }
@@ -4,6 +4,7 @@
 #include "Framework/ComponentDefinition.h"
 #include "Framework/ComponentSet.h"
 #include "Framework/Entity.h"
+#include "Framework/SpawnTemplate.h"
 
 namespace Helium
 {
@@ -30,18 +31,33 @@ namespace Helium
 		virtual ~EntityDefinition();
 		//@}
 		
+		virtual void FinalizeLoad() override;
+#if HELIUM_TOOLS
+		virtual void PostSave() override;
+#endif
+
 		void AddComponentDefinition( Helium::Name name, Helium::ComponentDefinition *pComponentDefinition );
 
-		ComponentSet &GetComponentDefinitions() { return m_ComponentSet; }
+		// Non-const access invalidates the spawn template, since the caller may modify the definitions
+		ComponentSet &GetComponentDefinitions();
 
 		// Two phase construction to allow the entity to be set up before components get finalized
 		EntityPtr CreateEntity();
 		void FinalizeEntity(Entity *pEntity, const ParameterSet *pParameterSet = NULL);
 
+		// Precompiled component definitions used by FinalizeEntity(). Built on first use and rebuilt after the asset is
+		// (re)loaded; call InvalidateSpawnTemplate() after modifying the component definitions so that it gets rebuilt.
+		// The returned handle keeps the template alive even if it gets invalidated while in use.
+		SpawnTemplatePtr GetSpawnTemplate();
+		void InvalidateSpawnTemplate();
+
 	private:
 
 		ComponentSet m_ComponentSet;
 		DynamicArray<ComponentDefinitionPtr> m_Components;
+
+		SpawnTemplatePtr m_spSpawnTemplate;
+		Mutex m_SpawnTemplateLock;
 	};
 	typedef Helium::StrongPtr<EntityDefinition> EntityDefinitionPtr;
 }
@@ -0,0 +1,154 @@
+#include "Precompile.h"
+#include "Framework/EntityFlags.h"
+
+#include "Platform/Locks.h"
+
+using namespace Helium;
+
+static Name g_FlagNames[ EntityFlags::FLAG_COUNT_MAX ];
+static size_t g_FlagCount = 0;
+static Mutex g_FlagLock;
+
+EntityFlag Helium::EntityFlags::Register( Name name )
+{
+	HELIUM_ASSERT( !name.IsEmpty() );
+
+	MutexScopeLock lock( g_FlagLock );
+
+	for ( size_t i = 0; i < g_FlagCount; ++i )
+	{
+		if ( g_FlagNames[ i ] == name )
+		{
+			return static_cast< EntityFlag >( i );
+		}
+	}
+
+	if ( g_FlagCount >= FLAG_COUNT_MAX )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"EntityFlags::Register - Cannot register flag '%s'; the maximum of %" PRIuSZ " flags are already registered.\n",
+			*name,
+			FLAG_COUNT_MAX );
+		return Invalid< EntityFlag >();
+	}
+
+	g_FlagNames[ g_FlagCount ] = name;
+	return static_cast< EntityFlag >( g_FlagCount++ );
+}
+
+EntityFlag Helium::EntityFlags::Find( Name name )
+{
+	MutexScopeLock lock( g_FlagLock );
+
+	for ( size_t i = 0; i < g_FlagCount; ++i )
+	{
+		if ( g_FlagNames[ i ] == name )
+		{
+			return static_cast< EntityFlag >( i );
+		}
+	}
+
+	return Invalid< EntityFlag >();
+}
+
+Name Helium::EntityFlags::GetName( EntityFlag flag )
+{
+	MutexScopeLock lock( g_FlagLock );
+	return flag < g_FlagCount ? g_FlagNames[ flag ] : Name();
+}
+
+size_t Helium::EntityFlags::GetRegisteredCount()
+{
+	MutexScopeLock lock( g_FlagLock );
+	return g_FlagCount;
+}
+
+EntityFlagSet::EntityFlagSet()
+{
+	MemoryZero( m_Counts, sizeof( m_Counts ) );
+}
+
+void EntityFlagSet::Set( size_t index, EntityFlag flag )
+{
+	HELIUM_ASSERT( flag < EntityFlags::FLAG_COUNT_MAX );
+
+	DynamicArray< uint64_t > &rBits = m_Bits[ flag ];
+	size_t wordIndex = index / 64;
+	size_t wordCount = rBits.GetSize();
+	if ( wordIndex >= wordCount )
+	{
+		rBits.Resize( wordIndex + 1 );
+		MemoryZero( rBits.GetData() + wordCount, ( wordIndex + 1 - wordCount ) * sizeof( uint64_t ) );
+	}
+
+	uint64_t mask = static_cast< uint64_t >( 1 ) << ( index % 64 );
+	if ( !( rBits[ wordIndex ] & mask ) )
+	{
+		rBits[ wordIndex ] |= mask;
+		++m_Counts[ flag ];
+	}
+}
+
+void EntityFlagSet::Clear( size_t index, EntityFlag flag )
+{
+	HELIUM_ASSERT( flag < EntityFlags::FLAG_COUNT_MAX );
+
+	DynamicArray< uint64_t > &rBits = m_Bits[ flag ];
+	size_t wordIndex = index / 64;
+	if ( wordIndex >= rBits.GetSize() )
+	{
+		return;
+	}
+
+	uint64_t mask = static_cast< uint64_t >( 1 ) << ( index % 64 );
+	if ( rBits[ wordIndex ] & mask )
+	{
+		rBits[ wordIndex ] &= ~mask;
+		HELIUM_ASSERT( m_Counts[ flag ] );
+		--m_Counts[ flag ];
+	}
+}
+
+void EntityFlagSet::ClearAll( EntityFlag flag )
+{
+	HELIUM_ASSERT( flag < EntityFlags::FLAG_COUNT_MAX );
+
+	if ( m_Counts[ flag ] )
+	{
+		DynamicArray< uint64_t > &rBits = m_Bits[ flag ];
+		MemoryZero( rBits.GetData(), rBits.GetSize() * sizeof( uint64_t ) );
+		m_Counts[ flag ] = 0;
+	}
+}
+
+void EntityFlagSet::RemoveSwap( size_t index, size_t lastIndex )
+{
+	HELIUM_ASSERT( index <= lastIndex );
+
+	for ( size_t flag = 0; flag < EntityFlags::FLAG_COUNT_MAX; ++flag )
+	{
+		if ( !m_Counts[ flag ] )
+		{
+			continue;
+		}
+
+		EntityFlag entityFlag = static_cast< EntityFlag >( flag );
+		bool lastSet = Test( lastIndex, entityFlag );
+		Clear( index, entityFlag );
+		if ( lastSet && index != lastIndex )
+		{
+			Clear( lastIndex, entityFlag );
+			Set( index, entityFlag );
+		}
+	}
+}
+
+void EntityFlagSet::Reset()
+{
+	for ( size_t flag = 0; flag < EntityFlags::FLAG_COUNT_MAX; ++flag )
+	{
+		m_Bits[ flag ].Clear();
+		m_Counts[ flag ] = 0;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Framework/Framework.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/Name.h"
+
+namespace Helium
+{
+	// Identifier of a registered entity flag
+	typedef uint32_t EntityFlag;
+
+	// Entity flags are dataless tags: they mark an entity without allocating a component. Each slice keeps one bit
+	// array per registered flag, parallel to its entity array, so finding or clearing every flagged entity touches one
+	// bit per entity (skipping 64 unflagged entities at a time) instead of visiting every entity object.
+	//
+	// Flags should be registered during startup. Setting and clearing flags is not thread-safe; flag changes made from
+	// tasks that run in parallel must be deferred to the main thread.
+	namespace EntityFlags
+	{
+		static const size_t FLAG_COUNT_MAX = 64;
+
+		// Register a flag by name, returning its id (the existing id if the name was already registered)
+		HELIUM_FRAMEWORK_API EntityFlag Register( Name name );
+		// Find a registered flag by name, returning an invalid id if not registered
+		HELIUM_FRAMEWORK_API EntityFlag Find( Name name );
+		HELIUM_FRAMEWORK_API Name       GetName( EntityFlag flag );
+		HELIUM_FRAMEWORK_API size_t     GetRegisteredCount();
+	}
+
+	// Per-slice flag storage, indexed by the slice index of each entity
+	class HELIUM_FRAMEWORK_API EntityFlagSet
+	{
+	public:
+		EntityFlagSet();
+
+		void          Set( size_t index, EntityFlag flag );
+		void          Clear( size_t index, EntityFlag flag );
+		inline bool   Test( size_t index, EntityFlag flag ) const;
+		inline size_t GetCount( EntityFlag flag ) const;
+
+		// Clear a flag on every entity
+		void          ClearAll( EntityFlag flag );
+		// Append the element of an array parallel to the entity array for every entity with the flag set
+		template< class SourceT, class ElementT >
+		void          GetElements( EntityFlag flag, const DynamicArray< SourceT > &rSource, DynamicArray< ElementT > &rElements ) const;
+
+		// Mirror DynamicArray::RemoveSwap() on the entity array: the flags at lastIndex move to index
+		void          RemoveSwap( size_t index, size_t lastIndex );
+		void          Reset();
+
+	private:
+		// Index of the lowest set bit of a non-zero word
+		inline static size_t LowestSetBit( uint64_t word );
+
+		// Bit arrays for each flag, grown on demand (bits past the end of an array are clear)
+		DynamicArray< uint64_t > m_Bits[ EntityFlags::FLAG_COUNT_MAX ];
+		// Number of entities with each flag set
+		size_t m_Counts[ EntityFlags::FLAG_COUNT_MAX ];
+	};
+}
+
+#include "Framework/EntityFlags.inl"
@@ -0,0 +1,64 @@
+namespace Helium
+{
+	bool EntityFlagSet::Test( size_t index, EntityFlag flag ) const
+	{
+		HELIUM_ASSERT( flag < EntityFlags::FLAG_COUNT_MAX );
+
+		const DynamicArray< uint64_t > &rBits = m_Bits[ flag ];
+		size_t wordIndex = index / 64;
+		return wordIndex < rBits.GetSize() && ( rBits[ wordIndex ] & ( static_cast< uint64_t >( 1 ) << ( index % 64 ) ) ) != 0;
+	}
+
+	size_t EntityFlagSet::GetCount( EntityFlag flag ) const
+	{
+		HELIUM_ASSERT( flag < EntityFlags::FLAG_COUNT_MAX );
+		return m_Counts[ flag ];
+	}
+
+	template< class SourceT, class ElementT >
+	void EntityFlagSet::GetElements( EntityFlag flag, const DynamicArray< SourceT > &rSource, DynamicArray< ElementT > &rElements ) const
+	{
+		HELIUM_ASSERT( flag < EntityFlags::FLAG_COUNT_MAX );
+
+		size_t remaining = m_Counts[ flag ];
+		if ( !remaining )
+		{
+			return;
+		}
+
+		rElements.Reserve( rElements.GetSize() + remaining );
+
+		const DynamicArray< uint64_t > &rBits = m_Bits[ flag ];
+		size_t wordCount = rBits.GetSize();
+		for ( size_t wordIndex = 0; wordIndex < wordCount && remaining; ++wordIndex )
+		{
+			uint64_t word = rBits[ wordIndex ];
+			while ( word )
+			{
+				size_t index = wordIndex * 64 + LowestSetBit( word );
+				HELIUM_ASSERT( index < rSource.GetSize() );
+				rElements.Push( rSource[ index ] );
+				word &= word - 1;
+				--remaining;
+			}
+		}
+
+		HELIUM_ASSERT( !remaining );
+	}
+
+	size_t EntityFlagSet::LowestSetBit( uint64_t word )
+	{
+		HELIUM_ASSERT( word );
+
+		static const uint8_t debruijnPositions[ 64 ] =
+		{
+			 0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+			62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+			63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+			46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+		};
+
+		uint64_t lowestBit = word & ( ~word + 1 );
+		return debruijnPositions[ ( lowestBit * 0x03f79d71b4cb0a89ULL ) >> 58 ];
+	}
+}
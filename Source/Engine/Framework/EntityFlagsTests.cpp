@@ -0,0 +1,106 @@
+#include "Framework/EntityFlags.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+namespace
+{
+	/// Number of entities covered by each test, spanning several bit array words.
+	const size_t ENTITY_COUNT = 200;
+
+	/// Registers a pair of flags for each test.  Registered flags keep their names, so the name table is left running.
+	class EntityFlagSetTest : public testing::Test
+	{
+	protected:
+		virtual void SetUp()
+		{
+			m_FlagA = EntityFlags::Register( Name( "EntityFlagsTestA" ) );
+			m_FlagB = EntityFlags::Register( Name( "EntityFlagsTestB" ) );
+			ASSERT_TRUE( IsValid( m_FlagA ) );
+			ASSERT_TRUE( IsValid( m_FlagB ) );
+
+			m_Entities.Reserve( ENTITY_COUNT );
+			for ( size_t index = 0; index < ENTITY_COUNT; ++index )
+			{
+				m_Entities.Push( index );
+			}
+		}
+
+		virtual void TearDown()
+		{
+			m_Flags.Reset();
+		}
+
+		/// Get the entities with a flag set, in ascending order.
+		void GetFlagged( EntityFlag flag, DynamicArray< size_t > &rFlagged ) const
+		{
+			rFlagged.Resize( 0 );
+			m_Flags.GetElements( flag, m_Entities, rFlagged );
+		}
+
+		EntityFlag m_FlagA;
+		EntityFlag m_FlagB;
+		EntityFlagSet m_Flags;
+		DynamicArray< size_t > m_Entities;
+	};
+}
+
+TEST_F( EntityFlagSetTest, RegistersFlagsOnce )
+{
+	EXPECT_NE( m_FlagA, m_FlagB );
+	EXPECT_EQ( m_FlagA, EntityFlags::Register( Name( "EntityFlagsTestA" ) ) );
+	EXPECT_EQ( m_FlagB, EntityFlags::Find( Name( "EntityFlagsTestB" ) ) );
+	EXPECT_TRUE( IsInvalid( EntityFlags::Find( Name( "EntityFlagsTestMissing" ) ) ) );
+}
+
+TEST_F( EntityFlagSetTest, SetsClearsAndIterates )
+{
+	// Cover both ends of a word and indices past the end of the bit array
+	m_Flags.Set( 3, m_FlagA );
+	m_Flags.Set( 63, m_FlagA );
+	m_Flags.Set( 64, m_FlagA );
+	m_Flags.Set( 199, m_FlagA );
+	m_Flags.Set( 64, m_FlagA );
+	m_Flags.Set( 10, m_FlagB );
+
+	EXPECT_EQ( 4u, m_Flags.GetCount( m_FlagA ) );
+	EXPECT_EQ( 1u, m_Flags.GetCount( m_FlagB ) );
+	EXPECT_TRUE( m_Flags.Test( 63, m_FlagA ) );
+	EXPECT_FALSE( m_Flags.Test( 10, m_FlagA ) );
+	EXPECT_FALSE( m_Flags.Test( 1000, m_FlagA ) );
+
+	DynamicArray< size_t > flagged;
+	GetFlagged( m_FlagA, flagged );
+	ASSERT_EQ( 4u, flagged.GetSize() );
+	EXPECT_EQ( 3u, flagged[ 0 ] );
+	EXPECT_EQ( 63u, flagged[ 1 ] );
+	EXPECT_EQ( 64u, flagged[ 2 ] );
+	EXPECT_EQ( 199u, flagged[ 3 ] );
+
+	m_Flags.Clear( 63, m_FlagA );
+	m_Flags.Clear( 63, m_FlagA );
+	m_Flags.Clear( 1000, m_FlagA );
+	EXPECT_EQ( 3u, m_Flags.GetCount( m_FlagA ) );
+	EXPECT_FALSE( m_Flags.Test( 63, m_FlagA ) );
+
+	m_Flags.ClearAll( m_FlagA );
+	EXPECT_EQ( 0u, m_Flags.GetCount( m_FlagA ) );
+	GetFlagged( m_FlagA, flagged );
+	EXPECT_TRUE( flagged.IsEmpty() );
+	EXPECT_EQ( 1u, m_Flags.GetCount( m_FlagB ) );
+}
+
+TEST_F( EntityFlagSetTest, RemoveSwapMovesLastEntityFlags )
+{
+	m_Flags.Set( 5, m_FlagA );
+	m_Flags.Set( ENTITY_COUNT - 1, m_FlagB );
+
+	// Entity 5 is removed and the last entity takes its place
+	m_Flags.RemoveSwap( 5, ENTITY_COUNT - 1 );
+
+	EXPECT_EQ( 0u, m_Flags.GetCount( m_FlagA ) );
+	EXPECT_EQ( 1u, m_Flags.GetCount( m_FlagB ) );
+	EXPECT_TRUE( m_Flags.Test( 5, m_FlagB ) );
+	EXPECT_FALSE( m_Flags.Test( ENTITY_COUNT - 1, m_FlagB ) );
+}
@@ -1,7 +1,9 @@
 #include "Precompile.h"
 #include "Framework/GameSystem.h"
 
+#include "Engine/AsyncDeserializer.h"
 #include "Engine/AsyncLoader.h"
+#include "EngineJobs/JobManager.h"
 #include "Engine/FileLocations.h"
 #include "Foundation/FilePath.h"
 #include "Foundation/DirectoryIterator.h"
@@ -87,6 +89,8 @@ bool GameSystem::Initialize(
 #endif
 
 	AsyncLoader::Startup();
+	AsyncDeserializer::Startup();
+	JobManager::Startup();
 	CacheManager::Startup();
 	Reflect::Startup();
 
@@ -181,6 +185,8 @@ void GameSystem::Cleanup()
 	Reflect::Shutdown();
 	AssetType::Shutdown();
 	Asset::Shutdown();
+	JobManager::Shutdown();
+	AsyncDeserializer::Shutdown();
 	AsyncLoader::Shutdown();
 
 	Reflect::ObjectRefCountSupport::Shutdown();
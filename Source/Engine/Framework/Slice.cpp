@@ -73,6 +73,97 @@ Entity* Slice::CreateEntity(EntityDefinition *pEntityDefinition, ParameterSet *p
     return entity.Get();
 }
 
+/// Create a batch of entities from the same definition within this slice.
+///
+/// The entity definition's spawn template is built once for the whole batch, the entity list is grown once, and the
+/// world's component pools are checked up front so that the batch is trimmed to the number of entities whose
+/// components can all be allocated instead of failing partway through an entity.
+///
+/// @param[in]  pEntityDefinition  Definition from which to create each entity.
+/// @param[in]  count              Number of entities to create.
+/// @param[in]  ppParameterSets    Array of parameter sets to apply to each entity (individual entries can be null), or
+///                                null to create all entities without parameters.
+/// @param[out] ppEntities         If not null, array of at least count entries in which to store each created entity.
+///
+/// @return  Number of entities created.
+///
+/// @see CreateEntity(), DestroyEntity()
+size_t Slice::CreateEntities(
+    EntityDefinition *pEntityDefinition, size_t count, ParameterSet * const *ppParameterSets, Entity **ppEntities )
+{
+    HELIUM_ASSERT( pEntityDefinition );
+    if( !pEntityDefinition )
+    {
+        HELIUM_TRACE( TraceLevels::Error, "Slice::CreateEntities(): EntityDefinition is NULL.\n" );
+        return 0;
+    }
+
+    // Trim the batch to what the component pools can hold.
+    SpawnTemplatePtr spSpawnTemplate = pEntityDefinition->GetSpawnTemplate();
+    HELIUM_ASSERT( spSpawnTemplate );
+    const DynamicArray< Components::TypeId >& rComponentTypes = spSpawnTemplate->GetComponentTypes();
+
+    World* pWorld = GetWorld();
+    ComponentManager* pComponentManager = pWorld ? pWorld->GetComponentManager() : NULL;
+    if( pComponentManager )
+    {
+        size_t typeCount = rComponentTypes.GetSize();
+        for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+        {
+            Components::TypeId typeId = rComponentTypes[ typeIndex ];
+            if( IsInvalid( typeId ) )
+            {
+                continue;
+            }
+
+            size_t perEntityCount = 0;
+            for( size_t otherIndex = 0; otherIndex < typeCount; ++otherIndex )
+            {
+                perEntityCount += ( rComponentTypes[ otherIndex ] == typeId ? 1 : 0 );
+            }
+
+            size_t availableCount = pComponentManager->CountAvailableComponents( typeId ) / perEntityCount;
+            if( availableCount < count )
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Warning,
+                    "Slice::CreateEntities(): Component pools only have room for %" PRIuSZ " of %" PRIuSZ " entities.\n",
+                    availableCount,
+                    count );
+
+                count = availableCount;
+            }
+        }
+    }
+
+    m_entities.Reserve( m_entities.GetSize() + count );
+
+    for( size_t entityIndex = 0; entityIndex < count; ++entityIndex )
+    {
+        EntityPtr entity = pEntityDefinition->CreateEntity();
+        HELIUM_ASSERT( entity.Get() );
+        if( !entity )
+        {
+            HELIUM_TRACE( TraceLevels::Error, "Slice::CreateEntities(): Call to EntityDefinition::CreateEntity failed.\n" );
+            return entityIndex;
+        }
+
+        size_t sliceIndex = m_entities.Push( entity );
+        HELIUM_ASSERT( IsValid( sliceIndex ) );
+        entity->SetSliceInfo( this, sliceIndex );
+
+        // Deploy the template the capacity check used, even if the definition gets reloaded meanwhile.
+        spSpawnTemplate->Deploy( *entity, ppParameterSets ? ppParameterSets[ entityIndex ] : NULL );
+
+        if( ppEntities )
+        {
+            ppEntities[ entityIndex ] = entity.Get();
+        }
+    }
+
+    return count;
+}
+
 /// Destroy an entity in this slice.
 ///
 /// @param[in] pEntity  EntityDefinition to destroy.
@@ -101,6 +192,7 @@ bool Slice::DestroyEntity( Entity* pEntity )
     HELIUM_ASSERT( index < m_entities.GetSize() );
 
     pEntity->ClearSliceInfo();
+    m_entityFlags.RemoveSwap( index, m_entities.GetSize() - 1 );
     m_entities.RemoveSwap( index );
 
     // Update the index of the entity which has been moved to fill the entity list entry we just removed.
@@ -117,6 +209,18 @@ bool Slice::DestroyEntity( Entity* pEntity )
 }
 
 
+/// Get every entity in this slice with a given flag set.
+///
+/// @param[in]  flag       Flag to query.
+/// @param[out] rEntities  Array to which the flagged entities are appended.
+///
+/// @see GetEntityFlags()
+void Slice::GetFlaggedEntities( EntityFlag flag, DynamicArray< Entity* >& rEntities ) const
+{
+    m_entityFlags.GetElements( flag, m_entities, rEntities );
+}
+
+
 /// Set the world to which this slice is currently bound, along with the index of this slice within the world.
 ///
 /// @param[in] pWorld      World to set.
@@ -3,6 +3,7 @@
 #include "Framework/Framework.h"
 
 #include "Framework/ParameterSet.h"
+#include "Framework/EntityFlags.h"
 #include "Reflect/Object.h"
 
 namespace Helium
@@ -39,6 +40,9 @@ namespace Helium
         /// @name EntityDefinition Creation
         //@{
 		virtual Helium::Entity* CreateEntity(EntityDefinition *pEntityDefinition, ParameterSet *pParameterSet = NULL);
+        virtual size_t CreateEntities(
+            EntityDefinition *pEntityDefinition, size_t count, ParameterSet * const *ppParameterSets = NULL,
+            Entity **ppEntities = NULL );
         virtual bool DestroyEntity( Entity* pEntity );
         //@}
 
@@ -48,6 +52,13 @@ namespace Helium
         Entity* GetEntity( size_t index ) const;
         //@}
 
+        /// @name Entity Flags
+        //@{
+        inline EntityFlagSet& GetEntityFlags();
+        inline const EntityFlagSet& GetEntityFlags() const;
+        void GetFlaggedEntities( EntityFlag flag, DynamicArray< Entity* >& rEntities ) const;
+        //@}
+
         /// @name World Registration
         //@{
         World *GetWorld();
@@ -65,6 +76,8 @@ namespace Helium
 
         /// Entities.
         DynamicArray< EntityPtr > m_entities;
+        /// Entity flags, indexed in parallel with the entity list.
+        EntityFlagSet m_entityFlags;
 
         /// Slice world.
         WorldWPtr m_spWorld;
@@ -21,4 +21,28 @@ namespace Helium
         return m_entities.GetSize();
     }
 
+    /// Get the flags set on the entities in this slice.
+    ///
+    /// Flags are indexed by the slice index of each entity.
+    ///
+    /// @return  Entity flag storage.
+    ///
+    /// @see GetFlaggedEntities()
+    EntityFlagSet& Slice::GetEntityFlags()
+    {
+        return m_entityFlags;
+    }
+
+    /// Get the flags set on the entities in this slice.
+    ///
+    /// Flags are indexed by the slice index of each entity.
+    ///
+    /// @return  Entity flag storage.
+    ///
+    /// @see GetFlaggedEntities()
+    const EntityFlagSet& Slice::GetEntityFlags() const
+    {
+        return m_entityFlags;
+    }
+
 }
@@ -0,0 +1,286 @@
+#include "Precompile.h"
+#include "Framework/SpawnTemplate.h"
+
+#include "Foundation/Log.h"
+#include "Framework/ComponentSet.h"
+#include "Reflect/TranslatorDeduction.h"
+
+using namespace Helium;
+
+SpawnTemplate::SpawnTemplate()
+	: m_Built( false )
+{
+
+}
+
+SpawnTemplate::~SpawnTemplate()
+{
+}
+
+void SpawnTemplate::Build( const DynamicArray<ComponentDefinitionPtr> &definitions, const ComponentSet &componentSet )
+{
+	// Other threads may be deploying a published template, so it is never rebuilt in place
+	HELIUM_ASSERT( !m_Built );
+
+	//////////////////////////////////////////////////////////////////////////
+	// 1. Shared definitions are used as-is
+	//////////////////////////////////////////////////////////////////////////
+	for (DynamicArray<ComponentDefinitionPtr>::ConstIterator iter = definitions.Begin();
+		iter != definitions.End(); ++iter)
+	{
+		if (!*iter)
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"SpawnTemplate::Build - A ComponentDefinitionPtr in the supplied list was null - ignoring.\n" );
+			continue;
+		}
+
+		m_SharedDefinitions.Push( *iter );
+		m_ComponentTypes.Push( (*iter)->GetComponentTypeId() );
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// 2. Clone the component set's definitions once, to be shared by every deployment
+	//////////////////////////////////////////////////////////////////////////
+	// DeployComponents() creates and finalizes components in the order of its name map, not in component set order,
+	// so sort them the same way to keep the initialization order existing content relies on.
+	typedef Map<Name, size_t> M_ComponentIndices;
+	M_ComponentIndices componentIndices;
+
+	for (size_t i = 0; i < componentSet.m_Components.GetSize(); ++i)
+	{
+		const ComponentSet::NameDefinitionPair &component_to_clone = componentSet.m_Components[i];
+
+		M_ComponentIndices::Iterator iter = componentIndices.Find(component_to_clone.m_Name);
+		if (iter != componentIndices.End())
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"SpawnTemplate::Build - Multiple components named '%s'\n",
+				*component_to_clone.m_Name);
+			continue;
+		}
+
+		if ( !component_to_clone.m_Definition.ReferencesObject() )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"SpawnTemplate::Build - Cannot clone null component named '%s'\n",
+				*component_to_clone.m_Name);
+			continue;
+		}
+
+		componentIndices.Insert(iter, M_ComponentIndices::ValueType(component_to_clone.m_Name, i));
+	}
+
+	DynamicArray<Name> names;
+
+	for (M_ComponentIndices::Iterator iter = componentIndices.Begin(); iter != componentIndices.End(); ++iter)
+	{
+		const ComponentSet::NameDefinitionPair &component_to_clone = componentSet.m_Components[iter->Second()];
+
+		// The asset's own definitions are never modified, so binding components by name below works on clones
+		Reflect::ObjectPtr object_ptr = component_to_clone.m_Definition->Clone();
+		ComponentDefinition *pPrototype = Reflect::AssertCast<ComponentDefinition>(object_ptr.Get());
+
+		names.Push( component_to_clone.m_Name );
+		m_Prototypes.Push( pPrototype );
+		m_ClonePerEntity.Push( pPrototype->ClonePerEntity() );
+		m_ComponentTypes.Push( pPrototype->GetComponentTypeId() );
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// 3. Resolve each exposed parameter to a field, and wire parameters that name another component
+	//////////////////////////////////////////////////////////////////////////
+	for (size_t parameter_index = 0; parameter_index < componentSet.m_Parameters.GetSize(); ++parameter_index)
+	{
+		const ComponentSet::Parameter &parameter = componentSet.m_Parameters[parameter_index];
+
+		size_t target_index = Invalid<size_t>();
+		size_t source_index = Invalid<size_t>();
+		for (size_t nameIndex = 0; nameIndex < names.GetSize(); ++nameIndex)
+		{
+			if (names[nameIndex] == parameter.m_ComponentName)
+			{
+				target_index = nameIndex;
+			}
+
+			if (names[nameIndex] == parameter.m_ParameterName)
+			{
+				source_index = nameIndex;
+			}
+		}
+
+		if (IsInvalid(target_index))
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"SpawnTemplate::Build - Parameter '%s' refers to a component '%s' that cannot be found - ignored.\n",
+				*parameter.m_ParameterName,
+				*parameter.m_ComponentName);
+			continue;
+		}
+
+		ComponentDefinition *pTarget = m_Prototypes[target_index];
+		uint32_t fieldNameCrc = Crc32( parameter.m_ComponentFieldName.Get() );
+		const Reflect::Field *field = pTarget->GetMetaClass()->FindFieldByName(fieldNameCrc);
+
+		if (!field)
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"SpawnTemplate::Build - Parameter '%s' cannot find field named '%s' on component '%s' - ignored.\n",
+				*parameter.m_ParameterName,
+				*parameter.m_ComponentFieldName,
+				*parameter.m_ComponentName);
+			continue;
+		}
+
+		Binding binding;
+		binding.m_ParameterName = parameter.m_ParameterName;
+		binding.m_Field = field;
+		binding.m_TargetIndex = target_index;
+		binding.m_SourceIndex = source_index;
+		m_Bindings.Push( binding );
+
+		// Components bound by name are wired into the prototypes now; a deployment only redoes it for clones
+		if (IsValid(source_index))
+		{
+			field->m_Translator->Copy(
+				Reflect::Pointer( m_Prototypes[source_index] ),
+				Reflect::Pointer( field, pTarget ),
+				Reflect::CopyFlags::Shallow );
+		}
+	}
+
+	m_Built = true;
+}
+
+void SpawnTemplate::Deploy( Components::IHasComponents &rHasComponents, const ParameterSet *pParameterSet ) const
+{
+	HELIUM_ASSERT( m_Built );
+
+	// Find the value supplied for each binding; these take precedence over components bound by name
+	DynamicArray<Parameter> parameters;
+	DynamicArray<const Parameter *> supplied;
+	if (pParameterSet)
+	{
+		pParameterSet->EnumerateParameters(parameters);
+	}
+
+	if (!parameters.IsEmpty())
+	{
+		supplied.Reserve( m_Bindings.GetSize() );
+		for (size_t binding_index = 0; binding_index < m_Bindings.GetSize(); ++binding_index)
+		{
+			const Parameter *pSupplied = NULL;
+			for (size_t parameter_index = 0; parameter_index < parameters.GetSize(); ++parameter_index)
+			{
+				if (parameters[parameter_index].GetName() == m_Bindings[binding_index].m_ParameterName)
+				{
+					pSupplied = &parameters[parameter_index];
+					break;
+				}
+			}
+
+			supplied.Push( pSupplied );
+		}
+	}
+
+	// Decide which prototypes cannot be shared by this entity: types that opt in to per-entity clones, targets of a
+	// supplied value, and (transitively) definitions bound by name to one of those, since they must point at the clone
+	DynamicArray<bool> clone;
+	bool any_clone = false;
+	clone.Reserve( m_ClonePerEntity.GetSize() );
+	for (size_t i = 0; i < m_ClonePerEntity.GetSize(); ++i)
+	{
+		clone.Push( m_ClonePerEntity[i] );
+		any_clone |= m_ClonePerEntity[i];
+	}
+
+	for (size_t binding_index = 0; binding_index < supplied.GetSize(); ++binding_index)
+	{
+		if (supplied[binding_index])
+		{
+			clone[m_Bindings[binding_index].m_TargetIndex] = true;
+			any_clone = true;
+		}
+	}
+
+	for (bool changed = any_clone; changed; )
+	{
+		changed = false;
+		for (size_t binding_index = 0; binding_index < m_Bindings.GetSize(); ++binding_index)
+		{
+			const Binding &binding = m_Bindings[binding_index];
+			bool is_supplied = !supplied.IsEmpty() && supplied[binding_index];
+			if (!is_supplied && IsValid(binding.m_SourceIndex) && clone[binding.m_SourceIndex] && !clone[binding.m_TargetIndex])
+			{
+				clone[binding.m_TargetIndex] = true;
+				changed = true;
+			}
+		}
+	}
+
+	DynamicArray<ComponentDefinitionPtr> definitions;
+	if (any_clone)
+	{
+		definitions.Reserve( m_Prototypes.GetSize() );
+		for (size_t i = 0; i < m_Prototypes.GetSize(); ++i)
+		{
+			if (clone[i])
+			{
+				Reflect::ObjectPtr object_ptr = m_Prototypes[i]->Clone();
+				definitions.Push( Reflect::AssertCast<ComponentDefinition>(object_ptr.Get()) );
+			}
+			else
+			{
+				definitions.Push( m_Prototypes[i] );
+			}
+		}
+
+		for (size_t binding_index = 0; binding_index < m_Bindings.GetSize(); ++binding_index)
+		{
+			const Binding &binding = m_Bindings[binding_index];
+			Reflect::Pointer target( binding.m_Field, definitions[binding.m_TargetIndex].Get() );
+
+			if (!supplied.IsEmpty() && supplied[binding_index])
+			{
+				binding.m_Field->m_Translator->Copy(
+					supplied[binding_index]->GetPointer(),
+					target,
+					Reflect::CopyFlags::Shallow );
+			}
+			else if (IsValid(binding.m_SourceIndex) && clone[binding.m_SourceIndex])
+			{
+				binding.m_Field->m_Translator->Copy(
+					Reflect::Pointer( definitions[binding.m_SourceIndex] ),
+					target,
+					Reflect::CopyFlags::Shallow );
+			}
+		}
+	}
+
+	// Shared definitions are created and finalized before the component set, same as EntityDefinition always did.
+	// Definitions remember the component they created last, so only one deployment may use them at a time.
+	MutexScopeLock lock( m_DeployLock );
+	DeployDefinitions( rHasComponents, m_SharedDefinitions );
+	DeployDefinitions( rHasComponents, any_clone ? definitions : m_Prototypes );
+}
+
+void SpawnTemplate::DeployDefinitions(
+	Components::IHasComponents &rHasComponents,
+	const DynamicArray<ComponentDefinitionPtr> &definitions )
+{
+	for (size_t i = 0; i < definitions.GetSize(); ++i)
+	{
+		definitions[i]->CreateComponent(rHasComponents);
+	}
+
+	// Second pass to allow components to get references to each other if need be
+	for (size_t i = 0; i < definitions.GetSize(); ++i)
+	{
+		definitions[i]->FinalizeComponent();
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Framework/Framework.h"
+#include "Framework/ComponentDefinition.h"
+#include "Framework/ParameterSet.h"
+
+#include "Platform/Locks.h"
+#include "Foundation/ReferenceCounting.h"
+#include "Foundation/SmartPtr.h"
+
+namespace Helium
+{
+	class ComponentSet;
+
+	// Precompiled form of an entity's component definitions. Components::DeployComponents() clones the component set
+	// and resolves component names and parameter bindings through maps every time it runs. A spawn template clones the
+	// component set and wires components bound by name once when it is built, and deploys those prototypes directly,
+	// so every entity spawned from it shares the same definitions.
+	//
+	// Definitions are immutable once finalized (see ComponentDefinition::ClonePerEntity()). A deployment only clones
+	// the definitions that cannot be shared: those whose type opts in to per-entity clones, those that receive
+	// parameter values supplied for this entity, and those bound by name to a definition that was cloned. The template
+	// itself is never modified while deploying; definitions remember the component they created last, so deployments
+	// are serialized by a lock.
+	//
+	// Templates are reference counted and never change once built, so a spawner can keep deploying one while its
+	// EntityDefinition replaces it with a rebuilt template.
+	class HELIUM_FRAMEWORK_API SpawnTemplate : public AtomicRefCountBase< SpawnTemplate >, NonCopyable
+	{
+	public:
+		SpawnTemplate();
+		~SpawnTemplate();
+
+		// Compile the template from a list of shared definitions followed by a component set (only done once)
+		void Build( const DynamicArray<ComponentDefinitionPtr> &definitions, const ComponentSet &componentSet );
+		inline bool IsBuilt() const;
+
+		// Create and finalize components for one entity
+		void Deploy( Components::IHasComponents &rHasComponents, const ParameterSet *pParameterSet ) const;
+
+		// Type of each component created per deployment (invalid for definitions that don't report their type)
+		inline const DynamicArray<Components::TypeId> &GetComponentTypes() const;
+
+	private:
+		// An exposed component set parameter, resolved to a field on one of the component set's definitions
+		struct Binding
+		{
+			Name                       m_ParameterName;
+			const Reflect::Field      *m_Field;
+			size_t                     m_TargetIndex;   //< Index of the definition that owns the field
+			size_t                     m_SourceIndex;   //< Index of the definition bound by name, or invalid if none
+		};
+
+		static void DeployDefinitions(
+			Components::IHasComponents &rHasComponents,
+			const DynamicArray<ComponentDefinitionPtr> &definitions );
+
+		// Shared definitions, deployed as-is
+		DynamicArray<ComponentDefinitionPtr> m_SharedDefinitions;
+		// Clones of the component set definitions (with duplicate and null entries removed), with name bindings applied
+		DynamicArray<ComponentDefinitionPtr> m_Prototypes;
+		// Whether each prototype's type asked for a clone per deployment
+		DynamicArray<bool>                   m_ClonePerEntity;
+		DynamicArray<Binding>                m_Bindings;
+		DynamicArray<Components::TypeId>     m_ComponentTypes;
+
+		// Serializes deployment, since definitions remember the component they created last
+		mutable Mutex                        m_DeployLock;
+
+		bool m_Built;
+	};
+	typedef Helium::SmartPtr< SpawnTemplate > SpawnTemplatePtr;
+}
+
+#include "Framework/SpawnTemplate.inl"
@@ -0,0 +1,12 @@
+namespace Helium
+{
+	bool SpawnTemplate::IsBuilt() const
+	{
+		return m_Built;
+	}
+
+	const DynamicArray<Components::TypeId> &SpawnTemplate::GetComponentTypes() const
+	{
+		return m_ComponentTypes;
+	}
+}
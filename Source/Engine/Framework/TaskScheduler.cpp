@@ -2,14 +2,26 @@
 #include "Precompile.h"
 #include "TaskScheduler.h"
 #include "Foundation/Map.h"
+#include "Platform/Atomic.h"
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
+#include "EngineJobs/JobManager.h"
 
 using namespace Helium;
 
 
 TaskDefinition *TaskDefinition::s_FirstTaskDefinition = NULL;
 bool TaskScheduler::m_ContractsDefined = false;
+TaskExecutionMode TaskScheduler::m_ExecutionMode = TaskExecutionModes::Serial;
+
+typedef Helium::Map<const TaskDefinition *, uint32_t> M_TaskIndexMap;
+
+// Task being executed by the current thread
+static ThreadLocalPointer s_CurrentTaskTls;
 
 bool InsertToTaskList(A_TaskDefinitionPtr &rTaskInfoList, DynamicArray<TaskFunc> &rTaskFuncList, A_TaskDefinitionPtr &rTaskStack, const TaskDefinition *pTask, uint32_t tickType);
+void GatherScheduledPredecessors(const TaskDefinition *pTask, const M_TaskIndexMap &rTaskIndices, A_TaskDefinitionPtr &rVisited, DynamicArray<uint32_t> &rPredecessors);
+void BuildScheduleDependencies(TaskSchedule &rSchedule);
 
 bool TaskScheduler::CalculateSchedule(uint32_t tickType, TaskSchedule &schedule)
 {	
@@ -205,9 +217,114 @@ bool TaskScheduler::CalculateSchedule(uint32_t tickType, TaskSchedule &schedule)
 	}
 #endif
 
+	BuildScheduleDependencies(schedule);
+
 	return true;
 }
 
+// Find the tasks in the compact schedule that must complete before the given task can start. Tasks that aren't in the
+// schedule (abstract tasks and tasks for other tick types) are walked through so that the ordering they imply between
+// scheduled tasks is preserved.
+void GatherScheduledPredecessors(const TaskDefinition *pTask, const M_TaskIndexMap &rTaskIndices, A_TaskDefinitionPtr &rVisited, DynamicArray<uint32_t> &rPredecessors)
+{
+	for (A_TaskDefinitionPtr::ConstIterator prior_task_iter = pTask->m_RequiredTasks.Begin();
+		prior_task_iter != pTask->m_RequiredTasks.End(); ++prior_task_iter)
+	{
+		const TaskDefinition *pPriorTask = *prior_task_iter;
+
+		bool already_visited = false;
+		for (A_TaskDefinitionPtr::Iterator visited_iter = rVisited.Begin();
+			visited_iter != rVisited.End(); ++visited_iter)
+		{
+			if (*visited_iter == pPriorTask)
+			{
+				already_visited = true;
+				break;
+			}
+		}
+
+		if (already_visited)
+		{
+			continue;
+		}
+
+		rVisited.Push(pPriorTask);
+
+		M_TaskIndexMap::ConstIterator index_iter = rTaskIndices.Find(pPriorTask);
+		if (index_iter != rTaskIndices.End())
+		{
+			// Scheduled tasks already wait on their own predecessors, so there is no need to go any further
+			rPredecessors.Push(index_iter->Second());
+		}
+		else
+		{
+			GatherScheduledPredecessors(pPriorTask, rTaskIndices, rVisited, rPredecessors);
+		}
+	}
+}
+
+// Build the dependency graph of the compact schedule used by TaskScheduler::ExecuteScheduleParallel()
+void BuildScheduleDependencies(TaskSchedule &rSchedule)
+{
+	const uint32_t taskCount = static_cast<uint32_t>(rSchedule.m_ScheduleInfo.GetSize());
+
+	M_TaskIndexMap taskIndices;
+	for (uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		M_TaskIndexMap::Iterator map_entry;
+		taskIndices.Insert(map_entry, M_TaskIndexMap::ValueType(rSchedule.m_ScheduleInfo[taskIndex], taskIndex));
+	}
+
+	// Gather the predecessors of every task
+	DynamicArray<uint32_t> predecessors;
+	DynamicArray<uint32_t> predecessorsStart;
+	A_TaskDefinitionPtr visited;
+	for (uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		predecessorsStart.Push(static_cast<uint32_t>(predecessors.GetSize()));
+
+		visited.Resize(0);
+		visited.Push(rSchedule.m_ScheduleInfo[taskIndex]);
+		GatherScheduledPredecessors(rSchedule.m_ScheduleInfo[taskIndex], taskIndices, visited, predecessors);
+	}
+	predecessorsStart.Push(static_cast<uint32_t>(predecessors.GetSize()));
+
+	// Invert the predecessor lists into per-task dependent lists
+	rSchedule.m_ScheduleDependencyCounts.Resize(taskCount);
+	rSchedule.m_ScheduleDependentsStart.Resize(taskCount + 1);
+	rSchedule.m_ScheduleDependents.Resize(predecessors.GetSize());
+
+	DynamicArray<uint32_t> dependentCounts;
+	dependentCounts.Resize(taskCount);
+	for (uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		rSchedule.m_ScheduleDependencyCounts[taskIndex] = predecessorsStart[taskIndex + 1] - predecessorsStart[taskIndex];
+		dependentCounts[taskIndex] = 0;
+	}
+
+	for (size_t i = 0; i < predecessors.GetSize(); ++i)
+	{
+		++dependentCounts[predecessors[i]];
+	}
+
+	uint32_t dependentsStart = 0;
+	for (uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		rSchedule.m_ScheduleDependentsStart[taskIndex] = dependentsStart;
+		dependentsStart += dependentCounts[taskIndex];
+		dependentCounts[taskIndex] = rSchedule.m_ScheduleDependentsStart[taskIndex];
+	}
+	rSchedule.m_ScheduleDependentsStart[taskCount] = dependentsStart;
+
+	for (uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		for (uint32_t i = predecessorsStart[taskIndex]; i < predecessorsStart[taskIndex + 1]; ++i)
+		{
+			rSchedule.m_ScheduleDependents[dependentCounts[predecessors[i]]++] = taskIndex;
+		}
+	}
+}
+
 bool InsertToTaskList(A_TaskDefinitionPtr &rTaskInfoList, DynamicArray<TaskFunc> &rTaskFuncList, A_TaskDefinitionPtr &rTaskStack, const TaskDefinition *pTask, uint32_t tickType)
 {
 	// Don't add functions that do not run under the given tick type
@@ -280,12 +397,252 @@ bool InsertToTaskList(A_TaskDefinitionPtr &rTaskInfoList, DynamicArray<TaskFunc>
 
 void TaskScheduler::ExecuteSchedule( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds )
 {
-	int i = 0;
-	for (DynamicArray<TaskFunc>::ConstIterator iter = schedule.m_ScheduleFunc.Begin(); iter != schedule.m_ScheduleFunc.End(); ++iter)
+	// Parallel execution requires job workers, and a schedule with a dependency graph
+	if ( m_ExecutionMode == TaskExecutionModes::Parallel &&
+		JobManager::GetInstance() &&
+		schedule.m_ScheduleDependencyCounts.GetSize() == schedule.m_ScheduleFunc.GetSize() )
 	{
-		(*iter)( rWorlds );
-		HELIUM_ASSERT(schedule.m_ScheduleInfo[i++]->m_Func == *iter);
+		ExecuteScheduleParallel( schedule, rWorlds );
 	}
+	else
+	{
+		ExecuteScheduleSerial( schedule, rWorlds );
+	}
+}
+
+// Run a single task of the schedule, tracking it as the current task of this thread while it runs
+static void ExecuteTask( const TaskSchedule &schedule, uint32_t taskIndex, DynamicArray< WorldPtr > &rWorlds )
+{
+	const TaskDefinition *pTask = schedule.m_ScheduleInfo[ taskIndex ];
+	HELIUM_ASSERT( pTask->m_Func == schedule.m_ScheduleFunc[ taskIndex ] );
+
+	void *pPreviousTask = s_CurrentTaskTls.GetPointer();
+	s_CurrentTaskTls.SetPointer( const_cast< TaskDefinition * >( pTask ) );
+	schedule.m_ScheduleFunc[ taskIndex ]( rWorlds );
+	s_CurrentTaskTls.SetPointer( pPreviousTask );
+}
+
+void TaskScheduler::ExecuteScheduleSerial( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds )
+{
+	const uint32_t taskCount = static_cast< uint32_t >( schedule.m_ScheduleFunc.GetSize() );
+	for ( uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex )
+	{
+		ExecuteTask( schedule, taskIndex, rWorlds );
+	}
+}
+
+// State shared by all the tasks of a schedule being executed in parallel
+struct ParallelScheduleContext
+{
+	const TaskSchedule *m_pSchedule;
+	DynamicArray< WorldPtr > *m_pWorlds;
+	JobManager *m_pJobManager;
+
+	// Number of incomplete predecessors of each task
+	DynamicArray< int32_t > m_RemainingDependencyCounts;
+	// Tasks flagged with TaskFlags::MainThreadOnly that are ready to run
+	Locker< DynamicArray< uint32_t >, SpinLock > m_MainThreadReadyTasks;
+	// Number of tasks that have completed
+	volatile int32_t m_CompletedTaskCount;
+};
+
+// Job data for running a single task on a worker
+struct ParallelTaskJobData
+{
+	ParallelScheduleContext *m_pContext;
+	uint32_t m_TaskIndex;
+};
+
+static void DispatchParallelTask( ParallelScheduleContext &rContext, uint32_t taskIndex );
+
+static void RunParallelTask( ParallelScheduleContext &rContext, uint32_t taskIndex )
+{
+	const TaskSchedule &rSchedule = *rContext.m_pSchedule;
+	ExecuteTask( rSchedule, taskIndex, *rContext.m_pWorlds );
+
+	// Release any tasks that were only waiting on this one
+	for ( uint32_t i = rSchedule.m_ScheduleDependentsStart[ taskIndex ]; i < rSchedule.m_ScheduleDependentsStart[ taskIndex + 1 ]; ++i )
+	{
+		uint32_t dependentIndex = rSchedule.m_ScheduleDependents[ i ];
+		if ( AtomicDecrementRelease( rContext.m_RemainingDependencyCounts[ dependentIndex ] ) == 0 )
+		{
+			DispatchParallelTask( rContext, dependentIndex );
+		}
+	}
+
+	AtomicIncrementRelease( rContext.m_CompletedTaskCount );
+}
+
+static void RunParallelTaskCallback( void *pData )
+{
+	HELIUM_ASSERT( pData );
+	ParallelTaskJobData *pJobData = static_cast< ParallelTaskJobData * >( pData );
+	RunParallelTask( *pJobData->m_pContext, pJobData->m_TaskIndex );
+}
+
+static void DispatchParallelTask( ParallelScheduleContext &rContext, uint32_t taskIndex )
+{
+	const TaskDefinition *pTask = rContext.m_pSchedule->m_ScheduleInfo[ taskIndex ];
+	if ( pTask->m_Contract.m_Flags & TaskFlags::MainThreadOnly )
+	{
+		Locker< DynamicArray< uint32_t >, SpinLock >::Handle handle( rContext.m_MainThreadReadyTasks );
+		handle->Push( taskIndex );
+		return;
+	}
+
+	ParallelTaskJobData jobData;
+	jobData.m_pContext = &rContext;
+	jobData.m_TaskIndex = taskIndex;
+
+	JobManager *pJobManager = rContext.m_pJobManager;
+	pJobManager->Run( pJobManager->CreateJob( &RunParallelTaskCallback, &jobData, sizeof( jobData ) ) );
+}
+
+void TaskScheduler::ExecuteScheduleParallel( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds )
+{
+	const uint32_t taskCount = static_cast< uint32_t >( schedule.m_ScheduleFunc.GetSize() );
+
+	ParallelScheduleContext context;
+	context.m_pSchedule = &schedule;
+	context.m_pWorlds = &rWorlds;
+	context.m_pJobManager = JobManager::GetInstance();
+	HELIUM_ASSERT( context.m_pJobManager );
+	context.m_CompletedTaskCount = 0;
+
+	context.m_RemainingDependencyCounts.Resize( taskCount );
+	for ( uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex )
+	{
+		context.m_RemainingDependencyCounts[ taskIndex ] = static_cast< int32_t >( schedule.m_ScheduleDependencyCounts[ taskIndex ] );
+	}
+
+	// Kick off every task that has nothing to wait on
+	for ( uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex )
+	{
+		if ( schedule.m_ScheduleDependencyCounts[ taskIndex ] == 0 )
+		{
+			DispatchParallelTask( context, taskIndex );
+		}
+	}
+
+	// Run main thread tasks as they become ready, and help out with worker tasks in the meantime
+	while ( context.m_CompletedTaskCount < static_cast< int32_t >( taskCount ) )
+	{
+		uint32_t taskIndex = Invalid< uint32_t >();
+		{
+			Locker< DynamicArray< uint32_t >, SpinLock >::Handle handle( context.m_MainThreadReadyTasks );
+			if ( !handle->IsEmpty() )
+			{
+				taskIndex = handle->Pop();
+			}
+		}
+
+		if ( IsValid( taskIndex ) )
+		{
+			RunParallelTask( context, taskIndex );
+		}
+		else if ( !context.m_pJobManager->ExecutePendingJob() )
+		{
+			Thread::Yield();
+		}
+	}
+}
+
+// Job data for running part of the schedule on a single world
+struct PerWorldTaskJobData
+{
+	const TaskSchedule *m_pSchedule;
+	DynamicArray< WorldPtr > *m_pWorld;
+	uint32_t m_StartTaskIndex;
+	uint32_t m_EndTaskIndex;
+};
+
+static void RunPerWorldTasksCallback( void *pData )
+{
+	HELIUM_ASSERT( pData );
+	PerWorldTaskJobData *pJobData = static_cast< PerWorldTaskJobData * >( pData );
+
+	for ( uint32_t taskIndex = pJobData->m_StartTaskIndex; taskIndex < pJobData->m_EndTaskIndex; ++taskIndex )
+	{
+		ExecuteTask( *pJobData->m_pSchedule, taskIndex, *pJobData->m_pWorld );
+	}
+}
+
+// Run the schedule for each world independently, with each world's tasks executed in order on a job worker. Worlds
+// don't share components, so the cost of a frame is bounded by the slowest world rather than the sum of all of them.
+// Tasks flagged with TaskFlags::MainThreadOnly act as a barrier: all worlds catch up to the task, which is then run
+// for every world on the calling thread.
+void TaskScheduler::ExecuteSchedulePerWorld( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds )
+{
+	JobManager *pJobManager = JobManager::GetInstance();
+	if ( !pJobManager || rWorlds.GetSize() < 2 )
+	{
+		ExecuteSchedule( schedule, rWorlds );
+		return;
+	}
+
+	// Tasks take a list of worlds, so give each world a list of its own
+	const size_t worldCount = rWorlds.GetSize();
+	DynamicArray< DynamicArray< WorldPtr > > perWorldLists;
+	perWorldLists.Resize( worldCount );
+	for ( size_t worldIndex = 0; worldIndex < worldCount; ++worldIndex )
+	{
+		perWorldLists[ worldIndex ].Push( rWorlds[ worldIndex ] );
+	}
+
+	const uint32_t taskCount = static_cast< uint32_t >( schedule.m_ScheduleFunc.GetSize() );
+	uint32_t segmentStart = 0;
+	while ( segmentStart < taskCount )
+	{
+		// Find the run of tasks up to the next main thread task
+		uint32_t segmentEnd = segmentStart;
+		while ( segmentEnd < taskCount &&
+			!( schedule.m_ScheduleInfo[ segmentEnd ]->m_Contract.m_Flags & TaskFlags::MainThreadOnly ) )
+		{
+			++segmentEnd;
+		}
+
+		if ( segmentEnd != segmentStart )
+		{
+			JobHandle group = pJobManager->CreateGroup();
+			for ( size_t worldIndex = 0; worldIndex < worldCount; ++worldIndex )
+			{
+				PerWorldTaskJobData jobData;
+				jobData.m_pSchedule = &schedule;
+				jobData.m_pWorld = &perWorldLists[ worldIndex ];
+				jobData.m_StartTaskIndex = segmentStart;
+				jobData.m_EndTaskIndex = segmentEnd;
+
+				pJobManager->Run( pJobManager->CreateJob( &RunPerWorldTasksCallback, &jobData, sizeof( jobData ), group ) );
+			}
+
+			pJobManager->Run( group );
+			pJobManager->Wait( group );
+		}
+
+		if ( segmentEnd < taskCount )
+		{
+			ExecuteTask( schedule, segmentEnd, rWorlds );
+			++segmentEnd;
+		}
+
+		segmentStart = segmentEnd;
+	}
+}
+
+void TaskScheduler::SetExecutionMode( TaskExecutionMode executionMode )
+{
+	m_ExecutionMode = executionMode;
+}
+
+TaskExecutionMode TaskScheduler::GetExecutionMode()
+{
+	return m_ExecutionMode;
+}
+
+// Get the task being executed by the calling thread, or null if the thread isn't running a task
+const TaskDefinition *TaskScheduler::GetCurrentTask()
+{
+	return static_cast< const TaskDefinition * >( s_CurrentTaskTls.GetPointer() );
 }
 
 void Helium::TaskScheduler::ResetContracts()
@@ -67,6 +67,34 @@ namespace Helium
 	}
 	typedef TickTypes::TickType TickType;
 
+	namespace TaskFlags
+	{
+		enum TaskFlag
+		{
+			// Task must be run on the thread executing the schedule (i.e. it talks to the renderer, window system or
+			// input devices). Note that other tasks may still be running on worker threads at the same time, so any
+			// shared data must still be protected by order requirements.
+			MainThreadOnly      = 1<<0,
+
+			// Task only touches the components of the tuple it is processing (and reads shared data), so
+			// ParallelQueryComponents() may split its tuples across job workers
+			ParallelQueries     = 1<<1,
+
+			None                = 0,
+		};
+	}
+	typedef uint32_t TaskFlag;
+
+	namespace TaskExecutionModes
+	{
+		enum TaskExecutionMode
+		{
+			Serial,   // Run every task in schedule order on the calling thread
+			Parallel, // Run tasks on job workers as soon as all the tasks they require have completed
+		};
+	}
+	typedef TaskExecutionModes::TaskExecutionMode TaskExecutionMode;
+
 	struct OrderRequirement
 	{
 		TaskDefinition *m_Dependency;
@@ -78,6 +106,7 @@ namespace Helium
 	{
 		TaskContract()
 			: m_TickType( TickTypes::Never )
+			, m_Flags( TaskFlags::None )
 		{
 
 		}
@@ -126,6 +155,18 @@ namespace Helium
 			m_TickType = tickType;
 		}
 
+		// This task must run on the thread executing the schedule when tasks are executed in parallel
+		void ExecuteOnMainThread()
+		{
+			m_Flags |= TaskFlags::MainThreadOnly;
+		}
+
+		// Component queries run by this task through ParallelQueryComponents() may be spread across job workers
+		void ExecuteQueriesInParallel()
+		{
+			m_Flags |= TaskFlags::ParallelQueries;
+		}
+
 		// Every requirement to be before or after another dependency goes here
 		DynamicArray<OrderRequirement> m_OrderRequirements;
 
@@ -133,6 +174,9 @@ namespace Helium
 		DynamicArray<const TaskDefinition *> m_ContributedDependencies;
 
 		TickType m_TickType;
+
+		// Combination of TaskFlags
+		TaskFlag m_Flags;
 	};
 
 	class World;
@@ -187,6 +231,13 @@ namespace Helium
 	{
 		A_TaskDefinitionPtr m_ScheduleInfo;
 		DynamicArray<TaskFunc> m_ScheduleFunc; // Compact version of our schedule
+
+		// Dependency graph of the compact schedule, used when executing tasks in parallel. The dependents of task i
+		// are m_ScheduleDependents[m_ScheduleDependentsStart[i]] up to (but not including)
+		// m_ScheduleDependents[m_ScheduleDependentsStart[i + 1]]
+		DynamicArray<uint32_t> m_ScheduleDependencyCounts; // Number of scheduled tasks each task must wait on
+		DynamicArray<uint32_t> m_ScheduleDependentsStart;
+		DynamicArray<uint32_t> m_ScheduleDependents;
 	};
 
 	class HELIUM_FRAMEWORK_API TaskScheduler
@@ -194,10 +245,22 @@ namespace Helium
 	public:
 		static bool CalculateSchedule( uint32_t tickType, TaskSchedule &schedule );
 		static void ExecuteSchedule( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds );
+		static void ExecuteSchedulePerWorld( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds );
 
 		static void ResetContracts();
 
+		static void SetExecutionMode( TaskExecutionMode executionMode );
+		static TaskExecutionMode GetExecutionMode();
+
+		static const TaskDefinition *GetCurrentTask();
+
 		static bool m_ContractsDefined;
+
+	private:
+		static void ExecuteScheduleSerial( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds );
+		static void ExecuteScheduleParallel( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds );
+
+		static TaskExecutionMode m_ExecutionMode;
 	};
 
 	namespace StandardDependencies
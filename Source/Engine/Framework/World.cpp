@@ -70,6 +70,9 @@ void World::Cleanup()
 
 	m_RootSlice.Set( NULL );
 
+	m_DeferredDestroyEntities.Clear();
+	m_DestroyingEntities.Clear();
+
 	m_Components.ReleaseAll();
 }
 
@@ -88,6 +91,61 @@ Slice *World::GetRootSlice()
 	return m_RootSlice;
 }
 
+/// Queue an entity to be destroyed by the next call to DestroyDeferredEntities().
+///
+/// This can be called from tasks running in parallel.
+///
+/// @param[in] pEntity  Entity to destroy.
+///
+/// @see DestroyDeferredEntities(), Entity::DeferredDestroy()
+void World::DeferDestroyEntity( Entity *pEntity )
+{
+	HELIUM_ASSERT( pEntity );
+
+	MutexScopeLock lock( m_DeferredDestroyLock );
+	m_DeferredDestroyEntities.Push( EntityPtr( pEntity ) );
+}
+
+/// Destroy every entity queued with DeferDestroyEntity() in one batch.
+///
+/// Entities that are no longer bound to a slice of this world (because they were already destroyed or queued more
+/// than once) are skipped.
+///
+/// @return  Number of entities destroyed.
+///
+/// @see DeferDestroyEntity()
+size_t World::DestroyDeferredEntities()
+{
+	{
+		MutexScopeLock lock( m_DeferredDestroyLock );
+		if ( m_DeferredDestroyEntities.IsEmpty() )
+		{
+			return 0;
+		}
+
+		m_DestroyingEntities.Swap( m_DeferredDestroyEntities );
+	}
+
+	size_t destroyedCount = 0;
+
+	size_t entityCount = m_DestroyingEntities.GetSize();
+	for ( size_t entityIndex = 0; entityIndex < entityCount; ++entityIndex )
+	{
+		Entity *pEntity = m_DestroyingEntities[ entityIndex ];
+		HELIUM_ASSERT( pEntity );
+
+		Slice *pSlice = pEntity->GetSlice().Get();
+		if ( pSlice && pSlice->GetWorld() == this && pSlice->DestroyEntity( pEntity ) )
+		{
+			++destroyedCount;
+		}
+	}
+
+	m_DestroyingEntities.Resize( 0 );
+
+	return destroyedCount;
+}
+
 /// @copydoc Asset::PreDestroy()
 void World::RefCountPreDestroy()
 {
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "Platform/Locks.h"
+
 #include "Framework/ComponentQuery.h"
 #include "Framework/Framework.h"
 
 namespace Helium
 {
 	class Entity;
+	typedef Helium::StrongPtr< Entity > EntityPtr;
 	class EntityDefinition;
 	
 	class Slice;
@@ -53,6 +56,9 @@ namespace Helium
 		//virtual Entity *CreateEntity(EntityDefinition *pEntityDefinition, Slice *pSlice = 0);
 		//virtual Entity *DestroyEntity(Entity *pEntity);
 		Slice *GetRootSlice();
+
+		void DeferDestroyEntity( Entity *pEntity );
+		size_t DestroyDeferredEntities();
 		//@}
 
 		/// @name SceneDefinition Registration
@@ -77,6 +83,13 @@ namespace Helium
 		/// Active slices.
 		DynamicArray< SlicePtr > m_Slices;
 		SlicePtr m_RootSlice;
+
+		/// Entities queued for destruction at the end of the frame.
+		DynamicArray< EntityPtr > m_DeferredDestroyEntities;
+		/// Entities being destroyed by DestroyDeferredEntities() (kept to reuse its allocation).
+		DynamicArray< EntityPtr > m_DestroyingEntities;
+		/// Synchronization for the deferred destroy queue, which may be filled from parallel tasks.
+		Mutex m_DeferredDestroyLock;
 	};
 
 	typedef Helium::StrongPtr< World > WorldPtr;
@@ -119,6 +132,35 @@ namespace Helium
 		HELIUM_ASSERT( pComponentManager );
 		QueryComponentsInternal( *pComponentManager, types, HELIUM_ARRAY_COUNT(types), TupleHandler<A, B, C, F> );
 	}
+
+	// Parallel versions of QueryComponents. When run by a task whose contract calls ExecuteQueriesInParallel(), F is
+	// called for chunks of tuples on the job workers, so it must only modify the components it is given.
+	template <class A, class B, void (*F)(A *, B *)>
+	inline void ParallelQueryComponents( World *pWorld )
+	{
+		static Components::TypeId types[] = {
+			Components::GetType<A>(),
+			Components::GetType<B>()
+		};
+
+		ComponentManager *pComponentManager = pWorld->GetComponentManager();
+		HELIUM_ASSERT( pComponentManager );
+		ParallelQueryComponentsInternal( *pComponentManager, types, HELIUM_ARRAY_COUNT(types), TupleHandler<A, B, F> );
+	}
+
+	template <class A, class B, class C, void (*F)(A *, B *, C *)>
+	inline void ParallelQueryComponents( World *pWorld )
+	{
+		static Components::TypeId types[] = {
+			Components::GetType<A>(),
+			Components::GetType<B>(),
+			Components::GetType<C>()
+		};
+
+		ComponentManager *pComponentManager = pWorld->GetComponentManager();
+		HELIUM_ASSERT( pComponentManager );
+		ParallelQueryComponentsInternal( *pComponentManager, types, HELIUM_ARRAY_COUNT(types), TupleHandler<A, B, C, F> );
+	}
 }
 
 #include "Framework/World.inl"
@@ -20,6 +20,7 @@ WorldManager::WorldManager()
 , m_frameDeltaTickCount( 0 )
 , m_frameDeltaSeconds( 0.0f )
 , m_bProcessedFirstFrame( false )
+, m_bParallelWorldUpdate( false )
 {
 }
 
@@ -181,29 +182,21 @@ void WorldManager::Update( TaskSchedule &schedule )
 	// Update the world time.
 	UpdateTime();
 	
-	Helium::TaskScheduler::ExecuteSchedule( schedule, m_worlds );
+	if ( m_bParallelWorldUpdate )
+	{
+		Helium::TaskScheduler::ExecuteSchedulePerWorld( schedule, m_worlds );
+	}
+	else
+	{
+		Helium::TaskScheduler::ExecuteSchedule( schedule, m_worlds );
+	}
 	
 	Components::Tick();
 
-	// TODO: I plan to do a "flag system" - components that are super lightweight.. like bitflags.. that carry no data
-	// but mark an object. This data would be kept parallel with slices/worlds so that they would be far faster to query
-	// than this abomination
+	// Destroy the entities each world queued for deferred destruction during the frame.
 	for ( DynamicArray< WorldPtr >::Iterator worldIter = m_worlds.Begin(); worldIter != m_worlds.End(); ++worldIter )
 	{
-		for ( size_t sliceIndex = 0; sliceIndex < (*worldIter)->GetSliceCount(); ++sliceIndex )
-		{
-			Slice *pSlice = (*worldIter)->GetSlice( sliceIndex );
-			for ( size_t entityIndex = 0; entityIndex < pSlice->GetEntityCount(); ++entityIndex )
-			{
-				Entity *pEntity = pSlice->GetEntity( entityIndex );
-
-				if ( pEntity->IsDeferredDestroySet() )
-				{
-					// TODO: I don't like that strong pointers might be holding these references alive.. need to find a way to fix this
-					pSlice->DestroyEntity( pEntity );
-				}
-			}
-		}
+		(*worldIter)->DestroyDeferredEntities();
 	}
 }
 
@@ -36,6 +36,9 @@ namespace Helium
 		/// @name Updating
 		//@{
 		void Update( TaskSchedule &schedule );
+
+		inline void SetParallelWorldUpdate( bool bParallelWorldUpdate );
+		inline bool IsParallelWorldUpdateEnabled() const;
 		//@}
 
 		/// @name Timing
@@ -69,6 +72,8 @@ namespace Helium
 
 		/// True if the first frame has been processed.
 		bool m_bProcessedFirstFrame;
+		/// True if each world's schedule should be executed on its own job worker.
+		bool m_bParallelWorldUpdate;
 
 		/// Singleton instance.
 		static WorldManager* sm_pInstance;
@@ -35,4 +35,28 @@ namespace Helium
     {
         return m_frameDeltaSeconds;
     }
-}
\ No newline at end of file
+
+    /// Set whether worlds should be updated in parallel.
+    ///
+    /// When enabled (and the JobManager is running), each world's task schedule is executed on its own job worker
+    /// during Update(), so the cost of a frame is bounded by the slowest world rather than the sum of all worlds.
+    /// Tasks flagged as main-thread-only are still run for all worlds on the thread calling Update().
+    ///
+    /// @param[in] bParallelWorldUpdate  True to update worlds in parallel, false to update them serially.
+    ///
+    /// @see IsParallelWorldUpdateEnabled()
+    void WorldManager::SetParallelWorldUpdate( bool bParallelWorldUpdate )
+    {
+        m_bParallelWorldUpdate = bParallelWorldUpdate;
+    }
+
+    /// Get whether worlds are updated in parallel.
+    ///
+    /// @return  True if worlds are updated in parallel, false if not.
+    ///
+    /// @see SetParallelWorldUpdate()
+    bool WorldManager::IsParallelWorldUpdateEnabled() const
+    {
+        return m_bParallelWorldUpdate;
+    }
+}
@@ -0,0 +1,63 @@
+#include "Precompile.h"
+#include "FrameworkImpl/NullRendererInitializationImpl.h"
+
+#include "RenderingNull/NullRenderer.h"
+
+#include "Graphics/RenderResourceManager.h"
+#include "Graphics/DynamicDrawer.h"
+#include "Graphics/TextureStreamer.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] displayWidth   Width of the main rendering context, in pixels.
+/// @param[in] displayHeight  Height of the main rendering context, in pixels.
+NullRendererInitializationImpl::NullRendererInitializationImpl( uint32_t displayWidth, uint32_t displayHeight )
+: m_displayWidth( displayWidth )
+, m_displayHeight( displayHeight )
+{
+}
+
+/// @copydoc RendererInitialization::Initialize()
+bool NullRendererInitializationImpl::Initialize()
+{
+	NullRenderer::Startup();
+
+	Renderer* pRenderer = NullRenderer::GetInstance();
+	if( !HELIUM_VERIFY( pRenderer ) )
+	{
+		return false;
+	}
+
+	// Create the main rendering context.  No window is needed, as nothing is actually presented.
+	Renderer::ContextInitParameters contextInitParams;
+	contextInitParams.displayWidth = m_displayWidth;
+	contextInitParams.displayHeight = m_displayHeight;
+	if( !HELIUM_VERIFY( pRenderer->CreateMainContext( contextInitParams ) ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"NullRendererInitializationImpl::Initialize(): Failed to create main renderer context.\n" );
+
+		return false;
+	}
+
+	RenderResourceManager::Startup();
+	DynamicDrawer::Startup();
+	TextureStreamer::Startup();
+
+	return true;
+}
+
+void Helium::NullRendererInitializationImpl::Shutdown()
+{
+	TextureStreamer::Shutdown();
+	DynamicDrawer::Shutdown();
+	RenderResourceManager::Shutdown();
+
+	if( Renderer::GetInstance() )
+	{
+		NullRenderer::Shutdown();
+	}
+}
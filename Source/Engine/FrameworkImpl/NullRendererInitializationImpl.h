@@ -0,0 +1,40 @@
+#pragma once
+
+#include "FrameworkImpl/FrameworkImpl.h"
+#include "Framework/RendererInitialization.h"
+
+namespace Helium
+{
+	/// Renderer factory implementation that creates a null renderer.
+	///
+	/// The null renderer keeps all render resources in system memory and only counts the commands issued to it, so
+	/// the full rendering path can be run headless (i.e. for benchmarking or automated performance testing) without
+	/// any window or graphics device.
+	class HELIUM_FRAMEWORK_IMPL_API NullRendererInitializationImpl : public RendererInitialization
+	{
+	public:
+		/// Default main context width, in pixels.
+		static const uint32_t DEFAULT_DISPLAY_WIDTH = 1280;
+		/// Default main context height, in pixels.
+		static const uint32_t DEFAULT_DISPLAY_HEIGHT = 720;
+
+		/// @name Construction/Destruction
+		//@{
+		NullRendererInitializationImpl(
+			uint32_t displayWidth = DEFAULT_DISPLAY_WIDTH, uint32_t displayHeight = DEFAULT_DISPLAY_HEIGHT );
+		//@}
+
+		/// @name Renderer Initialization
+		//@{
+		virtual bool Initialize();
+		//@}
+
+		virtual void Shutdown();
+
+	private:
+		/// Main context width, in pixels.
+		uint32_t m_displayWidth;
+		/// Main context height, in pixels.
+		uint32_t m_displayHeight;
+	};
+}
@@ -12,6 +12,7 @@
 
 #include "Graphics/RenderResourceManager.h"
 #include "Graphics/DynamicDrawer.h"
+#include "Graphics/TextureStreamer.h"
 
 using namespace Helium;
 
@@ -86,6 +87,7 @@ bool RendererInitializationImpl::Initialize()
 
 	RenderResourceManager::Startup();
 	DynamicDrawer::Startup();
+	TextureStreamer::Startup();
 	return true;
 }
 
@@ -112,6 +114,7 @@ void RendererInitializationImpl::OnMainWindowDestroyed( Window* pWindow )
 
 void Helium::RendererInitializationImpl::Shutdown()
 {
+	TextureStreamer::Shutdown();
 	DynamicDrawer::Shutdown();
 	RenderResourceManager::Shutdown();
 
@@ -1,12 +1,17 @@
 #include "Precompile.h"
 #include "Graphics/Animation.h"
 
+#include "Reflect/TranslatorDeduction.h"
+
 #if HELIUM_USE_GRANNY_ANIMATION
 #include "GrannyAnimationInterface.h"
 #include "GrannyAnimationInterface.cpp.inl"
 #endif
 
 HELIUM_IMPLEMENT_ASSET( Helium::Animation, Graphics, AssetType::FLAG_NO_TEMPLATE );
+#if !HELIUM_USE_GRANNY_ANIMATION
+HELIUM_DEFINE_CLASS( Helium::Animation::PersistentResourceData );
+#endif
 
 using namespace Helium;
 
@@ -27,3 +32,88 @@ Name Animation::GetCacheName() const
 
     return cacheName;
 }
+
+/// @copydoc Resource::LoadPersistentResourceObject()
+bool Animation::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+{
+#if HELIUM_USE_GRANNY_ANIMATION
+    return Base::LoadPersistentResourceObject( _object );
+#else
+    HELIUM_ASSERT( _object.ReferencesObject() );
+    if( !_object.ReferencesObject() )
+    {
+        return false;
+    }
+
+    _object->CopyTo( &m_persistentResourceData );
+
+    size_t trackCount = m_persistentResourceData.m_trackNames.GetSize();
+    size_t sampleCount = m_persistentResourceData.m_sampleCount;
+    if( m_persistentResourceData.m_rotations.GetSize() != trackCount * sampleCount * ROTATION_COMPONENT_COUNT ||
+        m_persistentResourceData.m_translations.GetSize() != trackCount * sampleCount * VECTOR_COMPONENT_COUNT ||
+        m_persistentResourceData.m_translationMinimums.GetSize() != trackCount * VECTOR_COMPONENT_COUNT ||
+        m_persistentResourceData.m_translationRanges.GetSize() != trackCount * VECTOR_COMPONENT_COUNT ||
+        ( !m_persistentResourceData.m_scales.IsEmpty() &&
+          ( m_persistentResourceData.m_scales.GetSize() != trackCount * sampleCount * VECTOR_COMPONENT_COUNT ||
+            m_persistentResourceData.m_scaleMinimums.GetSize() != trackCount * VECTOR_COMPONENT_COUNT ||
+            m_persistentResourceData.m_scaleRanges.GetSize() != trackCount * VECTOR_COMPONENT_COUNT ) ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            "Animation::LoadPersistentResourceObject(): Animation \"%s\" contains inconsistent track data.\n",
+            *GetPath().ToString() );
+
+        m_persistentResourceData.m_trackNames.Clear();
+        m_persistentResourceData.m_sampleCount = 0;
+
+        return false;
+    }
+
+    return true;
+#endif
+}
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+/// Find the track animating a given bone.
+///
+/// @param[in] boneName  Name of the bone to locate.
+///
+/// @return  Index of the track animating the bone, or an invalid index if no track animates it.
+///
+/// @see GetTrackCount(), GetTrackNames()
+size_t Animation::FindTrack( Name boneName ) const
+{
+    const DynamicArray< Name >& rTrackNames = m_persistentResourceData.m_trackNames;
+    size_t trackCount = rTrackNames.GetSize();
+    for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+    {
+        if( rTrackNames[ trackIndex ] == boneName )
+        {
+            return trackIndex;
+        }
+    }
+
+    return Invalid< size_t >();
+}
+
+/// Constructor.
+Animation::PersistentResourceData::PersistentResourceData()
+: m_sampleCount( 0 )
+, m_samplesPerSecond( 0.0f )
+{
+}
+
+void Animation::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+    comp.AddField( &PersistentResourceData::m_trackNames,           "m_trackNames" );
+    comp.AddField( &PersistentResourceData::m_sampleCount,          "m_sampleCount" );
+    comp.AddField( &PersistentResourceData::m_samplesPerSecond,     "m_samplesPerSecond" );
+    comp.AddField( &PersistentResourceData::m_translationMinimums,  "m_translationMinimums" );
+    comp.AddField( &PersistentResourceData::m_translationRanges,    "m_translationRanges" );
+    comp.AddField( &PersistentResourceData::m_scaleMinimums,        "m_scaleMinimums" );
+    comp.AddField( &PersistentResourceData::m_scaleRanges,          "m_scaleRanges" );
+    comp.AddField( &PersistentResourceData::m_rotations,            "m_rotations" );
+    comp.AddField( &PersistentResourceData::m_translations,         "m_translations" );
+    comp.AddField( &PersistentResourceData::m_scales,               "m_scales" );
+}
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
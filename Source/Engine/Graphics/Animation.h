@@ -3,6 +3,7 @@
 #include "Graphics/Graphics.h"
 #include "Engine/Resource.h"
 
+#include "Foundation/DynamicArray.h"
 #include "GraphicsTypes/GraphicsTypes.h"
 
 #if HELIUM_USE_GRANNY_ANIMATION
@@ -17,12 +18,66 @@ namespace Helium
         HELIUM_DECLARE_ASSET( Animation, Resource );
 
     public:
+#if !HELIUM_USE_GRANNY_ANIMATION
+        /// Number of quantized rotation components stored for each track sample.
+        static const size_t ROTATION_COMPONENT_COUNT = 4;
+        /// Number of quantized translation or scale components stored for each track sample.
+        static const size_t VECTOR_COMPONENT_COUNT = 3;
+
+        /// Native animation clip data.
+        ///
+        /// Each track stores one sample per frame for the bone with the corresponding name.  Samples are stored frame
+        /// by frame, with the samples for every track in a given frame stored contiguously, so evaluating a clip at a
+        /// given time only touches two small contiguous ranges of data.  Rotations are quantized to 16 bits per
+        /// component over the range [-1, 1], while translations and scales are quantized to 16 bits per component over
+        /// the range covered by each track.
+        struct HELIUM_GRAPHICS_API PersistentResourceData : public Object
+        {
+            HELIUM_DECLARE_CLASS(Animation::PersistentResourceData, Reflect::Object);
+
+            PersistentResourceData();
+            static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+            /// Name of the bone animated by each track.
+            DynamicArray< Name > m_trackNames;
+
+            /// Number of samples stored for each track.
+            uint32_t m_sampleCount;
+            /// Number of samples per second of playback.
+            float32_t m_samplesPerSecond;
+
+            /// Smallest translation in each track (three components per track).
+            DynamicArray< float32_t > m_translationMinimums;
+            /// Translation range covered by each track (three components per track).
+            DynamicArray< float32_t > m_translationRanges;
+            /// Smallest scale in each track (three components per track, empty if no track is scaled).
+            DynamicArray< float32_t > m_scaleMinimums;
+            /// Scale range covered by each track (three components per track, empty if no track is scaled).
+            DynamicArray< float32_t > m_scaleRanges;
+
+            /// Quantized rotation samples.
+            DynamicArray< uint16_t > m_rotations;
+            /// Quantized translation samples.
+            DynamicArray< uint16_t > m_translations;
+            /// Quantized scale samples (empty if no track is scaled).
+            DynamicArray< uint16_t > m_scales;
+        };
+
+        /// Persistent animation resource data.
+        PersistentResourceData m_persistentResourceData;
+#endif
+
         /// @name Construction/Destruction
         //@{
         Animation();
         virtual ~Animation();
         //@}
 
+        /// @name Resource Serialization
+        //@{
+        virtual bool LoadPersistentResourceObject( Reflect::ObjectPtr& _object ) override;
+        //@}
+
         /// @name Resource Caching Support
         //@{
         virtual Name GetCacheName() const override;
@@ -32,6 +87,15 @@ namespace Helium
         //@{
 #if HELIUM_USE_GRANNY_ANIMATION
         inline const Granny::AnimationData& GetGrannyData() const;
+#else
+        inline size_t GetTrackCount() const;
+        inline const Name* GetTrackNames() const;
+        inline uint32_t GetSampleCount() const;
+        inline float32_t GetSamplesPerSecond() const;
+        inline float32_t GetDuration() const;
+        inline bool HasScale() const;
+
+        size_t FindTrack( Name boneName ) const;
 #endif
         //@}
 
@@ -8,5 +8,75 @@ namespace Helium
     {
         return m_grannyData;
     }
+#else  // HELIUM_USE_GRANNY_ANIMATION
+    /// Get the number of tracks in this animation.
+    ///
+    /// @return  Track count.
+    ///
+    /// @see GetTrackNames(), FindTrack()
+    size_t Animation::GetTrackCount() const
+    {
+        return m_persistentResourceData.m_trackNames.GetSize();
+    }
+
+    /// Get the name of the bone animated by each track.
+    ///
+    /// @return  Pointer to the track name array, or null if this animation has no tracks.
+    ///
+    /// @see GetTrackCount(), FindTrack()
+    const Name* Animation::GetTrackNames() const
+    {
+        if( m_persistentResourceData.m_trackNames.IsEmpty() )
+        {
+            return NULL;
+        }
+
+        return m_persistentResourceData.m_trackNames.GetData();
+    }
+
+    /// Get the number of samples stored for each track.
+    ///
+    /// @return  Sample count.
+    ///
+    /// @see GetSamplesPerSecond(), GetDuration()
+    uint32_t Animation::GetSampleCount() const
+    {
+        return m_persistentResourceData.m_sampleCount;
+    }
+
+    /// Get the rate at which samples are played back.
+    ///
+    /// @return  Samples per second.
+    ///
+    /// @see GetSampleCount(), GetDuration()
+    float32_t Animation::GetSamplesPerSecond() const
+    {
+        return m_persistentResourceData.m_samplesPerSecond;
+    }
+
+    /// Get the playback length of this animation.
+    ///
+    /// @return  Animation duration, in seconds.
+    ///
+    /// @see GetSampleCount(), GetSamplesPerSecond()
+    float32_t Animation::GetDuration() const
+    {
+        float32_t samplesPerSecond = m_persistentResourceData.m_samplesPerSecond;
+        uint32_t sampleCount = m_persistentResourceData.m_sampleCount;
+        if( samplesPerSecond <= 0.0f || sampleCount <= 1 )
+        {
+            return 0.0f;
+        }
+
+        return static_cast< float32_t >( sampleCount - 1 ) / samplesPerSecond;
+    }
+
+    /// Get whether any track in this animation contains scale data.
+    ///
+    /// @return  True if scale data is present, false if every track keeps a unit scale.
+    bool Animation::HasScale() const
+    {
+        return !m_persistentResourceData.m_scales.IsEmpty();
+    }
 #endif  // HELIUM_USE_GRANNY_ANIMATION
 }
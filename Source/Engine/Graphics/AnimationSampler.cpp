@@ -0,0 +1,590 @@
+#include "Precompile.h"
+#include "Graphics/AnimationSampler.h"
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+#include "Graphics/Animation.h"
+#include "Graphics/Mesh.h"
+#include "MathSimd/Matrix44Soa.h"
+#include "MathSimd/QuatSoa.h"
+#include "MathSimd/Vector3Soa.h"
+#include "EngineJobs/JobManager.h"
+
+#include <algorithm>
+
+using namespace Helium;
+
+/// Number of skeletons evaluated together (one per SIMD lane).
+static const size_t SAMPLER_LANE_COUNT = HELIUM_SIMD_SIZE / sizeof( float32_t );
+/// Number of skeleton groups evaluated by each job.
+static const size_t SAMPLER_JOB_GROUP_COUNT = 8;
+/// Scale converting quantized sample components to the range [0, 1].
+static const float32_t SAMPLER_DEQUANTIZE_SCALE = 1.0f / 65535.0f;
+
+/// Skeletons sharing the same mesh that are evaluated together.
+struct AnimationSkeletonGroup
+{
+	/// Skeleton evaluated in each SIMD lane.
+	const AnimationSampler::Skeleton* pSkeletons[ SAMPLER_LANE_COUNT ];
+	/// Number of lanes in use.
+	size_t skeletonCount;
+};
+
+/// Skeleton group evaluation job data.
+struct AnimationEvaluateJobData
+{
+	/// First group to evaluate.
+	const AnimationSkeletonGroup* pGroups;
+	/// Number of groups to evaluate.
+	size_t groupCount;
+};
+
+/// Position within an animation layer being sampled for a single skeleton.
+struct AnimationLayerPosition
+{
+	/// Animation data to sample, or null if the layer does not contribute to the skeleton.
+	const Animation::PersistentResourceData* pData;
+	/// Index of the animation track for each bone.
+	const uint16_t* pTrackMap;
+	/// Index of the sample preceding the current time.
+	size_t sample0;
+	/// Index of the sample following the current time.
+	size_t sample1;
+	/// Interpolation factor between the two samples.
+	float32_t alpha;
+	/// Layer blend weight.
+	float32_t weight;
+};
+
+/// Sort comparison for grouping skeletons by mesh.
+class SkeletonMeshCompare
+{
+public:
+	bool operator()(
+		const AnimationSampler::Skeleton* pSkeleton0, const AnimationSampler::Skeleton* pSkeleton1 ) const
+	{
+		return pSkeleton0->pMesh < pSkeleton1->pMesh;
+	}
+};
+
+/// Compute the sample range and interpolation factor for an animation layer.
+///
+/// @param[in]  rLayer     Layer to sample.
+/// @param[out] rPosition  Sample position within the layer's animation.
+static void GetLayerPosition( const AnimationSampler::Layer& rLayer, AnimationLayerPosition& rPosition )
+{
+	rPosition.pData = NULL;
+	rPosition.pTrackMap = rLayer.pTrackMap;
+	rPosition.sample0 = 0;
+	rPosition.sample1 = 0;
+	rPosition.alpha = 0.0f;
+	rPosition.weight = rLayer.weight;
+
+	const Animation* pAnimation = rLayer.pAnimation;
+	if ( !pAnimation || !rLayer.pTrackMap || rLayer.weight <= 0.0f )
+	{
+		return;
+	}
+
+	uint32_t sampleCount = pAnimation->GetSampleCount();
+	if ( sampleCount == 0 || pAnimation->GetTrackCount() == 0 )
+	{
+		return;
+	}
+
+	rPosition.pData = &pAnimation->m_persistentResourceData;
+
+	float32_t duration = pAnimation->GetDuration();
+	if ( duration <= 0.0f )
+	{
+		return;
+	}
+
+	// Wrap the time to the animation duration so that clips loop.
+	float32_t time = rLayer.time;
+	time -= duration * static_cast< float32_t >( static_cast< int64_t >( time / duration ) );
+	if ( time < 0.0f )
+	{
+		time += duration;
+	}
+
+	float32_t position = time * pAnimation->GetSamplesPerSecond();
+	size_t sample0 = Min( static_cast< size_t >( position ), static_cast< size_t >( sampleCount - 1 ) );
+
+	rPosition.sample0 = sample0;
+	rPosition.sample1 = Min( sample0 + 1, static_cast< size_t >( sampleCount - 1 ) );
+	rPosition.alpha = Clamp( position - static_cast< float32_t >( sample0 ), 0.0f, 1.0f );
+}
+
+/// Dequantize the rotation of a track sample.
+///
+/// @param[in]  rData        Animation data.
+/// @param[in]  sampleIndex  Sample index.
+/// @param[in]  trackIndex   Track index.
+/// @param[out] pRotation    Rotation component arrays (x, y, z, w).
+/// @param[in]  lane         SIMD lane in which to store the rotation.
+static void DequantizeRotation(
+	const Animation::PersistentResourceData& rData,
+	size_t sampleIndex,
+	size_t trackIndex,
+	float32_t ( *pRotation )[ SAMPLER_LANE_COUNT ],
+	size_t lane )
+{
+	size_t trackCount = rData.m_trackNames.GetSize();
+	const uint16_t* pSample =
+		rData.m_rotations.GetData() + ( sampleIndex * trackCount + trackIndex ) * Animation::ROTATION_COMPONENT_COUNT;
+	for ( size_t component = 0; component < Animation::ROTATION_COMPONENT_COUNT; ++component )
+	{
+		pRotation[component][lane] =
+			static_cast< float32_t >( pSample[component] ) * ( 2.0f * SAMPLER_DEQUANTIZE_SCALE ) - 1.0f;
+	}
+}
+
+/// Dequantize the translation or scale of a track sample.
+///
+/// @param[in]  rSamples     Quantized samples.
+/// @param[in]  rMinimums    Smallest value in each track.
+/// @param[in]  rRanges      Range covered by each track.
+/// @param[in]  trackCount   Number of tracks.
+/// @param[in]  sampleIndex  Sample index.
+/// @param[in]  trackIndex   Track index.
+/// @param[out] pVector      Vector component arrays (x, y, z).
+/// @param[in]  lane         SIMD lane in which to store the vector.
+static void DequantizeVector(
+	const DynamicArray< uint16_t >& rSamples,
+	const DynamicArray< float32_t >& rMinimums,
+	const DynamicArray< float32_t >& rRanges,
+	size_t trackCount,
+	size_t sampleIndex,
+	size_t trackIndex,
+	float32_t ( *pVector )[ SAMPLER_LANE_COUNT ],
+	size_t lane )
+{
+	const uint16_t* pSample =
+		rSamples.GetData() + ( sampleIndex * trackCount + trackIndex ) * Animation::VECTOR_COMPONENT_COUNT;
+	const float32_t* pMinimum = rMinimums.GetData() + trackIndex * Animation::VECTOR_COMPONENT_COUNT;
+	const float32_t* pRange = rRanges.GetData() + trackIndex * Animation::VECTOR_COMPONENT_COUNT;
+	for ( size_t component = 0; component < Animation::VECTOR_COMPONENT_COUNT; ++component )
+	{
+		pVector[component][lane] =
+			pMinimum[component] +
+			static_cast< float32_t >( pSample[component] ) * SAMPLER_DEQUANTIZE_SCALE * pRange[component];
+	}
+}
+
+/// Negate the quaternions in the lanes selected by a mask.
+///
+/// @param[in,out] rQuat  Quaternions to update.
+/// @param[in]     mask   Lanes to negate.
+static void NegateQuatLanes( Simd::QuatSoa& rQuat, Simd::Mask mask )
+{
+	Simd::Register zero = Simd::LoadZeros();
+	rQuat.m_x = Simd::Select( rQuat.m_x, Simd::SubtractF32( zero, rQuat.m_x ), mask );
+	rQuat.m_y = Simd::Select( rQuat.m_y, Simd::SubtractF32( zero, rQuat.m_y ), mask );
+	rQuat.m_z = Simd::Select( rQuat.m_z, Simd::SubtractF32( zero, rQuat.m_z ), mask );
+	rQuat.m_w = Simd::Select( rQuat.m_w, Simd::SubtractF32( zero, rQuat.m_w ), mask );
+}
+
+/// Compute the four-component dot product of two sets of quaternions.
+///
+/// @param[in] rQuat0  First set of quaternions.
+/// @param[in] rQuat1  Second set of quaternions.
+///
+/// @return  Dot product of each pair of quaternions.
+static Simd::Register DotQuat( const Simd::QuatSoa& rQuat0, const Simd::QuatSoa& rQuat1 )
+{
+	Simd::Register dot = Simd::MultiplyF32( rQuat0.m_x, rQuat1.m_x );
+	dot = Simd::MultiplyAddF32( rQuat0.m_y, rQuat1.m_y, dot );
+	dot = Simd::MultiplyAddF32( rQuat0.m_z, rQuat1.m_z, dot );
+	dot = Simd::MultiplyAddF32( rQuat0.m_w, rQuat1.m_w, dot );
+
+	return dot;
+}
+
+/// Evaluate the bone palettes for a group of skeletons sharing the same mesh.
+///
+/// @param[in]     rGroup            Skeleton group.
+/// @param[in,out] rModelTransforms  Scratch space for the world-space transform of each bone.
+static void EvaluateSkeletonGroup(
+	const AnimationSkeletonGroup& rGroup, DynamicArray< Simd::Matrix44Soa >& rModelTransforms )
+{
+	HELIUM_ASSERT( rGroup.skeletonCount != 0 );
+	HELIUM_ASSERT( rGroup.skeletonCount <= SAMPLER_LANE_COUNT );
+
+	const Mesh* pMesh = rGroup.pSkeletons[0]->pMesh;
+	HELIUM_ASSERT( pMesh );
+
+	size_t boneCount = pMesh->GetBoneCount();
+	const uint8_t* pParentBoneIndices = pMesh->GetParentBoneIndices();
+	const Simd::Matrix44* pReferencePose = pMesh->GetReferencePose();
+	HELIUM_ASSERT( pParentBoneIndices );
+	HELIUM_ASSERT( pReferencePose );
+
+	// Unused lanes repeat the first skeleton so that every lane holds valid data.  Their results are never stored.
+	const AnimationSampler::Skeleton* pLaneSkeletons[ SAMPLER_LANE_COUNT ];
+	for ( size_t lane = 0; lane < SAMPLER_LANE_COUNT; ++lane )
+	{
+		pLaneSkeletons[lane] = rGroup.pSkeletons[lane < rGroup.skeletonCount ? lane : 0];
+	}
+
+	AnimationLayerPosition layerPositions[ AnimationSampler::LAYER_COUNT_MAX ][ SAMPLER_LANE_COUNT ];
+	for ( size_t layerIndex = 0; layerIndex < AnimationSampler::LAYER_COUNT_MAX; ++layerIndex )
+	{
+		for ( size_t lane = 0; lane < SAMPLER_LANE_COUNT; ++lane )
+		{
+			const AnimationSampler::Skeleton* pSkeleton = pLaneSkeletons[lane];
+			AnimationLayerPosition& rPosition = layerPositions[layerIndex][lane];
+			if ( layerIndex < pSkeleton->layerCount )
+			{
+				GetLayerPosition( pSkeleton->layers[layerIndex], rPosition );
+			}
+			else
+			{
+				rPosition.pData = NULL;
+			}
+		}
+	}
+
+	// Gather the skeleton world transforms.
+	HELIUM_SIMD_ALIGN_PRE float32_t rootTransformData[ 16 ][ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	for ( size_t lane = 0; lane < SAMPLER_LANE_COUNT; ++lane )
+	{
+		const Simd::Matrix44* pTransform = pLaneSkeletons[lane]->pTransform;
+		if ( !pTransform )
+		{
+			pTransform = &Simd::Matrix44::IDENTITY;
+		}
+
+		for ( size_t element = 0; element < 16; ++element )
+		{
+			rootTransformData[element][lane] = pTransform->GetElement( element );
+		}
+	}
+
+	Simd::Matrix44Soa rootTransform(
+		rootTransformData[0], rootTransformData[1], rootTransformData[2], rootTransformData[3],
+		rootTransformData[4], rootTransformData[5], rootTransformData[6], rootTransformData[7],
+		rootTransformData[8], rootTransformData[9], rootTransformData[10], rootTransformData[11],
+		rootTransformData[12], rootTransformData[13], rootTransformData[14], rootTransformData[15] );
+
+	if ( rModelTransforms.GetSize() < boneCount )
+	{
+		rModelTransforms.Resize( boneCount );
+	}
+
+	Simd::Register zero = Simd::LoadZeros();
+
+	HELIUM_SIMD_ALIGN_PRE float32_t rotationData0[ 4 ][ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t rotationData1[ 4 ][ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t translationData0[ 3 ][ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t translationData1[ 3 ][ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t scaleData0[ 3 ][ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t scaleData1[ 3 ][ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t alphaData[ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t weightData[ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t paletteData[ 16 ][ SAMPLER_LANE_COUNT ] HELIUM_SIMD_ALIGN_POST;
+
+	for ( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+	{
+		Simd::QuatSoa rotation( zero, zero, zero, zero );
+		Simd::Vector3Soa translation( zero, zero, zero );
+		Simd::Vector3Soa scale( zero, zero, zero );
+		Simd::Register weightSum = zero;
+
+		for ( size_t layerIndex = 0; layerIndex < AnimationSampler::LAYER_COUNT_MAX; ++layerIndex )
+		{
+			// Gather both samples surrounding the current time for each lane.  Lanes with no track for this bone
+			// contribute nothing to the blend.
+			bool bLayerUsed = false;
+			for ( size_t lane = 0; lane < SAMPLER_LANE_COUNT; ++lane )
+			{
+				const AnimationLayerPosition& rPosition = layerPositions[layerIndex][lane];
+				const Animation::PersistentResourceData* pData = rPosition.pData;
+				uint16_t trackIndex = ( pData ? rPosition.pTrackMap[boneIndex] : Invalid< uint16_t >() );
+				if ( IsInvalid( trackIndex ) )
+				{
+					rotationData0[0][lane] = rotationData1[0][lane] = 0.0f;
+					rotationData0[1][lane] = rotationData1[1][lane] = 0.0f;
+					rotationData0[2][lane] = rotationData1[2][lane] = 0.0f;
+					rotationData0[3][lane] = rotationData1[3][lane] = 1.0f;
+					for ( size_t component = 0; component < Animation::VECTOR_COMPONENT_COUNT; ++component )
+					{
+						translationData0[component][lane] = translationData1[component][lane] = 0.0f;
+						scaleData0[component][lane] = scaleData1[component][lane] = 1.0f;
+					}
+
+					alphaData[lane] = 0.0f;
+					weightData[lane] = 0.0f;
+
+					continue;
+				}
+
+				bLayerUsed = true;
+
+				size_t trackCount = pData->m_trackNames.GetSize();
+				HELIUM_ASSERT( trackIndex < trackCount );
+
+				DequantizeRotation( *pData, rPosition.sample0, trackIndex, rotationData0, lane );
+				DequantizeRotation( *pData, rPosition.sample1, trackIndex, rotationData1, lane );
+				DequantizeVector(
+					pData->m_translations, pData->m_translationMinimums, pData->m_translationRanges, trackCount,
+					rPosition.sample0, trackIndex, translationData0, lane );
+				DequantizeVector(
+					pData->m_translations, pData->m_translationMinimums, pData->m_translationRanges, trackCount,
+					rPosition.sample1, trackIndex, translationData1, lane );
+
+				if ( pData->m_scales.IsEmpty() )
+				{
+					for ( size_t component = 0; component < Animation::VECTOR_COMPONENT_COUNT; ++component )
+					{
+						scaleData0[component][lane] = scaleData1[component][lane] = 1.0f;
+					}
+				}
+				else
+				{
+					DequantizeVector(
+						pData->m_scales, pData->m_scaleMinimums, pData->m_scaleRanges, trackCount, rPosition.sample0,
+						trackIndex, scaleData0, lane );
+					DequantizeVector(
+						pData->m_scales, pData->m_scaleMinimums, pData->m_scaleRanges, trackCount, rPosition.sample1,
+						trackIndex, scaleData1, lane );
+				}
+
+				alphaData[lane] = rPosition.alpha;
+				weightData[lane] = rPosition.weight;
+			}
+
+			if ( !bLayerUsed )
+			{
+				continue;
+			}
+
+			Simd::Register alpha = Simd::LoadAligned( alphaData );
+			Simd::Register weight = Simd::LoadAligned( weightData );
+
+			// Interpolate between the samples along the shortest arc.
+			Simd::QuatSoa rotation0( rotationData0[0], rotationData0[1], rotationData0[2], rotationData0[3] );
+			Simd::QuatSoa rotation1( rotationData1[0], rotationData1[1], rotationData1[2], rotationData1[3] );
+			NegateQuatLanes( rotation1, Simd::LessF32( DotQuat( rotation0, rotation1 ), zero ) );
+
+			Simd::QuatSoa layerRotation(
+				Simd::MultiplyAddF32( Simd::SubtractF32( rotation1.m_x, rotation0.m_x ), alpha, rotation0.m_x ),
+				Simd::MultiplyAddF32( Simd::SubtractF32( rotation1.m_y, rotation0.m_y ), alpha, rotation0.m_y ),
+				Simd::MultiplyAddF32( Simd::SubtractF32( rotation1.m_z, rotation0.m_z ), alpha, rotation0.m_z ),
+				Simd::MultiplyAddF32( Simd::SubtractF32( rotation1.m_w, rotation0.m_w ), alpha, rotation0.m_w ) );
+
+			Simd::Vector3Soa translation0( translationData0[0], translationData0[1], translationData0[2] );
+			Simd::Vector3Soa translation1( translationData1[0], translationData1[1], translationData1[2] );
+			Simd::Vector3Soa scale0( scaleData0[0], scaleData0[1], scaleData0[2] );
+			Simd::Vector3Soa scale1( scaleData1[0], scaleData1[1], scaleData1[2] );
+
+			// Accumulate the weighted layer transform, keeping each layer's rotation in the same hemisphere as the
+			// layers blended so far.
+			NegateQuatLanes( layerRotation, Simd::LessF32( DotQuat( rotation, layerRotation ), zero ) );
+
+			rotation.m_x = Simd::MultiplyAddF32( layerRotation.m_x, weight, rotation.m_x );
+			rotation.m_y = Simd::MultiplyAddF32( layerRotation.m_y, weight, rotation.m_y );
+			rotation.m_z = Simd::MultiplyAddF32( layerRotation.m_z, weight, rotation.m_z );
+			rotation.m_w = Simd::MultiplyAddF32( layerRotation.m_w, weight, rotation.m_w );
+
+			Simd::Register sampleWeight0 =
+				Simd::MultiplyF32( Simd::SubtractF32( Simd::SetSplatF32( 1.0f ), alpha ), weight );
+			Simd::Register sampleWeight1 = Simd::MultiplyF32( alpha, weight );
+			translation.m_x = Simd::MultiplyAddF32( translation0.m_x, sampleWeight0, translation.m_x );
+			translation.m_y = Simd::MultiplyAddF32( translation0.m_y, sampleWeight0, translation.m_y );
+			translation.m_z = Simd::MultiplyAddF32( translation0.m_z, sampleWeight0, translation.m_z );
+			translation.m_x = Simd::MultiplyAddF32( translation1.m_x, sampleWeight1, translation.m_x );
+			translation.m_y = Simd::MultiplyAddF32( translation1.m_y, sampleWeight1, translation.m_y );
+			translation.m_z = Simd::MultiplyAddF32( translation1.m_z, sampleWeight1, translation.m_z );
+
+			scale.m_x = Simd::MultiplyAddF32( scale0.m_x, sampleWeight0, scale.m_x );
+			scale.m_y = Simd::MultiplyAddF32( scale0.m_y, sampleWeight0, scale.m_y );
+			scale.m_z = Simd::MultiplyAddF32( scale0.m_z, sampleWeight0, scale.m_z );
+			scale.m_x = Simd::MultiplyAddF32( scale1.m_x, sampleWeight1, scale.m_x );
+			scale.m_y = Simd::MultiplyAddF32( scale1.m_y, sampleWeight1, scale.m_y );
+			scale.m_z = Simd::MultiplyAddF32( scale1.m_z, sampleWeight1, scale.m_z );
+
+			weightSum = Simd::AddF32( weightSum, weight );
+		}
+
+		// Normalize the blended transform, falling back to the reference pose in lanes where no layer animates this
+		// bone.
+		Simd::Mask animatedMask = Simd::GreaterF32( weightSum, zero );
+		Simd::Register inverseWeightSum = Simd::InverseF32( Simd::MaxF32( weightSum, Simd::EPSILON ) );
+		translation.Scale( inverseWeightSum );
+		scale.Scale( inverseWeightSum );
+		rotation.Normalize();
+
+		Simd::Matrix44Soa localTransform;
+		localTransform.SetRotationTranslationScaling( rotation, translation, scale );
+
+		Simd::Matrix44Soa referenceTransform( pReferencePose[boneIndex] );
+		for ( size_t row = 0; row < 4; ++row )
+		{
+			for ( size_t column = 0; column < 4; ++column )
+			{
+				localTransform.m_matrix[row][column] = Simd::Select(
+					referenceTransform.m_matrix[row][column], localTransform.m_matrix[row][column], animatedMask );
+			}
+		}
+
+		// Parent bones always precede their children, so their world transforms are already available.
+		Simd::Matrix44Soa& rModelTransform = rModelTransforms[boneIndex];
+		uint8_t parentIndex = pParentBoneIndices[boneIndex];
+		if ( IsValid( parentIndex ) )
+		{
+			HELIUM_ASSERT( parentIndex < boneIndex );
+			rModelTransform.MultiplySet( localTransform, rModelTransforms[parentIndex] );
+		}
+		else
+		{
+			rModelTransform.MultiplySet( localTransform, rootTransform );
+		}
+
+		// Scatter the lanes back out to each skeleton's bone palette.
+		rModelTransform.Store(
+			paletteData[0], paletteData[1], paletteData[2], paletteData[3],
+			paletteData[4], paletteData[5], paletteData[6], paletteData[7],
+			paletteData[8], paletteData[9], paletteData[10], paletteData[11],
+			paletteData[12], paletteData[13], paletteData[14], paletteData[15] );
+
+		for ( size_t lane = 0; lane < rGroup.skeletonCount; ++lane )
+		{
+			Simd::Matrix44& rPaletteTransform = rGroup.pSkeletons[lane]->pBonePalette[boneIndex];
+			for ( size_t element = 0; element < 16; ++element )
+			{
+				rPaletteTransform.GetElement( element ) = paletteData[element][lane];
+			}
+		}
+	}
+}
+
+/// Evaluate a range of skeleton groups.
+///
+/// @param[in] pData  Job data.
+static void EvaluateSkeletonGroupsCallback( void* pData )
+{
+	HELIUM_ASSERT( pData );
+	const AnimationEvaluateJobData* pJobData = static_cast< const AnimationEvaluateJobData* >( pData );
+
+	DynamicArray< Simd::Matrix44Soa > modelTransforms;
+	for ( size_t groupIndex = 0; groupIndex < pJobData->groupCount; ++groupIndex )
+	{
+		EvaluateSkeletonGroup( pJobData->pGroups[groupIndex], modelTransforms );
+	}
+}
+
+/// Build the mapping from each bone in a mesh to the animation track that animates it.
+///
+/// Track maps only need to be rebuilt when the mesh or animation changes.
+///
+/// @param[in]  pMesh       Skinned mesh.
+/// @param[in]  pAnimation  Animation.
+/// @param[out] rTrackMap   Index of the track for each bone, or an invalid index for bones with no track.
+void AnimationSampler::BuildTrackMap(
+	const Mesh* pMesh, const Animation* pAnimation, DynamicArray< uint16_t >& rTrackMap )
+{
+	rTrackMap.Resize( 0 );
+	if ( !pMesh )
+	{
+		return;
+	}
+
+	size_t boneCount = pMesh->GetBoneCount();
+	const Name* pBoneNames = pMesh->GetBoneNames();
+	rTrackMap.Resize( boneCount );
+	for ( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+	{
+		size_t trackIndex = Invalid< size_t >();
+		if ( pAnimation && pBoneNames )
+		{
+			trackIndex = pAnimation->FindTrack( pBoneNames[boneIndex] );
+		}
+
+		rTrackMap[boneIndex] =
+			( trackIndex < Invalid< uint16_t >() ? static_cast< uint16_t >( trackIndex ) : Invalid< uint16_t >() );
+	}
+}
+
+/// Sample and blend the animations for a set of skeletons, writing each skeleton's world-space bone palette.
+///
+/// Skeletons using the same mesh are evaluated together, one per SIMD lane.  Evaluation is spread across the job
+/// workers if a job manager exists, and this function returns once every skeleton has been evaluated.  Bones with no
+/// track in any layer are left in their reference pose.
+///
+/// @param[in] pSkeletons     Skeletons to evaluate.
+/// @param[in] skeletonCount  Number of skeletons.
+void AnimationSampler::Evaluate( const Skeleton* pSkeletons, size_t skeletonCount )
+{
+	if ( skeletonCount == 0 )
+	{
+		return;
+	}
+
+	HELIUM_ASSERT( pSkeletons );
+
+	DynamicArray< const Skeleton* > sortedSkeletons;
+	sortedSkeletons.Reserve( skeletonCount );
+	for ( size_t skeletonIndex = 0; skeletonIndex < skeletonCount; ++skeletonIndex )
+	{
+		const Skeleton& rSkeleton = pSkeletons[skeletonIndex];
+		const Mesh* pMesh = rSkeleton.pMesh;
+		if ( pMesh && rSkeleton.pBonePalette && pMesh->GetBoneCount() != 0 && pMesh->GetReferencePose() )
+		{
+			sortedSkeletons.Push( &rSkeleton );
+		}
+	}
+
+	if ( sortedSkeletons.IsEmpty() )
+	{
+		return;
+	}
+
+	const Skeleton** ppSkeletonsBegin = sortedSkeletons.GetData();
+	std::sort( ppSkeletonsBegin, ppSkeletonsBegin + sortedSkeletons.GetSize(), SkeletonMeshCompare() );
+
+	DynamicArray< AnimationSkeletonGroup > groups;
+	groups.Reserve( ( sortedSkeletons.GetSize() + SAMPLER_LANE_COUNT - 1 ) / SAMPLER_LANE_COUNT );
+	AnimationSkeletonGroup* pGroup = NULL;
+	for ( size_t skeletonIndex = 0; skeletonIndex < sortedSkeletons.GetSize(); ++skeletonIndex )
+	{
+		const Skeleton* pSkeleton = sortedSkeletons[skeletonIndex];
+		if ( !pGroup ||
+			pGroup->skeletonCount == SAMPLER_LANE_COUNT ||
+			pGroup->pSkeletons[0]->pMesh != pSkeleton->pMesh )
+		{
+			pGroup = groups.New();
+			HELIUM_ASSERT( pGroup );
+			pGroup->skeletonCount = 0;
+		}
+
+		pGroup->pSkeletons[pGroup->skeletonCount++] = pSkeleton;
+	}
+
+	size_t groupCount = groups.GetSize();
+	JobManager* pJobManager = JobManager::GetInstance();
+	if ( !pJobManager || groupCount <= SAMPLER_JOB_GROUP_COUNT )
+	{
+		AnimationEvaluateJobData jobData;
+		jobData.pGroups = groups.GetData();
+		jobData.groupCount = groupCount;
+		EvaluateSkeletonGroupsCallback( &jobData );
+
+		return;
+	}
+
+	JobHandle jobGroup = pJobManager->CreateGroup();
+	for ( size_t firstGroup = 0; firstGroup < groupCount; firstGroup += SAMPLER_JOB_GROUP_COUNT )
+	{
+		AnimationEvaluateJobData jobData;
+		jobData.pGroups = groups.GetData() + firstGroup;
+		jobData.groupCount = Min( SAMPLER_JOB_GROUP_COUNT, groupCount - firstGroup );
+
+		pJobManager->Run( pJobManager->CreateJob( &EvaluateSkeletonGroupsCallback, &jobData, sizeof( jobData ), jobGroup ) );
+	}
+
+	pJobManager->Run( jobGroup );
+	pJobManager->Wait( jobGroup );
+}
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/Matrix44.h"
+
+namespace Helium
+{
+    class Animation;
+    class Mesh;
+
+    /// Native skeletal animation sampling and blending.
+    ///
+    /// Skeletons sharing the same mesh are evaluated together in groups of up to four, with each skeleton occupying a
+    /// single SIMD lane, so the work for each bone of an entire group is performed with a single set of SIMD
+    /// operations.  Groups are spread across the job workers when a job manager is available.
+    class HELIUM_GRAPHICS_API AnimationSampler
+    {
+    public:
+        /// Maximum number of animation layers blended together for a single skeleton.
+        static const size_t LAYER_COUNT_MAX = 2;
+
+        /// Animation layer to sample for a skeleton.
+        struct Layer
+        {
+            /// Animation to sample.
+            const Animation* pAnimation;
+            /// Index of the animation track for each bone in the mesh (invalid for bones with no track).
+            const uint16_t* pTrackMap;
+            /// Playback time, in seconds (wrapped to the animation duration).
+            float32_t time;
+            /// Blend weight.
+            float32_t weight;
+        };
+
+        /// Skeleton to evaluate.
+        struct Skeleton
+        {
+            /// Skinned mesh providing the bone hierarchy and reference pose.
+            const Mesh* pMesh;
+            /// World transform of the skeleton.
+            const Simd::Matrix44* pTransform;
+            /// World-space transform of each bone (output, one entry per mesh bone).
+            Simd::Matrix44* pBonePalette;
+            /// Animation layers to blend.
+            Layer layers[ LAYER_COUNT_MAX ];
+            /// Number of animation layers in use.
+            uint32_t layerCount;
+        };
+
+        /// @name Static Evaluation
+        //@{
+        static void BuildTrackMap( const Mesh* pMesh, const Animation* pAnimation, DynamicArray< uint16_t >& rTrackMap );
+        static void Evaluate( const Skeleton* pSkeletons, size_t skeletonCount );
+        //@}
+    };
+}
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
@@ -24,6 +24,10 @@ BufferedDrawer::BufferedDrawer()
 	, m_instanceVertexConstantBufferIndex( Invalid< uint32_t >() )
 	, m_instancePixelConstantBlendColor( Color( 0xffffffff ) )
 	, m_instancePixelConstantBufferIndex( Invalid< uint32_t >() )
+	, m_spriteBatchCount( 0 )
+	, m_lastSpriteBatchIndex( Invalid< size_t >() )
+	, m_spriteCount( 0 )
+	, m_spriteDrawCount( 0 )
 	, m_currentResourceSetIndex( 0 )
 	, m_bDrawing( false )
 {
@@ -36,6 +40,7 @@ BufferedDrawer::BufferedDrawer()
 		rResourceSet.texturedIndexBufferSize = 0;
 		rResourceSet.screenSpaceTextVertexBufferSize = 0;
 		rResourceSet.projectedTextVertexBufferSize = 0;
+		rResourceSet.spriteVertexBufferSize = 0;
 	}
 }
 
@@ -98,6 +103,36 @@ bool BufferedDrawer::Initialize()
 			return false;
 		}
 
+		// Allocate the index buffer to use for sprite rendering, with two triangles for each sprite quad.
+		DynamicArray< uint16_t > spriteIndices;
+		spriteIndices.Resize( SPRITE_DRAW_SIZE_MAX * 6 );
+		uint16_t* pSpriteIndex = spriteIndices.GetData();
+		for( size_t spriteIndex = 0; spriteIndex < SPRITE_DRAW_SIZE_MAX; ++spriteIndex )
+		{
+			uint16_t baseVertexIndex = static_cast< uint16_t >( spriteIndex * 4 );
+			pSpriteIndex[ 0 ] = baseVertexIndex;
+			pSpriteIndex[ 1 ] = baseVertexIndex + 1;
+			pSpriteIndex[ 2 ] = baseVertexIndex + 2;
+			pSpriteIndex[ 3 ] = baseVertexIndex + 2;
+			pSpriteIndex[ 4 ] = baseVertexIndex + 1;
+			pSpriteIndex[ 5 ] = baseVertexIndex + 3;
+			pSpriteIndex += 6;
+		}
+
+		m_spSpriteIndexBuffer = pRenderer->CreateIndexBuffer(
+			sizeof( uint16_t ) * spriteIndices.GetSize(),
+			RENDERER_BUFFER_USAGE_STATIC,
+			RENDERER_INDEX_FORMAT_UINT16,
+			spriteIndices.GetData() );
+		if( !m_spSpriteIndexBuffer )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				"BufferedDrawer::Initialize(): Failed to create index buffer for sprite rendering.\n" );
+
+			return false;
+		}
+
 		// Allocate constant buffers for per-instance vertex and pixel shader constants.
 		for( size_t resourceSetIndex = 0; resourceSetIndex < HELIUM_ARRAY_COUNT( m_resourceSets ); ++resourceSetIndex )
 		{
@@ -180,8 +215,15 @@ void BufferedDrawer::Shutdown()
 	m_projectedTextDrawCalls.Clear();
 	m_screenTextGlyphIndices.Clear();
 
+	m_spriteBatches.Clear();
+	m_spriteBatchCount = 0;
+	SetInvalid( m_lastSpriteBatchIndex );
+	m_spriteCount = 0;
+	m_spriteDrawCount = 0;
+
 	m_spQuadVertexBuffer.Release();
 	m_spScreenSpaceTextIndexBuffer.Release();
+	m_spSpriteIndexBuffer.Release();
 
 	for( size_t fenceIndex = 0; fenceIndex < HELIUM_ARRAY_COUNT( m_instanceVertexConstantFences ); ++fenceIndex )
 	{
@@ -207,12 +249,14 @@ void BufferedDrawer::Shutdown()
 		rResourceSet.spTexturedVertexBuffer.Release();
 		rResourceSet.spTexturedIndexBuffer.Release();
 		rResourceSet.spScreenSpaceTextVertexBuffer.Release();
+		rResourceSet.spSpriteVertexBuffer.Release();
 		rResourceSet.untexturedVertexBufferSize = 0;
 		rResourceSet.untexturedIndexBufferSize = 0;
 		rResourceSet.texturedVertexBufferSize = 0;
 		rResourceSet.texturedIndexBufferSize = 0;
 		rResourceSet.screenSpaceTextVertexBufferSize = 0;
 		rResourceSet.projectedTextVertexBufferSize = 0;
+		rResourceSet.spriteVertexBufferSize = 0;
 
 		for( size_t bufferIndex = 0;
 			 bufferIndex < HELIUM_ARRAY_COUNT( rResourceSet.instancePixelConstantBuffers );
@@ -503,6 +547,152 @@ void BufferedDrawer::DrawTextured(
 	pDrawCall->transform = rTransform;
 }
 
+/// Buffer a textured sprite quad for batched rendering.
+///
+/// Sprites are grouped by texture and render state, with each group rendered using as few draw calls as possible
+/// instead of a draw call per sprite.  Sprites within a group are rendered in the order in which they are submitted,
+/// but the order in which groups are rendered is unspecified.
+///
+/// @param[in] pTexture           Texture to apply to the sprite.
+/// @param[in] rTransform         World transform of the unit quad, centered on the origin, to draw.
+/// @param[in] rUvTopLeft         Texture coordinates of the top-left corner of the sprite.
+/// @param[in] rUvBottomRight     Texture coordinates of the bottom-right corner of the sprite.
+/// @param[in] blendColor         Color with which to blend the sprite.
+/// @param[in] rasterizerState    Rasterizer state to use during rendering.
+/// @param[in] depthStencilState  Depth-stencil state to use during rendering.
+///
+/// @see DrawTexturedQuad()
+void BufferedDrawer::DrawSprite(
+	RTexture2d* pTexture,
+	const Simd::Matrix44& rTransform,
+	const Simd::Vector2& rUvTopLeft,
+	const Simd::Vector2& rUvBottomRight,
+	Color blendColor,
+	RenderResourceManager::ERasterizerState rasterizerState,
+	RenderResourceManager::EDepthStencilState depthStencilState )
+{
+	HELIUM_ASSERT( pTexture );
+	HELIUM_ASSERT(
+		static_cast< size_t >( rasterizerState ) <
+		static_cast< size_t >( RenderResourceManager::RASTERIZER_STATE_MAX ) );
+	HELIUM_ASSERT(
+		static_cast< size_t >( depthStencilState ) <
+		static_cast< size_t >( RenderResourceManager::DEPTH_STENCIL_STATE_MAX ) );
+
+	// Cannot add draw calls while rendering.
+	HELIUM_ASSERT( !m_bDrawing );
+
+	// Don't buffer any drawing information if we have no renderer.
+	if( !Renderer::GetInstance() )
+	{
+		return;
+	}
+
+	size_t stateIndex = GetStateIndex( rasterizerState, depthStencilState );
+
+	// Locate the batch for the sprite texture and state.  Sprites tend to be submitted in runs sharing the same
+	// texture, so check the batch most recently added to before searching the rest.
+	SpriteBatch* pBatch = NULL;
+	if( m_lastSpriteBatchIndex < m_spriteBatchCount )
+	{
+		SpriteBatch& rBatch = m_spriteBatches[ m_lastSpriteBatchIndex ];
+		if( rBatch.spTexture == pTexture && rBatch.stateIndex == stateIndex )
+		{
+			pBatch = &rBatch;
+		}
+	}
+
+	if( !pBatch )
+	{
+		for( size_t batchIndex = 0; batchIndex < m_spriteBatchCount; ++batchIndex )
+		{
+			SpriteBatch& rBatch = m_spriteBatches[ batchIndex ];
+			if( rBatch.spTexture == pTexture && rBatch.stateIndex == stateIndex )
+			{
+				pBatch = &rBatch;
+				m_lastSpriteBatchIndex = batchIndex;
+
+				break;
+			}
+		}
+
+		if( !pBatch )
+		{
+			if( m_spriteBatchCount >= m_spriteBatches.GetSize() )
+			{
+				m_spriteBatches.New();
+			}
+
+			pBatch = &m_spriteBatches[ m_spriteBatchCount ];
+			HELIUM_ASSERT( pBatch->vertices.IsEmpty() );
+			pBatch->spTexture = pTexture;
+			pBatch->stateIndex = stateIndex;
+			pBatch->spriteCount = 0;
+			pBatch->baseVertexIndex = 0;
+
+			m_lastSpriteBatchIndex = m_spriteBatchCount;
+			++m_spriteBatchCount;
+		}
+	}
+
+	// Transform the quad corners into world space.  Each corner is a sum of the transform rows scaled by the corner
+	// coordinates (+/-0.5 along the x and y axes, 1 along the z axis), so only the half-extent axes need to be
+	// scaled, and the corners themselves are built from vector adds and subtracts.
+	Simd::Vector4 halfAxisX = rTransform.GetRow( 0 ) * 0.5f;
+	Simd::Vector4 halfAxisY = rTransform.GetRow( 1 ) * 0.5f;
+	Simd::Vector4 center = rTransform.GetRow( 2 ) + rTransform.GetRow( 3 );
+
+	Simd::Vector4 centerTop = center + halfAxisY;
+	Simd::Vector4 centerBottom = center - halfAxisY;
+
+	Simd::Vector4 corners[ 4 ] =
+	{
+		centerTop - halfAxisX,
+		centerTop + halfAxisX,
+		centerBottom - halfAxisX,
+		centerBottom + halfAxisX,
+	};
+
+	Float32 texCoordLeft32, texCoordTop32, texCoordRight32, texCoordBottom32;
+	texCoordLeft32.value = rUvTopLeft.GetX();
+	texCoordTop32.value = rUvTopLeft.GetY();
+	texCoordRight32.value = rUvBottomRight.GetX();
+	texCoordBottom32.value = rUvBottomRight.GetY();
+
+	Float16 texCoordLeft = Float32To16( texCoordLeft32 );
+	Float16 texCoordTop = Float32To16( texCoordTop32 );
+	Float16 texCoordRight = Float32To16( texCoordRight32 );
+	Float16 texCoordBottom = Float32To16( texCoordBottom32 );
+
+	const Float16 cornerTexCoords[ 4 ][ 2 ] =
+	{
+		{ texCoordLeft, texCoordBottom },
+		{ texCoordRight, texCoordBottom },
+		{ texCoordLeft, texCoordTop },
+		{ texCoordRight, texCoordTop },
+	};
+
+	size_t vertexIndex = pBatch->vertices.GetSize();
+	pBatch->vertices.Resize( vertexIndex + 4 );
+	SimpleTexturedVertex* pVertex = pBatch->vertices.GetData() + vertexIndex;
+	for( size_t cornerIndex = 0; cornerIndex < 4; ++cornerIndex )
+	{
+		const Simd::Vector4& rCorner = corners[ cornerIndex ];
+		pVertex->position[ 0 ] = rCorner.GetElement( 0 );
+		pVertex->position[ 1 ] = rCorner.GetElement( 1 );
+		pVertex->position[ 2 ] = rCorner.GetElement( 2 );
+		pVertex->color[ 0 ] = blendColor.GetR();
+		pVertex->color[ 1 ] = blendColor.GetG();
+		pVertex->color[ 2 ] = blendColor.GetB();
+		pVertex->color[ 3 ] = blendColor.GetA();
+		pVertex->texCoords[ 0 ] = cornerTexCoords[ cornerIndex ][ 0 ];
+		pVertex->texCoords[ 1 ] = cornerTexCoords[ cornerIndex ][ 1 ];
+		++pVertex;
+	}
+
+	++pBatch->spriteCount;
+}
+
 /// Buffer a point list draw call using points larger than a pixel.
 ///
 /// @param[in] pVertices          Vertices to use for drawing.
@@ -770,6 +960,20 @@ void BufferedDrawer::BeginDrawing()
 	uint_fast32_t projectedTextGlyphIndexCount = static_cast< uint_fast32_t >( m_projectedTextGlyphIndices.GetSize() );
 	uint_fast32_t projectedTextVertexCount = projectedTextGlyphIndexCount * 4;
 
+	uint_fast32_t spriteCount = 0;
+	uint_fast32_t spriteDrawCount = 0;
+	for( size_t batchIndex = 0; batchIndex < m_spriteBatchCount; ++batchIndex )
+	{
+		uint32_t batchSpriteCount = m_spriteBatches[ batchIndex ].spriteCount;
+		spriteCount += batchSpriteCount;
+		spriteDrawCount += ( batchSpriteCount + SPRITE_DRAW_SIZE_MAX - 1 ) / SPRITE_DRAW_SIZE_MAX;
+	}
+
+	uint_fast32_t spriteVertexCount = spriteCount * 4;
+
+	m_spriteCount = static_cast< uint32_t >( spriteCount );
+	m_spriteDrawCount = static_cast< uint32_t >( spriteDrawCount );
+
 	if( untexturedVertexCount > rResourceSet.untexturedVertexBufferSize )
 	{
 		rResourceSet.spUntexturedVertexBuffer.Release();
@@ -898,6 +1102,27 @@ void BufferedDrawer::BeginDrawing()
 		}
 	}
 
+	if( spriteVertexCount > rResourceSet.spriteVertexBufferSize )
+	{
+		rResourceSet.spSpriteVertexBuffer.Release();
+		rResourceSet.spSpriteVertexBuffer = pRenderer->CreateVertexBuffer(
+			spriteVertexCount * sizeof( SimpleTexturedVertex ),
+			RENDERER_BUFFER_USAGE_DYNAMIC );
+		if( !rResourceSet.spSpriteVertexBuffer )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				"Failed to create vertex buffer for sprite drawing of %" PRIuFAST32 " vertices.\n",
+				spriteVertexCount );
+
+			rResourceSet.spriteVertexBufferSize = 0;
+		}
+		else
+		{
+			rResourceSet.spriteVertexBufferSize = static_cast< uint32_t >( spriteVertexCount );
+		}
+	}
+
 	// Fill the vertex and index buffers for rendering.
 	if( untexturedVertexCount && rResourceSet.spUntexturedVertexBuffer )
 	{
@@ -1202,12 +1427,44 @@ void BufferedDrawer::BeginDrawing()
 		rResourceSet.spProjectedTextVertexBuffer->Unmap();
 	}
 
+	// Pack the vertices of each sprite batch into the sprite vertex buffer.  The batch vertex arrays are emptied but not
+	// freed so that their storage can be reused for the next set of sprites.
+	if( spriteVertexCount && rResourceSet.spSpriteVertexBuffer )
+	{
+		SimpleTexturedVertex* pMappedVertexBuffer = static_cast< SimpleTexturedVertex* >(
+			rResourceSet.spSpriteVertexBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
+		HELIUM_ASSERT( pMappedVertexBuffer );
+
+		uint32_t baseVertexIndex = 0;
+		for( size_t batchIndex = 0; batchIndex < m_spriteBatchCount; ++batchIndex )
+		{
+			SpriteBatch& rBatch = m_spriteBatches[ batchIndex ];
+			uint32_t batchVertexCount = static_cast< uint32_t >( rBatch.vertices.GetSize() );
+			HELIUM_ASSERT( batchVertexCount == rBatch.spriteCount * 4 );
+
+			MemoryCopy(
+				pMappedVertexBuffer + baseVertexIndex,
+				rBatch.vertices.GetData(),
+				batchVertexCount * sizeof( SimpleTexturedVertex ) );
+
+			rBatch.baseVertexIndex = baseVertexIndex;
+			baseVertexIndex += batchVertexCount;
+		}
+
+		rResourceSet.spSpriteVertexBuffer->Unmap();
+	}
+
 	// Clear the buffered vertex and index data, as it is no longer needed.
 	m_untexturedVertices.RemoveAll();
 	m_texturedVertices.RemoveAll();
 	m_untexturedIndices.RemoveAll();
 	m_texturedIndices.RemoveAll();
 
+	for( size_t batchIndex = 0; batchIndex < m_spriteBatchCount; ++batchIndex )
+	{
+		m_spriteBatches[ batchIndex ].vertices.RemoveAll();
+	}
+
 	// Per-instance shader constant management data should already be reset (either from Initialize() or the last
 	// EndDrawing() call).
 	HELIUM_ASSERT( IsInvalid( m_instanceVertexConstantBufferIndex ) );
@@ -1260,6 +1517,17 @@ void BufferedDrawer::EndDrawing()
 		m_pointDrawCalls[ stateIndex ].RemoveAll();
 	}
 
+	for( size_t batchIndex = 0; batchIndex < m_spriteBatchCount; ++batchIndex )
+	{
+		SpriteBatch& rBatch = m_spriteBatches[ batchIndex ];
+		HELIUM_ASSERT( rBatch.vertices.IsEmpty() );
+		rBatch.spTexture.Release();
+		rBatch.spriteCount = 0;
+	}
+
+	m_spriteBatchCount = 0;
+	SetInvalid( m_lastSpriteBatchIndex );
+
 	// Release all fences used to block the usage lifetime of various instance-specific shader constant buffers.
 	for( size_t fenceIndex = 0; fenceIndex < HELIUM_ARRAY_COUNT( m_instanceVertexConstantFences ); ++fenceIndex )
 	{
@@ -1909,6 +2177,9 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 			}
 		}
 
+		// Draw batched sprites.
+		DrawStateSprites( rWorldResources, pRasterizerState, pDepthStencilState, stateIndex );
+
 		// Draw untextured data.
 		if( rWorldResources.spUntexturedVertexShader )
 		{
@@ -2171,6 +2442,116 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 	}
 }
 
+/// Draw the sprite batches for the specified rasterizer and depth-stencil state.
+///
+/// @param[in] rWorldResources     Cached references to various resources used during rendering.
+/// @param[in] pRasterizerState    Rasterizer state to use.
+/// @param[in] pDepthStencilState  Depth-stencil state to use.
+/// @param[in] stateIndex          Draw call set index for the rasterizer and depth-stencil state.
+///
+/// @see DrawDepthStencilStateWorldElements()
+void BufferedDrawer::DrawStateSprites(
+	WorldElementResources& rWorldResources,
+	RRasterizerState* pRasterizerState,
+	RDepthStencilState* pDepthStencilState,
+	size_t stateIndex )
+{
+	HELIUM_ASSERT( pRasterizerState );
+	HELIUM_ASSERT( pDepthStencilState );
+
+	ResourceSet& rResourceSet = m_resourceSets[ m_currentResourceSetIndex ];
+	if( !rResourceSet.spSpriteVertexBuffer || !m_spSpriteIndexBuffer || !rWorldResources.spTextureBlendVertexShader )
+	{
+		return;
+	}
+
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
+	RenderResourceManager* pRenderResourceManager = RenderResourceManager::GetInstance();
+	HELIUM_ASSERT( pRenderResourceManager );
+
+	RRenderCommandProxy* pCommandProxy = rWorldResources.spCommandProxy;
+	HELIUM_ASSERT( pCommandProxy );
+
+	StateCache* pStateCache = rWorldResources.pStateCache;
+	HELIUM_ASSERT( pStateCache );
+
+	bool bStateSet = false;
+	for( size_t batchIndex = 0; batchIndex < m_spriteBatchCount; ++batchIndex )
+	{
+		const SpriteBatch& rBatch = m_spriteBatches[ batchIndex ];
+		if( rBatch.stateIndex != stateIndex || rBatch.spriteCount == 0 )
+		{
+			continue;
+		}
+
+		// Sprite vertices are already in world space and carry their blend color, so the same identity transform and
+		// white blend color are used for every batch.
+		if( !bStateSet )
+		{
+			RBlendState* pBlendStateTransparent = pRenderResourceManager->GetBlendState(
+				RenderResourceManager::BLEND_STATE_TRANSPARENT );
+			HELIUM_ASSERT( pBlendStateTransparent );
+
+			pStateCache->SetRasterizerState( pRasterizerState );
+			pStateCache->SetBlendState( pBlendStateTransparent );
+			pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
+
+			pStateCache->SetVertexShader( rWorldResources.spTextureBlendVertexShader );
+			pStateCache->SetPixelShader( rWorldResources.spTextureBlendPixelShader );
+
+			rWorldResources.spTextureBlendVertexShader->CacheDescription(
+				pRenderer,
+				rWorldResources.spSimpleTexturedVertexDescription );
+			RVertexInputLayout* pVertexInputLayout =
+				rWorldResources.spTextureBlendVertexShader->GetCachedInputLayout();
+			HELIUM_ASSERT( pVertexInputLayout );
+			pStateCache->SetVertexInputLayout( pVertexInputLayout );
+
+			pStateCache->SetVertexBuffer(
+				rResourceSet.spSpriteVertexBuffer,
+				static_cast< uint32_t >( sizeof( SimpleTexturedVertex ) ) );
+			pStateCache->SetIndexBuffer( m_spSpriteIndexBuffer );
+
+			RConstantBuffer* pConstantBuffer = SetInstanceVertexConstantData(
+				pCommandProxy,
+				rResourceSet,
+				rWorldResources.inverseViewProjection,
+				Simd::Matrix44::IDENTITY );
+			HELIUM_ASSERT( pConstantBuffer );
+			pStateCache->SetVertexConstantBuffer( pConstantBuffer );
+
+			RConstantBuffer* pPixelConstantBuffer = SetInstancePixelConstantData(
+				pCommandProxy,
+				rResourceSet,
+				Color( 0xffffffff ) );
+			HELIUM_ASSERT( pPixelConstantBuffer );
+			pStateCache->SetPixelConstantBuffer( pPixelConstantBuffer );
+
+			bStateSet = true;
+		}
+
+		pStateCache->SetTexture( rBatch.spTexture );
+
+		// Batches larger than the sprite index buffer are split across multiple draw calls.
+		for( uint32_t spriteOffset = 0; spriteOffset < rBatch.spriteCount; spriteOffset += SPRITE_DRAW_SIZE_MAX )
+		{
+			uint32_t drawSpriteCount = Min< uint32_t >(
+				rBatch.spriteCount - spriteOffset,
+				static_cast< uint32_t >( SPRITE_DRAW_SIZE_MAX ) );
+
+			pCommandProxy->DrawIndexed(
+				RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST,
+				rBatch.baseVertexIndex + spriteOffset * 4,
+				0,
+				drawSpriteCount * 4,
+				0,
+				drawSpriteCount * 2 );
+		}
+	}
+}
+
 /// Set the vertex shader constant data for the current draw instance.
 ///
 /// @param[in] pCommandProxy           Interface through which render commands should be issued.
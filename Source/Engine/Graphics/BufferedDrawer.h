@@ -33,6 +33,9 @@ namespace Helium
 		/// Maximum number of characters to convert for rendered text strings (including null terminator).
 		static const size_t TEXT_CHARACTER_COUNT_MAX = 1024;
 
+		/// Maximum number of sprites to render with a single draw call (limited by the range of 16-bit indices).
+		static const size_t SPRITE_DRAW_SIZE_MAX = 16384;
+
 		/// @name Construction/Destruction
 		//@{
 		BufferedDrawer();
@@ -102,17 +105,19 @@ namespace Helium
 
 		void DrawTexturedQuad(RTexture2d *pTexture, const Simd::Matrix44& rTransform, const Simd::Vector2 uvTopLeft, const Simd::Vector2 uvBottomRight, Color blendColor = Color( 0xffffffff ))
 		{
-			DynamicArray<SimpleTexturedVertex> verticesT;
-			verticesT.New( Simd::Vector3( -0.5f, 0.5f, 1.0f ), Simd::Vector2( uvTopLeft.GetX(), uvBottomRight.GetY() ) );
-			verticesT.New( Simd::Vector3( 0.5f, 0.5f, 1.0f ), uvBottomRight );
-			verticesT.New( Simd::Vector3( -0.5f, -0.5f, 1.0f ), uvTopLeft );
-			verticesT.New( Simd::Vector3( 0.5f, -0.5f, 1.0f ), Simd::Vector2( uvBottomRight.GetX(), uvTopLeft.GetY() ) );
+			SimpleTexturedVertex verticesT[ 4 ] =
+			{
+				SimpleTexturedVertex( Simd::Vector3( -0.5f, 0.5f, 1.0f ), Simd::Vector2( uvTopLeft.GetX(), uvBottomRight.GetY() ) ),
+				SimpleTexturedVertex( Simd::Vector3( 0.5f, 0.5f, 1.0f ), uvBottomRight ),
+				SimpleTexturedVertex( Simd::Vector3( -0.5f, -0.5f, 1.0f ), uvTopLeft ),
+				SimpleTexturedVertex( Simd::Vector3( 0.5f, -0.5f, 1.0f ), Simd::Vector2( uvBottomRight.GetX(), uvTopLeft.GetY() ) ),
+			};
 
 			DrawTextured(
 				RENDERER_PRIMITIVE_TYPE_TRIANGLE_STRIP,
 				rTransform,
-				verticesT.GetData(),
-				(uint32_t)verticesT.GetSize(),
+				verticesT,
+				static_cast< uint32_t >( HELIUM_ARRAY_COUNT( verticesT ) ),
 				NULL,
 				2,
 				pTexture, 
@@ -138,6 +143,12 @@ namespace Helium
 				Helium::RenderResourceManager::DEPTH_STENCIL_STATE_TEST_ONLY);
 		}
 
+		void DrawSprite(
+			RTexture2d* pTexture, const Simd::Matrix44& rTransform, const Simd::Vector2& rUvTopLeft,
+			const Simd::Vector2& rUvBottomRight, Color blendColor = Color( 0xffffffff ),
+			RenderResourceManager::ERasterizerState rasterizerState = RenderResourceManager::RASTERIZER_STATE_DOUBLE_SIDED,
+			RenderResourceManager::EDepthStencilState depthStencilState = RenderResourceManager::DEPTH_STENCIL_STATE_TEST_ONLY );
+
 		void DrawWorldText(
 			const Simd::Matrix44& rTransform, const String& rText, Color color = Color( 0xffffffff ),
 			RenderResourceManager::EDebugFontSize size = RenderResourceManager::DEBUG_FONT_SIZE_MEDIUM,
@@ -161,6 +172,14 @@ namespace Helium
 		void DrawScreenElements();
 		//@}
 
+		/// @name Statistics
+		//@{
+		/// Get the number of sprites prepared for rendering by the last BeginDrawing() call.
+		uint32_t GetSpriteCount() const { return m_spriteCount; }
+		/// Get the number of draw calls needed to render the sprites prepared by the last BeginDrawing() call.
+		uint32_t GetSpriteDrawCount() const { return m_spriteDrawCount; }
+		//@}
+
 	private:
 		/// Untextured primitive draw call information using internal vertex/index buffers.
 		struct UntexturedDrawCall
@@ -204,6 +223,21 @@ namespace Helium
 			RTexture2dPtr spTexture;
 		} HELIUM_SIMD_ALIGN_POST;
 
+		/// Sprites sharing the same texture and render state, rendered together.
+		struct SpriteBatch
+		{
+			/// Texture with which to draw.
+			RTexture2dPtr spTexture;
+			/// Draw call set index for the rasterizer and depth-stencil state.
+			size_t stateIndex;
+			/// Sprite vertices, already transformed into world space (four per sprite).
+			DynamicArray< SimpleTexturedVertex > vertices;
+			/// Number of sprites in this batch.
+			uint32_t spriteCount;
+			/// Index of the first vertex of this batch in the sprite vertex buffer.
+			uint32_t baseVertexIndex;
+		};
+
 		/// Screen-space text draw call information.
 		struct ScreenTextDrawCall
 		{
@@ -244,6 +278,9 @@ namespace Helium
 			/// Vertex buffer for projected text rendering.
 			RVertexBufferPtr spProjectedTextVertexBuffer;
 
+			/// Vertex buffer for sprite rendering.
+			RVertexBufferPtr spSpriteVertexBuffer;
+
 			/// Vertex constant buffers.
 			RConstantBufferPtr instanceVertexConstantBuffers[ INSTANCE_VERTEX_CONSTANT_BUFFER_COUNT ];
 			/// Pixel constant buffers.
@@ -263,6 +300,9 @@ namespace Helium
 			uint32_t screenSpaceTextVertexBufferSize;
 			/// Maximum number of vertices in the projected text vertex buffer.
 			uint32_t projectedTextVertexBufferSize;
+
+			/// Maximum number of vertices in the sprite vertex buffer.
+			uint32_t spriteVertexBufferSize;
 		} HELIUM_SIMD_ALIGN_POST;
 
 		/// Cached renderer state information.
@@ -529,8 +569,23 @@ namespace Helium
 		/// Projected text draw call glyph indices.
 		DynamicArray< uint32_t > m_projectedTextGlyphIndices;
 
+		/// Sprite batches (only the first m_spriteBatchCount are in use, with the rest kept to reuse their vertex
+		/// storage in later frames).
+		DynamicArray< SpriteBatch > m_spriteBatches;
+		/// Number of sprite batches in use.
+		size_t m_spriteBatchCount;
+		/// Index of the sprite batch to which a sprite was most recently added.
+		size_t m_lastSpriteBatchIndex;
+
+		/// Number of sprites prepared for rendering by the last BeginDrawing() call.
+		uint32_t m_spriteCount;
+		/// Number of draw calls needed to render the sprites prepared by the last BeginDrawing() call.
+		uint32_t m_spriteDrawCount;
+
 		/// Index buffer for screen-space text rendering.
 		RIndexBufferPtr m_spScreenSpaceTextIndexBuffer;
+		/// Index buffer for sprite rendering (quad indices for SPRITE_DRAW_SIZE_MAX sprites).
+		RIndexBufferPtr m_spSpriteIndexBuffer;
 
 		/// Vertices for drawing quads
 		RVertexBufferPtr m_spQuadVertexBuffer;
@@ -571,6 +626,9 @@ namespace Helium
 		void DrawStateWorldElements(
 			WorldElementResources& rWorldResources, RenderResourceManager::ERasterizerState rasterizerState,
 			RenderResourceManager::EDepthStencilState depthStencilState );
+		void DrawStateSprites(
+			WorldElementResources& rWorldResources, RRasterizerState* pRasterizerState,
+			RDepthStencilState* pDepthStencilState, size_t stateIndex );
 		//@}
 
 		/// @name Static Utility Functions
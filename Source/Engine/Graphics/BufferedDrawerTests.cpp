@@ -0,0 +1,218 @@
+#include "Graphics/BufferedDrawer.h"
+
+#include "Foundation/Log.h"
+#include "Platform/Timer.h"
+#include "Rendering/RTexture2d.h"
+#include "RenderingNull/NullRenderer.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+namespace
+{
+	/// Number of distinct sprite textures.
+	const size_t TEXTURE_COUNT = 8;
+	/// Number of sprites submitted each frame by the stress scene test.
+	const size_t STRESS_SPRITE_COUNT = 4096;
+	/// Number of frames rendered by the stress scene test.
+	const size_t STRESS_FRAME_COUNT = 3;
+	/// Number of sprites submitted each frame by the stress scene benchmark.
+	const size_t BENCHMARK_SPRITE_COUNT = 100000;
+	/// Number of frames rendered by the stress scene benchmark.
+	const size_t BENCHMARK_FRAME_COUNT = 8;
+	/// Number of consecutive stress scene sprites that share a texture.
+	const size_t STRESS_SPRITE_RUN_LENGTH = 32;
+
+	/// Starts up the null renderer and a buffered drawer with a set of sprite textures for each test.
+	class BufferedDrawerSpriteTest : public testing::Test
+	{
+	protected:
+		virtual void SetUp()
+		{
+			NullRenderer::Startup();
+
+			m_pRenderer = static_cast< NullRenderer* >( Renderer::GetInstance() );
+			ASSERT_TRUE( m_pRenderer != NULL );
+
+			for( size_t textureIndex = 0; textureIndex < TEXTURE_COUNT; ++textureIndex )
+			{
+				m_spTextures[ textureIndex ] = m_pRenderer->CreateTexture2d(
+					1,
+					1,
+					1,
+					RENDERER_PIXEL_FORMAT_R8G8B8A8,
+					RENDERER_BUFFER_USAGE_STATIC,
+					NULL );
+				ASSERT_TRUE( m_spTextures[ textureIndex ] );
+			}
+
+			ASSERT_TRUE( m_drawer.Initialize() );
+
+			m_pRenderer->ResetStatistics();
+
+			m_submitTicks = 0;
+			m_prepareTicks = 0;
+		}
+
+		virtual void TearDown()
+		{
+			m_drawer.Shutdown();
+
+			for( size_t textureIndex = 0; textureIndex < TEXTURE_COUNT; ++textureIndex )
+			{
+				m_spTextures[ textureIndex ].Release();
+			}
+
+			NullRenderer::Shutdown();
+		}
+
+		/// Buffer a sprite using the full texture.
+		void DrawSprite(
+			size_t textureIndex,
+			RenderResourceManager::ERasterizerState rasterizerState = RenderResourceManager::RASTERIZER_STATE_DOUBLE_SIDED )
+		{
+			m_drawer.DrawSprite(
+				m_spTextures[ textureIndex ],
+				Simd::Matrix44::IDENTITY,
+				Simd::Vector2( 0.0f, 0.0f ),
+				Simd::Vector2( 1.0f, 1.0f ),
+				Color( 0xffffffff ),
+				rasterizerState );
+		}
+
+		/// Render frames of sprites in runs of alternating textures, checking batching and buffer reuse each frame.
+		///
+		/// @param[in] spriteCount  Number of sprites submitted each frame.
+		/// @param[in] frameCount   Number of frames to render.
+		///
+		/// @return  Number of draw calls expected each frame.
+		size_t RunStressScene( size_t spriteCount, size_t frameCount )
+		{
+			size_t expectedDrawCount = 0;
+			for( size_t textureIndex = 0; textureIndex < TEXTURE_COUNT; ++textureIndex )
+			{
+				size_t textureSpriteCount = 0;
+				for( size_t spriteIndex = 0; spriteIndex < spriteCount; ++spriteIndex )
+				{
+					if( ( spriteIndex / STRESS_SPRITE_RUN_LENGTH ) % TEXTURE_COUNT == textureIndex )
+					{
+						++textureSpriteCount;
+					}
+				}
+
+				expectedDrawCount +=
+					( textureSpriteCount + BufferedDrawer::SPRITE_DRAW_SIZE_MAX - 1 ) / BufferedDrawer::SPRITE_DRAW_SIZE_MAX;
+			}
+
+			for( size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+			{
+				m_pRenderer->ResetStatistics();
+
+				uint64_t startTicks = Timer::GetTickCount();
+
+				for( size_t spriteIndex = 0; spriteIndex < spriteCount; ++spriteIndex )
+				{
+					DrawSprite( ( spriteIndex / STRESS_SPRITE_RUN_LENGTH ) % TEXTURE_COUNT );
+				}
+
+				m_submitTicks += Timer::GetTickCount() - startTicks;
+				startTicks = Timer::GetTickCount();
+
+				m_drawer.BeginDrawing();
+
+				m_prepareTicks += Timer::GetTickCount() - startTicks;
+
+				EXPECT_EQ( spriteCount, m_drawer.GetSpriteCount() );
+				EXPECT_EQ( expectedDrawCount, m_drawer.GetSpriteDrawCount() );
+
+				// Each resource set creates its sprite vertex buffer once; later frames only upload the sprite vertices.
+				NullRenderer::Statistics statistics;
+				m_pRenderer->GetStatistics( statistics );
+				if( frameIndex >= 2 )
+				{
+					EXPECT_EQ( 0u, statistics.resourceCreateCount );
+				}
+
+				EXPECT_EQ( spriteCount * 4 * sizeof( SimpleTexturedVertex ), statistics.uploadedBytes );
+
+				m_drawer.EndDrawing();
+			}
+
+			return expectedDrawCount;
+		}
+
+		NullRenderer* m_pRenderer;
+		RTexture2dPtr m_spTextures[ TEXTURE_COUNT ];
+		BufferedDrawer m_drawer;
+
+		uint64_t m_submitTicks;
+		uint64_t m_prepareTicks;
+	};
+}
+
+TEST_F( BufferedDrawerSpriteTest, BatchesSpritesByTextureAndState )
+{
+	// Interleave textures so that batches are found by search rather than by the last-used batch.
+	for( size_t spriteIndex = 0; spriteIndex < 30; ++spriteIndex )
+	{
+		DrawSprite( spriteIndex % 3 );
+	}
+
+	DrawSprite( 0, RenderResourceManager::RASTERIZER_STATE_DEFAULT );
+
+	m_drawer.BeginDrawing();
+
+	EXPECT_EQ( 31u, m_drawer.GetSpriteCount() );
+	EXPECT_EQ( 4u, m_drawer.GetSpriteDrawCount() );
+
+	NullRenderer::Statistics statistics;
+	m_pRenderer->GetStatistics( statistics );
+	EXPECT_EQ( 1u, statistics.resourceCreateCount );
+	EXPECT_EQ( 31u * 4u * sizeof( SimpleTexturedVertex ), statistics.uploadedBytes );
+
+	m_drawer.EndDrawing();
+
+	// Batches are released at the end of the frame.
+	m_drawer.BeginDrawing();
+	EXPECT_EQ( 0u, m_drawer.GetSpriteCount() );
+	EXPECT_EQ( 0u, m_drawer.GetSpriteDrawCount() );
+	m_drawer.EndDrawing();
+}
+
+TEST_F( BufferedDrawerSpriteTest, SplitsBatchesAtIndexRange )
+{
+	size_t spriteCount = BufferedDrawer::SPRITE_DRAW_SIZE_MAX * 2 + 1;
+	for( size_t spriteIndex = 0; spriteIndex < spriteCount; ++spriteIndex )
+	{
+		DrawSprite( 0 );
+	}
+
+	m_drawer.BeginDrawing();
+
+	EXPECT_EQ( spriteCount, m_drawer.GetSpriteCount() );
+	EXPECT_EQ( 3u, m_drawer.GetSpriteDrawCount() );
+
+	m_drawer.EndDrawing();
+}
+
+TEST_F( BufferedDrawerSpriteTest, StressSceneReusesBuffers )
+{
+	RunStressScene( STRESS_SPRITE_COUNT, STRESS_FRAME_COUNT );
+}
+
+// Timing run, skipped by default.  Use --gtest_also_run_disabled_tests to run it.
+TEST_F( BufferedDrawerSpriteTest, DISABLED_BenchmarkStressScene )
+{
+	size_t drawCount = RunStressScene( BENCHMARK_SPRITE_COUNT, BENCHMARK_FRAME_COUNT );
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		"BufferedDrawer sprites, %" PRIuSZ " sprites x %" PRIuSZ " frames, %" PRIuSZ " draws per frame: "
+		"submit %.2f ms, prepare %.2f ms\n",
+		BENCHMARK_SPRITE_COUNT,
+		BENCHMARK_FRAME_COUNT,
+		drawCount,
+		static_cast< float64_t >( Timer::TicksToMilliseconds( m_submitTicks ) ),
+		static_cast< float64_t >( Timer::TicksToMilliseconds( m_prepareTicks ) ) );
+}
@@ -19,6 +19,9 @@ GraphicsConfig::GraphicsConfig()
 , m_shadowBufferSize( DEFAULT_SHADOW_BUFFER_SIZE )
 , m_bFullscreen( false )
 , m_bVsync( true )
+, m_bTextureStreaming( false )
+, m_textureStreamingBudget( DEFAULT_TEXTURE_STREAMING_BUDGET )
+, m_textureStreamingInitialSize( DEFAULT_TEXTURE_STREAMING_INITIAL_SIZE )
 {
 }
 
@@ -37,4 +40,7 @@ void GraphicsConfig::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &GraphicsConfig::m_maxAnisotropy, "m_MaxAnisotropy" );
     comp.AddField( &GraphicsConfig::m_shadowMode, "m_ShadowMode" );
     comp.AddField( &GraphicsConfig::m_shadowBufferSize, "m_ShadowBufferSize" );
+    comp.AddField( &GraphicsConfig::m_bTextureStreaming, "m_bTextureStreaming" );
+    comp.AddField( &GraphicsConfig::m_textureStreamingBudget, "m_TextureStreamingBudget" );
+    comp.AddField( &GraphicsConfig::m_textureStreamingInitialSize, "m_TextureStreamingInitialSize" );
 }
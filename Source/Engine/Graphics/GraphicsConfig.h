@@ -62,6 +62,11 @@ namespace Helium
         /// Default shadow buffer size.
         static const uint32_t DEFAULT_SHADOW_BUFFER_SIZE = 1024;
 
+        /// Default texture streaming memory budget, in megabytes.
+        static const uint32_t DEFAULT_TEXTURE_STREAMING_BUDGET = 256;
+        /// Default maximum width/height of the largest mip level loaded initially for streamed textures.
+        static const uint32_t DEFAULT_TEXTURE_STREAMING_INITIAL_SIZE = 64;
+
         /// @name Construction/Destruction
         //@{
         GraphicsConfig();
@@ -83,6 +88,10 @@ namespace Helium
 
         inline bool GetFullscreen() const;
         inline bool GetVsync() const;
+
+        inline bool GetTextureStreaming() const;
+        inline uint32_t GetTextureStreamingBudget() const;
+        inline uint32_t GetTextureStreamingInitialSize() const;
         //@}
 
     public:
@@ -105,6 +114,13 @@ namespace Helium
         bool m_bFullscreen;
         /// True to enable vsync.
         bool m_bVsync;
+
+        /// True to stream texture mip levels based on their on-screen size, false to load all mip levels up front.
+        bool m_bTextureStreaming;
+        /// Memory budget for streamed texture mip levels, in megabytes.
+        uint32_t m_textureStreamingBudget;
+        /// Maximum width/height of the largest mip level loaded initially for streamed textures.
+        uint32_t m_textureStreamingInitialSize;
     };
 }
 
@@ -67,4 +67,28 @@ namespace Helium
     {
         return m_bVsync;
     }
+
+    /// Get whether texture mip level streaming is enabled.
+    ///
+    /// @return  True if texture streaming is enabled, false if all texture mip levels are loaded up front.
+    bool GraphicsConfig::GetTextureStreaming() const
+    {
+        return m_bTextureStreaming;
+    }
+
+    /// Get the memory budget for streamed texture mip levels.
+    ///
+    /// @return  Texture streaming budget, in megabytes.
+    uint32_t GraphicsConfig::GetTextureStreamingBudget() const
+    {
+        return m_textureStreamingBudget;
+    }
+
+    /// Get the maximum size of the largest mip level loaded initially for streamed textures.
+    ///
+    /// @return  Maximum initial mip level width/height, in texels.
+    uint32_t GraphicsConfig::GetTextureStreamingInitialSize() const
+    {
+        return m_textureStreamingInitialSize;
+    }
 }
@@ -3,6 +3,7 @@
 #include "Graphics/GraphicsManagerComponent.h"
 #include "Graphics/GraphicsScene.h"
 #include "Graphics/RenderResourceManager.h"
+#include "Graphics/TextureStreamer.h"
 #include "Rendering/Renderer.h"
 #include "Framework/TaskScheduler.h"
 #include "Framework/World.h"
@@ -84,4 +85,25 @@ HELIUM_DEFINE_TASK( GraphicsManagerDrawTask, ForEachWorld< DrawGraphics >, TickT
 void Helium::GraphicsManagerDrawTask::DefineContract( TaskContract &rContract )
 {
 	rContract.ExecutesWithin< Helium::StandardDependencies::Render >();
-}
\ No newline at end of file
+	rContract.ExecuteOnMainThread();
+}
+
+void UpdateTextureStreamer( DynamicArray< WorldPtr > &rWorlds )
+{
+	TextureStreamer* pTextureStreamer = TextureStreamer::GetInstance();
+	if ( pTextureStreamer && pTextureStreamer->IsEnabled() )
+	{
+		pTextureStreamer->Update();
+	}
+}
+
+// Runs once per frame rather than once per world so that the streaming budget is applied a single time, after every
+// scene has requested the mip levels it needs and finished recording its views.
+HELIUM_DEFINE_TASK( TextureStreamerUpdateTask, UpdateTextureStreamer, TickTypes::Client )
+
+void Helium::TextureStreamerUpdateTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteAfter< Helium::GraphicsManagerDrawTask >();
+	rContract.ExecutesWithin< Helium::StandardDependencies::Render >();
+	rContract.ExecuteOnMainThread();
+}
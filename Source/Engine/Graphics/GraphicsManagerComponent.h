@@ -52,6 +52,12 @@ namespace Helium
 		HELIUM_DECLARE_TASK(GraphicsManagerDrawTask)
 		virtual void DefineContract(TaskContract &rContract);
 	};
+
+	struct HELIUM_GRAPHICS_API TextureStreamerUpdateTask : public TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(TextureStreamerUpdateTask)
+		virtual void DefineContract(TaskContract &rContract);
+	};
 }
 
 #include "Graphics/GraphicsManagerComponent.inl"
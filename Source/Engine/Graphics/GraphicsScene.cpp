@@ -5,6 +5,7 @@
 #include "MathSimd/Vector3Soa.h"
 #include "MathSimd/VectorConversion.h"
 #include "EngineJobs/EngineJobsInterface.h"
+#include "EngineJobs/JobManager.h"
 #include "Rendering/RConstantBuffer.h"
 #include "Rendering/RIndexBuffer.h"
 #include "Rendering/RPixelShader.h"
@@ -20,12 +21,14 @@
 #include "Graphics/DynamicDrawer.h"
 #include "Graphics/Material.h"
 #include "Graphics/RenderResourceManager.h"
-#include "Graphics/Texture.h"
+#include "Graphics/Texture2d.h"
+#include "Graphics/TextureStreamer.h"
 #include "Framework/World.h"
 #include "Framework/Entity.h"
 #include "Framework/Slice.h"
 #include "Framework/EntityDefinition.h"
 #include "Framework/WorldDefinition.h"
+#include "Framework/WorldManager.h"
 
 HELIUM_DEFINE_CLASS( Helium::GraphicsScene );
 
@@ -37,9 +40,69 @@ HELIUM_DEFINE_COMPONENT( Helium::SceneObjectTransform, 32 );
 static const size_t SCENE_VIEW_BUFFERED_DRAWER_POOL_BLOCK_SIZE = 4;
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
-namespace Helium
+/// Number of scene objects sharing each visibility mask (scene object bounds arrays are padded to a multiple of this).
+static const size_t SCENE_OBJECT_VISIBILITY_MASK_BITS = 32;
+
+/// Sub-mesh draw key pass identifiers.
+static const uint64_t DRAW_KEY_PASS_SHADOW_DEPTH = 0;
+static const uint64_t DRAW_KEY_PASS_DEPTH_PRE = 1;
+static const uint64_t DRAW_KEY_PASS_BASE = 2;
+
+/// Bit offset of the pass identifier within each sub-mesh draw key.
+static const uint32_t DRAW_KEY_PASS_SHIFT = 60;
+/// Bit offset of the vertex shader variant rank within base pass draw keys.
+static const uint32_t DRAW_KEY_VERTEX_VARIANT_SHIFT = 50;
+/// Bit offset of the pixel shader variant rank within base pass draw keys.
+static const uint32_t DRAW_KEY_PIXEL_VARIANT_SHIFT = 40;
+/// Bit offset of the material rank within base pass draw keys.
+static const uint32_t DRAW_KEY_MATERIAL_SHIFT = 28;
+/// Bit offset of the mesh buffer rank within base pass draw keys.
+static const uint32_t DRAW_KEY_MESH_SHIFT = 16;
+/// Bit offset of the mesh buffer rank within shadow depth pass draw keys.
+static const uint32_t DRAW_KEY_SHADOW_DEPTH_MESH_SHIFT = 32;
+/// Largest shader variant rank stored in base pass draw keys (any further variants share this rank).  Materials
+/// rarely outnumber the variants they select, so variants get the narrowest fields.
+static const uint32_t DRAW_KEY_VARIANT_RANK_MAX = 0x3ff;
+/// Largest material or mesh buffer rank stored in draw keys (any further states share this rank).
+static const uint32_t DRAW_KEY_STATE_RANK_MAX = 0xfff;
+/// Number of low depth bits dropped to fit the depth into the bottom of base pass draw keys.  The remaining 16 bits
+/// keep the sign, the full exponent, and the top seven mantissa bits, so sub-meshes sharing the same state are still
+/// ordered front to back to within 1% of their distance.
+static const uint32_t DRAW_KEY_BASE_PASS_DEPTH_DROPPED_BITS = 16;
+
+/// Minimum number of sub-mesh draw keys to sort within each job.
+static const size_t DRAW_KEY_SORT_SINGLE_JOB_COUNT = 1024;
+
+/// Render pass recording job data.
+struct RecordRenderPassJobData
 {
-	HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+	/// Scene being rendered.
+	GraphicsScene* pScene;
+	/// Index of the view being rendered.
+	uint32_t viewIndex;
+	/// Render pass to record (GraphicsScene::ERenderPass value).
+	uint32_t pass;
+};
+
+/// Convert a depth value to an unsigned integer whose ordering matches that of the original values.
+///
+/// @param[in] depth  Depth value.
+///
+/// @return  Draw key depth bits.
+static uint32_t GetDrawKeyDepth( float32_t depth )
+{
+	union
+	{
+		float32_t floatValue;
+		uint32_t bits;
+	} depthBits;
+	depthBits.floatValue = depth;
+
+	// Positive values sort correctly once the sign bit is set, while negative values need every bit flipped so that
+	// larger magnitudes sort first.
+	uint32_t bits = depthBits.bits;
+
+	return ( ( bits & 0x80000000 ) ? ~bits : ( bits | 0x80000000 ) );
 }
 
 /// Constructor.
@@ -56,6 +119,7 @@ GraphicsScene::GraphicsScene()
 	, m_directionalLightDirection( 0.0f, -1.0f, 0.0f )
 	, m_directionalLightColor( 0xffffffff )
 	, m_directionalLightBrightness( 1.0f )
+	, m_bSpatialCulling( false )
 	, m_activeViewId( Invalid< uint32_t >() )
 	, m_constantBufferSetIndex( 0 )
 {
@@ -129,29 +193,26 @@ void GraphicsScene::Update( World *pWorld )
 	}
 
 	// Update each scene object as necessary.
-	size_t sceneObjectCount = m_sceneObjects.GetSize();
-	//for( size_t objectIndex = 0; objectIndex < sceneObjectCount; ++objectIndex )
-	//{
-	//    if( !m_sceneObjects.IsElementValid( objectIndex ) )
-	//    {
-	//        continue;
-	//    }
-
-	//    m_sceneObjects[ objectIndex ].ConditionalUpdate( this );
-	//}
-
 	for ( ImplementingComponentIterator<SceneObjectTransform> iter( *pWorld->m_ComponentManager ); *iter; iter.Advance() )
 	{
 		iter->GraphicsSceneObjectUpdate( this );
 	}
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+	// Sample the animations of skinned objects so that their bone palettes are ready for the constant buffer update.
+	WorldManager* pWorldManager = WorldManager::GetInstance();
+	UpdateSceneObjectAnimations( pWorldManager ? pWorldManager->GetFrameDeltaSeconds() : 0.0f );
+#endif
+
+	// Refit the scene object hierarchy to any bounds changed by the object updates.
+	if ( m_bSpatialCulling )
+	{
+		m_sceneObjectBvh.Update();
+	}
+
 	// Swap dynamic constant buffers and update their contents.
 	SwapDynamicConstantBuffers();
 
-	// Resize the visible object bit array as necessary.
-	m_visibleSceneObjects.Reserve( sceneObjectCount );
-	m_visibleSceneObjects.Resize( sceneObjectCount );
-
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 	// Set up the scene's buffered drawer for the current frame.
 	m_sceneBufferedDrawer.BeginDrawing();
@@ -262,7 +323,32 @@ size_t GraphicsScene::AllocateSceneObject()
 	GraphicsSceneObject* pSceneObject = m_sceneObjects.New();
 	HELIUM_ASSERT( pSceneObject );
 
-	return m_sceneObjects.GetElementIndex( pSceneObject );
+	size_t id = m_sceneObjects.GetElementIndex( pSceneObject );
+
+	// Grow the culling bounds arrays in whole visibility masks, filling new slots with bounds that are never visible.
+	size_t boundsCount = m_sceneObjectBoundsRadius.GetSize();
+	if ( id >= boundsCount )
+	{
+		size_t newBoundsCount =
+			( id + SCENE_OBJECT_VISIBILITY_MASK_BITS ) & ~( SCENE_OBJECT_VISIBILITY_MASK_BITS - 1 );
+		m_sceneObjectBoundsX.Resize( newBoundsCount );
+		m_sceneObjectBoundsY.Resize( newBoundsCount );
+		m_sceneObjectBoundsZ.Resize( newBoundsCount );
+		m_sceneObjectBoundsRadius.Resize( newBoundsCount );
+
+		for ( size_t boundsIndex = boundsCount; boundsIndex < newBoundsCount; ++boundsIndex )
+		{
+			m_sceneObjectBoundsX[boundsIndex] = 0.0f;
+			m_sceneObjectBoundsY[boundsIndex] = 0.0f;
+			m_sceneObjectBoundsZ[boundsIndex] = 0.0f;
+			m_sceneObjectBoundsRadius[boundsIndex] = -1.0f;
+		}
+	}
+
+	// Objects are not visible until their bounds have been set.
+	m_sceneObjectBoundsRadius[id] = -1.0f;
+
+	return id;
 }
 
 /// Detach and release a previously allocated scene object.
@@ -276,7 +362,213 @@ void GraphicsScene::ReleaseSceneObject( size_t id )
 	HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
 
 	m_sceneObjects.Remove( id );
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+	ClearSceneObjectAnimation( id );
+#endif
+
+	HELIUM_ASSERT( id < m_sceneObjectBoundsRadius.GetSize() );
+	m_sceneObjectBoundsRadius[id] = -1.0f;
+
+	if ( m_bSpatialCulling )
+	{
+		m_sceneObjectBvh.RemoveObject( id );
+	}
+}
+
+/// Set the world-space bounds of a scene object.
+///
+/// This updates both the scene object and the copy of its bounding sphere used for visibility culling, so scene
+/// object bounds should always be set through this function instead of GraphicsSceneObject::SetWorldBounds().
+///
+/// @param[in] id    ID of the scene object to update.
+/// @param[in] rBox  World-space axis-aligned bounding box to set.
+///
+/// @see AllocateSceneObject(), GetSceneObject()
+void GraphicsScene::SetSceneObjectWorldBounds( size_t id, const Simd::AaBox& rBox )
+{
+	HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+	HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
+	HELIUM_ASSERT( id < m_sceneObjectBoundsRadius.GetSize() );
+
+	GraphicsSceneObject& rSceneObject = m_sceneObjects[id];
+	rSceneObject.SetWorldBounds( rBox );
+
+	const Simd::Sphere& rSphere = rSceneObject.GetWorldSphere();
+	m_sceneObjectBoundsX[id] = rSphere.GetElement( 0 );
+	m_sceneObjectBoundsY[id] = rSphere.GetElement( 1 );
+	m_sceneObjectBoundsZ[id] = rSphere.GetElement( 2 );
+	m_sceneObjectBoundsRadius[id] = rSphere.GetElement( 3 );
+
+	if ( m_bSpatialCulling )
+	{
+		m_sceneObjectBvh.SetObjectBounds( id, rBox );
+	}
+}
+
+/// Set whether scene objects should be culled using a bounding volume hierarchy.
+///
+/// When enabled, the scene maintains a hierarchy over the scene object bounds that is refit each Update() to the
+/// objects whose bounds changed.  Culling a view or shadow view then skips entire groups of objects that lie fully
+/// inside or outside the view frustum, which is considerably cheaper than testing every object for scenes where
+/// most objects are static.  When disabled, every object is tested against each frustum.
+///
+/// @param[in] bEnabled  True to enable spatial culling, false to disable it.
+///
+/// @see IsSpatialCullingEnabled(), GetSceneObjectBvh()
+void GraphicsScene::SetSpatialCullingEnabled( bool bEnabled )
+{
+	if ( bEnabled == m_bSpatialCulling )
+	{
+		return;
+	}
+
+	m_bSpatialCulling = bEnabled;
+	m_sceneObjectBvh.Clear();
+
+	if ( bEnabled )
+	{
+		// Add every object that already has its bounds set.
+		size_t sceneObjectCount = m_sceneObjects.GetSize();
+		for ( size_t sceneObjectIndex = 0; sceneObjectIndex < sceneObjectCount; ++sceneObjectIndex )
+		{
+			if ( m_sceneObjects.IsElementValid( sceneObjectIndex ) &&
+				m_sceneObjectBoundsRadius[sceneObjectIndex] >= 0.0f )
+			{
+				m_sceneObjectBvh.SetObjectBounds( sceneObjectIndex, m_sceneObjects[sceneObjectIndex].GetWorldBox() );
+			}
+		}
+
+		m_sceneObjectBvh.Update();
+	}
+}
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+/// Play an animation on a skinned scene object.
+///
+/// The animation is sampled each Update(), and the resulting bone palette is assigned to the scene object before its
+/// sub-mesh constant buffers are filled.  Setting the animation already playing on the object has no effect.
+///
+/// @param[in] id            ID of the scene object to animate.
+/// @param[in] pMesh         Skinned mesh rendered by the scene object.
+/// @param[in] pAnimation    Animation to play, or null to hold the reference pose.
+/// @param[in] blendSeconds  Time over which to blend from the animation currently playing, in seconds.
+///
+/// @see ClearSceneObjectAnimation()
+void GraphicsScene::SetSceneObjectAnimation( size_t id, Mesh* pMesh, Animation* pAnimation, float32_t blendSeconds )
+{
+	HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+	HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
+
+	if ( !pMesh || pMesh->GetBoneCount() == 0 )
+	{
+		ClearSceneObjectAnimation( id );
+
+		return;
+	}
+
+	if ( m_sceneObjectAnimationIndices.GetSize() <= id )
+	{
+		size_t oldCount = m_sceneObjectAnimationIndices.GetSize();
+		m_sceneObjectAnimationIndices.Resize( id + 1 );
+		for ( size_t objectIndex = oldCount; objectIndex <= id; ++objectIndex )
+		{
+			SetInvalid( m_sceneObjectAnimationIndices[objectIndex] );
+		}
+	}
+
+	size_t animationIndex = m_sceneObjectAnimationIndices[id];
+	if ( IsInvalid( animationIndex ) )
+	{
+		animationIndex = m_sceneObjectAnimations.GetSize();
+		m_sceneObjectAnimationIndices[id] = animationIndex;
+
+		SceneObjectAnimation* pState = m_sceneObjectAnimations.New();
+		HELIUM_ASSERT( pState );
+		pState->sceneObjectId = id;
+		pState->time = 0.0f;
+		pState->previousTime = 0.0f;
+		pState->blendTime = 0.0f;
+		pState->blendDuration = 0.0f;
+	}
+
+	SceneObjectAnimation& rState = m_sceneObjectAnimations[animationIndex];
+	if ( rState.spMesh.Get() != pMesh )
+	{
+		// A new mesh invalidates every track map, so restart playback without blending.
+		rState.spMesh = pMesh;
+		rState.spAnimation = pAnimation;
+		rState.spPreviousAnimation.Release();
+		rState.time = 0.0f;
+		rState.blendDuration = 0.0f;
+		AnimationSampler::BuildTrackMap( pMesh, pAnimation, rState.trackMap );
+		rState.previousTrackMap.Resize( 0 );
+		rState.bonePalette.Resize( pMesh->GetBoneCount() );
+
+		return;
+	}
+
+	if ( rState.spAnimation.Get() == pAnimation )
+	{
+		return;
+	}
+
+	if ( blendSeconds > 0.0f && rState.spAnimation )
+	{
+		rState.spPreviousAnimation = rState.spAnimation;
+		rState.previousTrackMap.Swap( rState.trackMap );
+		rState.previousTime = rState.time;
+		rState.blendTime = 0.0f;
+		rState.blendDuration = blendSeconds;
+	}
+	else
+	{
+		rState.spPreviousAnimation.Release();
+		rState.blendDuration = 0.0f;
+	}
+
+	rState.spAnimation = pAnimation;
+	rState.time = 0.0f;
+	AnimationSampler::BuildTrackMap( pMesh, pAnimation, rState.trackMap );
+}
+
+/// Stop animating a scene object.
+///
+/// The scene object's bone palette is cleared, so its skinned sub-meshes are no longer drawn until a new palette is
+/// set.
+///
+/// @param[in] id  ID of the scene object.
+///
+/// @see SetSceneObjectAnimation()
+void GraphicsScene::ClearSceneObjectAnimation( size_t id )
+{
+	if ( id >= m_sceneObjectAnimationIndices.GetSize() )
+	{
+		return;
+	}
+
+	size_t animationIndex = m_sceneObjectAnimationIndices[id];
+	if ( IsInvalid( animationIndex ) )
+	{
+		return;
+	}
+
+	SetInvalid( m_sceneObjectAnimationIndices[id] );
+
+	size_t lastIndex = m_sceneObjectAnimations.GetSize() - 1;
+	if ( animationIndex != lastIndex )
+	{
+		m_sceneObjectAnimationIndices[m_sceneObjectAnimations[lastIndex].sceneObjectId] = animationIndex;
+	}
+
+	m_sceneObjectAnimations.RemoveSwap( animationIndex );
+
+	if ( m_sceneObjects.IsElementValid( id ) )
+	{
+		m_sceneObjects[id].SetBonePalette( NULL );
+	}
 }
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
 
 /// Allocate new scene object sub-mesh data and add it to the scene.
 ///
@@ -426,6 +718,84 @@ Name GraphicsScene::GetShadowMapTextureName()
 	return shadowMapTextureName;
 }
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+/// Advance the animation of each animated scene object and evaluate their bone palettes.
+///
+/// @param[in] deltaSeconds  Time elapsed since the last update, in seconds.
+void GraphicsScene::UpdateSceneObjectAnimations( float32_t deltaSeconds )
+{
+	size_t animationCount = m_sceneObjectAnimations.GetSize();
+	if ( animationCount == 0 )
+	{
+		return;
+	}
+
+	m_animationSkeletons.Resize( animationCount );
+
+	for ( size_t animationIndex = 0; animationIndex < animationCount; ++animationIndex )
+	{
+		SceneObjectAnimation& rState = m_sceneObjectAnimations[animationIndex];
+		HELIUM_ASSERT( m_sceneObjects.IsElementValid( rState.sceneObjectId ) );
+
+		rState.time += deltaSeconds;
+		if ( rState.spPreviousAnimation )
+		{
+			rState.previousTime += deltaSeconds;
+			rState.blendTime += deltaSeconds;
+			if ( rState.blendTime >= rState.blendDuration )
+			{
+				rState.spPreviousAnimation.Release();
+				rState.previousTrackMap.Resize( 0 );
+			}
+		}
+
+		// Keep the playback time within the clip length so that precision does not degrade over long sessions.
+		if ( rState.spAnimation )
+		{
+			float32_t duration = rState.spAnimation->GetDuration();
+			if ( duration > 0.0f && rState.time >= duration )
+			{
+				rState.time -= duration * static_cast< float32_t >( static_cast< int64_t >( rState.time / duration ) );
+			}
+		}
+
+		AnimationSampler::Skeleton& rSkeleton = m_animationSkeletons[animationIndex];
+		rSkeleton.pMesh = rState.spMesh;
+		rSkeleton.pTransform = &m_sceneObjects[rState.sceneObjectId].GetTransform();
+		rSkeleton.pBonePalette = rState.bonePalette.GetData();
+
+		AnimationSampler::Layer& rCurrentLayer = rSkeleton.layers[0];
+		rCurrentLayer.pAnimation = rState.spAnimation;
+		rCurrentLayer.pTrackMap = rState.trackMap.GetData();
+		rCurrentLayer.time = rState.time;
+		rCurrentLayer.weight = 1.0f;
+		rSkeleton.layerCount = 1;
+
+		if ( rState.spPreviousAnimation )
+		{
+			float32_t blend = Clamp( rState.blendTime / rState.blendDuration, 0.0f, 1.0f );
+			rCurrentLayer.weight = blend;
+
+			AnimationSampler::Layer& rPreviousLayer = rSkeleton.layers[1];
+			rPreviousLayer.pAnimation = rState.spPreviousAnimation;
+			rPreviousLayer.pTrackMap = rState.previousTrackMap.GetData();
+			rPreviousLayer.time = rState.previousTime;
+			rPreviousLayer.weight = 1.0f - blend;
+			rSkeleton.layerCount = 2;
+		}
+	}
+
+	AnimationSampler::Evaluate( m_animationSkeletons.GetData(), animationCount );
+
+	// Palettes are reassigned every frame, as growing the animation state array may have moved them.
+	for ( size_t animationIndex = 0; animationIndex < animationCount; ++animationIndex )
+	{
+		SceneObjectAnimation& rState = m_sceneObjectAnimations[animationIndex];
+		m_sceneObjects[rState.sceneObjectId].SetBonePalette( rState.bonePalette.GetData() );
+	}
+}
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
+
 /// Update the shadow depth pass inverse view/projection matrix for a given scene view.
 ///
 /// @param[in] viewIndex  Index of the scene view for which to update the shadow depth pass transform matrix.
@@ -1124,54 +1494,58 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 	}
 }
 
-/// Render the specified scene view.
+/// Test the bounds of every scene object against a frustum, storing the results in the visible scene object masks.
 ///
-/// @param[in] viewIndex  Index of the scene view to render (can be an invalid element, but must be less than the size
-///                       of the scene view sparse array).
-void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
+/// Bounding spheres are tested four at a time from the struct-of-arrays copies maintained by
+/// SetSceneObjectWorldBounds(), split across the job workers in blocks of whole visibility masks.
+///
+/// @param[in] rFrustum  Frustum against which to test.
+///
+/// @see IsSceneObjectVisible()
+void GraphicsScene::CullSceneObjects( const Simd::Frustum& rFrustum )
 {
-	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+	size_t boundsCount = m_sceneObjectBoundsRadius.GetSize();
+	HELIUM_ASSERT( ( boundsCount % SCENE_OBJECT_VISIBILITY_MASK_BITS ) == 0 );
 
-	if ( !m_sceneViews.IsElementValid( viewIndex ) )
+	m_visibleSceneObjectMasks.Resize( boundsCount / SCENE_OBJECT_VISIBILITY_MASK_BITS );
+	if ( boundsCount == 0 )
 	{
 		return;
 	}
 
-	RConstantBuffer* pViewVertexGlobalDataBuffer =
-		m_viewVertexGlobalDataBuffers[m_constantBufferSetIndex][viewIndex];
-	if ( !pViewVertexGlobalDataBuffer )
+	if ( m_bSpatialCulling )
 	{
-		return;
-	}
+		m_sceneObjectBvh.QueryFrustum(
+			rFrustum,
+			m_visibleSceneObjectMasks.GetData(),
+			m_visibleSceneObjectMasks.GetSize() );
 
-	GraphicsSceneView& rView = m_sceneViews[viewIndex];
-	RRenderContext* pRenderContext = rView.GetRenderContext();
-	if ( !pRenderContext )
-	{
 		return;
 	}
 
-	// Determine which scene objects are visible in the current view.
-	m_visibleSceneObjects.UnsetAll();
-
-	const Simd::Frustum& rViewFrustum = rView.GetFrustum();
+	CullGraphicsSceneObjectsJobSpawner job;
+	CullGraphicsSceneObjectsJobSpawner::Parameters& rParameters = job.GetParameters();
+	rParameters.pFrustum = &rFrustum;
+	rParameters.sceneObjectCount = static_cast<uint32_t>( boundsCount );
+	rParameters.pCentersX = m_sceneObjectBoundsX.GetData();
+	rParameters.pCentersY = m_sceneObjectBoundsY.GetData();
+	rParameters.pCentersZ = m_sceneObjectBoundsZ.GetData();
+	rParameters.pRadii = m_sceneObjectBoundsRadius.GetData();
+	rParameters.pVisibilityMasks = m_visibleSceneObjectMasks.GetData();
+	job.Run();
+}
 
-	size_t sceneObjectCount = m_sceneObjects.GetSize();
-	for ( size_t sceneObjectIndex = 0; sceneObjectIndex < sceneObjectCount; ++sceneObjectIndex )
-	{
-		if ( m_sceneObjects.IsElementValid( sceneObjectIndex ) )
-		{
-			//const AaBox& rObjectBounds = m_sceneObjects[ sceneObjectIndex ].GetWorldBox();
-			const Simd::Sphere& rObjectBounds = m_sceneObjects[sceneObjectIndex].GetWorldSphere();
-			if ( rViewFrustum.Intersects( rObjectBounds ) )
-			{
-				m_visibleSceneObjects.SetElement( sceneObjectIndex );
-			}
-		}
-	}
+/// Build the list of sub-meshes belonging to scene objects that intersect a frustum.
+///
+/// @param[in]  rFrustum         Frustum against which to cull.
+/// @param[out] rSubMeshIndices  Array in which to store the (unsorted) indices of each visible sub-mesh.
+///
+/// @see CullSceneObjects()
+void GraphicsScene::BuildVisibleSubMeshList( const Simd::Frustum& rFrustum, DynamicArray< size_t >& rSubMeshIndices )
+{
+	CullSceneObjects( rFrustum );
 
-	// Build a list of indices for each visible sub-mesh for sorting.
-	m_sceneObjectSubMeshIndices.Resize( 0 );
+	rSubMeshIndices.Resize( 0 );
 
 	size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
 	for ( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
@@ -1179,70 +1553,661 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 		if ( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
 		{
 			size_t sceneObjectId = m_sceneObjectSubMeshes[subMeshIndex].GetSceneObjectId();
-			HELIUM_ASSERT( sceneObjectId < m_visibleSceneObjects.GetSize() );
-			if ( m_visibleSceneObjects[sceneObjectId] )
+			if ( IsSceneObjectVisible( sceneObjectId ) )
 			{
-				m_sceneObjectSubMeshIndices.Push( subMeshIndex );
+				rSubMeshIndices.Push( subMeshIndex );
 			}
 		}
 	}
+}
 
-	// Get the renderer interface and the main command proxy for the renderer.
-	Renderer* pRenderer = Renderer::GetInstance();
-	HELIUM_ASSERT( pRenderer );
+/// Request the texture mip levels needed to draw a list of visible sub-meshes from the texture streamer.
+///
+/// The on-screen size of each sub-mesh is approximated by the projected diameter of its scene object's bounding
+/// sphere, and each 2D texture used by its material is assumed to be mapped once across that area.
+///
+/// @param[in] rView            Scene view in which the sub-meshes are visible.
+/// @param[in] rSubMeshIndices  Indices of the visible sub-meshes.
+///
+/// @see BuildVisibleSubMeshList()
+void GraphicsScene::RequestTextureMipLevels( const GraphicsSceneView& rView, const DynamicArray< size_t >& rSubMeshIndices )
+{
+	TextureStreamer* pTextureStreamer = TextureStreamer::GetInstance();
+	if ( !pTextureStreamer || !pTextureStreamer->IsEnabled() )
+	{
+		return;
+	}
 
-	RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
-	HELIUM_ASSERT( spCommandProxy );
+	const Simd::Vector3& rOrigin = rView.GetOrigin();
+	float32_t originX = rOrigin.GetElement( 0 );
+	float32_t originY = rOrigin.GetElement( 1 );
+	float32_t originZ = rOrigin.GetElement( 2 );
 
-	RenderResourceManager* pRenderResourceManager = RenderResourceManager::GetInstance();
-	HELIUM_ASSERT( pRenderResourceManager );
+	// Scale from a bounding sphere radius divided by its distance to its projected diameter in pixels.
+	float32_t projectionScale =
+		rView.GetProjectionMatrix().GetElement( 0 ) * static_cast< float32_t >( rView.GetViewportWidth() );
+	float32_t sizeMax = static_cast< float32_t >( Max( rView.GetViewportWidth(), rView.GetViewportHeight() ) );
 
-	// Get the state objects that we will use during rendering.
-	RRasterizerState* pRasterizerStateDefault = pRenderResourceManager->GetRasterizerState(
-		RenderResourceManager::RASTERIZER_STATE_DEFAULT );
-	RBlendState* pBlendStateOpaque = pRenderResourceManager->GetBlendState( RenderResourceManager::BLEND_STATE_OPAQUE );
-	RDepthStencilState* pDepthStateDefault = pRenderResourceManager->GetDepthStencilState(
-		RenderResourceManager::DEPTH_STENCIL_STATE_DEFAULT );
-	RDepthStencilState* pDepthStateNone = pRenderResourceManager->GetDepthStencilState(
-		RenderResourceManager::DEPTH_STENCIL_STATE_NONE );
-	RSamplerState* pSamplerStatePointClamp = pRenderResourceManager->GetSamplerState(
-		RenderResourceManager::TEXTURE_FILTER_POINT,
-		RENDERER_TEXTURE_ADDRESS_MODE_CLAMP );
+	size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[rSubMeshIndices[meshIndexIndex]];
 
-	// Set the default depth state.
-	spCommandProxy->SetDepthStencilState( pDepthStateDefault, 0 );
+		Material* pMaterial = rSubMeshData.GetMaterial();
+		if ( !pMaterial )
+		{
+			continue;
+		}
 
-	// Draw shadow depth pass (this will also set up the shadow depth scene as needed).
-	DrawShadowDepthPass( viewIndex );
+		size_t textureParameterCount = pMaterial->GetTextureParameterCount();
+		if ( textureParameterCount == 0 )
+		{
+			continue;
+		}
 
-	// Set up normal scene rendering.
-	RSurface* pDepthStencilSurface = rView.GetDepthStencilSurface();
+		// Objects without bounds or that contain the view origin get the largest size possible.
+		size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+		HELIUM_ASSERT( sceneObjectId < m_sceneObjectBoundsRadius.GetSize() );
 
-	// Depth-stencil surfaces can be null, so we don't assert on the depth-stencil surface returned.
-	RTexture2dPtr spSceneTexture = pRenderResourceManager->GetSceneTexture();
-	HELIUM_ASSERT( spSceneTexture );
-	RSurfacePtr spSceneTextureSurface = spSceneTexture->GetSurface( 0 );
-	HELIUM_ASSERT( spSceneTextureSurface );
+		float32_t projectedSize = sizeMax;
+		float32_t radius = m_sceneObjectBoundsRadius[sceneObjectId];
+		if ( radius >= 0.0f )
+		{
+			float32_t offsetX = m_sceneObjectBoundsX[sceneObjectId] - originX;
+			float32_t offsetY = m_sceneObjectBoundsY[sceneObjectId] - originY;
+			float32_t offsetZ = m_sceneObjectBoundsZ[sceneObjectId] - originZ;
+			float32_t distance = Sqrt( offsetX * offsetX + offsetY * offsetY + offsetZ * offsetZ );
+			if ( distance > radius )
+			{
+				projectedSize = Min( radius * projectionScale / distance, sizeMax );
+			}
+		}
 
-	spCommandProxy->SetRenderSurfaces( spSceneTextureSurface, pDepthStencilSurface );
+		for ( size_t parameterIndex = 0; parameterIndex < textureParameterCount; ++parameterIndex )
+		{
+			Texture2d* pTexture = Reflect::SafeCast< Texture2d >(
+				pMaterial->GetTextureParameter( parameterIndex ).value.Get() );
+			if ( pTexture )
+			{
+				pTextureStreamer->RequestMipLevel( pTexture, pTexture->GetRequiredMipLevel( projectedSize ) );
+			}
+		}
+	}
+}
 
-	spCommandProxy->SetViewport(
-		rView.GetViewportX(),
-		rView.GetViewportY(),
-		rView.GetViewportWidth(),
-		rView.GetViewportHeight() );
+/// Sort a list of sub-meshes from front to back along a given direction.
+///
+/// Each sub-mesh is given a draw key holding the pass identifier and the distance of its scene object along the
+/// direction, which are then sorted using a parallel radix sort.
+///
+/// @param[in,out] rPass       Render pass data containing the indices of the sub-meshes to sort.
+/// @param[in]     pass        Draw key pass identifier.
+/// @param[in]     rDirection  Direction along which to sort.
+///
+/// @see SortSubMeshesByDrawState()
+void GraphicsScene::SortSubMeshesFrontToBack(
+	RenderPassData& rPass,
+	uint64_t pass,
+	const Simd::Vector3& rDirection )
+{
+	const DynamicArray< size_t >& rSubMeshIndices = rPass.subMeshIndices;
+	size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+	rPass.drawKeys.Resize( subMeshIndexCount );
 
-	spCommandProxy->BeginScene();
-	spCommandProxy->Clear( RENDERER_CLEAR_FLAG_ALL, rView.GetClearColor() );
+	uint64_t passKey = pass << DRAW_KEY_PASS_SHIFT;
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[rSubMeshIndices[meshIndexIndex]];
 
-	spCommandProxy->SetRasterizerState( pRasterizerStateDefault );
-	spCommandProxy->SetVertexConstantBuffers( 0, 1, &pViewVertexGlobalDataBuffer );
+		size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+		const GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
 
-	// Draw passes...
-	DrawDepthPrePass( viewIndex );
-	DrawBasePass( viewIndex );
+		float32_t depth = Simd::Vector4ToVector3( rSceneObject.GetTransform().GetRow( 3 ) ).Dot( rDirection );
+		rPass.drawKeys[meshIndexIndex] = passKey | GetDrawKeyDepth( depth );
+	}
 
-#if GRAPHICS_SCENE_BUFFERED_DRAWER
+	SortSubMeshDrawKeys( rPass );
+}
+
+/// Sort a list of sub-meshes so that sub-meshes sharing the same vertex and index buffers are drawn together.
+///
+/// Each sub-mesh is given a draw key holding the pass identifier, the rank of its scene object's vertex buffer
+/// (assigned in the order in which they are first encountered), and its distance along the given direction, which are
+/// then sorted using a parallel radix sort.  This is used for passes in which the shader state remains fixed, allowing
+/// consecutive sub-meshes to be drawn without rebinding their geometry buffers.
+///
+/// @param[in,out] rPass       Render pass data containing the indices of the sub-meshes to sort.
+/// @param[in]     pass        Draw key pass identifier.
+/// @param[in]     rDirection  Direction along which to sort sub-meshes sharing the same buffers.
+///
+/// @see SortSubMeshesFrontToBack(), SortSubMeshesByDrawState()
+void GraphicsScene::SortSubMeshesByMesh(
+	RenderPassData& rPass,
+	uint64_t pass,
+	const Simd::Vector3& rDirection )
+{
+	const DynamicArray< size_t >& rSubMeshIndices = rPass.subMeshIndices;
+	size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+	rPass.drawKeys.Resize( subMeshIndexCount );
+
+	rPass.drawStateRanks.Clear();
+	uint32_t nextMeshRank = 1;
+
+	uint64_t passKey = pass << DRAW_KEY_PASS_SHIFT;
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[rSubMeshIndices[meshIndexIndex]];
+
+		size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+		const GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+
+		float32_t depth = Simd::Vector4ToVector3( rSceneObject.GetTransform().GetRow( 3 ) ).Dot( rDirection );
+		rPass.drawKeys[meshIndexIndex] =
+			passKey |
+			( GetDrawStateRank( rPass, rSceneObject.GetVertexBuffer(), nextMeshRank, DRAW_KEY_STATE_RANK_MAX ) <<
+				DRAW_KEY_SHADOW_DEPTH_MESH_SHIFT ) |
+			GetDrawKeyDepth( depth );
+	}
+
+	SortSubMeshDrawKeys( rPass );
+}
+
+/// Sort a list of sub-meshes in order to reduce shader and material switches.
+///
+/// Each sub-mesh is given a draw key holding the pass identifier, the ranks of its vertex shader variant, pixel
+/// shader variant, material, and scene object vertex buffer (assigned in the order in which they are first
+/// encountered), and its distance along the given direction.  Sub-meshes without a material are given a rank of zero
+/// for each shader and material state and sort first.  Instances of the same mesh using the same material end up
+/// adjacent, so BuildInstanceRuns() can combine them into instanced draws.  The keys are then sorted using a parallel
+/// radix sort.
+///
+/// @param[in,out] rPass       Render pass data containing the indices of the sub-meshes to sort.
+/// @param[in]     pass        Draw key pass identifier.
+/// @param[in]     rDirection  Direction along which to sort sub-meshes sharing the same material and mesh.
+///
+/// @see SortSubMeshesFrontToBack(), SortSubMeshesByMesh()
+void GraphicsScene::SortSubMeshesByDrawState(
+	RenderPassData& rPass,
+	uint64_t pass,
+	const Simd::Vector3& rDirection )
+{
+	const DynamicArray< size_t >& rSubMeshIndices = rPass.subMeshIndices;
+	size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+	rPass.drawKeys.Resize( subMeshIndexCount );
+
+	rPass.drawStateRanks.Clear();
+	uint32_t nextVariantRank = 1;
+	uint32_t nextMaterialRank = 1;
+	uint32_t nextMeshRank = 1;
+
+	uint64_t passKey = pass << DRAW_KEY_PASS_SHIFT;
+	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+	{
+		const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[rSubMeshIndices[meshIndexIndex]];
+
+		size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+		const GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+
+		float32_t depth = Simd::Vector4ToVector3( rSceneObject.GetTransform().GetRow( 3 ) ).Dot( rDirection );
+		uint64_t key = passKey | ( GetDrawKeyDepth( depth ) >> DRAW_KEY_BASE_PASS_DEPTH_DROPPED_BITS );
+
+		Material* pMaterial = rSubMeshData.GetMaterial();
+		if ( pMaterial )
+		{
+			key |= GetDrawStateRank(
+				rPass,
+				pMaterial->GetShaderVariant( RShader::TYPE_VERTEX ),
+				nextVariantRank,
+				DRAW_KEY_VARIANT_RANK_MAX ) << DRAW_KEY_VERTEX_VARIANT_SHIFT;
+			key |= GetDrawStateRank(
+				rPass,
+				pMaterial->GetShaderVariant( RShader::TYPE_PIXEL ),
+				nextVariantRank,
+				DRAW_KEY_VARIANT_RANK_MAX ) << DRAW_KEY_PIXEL_VARIANT_SHIFT;
+			key |= GetDrawStateRank( rPass, pMaterial, nextMaterialRank, DRAW_KEY_STATE_RANK_MAX ) <<
+				DRAW_KEY_MATERIAL_SHIFT;
+		}
+
+		key |= GetDrawStateRank( rPass, rSceneObject.GetVertexBuffer(), nextMeshRank, DRAW_KEY_STATE_RANK_MAX ) <<
+			DRAW_KEY_MESH_SHIFT;
+
+		rPass.drawKeys[meshIndexIndex] = key;
+	}
+
+	SortSubMeshDrawKeys( rPass );
+}
+
+/// Sort the sub-meshes of a render pass by the draw keys stored in its draw key array.
+///
+/// @param[in,out] rPass  Render pass data containing the indices of the sub-meshes to sort (one for each draw key).
+void GraphicsScene::SortSubMeshDrawKeys( RenderPassData& rPass )
+{
+	size_t subMeshIndexCount = rPass.subMeshIndices.GetSize();
+	HELIUM_ASSERT( rPass.drawKeys.GetSize() == subMeshIndexCount );
+
+	rPass.drawKeyScratch.Resize( subMeshIndexCount );
+	rPass.subMeshIndexScratch.Resize( subMeshIndexCount );
+
+	RadixSortJob< size_t > job;
+	RadixSortJob< size_t >::Parameters& rParameters = job.GetParameters();
+	rParameters.pKeys = rPass.drawKeys.GetData();
+	rParameters.pValues = rPass.subMeshIndices.GetData();
+	rParameters.pScratchKeys = rPass.drawKeyScratch.GetData();
+	rParameters.pScratchValues = rPass.subMeshIndexScratch.GetData();
+	rParameters.count = subMeshIndexCount;
+	rParameters.singleJobCount = DRAW_KEY_SORT_SINGLE_JOB_COUNT;
+	job.Run();
+}
+
+/// Get the rank of a material, shader variant, or vertex buffer within the draw keys currently being built.
+///
+/// @param[in,out] rPass      Render pass data for which draw keys are being built.
+/// @param[in]     pState     State object address (null is always given a rank of zero).
+/// @param[in,out] rNextRank  Rank to assign if this is the first time the given state has been encountered (advanced
+///                           if it is used).
+/// @param[in]     rankMax    Largest rank that fits in the draw key field for the state.
+///
+/// @return  Draw key rank.
+uint64_t GraphicsScene::GetDrawStateRank(
+	RenderPassData& rPass,
+	const void* pState,
+	uint32_t& rNextRank,
+	uint32_t rankMax )
+{
+	if ( !pState )
+	{
+		return 0;
+	}
+
+	HashMap< const void*, uint32_t, DrawStateHash >::Iterator rankIterator;
+	if ( rPass.drawStateRanks.Insert(
+		rankIterator,
+		HashMap< const void*, uint32_t, DrawStateHash >::ValueType( pState, rNextRank ) ) )
+	{
+		rNextRank = Min( rNextRank + 1, rankMax );
+	}
+
+	return rankIterator->Second();
+}
+
+/// Make sure the per-instance vertex buffer of a render pass can hold a transform for each of its sub-meshes.
+///
+/// Buffers must be created from the main thread, so this is called for each view before its passes are drawn or
+/// recorded.  Any instance data left from a previous view is discarded as well.
+///
+/// @param[in,out] rPass  Render pass data with its sub-mesh list already built.
+///
+/// @see BuildInstanceRuns(), UploadInstanceVertexData()
+void GraphicsScene::ReserveInstanceVertexBuffer( RenderPassData& rPass )
+{
+	rPass.instanceTransforms.Resize( 0 );
+
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+	if ( !pRenderer->SupportsAnyFeature( RENDERER_FEATURE_FLAG_INSTANCING ) )
+	{
+		return;
+	}
+
+	size_t instanceCount = rPass.subMeshIndices.GetSize();
+	if ( instanceCount <= rPass.instanceVertexBufferCapacity )
+	{
+		return;
+	}
+
+	rPass.spInstanceVertexBuffer.Release();
+	rPass.spInstanceVertexBuffer = pRenderer->CreateVertexBuffer(
+		instanceCount * RenderResourceManager::MESH_INSTANCE_VERTEX_STRIDE,
+		RENDERER_BUFFER_USAGE_DYNAMIC );
+	if ( !rPass.spInstanceVertexBuffer )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"GraphicsScene: Failed to create per-instance vertex buffer for %" PRIuSZ " instances.\n",
+			instanceCount );
+
+		rPass.instanceVertexBufferCapacity = 0;
+	}
+	else
+	{
+		rPass.instanceVertexBufferCapacity = instanceCount;
+	}
+}
+
+/// Group the sorted sub-meshes of a render pass into runs that can be drawn with a single instanced draw.
+///
+/// Sub-meshes whose draw keys differ only in their depth bits share the same shader and mesh buffer state.  Within
+/// each such range, sub-meshes drawing the same part of the same non-skinned mesh are moved next to each other (which
+/// keeps them in depth order), and the length of each run is stored at the position of its first sub-mesh.  The world
+/// transform of each sub-mesh in a run of two or more is appended to the pass's instance transform array in draw
+/// order.  If the pass has no per-instance vertex buffer, every sub-mesh is drawn on its own.
+///
+/// @param[in,out] rPass           Render pass data with its sub-meshes sorted by draw key.
+/// @param[in]     depthBitCount   Number of low draw key bits holding the sub-mesh depth.
+/// @param[in]     bMatchMaterial  True if sub-meshes drawn together must also share the same material.
+///
+/// @see ReserveInstanceVertexBuffer(), UploadInstanceVertexData()
+void GraphicsScene::BuildInstanceRuns( RenderPassData& rPass, uint32_t depthBitCount, bool bMatchMaterial )
+{
+	size_t subMeshIndexCount = rPass.subMeshIndices.GetSize();
+	rPass.instanceRunLengths.Resize( subMeshIndexCount );
+	rPass.instanceTransforms.Resize( 0 );
+
+	uint32_t* pRunLengths = rPass.instanceRunLengths.GetData();
+
+	if ( !rPass.spInstanceVertexBuffer || rPass.instanceVertexBufferCapacity < subMeshIndexCount )
+	{
+		for ( size_t indexIndex = 0; indexIndex < subMeshIndexCount; ++indexIndex )
+		{
+			pRunLengths[indexIndex] = 1;
+		}
+
+		return;
+	}
+
+	HELIUM_ASSERT( rPass.drawKeys.GetSize() == subMeshIndexCount );
+	HELIUM_ASSERT( rPass.subMeshIndexScratch.GetSize() == subMeshIndexCount );
+
+	const uint64_t* pDrawKeys = rPass.drawKeys.GetData();
+	size_t* pSubMeshIndices = rPass.subMeshIndices.GetData();
+	size_t* pScratchIndices = rPass.subMeshIndexScratch.GetData();
+
+	static const size_t transformFloatCount = RenderResourceManager::MESH_INSTANCE_VERTEX_STRIDE / sizeof( float32_t );
+	rPass.instanceTransforms.Reserve( subMeshIndexCount * transformFloatCount );
+
+	size_t rangeStart = 0;
+	while ( rangeStart < subMeshIndexCount )
+	{
+		uint64_t stateKey = pDrawKeys[rangeStart] >> depthBitCount;
+		size_t rangeEnd = rangeStart + 1;
+		while ( rangeEnd < subMeshIndexCount && ( pDrawKeys[rangeEnd] >> depthBitCount ) == stateKey )
+		{
+			++rangeEnd;
+		}
+
+		// Gather each run into the scratch array, invalidating the indices of sub-meshes pulled forward into an
+		// earlier run.
+		size_t scratchIndex = rangeStart;
+		for ( size_t indexIndex = rangeStart; indexIndex < rangeEnd; ++indexIndex )
+		{
+			size_t subMeshIndex = pSubMeshIndices[indexIndex];
+			if ( IsInvalid( subMeshIndex ) )
+			{
+				continue;
+			}
+
+			size_t runStart = scratchIndex;
+			pScratchIndices[scratchIndex++] = subMeshIndex;
+
+			if ( IsSubMeshInstanceable( subMeshIndex ) )
+			{
+				for ( size_t otherIndex = indexIndex + 1; otherIndex < rangeEnd; ++otherIndex )
+				{
+					size_t otherSubMeshIndex = pSubMeshIndices[otherIndex];
+					if ( IsValid( otherSubMeshIndex ) &&
+						CanInstanceSubMeshes( subMeshIndex, otherSubMeshIndex, bMatchMaterial ) )
+					{
+						pScratchIndices[scratchIndex++] = otherSubMeshIndex;
+						pSubMeshIndices[otherIndex] = Invalid< size_t >();
+					}
+				}
+			}
+
+			size_t runLength = scratchIndex - runStart;
+			pRunLengths[runStart] = static_cast< uint32_t >( runLength );
+			if ( runLength < 2 )
+			{
+				continue;
+			}
+
+			size_t transformOffset = rPass.instanceTransforms.GetSize();
+			rPass.instanceTransforms.Resize( transformOffset + runLength * transformFloatCount );
+			float32_t* pTransform = rPass.instanceTransforms.GetData() + transformOffset;
+
+			for ( size_t runIndex = runStart; runIndex < scratchIndex; ++runIndex )
+			{
+				if ( runIndex != runStart )
+				{
+					pRunLengths[runIndex] = 0;
+				}
+
+				// Match the layout of the instance constant buffers written by the scene object update jobs.
+				const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[pScratchIndices[runIndex]];
+				const Simd::Matrix44& rTransform = m_sceneObjects[rSubMeshData.GetSceneObjectId()].GetTransform();
+
+				*( pTransform++ ) = rTransform.GetElement( 0 );
+				*( pTransform++ ) = rTransform.GetElement( 4 );
+				*( pTransform++ ) = rTransform.GetElement( 8 );
+				*( pTransform++ ) = rTransform.GetElement( 12 );
+				*( pTransform++ ) = rTransform.GetElement( 1 );
+				*( pTransform++ ) = rTransform.GetElement( 5 );
+				*( pTransform++ ) = rTransform.GetElement( 9 );
+				*( pTransform++ ) = rTransform.GetElement( 13 );
+				*( pTransform++ ) = rTransform.GetElement( 2 );
+				*( pTransform++ ) = rTransform.GetElement( 6 );
+				*( pTransform++ ) = rTransform.GetElement( 10 );
+				*( pTransform++ ) = rTransform.GetElement( 14 );
+			}
+		}
+
+		HELIUM_ASSERT( scratchIndex == rangeEnd );
+		ArrayCopy( pSubMeshIndices + rangeStart, pScratchIndices + rangeStart, rangeEnd - rangeStart );
+
+		rangeStart = rangeEnd;
+	}
+}
+
+/// Get whether a sub-mesh can be drawn as part of an instanced draw.
+///
+/// @param[in] subMeshIndex  Index of the sub-mesh to check.
+///
+/// @return  True if the sub-mesh belongs to a non-skinned mesh whose vertex layout has an instanced counterpart, false
+///          if not.
+bool GraphicsScene::IsSubMeshInstanceable( size_t subMeshIndex ) const
+{
+	HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) );
+	const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[subMeshIndex];
+
+	size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+	HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+	const GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
+
+	if ( rSceneObject.GetBoneCount() != 0 && rSceneObject.GetBonePalette() )
+	{
+		return false;
+	}
+
+	if ( !rSceneObject.GetVertexBuffer() || !rSceneObject.GetIndexBuffer() )
+	{
+		return false;
+	}
+
+	RenderResourceManager* pRenderResourceManager = RenderResourceManager::GetInstance();
+	HELIUM_ASSERT( pRenderResourceManager );
+
+	return ( pRenderResourceManager->GetInstancedVertexDescription( rSceneObject.GetVertexDescription() ) != NULL );
+}
+
+/// Get whether an instanceable sub-mesh can be drawn in the same instanced draw as another sub-mesh.
+///
+/// @param[in] subMeshIndex0   Index of an instanceable sub-mesh.
+/// @param[in] subMeshIndex1   Index of the sub-mesh to test against it.
+/// @param[in] bMatchMaterial  True if the sub-meshes must also share the same material.
+///
+/// @return  True if both sub-meshes draw the same part of the same mesh, false if not.
+bool GraphicsScene::CanInstanceSubMeshes( size_t subMeshIndex0, size_t subMeshIndex1, bool bMatchMaterial ) const
+{
+	HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex0 ) );
+	HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex1 ) );
+	const GraphicsSceneObject::SubMeshData& rSubMeshData0 = m_sceneObjectSubMeshes[subMeshIndex0];
+	const GraphicsSceneObject::SubMeshData& rSubMeshData1 = m_sceneObjectSubMeshes[subMeshIndex1];
+
+	if ( rSubMeshData0.GetPrimitiveType() != rSubMeshData1.GetPrimitiveType() ||
+		rSubMeshData0.GetPrimitiveCount() != rSubMeshData1.GetPrimitiveCount() ||
+		rSubMeshData0.GetStartVertex() != rSubMeshData1.GetStartVertex() ||
+		rSubMeshData0.GetVertexRange() != rSubMeshData1.GetVertexRange() ||
+		rSubMeshData0.GetStartIndex() != rSubMeshData1.GetStartIndex() )
+	{
+		return false;
+	}
+
+	if ( bMatchMaterial && rSubMeshData0.GetMaterial() != rSubMeshData1.GetMaterial() )
+	{
+		return false;
+	}
+
+	const GraphicsSceneObject& rSceneObject0 = m_sceneObjects[rSubMeshData0.GetSceneObjectId()];
+	const GraphicsSceneObject& rSceneObject1 = m_sceneObjects[rSubMeshData1.GetSceneObjectId()];
+
+	if ( rSceneObject0.GetVertexBuffer() != rSceneObject1.GetVertexBuffer() ||
+		rSceneObject0.GetIndexBuffer() != rSceneObject1.GetIndexBuffer() ||
+		rSceneObject0.GetVertexDescription() != rSceneObject1.GetVertexDescription() ||
+		rSceneObject0.GetVertexStride() != rSceneObject1.GetVertexStride() )
+	{
+		return false;
+	}
+
+	return ( rSceneObject1.GetBoneCount() == 0 || !rSceneObject1.GetBonePalette() );
+}
+
+/// Copy the instance transforms built for a render pass into its per-instance vertex buffer.
+///
+/// This maps the buffer, so it must be called from the main thread: directly by passes drawn through the immediate
+/// command proxy, and by SubmitRenderPass() for recorded passes before their command lists are executed.
+///
+/// @param[in] rPass  Render pass data whose instance runs have been built.
+///
+/// @see ReserveInstanceVertexBuffer(), BuildInstanceRuns()
+void GraphicsScene::UploadInstanceVertexData( RenderPassData& rPass )
+{
+	size_t transformFloatCount = rPass.instanceTransforms.GetSize();
+	if ( transformFloatCount == 0 )
+	{
+		return;
+	}
+
+	HELIUM_ASSERT( rPass.spInstanceVertexBuffer );
+	void* pMappedData = rPass.spInstanceVertexBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD );
+	HELIUM_ASSERT( pMappedData );
+	if ( pMappedData )
+	{
+		MemoryCopy( pMappedData, rPass.instanceTransforms.GetData(), transformFloatCount * sizeof( float32_t ) );
+		rPass.spInstanceVertexBuffer->Unmap();
+	}
+}
+
+///
+/// @param[in] viewIndex  Index of the scene view to render (can be an invalid element, but must be less than the size
+///                       of the scene view sparse array).
+void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
+{
+	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+
+	if ( !m_sceneViews.IsElementValid( viewIndex ) )
+	{
+		return;
+	}
+
+	RConstantBuffer* pViewVertexGlobalDataBuffer =
+		m_viewVertexGlobalDataBuffers[m_constantBufferSetIndex][viewIndex];
+	if ( !pViewVertexGlobalDataBuffer )
+	{
+		return;
+	}
+
+	GraphicsSceneView& rView = m_sceneViews[viewIndex];
+	RRenderContext* pRenderContext = rView.GetRenderContext();
+	if ( !pRenderContext )
+	{
+		return;
+	}
+
+	RenderResourceManager* pRenderResourceManager = RenderResourceManager::GetInstance();
+	HELIUM_ASSERT( pRenderResourceManager );
+
+	// Build a list of indices for each sub-mesh visible in the current view for sorting.  Culling updates the shared
+	// scene object visibility masks, so the lists for each pass are built up front before any pass is recorded.
+	RenderPassData& rBasePass = m_renderPasses[ RENDER_PASS_BASE ];
+	BuildVisibleSubMeshList( rView.GetFrustum(), rBasePass.subMeshIndices );
+	m_renderPasses[ RENDER_PASS_DEPTH_PRE ].subMeshIndices = rBasePass.subMeshIndices;
+	RequestTextureMipLevels( rView, rBasePass.subMeshIndices );
+
+	// Find the shadow casters within the shadow view if shadows are enabled.
+	RenderPassData& rShadowDepthPass = m_renderPasses[ RENDER_PASS_SHADOW_DEPTH ];
+	rShadowDepthPass.subMeshIndices.Resize( 0 );
+
+	GraphicsConfig::EShadowMode shadowMode = pRenderResourceManager->GetShadowMode();
+	if ( shadowMode != GraphicsConfig::EShadowMode::INVALID && shadowMode != GraphicsConfig::EShadowMode::NONE )
+	{
+		HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
+		Simd::Frustum shadowViewFrustum( m_shadowViewInverseViewProjectionMatrices[viewIndex].GetTranspose() );
+		BuildVisibleSubMeshList( shadowViewFrustum, rShadowDepthPass.subMeshIndices );
+	}
+
+	// Size the per-instance vertex buffers of the passes that use instanced draws up front, as buffers can only be
+	// created from the main thread.
+	ReserveInstanceVertexBuffer( rShadowDepthPass );
+	ReserveInstanceVertexBuffer( rBasePass );
+
+	// Record the commands for each pass on separate threads if the renderer supports deferred command proxies.
+	bool bRecorded = RecordRenderPasses( viewIndex );
+
+	// Get the renderer interface and the main command proxy for the renderer.
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
+	RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
+	HELIUM_ASSERT( spCommandProxy );
+
+	// Get the state objects that we will use during rendering.
+	RRasterizerState* pRasterizerStateDefault = pRenderResourceManager->GetRasterizerState(
+		RenderResourceManager::RASTERIZER_STATE_DEFAULT );
+	RBlendState* pBlendStateOpaque = pRenderResourceManager->GetBlendState( RenderResourceManager::BLEND_STATE_OPAQUE );
+	RDepthStencilState* pDepthStateDefault = pRenderResourceManager->GetDepthStencilState(
+		RenderResourceManager::DEPTH_STENCIL_STATE_DEFAULT );
+	RDepthStencilState* pDepthStateNone = pRenderResourceManager->GetDepthStencilState(
+		RenderResourceManager::DEPTH_STENCIL_STATE_NONE );
+	RSamplerState* pSamplerStatePointClamp = pRenderResourceManager->GetSamplerState(
+		RenderResourceManager::TEXTURE_FILTER_POINT,
+		RENDERER_TEXTURE_ADDRESS_MODE_CLAMP );
+
+	// Set the default depth state.
+	spCommandProxy->SetDepthStencilState( pDepthStateDefault, 0 );
+
+	// Draw shadow depth pass (this will also set up the shadow depth scene as needed).
+	SubmitRenderPass( RENDER_PASS_SHADOW_DEPTH, viewIndex, spCommandProxy, bRecorded );
+
+	// Set up normal scene rendering.
+	RSurface* pDepthStencilSurface = rView.GetDepthStencilSurface();
+
+	// Depth-stencil surfaces can be null, so we don't assert on the depth-stencil surface returned.
+	RTexture2dPtr spSceneTexture = pRenderResourceManager->GetSceneTexture();
+	HELIUM_ASSERT( spSceneTexture );
+	RSurfacePtr spSceneTextureSurface = spSceneTexture->GetSurface( 0 );
+	HELIUM_ASSERT( spSceneTextureSurface );
+
+	spCommandProxy->SetRenderSurfaces( spSceneTextureSurface, pDepthStencilSurface );
+
+	spCommandProxy->SetViewport(
+		rView.GetViewportX(),
+		rView.GetViewportY(),
+		rView.GetViewportWidth(),
+		rView.GetViewportHeight() );
+
+	spCommandProxy->BeginScene();
+	spCommandProxy->Clear( RENDERER_CLEAR_FLAG_ALL, rView.GetClearColor() );
+
+	spCommandProxy->SetRasterizerState( pRasterizerStateDefault );
+	spCommandProxy->SetVertexConstantBuffers( 0, 1, &pViewVertexGlobalDataBuffer );
+
+	// Draw passes...
+	SubmitRenderPass( RENDER_PASS_DEPTH_PRE, viewIndex, spCommandProxy, bRecorded );
+	SubmitRenderPass( RENDER_PASS_BASE, viewIndex, spCommandProxy, bRecorded );
+
+#if GRAPHICS_SCENE_BUFFERED_DRAWER
 	// Draw buffered world-space draw calls for the current scene and view.
 	const Simd::Matrix44& rInverseViewProjectionMatrix = rView.GetInverseViewProjectionMatrix();
 	m_sceneBufferedDrawer.DrawWorldElements( rInverseViewProjectionMatrix );
@@ -1337,25 +2302,183 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 			}
 		}
 	}
-#endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+#endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+	spCommandProxy->EndScene();
+
+	spCommandProxy->UnbindResources();
+
+	pRenderContext->Swap();
+}
+
+/// Record the commands for each render pass of a scene view to deferred command lists.
+///
+/// Each pass is recorded by a separate job using its own deferred command proxy, with the resulting command lists
+/// stored in the pass data for playback by SubmitRenderPass().  The sub-mesh lists for each pass must already be built.
+///
+/// @param[in] viewIndex  Index of the view being rendered.
+///
+/// @return  True if the passes were recorded, false if the renderer does not support deferred command proxies (in
+///          which case the passes should be drawn directly).
+///
+/// @see SubmitRenderPass()
+bool GraphicsScene::RecordRenderPasses( uint_fast32_t viewIndex )
+{
+	Renderer* pRenderer = Renderer::GetInstance();
+	HELIUM_ASSERT( pRenderer );
+
+	for ( size_t passIndex = 0; passIndex < RENDER_PASS_MAX; ++passIndex )
+	{
+		RenderPassData& rPass = m_renderPasses[ passIndex ];
+		if ( !rPass.spCommandProxy )
+		{
+			rPass.spCommandProxy = pRenderer->CreateDeferredCommandProxy();
+			if ( !rPass.spCommandProxy )
+			{
+				return false;
+			}
+		}
+	}
+
+	// Make sure the shader option names used while drawing are initialized before any jobs run.
+	GetNoneOptionName();
+	GetSkinningSysSelectName();
+	GetSkinningSmoothOptionName();
+	GetSkinningRigidOptionName();
+	GetInstancingSysToggleName();
+
+	JobManager* pJobManager = JobManager::GetInstance();
+	if ( !pJobManager )
+	{
+		for ( size_t passIndex = 0; passIndex < RENDER_PASS_MAX; ++passIndex )
+		{
+			RecordRenderPass( static_cast< ERenderPass >( passIndex ), viewIndex );
+		}
+
+		return true;
+	}
+
+	JobHandle jobGroup = pJobManager->CreateGroup();
+	for ( size_t passIndex = 0; passIndex < RENDER_PASS_MAX; ++passIndex )
+	{
+		RecordRenderPassJobData jobData;
+		jobData.pScene = this;
+		jobData.viewIndex = static_cast< uint32_t >( viewIndex );
+		jobData.pass = static_cast< uint32_t >( passIndex );
+
+		pJobManager->Run( pJobManager->CreateJob( &RecordRenderPassCallback, &jobData, sizeof( jobData ), jobGroup ) );
+	}
+
+	pJobManager->Run( jobGroup );
+	pJobManager->Wait( jobGroup );
+
+	return true;
+}
+
+/// Job callback for recording a single render pass.
+///
+/// @param[in] pData  RecordRenderPassJobData for the pass to record.
+void GraphicsScene::RecordRenderPassCallback( void* pData )
+{
+	HELIUM_ASSERT( pData );
+	const RecordRenderPassJobData* pJobData = static_cast< const RecordRenderPassJobData* >( pData );
+	HELIUM_ASSERT( pJobData->pScene );
+
+	pJobData->pScene->RecordRenderPass( static_cast< ERenderPass >( pJobData->pass ), pJobData->viewIndex );
+}
+
+/// Record the commands for a render pass to a command list using the deferred command proxy of the pass.
+///
+/// Only the data of the given pass is modified, so separate passes can be recorded concurrently.
+///
+/// @param[in] pass       Render pass to record.
+/// @param[in] viewIndex  Index of the view being rendered.
+void GraphicsScene::RecordRenderPass( ERenderPass pass, uint_fast32_t viewIndex )
+{
+	HELIUM_ASSERT( static_cast< size_t >( pass ) < RENDER_PASS_MAX );
+
+	RenderPassData& rPass = m_renderPasses[ pass ];
+	HELIUM_ASSERT( rPass.spCommandProxy );
+
+	DrawRenderPass( pass, viewIndex, rPass.spCommandProxy );
+	rPass.spCommandProxy->FinishCommandList( rPass.spCommandList );
+}
+
+/// Issue the commands for a render pass through a command proxy.
+///
+/// @param[in] pass           Render pass to submit.
+/// @param[in] viewIndex      Index of the view being rendered.
+/// @param[in] pCommandProxy  Command proxy through which to issue commands.
+/// @param[in] bRecorded      True to play back the command list recorded by RecordRenderPasses(), false to draw the
+///                           pass directly.
+///
+/// @see RecordRenderPasses()
+void GraphicsScene::SubmitRenderPass(
+	ERenderPass pass,
+	uint_fast32_t viewIndex,
+	RRenderCommandProxy* pCommandProxy,
+	bool bRecorded )
+{
+	HELIUM_ASSERT( static_cast< size_t >( pass ) < RENDER_PASS_MAX );
+	HELIUM_ASSERT( pCommandProxy );
+
+	if ( !bRecorded )
+	{
+		DrawRenderPass( pass, viewIndex, pCommandProxy );
+
+		return;
+	}
+
+	// Instance data is uploaded here rather than while recording, since buffers can only be mapped from the main thread.
+	RenderPassData& rPass = m_renderPasses[ pass ];
+	UploadInstanceVertexData( rPass );
+
+	if ( rPass.spCommandList )
+	{
+		pCommandProxy->ExecuteCommandList( rPass.spCommandList );
+		rPass.spCommandList.Release();
+	}
+}
 
-	spCommandProxy->EndScene();
+/// Draw a render pass.
+///
+/// @param[in] pass           Render pass to draw.
+/// @param[in] viewIndex      Index of the view being rendered.
+/// @param[in] pCommandProxy  Command proxy through which to issue commands.
+void GraphicsScene::DrawRenderPass( ERenderPass pass, uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy )
+{
+	switch ( pass )
+	{
+	case RENDER_PASS_SHADOW_DEPTH:
+		DrawShadowDepthPass( viewIndex, pCommandProxy );
+		break;
 
-	spCommandProxy->UnbindResources();
+	case RENDER_PASS_DEPTH_PRE:
+		DrawDepthPrePass( viewIndex, pCommandProxy );
+		break;
 
-	pRenderContext->Swap();
+	case RENDER_PASS_BASE:
+		DrawBasePass( viewIndex, pCommandProxy );
+		break;
+
+	default:
+		HELIUM_BREAK();
+		break;
+	}
 }
 
 /// Draw the shadow depth render pass.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort by depth if rendering is performed.
+/// - The shadow depth pass sub-mesh list should already be prepared with the (unsorted) list of shadow casters within
+///   the shadow view frustum, so casters outside of the scene view still render to the shadow depth texture.  This
+///   function will sort them by depth if rendering is performed.
 /// - Default rasterizer and depth states should be already set.
 ///
-/// @param[in] viewIndex  Index of the view for which the shadow depth pass is being rendered.
+/// @param[in] viewIndex      Index of the view for which the shadow depth pass is being rendered.
+/// @param[in] pCommandProxy  Command proxy through which to issue commands.
 ///
 /// @see DrawDepthPrePass(), DrawBasePass()
-void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
+void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy )
 {
 	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
 	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
@@ -1413,6 +2536,34 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 	HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
 	RVertexShader* pPrePassSmoothSkinningVertexShader = static_cast<RVertexShader*>( pPrePassShaderResource );
 
+	// The instanced variant is optional (shaders without the instancing toggle resolve to the non-instanced variant, in
+	// which case instance runs are drawn one sub-mesh at a time).
+	Name instancingToggleName = GetInstancingSysToggleName();
+	optionSelectPair.choice = GetNoneOptionName();
+	size_t noInstancingOptionSetIndex = rPrePassShaderSysOptions.GetOptionSetIndex(
+		RShader::TYPE_VERTEX,
+		NULL,
+		0,
+		&optionSelectPair,
+		1 );
+	optionSetIndex = rPrePassShaderSysOptions.GetOptionSetIndex(
+		RShader::TYPE_VERTEX,
+		&instancingToggleName,
+		1,
+		&optionSelectPair,
+		1 );
+
+	RVertexShader* pPrePassInstancedVertexShader = NULL;
+	if ( optionSetIndex != noInstancingOptionSetIndex )
+	{
+		pPrePassShaderResource = pPrePassVertexShaderVariant->GetRenderResource( optionSetIndex );
+		if ( pPrePassShaderResource )
+		{
+			HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
+			pPrePassInstancedVertexShader = static_cast<RVertexShader*>( pPrePassShaderResource );
+		}
+	}
+
 	// Make sure the shadow depth pass constant buffer exists.
 	RConstantBuffer* pShadowViewVertexDataBuffer =
 		m_shadowViewVertexDataBuffers[m_constantBufferSetIndex][viewIndex];
@@ -1432,59 +2583,73 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 	RSurfacePtr spShadowDepthTextureSurface = pShadowDepthTexture->GetSurface( 0 );
 	HELIUM_ASSERT( spShadowDepthTextureSurface );
 
-	// Sort meshes based on distance from front to back in order to reduce overdraw.
-	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
-
-	{
-		SortJob< size_t, SubMeshFrontToBackCompare > job;
-
-		SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = job.GetParameters();
-		rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-		rParameters.count = subMeshIndexCount;
-		rParameters.compare = SubMeshFrontToBackCompare(
-			m_directionalLightDirection,
-			m_sceneObjects,
-			m_sceneObjectSubMeshes );
-		rParameters.singleJobCount = 100;
-
-		job.Run();
-	}
+	// Sort meshes so that instances of the same mesh are drawn together, and from front to back within each mesh in
+	// order to reduce overdraw, then group repeated meshes into instanced draws (materials don't affect depth
+	// rendering, so instances with different materials can be drawn together).
+	RenderPassData& rPass = m_renderPasses[ RENDER_PASS_SHADOW_DEPTH ];
+	SortSubMeshesByMesh( rPass, DRAW_KEY_PASS_SHADOW_DEPTH, m_directionalLightDirection );
+	BuildInstanceRuns( rPass, DRAW_KEY_SHADOW_DEPTH_MESH_SHIFT, false );
+	size_t subMeshIndexCount = rPass.subMeshIndices.GetSize();
 
 	// Prepare the shadow depth pass scene for rendering.
 	Renderer* pRenderer = Renderer::GetInstance();
 	HELIUM_ASSERT( pRenderer );
 
-	RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
-	HELIUM_ASSERT( spCommandProxy );
+	// Recorded passes have their instance data uploaded by SubmitRenderPass() from the main thread.
+	if ( pCommandProxy != rPass.spCommandProxy )
+	{
+		UploadInstanceVertexData( rPass );
+	}
 
 	RTexture2d* pSceneTexture = pRenderResourceManager->GetSceneTexture();
 	HELIUM_ASSERT( pSceneTexture );
 	RSurfacePtr spSceneTextureSurface = pSceneTexture->GetSurface( 0 );
 	HELIUM_ASSERT( spSceneTextureSurface );
 
-	spCommandProxy->SetRenderSurfaces( spSceneTextureSurface, spShadowDepthTextureSurface );
-	spCommandProxy->SetViewport( 0, 0, shadowDepthTextureUsableSize, shadowDepthTextureUsableSize );
+	pCommandProxy->SetRenderSurfaces( spSceneTextureSurface, spShadowDepthTextureSurface );
+	pCommandProxy->SetViewport( 0, 0, shadowDepthTextureUsableSize, shadowDepthTextureUsableSize );
 
 	RRasterizerState* pRasterizerStateShadowDepth = pRenderResourceManager->GetRasterizerState(
 		RenderResourceManager::RASTERIZER_STATE_SHADOW_DEPTH );
-	spCommandProxy->SetRasterizerState( pRasterizerStateShadowDepth );
+	pCommandProxy->SetRasterizerState( pRasterizerStateShadowDepth );
 
 	RBlendState* pBlendStateNoColor = pRenderResourceManager->GetBlendState(
 		RenderResourceManager::BLEND_STATE_NO_COLOR );
-	spCommandProxy->SetBlendState( pBlendStateNoColor );
+	pCommandProxy->SetBlendState( pBlendStateNoColor );
 
 	// Draw the scene.
-	spCommandProxy->BeginScene();
-	spCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
+	pCommandProxy->BeginScene();
+	pCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
 
-	spCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
-	spCommandProxy->SetPixelShader( NULL );
+	pCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
+	pCommandProxy->SetPixelShader( NULL );
 
 	RVertexShader* pPreviousVertexShader = NULL;
+	RConstantBuffer* pPreviousInstanceVertexGlobalDataBuffer = NULL;
+	RVertexBuffer* pPreviousVertexBuffer = NULL;
+	RIndexBuffer* pPreviousIndexBuffer = NULL;
+	RVertexInputLayout* pPreviousInputLayout = NULL;
+
+	RVertexBuffer* pInstanceVertexBuffer = rPass.spInstanceVertexBuffer;
+	uint32_t instanceVertexStride = RenderResourceManager::MESH_INSTANCE_VERTEX_STRIDE;
+	uint32_t instanceOffset = 0;
 
 	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
 	{
-		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
+		// Skip sub-meshes already drawn by a preceding instanced draw.
+		uint32_t instanceCount = rPass.instanceRunLengths[meshIndexIndex];
+		if ( instanceCount == 0 )
+		{
+			continue;
+		}
+
+		uint32_t firstInstance = instanceOffset;
+		if ( instanceCount > 1 )
+		{
+			instanceOffset += instanceCount;
+		}
+
+		size_t meshIndex = rPass.subMeshIndices[meshIndexIndex];
 		HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
 		GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[meshIndex];
@@ -1494,18 +2659,6 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 		HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
 		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
 
-		HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
-		RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[meshIndex];
-		if ( !pInstanceVertexGlobalDataBuffer )
-		{
-			HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
-			pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[sceneObjectId];
-			if ( !pInstanceVertexGlobalDataBuffer )
-			{
-				continue;
-			}
-		}
-
 		GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
 
 		RVertexBuffer* pVertexBuffer = rSceneObject.GetVertexBuffer();
@@ -1526,21 +2679,62 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 			continue;
 		}
 
-		RVertexShader* pVertexShader;
-		if ( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() )
-		{
-			pVertexShader = pPrePassNoSkinningVertexShader;
-		}
-		else
+		RVertexShader* pVertexShader = NULL;
+		RVertexInputLayout* pInputLayout = NULL;
+
+		if ( instanceCount > 1 )
 		{
-			pVertexShader = pPrePassSmoothSkinningVertexShader;
+			pVertexShader = pPrePassInstancedVertexShader;
+			if ( pVertexShader )
+			{
+				RVertexDescription* pInstancedVertexDescription =
+					pRenderResourceManager->GetInstancedVertexDescription( pVertexDescription );
+				HELIUM_ASSERT( pInstancedVertexDescription );
+				pInputLayout = pVertexShader->GetInputLayout( pRenderer, pInstancedVertexDescription );
+			}
+
+			// Fall back to drawing each sub-mesh of the run on its own if the instanced shader can't be used.
+			if ( !pInputLayout )
+			{
+				for ( uint32_t runIndex = 1; runIndex < instanceCount; ++runIndex )
+				{
+					rPass.instanceRunLengths[meshIndexIndex + runIndex] = 1;
+				}
+
+				instanceCount = 1;
+			}
 		}
 
-		pVertexShader->CacheDescription( pRenderer, pVertexDescription );
-		RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
-		if ( !pInputLayout )
+		RConstantBuffer* pInstanceVertexGlobalDataBuffer = NULL;
+
+		if ( instanceCount == 1 )
 		{
-			continue;
+			HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
+			pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[meshIndex];
+			if ( !pInstanceVertexGlobalDataBuffer )
+			{
+				HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
+				pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[sceneObjectId];
+				if ( !pInstanceVertexGlobalDataBuffer )
+				{
+					continue;
+				}
+			}
+
+			if ( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() )
+			{
+				pVertexShader = pPrePassNoSkinningVertexShader;
+			}
+			else
+			{
+				pVertexShader = pPrePassSmoothSkinningVertexShader;
+			}
+
+			pInputLayout = pVertexShader->GetInputLayout( pRenderer, pVertexDescription );
+			if ( !pInputLayout )
+			{
+				continue;
+			}
 		}
 
 		uint32_t vertexStride = rSceneObject.GetVertexStride();
@@ -1554,39 +2748,79 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 
 		if ( pPreviousVertexShader != pVertexShader )
 		{
-			spCommandProxy->SetVertexShader( pVertexShader );
+			pCommandProxy->SetVertexShader( pVertexShader );
 			pPreviousVertexShader = pVertexShader;
 		}
 
-		spCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
-		spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
-		spCommandProxy->SetIndexBuffer( pIndexBuffer );
-		spCommandProxy->SetVertexInputLayout( pInputLayout );
+		// Consecutive instances of the same mesh only need their instance constant buffer switched.
+		if ( pInstanceVertexGlobalDataBuffer &&
+			pInstanceVertexGlobalDataBuffer != pPreviousInstanceVertexGlobalDataBuffer )
+		{
+			pCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
+			pPreviousInstanceVertexGlobalDataBuffer = pInstanceVertexGlobalDataBuffer;
+		}
 
-		spCommandProxy->DrawIndexed(
-			primitiveType,
-			startVertex,
-			0,
-			vertexRange,
-			startIndex,
-			primitiveCount );
+		if ( pVertexBuffer != pPreviousVertexBuffer )
+		{
+			pCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
+			pPreviousVertexBuffer = pVertexBuffer;
+		}
+
+		if ( pIndexBuffer != pPreviousIndexBuffer )
+		{
+			pCommandProxy->SetIndexBuffer( pIndexBuffer );
+			pPreviousIndexBuffer = pIndexBuffer;
+		}
+
+		if ( pInputLayout != pPreviousInputLayout )
+		{
+			pCommandProxy->SetVertexInputLayout( pInputLayout );
+			pPreviousInputLayout = pInputLayout;
+		}
+
+		if ( instanceCount > 1 )
+		{
+			// Each run reads its transforms from its own range of the per-instance vertex buffer.
+			uint32_t instanceVertexOffset = firstInstance * instanceVertexStride;
+			pCommandProxy->SetVertexBuffers( 1, 1, &pInstanceVertexBuffer, &instanceVertexStride, &instanceVertexOffset );
+
+			pCommandProxy->DrawIndexedInstanced(
+				primitiveType,
+				startVertex,
+				0,
+				vertexRange,
+				startIndex,
+				primitiveCount,
+				instanceCount );
+		}
+		else
+		{
+			pCommandProxy->DrawIndexed(
+				primitiveType,
+				startVertex,
+				0,
+				vertexRange,
+				startIndex,
+				primitiveCount );
+		}
 	}
 
-	spCommandProxy->EndScene();
+	pCommandProxy->EndScene();
 }
 
 /// Draw the depth-only pre-pass for the given scene view.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort by depth if rendering is performed.
+/// - The depth pre-pass sub-mesh list should already be prepared with the (unsorted) list of visible sub-meshes.
+///   This function will sort by depth if rendering is performed.
 /// - Standard viewport render surfaces are expected to have already been set, with the depth buffer cleared.
 /// - Default rasterizer and depth states should be already set.
 /// - Global per-view constant buffers should be already set.
 ///
-/// @param[in] viewIndex  Index of the view for which the depth-only pre-pass is being rendered.
+/// @param[in] viewIndex      Index of the view for which the depth-only pre-pass is being rendered.
+/// @param[in] pCommandProxy  Command proxy through which to issue commands.
 ///
 /// @see DrawShadowDepthPass(), DrawBasePass()
-void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
+void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy )
 {
 	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
 	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
@@ -1641,37 +2875,30 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 	GraphicsSceneView& rView = m_sceneViews[viewIndex];
 	const Simd::Vector3& rViewDirection = rView.GetForward();
 
-	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
-
-	{
-		SortJob< size_t, SubMeshFrontToBackCompare > job;
-		SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = job.GetParameters();
-		rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-		rParameters.count = subMeshIndexCount;
-		rParameters.compare = SubMeshFrontToBackCompare( rViewDirection, m_sceneObjects, m_sceneObjectSubMeshes );
-		rParameters.singleJobCount = 100;
-		job.Run();
-	}
+	RenderPassData& rPass = m_renderPasses[ RENDER_PASS_DEPTH_PRE ];
+	SortSubMeshesFrontToBack( rPass, DRAW_KEY_PASS_DEPTH_PRE, rViewDirection );
+	size_t subMeshIndexCount = rPass.subMeshIndices.GetSize();
 
 	// Initialize the blend state and shaders for performing no color writes.
 	Renderer* pRenderer = Renderer::GetInstance();
 	HELIUM_ASSERT( pRenderer );
 
-	RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
-	HELIUM_ASSERT( spCommandProxy );
-
 	RBlendState* pBlendStateNoColor = pRenderResourceManager->GetBlendState(
 		RenderResourceManager::BLEND_STATE_NO_COLOR );
-	spCommandProxy->SetBlendState( pBlendStateNoColor );
+	pCommandProxy->SetBlendState( pBlendStateNoColor );
 
-	spCommandProxy->SetPixelShader( NULL );
+	pCommandProxy->SetPixelShader( NULL );
 
 	// Draw each visible mesh instance.
 	RVertexShader* pPreviousVertexShader = NULL;
+	RConstantBuffer* pPreviousInstanceVertexGlobalDataBuffer = NULL;
+	RVertexBuffer* pPreviousVertexBuffer = NULL;
+	RIndexBuffer* pPreviousIndexBuffer = NULL;
+	RVertexInputLayout* pPreviousInputLayout = NULL;
 
 	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
 	{
-		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
+		size_t meshIndex = rPass.subMeshIndices[meshIndexIndex];
 		HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
 		GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[meshIndex];
@@ -1723,8 +2950,7 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 			pVertexShader = pPrePassSmoothSkinningVertexShader;
 		}
 
-		pVertexShader->CacheDescription( pRenderer, pVertexDescription );
-		RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
+		RVertexInputLayout* pInputLayout = pVertexShader->GetInputLayout( pRenderer, pVertexDescription );
 		if ( !pInputLayout )
 		{
 			continue;
@@ -1741,16 +2967,36 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 
 		if ( pPreviousVertexShader != pVertexShader )
 		{
-			spCommandProxy->SetVertexShader( pVertexShader );
+			pCommandProxy->SetVertexShader( pVertexShader );
 			pPreviousVertexShader = pVertexShader;
 		}
 
-		spCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
-		spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
-		spCommandProxy->SetIndexBuffer( pIndexBuffer );
-		spCommandProxy->SetVertexInputLayout( pInputLayout );
+		// Consecutive instances of the same mesh only need their instance constant buffer switched.
+		if ( pInstanceVertexGlobalDataBuffer != pPreviousInstanceVertexGlobalDataBuffer )
+		{
+			pCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
+			pPreviousInstanceVertexGlobalDataBuffer = pInstanceVertexGlobalDataBuffer;
+		}
+
+		if ( pVertexBuffer != pPreviousVertexBuffer )
+		{
+			pCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
+			pPreviousVertexBuffer = pVertexBuffer;
+		}
+
+		if ( pIndexBuffer != pPreviousIndexBuffer )
+		{
+			pCommandProxy->SetIndexBuffer( pIndexBuffer );
+			pPreviousIndexBuffer = pIndexBuffer;
+		}
+
+		if ( pInputLayout != pPreviousInputLayout )
+		{
+			pCommandProxy->SetVertexInputLayout( pInputLayout );
+			pPreviousInputLayout = pInputLayout;
+		}
 
-		spCommandProxy->DrawIndexed(
+		pCommandProxy->DrawIndexed(
 			primitiveType,
 			startVertex,
 			0,
@@ -1762,18 +3008,19 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 
 /// Draw the base pass for the given scene view.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort as appropriate if rendering is performed.
+/// - The base pass sub-mesh list should already be prepared with the (unsorted) list of visible sub-meshes.  This
+///   function will sort as appropriate if rendering is performed.
 /// - Standard viewport render surfaces are expected to have already been set, with the depth buffer either cleared
 ///   or prepared by the depth-only pre-pass.
 /// - Default rasterizer and depth states should be already set.
 /// - Global per-view constant buffers should be already set (buffers specific to the base pass will be set by this
 ///   function).
 ///
-/// @param[in] viewIndex  Index of the view for which the base pass is being rendered.
+/// @param[in] viewIndex      Index of the view for which the base pass is being rendered.
+/// @param[in] pCommandProxy  Command proxy through which to issue commands.
 ///
 /// @see DrawShadowDepthPass(), DrawDepthPrePass()
-void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
+void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy )
 {
 	HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
 	HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
@@ -1822,33 +3069,29 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 
 	systemSelections[0].choice = shadowSelectOptions[shadowMode];
 
-	// Sort meshes based on material in order to reduce shader switches.
-	size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+	// Sort meshes based on material in order to reduce shader switches, then group repeated meshes using the same
+	// material into instanced draws.
+	RenderPassData& rPass = m_renderPasses[ RENDER_PASS_BASE ];
+	SortSubMeshesByDrawState( rPass, DRAW_KEY_PASS_BASE, m_sceneViews[viewIndex].GetForward() );
+	BuildInstanceRuns( rPass, DRAW_KEY_MESH_SHIFT, true );
+	size_t subMeshIndexCount = rPass.subMeshIndices.GetSize();
 
+	// Recorded passes have their instance data uploaded by SubmitRenderPass() from the main thread.
+	if ( pCommandProxy != rPass.spCommandProxy )
 	{
-		SortJob< size_t, SubMeshMaterialCompare > job;
-		SortJob< size_t, SubMeshMaterialCompare >::Parameters& rParameters = job.GetParameters();
-		rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-		rParameters.count = subMeshIndexCount;
-		rParameters.compare = SubMeshMaterialCompare( m_sceneObjectSubMeshes );
-		rParameters.singleJobCount = 100;
-
-		job.Run();
+		UploadInstanceVertexData( rPass );
 	}
 
 	// Set the opaque rendering blend state and per-view constant buffers for this pass.
 	Renderer* pRenderer = Renderer::GetInstance();
 	HELIUM_ASSERT( pRenderer );
 
-	RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
-	HELIUM_ASSERT( spCommandProxy );
-
 	RBlendState* pBlendStateOpaque = pRenderResourceManager->GetBlendState(
 		RenderResourceManager::BLEND_STATE_OPAQUE );
-	spCommandProxy->SetBlendState( pBlendStateOpaque );
+	pCommandProxy->SetBlendState( pBlendStateOpaque );
 
-	spCommandProxy->SetVertexConstantBuffers( 1, 1, &pViewVertexBasePassDataBuffer );
-	spCommandProxy->SetPixelConstantBuffers( 0, 1, &pViewPixelBasePassDataBuffer );
+	pCommandProxy->SetVertexConstantBuffers( 1, 1, &pViewVertexBasePassDataBuffer );
+	pCommandProxy->SetPixelConstantBuffers( 0, 1, &pViewPixelBasePassDataBuffer );
 
 	// Draw each visible sub-mesh.
 	Name defaultSamplerStateName = GetDefaultSamplerStateName();
@@ -1868,10 +3111,33 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 	RPixelShader* pPreviousPixelShader = NULL;
 	RConstantBuffer* pPreviousMaterialVertexConstantBuffer = NULL;
 	RConstantBuffer* pPreviousMaterialPixelConstantBuffer = NULL;
+	RConstantBuffer* pPreviousInstanceVertexGlobalDataBuffer = NULL;
+	RVertexBuffer* pPreviousVertexBuffer = NULL;
+	RIndexBuffer* pPreviousIndexBuffer = NULL;
+	RVertexInputLayout* pPreviousInputLayout = NULL;
+	Material* pPreviousMaterial = NULL;
+
+	Name instancingToggleName = GetInstancingSysToggleName();
+	RVertexBuffer* pInstanceVertexBuffer = rPass.spInstanceVertexBuffer;
+	uint32_t instanceVertexStride = RenderResourceManager::MESH_INSTANCE_VERTEX_STRIDE;
+	uint32_t instanceOffset = 0;
 
 	for ( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
 	{
-		size_t meshIndex = m_sceneObjectSubMeshIndices[meshIndexIndex];
+		// Skip sub-meshes already drawn by a preceding instanced draw.
+		uint32_t instanceCount = rPass.instanceRunLengths[meshIndexIndex];
+		if ( instanceCount == 0 )
+		{
+			continue;
+		}
+
+		uint32_t firstInstance = instanceOffset;
+		if ( instanceCount > 1 )
+		{
+			instanceOffset += instanceCount;
+		}
+
+		size_t meshIndex = rPass.subMeshIndices[meshIndexIndex];
 		HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
 		GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[meshIndex];
@@ -1881,18 +3147,6 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 		HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
 		HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
 
-		HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
-		RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[meshIndex];
-		if ( !pInstanceVertexGlobalDataBuffer )
-		{
-			HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
-			pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[sceneObjectId];
-			if ( !pInstanceVertexGlobalDataBuffer )
-			{
-				continue;
-			}
-		}
-
 		GraphicsSceneObject& rSceneObject = m_sceneObjects[sceneObjectId];
 
 		RVertexBuffer* pVertexBuffer = rSceneObject.GetVertexBuffer();
@@ -1960,23 +3214,76 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 			systemSelections,
 			HELIUM_ARRAY_COUNT( systemSelections ) );
 
-		RVertexShader* pVertexShader =
-			static_cast<RVertexShader*>( pVertexShaderVariant->GetRenderResource( vertexShaderIndex ) );
-		if ( !pVertexShader )
+		RVertexShader* pVertexShader = NULL;
+		RVertexInputLayout* pInputLayout = NULL;
+
+		if ( instanceCount > 1 )
 		{
-			continue;
+			// Shaders without the instancing toggle resolve to the non-instanced variant.
+			size_t instancedVertexShaderIndex = rSystemOptions.GetOptionSetIndex(
+				RShader::TYPE_VERTEX,
+				&instancingToggleName,
+				1,
+				systemSelections,
+				HELIUM_ARRAY_COUNT( systemSelections ) );
+			if ( instancedVertexShaderIndex != vertexShaderIndex )
+			{
+				pVertexShader = static_cast<RVertexShader*>(
+					pVertexShaderVariant->GetRenderResource( instancedVertexShaderIndex ) );
+				if ( pVertexShader )
+				{
+					RVertexDescription* pInstancedVertexDescription =
+						pRenderResourceManager->GetInstancedVertexDescription( pVertexDescription );
+					HELIUM_ASSERT( pInstancedVertexDescription );
+					pInputLayout = pVertexShader->GetInputLayout( pRenderer, pInstancedVertexDescription );
+				}
+			}
+
+			// Fall back to drawing each sub-mesh of the run on its own if the instanced shader can't be used.
+			if ( !pInputLayout )
+			{
+				for ( uint32_t runIndex = 1; runIndex < instanceCount; ++runIndex )
+				{
+					rPass.instanceRunLengths[meshIndexIndex + runIndex] = 1;
+				}
+
+				instanceCount = 1;
+			}
 		}
 
-		RPixelShader* pPixelShader =
-			static_cast<RPixelShader*>( pPixelShaderVariant->GetRenderResource( pixelShaderIndex ) );
-		if ( !pPixelShader )
+		RConstantBuffer* pInstanceVertexGlobalDataBuffer = NULL;
+
+		if ( instanceCount == 1 )
 		{
-			continue;
+			HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
+			pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[meshIndex];
+			if ( !pInstanceVertexGlobalDataBuffer )
+			{
+				HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
+				pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[sceneObjectId];
+				if ( !pInstanceVertexGlobalDataBuffer )
+				{
+					continue;
+				}
+			}
+
+			pVertexShader =
+				static_cast<RVertexShader*>( pVertexShaderVariant->GetRenderResource( vertexShaderIndex ) );
+			if ( !pVertexShader )
+			{
+				continue;
+			}
+
+			pInputLayout = pVertexShader->GetInputLayout( pRenderer, pVertexDescription );
+			if ( !pInputLayout )
+			{
+				continue;
+			}
 		}
 
-		pVertexShader->CacheDescription( pRenderer, pVertexDescription );
-		RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
-		if ( !pInputLayout )
+		RPixelShader* pPixelShader =
+			static_cast<RPixelShader*>( pPixelShaderVariant->GetRenderResource( pixelShaderIndex ) );
+		if ( !pPixelShader )
 		{
 			continue;
 		}
@@ -1995,38 +3302,62 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 		uint32_t vertexRange = rSubMeshData.GetVertexRange();
 		uint32_t startIndex = rSubMeshData.GetStartIndex();
 
-		spCommandProxy->SetVertexConstantBuffers( 2, 1, &pInstanceVertexGlobalDataBuffer );
+		if ( pInstanceVertexGlobalDataBuffer &&
+			pInstanceVertexGlobalDataBuffer != pPreviousInstanceVertexGlobalDataBuffer )
+		{
+			pCommandProxy->SetVertexConstantBuffers( 2, 1, &pInstanceVertexGlobalDataBuffer );
+			pPreviousInstanceVertexGlobalDataBuffer = pInstanceVertexGlobalDataBuffer;
+		}
 
 		if ( pMaterialVertexConstantBuffer != pPreviousMaterialVertexConstantBuffer )
 		{
-			spCommandProxy->SetVertexConstantBuffers( 3, 1, &pMaterialVertexConstantBuffer );
+			pCommandProxy->SetVertexConstantBuffers( 3, 1, &pMaterialVertexConstantBuffer );
 			pPreviousMaterialVertexConstantBuffer = pMaterialVertexConstantBuffer;
 		}
 
 		if ( pMaterialPixelConstantBuffer != pPreviousMaterialPixelConstantBuffer )
 		{
-			spCommandProxy->SetPixelConstantBuffers( 1, 1, &pMaterialPixelConstantBuffer );
+			pCommandProxy->SetPixelConstantBuffers( 1, 1, &pMaterialPixelConstantBuffer );
 			pPreviousMaterialPixelConstantBuffer = pMaterialPixelConstantBuffer;
 		}
 
-		spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
-		spCommandProxy->SetIndexBuffer( pIndexBuffer );
+		if ( pVertexBuffer != pPreviousVertexBuffer )
+		{
+			pCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
+			pPreviousVertexBuffer = pVertexBuffer;
+		}
+
+		if ( pIndexBuffer != pPreviousIndexBuffer )
+		{
+			pCommandProxy->SetIndexBuffer( pIndexBuffer );
+			pPreviousIndexBuffer = pIndexBuffer;
+		}
 
 		if ( pVertexShader != pPreviousVertexShader )
 		{
-			spCommandProxy->SetVertexShader( pVertexShader );
+			pCommandProxy->SetVertexShader( pVertexShader );
 			pPreviousVertexShader = pVertexShader;
 		}
 
+		// Sampler and texture bindings depend only on the material and pixel shader, so they can be left as-is when
+		// drawing further instances using the same material.
+		bool bBindMaterialResources = ( pMaterial != pPreviousMaterial || pPixelShader != pPreviousPixelShader );
+		pPreviousMaterial = pMaterial;
+
 		if ( pPixelShader != pPreviousPixelShader )
 		{
-			spCommandProxy->SetPixelShader( pPixelShader );
+			pCommandProxy->SetPixelShader( pPixelShader );
 			pPreviousPixelShader = pPixelShader;
 		}
 
-		spCommandProxy->SetVertexInputLayout( pInputLayout );
+		if ( pInputLayout != pPreviousInputLayout )
+		{
+			pCommandProxy->SetVertexInputLayout( pInputLayout );
+			pPreviousInputLayout = pInputLayout;
+		}
 
-		const ShaderSamplerInfoSet* pSamplerInfoSet = pPixelShaderVariant->GetSamplerInfoSet( pixelShaderIndex );
+		const ShaderSamplerInfoSet* pSamplerInfoSet =
+			( bBindMaterialResources ? pPixelShaderVariant->GetSamplerInfoSet( pixelShaderIndex ) : NULL );
 		if ( pSamplerInfoSet )
 		{
 			const DynamicArray< ShaderSamplerInfo >& samplerInputs = pSamplerInfoSet->inputs;
@@ -2047,11 +3378,12 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 					pSamplerState = pSamplerStateShadowMap;
 				}
 
-				spCommandProxy->SetSamplerStates( rInputInfo.bindIndex, 1, &pSamplerState );
+				pCommandProxy->SetSamplerStates( rInputInfo.bindIndex, 1, &pSamplerState );
 			}
 		}
 
-		const ShaderTextureInfoSet* pTextureInfoSet = pPixelShaderVariant->GetTextureInfoSet( pixelShaderIndex );
+		const ShaderTextureInfoSet* pTextureInfoSet =
+			( bBindMaterialResources ? pPixelShaderVariant->GetTextureInfoSet( pixelShaderIndex ) : NULL );
 		if ( pTextureInfoSet )
 		{
 			size_t materialTextureCount = pMaterial->GetTextureParameterCount();
@@ -2090,17 +3422,35 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 					}
 				}
 
-				spCommandProxy->SetTexture( rInputInfo.bindIndex, pTextureResource );
+				pCommandProxy->SetTexture( rInputInfo.bindIndex, pTextureResource );
 			}
 		}
 
-		spCommandProxy->DrawIndexed(
-			primitiveType,
-			startVertex,
-			0,
-			vertexRange,
-			startIndex,
-			primitiveCount );
+		if ( instanceCount > 1 )
+		{
+			// Each run reads its transforms from its own range of the per-instance vertex buffer.
+			uint32_t instanceVertexOffset = firstInstance * instanceVertexStride;
+			pCommandProxy->SetVertexBuffers( 1, 1, &pInstanceVertexBuffer, &instanceVertexStride, &instanceVertexOffset );
+
+			pCommandProxy->DrawIndexedInstanced(
+				primitiveType,
+				startVertex,
+				0,
+				vertexRange,
+				startIndex,
+				primitiveCount,
+				instanceCount );
+		}
+		else
+		{
+			pCommandProxy->DrawIndexed(
+				primitiveType,
+				startVertex,
+				0,
+				vertexRange,
+				startIndex,
+				primitiveCount );
+		}
 	}
 }
 
@@ -2150,111 +3500,23 @@ Name GraphicsScene::GetSkinningRigidOptionName()
 	return skinningRigidOptionName;
 }
 
-/// Constructor.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare()
-	: m_cameraDirection( 0.0f )
-	, m_pSceneObjects( NULL )
-	, m_pSubMeshes( NULL )
-{
-}
-
-/// Constructor.
-///
-/// @param[in] rCameraDirection  Camera world direction.
-/// @param[in] rSceneObjects     List of graphics scene objects in the scene.
-/// @param[in] rSubMeshes        List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare(
-	const Simd::Vector3& rCameraDirection,
-	const SparseArray< GraphicsSceneObject >& rSceneObjects,
-	const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-	: m_cameraDirection( rCameraDirection )
-	, m_pSceneObjects( &rSceneObjects )
-	, m_pSubMeshes( &rSubMeshes )
-{
-}
-
-/// Compare two sub-meshes for sorting.
-///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
+/// Get the name of the instancing system toggle for shaders.
 ///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshFrontToBackCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
-{
-	const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-	const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-	size_t sceneObjectIndex0 = rSubMesh0.GetSceneObjectId();
-	HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex0 ) );
-	size_t sceneObjectIndex1 = rSubMesh1.GetSceneObjectId();
-	HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex1 ) );
-
-	const GraphicsSceneObject& rSceneObject0 = m_pSceneObjects->GetElement( sceneObjectIndex0 );
-	const GraphicsSceneObject& rSceneObject1 = m_pSceneObjects->GetElement( sceneObjectIndex1 );
-
-	Simd::Vector3 object0Pos = Simd::Vector4ToVector3( rSceneObject0.GetTransform().GetRow( 3 ) );
-	Simd::Vector3 object1Pos = Simd::Vector4ToVector3( rSceneObject1.GetTransform().GetRow( 3 ) );
-
-	float distance0 = object0Pos.Dot( m_cameraDirection );
-	float distance1 = object1Pos.Dot( m_cameraDirection );
-
-	return ( distance0 < distance1 );
-}
-
-/// Constructor.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare()
-	: m_pSubMeshes( NULL )
+/// @return  Instancing system toggle name.
+Name GraphicsScene::GetInstancingSysToggleName()
 {
-}
+	static Name instancingSysToggleName( "INSTANCING" );
 
-/// Constructor.
-///
-/// @param[in] rSubMeshes  List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare(
-	const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-	: m_pSubMeshes( &rSubMeshes )
-{
+	return instancingSysToggleName;
 }
 
-/// Compare two sub-meshes for sorting.
+/// Compute the hash of a material or shader variant address.
 ///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
+/// @param[in] pState  Address to hash.
 ///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshMaterialCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
+/// @return  Hash value.
+size_t GraphicsScene::DrawStateHash::operator()( const void* pState ) const
 {
-	const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-	const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-	Material* pMaterial0 = rSubMesh0.GetMaterial();
-	Material* pMaterial1 = rSubMesh1.GetMaterial();
-	if ( pMaterial0 == pMaterial1 )
-	{
-		return false;
-	}
-
-	if ( !pMaterial0 )
-	{
-		return true;
-	}
-
-	if ( !pMaterial1 )
-	{
-		return false;
-	}
-
-	ShaderVariant* pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_VERTEX );
-	ShaderVariant* pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_VERTEX );
-	if ( pVariant0 != pVariant1 )
-	{
-		return ( pVariant0 < pVariant1 );
-	}
-
-	pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_PIXEL );
-	pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_PIXEL );
-
-	return ( pVariant0 < pVariant1 );
+	// Objects are allocated with at least 16-byte alignment, so the lowest address bits carry no information.
+	return ( reinterpret_cast< uintptr_t >( pState ) >> 4 );
 }
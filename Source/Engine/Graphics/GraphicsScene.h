@@ -4,11 +4,19 @@
 //#include "Engine/Asset.h"
 #include "Reflect/Object.h"
 
-#include "Foundation/BitArray.h"
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
 #include "Rendering/RRenderResource.h"
+#include "Graphics/GraphicsSceneBvh.h"
 #include "GraphicsTypes/GraphicsSceneObject.h"
 #include "GraphicsTypes/GraphicsSceneView.h"
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+#include "Graphics/Animation.h"
+#include "Graphics/AnimationSampler.h"
+#include "Graphics/Mesh.h"
+#endif
+
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
 #include "Foundation/ObjectPool.h"
 #include "Graphics/BufferedDrawer.h"
@@ -17,6 +25,9 @@
 namespace Helium
 {
     HELIUM_DECLARE_RPTR( RConstantBuffer );
+    HELIUM_DECLARE_RPTR( RRenderCommandList );
+    HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+    HELIUM_DECLARE_RPTR( RVertexBuffer );
 
     class HELIUM_GRAPHICS_API SceneObjectTransform : public Helium::Component
     {
@@ -58,6 +69,23 @@ namespace Helium
         inline GraphicsSceneObject* GetSceneObject( size_t id );
         //@}
 
+        /// @name Scene Object Culling
+        //@{
+        void SetSceneObjectWorldBounds( size_t id, const Simd::AaBox& rBox );
+
+        void SetSpatialCullingEnabled( bool bEnabled );
+        inline bool IsSpatialCullingEnabled() const;
+        inline const GraphicsSceneBvh& GetSceneObjectBvh() const;
+        //@}
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+        /// @name Scene Object Animation
+        //@{
+        void SetSceneObjectAnimation( size_t id, Mesh* pMesh, Animation* pAnimation, float32_t blendSeconds = 0.0f );
+        void ClearSceneObjectAnimation( size_t id );
+        //@}
+#endif
+
         /// @name Scene Asset Sub-mesh Allocation
         //@{
         size_t AllocateSceneObjectSubMeshData( size_t sceneObjectId );
@@ -96,51 +124,97 @@ namespace Helium
         //@}
 
     private:
-        /// Front-to-back sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshFrontToBackCompare
+        /// Hash function for material and shader variant addresses used in sub-mesh draw keys.
+        class HELIUM_GRAPHICS_API DrawStateHash
         {
         public:
-            /// @name Construction/Destruction
-            //@{
-            SubMeshFrontToBackCompare();
-            SubMeshFrontToBackCompare(
-                const Simd::Vector3& rCameraDirection, const SparseArray< GraphicsSceneObject >& rSceneObjects,
-                const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
-
             /// @name Overloaded Operators
             //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
+            size_t operator()( const void* pState ) const;
             //@}
+        };
 
-        private:
-            /// Camera direction.
-            Simd::Vector3 m_cameraDirection;
-            /// Scene object list.
-            const SparseArray< GraphicsSceneObject >* m_pSceneObjects;
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
+        /// Render passes drawn for each scene view.
+        enum ERenderPass
+        {
+            /// Shadow depth pass.
+            RENDER_PASS_SHADOW_DEPTH,
+            /// Depth-only pre-pass.
+            RENDER_PASS_DEPTH_PRE,
+            /// Base pass.
+            RENDER_PASS_BASE,
+
+            RENDER_PASS_MAX
         };
 
-        /// Material-based sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshMaterialCompare
+        /// Sorting and command recording data for a single render pass.
+        struct RenderPassData
         {
-        public:
             /// @name Construction/Destruction
             //@{
-            SubMeshMaterialCompare();
-            explicit SubMeshMaterialCompare( const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
+            inline RenderPassData();
             //@}
 
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
-            //@}
+            /// Indices of the sub-meshes drawn in the pass.
+            DynamicArray< size_t > subMeshIndices;
+
+            /// Draw key of each sub-mesh being sorted.
+            DynamicArray< uint64_t > drawKeys;
+            /// Scratch space for sorting sub-mesh draw keys.
+            DynamicArray< uint64_t > drawKeyScratch;
+            /// Scratch space for sorting sub-mesh indices along with their draw keys.
+            DynamicArray< size_t > subMeshIndexScratch;
+            /// Rank of each material, shader variant, and vertex buffer referenced by the draw keys being built.
+            HashMap< const void*, uint32_t, DrawStateHash > drawStateRanks;
+
+            /// Number of sub-meshes drawn by the draw issued at each position of the sorted sub-mesh list (more than
+            /// one for instanced draws, zero for sub-meshes drawn by a preceding instanced draw).
+            DynamicArray< uint32_t > instanceRunLengths;
+            /// World transform rows of each sub-mesh drawn using instancing, in draw order.
+            DynamicArray< float32_t > instanceTransforms;
+            /// Per-instance vertex buffer from which instanced draws read their world transforms.
+            RVertexBufferPtr spInstanceVertexBuffer;
+            /// Number of instances that fit in the per-instance vertex buffer.
+            size_t instanceVertexBufferCapacity;
+
+            /// Deferred command proxy with which the pass is recorded.
+            RRenderCommandProxyPtr spCommandProxy;
+            /// Commands recorded for the pass in the current view.
+            RRenderCommandListPtr spCommandList;
+        };
 
-        private:
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
+#if !HELIUM_USE_GRANNY_ANIMATION
+        /// Animation playback state for a skinned scene object.
+        struct SceneObjectAnimation
+        {
+            /// ID of the animated scene object.
+            size_t sceneObjectId;
+            /// Skinned mesh providing the bone hierarchy.
+            StrongPtr< Mesh > spMesh;
+
+            /// Animation currently playing.
+            StrongPtr< Animation > spAnimation;
+            /// Track index for each bone in the current animation.
+            DynamicArray< uint16_t > trackMap;
+            /// Playback time of the current animation, in seconds.
+            float32_t time;
+
+            /// Animation being blended out (null if no blend is in progress).
+            StrongPtr< Animation > spPreviousAnimation;
+            /// Track index for each bone in the previous animation.
+            DynamicArray< uint16_t > previousTrackMap;
+            /// Playback time of the previous animation, in seconds.
+            float32_t previousTime;
+
+            /// Time elapsed since the current blend started, in seconds.
+            float32_t blendTime;
+            /// Length of the current blend, in seconds.
+            float32_t blendDuration;
+
+            /// World-space transform of each bone.
+            DynamicArray< Simd::Matrix44 > bonePalette;
         };
+#endif
 
         /// Scene view list.
         SparseArray< GraphicsSceneView > m_sceneViews;
@@ -158,10 +232,34 @@ namespace Helium
         DynamicArray< BufferedDrawer* > m_viewBufferedDrawers;
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
-        /// Visible scene objects for the current view.
-        BitArray<> m_visibleSceneObjects;
-        /// Scene object sub-data index list (for sorting during rendering).
-        DynamicArray< size_t > m_sceneObjectSubMeshIndices;
+        /// Scene object bounding sphere center x coordinates (struct-of-arrays copy of each object's world sphere).
+        DynamicArray< float32_t > m_sceneObjectBoundsX;
+        /// Scene object bounding sphere center y coordinates.
+        DynamicArray< float32_t > m_sceneObjectBoundsY;
+        /// Scene object bounding sphere center z coordinates.
+        DynamicArray< float32_t > m_sceneObjectBoundsZ;
+        /// Scene object bounding sphere radii (negative for unused slots and objects with no bounds set).
+        DynamicArray< float32_t > m_sceneObjectBoundsRadius;
+
+        /// Bounding volume hierarchy over the scene objects (only maintained while spatial culling is enabled).
+        GraphicsSceneBvh m_sceneObjectBvh;
+        /// True if scene objects are culled using the bounding volume hierarchy, false to test every object.
+        bool m_bSpatialCulling;
+
+        /// Visible scene objects for the current view (one bit per scene object).
+        DynamicArray< uint32_t > m_visibleSceneObjectMasks;
+
+        /// Sub-mesh lists, sorting data, and recorded commands for each render pass.
+        RenderPassData m_renderPasses[ RENDER_PASS_MAX ];
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+        /// Animation state of each animated scene object.
+        DynamicArray< SceneObjectAnimation > m_sceneObjectAnimations;
+        /// Index of each scene object's animation state, indexed by scene object ID (invalid if not animated).
+        DynamicArray< size_t > m_sceneObjectAnimationIndices;
+        /// Skeletons evaluated during the current update.
+        DynamicArray< AnimationSampler::Skeleton > m_animationSkeletons;
+#endif
 
         /// Ambient light top color.
         Color m_ambientLightTopColor;
@@ -216,6 +314,13 @@ namespace Helium
         /// Current dynamic constant buffer set index.
         size_t m_constantBufferSetIndex;
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+        /// @name Animation
+        //@{
+        void UpdateSceneObjectAnimations( float32_t deltaSeconds );
+        //@}
+#endif
+
         /// @name Rendering
         //@{
         void UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIndex );
@@ -223,11 +328,36 @@ namespace Helium
 
         void SwapDynamicConstantBuffers();
 
+        void CullSceneObjects( const Simd::Frustum& rFrustum );
+        inline bool IsSceneObjectVisible( size_t id ) const;
+        void BuildVisibleSubMeshList( const Simd::Frustum& rFrustum, DynamicArray< size_t >& rSubMeshIndices );
+        void RequestTextureMipLevels( const GraphicsSceneView& rView, const DynamicArray< size_t >& rSubMeshIndices );
+
+        void SortSubMeshesFrontToBack( RenderPassData& rPass, uint64_t pass, const Simd::Vector3& rDirection );
+        void SortSubMeshesByMesh( RenderPassData& rPass, uint64_t pass, const Simd::Vector3& rDirection );
+        void SortSubMeshesByDrawState( RenderPassData& rPass, uint64_t pass, const Simd::Vector3& rDirection );
+        void SortSubMeshDrawKeys( RenderPassData& rPass );
+        uint64_t GetDrawStateRank(
+            RenderPassData& rPass, const void* pState, uint32_t& rNextRank, uint32_t rankMax );
+
+        void ReserveInstanceVertexBuffer( RenderPassData& rPass );
+        void BuildInstanceRuns( RenderPassData& rPass, uint32_t depthBitCount, bool bMatchMaterial );
+        bool IsSubMeshInstanceable( size_t subMeshIndex ) const;
+        bool CanInstanceSubMeshes( size_t subMeshIndex0, size_t subMeshIndex1, bool bMatchMaterial ) const;
+        void UploadInstanceVertexData( RenderPassData& rPass );
+
         void DrawSceneView( uint_fast32_t viewIndex );
 
-        void DrawShadowDepthPass( uint_fast32_t viewIndex );
-        void DrawDepthPrePass( uint_fast32_t viewIndex );
-        void DrawBasePass( uint_fast32_t viewIndex );
+        bool RecordRenderPasses( uint_fast32_t viewIndex );
+        static void RecordRenderPassCallback( void* pData );
+        void RecordRenderPass( ERenderPass pass, uint_fast32_t viewIndex );
+        void SubmitRenderPass(
+            ERenderPass pass, uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy, bool bRecorded );
+        void DrawRenderPass( ERenderPass pass, uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy );
+
+        void DrawShadowDepthPass( uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy );
+        void DrawDepthPrePass( uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy );
+        void DrawBasePass( uint_fast32_t viewIndex, RRenderCommandProxy* pCommandProxy );
         //@}
 
         /// @name Private Static Utility Functions
@@ -237,6 +367,8 @@ namespace Helium
         static Name GetSkinningSysSelectName();
         static Name GetSkinningSmoothOptionName();
         static Name GetSkinningRigidOptionName();
+
+        static Name GetInstancingSysToggleName();
         //@}
     };
 }
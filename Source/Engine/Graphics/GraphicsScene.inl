@@ -118,6 +118,29 @@ namespace Helium
         return m_directionalLightBrightness;
     }
 
+    /// Get whether scene objects are culled using a bounding volume hierarchy.
+    ///
+    /// @return  True if spatial culling is enabled, false if every scene object is tested individually.
+    ///
+    /// @see SetSpatialCullingEnabled(), GetSceneObjectBvh()
+    bool GraphicsScene::IsSpatialCullingEnabled() const
+    {
+        return m_bSpatialCulling;
+    }
+
+    /// Get the bounding volume hierarchy over the scene objects.
+    ///
+    /// The hierarchy can be used for sphere and ray queries against scene object bounds, but it is only maintained
+    /// while spatial culling is enabled and only reflects changes applied during the last Update().
+    ///
+    /// @return  Scene object bounding volume hierarchy.
+    ///
+    /// @see SetSpatialCullingEnabled(), IsSpatialCullingEnabled()
+    const GraphicsSceneBvh& GraphicsScene::GetSceneObjectBvh() const
+    {
+        return m_sceneObjectBvh;
+    }
+
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
     /// Get the buffered drawing interface for the entire scene.
     ///
@@ -131,4 +154,22 @@ namespace Helium
         return m_sceneBufferedDrawer;
     }
 #endif  // !HELIUM_RELEASE && !HELIUM_PROFILE
+
+    /// Get whether a scene object was found to be visible by the most recent call to CullSceneObjects().
+    ///
+    /// @param[in] id  ID of the scene object to check.
+    ///
+    /// @return  True if the scene object is visible in the view being rendered, false if not.
+    bool GraphicsScene::IsSceneObjectVisible( size_t id ) const
+    {
+        HELIUM_ASSERT( id / 32 < m_visibleSceneObjectMasks.GetSize() );
+
+        return ( m_visibleSceneObjectMasks[ id / 32 ] & ( 1U << ( id % 32 ) ) ) != 0;
+    }
+
+    /// Constructor.
+    GraphicsScene::RenderPassData::RenderPassData()
+        : instanceVertexBufferCapacity( 0 )
+    {
+    }
 }
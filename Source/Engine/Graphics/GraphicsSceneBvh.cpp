@@ -0,0 +1,654 @@
+#include "Precompile.h"
+#include "Graphics/GraphicsSceneBvh.h"
+
+#include <algorithm>
+
+using namespace Helium;
+
+/// Fewest objects outside the tree that will trigger a rebuild.
+static const uint32_t BVH_LOOSE_OBJECT_REBUILD_MIN = 64;
+/// Growth in total leaf surface area from refitting at which the tree is rebuilt.
+static const float32_t BVH_LEAF_AREA_REBUILD_RATIO = 1.5f;
+/// Size of the node stacks used when building and traversing the tree (median splits keep the tree balanced, so
+/// this bounds the depth well beyond any object count that fits in 32 bits).
+static const size_t BVH_NODE_STACK_SIZE = 64;
+
+/// Sort comparison for ordering object IDs along a single axis by the center of their bounds.
+class ObjectCenterCompare
+{
+public:
+	ObjectCenterCompare( const Simd::AaBox* pBoxes, size_t axis )
+		: m_pBoxes( pBoxes )
+		, m_axis( axis )
+	{
+	}
+
+	bool operator()( uint32_t id0, uint32_t id1 ) const
+	{
+		const Simd::AaBox& rBox0 = m_pBoxes[id0];
+		const Simd::AaBox& rBox1 = m_pBoxes[id1];
+
+		return rBox0.GetMinimum().GetElement( m_axis ) + rBox0.GetMaximum().GetElement( m_axis ) <
+			rBox1.GetMinimum().GetElement( m_axis ) + rBox1.GetMaximum().GetElement( m_axis );
+	}
+
+private:
+	const Simd::AaBox* m_pBoxes;
+	size_t m_axis;
+};
+
+/// Compute the smallest box containing two boxes.
+static Simd::AaBox MergeBoxes( const Simd::AaBox& rBox0, const Simd::AaBox& rBox1 )
+{
+	return Simd::AaBox(
+		Simd::Vector3( Helium::Simd::MinF32( rBox0.GetMinimum().GetSimdVector(), rBox1.GetMinimum().GetSimdVector() ) ),
+		Simd::Vector3( Helium::Simd::MaxF32( rBox0.GetMaximum().GetSimdVector(), rBox1.GetMaximum().GetSimdVector() ) ) );
+}
+
+/// Compute the surface area of a box.
+static float32_t GetBoxSurfaceArea( const Simd::AaBox& rBox )
+{
+	Simd::Vector3 extents = rBox.GetMaximum() - rBox.GetMinimum();
+	float32_t x = extents.GetElement( 0 );
+	float32_t y = extents.GetElement( 1 );
+	float32_t z = extents.GetElement( 2 );
+
+	return 2.0f * ( x * y + y * z + z * x );
+}
+
+/// Test whether a sphere overlaps a box.
+static bool SphereOverlapsBox( const Simd::Sphere& rSphere, const Simd::AaBox& rBox )
+{
+	float32_t distanceSquared = 0.0f;
+	for ( size_t axis = 0; axis < 3; ++axis )
+	{
+		float32_t center = rSphere.GetElement( axis );
+		float32_t closest = Max( Min( center, rBox.GetMaximum().GetElement( axis ) ), rBox.GetMinimum().GetElement( axis ) );
+		float32_t offset = center - closest;
+		distanceSquared += offset * offset;
+	}
+
+	float32_t radius = rSphere.GetElement( 3 );
+
+	return distanceSquared <= radius * radius;
+}
+
+/// Test whether a ray segment overlaps a box.
+static bool RayOverlapsBox(
+	const Simd::Vector3& rOrigin,
+	const Simd::Vector3& rDirection,
+	float32_t maxDistance,
+	const Simd::AaBox& rBox )
+{
+	float32_t entryDistance = 0.0f;
+	float32_t exitDistance = maxDistance;
+	for ( size_t axis = 0; axis < 3; ++axis )
+	{
+		float32_t origin = rOrigin.GetElement( axis );
+		float32_t direction = rDirection.GetElement( axis );
+		float32_t boxMinimum = rBox.GetMinimum().GetElement( axis );
+		float32_t boxMaximum = rBox.GetMaximum().GetElement( axis );
+
+		// Rays parallel to a slab only need to start within it.
+		if ( Abs( direction ) < HELIUM_EPSILON )
+		{
+			if ( origin < boxMinimum || origin > boxMaximum )
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		float32_t inverseDirection = 1.0f / direction;
+		float32_t distance0 = ( boxMinimum - origin ) * inverseDirection;
+		float32_t distance1 = ( boxMaximum - origin ) * inverseDirection;
+		if ( distance0 > distance1 )
+		{
+			std::swap( distance0, distance1 );
+		}
+
+		entryDistance = Max( entryDistance, distance0 );
+		exitDistance = Min( exitDistance, distance1 );
+		if ( entryDistance > exitDistance )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// Constructor.
+GraphicsSceneBvh::GraphicsSceneBvh()
+	: m_builtObjectCount( 0 )
+	, m_removedObjectCount( 0 )
+	, m_builtLeafArea( 0.0f )
+	, m_leafArea( 0.0f )
+{
+}
+
+/// Destructor.
+GraphicsSceneBvh::~GraphicsSceneBvh()
+{
+}
+
+/// Add an object to this hierarchy or update its bounds.
+///
+/// Objects already in the tree have their leaf queued for refitting by the next Update(), while new objects are
+/// tested individually until the next rebuild.
+///
+/// @param[in] id    ID of the object.
+/// @param[in] rBox  World-space bounds of the object.
+///
+/// @see RemoveObject(), Update()
+void GraphicsSceneBvh::SetObjectBounds( size_t id, const Simd::AaBox& rBox )
+{
+	HELIUM_ASSERT( id < NumericLimits< uint32_t >::Maximum );
+
+	EnsureObjectCapacity( id );
+	m_objectBoxes[id] = rBox;
+
+	uint32_t leafIndex = m_objectLeaves[id];
+	if ( IsValid( leafIndex ) )
+	{
+		MarkLeafDirty( leafIndex );
+	}
+	else if ( IsInvalid( m_objectLooseIndices[id] ) )
+	{
+		AddLooseObject( static_cast< uint32_t >( id ) );
+	}
+}
+
+/// Remove an object from this hierarchy.
+///
+/// @param[in] id  ID of the object to remove.  Objects that are not in this hierarchy are ignored.
+///
+/// @see SetObjectBounds()
+void GraphicsSceneBvh::RemoveObject( size_t id )
+{
+	if ( id >= m_objectLeaves.GetSize() )
+	{
+		return;
+	}
+
+	uint32_t leafIndex = m_objectLeaves[id];
+	if ( IsValid( leafIndex ) )
+	{
+		// Removed objects keep their slot in the object order until the next rebuild, but are skipped by queries.
+		SetInvalid( m_objectLeaves[id] );
+		++m_removedObjectCount;
+		MarkLeafDirty( leafIndex );
+	}
+	else if ( IsValid( m_objectLooseIndices[id] ) )
+	{
+		RemoveLooseObject( static_cast< uint32_t >( id ) );
+	}
+}
+
+/// Remove all objects from this hierarchy.
+void GraphicsSceneBvh::Clear()
+{
+	m_nodes.Resize( 0 );
+	m_objectOrder.Resize( 0 );
+	m_objectBoxes.Resize( 0 );
+	m_objectLeaves.Resize( 0 );
+	m_objectLooseIndices.Resize( 0 );
+	m_looseObjects.Resize( 0 );
+	m_dirtyLeaves.Resize( 0 );
+
+	m_builtObjectCount = 0;
+	m_removedObjectCount = 0;
+	m_builtLeafArea = 0.0f;
+	m_leafArea = 0.0f;
+}
+
+/// Apply pending object changes.
+///
+/// Leaves containing objects whose bounds changed are refit, and the tree is rebuilt if too many objects have been
+/// added or removed since it was last built, or if refitting has grown the leaf bounds too far.
+void GraphicsSceneBvh::Update()
+{
+	Refit();
+
+	uint32_t treeObjectCount = m_builtObjectCount - m_removedObjectCount;
+	uint32_t looseObjectCount = static_cast< uint32_t >( m_looseObjects.GetSize() );
+
+	bool bRebuild =
+		looseObjectCount > Max( BVH_LOOSE_OBJECT_REBUILD_MIN, treeObjectCount / 8 ) ||
+		m_removedObjectCount > m_builtObjectCount / 4 ||
+		( m_builtLeafArea > 0.0f && m_leafArea > m_builtLeafArea * BVH_LEAF_AREA_REBUILD_RATIO );
+	if ( bRebuild )
+	{
+		Rebuild();
+	}
+}
+
+/// Find all objects with bounds that intersect a frustum.
+///
+/// Subtrees that lie entirely within the frustum are accepted without testing their objects individually.
+///
+/// @param[in]  rFrustum          Frustum to test.
+/// @param[out] pVisibilityMasks  Array of bit masks (one bit per object ID) in which to flag the objects found.  All
+///                               masks are cleared before testing.
+/// @param[in]  maskCount         Number of elements in the mask array.
+void GraphicsSceneBvh::QueryFrustum(
+	const Simd::Frustum& rFrustum,
+	uint32_t* pVisibilityMasks,
+	size_t maskCount ) const
+{
+	HELIUM_ASSERT( pVisibilityMasks || maskCount == 0 );
+	HELIUM_ASSERT( m_objectLeaves.GetSize() <= maskCount * 32 );
+
+	MemoryZero( pVisibilityMasks, maskCount * sizeof( uint32_t ) );
+
+	if ( !m_nodes.IsEmpty() )
+	{
+		uint32_t nodeStack[BVH_NODE_STACK_SIZE];
+		nodeStack[0] = 0;
+		size_t nodeStackSize = 1;
+
+		while ( nodeStackSize != 0 )
+		{
+			const Node& rNode = m_nodes[nodeStack[--nodeStackSize]];
+			if ( rNode.bEmpty || !rFrustum.Intersects( rNode.bounds ) )
+			{
+				continue;
+			}
+
+			bool bContained = rFrustum.Contains( rNode.bounds );
+			if ( !bContained && IsValid( rNode.leftChild ) )
+			{
+				HELIUM_ASSERT( nodeStackSize + 2 <= BVH_NODE_STACK_SIZE );
+				nodeStack[nodeStackSize++] = rNode.leftChild;
+				nodeStack[nodeStackSize++] = rNode.leftChild + 1;
+
+				continue;
+			}
+
+			const uint32_t* pObjectIds = m_objectOrder.GetData() + rNode.firstObject;
+			for ( uint32_t objectIndex = 0; objectIndex < rNode.objectCount; ++objectIndex )
+			{
+				uint32_t id = pObjectIds[objectIndex];
+				if ( IsValid( m_objectLeaves[id] ) && ( bContained || rFrustum.Intersects( m_objectBoxes[id] ) ) )
+				{
+					pVisibilityMasks[id / 32] |= 1U << ( id % 32 );
+				}
+			}
+		}
+	}
+
+	size_t looseObjectCount = m_looseObjects.GetSize();
+	for ( size_t looseIndex = 0; looseIndex < looseObjectCount; ++looseIndex )
+	{
+		uint32_t id = m_looseObjects[looseIndex];
+		if ( rFrustum.Intersects( m_objectBoxes[id] ) )
+		{
+			pVisibilityMasks[id / 32] |= 1U << ( id % 32 );
+		}
+	}
+}
+
+/// Find all objects with bounds that overlap a sphere.
+///
+/// @param[in]  rSphere     Sphere to test.
+/// @param[out] rObjectIds  Array to which the IDs of the objects found will be appended, in no particular order.
+void GraphicsSceneBvh::QuerySphere( const Simd::Sphere& rSphere, DynamicArray< size_t >& rObjectIds ) const
+{
+	if ( !m_nodes.IsEmpty() )
+	{
+		uint32_t nodeStack[BVH_NODE_STACK_SIZE];
+		nodeStack[0] = 0;
+		size_t nodeStackSize = 1;
+
+		while ( nodeStackSize != 0 )
+		{
+			const Node& rNode = m_nodes[nodeStack[--nodeStackSize]];
+			if ( rNode.bEmpty || !SphereOverlapsBox( rSphere, rNode.bounds ) )
+			{
+				continue;
+			}
+
+			if ( IsValid( rNode.leftChild ) )
+			{
+				HELIUM_ASSERT( nodeStackSize + 2 <= BVH_NODE_STACK_SIZE );
+				nodeStack[nodeStackSize++] = rNode.leftChild;
+				nodeStack[nodeStackSize++] = rNode.leftChild + 1;
+
+				continue;
+			}
+
+			const uint32_t* pObjectIds = m_objectOrder.GetData() + rNode.firstObject;
+			for ( uint32_t objectIndex = 0; objectIndex < rNode.objectCount; ++objectIndex )
+			{
+				uint32_t id = pObjectIds[objectIndex];
+				if ( IsValid( m_objectLeaves[id] ) && SphereOverlapsBox( rSphere, m_objectBoxes[id] ) )
+				{
+					rObjectIds.Push( id );
+				}
+			}
+		}
+	}
+
+	size_t looseObjectCount = m_looseObjects.GetSize();
+	for ( size_t looseIndex = 0; looseIndex < looseObjectCount; ++looseIndex )
+	{
+		uint32_t id = m_looseObjects[looseIndex];
+		if ( SphereOverlapsBox( rSphere, m_objectBoxes[id] ) )
+		{
+			rObjectIds.Push( id );
+		}
+	}
+}
+
+/// Find all objects with bounds crossed by a ray segment.
+///
+/// @param[in]  rOrigin      Ray origin.
+/// @param[in]  rDirection   Ray direction (distances are measured in multiples of its length).
+/// @param[in]  maxDistance  Distance along the ray at which to stop testing.
+/// @param[out] rObjectIds   Array to which the IDs of the objects found will be appended, in no particular order.
+void GraphicsSceneBvh::QueryRay(
+	const Simd::Vector3& rOrigin,
+	const Simd::Vector3& rDirection,
+	float32_t maxDistance,
+	DynamicArray< size_t >& rObjectIds ) const
+{
+	if ( !m_nodes.IsEmpty() )
+	{
+		uint32_t nodeStack[BVH_NODE_STACK_SIZE];
+		nodeStack[0] = 0;
+		size_t nodeStackSize = 1;
+
+		while ( nodeStackSize != 0 )
+		{
+			const Node& rNode = m_nodes[nodeStack[--nodeStackSize]];
+			if ( rNode.bEmpty || !RayOverlapsBox( rOrigin, rDirection, maxDistance, rNode.bounds ) )
+			{
+				continue;
+			}
+
+			if ( IsValid( rNode.leftChild ) )
+			{
+				HELIUM_ASSERT( nodeStackSize + 2 <= BVH_NODE_STACK_SIZE );
+				nodeStack[nodeStackSize++] = rNode.leftChild;
+				nodeStack[nodeStackSize++] = rNode.leftChild + 1;
+
+				continue;
+			}
+
+			const uint32_t* pObjectIds = m_objectOrder.GetData() + rNode.firstObject;
+			for ( uint32_t objectIndex = 0; objectIndex < rNode.objectCount; ++objectIndex )
+			{
+				uint32_t id = pObjectIds[objectIndex];
+				if ( IsValid( m_objectLeaves[id] ) &&
+					RayOverlapsBox( rOrigin, rDirection, maxDistance, m_objectBoxes[id] ) )
+				{
+					rObjectIds.Push( id );
+				}
+			}
+		}
+	}
+
+	size_t looseObjectCount = m_looseObjects.GetSize();
+	for ( size_t looseIndex = 0; looseIndex < looseObjectCount; ++looseIndex )
+	{
+		uint32_t id = m_looseObjects[looseIndex];
+		if ( RayOverlapsBox( rOrigin, rDirection, maxDistance, m_objectBoxes[id] ) )
+		{
+			rObjectIds.Push( id );
+		}
+	}
+}
+
+/// Make sure the per-object arrays can hold an object with the given ID.
+///
+/// @param[in] id  Object ID.
+void GraphicsSceneBvh::EnsureObjectCapacity( size_t id )
+{
+	size_t objectCapacity = m_objectLeaves.GetSize();
+	if ( id < objectCapacity )
+	{
+		return;
+	}
+
+	m_objectBoxes.Resize( id + 1 );
+	m_objectLeaves.Resize( id + 1 );
+	m_objectLooseIndices.Resize( id + 1 );
+
+	for ( size_t objectIndex = objectCapacity; objectIndex <= id; ++objectIndex )
+	{
+		SetInvalid( m_objectLeaves[objectIndex] );
+		SetInvalid( m_objectLooseIndices[objectIndex] );
+	}
+}
+
+/// Add an object to the list of objects tested outside the tree.
+///
+/// @param[in] id  Object ID.
+void GraphicsSceneBvh::AddLooseObject( uint32_t id )
+{
+	HELIUM_ASSERT( IsInvalid( m_objectLooseIndices[id] ) );
+
+	m_objectLooseIndices[id] = static_cast< uint32_t >( m_looseObjects.GetSize() );
+	m_looseObjects.Push( id );
+}
+
+/// Remove an object from the list of objects tested outside the tree.
+///
+/// @param[in] id  Object ID.
+void GraphicsSceneBvh::RemoveLooseObject( uint32_t id )
+{
+	uint32_t looseIndex = m_objectLooseIndices[id];
+	HELIUM_ASSERT( looseIndex < m_looseObjects.GetSize() );
+
+	uint32_t lastId = m_looseObjects[m_looseObjects.GetSize() - 1];
+	m_looseObjects[looseIndex] = lastId;
+	m_objectLooseIndices[lastId] = looseIndex;
+	m_looseObjects.Pop();
+
+	SetInvalid( m_objectLooseIndices[id] );
+}
+
+/// Queue a leaf node for refitting.
+///
+/// @param[in] leafIndex  Index of the leaf node.
+void GraphicsSceneBvh::MarkLeafDirty( uint32_t leafIndex )
+{
+	Node& rLeaf = m_nodes[leafIndex];
+	HELIUM_ASSERT( IsInvalid( rLeaf.leftChild ) );
+
+	if ( !rLeaf.bDirty )
+	{
+		rLeaf.bDirty = true;
+		m_dirtyLeaves.Push( leafIndex );
+	}
+}
+
+/// Recompute the bounds of each dirty leaf from its remaining objects and propagate the change to its ancestors.
+void GraphicsSceneBvh::Refit()
+{
+	size_t dirtyLeafCount = m_dirtyLeaves.GetSize();
+	for ( size_t dirtyIndex = 0; dirtyIndex < dirtyLeafCount; ++dirtyIndex )
+	{
+		uint32_t leafIndex = m_dirtyLeaves[dirtyIndex];
+		Node& rLeaf = m_nodes[leafIndex];
+		HELIUM_ASSERT( rLeaf.bDirty );
+		rLeaf.bDirty = false;
+
+		if ( !rLeaf.bEmpty )
+		{
+			m_leafArea -= GetBoxSurfaceArea( rLeaf.bounds );
+		}
+
+		rLeaf.bEmpty = true;
+
+		const uint32_t* pObjectIds = m_objectOrder.GetData() + rLeaf.firstObject;
+		for ( uint32_t objectIndex = 0; objectIndex < rLeaf.objectCount; ++objectIndex )
+		{
+			uint32_t id = pObjectIds[objectIndex];
+			if ( m_objectLeaves[id] != leafIndex )
+			{
+				continue;
+			}
+
+			rLeaf.bounds = ( rLeaf.bEmpty ? m_objectBoxes[id] : MergeBoxes( rLeaf.bounds, m_objectBoxes[id] ) );
+			rLeaf.bEmpty = false;
+		}
+
+		if ( !rLeaf.bEmpty )
+		{
+			m_leafArea += GetBoxSurfaceArea( rLeaf.bounds );
+		}
+
+		for ( uint32_t nodeIndex = rLeaf.parent; IsValid( nodeIndex ); nodeIndex = m_nodes[nodeIndex].parent )
+		{
+			Node& rNode = m_nodes[nodeIndex];
+			const Node& rLeftChild = m_nodes[rNode.leftChild];
+			const Node& rRightChild = m_nodes[rNode.leftChild + 1];
+
+			rNode.bEmpty = rLeftChild.bEmpty && rRightChild.bEmpty;
+			if ( rLeftChild.bEmpty )
+			{
+				rNode.bounds = rRightChild.bounds;
+			}
+			else if ( rRightChild.bEmpty )
+			{
+				rNode.bounds = rLeftChild.bounds;
+			}
+			else
+			{
+				rNode.bounds = MergeBoxes( rLeftChild.bounds, rRightChild.bounds );
+			}
+		}
+	}
+
+	m_dirtyLeaves.Resize( 0 );
+}
+
+/// Rebuild the tree from every object currently in this hierarchy.
+void GraphicsSceneBvh::Rebuild()
+{
+	// Gather the objects still in the tree followed by the loose objects.
+	size_t orderCount = m_objectOrder.GetSize();
+	size_t objectCount = 0;
+	for ( size_t orderIndex = 0; orderIndex < orderCount; ++orderIndex )
+	{
+		uint32_t id = m_objectOrder[orderIndex];
+		if ( IsValid( m_objectLeaves[id] ) )
+		{
+			m_objectOrder[objectCount++] = id;
+		}
+	}
+
+	m_objectOrder.Resize( objectCount );
+
+	size_t looseObjectCount = m_looseObjects.GetSize();
+	for ( size_t looseIndex = 0; looseIndex < looseObjectCount; ++looseIndex )
+	{
+		uint32_t id = m_looseObjects[looseIndex];
+		SetInvalid( m_objectLooseIndices[id] );
+		m_objectOrder.Push( id );
+	}
+
+	m_looseObjects.Resize( 0 );
+	m_dirtyLeaves.Resize( 0 );
+	m_nodes.Resize( 0 );
+
+	objectCount = m_objectOrder.GetSize();
+	m_builtObjectCount = static_cast< uint32_t >( objectCount );
+	m_removedObjectCount = 0;
+	m_leafArea = 0.0f;
+
+	if ( objectCount != 0 )
+	{
+		Node rootNode;
+		rootNode.firstObject = 0;
+		rootNode.objectCount = static_cast< uint32_t >( objectCount );
+		SetInvalid( rootNode.leftChild );
+		SetInvalid( rootNode.parent );
+		rootNode.bEmpty = false;
+		rootNode.bDirty = false;
+		m_nodes.Push( rootNode );
+
+		uint32_t nodeStack[BVH_NODE_STACK_SIZE];
+		nodeStack[0] = 0;
+		size_t nodeStackSize = 1;
+
+		while ( nodeStackSize != 0 )
+		{
+			uint32_t nodeIndex = nodeStack[--nodeStackSize];
+			uint32_t firstObject = m_nodes[nodeIndex].firstObject;
+			uint32_t nodeObjectCount = m_nodes[nodeIndex].objectCount;
+			uint32_t* pObjectIds = m_objectOrder.GetData() + firstObject;
+
+			// Compute the node bounds along with the bounds of the object centers used to pick a split axis.
+			Simd::AaBox bounds = m_objectBoxes[pObjectIds[0]];
+			Simd::Vector3 centerMinimum = ( bounds.GetMinimum() + bounds.GetMaximum() ) * 0.5f;
+			Simd::Vector3 centerMaximum = centerMinimum;
+			for ( uint32_t objectIndex = 1; objectIndex < nodeObjectCount; ++objectIndex )
+			{
+				const Simd::AaBox& rObjectBox = m_objectBoxes[pObjectIds[objectIndex]];
+				bounds = MergeBoxes( bounds, rObjectBox );
+
+				Simd::Vector3 center = ( rObjectBox.GetMinimum() + rObjectBox.GetMaximum() ) * 0.5f;
+				centerMinimum = Simd::Vector3( Helium::Simd::MinF32( centerMinimum.GetSimdVector(), center.GetSimdVector() ) );
+				centerMaximum = Simd::Vector3( Helium::Simd::MaxF32( centerMaximum.GetSimdVector(), center.GetSimdVector() ) );
+			}
+
+			m_nodes[nodeIndex].bounds = bounds;
+
+			if ( nodeObjectCount <= LEAF_OBJECT_COUNT_MAX )
+			{
+				for ( uint32_t objectIndex = 0; objectIndex < nodeObjectCount; ++objectIndex )
+				{
+					m_objectLeaves[pObjectIds[objectIndex]] = nodeIndex;
+				}
+
+				m_leafArea += GetBoxSurfaceArea( bounds );
+
+				continue;
+			}
+
+			// Split at the median object along the axis with the widest spread of object centers.
+			Simd::Vector3 centerExtents = centerMaximum - centerMinimum;
+			size_t splitAxis = 0;
+			for ( size_t axis = 1; axis < 3; ++axis )
+			{
+				if ( centerExtents.GetElement( axis ) > centerExtents.GetElement( splitAxis ) )
+				{
+					splitAxis = axis;
+				}
+			}
+
+			uint32_t leftObjectCount = nodeObjectCount / 2;
+			std::nth_element(
+				pObjectIds,
+				pObjectIds + leftObjectCount,
+				pObjectIds + nodeObjectCount,
+				ObjectCenterCompare( m_objectBoxes.GetData(), splitAxis ) );
+
+			uint32_t leftChild = static_cast< uint32_t >( m_nodes.GetSize() );
+			m_nodes[nodeIndex].leftChild = leftChild;
+
+			Node childNode;
+			SetInvalid( childNode.leftChild );
+			childNode.parent = nodeIndex;
+			childNode.bEmpty = false;
+			childNode.bDirty = false;
+
+			childNode.firstObject = firstObject;
+			childNode.objectCount = leftObjectCount;
+			m_nodes.Push( childNode );
+
+			childNode.firstObject = firstObject + leftObjectCount;
+			childNode.objectCount = nodeObjectCount - leftObjectCount;
+			m_nodes.Push( childNode );
+
+			HELIUM_ASSERT( nodeStackSize + 2 <= BVH_NODE_STACK_SIZE );
+			nodeStack[nodeStackSize++] = leftChild;
+			nodeStack[nodeStackSize++] = leftChild + 1;
+		}
+	}
+
+	m_builtLeafArea = m_leafArea;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/AaBox.h"
+#include "MathSimd/Frustum.h"
+#include "MathSimd/Sphere.h"
+
+namespace Helium
+{
+    /// Bounding volume hierarchy over the objects of a graphics scene.
+    ///
+    /// The hierarchy is a binary tree of axis-aligned boxes built by splitting objects at the median of their longest
+    /// axis.  Each node covers a contiguous range of the object order array, so a node found to lie entirely within a
+    /// query volume accepts all of its objects without testing them individually.
+    ///
+    /// Changing the bounds of an object already in the tree marks its leaf for refitting, which is performed by
+    /// Update() along with any rebuild needed once refitting has degraded the tree too far.  Objects added since the
+    /// last build are kept in a separate list and tested individually until the next rebuild.
+    class HELIUM_GRAPHICS_API GraphicsSceneBvh : NonCopyable
+    {
+    public:
+        /// Maximum number of objects in each leaf node.
+        static const uint32_t LEAF_OBJECT_COUNT_MAX = 8;
+
+        /// @name Construction/Destruction
+        //@{
+        GraphicsSceneBvh();
+        ~GraphicsSceneBvh();
+        //@}
+
+        /// @name Object Management
+        //@{
+        void SetObjectBounds( size_t id, const Simd::AaBox& rBox );
+        void RemoveObject( size_t id );
+        void Clear();
+
+        void Update();
+        //@}
+
+        /// @name Queries
+        //@{
+        void QueryFrustum( const Simd::Frustum& rFrustum, uint32_t* pVisibilityMasks, size_t maskCount ) const;
+        void QuerySphere( const Simd::Sphere& rSphere, DynamicArray< size_t >& rObjectIds ) const;
+        void QueryRay(
+            const Simd::Vector3& rOrigin, const Simd::Vector3& rDirection, float32_t maxDistance,
+            DynamicArray< size_t >& rObjectIds ) const;
+        //@}
+
+    private:
+        /// Tree node.
+        struct Node
+        {
+            /// Bounds of all objects in this node's subtree.
+            Simd::AaBox bounds;
+            /// Index of the first object in this node's subtree within the object order array.
+            uint32_t firstObject;
+            /// Number of objects in this node's subtree (including objects removed since the last build).
+            uint32_t objectCount;
+            /// Index of the left child node (the right child immediately follows it), or invalid for leaf nodes.
+            uint32_t leftChild;
+            /// Index of the parent node, or invalid for the root node.
+            uint32_t parent;
+            /// True if every object in this node's subtree has been removed.
+            bool bEmpty;
+            /// True if this node is a leaf queued for refitting.
+            bool bDirty;
+        };
+
+        /// Tree nodes (the root node is always first, and parents always precede their children).
+        DynamicArray< Node > m_nodes;
+        /// Object IDs, ordered so that each node's subtree is contiguous.
+        DynamicArray< uint32_t > m_objectOrder;
+
+        /// Bounds of each object, indexed by object ID.
+        DynamicArray< Simd::AaBox > m_objectBoxes;
+        /// Leaf node containing each object, or invalid if the object is not in the tree.
+        DynamicArray< uint32_t > m_objectLeaves;
+        /// Index of each object in the loose object list, or invalid if the object is not in the list.
+        DynamicArray< uint32_t > m_objectLooseIndices;
+
+        /// Objects added since the last build.
+        DynamicArray< uint32_t > m_looseObjects;
+        /// Leaf nodes queued for refitting.
+        DynamicArray< uint32_t > m_dirtyLeaves;
+
+        /// Number of objects in the tree at the time it was last built.
+        uint32_t m_builtObjectCount;
+        /// Number of objects removed from the tree since it was last built.
+        uint32_t m_removedObjectCount;
+        /// Total surface area of all leaf nodes at the time the tree was last built.
+        float32_t m_builtLeafArea;
+        /// Current total surface area of all leaf nodes.
+        float32_t m_leafArea;
+
+        /// @name Private Utility Functions
+        //@{
+        void EnsureObjectCapacity( size_t id );
+        void AddLooseObject( uint32_t id );
+        void RemoveLooseObject( uint32_t id );
+        void MarkLeafDirty( uint32_t leafIndex );
+
+        void Refit();
+        void Rebuild();
+        //@}
+    };
+}
@@ -20,7 +20,10 @@ using namespace Helium;
 
 /// Constructor.
 Mesh::Mesh()
-: m_vertexBufferLoadId( Invalid< size_t >() )
+: m_lodGenerationCount( 0 )
+, m_lodTriangleRatio( 0.5f )
+, m_lodMaxError( 0.02f )
+, m_vertexBufferLoadId( Invalid< size_t >() )
 , m_indexBufferLoadId( Invalid< size_t >() )
 {
 }
@@ -49,6 +52,9 @@ void Mesh::RefCountPreDestroy()
 void Mesh::PopulateMetaType(Reflect::MetaStruct& comp)
 {
     comp.AddField(&Mesh::m_materials, "m_materials");
+    comp.AddField(&Mesh::m_lodGenerationCount, "m_lodGenerationCount");
+    comp.AddField(&Mesh::m_lodTriangleRatio, "m_lodTriangleRatio");
+    comp.AddField(&Mesh::m_lodMaxError, "m_lodMaxError");
 }
 
 /// @copydoc Asset::NeedsPrecacheResourceData()
@@ -135,7 +141,9 @@ bool Mesh::BeginPrecacheResourceData()
             m_spIndexBuffer = pRenderer->CreateIndexBuffer(
                 indexDataSize,
                 RENDERER_BUFFER_USAGE_STATIC,
-                RENDERER_INDEX_FORMAT_UINT16 );
+                ( m_persistentResourceData.m_bUses32BitIndices
+                  ? RENDERER_INDEX_FORMAT_UINT32
+                  : RENDERER_INDEX_FORMAT_UINT16 ) );
             if( !m_spIndexBuffer )
             {
                 HELIUM_TRACE(
@@ -212,6 +220,7 @@ bool Mesh::TryFinishPrecacheResourceData()
 Mesh::PersistentResourceData::PersistentResourceData()
 : m_vertexCount( 0 )
 , m_triangleCount( 0 )
+, m_bUses32BitIndices( false )
 #if !HELIUM_USE_GRANNY_ANIMATION
 , m_boneCount( 0 )
 #endif
@@ -224,8 +233,10 @@ void Mesh::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &PersistentResourceData::m_sectionVertexCounts,      "m_sectionVertexCounts" );
     comp.AddField( &PersistentResourceData::m_sectionTriangleCounts,    "m_sectionTriangleCounts" );
     comp.AddField( &PersistentResourceData::m_skinningPaletteMap,       "m_skinningPaletteMap" );
+    comp.AddField( &PersistentResourceData::m_lodSectionTriangleCounts, "m_lodSectionTriangleCounts" );
     comp.AddField( &PersistentResourceData::m_vertexCount,              "m_vertexCount" );
     comp.AddField( &PersistentResourceData::m_triangleCount,            "m_triangleCount" );
+    comp.AddField( &PersistentResourceData::m_bUses32BitIndices,        "m_bUses32BitIndices" );
     comp.AddField( &PersistentResourceData::m_bounds,                   "m_bounds" );
 #if !HELIUM_USE_GRANNY_ANIMATION
     comp.AddField( &PersistentResourceData::m_boneCount,                "m_boneCount" );
@@ -248,6 +259,41 @@ bool Helium::Mesh::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
 
     _object->CopyTo(&m_persistentResourceData);
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+    // Build the inverse mesh-space reference pose used for skinning.  Parent bones always precede their children.
+    size_t boneCount = m_persistentResourceData.m_boneCount;
+    m_inverseReferencePose.Resize( 0 );
+    if( boneCount != 0 &&
+        m_persistentResourceData.m_pParentBoneIndices.GetSize() == boneCount &&
+        m_persistentResourceData.m_pReferencePose.GetSize() == boneCount )
+    {
+        m_inverseReferencePose.Resize( boneCount );
+
+        for( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+        {
+            const Simd::Matrix44& rReferenceTransform = m_persistentResourceData.m_pReferencePose[ boneIndex ];
+            uint8_t parentIndex = m_persistentResourceData.m_pParentBoneIndices[ boneIndex ];
+            if( IsValid( parentIndex ) )
+            {
+                HELIUM_ASSERT( parentIndex < boneIndex );
+                m_inverseReferencePose[ boneIndex ].MultiplySet(
+                    rReferenceTransform,
+                    m_inverseReferencePose[ parentIndex ] );
+            }
+            else
+            {
+                m_inverseReferencePose[ boneIndex ] = rReferenceTransform;
+            }
+        }
+
+        // Invert the mesh-space transforms in place now that every child has been built from its parent.
+        for( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+        {
+            m_inverseReferencePose[ boneIndex ].Invert();
+        }
+    }
+#endif
+
     return true;
 }
 
@@ -45,16 +45,20 @@ namespace Helium
             static void PopulateMetaType( Reflect::MetaStruct& comp );
             
             /// Number of vertices used by each mesh section.
-            DynamicArray< uint16_t > m_sectionVertexCounts;
+            DynamicArray< uint32_t > m_sectionVertexCounts;
             /// Number of triangles in each mesh section.
             DynamicArray< uint32_t > m_sectionTriangleCounts;
             /// Skinning palette map (split by mesh section).
             DynamicArray< uint8_t > m_skinningPaletteMap;
+            /// Number of triangles in each mesh section for each simplified level of detail (grouped by level).
+            DynamicArray< uint32_t > m_lodSectionTriangleCounts;
         
             /// Vertex count.
             uint32_t m_vertexCount;
             /// Triangle count.
             uint32_t m_triangleCount;
+            /// True if the index buffer uses 32-bit indices, false if it uses 16-bit indices.
+            bool m_bUses32BitIndices;
         
             /// Mesh bounds.
             Simd::AaBox m_bounds;
@@ -112,6 +116,9 @@ namespace Helium
         inline uint32_t GetSectionTriangleCount( size_t sectionIndex ) const;
         const uint8_t* GetSectionSkinningPaletteMap( size_t sectionIndex ) const;
 
+        inline size_t GetLodCount() const;
+        inline uint32_t GetLodSectionTriangleCount( size_t lodIndex, size_t sectionIndex ) const;
+
         inline bool IsSkinned() const;
 #if HELIUM_USE_GRANNY_ANIMATION
         inline const Granny::MeshData& GetGrannyData() const;
@@ -120,6 +127,7 @@ namespace Helium
         inline const Name* GetBoneNames() const;
         inline const uint8_t* GetParentBoneIndices() const;
         inline const Simd::Matrix44* GetReferencePose() const;
+        inline const Simd::Matrix44* GetInverseReferencePose() const;
 #endif
 
         inline size_t GetMaterialCount() const;
@@ -127,6 +135,7 @@ namespace Helium
 
         inline uint32_t GetVertexCount() const;
         inline uint32_t GetTriangleCount() const;
+        inline bool Uses32BitIndices() const;
 
         inline const Simd::AaBox& GetBounds() const;
 
@@ -134,15 +143,32 @@ namespace Helium
         inline RIndexBuffer* GetIndexBuffer() const;
         //@}
 
+        /// @name Level of Detail Generation Settings
+        //@{
+        inline uint32_t GetLodGenerationCount() const;
+        inline float32_t GetLodTriangleRatio() const;
+        inline float32_t GetLodMaxError() const;
+        //@}
+
     private:
         
 #if HELIUM_USE_GRANNY_ANIMATION
         /// Granny-specific mesh data.
         Granny::MeshData m_grannyData;
+#else
+        /// Inverse of each bone's mesh-space reference pose transform (built when the persistent data is loaded).
+        DynamicArray< Simd::Matrix44 > m_inverseReferencePose;
 #endif
 
         /// Default material set.
         DynamicArray< MaterialPtr > m_materials;
+
+        /// Number of simplified levels of detail to generate when caching the mesh.
+        uint32_t m_lodGenerationCount;
+        /// Fraction of the triangles of each level of detail to keep when generating the next level.
+        float32_t m_lodTriangleRatio;
+        /// Maximum error introduced when simplifying each level of detail, relative to the size of the mesh.
+        float32_t m_lodMaxError;
         
         /// Vertex buffer.
         RVertexBufferPtr m_spVertexBuffer;
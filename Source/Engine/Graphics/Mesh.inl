@@ -46,6 +46,40 @@ namespace Helium
         return m_persistentResourceData.m_sectionTriangleCounts[ sectionIndex ];
     }
 
+    /// Get the number of simplified levels of detail cached for this mesh.
+    ///
+    /// The indices for each level of detail follow those of the full detail mesh in the index buffer, with each level
+    /// stored in sequence and the sections of each level stored in the same order as the full detail mesh.  Levels of
+    /// detail share the vertices of the full detail mesh.
+    ///
+    /// @return  Number of simplified levels of detail.
+    ///
+    /// @see GetLodSectionTriangleCount()
+    size_t Mesh::GetLodCount() const
+    {
+        size_t sectionCount = m_persistentResourceData.m_sectionTriangleCounts.GetSize();
+
+        return ( sectionCount != 0 ? m_persistentResourceData.m_lodSectionTriangleCounts.GetSize() / sectionCount : 0 );
+    }
+
+    /// Get the number of triangles in a specific mesh section for a simplified level of detail.
+    ///
+    /// @param[in] lodIndex      Level of detail index (zero for the first simplified level).
+    /// @param[in] sectionIndex  Mesh section index.
+    ///
+    /// @return  Number of triangles in the section at the specified level of detail.
+    ///
+    /// @see GetLodCount(), GetSectionTriangleCount()
+    uint32_t Mesh::GetLodSectionTriangleCount( size_t lodIndex, size_t sectionIndex ) const
+    {
+        size_t sectionCount = m_persistentResourceData.m_sectionTriangleCounts.GetSize();
+        HELIUM_ASSERT( sectionIndex < sectionCount );
+        HELIUM_ASSERT(
+            lodIndex * sectionCount + sectionIndex < m_persistentResourceData.m_lodSectionTriangleCounts.GetSize() );
+
+        return m_persistentResourceData.m_lodSectionTriangleCounts[ lodIndex * sectionCount + sectionIndex ];
+    }
+
     /// Get whether this mesh is a skinned mesh.
     ///
     /// @return  True if this is a skinned mesh, false if not.
@@ -119,6 +153,20 @@ namespace Helium
         return m_persistentResourceData.m_pReferencePose.GetData();
     }
 
+    /// Get the array containing the inverse of each bone's reference pose transform in mesh space.
+    ///
+    /// @return  Pointer to the array of inverse mesh-space reference pose bone transforms, or null if this mesh is not
+    ///          a skinned mesh.
+    const Simd::Matrix44* Mesh::GetInverseReferencePose() const
+    {
+        if( m_inverseReferencePose.IsEmpty() )
+        {
+            return NULL;
+        }
+
+        return m_inverseReferencePose.GetData();
+    }
+
 #endif  // HELIUM_USE_GRANNY_ANIMATION
 
     /// Get the number of materials assigned to this mesh's default material set.
@@ -163,6 +211,17 @@ namespace Helium
         return m_persistentResourceData.m_triangleCount;
     }
 
+    /// Get whether the index buffer of this mesh uses 32-bit indices.
+    ///
+    /// Meshes are cached with 16-bit indices unless a mesh section addresses more vertices than 16-bit indices can
+    /// reference.
+    ///
+    /// @return  True if the mesh uses 32-bit indices, false if it uses 16-bit indices.
+    bool Mesh::Uses32BitIndices() const
+    {
+        return m_persistentResourceData.m_bUses32BitIndices;
+    }
+
     /// Get the bounds of this mesh.
     ///
     /// @return  Axis-aligned bounding box encompassing this mesh.
@@ -190,4 +249,34 @@ namespace Helium
     {
         return m_spIndexBuffer;
     }
+
+    /// Get the number of simplified levels of detail to generate when caching this mesh.
+    ///
+    /// @return  Number of levels of detail to generate.
+    ///
+    /// @see GetLodTriangleRatio(), GetLodMaxError(), GetLodCount()
+    uint32_t Mesh::GetLodGenerationCount() const
+    {
+        return m_lodGenerationCount;
+    }
+
+    /// Get the fraction of triangles to keep from each level of detail when generating the next level.
+    ///
+    /// @return  Target triangle ratio between successive levels of detail.
+    ///
+    /// @see GetLodGenerationCount(), GetLodMaxError()
+    float32_t Mesh::GetLodTriangleRatio() const
+    {
+        return m_lodTriangleRatio;
+    }
+
+    /// Get the maximum error that simplifying each level of detail may introduce.
+    ///
+    /// @return  Maximum simplification error, relative to the size of the mesh.
+    ///
+    /// @see GetLodGenerationCount(), GetLodTriangleRatio()
+    float32_t Mesh::GetLodMaxError() const
+    {
+        return m_lodMaxError;
+    }
 }
@@ -229,6 +229,35 @@ bool RenderResourceManager::Initialize()
 	m_staticMeshVertexDescriptions[1] = pRenderer->CreateVertexDescription( vertexElements, 6 );
 	HELIUM_ASSERT( m_staticMeshVertexDescriptions[1] );
 
+	// Instanced static meshes read their world transform rows from a second, per-instance vertex stream.
+	if ( pRenderer->SupportsAnyFeature( RENDERER_FEATURE_FLAG_INSTANCING ) )
+	{
+		RVertexDescription::Element instancedVertexElements[HELIUM_ARRAY_COUNT( vertexElements ) + 3];
+
+		for ( size_t textureCoordinateSetIndex = 0;
+			textureCoordinateSetIndex < MESH_TEXTURE_COORDINATE_SET_COUNT_MAX;
+			++textureCoordinateSetIndex )
+		{
+			size_t vertexElementCount = 5 + textureCoordinateSetIndex;
+			ArrayCopy( instancedVertexElements, vertexElements, vertexElementCount );
+
+			for ( size_t rowIndex = 0; rowIndex < 3; ++rowIndex )
+			{
+				RVertexDescription::Element& rElement = instancedVertexElements[vertexElementCount + rowIndex];
+				rElement.type = RENDERER_VERTEX_DATA_TYPE_FLOAT32_4;
+				rElement.semantic = RENDERER_VERTEX_SEMANTIC_TEXCOORD;
+				rElement.semanticIndex = static_cast<uint8_t>( 4 + rowIndex );
+				rElement.bufferIndex = 1;
+				rElement.instanceStepRate = 1;
+			}
+
+			m_instancedStaticMeshVertexDescriptions[textureCoordinateSetIndex] = pRenderer->CreateVertexDescription(
+				instancedVertexElements,
+				vertexElementCount + 3 );
+			HELIUM_ASSERT( m_instancedStaticMeshVertexDescriptions[textureCoordinateSetIndex] );
+		}
+	}
+
 	vertexElements[1].type = RENDERER_VERTEX_DATA_TYPE_UINT8_4_NORM;
 	vertexElements[1].semantic = RENDERER_VERTEX_SEMANTIC_BLENDWEIGHT;
 	vertexElements[1].semanticIndex = 0;
@@ -473,6 +502,7 @@ void RenderResourceManager::Cleanup()
 		++descriptionIndex )
 	{
 		m_staticMeshVertexDescriptions[descriptionIndex].Release();
+		m_instancedStaticMeshVertexDescriptions[descriptionIndex].Release();
 	}
 
 	m_spSkinnedMeshVertexDescription.Release();
@@ -804,6 +834,35 @@ RVertexDescription* RenderResourceManager::GetSkinnedMeshVertexDescription() con
 	return m_spSkinnedMeshVertexDescription;
 }
 
+/// Get the description to use when drawing meshes with the given vertex description using hardware instancing.
+///
+/// The returned description reads the mesh vertices from the first vertex buffer and a 3x4 world transform for each
+/// instance (TEXCOORD4 through TEXCOORD6, MESH_INSTANCE_VERTEX_STRIDE bytes per instance) from the second.
+///
+/// @param[in] pDescription  Vertex description of the mesh to instance.
+///
+/// @return  Instanced vertex description, or null if the mesh vertex format cannot be instanced (only static mesh
+///          vertices are supported) or hardware instancing is not available.
+///
+/// @see GetStaticMeshVertexDescription()
+RVertexDescription* RenderResourceManager::GetInstancedVertexDescription( RVertexDescription* pDescription ) const
+{
+	if ( pDescription )
+	{
+		for ( size_t descriptionIndex = 0;
+			descriptionIndex < HELIUM_ARRAY_COUNT( m_staticMeshVertexDescriptions );
+			++descriptionIndex )
+		{
+			if ( m_staticMeshVertexDescriptions[descriptionIndex].Get() == pDescription )
+			{
+				return m_instancedStaticMeshVertexDescriptions[descriptionIndex];
+			}
+		}
+	}
+
+	return NULL;
+}
+
 /// Get the texture to which scene color data is written each frame.
 ///
 /// @return  Scene color target texture.
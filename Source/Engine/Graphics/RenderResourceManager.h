@@ -30,6 +30,9 @@ namespace Helium
 	public:
 		/// Maximum number of texture coordinate sets allowed for meshes.
 		static const size_t MESH_TEXTURE_COORDINATE_SET_COUNT_MAX = 2;
+		/// Stride of the per-instance vertex stream used when drawing static meshes with hardware instancing (one
+		/// 3x4 world transform per instance).
+		static const uint32_t MESH_INSTANCE_VERTEX_STRIDE = sizeof( float32_t ) * 12;
 
 		/// Standard rasterizer states.
 		enum ERasterizerState
@@ -150,6 +153,7 @@ namespace Helium
 		RVertexDescription* GetProjectedVertexDescription() const;
 		RVertexDescription* GetStaticMeshVertexDescription( size_t textureCoordinateSetCount ) const;
 		RVertexDescription* GetSkinnedMeshVertexDescription() const;
+		RVertexDescription* GetInstancedVertexDescription( RVertexDescription* pDescription ) const;
 		//@}
 
 		/// @name Resource Access
@@ -200,6 +204,9 @@ namespace Helium
 		RVertexDescriptionPtr m_spProjectedVertexDescription;
 		/// Static mesh vertex descriptions.
 		RVertexDescriptionPtr m_staticMeshVertexDescriptions[MESH_TEXTURE_COORDINATE_SET_COUNT_MAX];
+		/// Static mesh vertex descriptions with an additional per-instance transform stream (null if hardware
+		/// instancing is not supported).
+		RVertexDescriptionPtr m_instancedStaticMeshVertexDescriptions[MESH_TEXTURE_COORDINATE_SET_COUNT_MAX];
 		/// Skinned mesh vertex description.
 		RVertexDescriptionPtr m_spSkinnedMeshVertexDescription;
 
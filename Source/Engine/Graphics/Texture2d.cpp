@@ -4,6 +4,7 @@
 #include "Rendering/RendererUtil.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RTexture2d.h"
+#include "Graphics/TextureStreamer.h"
 #include "Reflect/TranslatorDeduction.h"
 
 HELIUM_IMPLEMENT_ASSET( Helium::Texture2d, Graphics, AssetType::FLAG_NO_TEMPLATE );
@@ -31,6 +32,10 @@ void Texture2d::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& c
 
 /// Constructor.
 Texture2d::Texture2d()
+: m_residentMipLevel( 0 )
+, m_initialMipLevel( 0 )
+, m_streamingMipLevel( 0 )
+, m_streamerIndex( Invalid< size_t >() )
 {
 }
 
@@ -39,6 +44,14 @@ Texture2d::~Texture2d()
 {
 }
 
+/// @copydoc Asset::RefCountPreDestroy()
+void Texture2d::RefCountPreDestroy()
+{
+    ReleaseStreaming();
+
+    Base::RefCountPreDestroy();
+}
+
 /// @copydoc Asset::NeedsPrecacheResourceData()
 bool Texture2d::NeedsPrecacheResourceData() const
 {
@@ -56,14 +69,205 @@ bool Texture2d::BeginPrecacheResourceData()
         return true;
     }
 
-    const uint32_t baseLevelWidth = m_persistentResourceData.m_baseLevelWidth;
-    const uint32_t baseLevelHeight = m_persistentResourceData.m_baseLevelHeight;
+    // Only load the smallest mip levels up front if texture streaming is enabled.
+    const uint32_t mipCount = m_persistentResourceData.m_mipCount;
+
+    m_initialMipLevel = 0;
+    TextureStreamer* pTextureStreamer = TextureStreamer::GetInstance();
+    if ( pTextureStreamer )
+    {
+        m_initialMipLevel = pTextureStreamer->GetInitialMipLevel(
+            m_persistentResourceData.m_baseLevelWidth,
+            m_persistentResourceData.m_baseLevelHeight,
+            mipCount );
+    }
+
+    RTexture2d* pTexture2d = CreateRenderResource( m_initialMipLevel );
+    if ( !pTexture2d )
+    {
+        return false;
+    }
+
+    m_spTexture = pTexture2d;
+    m_residentMipLevel = m_initialMipLevel;
+
+    BeginLoadMipLevels( pTexture2d, m_initialMipLevel, m_renderResourceLoadIds );
+
+    return true;
+}
+
+/// @copydoc Asset::TryFinishPrecacheResourceData()
+bool Texture2d::TryFinishPrecacheResourceData()
+{
+    // Check all pending load requests.
+    if( m_renderResourceLoadIds.IsEmpty() )
+    {
+        return true;
+    }
+
+    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
+    HELIUM_ASSERT( pTexture2d );
+
+    if( !TryFinishLoadMipLevels( pTexture2d, m_renderResourceLoadIds ) )
+    {
+        return false;
+    }
+
+    // Hand the texture over to the streamer if any of its larger mip levels were skipped.
+    if( m_initialMipLevel != 0 && IsInvalid( m_streamerIndex ) )
+    {
+        TextureStreamer* pTextureStreamer = TextureStreamer::GetInstance();
+        if( pTextureStreamer )
+        {
+            pTextureStreamer->RegisterTexture( this );
+        }
+    }
+
+    return true;
+}
+
+bool Texture2d::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+{
+    ReleaseStreaming();
+    m_spTexture.Release();
+    m_residentMipLevel = 0;
+    m_initialMipLevel = 0;
+
+    HELIUM_ASSERT(_object.ReferencesObject());
+    if (!_object.ReferencesObject())
+    {
+        return false;
+    }
+
+    _object->CopyTo(&m_persistentResourceData);
+
+    return true;
+}
+
+/// @copydoc Texture::GetRenderResource2d()
+RTexture2d* Texture2d::GetRenderResource2d() const
+{
+    return static_cast< RTexture2d* >( m_spTexture.Get() );
+}
+
+/// Get the size of the cached data for a mip chain.
+///
+/// @param[in] firstMipLevel  Index of the first mip level in the chain.
+///
+/// @return  Total size of the cached data for all mip levels from the given level down to the smallest level.
+size_t Texture2d::GetMipChainSize( uint32_t firstMipLevel ) const
+{
+    size_t size = 0;
+
+    const uint32_t mipCount = m_persistentResourceData.m_mipCount;
+    for ( uint32_t mipIndex = firstMipLevel; mipIndex < mipCount; ++mipIndex )
+    {
+        size += GetSubDataSize( mipIndex );
+    }
+
+    return size;
+}
+
+/// Get the index of the largest mip level needed to draw this texture at a given size on screen.
+///
+/// @param[in] projectedSize  Approximate size of the texture on screen, in pixels.
+///
+/// @return  Index of the smallest mip level whose largest dimension is at least the projected size.
+uint32_t Texture2d::GetRequiredMipLevel( float32_t projectedSize ) const
+{
     const uint32_t mipCount = m_persistentResourceData.m_mipCount;
+    if ( mipCount == 0 )
+    {
+        return 0;
+    }
+
+    uint32_t baseLevelSize = Max( m_persistentResourceData.m_baseLevelWidth, m_persistentResourceData.m_baseLevelHeight );
+
+    uint32_t mipLevel = 0;
+    while ( mipLevel + 1 < mipCount && static_cast< float32_t >( baseLevelSize >> ( mipLevel + 1 ) ) >= projectedSize )
+    {
+        ++mipLevel;
+    }
+
+    return mipLevel;
+}
+
+/// Begin loading a new mip chain for this texture.
+///
+/// A new render resource holding only the mip levels from the given level down is created and its data is loaded
+/// from the resource cache.  The current render resource remains in use until TryFinishStreamMipLevel() swaps in the
+/// new resource.
+///
+/// @param[in] mipLevel  Index of the first mip level to make resident.
+///
+/// @return  True if streaming was started, false if it failed or a change is already in progress.
+///
+/// @see TryFinishStreamMipLevel(), IsStreamingMipLevel()
+bool Texture2d::BeginStreamMipLevel( uint32_t mipLevel )
+{
+    HELIUM_ASSERT( mipLevel < m_persistentResourceData.m_mipCount );
+
+    if ( m_spStreamingTexture || !m_renderResourceLoadIds.IsEmpty() || mipLevel == m_residentMipLevel )
+    {
+        return false;
+    }
+
+    RTexture2d* pTexture2d = CreateRenderResource( mipLevel );
+    if ( !pTexture2d )
+    {
+        return false;
+    }
+
+    m_spStreamingTexture = pTexture2d;
+    m_streamingMipLevel = mipLevel;
+
+    BeginLoadMipLevels( pTexture2d, mipLevel, m_streamingLoadIds );
+
+    return true;
+}
+
+/// Check whether a mip level change has finished loading, swapping in the new render resource if so.
+///
+/// @return  True if no change is in progress or the change has completed, false if loading is still in progress.
+///
+/// @see BeginStreamMipLevel(), IsStreamingMipLevel()
+bool Texture2d::TryFinishStreamMipLevel()
+{
+    if ( !m_spStreamingTexture )
+    {
+        return true;
+    }
+
+    if ( !TryFinishLoadMipLevels( m_spStreamingTexture.Get(), m_streamingLoadIds ) )
+    {
+        return false;
+    }
+
+    m_spTexture = m_spStreamingTexture;
+    m_spStreamingTexture.Release();
+    m_residentMipLevel = m_streamingMipLevel;
+
+    return true;
+}
+
+/// Create a render resource for the mip chain starting at a given level.
+///
+/// @param[in] firstMipLevel  Index of the first mip level to include.
+///
+/// @return  Newly created texture render resource, or null if creation failed.
+RTexture2d* Texture2d::CreateRenderResource( uint32_t firstMipLevel ) const
+{
+    Renderer* pRenderer = Renderer::GetInstance();
+    HELIUM_ASSERT( pRenderer );
+
+    const uint32_t width = Max< uint32_t >( m_persistentResourceData.m_baseLevelWidth >> firstMipLevel, 1 );
+    const uint32_t height = Max< uint32_t >( m_persistentResourceData.m_baseLevelHeight >> firstMipLevel, 1 );
+    const uint32_t mipCount = m_persistentResourceData.m_mipCount - firstMipLevel;
     const int32_t pixelFormatIndex = m_persistentResourceData.m_pixelFormatIndex;
 
     RTexture2d* pTexture2d = pRenderer->CreateTexture2d(
-        baseLevelWidth,
-        baseLevelHeight,
+        width,
+        height,
         mipCount,
         static_cast< ERendererPixelFormat >( pixelFormatIndex ),
         RENDERER_BUFFER_USAGE_STATIC );
@@ -72,42 +276,58 @@ bool Texture2d::BeginPrecacheResourceData()
     {
         HELIUM_TRACE(
             TraceLevels::Error,
-            "Texture2d::BeginPrecacheResourceData(): Failed to create texture render resource (width: %" PRIu32 "; height: %" PRIu32 "; mip count: %" PRIu32 "; pixel format index: %" PRId32 ").\n",
-            baseLevelWidth,
-            baseLevelHeight,
+            "Texture2d::CreateRenderResource(): Failed to create texture render resource (width: %" PRIu32 "; height: %" PRIu32 "; mip count: %" PRIu32 "; pixel format index: %" PRId32 ").\n",
+            width,
+            height,
             mipCount,
             pixelFormatIndex );
-
-        return false;
     }
 
-    m_spTexture = pTexture2d;
+    return pTexture2d;
+}
 
-    m_renderResourceLoadIds.Reserve( mipCount );
-    m_renderResourceLoadIds.Resize( mipCount );
-    m_renderResourceLoadIds.Trim();
+/// Begin loading cached mip level data into a texture render resource.
+///
+/// @param[in]  pTexture2d     Render resource created for the mip chain starting at the given level.
+/// @param[in]  firstMipLevel  Index of the mip level loaded into the first level of the render resource.
+/// @param[out] rLoadIds       Async load IDs for each level of the render resource (invalid for levels that failed
+///                            to begin loading).
+///
+/// @see TryFinishLoadMipLevels()
+void Texture2d::BeginLoadMipLevels( RTexture2d* pTexture2d, uint32_t firstMipLevel, DynamicArray< size_t >& rLoadIds )
+{
+    HELIUM_ASSERT( pTexture2d );
+    HELIUM_ASSERT( rLoadIds.IsEmpty() );
 
-    const ERendererPixelFormat format = static_cast< ERendererPixelFormat >( pixelFormatIndex );
+    const uint32_t levelCount = pTexture2d->GetMipCount();
+
+    rLoadIds.Reserve( levelCount );
+    rLoadIds.Resize( levelCount );
+    rLoadIds.Trim();
+
+    const ERendererPixelFormat format = static_cast< ERendererPixelFormat >( m_persistentResourceData.m_pixelFormatIndex );
     HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
 
-    for ( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    for ( uint32_t levelIndex = 0; levelIndex < levelCount; ++levelIndex )
     {
-        SetInvalid( m_renderResourceLoadIds[ mipIndex ] );
+        SetInvalid( rLoadIds[ levelIndex ] );
+
+        uint32_t mipIndex = firstMipLevel + levelIndex;
 
         size_t pitch;
-        void* pMipData = pTexture2d->Map( mipIndex, pitch );
+        void* pMipData = pTexture2d->Map( levelIndex, pitch );
         HELIUM_ASSERT( pMipData );
         if ( !pMipData )
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
-                "Texture2d::BeginPrecacheResourceData(): Failed to lock mip level %" PRIu32 ".\n",
+                "Texture2d::BeginLoadMipLevels(): Failed to lock mip level %" PRIu32 ".\n",
                 mipIndex );
 
             continue;
         }
 
-        uint32_t mipLevelHeight = pTexture2d->GetHeight( mipIndex );
+        uint32_t mipLevelHeight = pTexture2d->GetHeight( levelIndex );
         size_t rowCount = RendererUtil::PixelToBlockRowCount( mipLevelHeight, format );
         size_t mipLevelSize = pitch * rowCount;
 
@@ -119,31 +339,37 @@ bool Texture2d::BeginPrecacheResourceData()
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
-                "Texture2d::BeginPrecacheResourceData(): Failed to begin loading of cached data for mip level %" PRIu32 ".\n",
+                "Texture2d::BeginLoadMipLevels(): Failed to begin loading of cached data for mip level %" PRIu32 ".\n",
                 mipIndex );
 
-            pTexture2d->Unmap( mipIndex );
+            pTexture2d->Unmap( levelIndex );
 
             continue;
         }
 
-        m_renderResourceLoadIds[ mipIndex ] = loadId;
+        rLoadIds[ levelIndex ] = loadId;
     }
-
-    return true;
 }
 
-/// @copydoc Asset::TryFinishPrecacheResourceData()
-bool Texture2d::TryFinishPrecacheResourceData()
+/// Check whether all pending mip level loads for a texture render resource have completed.
+///
+/// Each level whose load has completed is unmapped and its load ID invalidated.  Once all loads have completed, the
+/// load ID array is cleared.
+///
+/// @param[in]     pTexture2d  Render resource being loaded.
+/// @param[in,out] rLoadIds    Async load IDs for each level of the render resource.
+///
+/// @return  True if all loads have completed, false if any are still in progress.
+///
+/// @see BeginLoadMipLevels()
+bool Texture2d::TryFinishLoadMipLevels( RTexture2d* pTexture2d, DynamicArray< size_t >& rLoadIds )
 {
-    // Check all pending load requests.
-    size_t loadRequestCount = m_renderResourceLoadIds.GetSize();
+    size_t loadRequestCount = rLoadIds.GetSize();
     if( loadRequestCount == 0 )
     {
         return true;
     }
 
-    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
     HELIUM_ASSERT( pTexture2d );
     HELIUM_ASSERT( loadRequestCount == pTexture2d->GetMipCount() );
 
@@ -151,7 +377,7 @@ bool Texture2d::TryFinishPrecacheResourceData()
 
     for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestCount; ++loadRequestIndex )
     {
-        size_t loadId = m_renderResourceLoadIds[ loadRequestIndex ];
+        size_t loadId = rLoadIds[ loadRequestIndex ];
         if( IsInvalid( loadId ) )
         {
             continue;
@@ -164,7 +390,7 @@ bool Texture2d::TryFinishPrecacheResourceData()
             continue;
         }
 
-        SetInvalid( m_renderResourceLoadIds[ loadRequestIndex ] );
+        SetInvalid( rLoadIds[ loadRequestIndex ] );
         pTexture2d->Unmap( static_cast< uint32_t >( loadRequestIndex ) );
     }
 
@@ -173,28 +399,60 @@ bool Texture2d::TryFinishPrecacheResourceData()
         return false;
     }
 
-    m_renderResourceLoadIds.Clear();
+    rLoadIds.Clear();
 
     return true;
 }
 
-bool Texture2d::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+/// Block until all pending mip level loads for a texture render resource have completed.
+///
+/// Each level is unmapped once its load has completed, and the load ID array is cleared.
+///
+/// @param[in]     pTexture2d  Render resource being loaded.
+/// @param[in,out] rLoadIds    Async load IDs for each level of the render resource.
+///
+/// @see BeginLoadMipLevels(), TryFinishLoadMipLevels()
+void Texture2d::FinishLoadMipLevels( RTexture2d* pTexture2d, DynamicArray< size_t >& rLoadIds )
 {
-    m_spTexture.Release();
-
-    HELIUM_ASSERT(_object.ReferencesObject());
-    if (!_object.ReferencesObject())
+    size_t loadRequestCount = rLoadIds.GetSize();
+    if( loadRequestCount == 0 )
     {
-        return false;
+        return;
     }
 
-    _object->CopyTo(&m_persistentResourceData);
+    HELIUM_ASSERT( pTexture2d );
+    HELIUM_ASSERT( loadRequestCount == pTexture2d->GetMipCount() );
 
-    return true;
+    for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestCount; ++loadRequestIndex )
+    {
+        size_t loadId = rLoadIds[ loadRequestIndex ];
+        if( IsInvalid( loadId ) )
+        {
+            continue;
+        }
+
+        FinishLoadSubData( loadId );
+
+        pTexture2d->Unmap( static_cast< uint32_t >( loadRequestIndex ) );
+    }
+
+    rLoadIds.Clear();
 }
 
-/// @copydoc Texture::GetRenderResource2d()
-RTexture2d* Texture2d::GetRenderResource2d() const
+/// Wait for any mip level change in progress to finish and unregister this texture from the texture streamer.
+void Texture2d::ReleaseStreaming()
 {
-    return static_cast< RTexture2d* >( m_spTexture.Get() );
+    FinishLoadMipLevels( m_spStreamingTexture.Get(), m_streamingLoadIds );
+    m_spStreamingTexture.Release();
+
+    // The texture may still be queued for registration, in which case its streamer index is not yet valid.
+    TextureStreamer* pTextureStreamer = TextureStreamer::GetInstance();
+    if( pTextureStreamer )
+    {
+        pTextureStreamer->UnregisterTexture( this );
+    }
+    else
+    {
+        HELIUM_ASSERT( IsInvalid( m_streamerIndex ) );
+    }
 }
@@ -4,11 +4,18 @@
 
 namespace Helium
 {
+	HELIUM_DECLARE_RPTR( RTexture2d );
+
 	class Texture2d;
 	typedef Helium::StrongPtr< Texture2d > Texture2dPtr;
 	typedef Helium::StrongPtr< const Texture2d > ConstTexture2dPtr;
 
 	/// 2D texture resource.
+	///
+	/// When texture streaming is enabled, only the mip levels no larger than the configured initial size are loaded
+	/// when the texture is precached.  The TextureStreamer then moves the first resident mip level up or down based on
+	/// the levels requested by the graphics scene, creating a new render resource containing the new mip chain and
+	/// swapping it in once all of its levels have been loaded.
 	class HELIUM_GRAPHICS_API Texture2d : public Texture
 	{
 		HELIUM_DECLARE_ASSET( Texture2d, Texture );
@@ -36,6 +43,11 @@ namespace Helium
 		/// Persistent texture resource data.
 		PersistentResourceData m_persistentResourceData;
 
+		/// @name Asset Interface
+		//@{
+		virtual void RefCountPreDestroy() override;
+		//@}
+
 		/// @name Serialization
 		//@{
 		virtual bool NeedsPrecacheResourceData() const override;
@@ -54,11 +66,52 @@ namespace Helium
 		/// @name Data Access
 		//@{
 		virtual RTexture2d* GetRenderResource2d() const override;
+
+		inline uint32_t GetMipCount() const;
+		inline uint32_t GetResidentMipLevel() const;
+		inline uint32_t GetInitialMipLevel() const;
+		//@}
+
+		/// @name Mip Level Streaming
+		//@{
+		size_t GetMipChainSize( uint32_t firstMipLevel ) const;
+		uint32_t GetRequiredMipLevel( float32_t projectedSize ) const;
+
+		bool BeginStreamMipLevel( uint32_t mipLevel );
+		bool TryFinishStreamMipLevel();
+		inline bool IsStreamingMipLevel() const;
+		inline uint32_t GetStreamingMipLevel() const;
 		//@}
 
 	private:
 		/// Async load IDs for cached texture data.
 		DynamicArray< size_t > m_renderResourceLoadIds;
+
+		/// Index of the first mip level loaded into the current render resource.
+		uint32_t m_residentMipLevel;
+		/// Index of the first mip level loaded when the texture is precached.
+		uint32_t m_initialMipLevel;
+
+		/// Render resource being loaded with a new mip chain (null if no streaming change is in progress).
+		RTexture2dPtr m_spStreamingTexture;
+		/// Index of the first mip level being loaded into the streaming render resource.
+		uint32_t m_streamingMipLevel;
+		/// Async load IDs for the mip levels being loaded into the streaming render resource.
+		DynamicArray< size_t > m_streamingLoadIds;
+
+		/// Index of this texture in the texture streamer (invalid if not registered).
+		size_t m_streamerIndex;
+
+		/// @name Private Utility Functions
+		//@{
+		RTexture2d* CreateRenderResource( uint32_t firstMipLevel ) const;
+		void BeginLoadMipLevels( RTexture2d* pTexture2d, uint32_t firstMipLevel, DynamicArray< size_t >& rLoadIds );
+		bool TryFinishLoadMipLevels( RTexture2d* pTexture2d, DynamicArray< size_t >& rLoadIds );
+		void FinishLoadMipLevels( RTexture2d* pTexture2d, DynamicArray< size_t >& rLoadIds );
+		void ReleaseStreaming();
+		//@}
+
+		friend class TextureStreamer;
 	};
 }
 
@@ -10,4 +10,52 @@ namespace Helium
 	{
 		return m_persistentResourceData.m_baseLevelHeight;
 	}
+
+	/// Get the total number of mip levels in this texture.
+	///
+	/// @return  Mip level count.
+	uint32_t Texture2d::GetMipCount() const
+	{
+		return m_persistentResourceData.m_mipCount;
+	}
+
+	/// Get the index of the first mip level loaded into the current render resource.
+	///
+	/// @return  First resident mip level index.
+	///
+	/// @see GetInitialMipLevel(), GetStreamingMipLevel()
+	uint32_t Texture2d::GetResidentMipLevel() const
+	{
+		return m_residentMipLevel;
+	}
+
+	/// Get the index of the first mip level loaded when this texture is precached.
+	///
+	/// @return  Initial mip level index (zero if texture streaming was disabled when the texture was precached).
+	///
+	/// @see GetResidentMipLevel()
+	uint32_t Texture2d::GetInitialMipLevel() const
+	{
+		return m_initialMipLevel;
+	}
+
+	/// Get whether a change in the resident mip levels is currently in progress.
+	///
+	/// @return  True if mip levels are being streamed, false if not.
+	///
+	/// @see BeginStreamMipLevel(), TryFinishStreamMipLevel(), GetStreamingMipLevel()
+	bool Texture2d::IsStreamingMipLevel() const
+	{
+		return ( m_spStreamingTexture.Get() != NULL );
+	}
+
+	/// Get the index of the first mip level currently being streamed in.
+	///
+	/// @return  First streaming mip level index if streaming is in progress, the resident mip level index otherwise.
+	///
+	/// @see IsStreamingMipLevel(), GetResidentMipLevel()
+	uint32_t Texture2d::GetStreamingMipLevel() const
+	{
+		return ( m_spStreamingTexture ? m_streamingMipLevel : m_residentMipLevel );
+	}
 }
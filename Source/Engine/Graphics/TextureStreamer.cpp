@@ -0,0 +1,535 @@
+#include "Precompile.h"
+#include "Graphics/TextureStreamer.h"
+
+#include "Engine/Config.h"
+#include "Graphics/GraphicsConfig.h"
+#include "Graphics/Texture2d.h"
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+TextureStreamer* TextureStreamer::sm_pInstance = NULL;
+
+/// Constructor.
+TextureStreamer::Statistics::Statistics()
+	: textureCount( 0 )
+	, streamingTextureCount( 0 )
+	, residentBytes( 0 )
+	, requestedBytes( 0 )
+	, budgetBytes( 0 )
+	, upgradeCount( 0 )
+	, downgradeCount( 0 )
+{
+}
+
+/// Constructor.
+TextureStreamer::TextureStreamer()
+	: m_bEnabled( false )
+	, m_budget( 0 )
+	, m_initialSize( 0 )
+	, m_updateCount( 0 )
+{
+}
+
+/// Destructor.
+TextureStreamer::~TextureStreamer()
+{
+	Cleanup();
+}
+
+/// Initialize the streamer settings from the graphics configuration.
+///
+/// @return  True if initialization was successful, false if not.
+///
+/// @see Cleanup()
+bool TextureStreamer::Initialize()
+{
+	Cleanup();
+
+	Config* pConfig = Config::GetInstance();
+	if ( !HELIUM_VERIFY( pConfig ) )
+	{
+		return false;
+	}
+
+	StrongPtr< GraphicsConfig > spGraphicsConfig(
+		pConfig->GetConfigObject< GraphicsConfig >( Name( "GraphicsConfig" ) ) );
+	if ( !spGraphicsConfig )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"TextureStreamer::Initialize(): Missing GraphicsConfig; texture streaming will be disabled.\n" );
+
+		return true;
+	}
+
+	m_bEnabled = spGraphicsConfig->GetTextureStreaming();
+	m_budget = static_cast< uint64_t >( spGraphicsConfig->GetTextureStreamingBudget() ) << 20;
+	m_initialSize = Max< uint32_t >( spGraphicsConfig->GetTextureStreamingInitialSize(), 1 );
+
+	m_statistics.budgetBytes = m_budget;
+
+	return true;
+}
+
+/// Unregister all textures and reset the streamer settings.
+///
+/// Any mip level changes in progress are synced before their textures are unregistered.
+///
+/// @see Initialize()
+void TextureStreamer::Cleanup()
+{
+	{
+		MutexScopeLock scopeLock( m_pendingTextureLock );
+		m_pendingTextures.Clear();
+	}
+
+	while ( !m_entries.IsEmpty() )
+	{
+		Texture2d* pTexture = m_entries.GetLast().pTexture;
+		HELIUM_ASSERT( pTexture );
+		pTexture->ReleaseStreaming();
+	}
+
+	m_entries.Clear();
+
+	m_bEnabled = false;
+	m_budget = 0;
+	m_initialSize = 0;
+	m_updateCount = 0;
+
+	m_statistics = Statistics();
+}
+
+/// Set the memory budget for streamed textures.
+///
+/// The new budget is applied during the next Update().
+///
+/// @param[in] budget  Memory budget, in bytes.
+///
+/// @see GetBudget()
+void TextureStreamer::SetBudget( uint64_t budget )
+{
+	m_budget = budget;
+	m_statistics.budgetBytes = budget;
+}
+
+/// Get the index of the first mip level to load when precaching a texture.
+///
+/// @param[in] width     Width of the base mip level.
+/// @param[in] height    Height of the base mip level.
+/// @param[in] mipCount  Number of mip levels in the texture.
+///
+/// @return  Index of the largest mip level whose width and height both fit within the configured initial size, or
+///          zero if streaming is disabled.
+uint32_t TextureStreamer::GetInitialMipLevel( uint32_t width, uint32_t height, uint32_t mipCount ) const
+{
+	if ( !m_bEnabled || mipCount == 0 )
+	{
+		return 0;
+	}
+
+	uint32_t mipLevel = 0;
+	while ( mipLevel + 1 < mipCount && Max( width >> mipLevel, height >> mipLevel ) > m_initialSize )
+	{
+		++mipLevel;
+	}
+
+	return mipLevel;
+}
+
+/// Register a texture for mip level streaming.
+///
+/// This may be called from any thread.  The texture is queued, and starts streaming after the next Update().
+///
+/// @param[in] pTexture  Texture to register.
+///
+/// @see UnregisterTexture()
+void TextureStreamer::RegisterTexture( Texture2d* pTexture )
+{
+	HELIUM_ASSERT( pTexture );
+	HELIUM_ASSERT( IsInvalid( pTexture->m_streamerIndex ) );
+
+	MutexScopeLock scopeLock( m_pendingTextureLock );
+	m_pendingTextures.Push( pTexture );
+}
+
+/// Unregister a texture from mip level streaming.
+///
+/// The texture must not have a mip level change in progress.  Textures still queued by RegisterTexture() may be
+/// unregistered from any thread; textures already added by Update() must be unregistered from the main thread.
+/// Unregistering a texture that was never registered does nothing.
+///
+/// @param[in] pTexture  Texture to unregister.
+///
+/// @see RegisterTexture()
+void TextureStreamer::UnregisterTexture( Texture2d* pTexture )
+{
+	HELIUM_ASSERT( pTexture );
+	HELIUM_ASSERT( !pTexture->IsStreamingMipLevel() );
+
+	size_t index = pTexture->m_streamerIndex;
+	if ( IsInvalid( index ) )
+	{
+		MutexScopeLock scopeLock( m_pendingTextureLock );
+
+		size_t pendingCount = m_pendingTextures.GetSize();
+		for ( size_t pendingIndex = 0; pendingIndex < pendingCount; ++pendingIndex )
+		{
+			if ( m_pendingTextures[ pendingIndex ] == pTexture )
+			{
+				m_pendingTextures.RemoveSwap( pendingIndex );
+				break;
+			}
+		}
+
+		return;
+	}
+
+	HELIUM_ASSERT( index < m_entries.GetSize() );
+	HELIUM_ASSERT( m_entries[ index ].pTexture == pTexture );
+
+	m_entries.RemoveSwap( index );
+	if ( index < m_entries.GetSize() )
+	{
+		m_entries[ index ].pTexture->m_streamerIndex = index;
+	}
+
+	SetInvalid( pTexture->m_streamerIndex );
+}
+
+/// Request that a mip level be resident for a registered texture during the next update.
+///
+/// The lowest mip level index requested for a texture between updates is used.  Requests for textures that are not
+/// registered with the streamer are ignored.
+///
+/// @param[in] pTexture  Texture.
+/// @param[in] mipLevel  Index of the largest mip level needed.
+///
+/// @see Update()
+void TextureStreamer::RequestMipLevel( Texture2d* pTexture, uint32_t mipLevel )
+{
+	HELIUM_ASSERT( pTexture );
+
+	size_t index = pTexture->m_streamerIndex;
+	if ( IsInvalid( index ) )
+	{
+		return;
+	}
+
+	HELIUM_ASSERT( index < m_entries.GetSize() );
+	Entry& rEntry = m_entries[ index ];
+	HELIUM_ASSERT( rEntry.pTexture == pTexture );
+
+	rEntry.requestedMipLevel = Min( rEntry.requestedMipLevel, mipLevel );
+	rEntry.lastRequestUpdate = m_updateCount;
+}
+
+/// Update mip level residency for all registered textures.
+///
+/// Mip level changes that have finished loading are swapped in, new target mip levels are computed from the requests
+/// made since the last update and fit within the memory budget, and mip level changes are started for textures whose
+/// resident mip levels do not match their targets.  Textures that have not been requested for IDLE_UPDATE_COUNT
+/// updates return to their initial mip level.
+///
+/// @see RequestMipLevel()
+void TextureStreamer::Update()
+{
+	AddPendingTextures();
+
+	// Finish any mip level changes that have completed loading.
+	size_t streamingCount = 0;
+
+	size_t entryCount = m_entries.GetSize();
+	for ( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		Texture2d* pTexture = m_entries[ entryIndex ].pTexture;
+		HELIUM_ASSERT( pTexture );
+		if ( !pTexture->IsStreamingMipLevel() )
+		{
+			continue;
+		}
+
+		uint32_t previousMipLevel = pTexture->GetResidentMipLevel();
+		if ( !pTexture->TryFinishStreamMipLevel() )
+		{
+			++streamingCount;
+
+			continue;
+		}
+
+		uint32_t residentMipLevel = pTexture->GetResidentMipLevel();
+		if ( residentMipLevel < previousMipLevel )
+		{
+			++m_statistics.upgradeCount;
+		}
+		else if ( residentMipLevel > previousMipLevel )
+		{
+			++m_statistics.downgradeCount;
+		}
+	}
+
+	// Compute the target mip level of each texture from its requests.
+	uint64_t requestedBytes = 0;
+
+	for ( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		Entry& rEntry = m_entries[ entryIndex ];
+		Texture2d* pTexture = rEntry.pTexture;
+
+		uint32_t initialMipLevel = pTexture->GetInitialMipLevel();
+		if ( IsValid( rEntry.requestedMipLevel ) )
+		{
+			rEntry.targetMipLevel = Min( rEntry.requestedMipLevel, initialMipLevel );
+		}
+		else if ( m_updateCount - rEntry.lastRequestUpdate > IDLE_UPDATE_COUNT )
+		{
+			rEntry.targetMipLevel = initialMipLevel;
+		}
+		else
+		{
+			rEntry.targetMipLevel = pTexture->GetStreamingMipLevel();
+		}
+
+		requestedBytes += pTexture->GetMipChainSize( rEntry.targetMipLevel );
+	}
+
+	FitTargetsToBudget( requestedBytes );
+
+	// Count the memory held by resident mip chains and by those still loading, and start mip level changes for
+	// textures that are not at their targets as long as the new loads fit alongside them.
+	uint64_t committedBytes = 0;
+
+	for ( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		Texture2d* pTexture = m_entries[ entryIndex ].pTexture;
+
+		committedBytes += pTexture->GetMipChainSize( pTexture->GetResidentMipLevel() );
+		if ( pTexture->IsStreamingMipLevel() )
+		{
+			committedBytes += pTexture->GetMipChainSize( pTexture->GetStreamingMipLevel() );
+		}
+	}
+
+	streamingCount = IssueStreamRequests( streamingCount, committedBytes );
+
+	// Update the statistics and reset the requests for the next update.
+	uint64_t residentBytes = 0;
+
+	for ( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		Entry& rEntry = m_entries[ entryIndex ];
+		Texture2d* pTexture = rEntry.pTexture;
+
+		residentBytes += pTexture->GetMipChainSize( pTexture->GetResidentMipLevel() );
+		if ( pTexture->IsStreamingMipLevel() )
+		{
+			residentBytes += pTexture->GetMipChainSize( pTexture->GetStreamingMipLevel() );
+		}
+
+		SetInvalid( rEntry.requestedMipLevel );
+	}
+
+	m_statistics.textureCount = entryCount;
+	m_statistics.streamingTextureCount = streamingCount;
+	m_statistics.residentBytes = residentBytes;
+	m_statistics.requestedBytes = requestedBytes;
+	m_statistics.budgetBytes = m_budget;
+
+	++m_updateCount;
+}
+
+/// Reset the upgrade and downgrade counters in the streaming statistics.
+///
+/// @see GetStatistics()
+void TextureStreamer::ResetStatistics()
+{
+	m_statistics.upgradeCount = 0;
+	m_statistics.downgradeCount = 0;
+}
+
+/// Get the singleton TextureStreamer instance.
+///
+/// @return  Pointer to the TextureStreamer instance, or null if it has not been started.
+///
+/// @see Startup(), Shutdown()
+TextureStreamer* TextureStreamer::GetInstance()
+{
+	return sm_pInstance;
+}
+
+/// Create the singleton TextureStreamer instance.
+///
+/// @see Shutdown(), GetInstance()
+void TextureStreamer::Startup()
+{
+	if ( ++g_InitCount == 1 )
+	{
+		Config::Startup();
+
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new TextureStreamer;
+		HELIUM_ASSERT( sm_pInstance );
+		if ( !HELIUM_VERIFY( sm_pInstance->Initialize() ) )
+		{
+			Shutdown();
+		}
+	}
+}
+
+/// Destroy the singleton TextureStreamer instance.
+///
+/// @see Startup(), GetInstance()
+void TextureStreamer::Shutdown()
+{
+	if ( --g_InitCount == 0 )
+	{
+		HELIUM_ASSERT( sm_pInstance );
+		sm_pInstance->Cleanup();
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+
+		Config::Shutdown();
+	}
+}
+
+/// Add the textures queued by RegisterTexture() since the last update to the registered texture list.
+void TextureStreamer::AddPendingTextures()
+{
+	MutexScopeLock scopeLock( m_pendingTextureLock );
+
+	size_t pendingCount = m_pendingTextures.GetSize();
+	for ( size_t pendingIndex = 0; pendingIndex < pendingCount; ++pendingIndex )
+	{
+		Texture2d* pTexture = m_pendingTextures[ pendingIndex ];
+		HELIUM_ASSERT( pTexture );
+		HELIUM_ASSERT( IsInvalid( pTexture->m_streamerIndex ) );
+
+		pTexture->m_streamerIndex = m_entries.GetSize();
+
+		Entry* pEntry = m_entries.New();
+		HELIUM_ASSERT( pEntry );
+		pEntry->pTexture = pTexture;
+		SetInvalid( pEntry->requestedMipLevel );
+		pEntry->targetMipLevel = pTexture->GetResidentMipLevel();
+		pEntry->lastRequestUpdate = m_updateCount;
+	}
+
+	m_pendingTextures.Resize( 0 );
+}
+
+/// Raise target mip level indices until the targeted mip levels of all textures fit within the memory budget.
+///
+/// Textures that were not requested since the last update are dropped to their initial mip levels first.  If that is
+/// not enough, every texture above its initial mip level drops one level at a time until the budget is met.
+///
+/// @param[in] targetBytes  Number of bytes needed for the current target mip levels.
+///
+/// @return  Number of bytes needed for the adjusted target mip levels.
+uint64_t TextureStreamer::FitTargetsToBudget( uint64_t targetBytes )
+{
+	if ( targetBytes <= m_budget )
+	{
+		return targetBytes;
+	}
+
+	size_t entryCount = m_entries.GetSize();
+	for ( size_t entryIndex = 0; entryIndex < entryCount && targetBytes > m_budget; ++entryIndex )
+	{
+		Entry& rEntry = m_entries[ entryIndex ];
+		Texture2d* pTexture = rEntry.pTexture;
+
+		uint32_t initialMipLevel = pTexture->GetInitialMipLevel();
+		if ( IsValid( rEntry.requestedMipLevel ) || rEntry.targetMipLevel >= initialMipLevel )
+		{
+			continue;
+		}
+
+		targetBytes -= pTexture->GetMipChainSize( rEntry.targetMipLevel );
+		targetBytes += pTexture->GetMipChainSize( initialMipLevel );
+		rEntry.targetMipLevel = initialMipLevel;
+	}
+
+	bool bReduced = true;
+	while ( bReduced && targetBytes > m_budget )
+	{
+		bReduced = false;
+
+		for ( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			Entry& rEntry = m_entries[ entryIndex ];
+			Texture2d* pTexture = rEntry.pTexture;
+			if ( rEntry.targetMipLevel >= pTexture->GetInitialMipLevel() )
+			{
+				continue;
+			}
+
+			targetBytes -= pTexture->GetMipChainSize( rEntry.targetMipLevel );
+			++rEntry.targetMipLevel;
+			targetBytes += pTexture->GetMipChainSize( rEntry.targetMipLevel );
+
+			bReduced = true;
+		}
+	}
+
+	return targetBytes;
+}
+
+/// Start mip level changes for textures whose resident mip levels do not match their targets.
+///
+/// Changes that release memory are started before changes that load larger mip levels, and no more than
+/// STREAM_REQUEST_LIMIT textures are allowed to stream at once.  Textures that already have a change in progress are
+/// left alone until it completes.
+///
+/// Each change reserves the size of its target mip chain, since the new chain is loaded while the old one is still
+/// resident.  Changes that load larger mip levels are only started if that reservation fits in the budget, except
+/// when nothing else is streaming, so that a texture whose old and new chains can't both fit still gets upgraded.
+///
+/// @param[in] streamingCount  Number of textures with mip level changes already in progress.
+/// @param[in] committedBytes  Number of bytes used by resident mip chains and mip chains being loaded.
+///
+/// @return  Number of textures with mip level changes in progress after starting new changes.
+size_t TextureStreamer::IssueStreamRequests( size_t streamingCount, uint64_t committedBytes )
+{
+	size_t entryCount = m_entries.GetSize();
+	for ( size_t passIndex = 0; passIndex < 2; ++passIndex )
+	{
+		bool bUpgradePass = ( passIndex != 0 );
+
+		for ( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			if ( streamingCount >= STREAM_REQUEST_LIMIT )
+			{
+				return streamingCount;
+			}
+
+			Entry& rEntry = m_entries[ entryIndex ];
+			Texture2d* pTexture = rEntry.pTexture;
+			if ( pTexture->IsStreamingMipLevel() )
+			{
+				continue;
+			}
+
+			uint32_t residentMipLevel = pTexture->GetResidentMipLevel();
+			if ( rEntry.targetMipLevel == residentMipLevel ||
+				( rEntry.targetMipLevel < residentMipLevel ) != bUpgradePass )
+			{
+				continue;
+			}
+
+			uint64_t streamBytes = pTexture->GetMipChainSize( rEntry.targetMipLevel );
+			if ( bUpgradePass && streamingCount != 0 && committedBytes + streamBytes > m_budget )
+			{
+				continue;
+			}
+
+			if ( pTexture->BeginStreamMipLevel( rEntry.targetMipLevel ) )
+			{
+				committedBytes += streamBytes;
+				++streamingCount;
+			}
+		}
+	}
+
+	return streamingCount;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Platform/Locks.h"
+
+namespace Helium
+{
+	class Texture2d;
+
+	/// Texture mip level streaming manager.
+	///
+	/// Textures precached while streaming is enabled only load their smallest mip levels and register themselves with
+	/// the streamer.  Each frame, the graphics scene requests the mip level needed by each texture visible in a scene
+	/// view, and Update() (run once per frame by TextureStreamerUpdateTask) raises or lowers the first resident mip
+	/// level of each texture towards its requested level while keeping the memory used by all streamed textures within
+	/// the configured budget.  Textures are never streamed out past their initial mip level.  Mip chains being loaded
+	/// count against the budget along with the resident ones, so new loads only start once there is room for them.
+	///
+	/// Textures may finish precaching on any thread, so RegisterTexture() and UnregisterTexture() only queue or dequeue
+	/// the texture under a lock, and queued textures are added during the next Update().  All other streamer functions
+	/// must be called from the main thread.
+	class HELIUM_GRAPHICS_API TextureStreamer : NonCopyable
+	{
+	public:
+		/// Number of updates after which a texture that has not been requested returns to its initial mip level.
+		static const uint64_t IDLE_UPDATE_COUNT = 60;
+		/// Maximum number of textures that can be streaming mip levels at the same time.
+		static const size_t STREAM_REQUEST_LIMIT = 8;
+
+		/// Streaming statistics.
+		struct HELIUM_GRAPHICS_API Statistics
+		{
+			/// Number of registered textures.
+			size_t textureCount;
+			/// Number of textures with mip level changes in progress.
+			size_t streamingTextureCount;
+
+			/// Number of bytes used by the mip levels of all registered textures, including any being streamed in.
+			uint64_t residentBytes;
+			/// Number of bytes needed to hold the mip levels requested for all registered textures.
+			uint64_t requestedBytes;
+			/// Memory budget, in bytes.
+			uint64_t budgetBytes;
+
+			/// Number of completed mip level changes that loaded larger mip levels.
+			uint64_t upgradeCount;
+			/// Number of completed mip level changes that released larger mip levels.
+			uint64_t downgradeCount;
+
+			/// @name Construction/Destruction
+			//@{
+			Statistics();
+			//@}
+		};
+
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+		//@}
+
+		/// @name Configuration
+		//@{
+		inline bool IsEnabled() const;
+
+		inline uint64_t GetBudget() const;
+		void SetBudget( uint64_t budget );
+
+		uint32_t GetInitialMipLevel( uint32_t width, uint32_t height, uint32_t mipCount ) const;
+		//@}
+
+		/// @name Texture Registration
+		//@{
+		void RegisterTexture( Texture2d* pTexture );
+		void UnregisterTexture( Texture2d* pTexture );
+		//@}
+
+		/// @name Streaming
+		//@{
+		void RequestMipLevel( Texture2d* pTexture, uint32_t mipLevel );
+		void Update();
+		//@}
+
+		/// @name Statistics
+		//@{
+		inline const Statistics& GetStatistics() const;
+		void ResetStatistics();
+		//@}
+
+		/// @name Static Access
+		//@{
+		static TextureStreamer* GetInstance();
+		static void Startup();
+		static void Shutdown();
+		//@}
+
+	private:
+		/// Registered texture data.
+		struct Entry
+		{
+			/// Texture.
+			Texture2d* pTexture;
+			/// Lowest mip level index requested since the last update (invalid if not requested).
+			uint32_t requestedMipLevel;
+			/// First mip level index to make resident.
+			uint32_t targetMipLevel;
+			/// Update count at which the texture was last requested.
+			uint64_t lastRequestUpdate;
+		};
+
+		/// Registered textures.
+		DynamicArray< Entry > m_entries;
+
+		/// Textures registered since the last update.
+		DynamicArray< Texture2d* > m_pendingTextures;
+		/// Synchronization for the pending texture list.
+		Mutex m_pendingTextureLock;
+
+		/// True if texture streaming is enabled.
+		bool m_bEnabled;
+		/// Memory budget for streamed textures, in bytes.
+		uint64_t m_budget;
+		/// Maximum width/height of the largest mip level loaded initially.
+		uint32_t m_initialSize;
+
+		/// Number of updates performed.
+		uint64_t m_updateCount;
+
+		/// Streaming statistics.
+		Statistics m_statistics;
+
+		/// Singleton instance.
+		static TextureStreamer* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		TextureStreamer();
+		~TextureStreamer();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		void AddPendingTextures();
+		uint64_t FitTargetsToBudget( uint64_t targetBytes );
+		size_t IssueStreamRequests( size_t streamingCount, uint64_t committedBytes );
+		//@}
+	};
+}
+
+#include "Graphics/TextureStreamer.inl"
@@ -0,0 +1,31 @@
+namespace Helium
+{
+	/// Get whether texture streaming is enabled.
+	///
+	/// @return  True if textures should only load their initial mip levels when precached, false if they should load
+	///          all mip levels.
+	bool TextureStreamer::IsEnabled() const
+	{
+		return m_bEnabled;
+	}
+
+	/// Get the memory budget for streamed textures.
+	///
+	/// @return  Memory budget, in bytes.
+	///
+	/// @see SetBudget()
+	uint64_t TextureStreamer::GetBudget() const
+	{
+		return m_budget;
+	}
+
+	/// Get the streaming statistics as of the last update.
+	///
+	/// @return  Streaming statistics.
+	///
+	/// @see ResetStatistics()
+	const TextureStreamer::Statistics& TextureStreamer::GetStatistics() const
+	{
+		return m_statistics;
+	}
+}
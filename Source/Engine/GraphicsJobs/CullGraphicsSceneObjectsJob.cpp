@@ -0,0 +1,19 @@
+#include "Precompile.h"
+#include "GraphicsJobs/GraphicsJobsInterface.h"
+
+using namespace Helium;
+
+/// Test the bounds of a set of graphics scene objects against a view frustum.
+void CullGraphicsSceneObjectsJob::Run()
+{
+    const Simd::Frustum* pFrustum = m_parameters.pFrustum;
+    HELIUM_ASSERT( pFrustum );
+
+    pFrustum->IntersectsSoa(
+        m_parameters.pCentersX,
+        m_parameters.pCentersY,
+        m_parameters.pCentersZ,
+        m_parameters.pRadii,
+        m_parameters.sceneObjectCount,
+        m_parameters.pVisibilityMasks );
+}
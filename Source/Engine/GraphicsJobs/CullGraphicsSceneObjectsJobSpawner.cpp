@@ -0,0 +1,75 @@
+#include "Precompile.h"
+#include "GraphicsJobs/GraphicsJobsInterface.h"
+
+#include "EngineJobs/JobManager.h"
+
+/// Maximum number of child jobs to spawn at once.
+static const uint_fast32_t SCENE_OBJECT_CULL_CHILD_JOB_MAX = 128;
+/// Maximum number of graphics scene objects to test in each child job (must be a multiple of 32 so that no two jobs
+/// write to the same visibility mask).
+static const uint_fast32_t SCENE_OBJECT_CULL_CHILD_JOB_OBJECT_COUNT_MAX = 2048;
+
+
+using namespace Helium;
+
+/// Spawn jobs to test the bounds of all graphics scene objects against a view frustum.
+void CullGraphicsSceneObjectsJobSpawner::Run()
+{
+    HELIUM_ASSERT( ( m_parameters.sceneObjectCount & 31 ) == 0 );
+
+    const float32_t* pCentersX = m_parameters.pCentersX;
+    const float32_t* pCentersY = m_parameters.pCentersY;
+    const float32_t* pCentersZ = m_parameters.pCentersZ;
+    const float32_t* pRadii = m_parameters.pRadii;
+    uint32_t* pVisibilityMasks = m_parameters.pVisibilityMasks;
+
+    uint_fast32_t sceneObjectCount = m_parameters.sceneObjectCount;
+
+    uint_fast32_t jobCount = ( sceneObjectCount + SCENE_OBJECT_CULL_CHILD_JOB_OBJECT_COUNT_MAX - 1 ) /
+        SCENE_OBJECT_CULL_CHILD_JOB_OBJECT_COUNT_MAX;
+    if( jobCount > SCENE_OBJECT_CULL_CHILD_JOB_MAX )
+    {
+        jobCount = SCENE_OBJECT_CULL_CHILD_JOB_MAX;
+    }
+
+    JobGroup jobGroup;
+
+    for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+    {
+        uint_fast32_t jobObjectCount = Min( sceneObjectCount, SCENE_OBJECT_CULL_CHILD_JOB_OBJECT_COUNT_MAX );
+        HELIUM_ASSERT( jobObjectCount != 0 );
+        sceneObjectCount -= jobObjectCount;
+
+        CullGraphicsSceneObjectsJob::Parameters parameters;
+        parameters.pFrustum = m_parameters.pFrustum;
+        parameters.sceneObjectCount = static_cast< uint32_t >( jobObjectCount );
+        parameters.pCentersX = pCentersX;
+        parameters.pCentersY = pCentersY;
+        parameters.pCentersZ = pCentersZ;
+        parameters.pRadii = pRadii;
+        parameters.pVisibilityMasks = pVisibilityMasks;
+        jobGroup.Spawn< CullGraphicsSceneObjectsJob >( parameters );
+
+        pCentersX += jobObjectCount;
+        pCentersY += jobObjectCount;
+        pCentersZ += jobObjectCount;
+        pRadii += jobObjectCount;
+        pVisibilityMasks += jobObjectCount / 32;
+    }
+
+    // Spawn another spawner job to handle any objects remaining after the child job limit has been reached.
+    if( sceneObjectCount != 0 )
+    {
+        CullGraphicsSceneObjectsJobSpawner::Parameters parameters;
+        parameters.pFrustum = m_parameters.pFrustum;
+        parameters.sceneObjectCount = static_cast< uint32_t >( sceneObjectCount );
+        parameters.pCentersX = pCentersX;
+        parameters.pCentersY = pCentersY;
+        parameters.pCentersZ = pCentersZ;
+        parameters.pRadii = pRadii;
+        parameters.pVisibilityMasks = pVisibilityMasks;
+        jobGroup.Spawn< CullGraphicsSceneObjectsJobSpawner >( parameters );
+    }
+
+    jobGroup.Wait();
+}
@@ -3,6 +3,7 @@
 #include "GraphicsJobs/GraphicsJobs.h"
 #include "Platform/Assert.h"
 #include "GraphicsTypes/GraphicsSceneObject.h"
+#include "MathSimd/Frustum.h"
 
 namespace Helium
 {
@@ -144,6 +145,57 @@ private:
     Parameters m_parameters;
 };
 
+/// Spawn jobs to test the bounds of all graphics scene objects against a view frustum.
+class HELIUM_GRAPHICS_JOBS_API CullGraphicsSceneObjectsJobSpawner : Helium::NonCopyable
+{
+public:
+    class Parameters
+    {
+    public:
+        /// [in] Frustum against which to test the scene object bounds.
+        const Simd::Frustum* pFrustum;
+        /// [in] Number of scene object bounds to test (must be a multiple of 32).
+        uint32_t sceneObjectCount;
+        /// [in] Scene object bounding sphere center x coordinates.
+        const float32_t* pCentersX;
+        /// [in] Scene object bounding sphere center y coordinates.
+        const float32_t* pCentersY;
+        /// [in] Scene object bounding sphere center z coordinates.
+        const float32_t* pCentersZ;
+        /// [in] Scene object bounding sphere radii.
+        const float32_t* pRadii;
+        /// [out] Array in which to store the visibility bit mask for every 32 scene objects.
+        uint32_t* pVisibilityMasks;
+
+        /// @name Construction/Destruction
+        //@{
+        inline Parameters();
+        //@}
+    };
+
+    /// @name Construction/Destruction
+    //@{
+    inline CullGraphicsSceneObjectsJobSpawner();
+    inline ~CullGraphicsSceneObjectsJobSpawner();
+    //@}
+
+    /// @name Parameters
+    //@{
+    inline Parameters& GetParameters();
+    inline const Parameters& GetParameters() const;
+    inline void SetParameters( const Parameters& rParameters );
+    //@}
+
+    /// @name Job Execution
+    //@{
+    void Run();
+    inline static void RunCallback( void* pJob );
+    //@}
+
+private:
+    Parameters m_parameters;
+};
+
 /// Update the constant buffer data for a set of graphics scene objects.
 class HELIUM_GRAPHICS_JOBS_API UpdateGraphicsSceneObjectBuffersJob : Helium::NonCopyable
 {
@@ -232,6 +284,57 @@ private:
     Parameters m_parameters;
 };
 
+/// Test the bounds of a set of graphics scene objects against a view frustum.
+class HELIUM_GRAPHICS_JOBS_API CullGraphicsSceneObjectsJob : Helium::NonCopyable
+{
+public:
+    class Parameters
+    {
+    public:
+        /// [in] Frustum against which to test the scene object bounds.
+        const Simd::Frustum* pFrustum;
+        /// [in] Number of scene object bounds to test (must be a multiple of 32).
+        uint32_t sceneObjectCount;
+        /// [in] Scene object bounding sphere center x coordinates.
+        const float32_t* pCentersX;
+        /// [in] Scene object bounding sphere center y coordinates.
+        const float32_t* pCentersY;
+        /// [in] Scene object bounding sphere center z coordinates.
+        const float32_t* pCentersZ;
+        /// [in] Scene object bounding sphere radii.
+        const float32_t* pRadii;
+        /// [out] Array in which to store the visibility bit mask for every 32 scene objects.
+        uint32_t* pVisibilityMasks;
+
+        /// @name Construction/Destruction
+        //@{
+        inline Parameters();
+        //@}
+    };
+
+    /// @name Construction/Destruction
+    //@{
+    inline CullGraphicsSceneObjectsJob();
+    inline ~CullGraphicsSceneObjectsJob();
+    //@}
+
+    /// @name Parameters
+    //@{
+    inline Parameters& GetParameters();
+    inline const Parameters& GetParameters() const;
+    inline void SetParameters( const Parameters& rParameters );
+    //@}
+
+    /// @name Job Execution
+    //@{
+    void Run();
+    inline static void RunCallback( void* pJob );
+    //@}
+
+private:
+    Parameters m_parameters;
+};
+
 }  // namespace Helium
 
 #include "GraphicsJobs/GraphicsJobsInterface.inl"
@@ -276,5 +276,113 @@ namespace Helium
 	{
 	}
 
+	/// Constructor.
+	CullGraphicsSceneObjectsJobSpawner::CullGraphicsSceneObjectsJobSpawner()
+	{
+	}
+
+	/// Destructor.
+	CullGraphicsSceneObjectsJobSpawner::~CullGraphicsSceneObjectsJobSpawner()
+	{
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	CullGraphicsSceneObjectsJobSpawner::Parameters& CullGraphicsSceneObjectsJobSpawner::GetParameters()
+	{
+		return m_parameters;
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Constant reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	const CullGraphicsSceneObjectsJobSpawner::Parameters& CullGraphicsSceneObjectsJobSpawner::GetParameters() const
+	{
+		return m_parameters;
+	}
+
+	/// Set the job parameters.
+	///
+	/// @param[in] rParameters  MetaStruct containing the job parameters.
+	///
+	/// @see GetParameters()
+	void CullGraphicsSceneObjectsJobSpawner::SetParameters( const Parameters& rParameters )
+	{
+		m_parameters = rParameters;
+	}
+
+	/// Callback executed to run the job.
+	///
+	/// @param[in] pJob  Job to run.
+	void CullGraphicsSceneObjectsJobSpawner::RunCallback( void* pJob )
+	{
+		HELIUM_ASSERT( pJob );
+		static_cast< CullGraphicsSceneObjectsJobSpawner* >( pJob )->Run();
+	}
+
+	/// Constructor.
+	CullGraphicsSceneObjectsJobSpawner::Parameters::Parameters()
+	{
+	}
+
+	/// Constructor.
+	CullGraphicsSceneObjectsJob::CullGraphicsSceneObjectsJob()
+	{
+	}
+
+	/// Destructor.
+	CullGraphicsSceneObjectsJob::~CullGraphicsSceneObjectsJob()
+	{
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	CullGraphicsSceneObjectsJob::Parameters& CullGraphicsSceneObjectsJob::GetParameters()
+	{
+		return m_parameters;
+	}
+
+	/// Get the parameters for this job.
+	///
+	/// @return  Constant reference to the structure containing the job parameters.
+	///
+	/// @see SetParameters()
+	const CullGraphicsSceneObjectsJob::Parameters& CullGraphicsSceneObjectsJob::GetParameters() const
+	{
+		return m_parameters;
+	}
+
+	/// Set the job parameters.
+	///
+	/// @param[in] rParameters  MetaStruct containing the job parameters.
+	///
+	/// @see GetParameters()
+	void CullGraphicsSceneObjectsJob::SetParameters( const Parameters& rParameters )
+	{
+		m_parameters = rParameters;
+	}
+
+	/// Callback executed to run the job.
+	///
+	/// @param[in] pJob  Job to run.
+	void CullGraphicsSceneObjectsJob::RunCallback( void* pJob )
+	{
+		HELIUM_ASSERT( pJob );
+		static_cast< CullGraphicsSceneObjectsJob* >( pJob )->Run();
+	}
+
+	/// Constructor.
+	CullGraphicsSceneObjectsJob::Parameters::Parameters()
+	{
+	}
+
 }  // namespace Helium
 
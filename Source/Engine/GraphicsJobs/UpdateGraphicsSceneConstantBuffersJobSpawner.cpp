@@ -1,31 +1,27 @@
 #include "Precompile.h"
 #include "GraphicsJobs/GraphicsJobsInterface.h"
 
-/// Maximum number of jobs to spawn at once for scene instance buffer updates.
-#define GRAPHICS_SCENE_INSTANCE_UPDATE_JOB_MAX 128
+#include "EngineJobs/JobManager.h"
 
 using namespace Helium;
 
 /// Spawn jobs to update all instance constant buffers for graphics scene objects and sub-meshes.
-///
-/// @param[in] pContext  Context in which this job is running.
 void UpdateGraphicsSceneConstantBuffersJobSpawner::Run()
 {
-	{
-		// NOTE: These were running in parallel, but now synchronous since we're removing tbb
-		UpdateGraphicsSceneObjectBuffersJobSpawner objectJob;
-		UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters& rObjectParameters = objectJob.GetParameters();
-		rObjectParameters.sceneObjectCount = m_parameters.sceneObjectCount;
-		rObjectParameters.pSceneObjects = m_parameters.pSceneObjects;
-		rObjectParameters.ppConstantBufferData = m_parameters.ppSceneObjectConstantBufferData;
-		objectJob.Run();
+	JobGroup jobGroup;
 
-		UpdateGraphicsSceneSubMeshBuffersJobSpawner subMeshJob;
-		UpdateGraphicsSceneSubMeshBuffersJobSpawner::Parameters& rSubMeshParameters = subMeshJob.GetParameters();
-		rSubMeshParameters.subMeshCount = m_parameters.subMeshCount;
-		rSubMeshParameters.pSubMeshes = m_parameters.pSubMeshes;
-		rSubMeshParameters.pSceneObjects = m_parameters.pSceneObjects;
-		rSubMeshParameters.ppConstantBufferData = m_parameters.ppSubMeshConstantBufferData;
-		subMeshJob.Run();
-	}
+	UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters objectParameters;
+	objectParameters.sceneObjectCount = m_parameters.sceneObjectCount;
+	objectParameters.pSceneObjects = m_parameters.pSceneObjects;
+	objectParameters.ppConstantBufferData = m_parameters.ppSceneObjectConstantBufferData;
+	jobGroup.Spawn< UpdateGraphicsSceneObjectBuffersJobSpawner >( objectParameters );
+
+	UpdateGraphicsSceneSubMeshBuffersJobSpawner::Parameters subMeshParameters;
+	subMeshParameters.subMeshCount = m_parameters.subMeshCount;
+	subMeshParameters.pSubMeshes = m_parameters.pSubMeshes;
+	subMeshParameters.pSceneObjects = m_parameters.pSceneObjects;
+	subMeshParameters.ppConstantBufferData = m_parameters.ppSubMeshConstantBufferData;
+	jobGroup.Spawn< UpdateGraphicsSceneSubMeshBuffersJobSpawner >( subMeshParameters );
+
+	jobGroup.Wait();
 }
@@ -1,6 +1,8 @@
 #include "Precompile.h"
 #include "GraphicsJobs/GraphicsJobsInterface.h"
 
+#include "EngineJobs/JobManager.h"
+
 /// Maximum number of child jobs to spawn at once.
 static const uint_fast32_t SCENE_OBJECT_CHILD_JOB_MAX = 128;
 /// Maximum number of graphics scene objects to update in each child job.
@@ -25,34 +27,33 @@ void UpdateGraphicsSceneObjectBuffersJobSpawner::Run()
         jobCount = SCENE_OBJECT_CHILD_JOB_MAX;
     }
 
+    JobGroup jobGroup;
+
+    for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+    {
+        uint_fast32_t jobObjectCount = Min( sceneObjectCount, SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX );
+        HELIUM_ASSERT( jobObjectCount != 0 );
+        sceneObjectCount -= jobObjectCount;
+
+        UpdateGraphicsSceneObjectBuffersJob::Parameters parameters;
+        parameters.sceneObjectCount = static_cast< uint32_t >( jobObjectCount );
+        parameters.pSceneObjects = pSceneObjects;
+        parameters.ppConstantBufferData = ppConstantBufferData;
+        jobGroup.Spawn< UpdateGraphicsSceneObjectBuffersJob >( parameters );
+
+        pSceneObjects += jobObjectCount;
+        ppConstantBufferData += jobObjectCount;
+    }
+
+    // Spawn another spawner job to handle any objects remaining after the child job limit has been reached.
+    if( sceneObjectCount != 0 )
     {
-        for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
-        {
-            uint_fast32_t jobObjectCount = Min( sceneObjectCount, SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX );
-            HELIUM_ASSERT( jobObjectCount != 0 );
-            sceneObjectCount -= jobObjectCount;
-
-			// NOTE: These were run in parallel but now synchronous since TBB has been removed
-			UpdateGraphicsSceneObjectBuffersJob job;
-            UpdateGraphicsSceneObjectBuffersJob::Parameters& rParameters = job.GetParameters();
-            rParameters.sceneObjectCount = static_cast< uint32_t >( jobObjectCount );
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-
-            pSceneObjects += jobObjectCount;
-            ppConstantBufferData += jobObjectCount;
-        }
-
-		// This was a continuation task but now just exectues inline here since TBB was removed
-        if( sceneObjectCount != 0 )
-        {
-			UpdateGraphicsSceneObjectBuffersJobSpawner job;
-            UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters& rParameters = job.GetParameters();
-            rParameters.sceneObjectCount = sceneObjectCount;
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-        }
+        UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters parameters;
+        parameters.sceneObjectCount = static_cast< uint32_t >( sceneObjectCount );
+        parameters.pSceneObjects = pSceneObjects;
+        parameters.ppConstantBufferData = ppConstantBufferData;
+        jobGroup.Spawn< UpdateGraphicsSceneObjectBuffersJobSpawner >( parameters );
     }
+
+    jobGroup.Wait();
 }
@@ -57,8 +57,13 @@ namespace Helium
             /// @name Testing
             //@{
             bool Contains( const Vector3& rPoint ) const;
+            bool Contains( const AaBox& rBox ) const;
             bool Intersects( const AaBox& rBox ) const;
             bool Intersects( const Sphere& rSphere ) const;
+
+            void IntersectsSoa(
+                const float32_t* pCentersX, const float32_t* pCentersY, const float32_t* pCentersZ,
+                const float32_t* pRadii, size_t sphereCount, uint32_t* pVisibilityMasks ) const;
             //@}
 
             /// @name Math
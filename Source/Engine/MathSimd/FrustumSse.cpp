@@ -42,6 +42,53 @@ bool Helium::Simd::Frustum::Contains( const Vector3& rPoint ) const
     return true;
 }
 
+/// Test whether this frustum fully contains a given axis-aligned bounding box in world space.
+///
+/// @param[in] rBox  Box to test.
+///
+/// @return  True if every corner of the box is within this frustum, false if not.
+///
+/// @see Intersects()
+bool Helium::Simd::Frustum::Contains( const AaBox& rBox ) const
+{
+    Helium::Simd::Register boxMinVec = rBox.GetMinimum().GetSimdVector();
+    Helium::Simd::Register boxMaxVec = rBox.GetMaximum().GetSimdVector();
+
+    Helium::Simd::Register boxX0 = _mm_shuffle_ps( boxMinVec, boxMinVec, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+    Helium::Simd::Register boxX1 = _mm_shuffle_ps( boxMaxVec, boxMaxVec, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+    Helium::Simd::Register boxY = _mm_shuffle_ps( boxMinVec, boxMaxVec, _MM_SHUFFLE( 1, 1, 1, 1 ) );
+    Helium::Simd::Register boxZ = _mm_unpackhi_ps( boxMinVec, boxMaxVec );
+    boxZ = _mm_movelh_ps( boxZ, boxZ );
+
+    PlaneSoa plane;
+    Vector3Soa points( boxX0, boxY, boxZ );
+    Helium::Simd::Register zeroVec = Helium::Simd::LoadZeros();
+
+    size_t planeCount = ( m_bInfiniteFarClip ? PLANE_FAR : PLANE_MAX );
+    for( size_t planeIndex = 0; planeIndex < planeCount; ++planeIndex )
+    {
+        plane.Load1Splat(
+            m_planeA + planeIndex,
+            m_planeB + planeIndex,
+            m_planeC + planeIndex,
+            m_planeD + planeIndex );
+
+        points.m_x = boxX0;
+        Helium::Simd::Mask containsPoints0 = Helium::Simd::GreaterEqualsF32( plane.GetDistance( points ), zeroVec );
+
+        points.m_x = boxX1;
+        Helium::Simd::Mask containsPoints1 = Helium::Simd::GreaterEqualsF32( plane.GetDistance( points ), zeroVec );
+
+        int resultMask = _mm_movemask_ps( Helium::Simd::MaskAnd( containsPoints0, containsPoints1 ) );
+        if( resultMask != 0xf )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /// Test whether this frustum intersects a given axis-aligned bounding box in world space.
 ///
 /// @param[in] rBox  Box to test.
@@ -124,6 +171,85 @@ bool Helium::Simd::Frustum::Intersects( const Sphere& rSphere ) const
     return true;
 }
 
+/// Test a batch of spheres in world space against this frustum, four spheres at a time.
+///
+/// Sphere data is provided in struct-of-arrays form, and the results are written as bit masks, with bit
+/// <code>i % 32</code> of <code>pVisibilityMasks[ i / 32 ]</code> set if sphere @c i intersects this frustum.  Each
+/// mask word touched is overwritten, so callers splitting a batch across threads should start each sub-batch on a
+/// multiple of 32 spheres.  Spheres with a negative radius never intersect the frustum, which can be used to pad the
+/// arrays or disable unused entries.
+///
+/// @param[in]  pCentersX         Sphere center x coordinates.
+/// @param[in]  pCentersY         Sphere center y coordinates.
+/// @param[in]  pCentersZ         Sphere center z coordinates.
+/// @param[in]  pRadii            Sphere radii.
+/// @param[in]  sphereCount       Number of spheres to test.  This must be a multiple of four.
+/// @param[out] pVisibilityMasks  Array in which the visibility bit masks will be stored.  This must be large enough
+///                               to hold <code>( sphereCount + 31 ) / 32</code> entries.
+///
+/// @see Intersects()
+void Helium::Simd::Frustum::IntersectsSoa(
+    const float32_t* pCentersX,
+    const float32_t* pCentersY,
+    const float32_t* pCentersZ,
+    const float32_t* pRadii,
+    size_t sphereCount,
+    uint32_t* pVisibilityMasks ) const
+{
+    HELIUM_ASSERT( pCentersX || sphereCount == 0 );
+    HELIUM_ASSERT( pCentersY || sphereCount == 0 );
+    HELIUM_ASSERT( pCentersZ || sphereCount == 0 );
+    HELIUM_ASSERT( pRadii || sphereCount == 0 );
+    HELIUM_ASSERT( pVisibilityMasks || sphereCount == 0 );
+    HELIUM_ASSERT( ( sphereCount & 3 ) == 0 );
+
+    // Splat each plane up front so the inner loop only touches sphere data.
+    size_t planeCount = ( m_bInfiniteFarClip ? PLANE_FAR : PLANE_MAX );
+    PlaneSoa planes[ PLANE_MAX ];
+    for( size_t planeIndex = 0; planeIndex < planeCount; ++planeIndex )
+    {
+        planes[ planeIndex ].Load1Splat(
+            m_planeA + planeIndex,
+            m_planeB + planeIndex,
+            m_planeC + planeIndex,
+            m_planeD + planeIndex );
+    }
+
+    Helium::Simd::Register zeroVec = Helium::Simd::LoadZeros();
+    Vector3Soa centers;
+    for( size_t baseSphereIndex = 0; baseSphereIndex < sphereCount; baseSphereIndex += 32 )
+    {
+        size_t blockSphereCount = Min< size_t >( sphereCount - baseSphereIndex, 32 );
+
+        uint32_t visibilityMask = 0;
+        for( size_t blockOffset = 0; blockOffset < blockSphereCount; blockOffset += 4 )
+        {
+            size_t sphereIndex = baseSphereIndex + blockOffset;
+
+            centers.m_x = Helium::Simd::LoadUnaligned( pCentersX + sphereIndex );
+            centers.m_y = Helium::Simd::LoadUnaligned( pCentersY + sphereIndex );
+            centers.m_z = Helium::Simd::LoadUnaligned( pCentersZ + sphereIndex );
+            Helium::Simd::Register radii = Helium::Simd::LoadUnaligned( pRadii + sphereIndex );
+
+            // Mask out negative radii explicitly, as a sphere with a small negative radius can still pass the plane
+            // tests when its center is far enough inside the frustum.
+            Helium::Simd::Mask insideMask = Helium::Simd::GreaterEqualsF32( radii, zeroVec );
+            for( size_t planeIndex = 0; planeIndex < planeCount; ++planeIndex )
+            {
+                insideMask = Helium::Simd::MaskAnd(
+                    insideMask,
+                    Helium::Simd::GreaterEqualsF32(
+                        Helium::Simd::AddF32( planes[ planeIndex ].GetDistance( centers ), radii ),
+                        zeroVec ) );
+            }
+
+            visibilityMask |= static_cast< uint32_t >( _mm_movemask_ps( insideMask ) ) << blockOffset;
+        }
+
+        pVisibilityMasks[ baseSphereIndex / 32 ] = visibilityMask;
+    }
+}
+
 /// Compute the corners of this view frustum.
 ///
 /// A view frustum can have either four or eight corners depending on whether a far clip plane exists (eight
@@ -13,6 +13,7 @@ void ProcessInput( DynamicArray< WorldPtr > &rWorlds)
 void Helium::OisTaskCapture::DefineContract( TaskContract &rContract )
 {
     rContract.ExecutesWithin<Helium::StandardDependencies::ReceiveInput>();
+    rContract.ExecuteOnMainThread();
 }
 
 HELIUM_DEFINE_TASK(OisTaskCapture, ProcessInput, TickTypes::Client)
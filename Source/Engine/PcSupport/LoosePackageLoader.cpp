@@ -6,6 +6,7 @@
 #include "Foundation/DirectoryIterator.h"
 #include "Foundation/FileStream.h"
 #include "Foundation/MemoryStream.h"
+#include "Engine/AsyncDeserializer.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/CacheManager.h"
 #include "Engine/Config.h"
@@ -187,6 +188,19 @@ void LoosePackageLoader::Cleanup()
 		{
 			LoadRequest* pRequest = m_loadRequests[requestIndex];
 			HELIUM_ASSERT( pRequest );
+
+			// Make sure no deserialization worker is still reading into the request.
+			if ( IsValid( pRequest->deserializeId ) )
+			{
+				AsyncDeserializer* pAsyncDeserializer = AsyncDeserializer::GetInstance();
+				HELIUM_ASSERT( pAsyncDeserializer );
+				pAsyncDeserializer->SyncRequest( pRequest->deserializeId );
+				SetInvalid( pRequest->deserializeId );
+
+				DefaultAllocator().Free( pRequest->pAsyncFileLoadBuffer );
+				pRequest->pAsyncFileLoadBuffer = NULL;
+			}
+
 			m_loadRequestPool.Release( pRequest );
 		}
 	}
@@ -343,6 +357,7 @@ size_t LoosePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 		SetInvalid( pRequest->asyncFileLoadId );
 		pRequest->pAsyncFileLoadBuffer = NULL;
 		pRequest->asyncFileLoadBufferSize = 0;
+		SetInvalid( pRequest->deserializeId );
 		pRequest->pResolver = NULL;
 		pRequest->forceReload = forceReload;
 
@@ -440,6 +455,7 @@ size_t LoosePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	SetInvalid( pRequest->asyncFileLoadId );
 	pRequest->pAsyncFileLoadBuffer = NULL;
 	pRequest->asyncFileLoadBufferSize = 0;
+	SetInvalid( pRequest->deserializeId );
 	pRequest->pResolver = pResolver;
 	pRequest->forceReload = forceReload;
 
@@ -555,15 +571,28 @@ void LoosePackageLoader::Tick()
 		return;
 	}
 
+	bool bProgress;
 	if ( !m_preloadedCounter )
 	{
 		// Update package preloading.
 		TickPreload();
+		bProgress = ( m_preloadedCounter != 0 );
 	}
 	else
 	{
 		// Process pending dependencies.
-		TickLoadRequests();
+		bProgress = TickLoadRequests();
+	}
+
+	// Preloading can finish here without any async work completing (such as when objects are deserialized on this
+	// thread), so wake up anything waiting on load progress.
+	if ( bProgress )
+	{
+		AsyncLoader* pAsyncLoader = AsyncLoader::GetInstance();
+		if ( pAsyncLoader )
+		{
+			pAsyncLoader->SignalCompletion();
+		}
 	}
 }
 
@@ -937,8 +966,10 @@ void LoosePackageLoader::TickPreload()
 }
 
 /// Update load processing of object load requests.
-void LoosePackageLoader::TickLoadRequests()
+bool LoosePackageLoader::TickLoadRequests()
 {
+	bool bProgress = false;
+
 	size_t loadRequestCount = m_loadRequests.GetSize();
 	for ( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestCount; ++loadRequestIndex )
 	{
@@ -950,26 +981,26 @@ void LoosePackageLoader::TickLoadRequests()
 		LoadRequest* pRequest = m_loadRequests[loadRequestIndex];
 		HELIUM_ASSERT( pRequest );
 
-		if ( !( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) )
+		uint32_t previousFlags = pRequest->flags;
+
+		if ( ( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) || TickDeserialize( pRequest ) )
 		{
-			if ( !TickDeserialize( pRequest ) )
+			//TODO: Investigate removing need to preload properties first. Probably need to have the
+			//      restriction as TickPersistentResourcePreload assumes the object exists.. but this
+			//      may not be the best place to put this 
+			if ( !( pRequest->flags & LOAD_FLAG_PERSISTENT_RESOURCE_PRELOADED ) )
 			{
-				continue;
+				TickPersistentResourcePreload( pRequest );
 			}
 		}
 
-		//TODO: Investigate removing need to preload properties first. Probably need to have the
-		//      restriction as TickPersistentResourcePreload assumes the object exists.. but this
-		//      may not be the best place to put this 
-		// We can probably remove these continues..
-		if ( !( pRequest->flags & LOAD_FLAG_PERSISTENT_RESOURCE_PRELOADED ) )
+		if ( pRequest->flags != previousFlags )
 		{
-			if ( !TickPersistentResourcePreload( pRequest ) )
-			{
-				continue;
-			}
+			bProgress = true;
 		}
 	}
+
+	return bProgress;
 }
 
 size_t LoosePackageLoader::FindObjectByPath( const AssetPath &path ) const
@@ -1014,6 +1045,21 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) );
 
+	// If the object properties are being read on a deserialization worker, wait for it to finish.
+	if ( IsValid( pRequest->deserializeId ) )
+	{
+		AsyncDeserializer* pAsyncDeserializer = AsyncDeserializer::GetInstance();
+		HELIUM_ASSERT( pAsyncDeserializer );
+		if ( !pAsyncDeserializer->TrySyncRequest( pRequest->deserializeId ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->deserializeId );
+
+		return FinishDeserialize( pRequest, false );
+	}
+
 	Asset* pObject = pRequest->spObject;
 
 	HELIUM_ASSERT( pRequest->index < m_objects.GetSize() );
@@ -1291,22 +1337,50 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 		}
 		else
 		{
-			StaticMemoryStream archiveStream( pRequest->pAsyncFileLoadBuffer, pRequest->asyncFileLoadBufferSize );
-
 			HELIUM_TRACE(
 				TraceLevels::Info,
 				"LoosePackageLoader: Reading %s. pResolver = %x\n",
 				object_file_path.Data(),
 				pRequest->pResolver );
 
-			DynamicArray< Reflect::ObjectPtr > objects;
-			objects.Push( pRequest->spObject.Get() ); // use existing objects
-			Persist::ArchiveReaderJson::ReadFromStream( archiveStream, objects, pRequest->pResolver );
-			HELIUM_ASSERT( objects[0].Get() == pRequest->spObject.Get() );
+			// Read the object properties on a deserialization worker if any are available.  The remainder of the
+			// preload process is handled by FinishDeserialize() once the worker has finished.
+			AsyncDeserializer* pAsyncDeserializer = AsyncDeserializer::GetInstance();
+			if ( pAsyncDeserializer )
+			{
+				pRequest->deserializeId = pAsyncDeserializer->QueueRequest( &DeserializeCallback, pRequest );
+				if ( IsValid( pRequest->deserializeId ) )
+				{
+					return false;
+				}
+			}
+
+			ReadObjectFile( pRequest );
 		}
 	}
 
-	if ( load_properties_from_file )
+	return FinishDeserialize( pRequest, object_creation_failure );
+}
+
+/// Complete the object deserialization process for the given object load request once its properties have been
+/// read.
+///
+/// @param[in] pRequest               Load request.
+/// @param[in] bObjectCreationFailed  True if the object could not be created or reused for loading.
+///
+/// @return  True (the object property preload process is always complete once this is called).
+bool LoosePackageLoader::FinishDeserialize( LoadRequest* pRequest, bool bObjectCreationFailed )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( IsInvalid( pRequest->deserializeId ) );
+
+	Asset* pObject = pRequest->spObject;
+	HELIUM_ASSERT( pObject );
+
+	HELIUM_ASSERT( pRequest->index < m_objects.GetSize() );
+	SerializedObjectData& rObjectData = m_objects[pRequest->index];
+
+	if ( pRequest->pAsyncFileLoadBuffer )
 	{
 		DefaultAllocator().Free( pRequest->pAsyncFileLoadBuffer );
 		pRequest->pAsyncFileLoadBuffer = NULL;
@@ -1315,7 +1389,7 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 
 	pRequest->flags |= LOAD_FLAG_PROPERTY_PRELOADED;
 
-	if ( object_creation_failure )
+	if ( bObjectCreationFailed )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
@@ -1377,6 +1451,32 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	return true;
 }
 
+/// Read the object properties from the loaded object file for the given load request.
+///
+/// This may be run on a deserialization worker thread, so it must not touch anything outside of the request itself.
+///
+/// @param[in] pRequest  Load request.
+void LoosePackageLoader::ReadObjectFile( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->pAsyncFileLoadBuffer );
+
+	StaticMemoryStream archiveStream( pRequest->pAsyncFileLoadBuffer, pRequest->asyncFileLoadBufferSize );
+
+	DynamicArray< Reflect::ObjectPtr > objects;
+	objects.Push( pRequest->spObject.Get() ); // use existing objects
+	Persist::ArchiveReaderJson::ReadFromStream( archiveStream, objects, pRequest->pResolver );
+	HELIUM_ASSERT( objects[0].Get() == pRequest->spObject.Get() );
+}
+
+/// AsyncDeserializer callback for reading object files on a worker thread.
+///
+/// @param[in] pData  Load request.
+void LoosePackageLoader::DeserializeCallback( void* pData )
+{
+	ReadObjectFile( static_cast< LoadRequest* >( pData ) );
+}
+
 /// Update processing of persistent resource data loading for a given load request.
 ///
 /// @param[in] pRequest  Load request to process.
@@ -130,6 +130,9 @@ namespace Helium
 			void* pAsyncFileLoadBuffer;
 			size_t asyncFileLoadBufferSize;
 
+			/// Async deserialization ID for the object file.
+			size_t deserializeId;
+
 			/// Load flags.
 			uint32_t flags;
 
@@ -182,9 +185,13 @@ namespace Helium
 		//@{
 		void TickPreload();
 
-		void TickLoadRequests();
+		bool TickLoadRequests();
 		bool TickDeserialize( LoadRequest* pRequest );
+		bool FinishDeserialize( LoadRequest* pRequest, bool bObjectCreationFailed );
 		bool TickPersistentResourcePreload( LoadRequest* pRequest );
+
+		static void ReadObjectFile( LoadRequest* pRequest );
+		static void DeserializeCallback( void* pData );
 		//@}
 
 		size_t FindObjectByPath( const AssetPath &path ) const;
@@ -0,0 +1,400 @@
+#include "Precompile.h"
+#include "Rendering/RDeferredCommandProxy.h"
+
+#include "Rendering/RBlendState.h"
+#include "Rendering/RConstantBuffer.h"
+#include "Rendering/RDepthStencilState.h"
+#include "Rendering/RFence.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RPixelShader.h"
+#include "Rendering/RRasterizerState.h"
+#include "Rendering/RSamplerState.h"
+#include "Rendering/RSurface.h"
+#include "Rendering/RTexture.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RVertexInputLayout.h"
+#include "Rendering/RVertexShader.h"
+
+using namespace Helium;
+
+/// Constructor.
+RDeferredCommandProxy::RDeferredCommandProxy()
+    : m_lastCommandListSize( 0 )
+{
+}
+
+/// Destructor.
+RDeferredCommandProxy::~RDeferredCommandProxy()
+{
+}
+
+/// @copydoc RRenderCommandProxy::SetRasterizerState()
+void RDeferredCommandProxy::SetRasterizerState( RRasterizerState* pState )
+{
+    RecordResourceCommand( RRecordedCommandList::COMMAND_SET_RASTERIZER_STATE, pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetBlendState()
+void RDeferredCommandProxy::SetBlendState( RBlendState* pState )
+{
+    RecordResourceCommand( RRecordedCommandList::COMMAND_SET_BLEND_STATE, pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetDepthStencilState()
+void RDeferredCommandProxy::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
+{
+    RRecordedCommandList* pCommandList = GetCommandList();
+
+    RRecordedCommandList::SetDepthStencilStateCommand* pCommand =
+        pCommandList->NewCommand< RRecordedCommandList::SetDepthStencilStateCommand >(
+            RRecordedCommandList::COMMAND_SET_DEPTH_STENCIL_STATE );
+    pCommand->pState = pState;
+    pCommand->stencilReferenceValue = stencilReferenceValue;
+
+    pCommandList->AddReference( pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetSamplerStates()
+void RDeferredCommandProxy::SetSamplerStates(
+    size_t startIndex,
+    size_t samplerCount,
+    RSamplerState* const* ppStates )
+{
+    HELIUM_ASSERT( ppStates || samplerCount == 0 );
+
+    RRecordedCommandList* pCommandList = GetCommandList();
+
+    RRecordedCommandList::SetSamplerStatesCommand* pCommand =
+        pCommandList->NewCommand< RRecordedCommandList::SetSamplerStatesCommand >(
+            RRecordedCommandList::COMMAND_SET_SAMPLER_STATES,
+            sizeof( RSamplerState* ) * samplerCount );
+    pCommand->startIndex = static_cast< uint32_t >( startIndex );
+    pCommand->samplerCount = static_cast< uint32_t >( samplerCount );
+
+    RSamplerState** ppCommandStates = reinterpret_cast< RSamplerState** >( pCommand + 1 );
+    for( size_t samplerIndex = 0; samplerIndex < samplerCount; ++samplerIndex )
+    {
+        RSamplerState* pState = ppStates[ samplerIndex ];
+        ppCommandStates[ samplerIndex ] = pState;
+        pCommandList->AddReference( pState );
+    }
+}
+
+/// @copydoc RRenderCommandProxy::SetRenderSurfaces()
+void RDeferredCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
+{
+    RRecordedCommandList* pCommandList = GetCommandList();
+
+    RRecordedCommandList::SetRenderSurfacesCommand* pCommand =
+        pCommandList->NewCommand< RRecordedCommandList::SetRenderSurfacesCommand >(
+            RRecordedCommandList::COMMAND_SET_RENDER_SURFACES );
+    pCommand->pRenderTargetSurface = pRenderTargetSurface;
+    pCommand->pDepthStencilSurface = pDepthStencilSurface;
+
+    pCommandList->AddReference( pRenderTargetSurface );
+    pCommandList->AddReference( pDepthStencilSurface );
+}
+
+/// @copydoc RRenderCommandProxy::SetViewport()
+void RDeferredCommandProxy::SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+{
+    RRecordedCommandList::SetViewportCommand* pCommand =
+        GetCommandList()->NewCommand< RRecordedCommandList::SetViewportCommand >(
+            RRecordedCommandList::COMMAND_SET_VIEWPORT );
+    pCommand->x = x;
+    pCommand->y = y;
+    pCommand->width = width;
+    pCommand->height = height;
+}
+
+/// @copydoc RRenderCommandProxy::BeginScene()
+void RDeferredCommandProxy::BeginScene()
+{
+    GetCommandList()->AllocateCommand( RRecordedCommandList::COMMAND_BEGIN_SCENE, 0 );
+}
+
+/// @copydoc RRenderCommandProxy::EndScene()
+void RDeferredCommandProxy::EndScene()
+{
+    GetCommandList()->AllocateCommand( RRecordedCommandList::COMMAND_END_SCENE, 0 );
+}
+
+/// @copydoc RRenderCommandProxy::Clear()
+void RDeferredCommandProxy::Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil )
+{
+    RRecordedCommandList::ClearCommand* pCommand =
+        GetCommandList()->NewCommand< RRecordedCommandList::ClearCommand >( RRecordedCommandList::COMMAND_CLEAR );
+    pCommand->clearFlags = clearFlags;
+    pCommand->color = rColor.GetArgb();
+    pCommand->depth = depth;
+    pCommand->stencil = stencil;
+}
+
+/// @copydoc RRenderCommandProxy::SetIndexBuffer()
+void RDeferredCommandProxy::SetIndexBuffer( RIndexBuffer* pBuffer )
+{
+    RecordResourceCommand( RRecordedCommandList::COMMAND_SET_INDEX_BUFFER, pBuffer );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexBuffers()
+void RDeferredCommandProxy::SetVertexBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RVertexBuffer* const* ppBuffers,
+    uint32_t* pStrides,
+    uint32_t* pOffsets )
+{
+    HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+    HELIUM_ASSERT( pStrides || bufferCount == 0 );
+    HELIUM_ASSERT( pOffsets || bufferCount == 0 );
+
+    RRecordedCommandList* pCommandList = GetCommandList();
+
+    RRecordedCommandList::SetVertexBuffersCommand* pCommand =
+        pCommandList->NewCommand< RRecordedCommandList::SetVertexBuffersCommand >(
+            RRecordedCommandList::COMMAND_SET_VERTEX_BUFFERS,
+            ( sizeof( RVertexBuffer* ) + sizeof( uint32_t ) * 2 ) * bufferCount );
+    pCommand->startIndex = static_cast< uint32_t >( startIndex );
+    pCommand->bufferCount = static_cast< uint32_t >( bufferCount );
+
+    RVertexBuffer** ppCommandBuffers = reinterpret_cast< RVertexBuffer** >( pCommand + 1 );
+    for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+    {
+        RVertexBuffer* pBuffer = ppBuffers[ bufferIndex ];
+        ppCommandBuffers[ bufferIndex ] = pBuffer;
+        pCommandList->AddReference( pBuffer );
+    }
+
+    if( bufferCount != 0 )
+    {
+        uint32_t* pCommandStrides = reinterpret_cast< uint32_t* >( ppCommandBuffers + bufferCount );
+        MemoryCopy( pCommandStrides, pStrides, sizeof( uint32_t ) * bufferCount );
+        MemoryCopy( pCommandStrides + bufferCount, pOffsets, sizeof( uint32_t ) * bufferCount );
+    }
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexInputLayout()
+void RDeferredCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayout )
+{
+    RecordResourceCommand( RRecordedCommandList::COMMAND_SET_VERTEX_INPUT_LAYOUT, pLayout );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexShader()
+void RDeferredCommandProxy::SetVertexShader( RVertexShader* pShader )
+{
+    RecordResourceCommand( RRecordedCommandList::COMMAND_SET_VERTEX_SHADER, pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelShader()
+void RDeferredCommandProxy::SetPixelShader( RPixelShader* pShader )
+{
+    RecordResourceCommand( RRecordedCommandList::COMMAND_SET_PIXEL_SHADER, pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexConstantBuffers()
+void RDeferredCommandProxy::SetVertexConstantBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    RecordConstantBuffers(
+        RRecordedCommandList::COMMAND_SET_VERTEX_CONSTANT_BUFFERS,
+        startIndex,
+        bufferCount,
+        ppBuffers,
+        pLimitSizes );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelConstantBuffers()
+void RDeferredCommandProxy::SetPixelConstantBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    RecordConstantBuffers(
+        RRecordedCommandList::COMMAND_SET_PIXEL_CONSTANT_BUFFERS,
+        startIndex,
+        bufferCount,
+        ppBuffers,
+        pLimitSizes );
+}
+
+/// @copydoc RRenderCommandProxy::SetTexture()
+void RDeferredCommandProxy::SetTexture( size_t samplerIndex, RTexture* pTexture )
+{
+    RRecordedCommandList* pCommandList = GetCommandList();
+
+    RRecordedCommandList::SetTextureCommand* pCommand =
+        pCommandList->NewCommand< RRecordedCommandList::SetTextureCommand >(
+            RRecordedCommandList::COMMAND_SET_TEXTURE );
+    pCommand->pTexture = pTexture;
+    pCommand->samplerIndex = static_cast< uint32_t >( samplerIndex );
+
+    pCommandList->AddReference( pTexture );
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexed()
+void RDeferredCommandProxy::DrawIndexed(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t minIndex,
+    uint32_t usedVertexCount,
+    uint32_t startIndex,
+    uint32_t primitiveCount )
+{
+    RRecordedCommandList::DrawIndexedCommand* pCommand =
+        GetCommandList()->NewCommand< RRecordedCommandList::DrawIndexedCommand >(
+            RRecordedCommandList::COMMAND_DRAW_INDEXED );
+    pCommand->primitiveType = static_cast< uint32_t >( primitiveType );
+    pCommand->baseVertexIndex = baseVertexIndex;
+    pCommand->minIndex = minIndex;
+    pCommand->usedVertexCount = usedVertexCount;
+    pCommand->startIndex = startIndex;
+    pCommand->primitiveCount = primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexedInstanced()
+void RDeferredCommandProxy::DrawIndexedInstanced(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t minIndex,
+    uint32_t usedVertexCount,
+    uint32_t startIndex,
+    uint32_t primitiveCount,
+    uint32_t instanceCount )
+{
+    RRecordedCommandList::DrawIndexedInstancedCommand* pCommand =
+        GetCommandList()->NewCommand< RRecordedCommandList::DrawIndexedInstancedCommand >(
+            RRecordedCommandList::COMMAND_DRAW_INDEXED_INSTANCED );
+    pCommand->primitiveType = static_cast< uint32_t >( primitiveType );
+    pCommand->baseVertexIndex = baseVertexIndex;
+    pCommand->minIndex = minIndex;
+    pCommand->usedVertexCount = usedVertexCount;
+    pCommand->startIndex = startIndex;
+    pCommand->primitiveCount = primitiveCount;
+    pCommand->instanceCount = instanceCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawUnindexed()
+void RDeferredCommandProxy::DrawUnindexed(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t primitiveCount )
+{
+    RRecordedCommandList::DrawUnindexedCommand* pCommand =
+        GetCommandList()->NewCommand< RRecordedCommandList::DrawUnindexedCommand >(
+            RRecordedCommandList::COMMAND_DRAW_UNINDEXED );
+    pCommand->primitiveType = static_cast< uint32_t >( primitiveType );
+    pCommand->baseVertexIndex = baseVertexIndex;
+    pCommand->primitiveCount = primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetFence()
+void RDeferredCommandProxy::SetFence( RFence* pFence )
+{
+    RecordResourceCommand( RRecordedCommandList::COMMAND_SET_FENCE, pFence );
+}
+
+/// @copydoc RRenderCommandProxy::UnbindResources()
+void RDeferredCommandProxy::UnbindResources()
+{
+    GetCommandList()->AllocateCommand( RRecordedCommandList::COMMAND_UNBIND_RESOURCES, 0 );
+}
+
+/// @copydoc RRenderCommandProxy::ExecuteCommandList()
+void RDeferredCommandProxy::ExecuteCommandList( RRenderCommandList* pCommandList )
+{
+    HELIUM_ASSERT( pCommandList );
+    HELIUM_ASSERT( pCommandList != m_spCommandList );
+
+    RecordResourceCommand( RRecordedCommandList::COMMAND_EXECUTE_COMMAND_LIST, pCommandList );
+}
+
+/// @copydoc RRenderCommandProxy::FinishCommandList()
+void RDeferredCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCommandList )
+{
+    rspCommandList = GetCommandList();
+    m_lastCommandListSize = m_spCommandList->GetSize();
+    m_spCommandList.Release();
+}
+
+/// Get the command list currently being recorded, starting a new list if necessary.
+///
+/// New lists reserve enough space for the previously finished list, so proxies that record a similar set of commands
+/// each frame rarely need to grow their command buffers.
+///
+/// @return  Current command list.
+RRecordedCommandList* RDeferredCommandProxy::GetCommandList()
+{
+    if( !m_spCommandList )
+    {
+        m_spCommandList = new RRecordedCommandList( m_lastCommandListSize );
+        HELIUM_ASSERT( m_spCommandList );
+    }
+
+    return m_spCommandList;
+}
+
+/// Record a command taking a single render resource.
+///
+/// @param[in] type       Command type.
+/// @param[in] pResource  Resource to record.
+void RDeferredCommandProxy::RecordResourceCommand(
+    RRecordedCommandList::ECommandType type,
+    RRenderResource* pResource )
+{
+    RRecordedCommandList* pCommandList = GetCommandList();
+
+    RRecordedCommandList::ResourceCommand* pCommand =
+        pCommandList->NewCommand< RRecordedCommandList::ResourceCommand >( type );
+    pCommand->pResource = pResource;
+
+    pCommandList->AddReference( pResource );
+}
+
+/// Record a vertex or pixel shader constant buffer command.
+///
+/// @param[in] type         Command type.
+/// @param[in] startIndex   Starting constant buffer index to set.
+/// @param[in] bufferCount  Number of consecutive constant buffers to set.
+/// @param[in] ppBuffers    Array of constant buffers to set.
+/// @param[in] pLimitSizes  Optional array of update range limits for each constant buffer.
+void RDeferredCommandProxy::RecordConstantBuffers(
+    RRecordedCommandList::ECommandType type,
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+    RRecordedCommandList* pCommandList = GetCommandList();
+
+    size_t extraSize = sizeof( RConstantBuffer* ) * bufferCount;
+    if( pLimitSizes )
+    {
+        extraSize += sizeof( size_t ) * bufferCount;
+    }
+
+    RRecordedCommandList::SetConstantBuffersCommand* pCommand =
+        pCommandList->NewCommand< RRecordedCommandList::SetConstantBuffersCommand >( type, extraSize );
+    pCommand->startIndex = static_cast< uint32_t >( startIndex );
+    pCommand->bufferCount = static_cast< uint32_t >( bufferCount );
+    pCommand->bLimitSizes = ( pLimitSizes ? 1 : 0 );
+    pCommand->padding = 0;
+
+    RConstantBuffer** ppCommandBuffers = reinterpret_cast< RConstantBuffer** >( pCommand + 1 );
+    for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+    {
+        RConstantBuffer* pBuffer = ppBuffers[ bufferIndex ];
+        ppCommandBuffers[ bufferIndex ] = pBuffer;
+        pCommandList->AddReference( pBuffer );
+    }
+
+    if( pLimitSizes && bufferCount != 0 )
+    {
+        MemoryCopy( ppCommandBuffers + bufferCount, pLimitSizes, sizeof( size_t ) * bufferCount );
+    }
+}
@@ -1,20 +1,24 @@
 #pragma once
 
-#include "RenderingD3D9/RenderingD3D9.h"
 #include "Rendering/RRenderCommandProxy.h"
 
+#include "Rendering/RRecordedCommandList.h"
+
 namespace Helium
 {
-    HELIUM_DECLARE_RPTR( D3D9RenderCommandList );
-
-    /// Render command proxy for building command lists for deferred issuing of rendering commands to the GPU command
-    /// buffer.
-    class D3D9DeferredCommandProxy : public RRenderCommandProxy
+    HELIUM_DECLARE_RPTR( RRecordedCommandList );
+
+    /// Render command proxy for recording commands into an RRecordedCommandList.
+    ///
+    /// This can be used by any renderer implementation to provide deferred command proxies.  Each proxy should only be
+    /// used by one thread at a time, although separate proxies can record on separate threads concurrently.  Recorded
+    /// lists are played back by passing them to ExecuteCommandList() on the immediate command proxy.
+    class HELIUM_RENDERING_API RDeferredCommandProxy : public RRenderCommandProxy
     {
     public:
         /// @name Construction/Destruction
         //@{
-        D3D9DeferredCommandProxy();
+        RDeferredCommandProxy();
         //@}
 
         /// @name State Management
@@ -59,6 +63,9 @@ namespace Helium
         void DrawIndexed(
             ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
             uint32_t startIndex, uint32_t primitiveCount );
+        void DrawIndexedInstanced(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount );
         void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
         //@}
 
@@ -80,12 +87,23 @@ namespace Helium
         //@}
 
     private:
-        /// Command list.
-        D3D9RenderCommandListPtr m_spCommandList;
+        /// Command list currently being recorded.
+        RRecordedCommandListPtr m_spCommandList;
+        /// Size of the last finished command list (used to reserve space for the next list).
+        size_t m_lastCommandListSize;
 
         /// @name Construction/Destruction
         //@{
-        ~D3D9DeferredCommandProxy();
+        ~RDeferredCommandProxy();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        RRecordedCommandList* GetCommandList();
+        void RecordResourceCommand( RRecordedCommandList::ECommandType type, RRenderResource* pResource );
+        void RecordConstantBuffers(
+            RRecordedCommandList::ECommandType type, size_t startIndex, size_t bufferCount,
+            RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes );
         //@}
     };
 }
@@ -0,0 +1,349 @@
+#include "Precompile.h"
+#include "Rendering/RRecordedCommandList.h"
+
+#include "Rendering/RBlendState.h"
+#include "Rendering/RConstantBuffer.h"
+#include "Rendering/RDepthStencilState.h"
+#include "Rendering/RFence.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RPixelShader.h"
+#include "Rendering/RRasterizerState.h"
+#include "Rendering/RRenderCommandProxy.h"
+#include "Rendering/RSamplerState.h"
+#include "Rendering/RSurface.h"
+#include "Rendering/RTexture.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RVertexInputLayout.h"
+#include "Rendering/RVertexShader.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] capacity  Number of bytes to initially reserve for command data.
+RRecordedCommandList::RRecordedCommandList( size_t capacity )
+    : m_commandCount( 0 )
+{
+    if( capacity != 0 )
+    {
+        m_buffer.Reserve( capacity );
+    }
+}
+
+/// Destructor.
+RRecordedCommandList::~RRecordedCommandList()
+{
+}
+
+/// Allocate space for a new command at the end of this list.
+///
+/// The command header is filled out automatically, while the returned command data is uninitialized and remains valid
+/// only until the next command is allocated.
+///
+/// @param[in] type      Command type.
+/// @param[in] dataSize  Size of the command data, in bytes.
+///
+/// @return  Command data.
+///
+/// @see NewCommand()
+void* RRecordedCommandList::AllocateCommand( ECommandType type, size_t dataSize )
+{
+    HELIUM_ASSERT( static_cast< size_t >( type ) < static_cast< size_t >( COMMAND_TYPE_MAX ) );
+
+    size_t commandSize = Align( sizeof( CommandHeader ) + dataSize, COMMAND_ALIGNMENT );
+    HELIUM_ASSERT( commandSize <= UINT32_MAX );
+
+    size_t offset = m_buffer.GetSize();
+    m_buffer.Resize( offset + commandSize );
+
+    CommandHeader* pHeader = reinterpret_cast< CommandHeader* >( m_buffer.GetData() + offset );
+    pHeader->type = static_cast< uint32_t >( type );
+    pHeader->size = static_cast< uint32_t >( commandSize );
+
+    ++m_commandCount;
+
+    return pHeader + 1;
+}
+
+/// Issue each command recorded in this list through the given command proxy, in the order in which they were
+/// recorded.
+///
+/// @param[in] pCommandProxy  Command proxy through which to issue commands.
+void RRecordedCommandList::Execute( RRenderCommandProxy* pCommandProxy )
+{
+    HELIUM_ASSERT( pCommandProxy );
+
+    uint8_t* pCommand = m_buffer.GetData();
+    uint8_t* pBufferEnd = pCommand + m_buffer.GetSize();
+    while( pCommand < pBufferEnd )
+    {
+        const CommandHeader* pHeader = reinterpret_cast< const CommandHeader* >( pCommand );
+        HELIUM_ASSERT( pHeader->size >= sizeof( CommandHeader ) );
+        HELIUM_ASSERT( pHeader->size <= static_cast< size_t >( pBufferEnd - pCommand ) );
+
+        void* pData = pCommand + sizeof( CommandHeader );
+
+        switch( pHeader->type )
+        {
+            case COMMAND_SET_RASTERIZER_STATE:
+            {
+                ResourceCommand* pResourceCommand = static_cast< ResourceCommand* >( pData );
+                pCommandProxy->SetRasterizerState( static_cast< RRasterizerState* >( pResourceCommand->pResource ) );
+
+                break;
+            }
+
+            case COMMAND_SET_BLEND_STATE:
+            {
+                ResourceCommand* pResourceCommand = static_cast< ResourceCommand* >( pData );
+                pCommandProxy->SetBlendState( static_cast< RBlendState* >( pResourceCommand->pResource ) );
+
+                break;
+            }
+
+            case COMMAND_SET_DEPTH_STENCIL_STATE:
+            {
+                SetDepthStencilStateCommand* pStateCommand = static_cast< SetDepthStencilStateCommand* >( pData );
+                pCommandProxy->SetDepthStencilState(
+                    static_cast< RDepthStencilState* >( pStateCommand->pState ),
+                    static_cast< uint8_t >( pStateCommand->stencilReferenceValue ) );
+
+                break;
+            }
+
+            case COMMAND_SET_SAMPLER_STATES:
+            {
+                SetSamplerStatesCommand* pStatesCommand = static_cast< SetSamplerStatesCommand* >( pData );
+                pCommandProxy->SetSamplerStates(
+                    pStatesCommand->startIndex,
+                    pStatesCommand->samplerCount,
+                    reinterpret_cast< RSamplerState* const* >( pStatesCommand + 1 ) );
+
+                break;
+            }
+
+            case COMMAND_SET_RENDER_SURFACES:
+            {
+                SetRenderSurfacesCommand* pSurfacesCommand = static_cast< SetRenderSurfacesCommand* >( pData );
+                pCommandProxy->SetRenderSurfaces(
+                    static_cast< RSurface* >( pSurfacesCommand->pRenderTargetSurface ),
+                    static_cast< RSurface* >( pSurfacesCommand->pDepthStencilSurface ) );
+
+                break;
+            }
+
+            case COMMAND_SET_VIEWPORT:
+            {
+                SetViewportCommand* pViewportCommand = static_cast< SetViewportCommand* >( pData );
+                pCommandProxy->SetViewport(
+                    pViewportCommand->x,
+                    pViewportCommand->y,
+                    pViewportCommand->width,
+                    pViewportCommand->height );
+
+                break;
+            }
+
+            case COMMAND_BEGIN_SCENE:
+            {
+                pCommandProxy->BeginScene();
+
+                break;
+            }
+
+            case COMMAND_END_SCENE:
+            {
+                pCommandProxy->EndScene();
+
+                break;
+            }
+
+            case COMMAND_CLEAR:
+            {
+                ClearCommand* pClearCommand = static_cast< ClearCommand* >( pData );
+
+                Color color;
+                color.SetArgb( pClearCommand->color );
+
+                pCommandProxy->Clear(
+                    pClearCommand->clearFlags,
+                    color,
+                    pClearCommand->depth,
+                    static_cast< uint8_t >( pClearCommand->stencil ) );
+
+                break;
+            }
+
+            case COMMAND_SET_INDEX_BUFFER:
+            {
+                ResourceCommand* pResourceCommand = static_cast< ResourceCommand* >( pData );
+                pCommandProxy->SetIndexBuffer( static_cast< RIndexBuffer* >( pResourceCommand->pResource ) );
+
+                break;
+            }
+
+            case COMMAND_SET_VERTEX_BUFFERS:
+            {
+                SetVertexBuffersCommand* pBuffersCommand = static_cast< SetVertexBuffersCommand* >( pData );
+                uint32_t bufferCount = pBuffersCommand->bufferCount;
+
+                RVertexBuffer** ppBuffers = reinterpret_cast< RVertexBuffer** >( pBuffersCommand + 1 );
+                uint32_t* pStrides = reinterpret_cast< uint32_t* >( ppBuffers + bufferCount );
+                uint32_t* pOffsets = pStrides + bufferCount;
+
+                pCommandProxy->SetVertexBuffers(
+                    pBuffersCommand->startIndex,
+                    bufferCount,
+                    ppBuffers,
+                    pStrides,
+                    pOffsets );
+
+                break;
+            }
+
+            case COMMAND_SET_VERTEX_INPUT_LAYOUT:
+            {
+                ResourceCommand* pResourceCommand = static_cast< ResourceCommand* >( pData );
+                pCommandProxy->SetVertexInputLayout(
+                    static_cast< RVertexInputLayout* >( pResourceCommand->pResource ) );
+
+                break;
+            }
+
+            case COMMAND_SET_VERTEX_SHADER:
+            {
+                ResourceCommand* pResourceCommand = static_cast< ResourceCommand* >( pData );
+                pCommandProxy->SetVertexShader( static_cast< RVertexShader* >( pResourceCommand->pResource ) );
+
+                break;
+            }
+
+            case COMMAND_SET_PIXEL_SHADER:
+            {
+                ResourceCommand* pResourceCommand = static_cast< ResourceCommand* >( pData );
+                pCommandProxy->SetPixelShader( static_cast< RPixelShader* >( pResourceCommand->pResource ) );
+
+                break;
+            }
+
+            case COMMAND_SET_VERTEX_CONSTANT_BUFFERS:
+            case COMMAND_SET_PIXEL_CONSTANT_BUFFERS:
+            {
+                SetConstantBuffersCommand* pBuffersCommand = static_cast< SetConstantBuffersCommand* >( pData );
+                uint32_t bufferCount = pBuffersCommand->bufferCount;
+
+                RConstantBuffer* const* ppBuffers = reinterpret_cast< RConstantBuffer* const* >( pBuffersCommand + 1 );
+                const size_t* pLimitSizes = NULL;
+                if( pBuffersCommand->bLimitSizes )
+                {
+                    pLimitSizes = reinterpret_cast< const size_t* >( ppBuffers + bufferCount );
+                }
+
+                if( pHeader->type == COMMAND_SET_VERTEX_CONSTANT_BUFFERS )
+                {
+                    pCommandProxy->SetVertexConstantBuffers(
+                        pBuffersCommand->startIndex,
+                        bufferCount,
+                        ppBuffers,
+                        pLimitSizes );
+                }
+                else
+                {
+                    pCommandProxy->SetPixelConstantBuffers(
+                        pBuffersCommand->startIndex,
+                        bufferCount,
+                        ppBuffers,
+                        pLimitSizes );
+                }
+
+                break;
+            }
+
+            case COMMAND_SET_TEXTURE:
+            {
+                SetTextureCommand* pTextureCommand = static_cast< SetTextureCommand* >( pData );
+                pCommandProxy->SetTexture(
+                    pTextureCommand->samplerIndex,
+                    static_cast< RTexture* >( pTextureCommand->pTexture ) );
+
+                break;
+            }
+
+            case COMMAND_DRAW_INDEXED:
+            {
+                DrawIndexedCommand* pDrawCommand = static_cast< DrawIndexedCommand* >( pData );
+                pCommandProxy->DrawIndexed(
+                    static_cast< ERendererPrimitiveType >( pDrawCommand->primitiveType ),
+                    pDrawCommand->baseVertexIndex,
+                    pDrawCommand->minIndex,
+                    pDrawCommand->usedVertexCount,
+                    pDrawCommand->startIndex,
+                    pDrawCommand->primitiveCount );
+
+                break;
+            }
+
+            case COMMAND_DRAW_INDEXED_INSTANCED:
+            {
+                DrawIndexedInstancedCommand* pDrawCommand = static_cast< DrawIndexedInstancedCommand* >( pData );
+                pCommandProxy->DrawIndexedInstanced(
+                    static_cast< ERendererPrimitiveType >( pDrawCommand->primitiveType ),
+                    pDrawCommand->baseVertexIndex,
+                    pDrawCommand->minIndex,
+                    pDrawCommand->usedVertexCount,
+                    pDrawCommand->startIndex,
+                    pDrawCommand->primitiveCount,
+                    pDrawCommand->instanceCount );
+
+                break;
+            }
+
+            case COMMAND_DRAW_UNINDEXED:
+            {
+                DrawUnindexedCommand* pDrawCommand = static_cast< DrawUnindexedCommand* >( pData );
+                pCommandProxy->DrawUnindexed(
+                    static_cast< ERendererPrimitiveType >( pDrawCommand->primitiveType ),
+                    pDrawCommand->baseVertexIndex,
+                    pDrawCommand->primitiveCount );
+
+                break;
+            }
+
+            case COMMAND_SET_FENCE:
+            {
+                ResourceCommand* pResourceCommand = static_cast< ResourceCommand* >( pData );
+                pCommandProxy->SetFence( static_cast< RFence* >( pResourceCommand->pResource ) );
+
+                break;
+            }
+
+            case COMMAND_UNBIND_RESOURCES:
+            {
+                pCommandProxy->UnbindResources();
+
+                break;
+            }
+
+            case COMMAND_EXECUTE_COMMAND_LIST:
+            {
+                ResourceCommand* pResourceCommand = static_cast< ResourceCommand* >( pData );
+                pCommandProxy->ExecuteCommandList( static_cast< RRenderCommandList* >( pResourceCommand->pResource ) );
+
+                break;
+            }
+
+            default:
+            {
+                HELIUM_TRACE(
+                    TraceLevels::Error,
+                    "RRecordedCommandList::Execute(): Invalid command type %" PRIu32 " encountered.\n",
+                    pHeader->type );
+                HELIUM_BREAK();
+
+                break;
+            }
+        }
+
+        pCommand += pHeader->size;
+    }
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "Rendering/RRenderCommandList.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    class RRenderCommandProxy;
+
+    HELIUM_DECLARE_RPTR( RRenderResource );
+
+    /// Backend-independent render command list.
+    ///
+    /// Commands are packed back to back in a single growable buffer, each as a small header followed by plain command
+    /// data, with any variable-length arguments (such as arrays of buffers) stored inline immediately after the fixed
+    /// command data.  Render resources are stored in the command data as raw pointers, while a reference to each is
+    /// held by the list itself until the list is destroyed.
+    ///
+    /// Command lists are recorded through RDeferredCommandProxy, and can be played back through any command proxy
+    /// using Execute(), allowing renderer implementations without native command list support to record commands on
+    /// worker threads and issue them from the render thread.
+    class HELIUM_RENDERING_API RRecordedCommandList : public RRenderCommandList
+    {
+    public:
+        /// Command types.
+        enum ECommandType
+        {
+            COMMAND_SET_RASTERIZER_STATE,
+            COMMAND_SET_BLEND_STATE,
+            COMMAND_SET_DEPTH_STENCIL_STATE,
+            COMMAND_SET_SAMPLER_STATES,
+            COMMAND_SET_RENDER_SURFACES,
+            COMMAND_SET_VIEWPORT,
+            COMMAND_BEGIN_SCENE,
+            COMMAND_END_SCENE,
+            COMMAND_CLEAR,
+            COMMAND_SET_INDEX_BUFFER,
+            COMMAND_SET_VERTEX_BUFFERS,
+            COMMAND_SET_VERTEX_INPUT_LAYOUT,
+            COMMAND_SET_VERTEX_SHADER,
+            COMMAND_SET_PIXEL_SHADER,
+            COMMAND_SET_VERTEX_CONSTANT_BUFFERS,
+            COMMAND_SET_PIXEL_CONSTANT_BUFFERS,
+            COMMAND_SET_TEXTURE,
+            COMMAND_DRAW_INDEXED,
+            COMMAND_DRAW_INDEXED_INSTANCED,
+            COMMAND_DRAW_UNINDEXED,
+            COMMAND_SET_FENCE,
+            COMMAND_UNBIND_RESOURCES,
+            COMMAND_EXECUTE_COMMAND_LIST,
+
+            COMMAND_TYPE_MAX
+        };
+
+        /// Alignment of each command within the command buffer.
+        static const size_t COMMAND_ALIGNMENT = sizeof( uint64_t );
+
+        /// Command header.
+        struct CommandHeader
+        {
+            /// Command type (ECommandType value).
+            uint32_t type;
+            /// Total size of the command, including this header and any padding, in bytes.
+            uint32_t size;
+        };
+
+        /// Command data for commands that take a single render resource.
+        struct ResourceCommand
+        {
+            /// Resource to set.
+            RRenderResource* pResource;
+        };
+
+        /// COMMAND_SET_DEPTH_STENCIL_STATE command data.
+        struct SetDepthStencilStateCommand
+        {
+            /// Depth-stencil state.
+            RRenderResource* pState;
+            /// Stencil reference value.
+            uint32_t stencilReferenceValue;
+        };
+
+        /// COMMAND_SET_SAMPLER_STATES command data (followed by an array of "samplerCount" sampler state pointers).
+        struct SetSamplerStatesCommand
+        {
+            /// Index of the first sampler to set.
+            uint32_t startIndex;
+            /// Number of sampler states.
+            uint32_t samplerCount;
+        };
+
+        /// COMMAND_SET_RENDER_SURFACES command data.
+        struct SetRenderSurfacesCommand
+        {
+            /// Render target surface.
+            RRenderResource* pRenderTargetSurface;
+            /// Depth-stencil surface.
+            RRenderResource* pDepthStencilSurface;
+        };
+
+        /// COMMAND_SET_VIEWPORT command data.
+        struct SetViewportCommand
+        {
+            /// Horizontal pixel coordinate of the top-left corner of the viewport.
+            uint32_t x;
+            /// Vertical pixel coordinate of the top-left corner of the viewport.
+            uint32_t y;
+            /// Viewport width, in pixels.
+            uint32_t width;
+            /// Viewport height, in pixels.
+            uint32_t height;
+        };
+
+        /// COMMAND_CLEAR command data.
+        struct ClearCommand
+        {
+            /// ERendererClearFlag flags.
+            uint32_t clearFlags;
+            /// Clear color, packed as ARGB.
+            uint32_t color;
+            /// Depth clear value.
+            float32_t depth;
+            /// Stencil clear value.
+            uint32_t stencil;
+        };
+
+        /// COMMAND_SET_VERTEX_BUFFERS command data (followed by arrays of "bufferCount" vertex buffer pointers,
+        /// strides, and offsets).
+        struct SetVertexBuffersCommand
+        {
+            /// Index of the first vertex buffer to set.
+            uint32_t startIndex;
+            /// Number of vertex buffers.
+            uint32_t bufferCount;
+        };
+
+        /// COMMAND_SET_VERTEX_CONSTANT_BUFFERS and COMMAND_SET_PIXEL_CONSTANT_BUFFERS command data (followed by an
+        /// array of "bufferCount" constant buffer pointers and, if "bLimitSizes" is set, an array of limit sizes).
+        struct SetConstantBuffersCommand
+        {
+            /// Index of the first constant buffer to set.
+            uint32_t startIndex;
+            /// Number of constant buffers.
+            uint32_t bufferCount;
+            /// Non-zero if limit sizes follow the buffer array.
+            uint32_t bLimitSizes;
+            /// Padding to keep the buffer pointer array aligned.
+            uint32_t padding;
+        };
+
+        /// COMMAND_SET_TEXTURE command data.
+        struct SetTextureCommand
+        {
+            /// Texture to set.
+            RRenderResource* pTexture;
+            /// Index of the sampler to set.
+            uint32_t samplerIndex;
+        };
+
+        /// COMMAND_DRAW_INDEXED command data.
+        struct DrawIndexedCommand
+        {
+            /// Primitive type (ERendererPrimitiveType value).
+            uint32_t primitiveType;
+            /// Vertex offset of the first vertex to use.
+            uint32_t baseVertexIndex;
+            /// Minimum vertex index value.
+            uint32_t minIndex;
+            /// Range of vertices used.
+            uint32_t usedVertexCount;
+            /// Offset of the first index to use.
+            uint32_t startIndex;
+            /// Number of primitives to render.
+            uint32_t primitiveCount;
+        };
+
+        /// COMMAND_DRAW_INDEXED_INSTANCED command data.
+        struct DrawIndexedInstancedCommand
+        {
+            /// Primitive type (ERendererPrimitiveType value).
+            uint32_t primitiveType;
+            /// Vertex offset of the first vertex to use.
+            uint32_t baseVertexIndex;
+            /// Minimum vertex index value.
+            uint32_t minIndex;
+            /// Range of vertices used.
+            uint32_t usedVertexCount;
+            /// Offset of the first index to use.
+            uint32_t startIndex;
+            /// Number of primitives to render for each instance.
+            uint32_t primitiveCount;
+            /// Number of instances to render.
+            uint32_t instanceCount;
+        };
+
+        /// COMMAND_DRAW_UNINDEXED command data.
+        struct DrawUnindexedCommand
+        {
+            /// Primitive type (ERendererPrimitiveType value).
+            uint32_t primitiveType;
+            /// Vertex offset of the first vertex to use.
+            uint32_t baseVertexIndex;
+            /// Number of primitives to render.
+            uint32_t primitiveCount;
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        explicit RRecordedCommandList( size_t capacity = 0 );
+        //@}
+
+        /// @name Command Recording
+        //@{
+        void* AllocateCommand( ECommandType type, size_t dataSize );
+        template< typename T > T* NewCommand( ECommandType type, size_t extraSize = 0 );
+
+        inline void AddReference( RRenderResource* pResource );
+        //@}
+
+        /// @name Command Execution
+        //@{
+        void Execute( RRenderCommandProxy* pCommandProxy );
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline size_t GetCommandCount() const;
+        inline size_t GetSize() const;
+        //@}
+
+    private:
+        /// Command buffer.
+        DynamicArray< uint8_t > m_buffer;
+        /// References to each render resource used by the recorded commands.
+        DynamicArray< RRenderResourcePtr > m_references;
+        /// Number of recorded commands.
+        size_t m_commandCount;
+
+        /// @name Construction/Destruction
+        //@{
+        ~RRecordedCommandList();
+        //@}
+    };
+}
+
+#include "Rendering/RRecordedCommandList.inl"
@@ -0,0 +1,50 @@
+namespace Helium
+{
+    /// Allocate a new command with data of the template type.
+    ///
+    /// The returned command data is uninitialized, and remains valid only until the next command is allocated.
+    ///
+    /// @param[in] type       Command type.
+    /// @param[in] extraSize  Number of bytes to reserve immediately after the command data for variable-length
+    ///                       arguments.
+    ///
+    /// @return  Command data.
+    ///
+    /// @see AllocateCommand()
+    template< typename T >
+    T* RRecordedCommandList::NewCommand( ECommandType type, size_t extraSize )
+    {
+        return static_cast< T* >( AllocateCommand( type, sizeof( T ) + extraSize ) );
+    }
+
+    /// Hold a reference to a render resource used by a recorded command for the lifetime of this list.
+    ///
+    /// @param[in] pResource  Render resource (can be null, in which case nothing is done).
+    void RRecordedCommandList::AddReference( RRenderResource* pResource )
+    {
+        if( pResource )
+        {
+            m_references.New( pResource );
+        }
+    }
+
+    /// Get the number of commands recorded in this list.
+    ///
+    /// @return  Command count.
+    ///
+    /// @see GetSize()
+    size_t RRecordedCommandList::GetCommandCount() const
+    {
+        return m_commandCount;
+    }
+
+    /// Get the size of the recorded command data.
+    ///
+    /// @return  Command buffer size, in bytes.
+    ///
+    /// @see GetCommandCount()
+    size_t RRecordedCommandList::GetSize() const
+    {
+        return m_buffer.GetSize();
+    }
+}
@@ -85,6 +85,9 @@ namespace Helium
         virtual void DrawIndexed(
             ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
             uint32_t startIndex, uint32_t primitiveCount ) = 0;
+        virtual void DrawIndexedInstanced(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount ) = 0;
         virtual void DrawUnindexed(
             ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount ) = 0;
         //@}
@@ -21,6 +21,9 @@ namespace Helium
             uint8_t semanticIndex;
             /// Input vertex buffer index.
             uint8_t bufferIndex;
+            /// Number of instances drawn for each element of per-instance data, or zero if the element holds
+            /// per-vertex data (all elements read from the same vertex buffer must use the same rate).
+            uint8_t instanceStepRate;
 
             /// @name Construction/Destruction
             //@{
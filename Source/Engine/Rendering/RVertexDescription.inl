@@ -6,6 +6,7 @@ namespace Helium
         , semantic( RENDERER_VERTEX_SEMANTIC_FIRST )
         , semanticIndex( 0 )
         , bufferIndex( 0 )
+        , instanceStepRate( 0 )
     {
     }
 }
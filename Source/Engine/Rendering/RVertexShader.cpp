@@ -7,6 +7,11 @@
 
 using namespace Helium;
 
+/// Serializes input layout creation across all vertex shaders.  Renderer devices are not created for multithreaded
+/// use (e.g. Direct3D 9 devices are created without D3DCREATE_MULTITHREADED), so only one thread at a time may create
+/// an input layout through the renderer.
+static Mutex g_InputLayoutCreationLock;
+
 /// Constructor.
 RVertexShader::RVertexShader()
 {
@@ -54,3 +59,54 @@ RVertexInputLayout* RVertexShader::GetCachedInputLayout() const
 {
     return m_spCachedInputLayout;
 }
+
+/// Get the input layout for the specified description, creating it if necessary.
+///
+/// Unlike CacheDescription(), this keeps the input layout for each description used with this shader, and can be
+/// called safely from multiple threads (such as when recording deferred command lists).  Input layouts are created
+/// through the renderer by one thread at a time, even across different shaders.  The returned layout remains valid
+/// for the lifetime of this shader.
+///
+/// @param[in] pRenderer     Renderer instance.
+/// @param[in] pDescription  Vertex description.
+///
+/// @return  Input layout for the given description, or null if no description was given.
+///
+/// @see CacheDescription()
+RVertexInputLayout* RVertexShader::GetInputLayout( Renderer* pRenderer, RVertexDescription* pDescription )
+{
+    if( !pDescription )
+    {
+        return NULL;
+    }
+
+    MutexScopeLock scopeLock( m_inputLayoutLock );
+
+    size_t layoutCount = m_inputLayouts.GetSize();
+    for( size_t layoutIndex = 0; layoutIndex < layoutCount; ++layoutIndex )
+    {
+        const InputLayoutEntry& rEntry = m_inputLayouts[ layoutIndex ];
+        if( rEntry.spDescription == pDescription )
+        {
+            return rEntry.spInputLayout;
+        }
+    }
+
+    HELIUM_ASSERT( pRenderer );
+    RVertexInputLayout* pInputLayout;
+    {
+        MutexScopeLock creationLock( g_InputLayoutCreationLock );
+        pInputLayout = pRenderer->CreateVertexInputLayout( pDescription, this );
+    }
+
+    HELIUM_ASSERT( pInputLayout );
+    if( pInputLayout )
+    {
+        InputLayoutEntry* pEntry = m_inputLayouts.New();
+        HELIUM_ASSERT( pEntry );
+        pEntry->spDescription = pDescription;
+        pEntry->spInputLayout = pInputLayout;
+    }
+
+    return pInputLayout;
+}
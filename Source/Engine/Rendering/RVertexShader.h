@@ -2,6 +2,9 @@
 
 #include "Rendering/RShader.h"
 
+#include "Platform/Locks.h"
+#include "Foundation/DynamicArray.h"
+
 namespace Helium
 {
     class Renderer;
@@ -22,14 +25,30 @@ namespace Helium
         //@{
         void CacheDescription( Renderer* pRenderer, RVertexDescription* pDescription );
         RVertexInputLayout* GetCachedInputLayout() const;
+
+        RVertexInputLayout* GetInputLayout( Renderer* pRenderer, RVertexDescription* pDescription );
         //@}
 
     protected:
+        /// Input layout created for a specific vertex description.
+        struct InputLayoutEntry
+        {
+            /// Vertex description.
+            RVertexDescriptionPtr spDescription;
+            /// Input layout for the description.
+            RVertexInputLayoutPtr spInputLayout;
+        };
+
         /// Most recently used vertex description.
         RVertexDescriptionPtr m_spCachedDescription;
         /// Input layout associated with the most recently used vertex description.
         RVertexInputLayoutPtr m_spCachedInputLayout;
 
+        /// Input layouts created through GetInputLayout() for each vertex description used with this shader.
+        DynamicArray< InputLayoutEntry > m_inputLayouts;
+        /// Synchronization for access to the input layout list.
+        Mutex m_inputLayoutLock;
+
         /// @name Construction/Destruction
         //@{
         RVertexShader();
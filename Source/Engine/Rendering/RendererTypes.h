@@ -11,7 +11,9 @@ namespace Helium
     enum ERendererFeatureFlag
     {
         /// Depth texture support (for shadow mapping and depth-based post effects).
-        RENDERER_FEATURE_FLAG_DEPTH_TEXTURE = ( 1 << 0 )
+        RENDERER_FEATURE_FLAG_DEPTH_TEXTURE = ( 1 << 0 ),
+        /// Hardware instancing support (DrawIndexedInstanced() and per-instance vertex streams).
+        RENDERER_FEATURE_FLAG_INSTANCING = ( 1 << 1 )
     };
 
     /// Triangle fill modes.
@@ -1,6 +1,7 @@
 #include "Precompile.h"
 #include "RenderingD3D9/D3D9ImmediateCommandProxy.h"
 
+#include "Rendering/RRecordedCommandList.h"
 #include "RenderingD3D9/D3D9BlendState.h"
 #include "RenderingD3D9/D3D9ConstantBuffer.h"
 #include "RenderingD3D9/D3D9DepthStencilState.h"
@@ -8,7 +9,6 @@
 #include "RenderingD3D9/D3D9IndexBuffer.h"
 #include "RenderingD3D9/D3D9PixelShader.h"
 #include "RenderingD3D9/D3D9RasterizerState.h"
-#include "RenderingD3D9/D3D9RenderCommandList.h"
 #include "RenderingD3D9/D3D9SamplerState.h"
 #include "RenderingD3D9/D3D9Surface.h"
 #include "RenderingD3D9/D3D9Texture2d.h"
@@ -519,10 +519,13 @@ void D3D9ImmediateCommandProxy::SetVertexBuffers(
 /// @copydoc RRenderCommandProxy::SetVertexInputLayout()
 void D3D9ImmediateCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayout )
 {
+    D3D9VertexInputLayout* pD3D9Layout = static_cast< D3D9VertexInputLayout* >( pLayout );
+    m_spVertexInputLayout = pD3D9Layout;
+
     IDirect3DVertexDeclaration9* pD3DDeclaration = NULL;
-    if( pLayout )
+    if( pD3D9Layout )
     {
-        pD3DDeclaration = static_cast< D3D9VertexInputLayout* >( pLayout )->GetD3DDeclaration();
+        pD3DDeclaration = pD3D9Layout->GetD3DDeclaration();
         HELIUM_ASSERT( pD3DDeclaration );
     }
 
@@ -777,6 +780,49 @@ void D3D9ImmediateCommandProxy::DrawIndexed(
         primitiveCount ) );
 }
 
+/// @copydoc RRenderCommandProxy::DrawIndexedInstanced()
+void D3D9ImmediateCommandProxy::DrawIndexedInstanced(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t minIndex,
+    uint32_t usedVertexCount,
+    uint32_t startIndex,
+    uint32_t primitiveCount,
+    uint32_t instanceCount )
+{
+    D3D9VertexInputLayout* pLayout = m_spVertexInputLayout;
+    HELIUM_ASSERT( pLayout );
+    if( !pLayout )
+    {
+        return;
+    }
+
+    // Geometry streams are repeated for each instance, while per-instance streams advance once every "step rate"
+    // instances.  Direct3D requires the indexed geometry to be in stream zero.
+    DWORD streamCount = static_cast< DWORD >( pLayout->GetStreamCount() );
+    const uint8_t* pInstanceStepRates = pLayout->GetInstanceStepRates();
+    HELIUM_ASSERT( streamCount != 0 );
+    HELIUM_ASSERT( pInstanceStepRates[ 0 ] == 0 );
+
+    for( DWORD streamIndex = 0; streamIndex < streamCount; ++streamIndex )
+    {
+        UINT stepRate = pInstanceStepRates[ streamIndex ];
+        HELIUM_D3D9_VERIFY( m_pDevice->SetStreamSourceFreq(
+            streamIndex,
+            ( stepRate != 0
+              ? ( D3DSTREAMSOURCE_INSTANCEDATA | stepRate )
+              : ( D3DSTREAMSOURCE_INDEXEDDATA | instanceCount ) ) ) );
+    }
+
+    DrawIndexed( primitiveType, baseVertexIndex, minIndex, usedVertexCount, startIndex, primitiveCount );
+
+    // Restore the default frequencies so that non-instanced draws are unaffected.
+    for( DWORD streamIndex = 0; streamIndex < streamCount; ++streamIndex )
+    {
+        HELIUM_D3D9_VERIFY( m_pDevice->SetStreamSourceFreq( streamIndex, 1 ) );
+    }
+}
+
 /// @copydoc RRenderCommandProxy::DrawUnindexed()
 void D3D9ImmediateCommandProxy::DrawUnindexed(
     ERendererPrimitiveType primitiveType,
@@ -826,6 +872,7 @@ void D3D9ImmediateCommandProxy::UnbindResources()
     m_spRasterizerState.Release();
     m_spBlendState.Release();
     m_spDepthStencilState.Release();
+    m_spVertexInputLayout.Release();
 
     for( size_t samplerIndex = 0; samplerIndex < HELIUM_ARRAY_COUNT( m_samplerStates ); ++samplerIndex )
     {
@@ -858,14 +905,8 @@ void D3D9ImmediateCommandProxy::ExecuteCommandList( RRenderCommandList* pCommand
 {
     HELIUM_ASSERT( pCommandList );
 
-    D3D9RenderCommandList* pRenderCommandList = static_cast< D3D9RenderCommandList* >( pCommandList );
-
-    D3D9RenderCommandList::Iterator listEnd = pRenderCommandList->End();
-    for( D3D9RenderCommandList::Iterator listIter = pRenderCommandList->Begin(); listIter != listEnd; ++listIter )
-    {
-        D3D9RenderCommand& rCommand = *listIter;
-        rCommand.Execute( this );
-    }
+    // Deferred command proxies created by D3D9Renderer record into backend-independent command lists.
+    static_cast< RRecordedCommandList* >( pCommandList )->Execute( this );
 }
 
 /// @copydoc RRenderCommandProxy::FinishCommandList()
@@ -14,6 +14,8 @@ namespace Helium
 
     HELIUM_DECLARE_RPTR( D3D9ConstantBuffer );
 
+    HELIUM_DECLARE_RPTR( D3D9VertexInputLayout );
+
     /// Render command proxy for immediate issuing of rendering commands to the GPU command buffer.
     class D3D9ImmediateCommandProxy : public RRenderCommandProxy
     {
@@ -81,6 +83,9 @@ namespace Helium
         void DrawIndexed(
             ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
             uint32_t startIndex, uint32_t primitiveCount );
+        void DrawIndexedInstanced(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount );
         void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
         //@}
 
@@ -175,6 +180,8 @@ namespace Helium
         D3D9DepthStencilStatePtr m_spDepthStencilState;
         /// Currently bound sampler states.
         D3D9SamplerStatePtr m_samplerStates[ SAMPLER_STAGE_COUNT ];
+        /// Currently bound vertex input layout (needed to set stream frequencies for instanced draws).
+        D3D9VertexInputLayoutPtr m_spVertexInputLayout;
 
         /// Vertex shader constant manager.
         VertexShaderConstantManager m_vertexConstantManager;
@@ -2,11 +2,11 @@
 #include "RenderingD3D9/D3D9Renderer.h"
 
 #include "Platform/Thread.h"
+#include "Rendering/RDeferredCommandProxy.h"
 #include "Rendering/RendererUtil.h"
 
 #include "RenderingD3D9/D3D9BlendState.h"
 #include "RenderingD3D9/D3D9ConstantBuffer.h"
-#include "RenderingD3D9/D3D9DeferredCommandProxy.h"
 #include "RenderingD3D9/D3D9DepthStencilState.h"
 #include "RenderingD3D9/D3D9DepthStencilSurface.h"
 #include "RenderingD3D9/D3D9DynamicIndexBuffer.h"
@@ -186,6 +186,14 @@ bool D3D9Renderer::Initialize()
 		m_featureFlags |= RENDERER_FEATURE_FLAG_DEPTH_TEXTURE;
 	}
 
+	// Stream source frequency instancing is only available with shader model 3 hardware.
+	D3DCAPS9 d3dCaps;
+	if( SUCCEEDED( m_pD3D->GetDeviceCaps( D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, &d3dCaps ) ) &&
+		d3dCaps.VertexShaderVersion >= D3DVS_VERSION( 3, 0 ) )
+	{
+		m_featureFlags |= RENDERER_FEATURE_FLAG_INSTANCING;
+	}
+
 	HELIUM_TRACE( TraceLevels::Info, "Direct3D9 initialized successfully.\n" );
 
 	return true;
@@ -983,6 +991,7 @@ RVertexDescription* D3D9Renderer::CreateVertexDescription(
 	};
 
 	DynamicArray< WORD > d3dStreamOffsets;
+	DynamicArray< uint8_t > instanceStepRates;
 
 	D3DVERTEXELEMENT9 d3dCurrentElement;
 
@@ -994,9 +1003,30 @@ RVertexDescription* D3D9Renderer::CreateVertexDescription(
 		HELIUM_ASSERT(
 			static_cast< size_t >( rElement.semantic ) < static_cast< size_t >( RENDERER_VERTEX_SEMANTIC_MAX ) );
 
+		if( rElement.bufferIndex >= D3D9VertexDescription::STREAM_COUNT_MAX )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				"D3D9Renderer::CreateVertexDescription(): Vertex buffer index %u exceeds the maximum of %" PRIuSZ ".\n",
+				static_cast< unsigned int >( rElement.bufferIndex ),
+				D3D9VertexDescription::STREAM_COUNT_MAX - 1 );
+
+			return NULL;
+		}
+
 		if( rElement.bufferIndex >= d3dStreamOffsets.GetSize() )
 		{
-			d3dStreamOffsets.Add( 0, rElement.bufferIndex - d3dStreamOffsets.GetSize() + 1 );
+			size_t addedStreamCount = rElement.bufferIndex - d3dStreamOffsets.GetSize() + 1;
+			d3dStreamOffsets.Add( 0, addedStreamCount );
+			instanceStepRates.Add( 0, addedStreamCount );
+		}
+
+		// Direct3D sets the instance frequency per stream, so the rate of the first element in each buffer is used.
+		HELIUM_ASSERT( d3dStreamOffsets[ rElement.bufferIndex ] == 0 ||
+			instanceStepRates[ rElement.bufferIndex ] == rElement.instanceStepRate );
+		if( d3dStreamOffsets[ rElement.bufferIndex ] == 0 )
+		{
+			instanceStepRates[ rElement.bufferIndex ] = rElement.instanceStepRate;
 		}
 
 		d3dCurrentElement.Stream = rElement.bufferIndex;
@@ -1029,7 +1059,10 @@ RVertexDescription* D3D9Renderer::CreateVertexDescription(
 		return NULL;
 	}
 
-	D3D9VertexDescription* pDescription = new D3D9VertexDescription( pD3DDeclaration );
+	D3D9VertexDescription* pDescription = new D3D9VertexDescription(
+		pD3DDeclaration,
+		instanceStepRates.GetData(),
+		instanceStepRates.GetSize() );
 	HELIUM_ASSERT( pDescription );
 
 	pD3DDeclaration->Release();
@@ -1044,11 +1077,14 @@ RVertexInputLayout* D3D9Renderer::CreateVertexInputLayout(
 {
 	HELIUM_ASSERT( pDescription );
 
-	IDirect3DVertexDeclaration9* pD3DDeclaration =
-		static_cast< D3D9VertexDescription* >( pDescription )->GetD3DDeclaration();
+	D3D9VertexDescription* pD3D9Description = static_cast< D3D9VertexDescription* >( pDescription );
+	IDirect3DVertexDeclaration9* pD3DDeclaration = pD3D9Description->GetD3DDeclaration();
 	HELIUM_ASSERT( pD3DDeclaration );
 
-	D3D9VertexInputLayout* pInputLayout = new D3D9VertexInputLayout( pD3DDeclaration );
+	D3D9VertexInputLayout* pInputLayout = new D3D9VertexInputLayout(
+		pD3DDeclaration,
+		pD3D9Description->GetInstanceStepRates(),
+		pD3D9Description->GetStreamCount() );
 	HELIUM_ASSERT( pInputLayout );
 
 	return pInputLayout;
@@ -1259,7 +1295,7 @@ RRenderCommandProxy* D3D9Renderer::GetImmediateCommandProxy()
 /// @copydoc Renderer::CreateDeferredCommandProxy()
 RRenderCommandProxy* D3D9Renderer::CreateDeferredCommandProxy()
 {
-	D3D9DeferredCommandProxy* pCommandProxy = new D3D9DeferredCommandProxy;
+	RDeferredCommandProxy* pCommandProxy = new RDeferredCommandProxy;
 	HELIUM_ASSERT( pCommandProxy );
 
 	return pCommandProxy;
@@ -5,13 +5,25 @@ using namespace Helium;
 
 /// Constructor.
 ///
-/// @param[in] pD3DDeclaration  Direct3D vertex declaration to wrap.  Its reference count will be incremented when
-///                             this object is constructed and decremented back when this object is destroyed.
-D3D9VertexInputLayout::D3D9VertexInputLayout( IDirect3DVertexDeclaration9* pD3DDeclaration )
+/// @param[in] pD3DDeclaration     Direct3D vertex declaration to wrap.  Its reference count will be incremented
+///                                when this object is constructed and decremented back when this object is
+///                                destroyed.
+/// @param[in] pInstanceStepRates  Instance step rate of each vertex stream (zero for per-vertex streams).
+/// @param[in] streamCount         Number of vertex streams referenced by the declaration.
+D3D9VertexInputLayout::D3D9VertexInputLayout(
+    IDirect3DVertexDeclaration9* pD3DDeclaration,
+    const uint8_t* pInstanceStepRates,
+    size_t streamCount )
 : m_pDeclaration( pD3DDeclaration )
+, m_streamCount( streamCount )
 {
     HELIUM_ASSERT( pD3DDeclaration );
+    HELIUM_ASSERT( pInstanceStepRates || streamCount == 0 );
+    HELIUM_ASSERT( streamCount <= STREAM_COUNT_MAX );
     pD3DDeclaration->AddRef();
+
+    MemoryZero( m_instanceStepRates, sizeof( m_instanceStepRates ) );
+    MemoryCopy( m_instanceStepRates, pInstanceStepRates, streamCount );
 }
 
 /// Destructor.
@@ -9,19 +9,29 @@ namespace Helium
     class D3D9VertexInputLayout : public RVertexInputLayout
     {
     public:
+        /// Maximum number of vertex streams that can be referenced.
+        static const size_t STREAM_COUNT_MAX = 16;
+
         /// @name Construction/Destruction
         //@{
-        D3D9VertexInputLayout( IDirect3DVertexDeclaration9* pD3DDeclaration );
+        D3D9VertexInputLayout(
+            IDirect3DVertexDeclaration9* pD3DDeclaration, const uint8_t* pInstanceStepRates, size_t streamCount );
         //@}
 
         /// @name Data Access
         //@{
         inline IDirect3DVertexDeclaration9* GetD3DDeclaration() const;
+        inline size_t GetStreamCount() const;
+        inline const uint8_t* GetInstanceStepRates() const;
         //@}
 
     private:
         /// Vertex declaration.
         IDirect3DVertexDeclaration9* m_pDeclaration;
+        /// Instance step rate of each vertex stream (zero for per-vertex streams).
+        uint8_t m_instanceStepRates[ STREAM_COUNT_MAX ];
+        /// Number of vertex streams referenced by the declaration.
+        size_t m_streamCount;
 
         /// @name Construction/Destruction
         //@{
@@ -7,4 +7,24 @@ namespace Helium
     {
         return m_pDeclaration;
     }
+
+    /// Get the number of vertex streams referenced by this vertex input layout.
+    ///
+    /// @return  Vertex stream count.
+    ///
+    /// @see GetInstanceStepRates()
+    size_t D3D9VertexInputLayout::GetStreamCount() const
+    {
+        return m_streamCount;
+    }
+
+    /// Get the instance step rate of each vertex stream referenced by this vertex input layout.
+    ///
+    /// @return  Array of instance step rates, one for each stream (zero for streams holding per-vertex data).
+    ///
+    /// @see GetStreamCount()
+    const uint8_t* D3D9VertexInputLayout::GetInstanceStepRates() const
+    {
+        return m_instanceStepRates;
+    }
 }
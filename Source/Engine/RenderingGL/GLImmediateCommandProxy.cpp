@@ -1,6 +1,7 @@
 #include "Precompile.h"
 #include "RenderingGL/GLImmediateCommandProxy.h"
 
+#include "Rendering/RRecordedCommandList.h"
 #include "RenderingGL/GLSurface.h"
 
 #include "GL/glew.h"
@@ -333,6 +334,19 @@ void GLImmediateCommandProxy::DrawIndexed(
 	HELIUM_BREAK();
 }
 
+/// @copydoc RRenderCommandProxy::DrawIndexedInstanced()
+void GLImmediateCommandProxy::DrawIndexedInstanced(
+	ERendererPrimitiveType primitiveType,
+	uint32_t baseVertexIndex,
+	uint32_t minIndex,
+	uint32_t usedVertexCount,
+	uint32_t startIndex,
+	uint32_t primitiveCount,
+	uint32_t instanceCount )
+{
+	HELIUM_BREAK();
+}
+
 /// @copydoc RRenderCommandProxy::DrawUnindexed()
 void GLImmediateCommandProxy::DrawUnindexed(
 	ERendererPrimitiveType primitiveType,
@@ -356,11 +370,20 @@ void GLImmediateCommandProxy::UnbindResources()
 /// @copydoc RRenderCommandProxy::ExecuteCommandList()
 void GLImmediateCommandProxy::ExecuteCommandList( RRenderCommandList* pCommandList )
 {
-	HELIUM_BREAK();
+	HELIUM_ASSERT( pCommandList );
+
+	// Deferred command proxies created by GLRenderer record into backend-independent command lists.
+	static_cast< RRecordedCommandList* >( pCommandList )->Execute( this );
 }
 
 /// @copydoc RRenderCommandProxy::FinishCommandList()
 void GLImmediateCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCommandList )
 {
-	HELIUM_BREAK();
+	HELIUM_TRACE(
+		TraceLevels::Error,
+		"GLImmediateCommandProxy: FinishCommandList() called on an immediate command proxy.\n" );
+
+	HELIUM_BREAK_MSG( "GLImmediateCommandProxy: FinishCommandList() called on an immediate command proxy" );
+
+	rspCommandList.Release();
 }
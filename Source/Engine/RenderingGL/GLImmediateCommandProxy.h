@@ -67,6 +67,9 @@ namespace Helium
 		void DrawIndexed(
 			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
 			uint32_t startIndex, uint32_t primitiveCount );
+		void DrawIndexedInstanced(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+			uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount );
 		void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
 		//@}
 
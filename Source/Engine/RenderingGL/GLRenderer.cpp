@@ -14,6 +14,7 @@
 #include "RenderingGL/GLTexture2d.h"
 #include "RenderingGL/GLSurface.h"
 
+#include "Rendering/RDeferredCommandProxy.h"
 #include "Rendering/RendererUtil.h"
 
 #include "GL/glew.h"
@@ -648,9 +649,12 @@ RRenderCommandProxy* GLRenderer::GetImmediateCommandProxy()
 /// @copydoc Renderer::CreateDeferredCommandProxy()
 RRenderCommandProxy* GLRenderer::CreateDeferredCommandProxy()
 {
-	HELIUM_BREAK();
+	// OpenGL has no native command lists, so commands are recorded into backend-independent command lists that are
+	// played back through the immediate command proxy.
+	RDeferredCommandProxy* pCommandProxy = new RDeferredCommandProxy;
+	HELIUM_ASSERT( pCommandProxy );
 
-	return NULL;
+	return pCommandProxy;
 }
 
 /// @copydoc Renderer::Flush()
@@ -115,6 +115,7 @@ bool GLVertexDescription::Initialize( const RVertexDescription::Element* pElemen
 		rDescriptionElement.size = vertexAttribSizes[ rElement.type ][ 0 ];
 		rDescriptionElement.type = vertexAttribTypes[ rElement.type ];
 		rDescriptionElement.isNormalized = vertexAttribNormalized[ rElement.type ];
+		rDescriptionElement.divisor = rElement.instanceStepRate;
 
 		// Calculate vertex attribute stride.
 		const GLsizei attribSizeBytes = rDescriptionElement.size * vertexAttribSizes[ rElement.type ][ 1 ];
@@ -28,6 +28,8 @@ namespace Helium
 			GLboolean isNormalized;
 			/// Vertex attribute stride
 			GLsizei stride;
+			/// Vertex attribute divisor (instances per element, or zero for per-vertex data)
+			GLuint divisor;
 
 			/// @name Construction/Destruction
 			//@{
@@ -7,5 +7,6 @@ namespace Helium
 	, type( GL_NONE )
 	, isNormalized( GL_FALSE )
 	, stride( 0 )
+	, divisor( 0 )
 	{}
 }
@@ -0,0 +1,129 @@
+#include "Precompile.h"
+#include "RenderingNull/NullBuffers.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] size   Buffer size, in bytes.
+/// @param[in] pData  Initial buffer contents (can be null to leave the buffer contents zeroed).
+NullBufferData::NullBufferData( size_t size, const void* pData )
+: m_bMapped( false )
+{
+	m_data.Resize( size );
+	if( pData )
+	{
+		MemoryCopy( m_data.GetData(), pData, size );
+	}
+	else
+	{
+		MemoryZero( m_data.GetData(), size );
+	}
+}
+
+/// Map the buffer contents for writing.
+///
+/// @return  Buffer contents.
+///
+/// @see Unmap()
+void* NullBufferData::Map()
+{
+	HELIUM_ASSERT( !m_bMapped );
+	m_bMapped = true;
+
+	return m_data.GetData();
+}
+
+/// Unmap the buffer contents after writing, counting the buffer size towards the renderer upload statistics.
+///
+/// @see Map()
+void NullBufferData::Unmap()
+{
+	HELIUM_ASSERT( m_bMapped );
+	m_bMapped = false;
+
+	NullRenderer* pRenderer = static_cast< NullRenderer* >( Renderer::GetInstance() );
+	HELIUM_ASSERT( pRenderer );
+	pRenderer->AddResourceUpload( m_data.GetSize(), false );
+}
+
+/// Constructor.
+///
+/// @param[in] size   Buffer size, in bytes.
+/// @param[in] pData  Initial buffer contents (can be null).
+NullVertexBuffer::NullVertexBuffer( size_t size, const void* pData )
+: m_bufferData( size, pData )
+{
+}
+
+/// Destructor.
+NullVertexBuffer::~NullVertexBuffer()
+{
+}
+
+/// @copydoc RVertexBuffer::Map()
+void* NullVertexBuffer::Map( ERendererBufferMapHint /*hint*/ )
+{
+	return m_bufferData.Map();
+}
+
+/// @copydoc RVertexBuffer::Unmap()
+void NullVertexBuffer::Unmap()
+{
+	m_bufferData.Unmap();
+}
+
+/// Constructor.
+///
+/// @param[in] size    Buffer size, in bytes.
+/// @param[in] format  Index format.
+/// @param[in] pData   Initial buffer contents (can be null).
+NullIndexBuffer::NullIndexBuffer( size_t size, ERendererIndexFormat format, const void* pData )
+: m_bufferData( size, pData )
+, m_format( format )
+{
+	HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_INDEX_FORMAT_MAX ) );
+}
+
+/// Destructor.
+NullIndexBuffer::~NullIndexBuffer()
+{
+}
+
+/// @copydoc RIndexBuffer::Map()
+void* NullIndexBuffer::Map( ERendererBufferMapHint /*hint*/ )
+{
+	return m_bufferData.Map();
+}
+
+/// @copydoc RIndexBuffer::Unmap()
+void NullIndexBuffer::Unmap()
+{
+	m_bufferData.Unmap();
+}
+
+/// Constructor.
+///
+/// @param[in] size   Buffer size, in bytes.
+/// @param[in] pData  Initial buffer contents (can be null).
+NullConstantBuffer::NullConstantBuffer( size_t size, const void* pData )
+: m_bufferData( size, pData )
+{
+}
+
+/// Destructor.
+NullConstantBuffer::~NullConstantBuffer()
+{
+}
+
+/// @copydoc RConstantBuffer::Map()
+void* NullConstantBuffer::Map( ERendererBufferMapHint /*hint*/ )
+{
+	return m_bufferData.Map();
+}
+
+/// @copydoc RConstantBuffer::Unmap()
+void NullConstantBuffer::Unmap()
+{
+	m_bufferData.Unmap();
+}
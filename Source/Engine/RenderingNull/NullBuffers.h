@@ -0,0 +1,122 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RConstantBuffer.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	/// System memory storage for null renderer buffers.
+	class NullBufferData
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullBufferData( size_t size, const void* pData );
+		//@}
+
+		/// @name Data Access
+		//@{
+		void* Map();
+		void Unmap();
+
+		inline const void* GetData() const;
+		inline size_t GetSize() const;
+		//@}
+
+	private:
+		/// Buffer contents.
+		DynamicArray< uint8_t > m_data;
+		/// True if the buffer is currently mapped.
+		bool m_bMapped;
+	};
+
+	/// Null renderer vertex buffer.
+	class NullVertexBuffer : public RVertexBuffer
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullVertexBuffer( size_t size, const void* pData );
+		//@}
+
+		/// @name Data Access
+		//@{
+		virtual void* Map( ERendererBufferMapHint hint ) override;
+		virtual void Unmap() override;
+
+		inline const NullBufferData& GetBufferData() const;
+		//@}
+
+	private:
+		/// Buffer storage.
+		NullBufferData m_bufferData;
+
+		/// @name Construction/Destruction
+		//@{
+		virtual ~NullVertexBuffer();
+		//@}
+	};
+
+	/// Null renderer index buffer.
+	class NullIndexBuffer : public RIndexBuffer
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullIndexBuffer( size_t size, ERendererIndexFormat format, const void* pData );
+		//@}
+
+		/// @name Data Access
+		//@{
+		virtual void* Map( ERendererBufferMapHint hint ) override;
+		virtual void Unmap() override;
+
+		inline const NullBufferData& GetBufferData() const;
+		inline ERendererIndexFormat GetFormat() const;
+		//@}
+
+	private:
+		/// Buffer storage.
+		NullBufferData m_bufferData;
+		/// Index format.
+		ERendererIndexFormat m_format;
+
+		/// @name Construction/Destruction
+		//@{
+		virtual ~NullIndexBuffer();
+		//@}
+	};
+
+	/// Null renderer constant buffer.
+	class NullConstantBuffer : public RConstantBuffer
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullConstantBuffer( size_t size, const void* pData );
+		//@}
+
+		/// @name Data Access
+		//@{
+		virtual void* Map( ERendererBufferMapHint hint ) override;
+		virtual void Unmap() override;
+
+		inline const NullBufferData& GetBufferData() const;
+		//@}
+
+	private:
+		/// Buffer storage.
+		NullBufferData m_bufferData;
+
+		/// @name Construction/Destruction
+		//@{
+		virtual ~NullConstantBuffer();
+		//@}
+	};
+}
+
+#include "RenderingNull/NullBuffers.inl"
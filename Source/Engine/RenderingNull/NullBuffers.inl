@@ -0,0 +1,58 @@
+namespace Helium
+{
+	/// Get the buffer contents.
+	///
+	/// @return  Buffer data.
+	///
+	/// @see GetSize()
+	const void* NullBufferData::GetData() const
+	{
+		return m_data.GetData();
+	}
+
+	/// Get the size of the buffer.
+	///
+	/// @return  Buffer size, in bytes.
+	///
+	/// @see GetData()
+	size_t NullBufferData::GetSize() const
+	{
+		return m_data.GetSize();
+	}
+
+	/// Get the system memory storage for this buffer.
+	///
+	/// @return  Buffer storage.
+	const NullBufferData& NullVertexBuffer::GetBufferData() const
+	{
+		return m_bufferData;
+	}
+
+	/// Get the system memory storage for this buffer.
+	///
+	/// @return  Buffer storage.
+	///
+	/// @see GetFormat()
+	const NullBufferData& NullIndexBuffer::GetBufferData() const
+	{
+		return m_bufferData;
+	}
+
+	/// Get the format of the indices in this buffer.
+	///
+	/// @return  Index format.
+	///
+	/// @see GetBufferData()
+	ERendererIndexFormat NullIndexBuffer::GetFormat() const
+	{
+		return m_format;
+	}
+
+	/// Get the system memory storage for this buffer.
+	///
+	/// @return  Buffer storage.
+	const NullBufferData& NullConstantBuffer::GetBufferData() const
+	{
+		return m_bufferData;
+	}
+}
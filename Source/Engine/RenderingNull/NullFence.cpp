@@ -0,0 +1,14 @@
+#include "Precompile.h"
+#include "RenderingNull/NullFence.h"
+
+using namespace Helium;
+
+/// Constructor.
+NullFence::NullFence()
+{
+}
+
+/// Destructor.
+NullFence::~NullFence()
+{
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RFence.h"
+
+namespace Helium
+{
+	/// Null renderer fence.
+	///
+	/// Commands complete as soon as they are issued, so fences are always signaled.
+	class NullFence : public RFence
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullFence();
+		//@}
+
+	private:
+		/// @name Construction/Destruction
+		//@{
+		~NullFence();
+		//@}
+	};
+}
@@ -0,0 +1,299 @@
+#include "Precompile.h"
+#include "RenderingNull/NullImmediateCommandProxy.h"
+
+#include "Rendering/RRecordedCommandList.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] rStatistics  Renderer statistics to update as commands are issued.
+NullImmediateCommandProxy::NullImmediateCommandProxy( NullRenderer::Statistics& rStatistics )
+: m_rStatistics( rStatistics )
+{
+	UnbindResources();
+
+	m_stencilReferenceValue = 0;
+	MemoryZero( m_viewport, sizeof( m_viewport ) );
+}
+
+/// Destructor.
+NullImmediateCommandProxy::~NullImmediateCommandProxy()
+{
+}
+
+/// @copydoc RRenderCommandProxy::SetRasterizerState()
+void NullImmediateCommandProxy::SetRasterizerState( RRasterizerState* pState )
+{
+	SetState( NullRenderer::STATE_TYPE_RASTERIZER, 0, pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetBlendState()
+void NullImmediateCommandProxy::SetBlendState( RBlendState* pState )
+{
+	SetState( NullRenderer::STATE_TYPE_BLEND, 0, pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetDepthStencilState()
+void NullImmediateCommandProxy::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
+{
+	const void*& rpBoundState = m_boundStates[ NullRenderer::STATE_TYPE_DEPTH_STENCIL ][ 0 ];
+
+	++m_rStatistics.stateChangeCounts[ NullRenderer::STATE_TYPE_DEPTH_STENCIL ];
+	if( rpBoundState == pState && m_stencilReferenceValue == stencilReferenceValue )
+	{
+		++m_rStatistics.redundantStateChangeCounts[ NullRenderer::STATE_TYPE_DEPTH_STENCIL ];
+	}
+
+	rpBoundState = pState;
+	m_stencilReferenceValue = stencilReferenceValue;
+}
+
+/// @copydoc RRenderCommandProxy::SetSamplerStates()
+void NullImmediateCommandProxy::SetSamplerStates(
+	size_t startIndex,
+	size_t samplerCount,
+	RSamplerState* const* ppStates )
+{
+	HELIUM_ASSERT( ppStates || samplerCount == 0 );
+
+	for( size_t samplerIndex = 0; samplerIndex < samplerCount; ++samplerIndex )
+	{
+		SetState( NullRenderer::STATE_TYPE_SAMPLER, startIndex + samplerIndex, ppStates[ samplerIndex ] );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetRenderSurfaces()
+void NullImmediateCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
+{
+	const void** ppBoundSurfaces = m_boundStates[ NullRenderer::STATE_TYPE_RENDER_SURFACES ];
+
+	++m_rStatistics.stateChangeCounts[ NullRenderer::STATE_TYPE_RENDER_SURFACES ];
+	if( ppBoundSurfaces[ 0 ] == pRenderTargetSurface && ppBoundSurfaces[ 1 ] == pDepthStencilSurface )
+	{
+		++m_rStatistics.redundantStateChangeCounts[ NullRenderer::STATE_TYPE_RENDER_SURFACES ];
+	}
+
+	ppBoundSurfaces[ 0 ] = pRenderTargetSurface;
+	ppBoundSurfaces[ 1 ] = pDepthStencilSurface;
+}
+
+/// @copydoc RRenderCommandProxy::SetViewport()
+void NullImmediateCommandProxy::SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+{
+	++m_rStatistics.stateChangeCounts[ NullRenderer::STATE_TYPE_VIEWPORT ];
+	if( m_viewport[ 0 ] == x && m_viewport[ 1 ] == y && m_viewport[ 2 ] == width && m_viewport[ 3 ] == height )
+	{
+		++m_rStatistics.redundantStateChangeCounts[ NullRenderer::STATE_TYPE_VIEWPORT ];
+	}
+
+	m_viewport[ 0 ] = x;
+	m_viewport[ 1 ] = y;
+	m_viewport[ 2 ] = width;
+	m_viewport[ 3 ] = height;
+}
+
+/// @copydoc RRenderCommandProxy::BeginScene()
+void NullImmediateCommandProxy::BeginScene()
+{
+	++m_rStatistics.sceneCount;
+}
+
+/// @copydoc RRenderCommandProxy::EndScene()
+void NullImmediateCommandProxy::EndScene()
+{
+}
+
+/// @copydoc RRenderCommandProxy::Clear()
+void NullImmediateCommandProxy::Clear(
+	uint32_t /*clearFlags*/,
+	const Color& /*rColor*/,
+	float32_t /*depth*/,
+	uint8_t /*stencil*/ )
+{
+	++m_rStatistics.clearCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetIndexBuffer()
+void NullImmediateCommandProxy::SetIndexBuffer( RIndexBuffer* pBuffer )
+{
+	SetState( NullRenderer::STATE_TYPE_INDEX_BUFFER, 0, pBuffer );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexBuffers()
+void NullImmediateCommandProxy::SetVertexBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RVertexBuffer* const* ppBuffers,
+	uint32_t* /*pStrides*/,
+	uint32_t* /*pOffsets*/ )
+{
+	HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+	for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+	{
+		SetState( NullRenderer::STATE_TYPE_VERTEX_BUFFER, startIndex + bufferIndex, ppBuffers[ bufferIndex ] );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexInputLayout()
+void NullImmediateCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayout )
+{
+	SetState( NullRenderer::STATE_TYPE_VERTEX_INPUT_LAYOUT, 0, pLayout );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexShader()
+void NullImmediateCommandProxy::SetVertexShader( RVertexShader* pShader )
+{
+	SetState( NullRenderer::STATE_TYPE_VERTEX_SHADER, 0, pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelShader()
+void NullImmediateCommandProxy::SetPixelShader( RPixelShader* pShader )
+{
+	SetState( NullRenderer::STATE_TYPE_PIXEL_SHADER, 0, pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexConstantBuffers()
+void NullImmediateCommandProxy::SetVertexConstantBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RConstantBuffer* const* ppBuffers,
+	const size_t* /*pLimitSizes*/ )
+{
+	HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+	for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+	{
+		SetState(
+			NullRenderer::STATE_TYPE_VERTEX_CONSTANT_BUFFER,
+			startIndex + bufferIndex,
+			ppBuffers[ bufferIndex ] );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelConstantBuffers()
+void NullImmediateCommandProxy::SetPixelConstantBuffers(
+	size_t startIndex,
+	size_t bufferCount,
+	RConstantBuffer* const* ppBuffers,
+	const size_t* /*pLimitSizes*/ )
+{
+	HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+	for( size_t bufferIndex = 0; bufferIndex < bufferCount; ++bufferIndex )
+	{
+		SetState(
+			NullRenderer::STATE_TYPE_PIXEL_CONSTANT_BUFFER,
+			startIndex + bufferIndex,
+			ppBuffers[ bufferIndex ] );
+	}
+}
+
+/// @copydoc RRenderCommandProxy::SetTexture()
+void NullImmediateCommandProxy::SetTexture( size_t samplerIndex, RTexture* pTexture )
+{
+	SetState( NullRenderer::STATE_TYPE_TEXTURE, samplerIndex, pTexture );
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexed()
+void NullImmediateCommandProxy::DrawIndexed(
+	ERendererPrimitiveType /*primitiveType*/,
+	uint32_t /*baseVertexIndex*/,
+	uint32_t /*minIndex*/,
+	uint32_t /*usedVertexCount*/,
+	uint32_t /*startIndex*/,
+	uint32_t primitiveCount )
+{
+	++m_rStatistics.drawCount;
+	m_rStatistics.primitiveCount += primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexedInstanced()
+void NullImmediateCommandProxy::DrawIndexedInstanced(
+	ERendererPrimitiveType /*primitiveType*/,
+	uint32_t /*baseVertexIndex*/,
+	uint32_t /*minIndex*/,
+	uint32_t /*usedVertexCount*/,
+	uint32_t /*startIndex*/,
+	uint32_t primitiveCount,
+	uint32_t instanceCount )
+{
+	++m_rStatistics.drawCount;
+	++m_rStatistics.instancedDrawCount;
+	m_rStatistics.instanceCount += instanceCount;
+	m_rStatistics.primitiveCount += static_cast< uint64_t >( primitiveCount ) * instanceCount;
+}
+
+/// @copydoc RRenderCommandProxy::DrawUnindexed()
+void NullImmediateCommandProxy::DrawUnindexed(
+	ERendererPrimitiveType /*primitiveType*/,
+	uint32_t /*baseVertexIndex*/,
+	uint32_t primitiveCount )
+{
+	++m_rStatistics.drawCount;
+	m_rStatistics.primitiveCount += primitiveCount;
+}
+
+/// @copydoc RRenderCommandProxy::SetFence()
+void NullImmediateCommandProxy::SetFence( RFence* /*pFence*/ )
+{
+}
+
+/// @copydoc RRenderCommandProxy::UnbindResources()
+void NullImmediateCommandProxy::UnbindResources()
+{
+	MemoryZero( m_boundStates, sizeof( m_boundStates ) );
+}
+
+/// @copydoc RRenderCommandProxy::ExecuteCommandList()
+void NullImmediateCommandProxy::ExecuteCommandList( RRenderCommandList* pCommandList )
+{
+	HELIUM_ASSERT( pCommandList );
+
+	++m_rStatistics.commandListCount;
+	static_cast< RRecordedCommandList* >( pCommandList )->Execute( this );
+}
+
+/// @copydoc RRenderCommandProxy::FinishCommandList()
+void NullImmediateCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCommandList )
+{
+	HELIUM_TRACE(
+		TraceLevels::Error,
+		"NullImmediateCommandProxy: FinishCommandList() called on an immediate command proxy.\n" );
+
+	HELIUM_BREAK_MSG( "NullImmediateCommandProxy: FinishCommandList() called on an immediate command proxy" );
+
+	rspCommandList.Release();
+}
+
+/// Count a state change, checking whether the state being set is already bound.
+///
+/// @param[in] type    State type.
+/// @param[in] slot    Binding slot index (zero for state types with a single binding).
+/// @param[in] pState  State being set.
+///
+/// @return  True if the state change was redundant, false if not.
+bool NullImmediateCommandProxy::SetState( NullRenderer::EStateType type, size_t slot, const void* pState )
+{
+	HELIUM_ASSERT( static_cast< size_t >( type ) < static_cast< size_t >( NullRenderer::STATE_TYPE_MAX ) );
+
+	++m_rStatistics.stateChangeCounts[ type ];
+
+	// States bound beyond the tracked slots are always treated as changes.
+	if( slot >= TRACKED_SLOT_COUNT )
+	{
+		return false;
+	}
+
+	const void*& rpBoundState = m_boundStates[ type ][ slot ];
+	bool bRedundant = ( rpBoundState == pState );
+	if( bRedundant )
+	{
+		++m_rStatistics.redundantStateChangeCounts[ type ];
+	}
+
+	rpBoundState = pState;
+
+	return bRedundant;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "RenderingNull/NullRenderer.h"
+#include "Rendering/RRenderCommandProxy.h"
+
+namespace Helium
+{
+	/// Render command proxy for the null renderer.
+	///
+	/// Commands are not executed, but are instead counted in the renderer statistics, along with any state changes that
+	/// set the same state that was already bound.
+	class NullImmediateCommandProxy : public RRenderCommandProxy
+	{
+	public:
+		/// Number of binding slots tracked for each state type when checking for redundant state changes.
+		static const size_t TRACKED_SLOT_COUNT = 16;
+
+		/// @name Construction/Destruction
+		//@{
+		explicit NullImmediateCommandProxy( NullRenderer::Statistics& rStatistics );
+		//@}
+
+		/// @name State Management
+		//@{
+		void SetRasterizerState( RRasterizerState* pState );
+		void SetBlendState( RBlendState* pState );
+		void SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue );
+		void SetSamplerStates( size_t startIndex, size_t samplerCount, RSamplerState* const* ppStates );
+		//@}
+
+		/// @name Render Target Management
+		//@{
+		void SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface );
+		void SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+		//@}
+
+		/// @name Command Generation
+		//@{
+		void BeginScene();
+		void EndScene();
+
+		void Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil );
+
+		void SetIndexBuffer( RIndexBuffer* pBuffer );
+		void SetVertexBuffers(
+			size_t startIndex, size_t bufferCount, RVertexBuffer* const* ppBuffers, uint32_t* pStrides,
+			uint32_t* pOffsets );
+		void SetVertexInputLayout( RVertexInputLayout* pLayout );
+
+		void SetVertexShader( RVertexShader* pShader );
+		void SetPixelShader( RPixelShader* pShader );
+
+		void SetVertexConstantBuffers(
+			size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+			const size_t* pLimitSizes = NULL );
+		void SetPixelConstantBuffers(
+			size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+			const size_t* pLimitSizes = NULL );
+
+		void SetTexture( size_t samplerIndex, RTexture* pTexture );
+
+		void DrawIndexed(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+			uint32_t startIndex, uint32_t primitiveCount );
+		void DrawIndexedInstanced(
+			ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+			uint32_t startIndex, uint32_t primitiveCount, uint32_t instanceCount );
+		void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
+		//@}
+
+		/// @name Fence Commands
+		//@{
+		void SetFence( RFence* pFence );
+		//@}
+
+		/// @name Miscellaneous Resource Management
+		//@{
+		void UnbindResources();
+		//@}
+
+		/// @name Command List Support
+		//@{
+		void ExecuteCommandList( RRenderCommandList* pCommandList );
+		void FinishCommandList( RRenderCommandListPtr& rspCommandList );
+		//@}
+
+	private:
+		/// Statistics to update.
+		NullRenderer::Statistics& m_rStatistics;
+
+		/// Currently bound state of each type in each slot (used only for address comparisons).
+		const void* m_boundStates[ NullRenderer::STATE_TYPE_MAX ][ TRACKED_SLOT_COUNT ];
+		/// Currently set stencil reference value.
+		uint8_t m_stencilReferenceValue;
+		/// Currently set viewport (x, y, width, height).
+		uint32_t m_viewport[ 4 ];
+
+		/// @name Construction/Destruction
+		//@{
+		~NullImmediateCommandProxy();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		bool SetState( NullRenderer::EStateType type, size_t slot, const void* pState );
+		//@}
+	};
+}
@@ -0,0 +1,35 @@
+#include "Precompile.h"
+#include "RenderingNull/NullRenderContext.h"
+
+#include "RenderingNull/NullSurface.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] width   Back buffer width, in pixels.
+/// @param[in] height  Back buffer height, in pixels.
+NullRenderContext::NullRenderContext( uint32_t width, uint32_t height )
+{
+	m_spBackBufferSurface = new NullSurface( width, height );
+	HELIUM_ASSERT( m_spBackBufferSurface );
+}
+
+/// Destructor.
+NullRenderContext::~NullRenderContext()
+{
+}
+
+/// @copydoc RRenderContext::GetBackBufferSurface()
+RSurface* NullRenderContext::GetBackBufferSurface()
+{
+	return m_spBackBufferSurface;
+}
+
+/// @copydoc RRenderContext::Swap()
+void NullRenderContext::Swap()
+{
+	NullRenderer* pRenderer = static_cast< NullRenderer* >( Renderer::GetInstance() );
+	HELIUM_ASSERT( pRenderer );
+	++pRenderer->GetRenderThreadStatistics().swapCount;
+}
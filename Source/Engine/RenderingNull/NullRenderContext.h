@@ -0,0 +1,34 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RRenderContext.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( NullSurface );
+
+	/// Null renderer rendering context.
+	class NullRenderContext : public RRenderContext
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullRenderContext( uint32_t width, uint32_t height );
+		//@}
+
+		/// @name Render Control
+		//@{
+		RSurface* GetBackBufferSurface();
+		void Swap();
+		//@}
+
+	private:
+		/// Back buffer surface.
+		NullSurfacePtr m_spBackBufferSurface;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullRenderContext();
+		//@}
+	};
+}
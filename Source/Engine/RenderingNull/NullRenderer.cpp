@@ -0,0 +1,432 @@
+#include "Precompile.h"
+#include "RenderingNull/NullRenderer.h"
+
+#include "RenderingNull/NullBuffers.h"
+#include "RenderingNull/NullFence.h"
+#include "RenderingNull/NullImmediateCommandProxy.h"
+#include "RenderingNull/NullRenderContext.h"
+#include "RenderingNull/NullShader.h"
+#include "RenderingNull/NullStateObject.h"
+#include "RenderingNull/NullSurface.h"
+#include "RenderingNull/NullTexture2d.h"
+#include "RenderingNull/NullVertexDescription.h"
+
+#include "Rendering/RDeferredCommandProxy.h"
+
+using namespace Helium;
+
+static uint32_t g_InitCount = 0;
+
+/// Constructor.
+NullRenderer::Statistics::Statistics()
+{
+	Reset();
+}
+
+/// Reset all counters to zero.
+void NullRenderer::Statistics::Reset()
+{
+	swapCount = 0;
+	sceneCount = 0;
+	clearCount = 0;
+	drawCount = 0;
+	primitiveCount = 0;
+	instancedDrawCount = 0;
+	instanceCount = 0;
+	commandListCount = 0;
+
+	MemoryZero( stateChangeCounts, sizeof( stateChangeCounts ) );
+	MemoryZero( redundantStateChangeCounts, sizeof( redundantStateChangeCounts ) );
+
+	resourceCreateCount = 0;
+	uploadedBytes = 0;
+}
+
+/// Get the total number of state changes of all types.
+///
+/// @return  State change count.
+///
+/// @see GetRedundantStateChangeCount()
+uint64_t NullRenderer::Statistics::GetStateChangeCount() const
+{
+	uint64_t count = 0;
+	for( size_t typeIndex = 0; typeIndex < STATE_TYPE_MAX; ++typeIndex )
+	{
+		count += stateChangeCounts[ typeIndex ];
+	}
+
+	return count;
+}
+
+/// Get the total number of redundant state changes of all types.
+///
+/// @return  Redundant state change count.
+///
+/// @see GetStateChangeCount()
+uint64_t NullRenderer::Statistics::GetRedundantStateChangeCount() const
+{
+	uint64_t count = 0;
+	for( size_t typeIndex = 0; typeIndex < STATE_TYPE_MAX; ++typeIndex )
+	{
+		count += redundantStateChangeCounts[ typeIndex ];
+	}
+
+	return count;
+}
+
+/// Constructor.
+NullRenderer::NullRenderer()
+: m_resourceCreateCount( 0 )
+, m_uploadedBytes( 0 )
+{
+}
+
+/// Destructor.
+NullRenderer::~NullRenderer()
+{
+}
+
+/// @copydoc Renderer::Initialize()
+bool NullRenderer::Initialize()
+{
+	HELIUM_TRACE( TraceLevels::Info, "Initializing null rendering support.\n" );
+
+	// Depth textures are simply system memory buffers and draws are only counted, so both are always supported.
+	m_featureFlags = RENDERER_FEATURE_FLAG_DEPTH_TEXTURE | RENDERER_FEATURE_FLAG_INSTANCING;
+
+	ResetStatistics();
+
+	// The immediate command proxy is available immediately, as it does not depend on any window.
+	m_spImmediateCommandProxy = new NullImmediateCommandProxy( m_renderThreadStatistics );
+	HELIUM_ASSERT( m_spImmediateCommandProxy );
+
+	return true;
+}
+
+/// @copydoc Renderer::Cleanup()
+void NullRenderer::Cleanup()
+{
+	HELIUM_TRACE( TraceLevels::Info, "Shutting down null rendering support.\n" );
+
+	m_spMainContext.Release();
+	m_spImmediateCommandProxy.Release();
+
+	m_featureFlags = 0;
+}
+
+/// @copydoc Renderer::CreateMainContext()
+bool NullRenderer::CreateMainContext( const ContextInitParameters& rInitParameters )
+{
+	m_spMainContext = new NullRenderContext( rInitParameters.displayWidth, rInitParameters.displayHeight );
+	HELIUM_ASSERT( m_spMainContext );
+
+	return true;
+}
+
+/// @copydoc Renderer::ResetMainContext()
+bool NullRenderer::ResetMainContext( const ContextInitParameters& rInitParameters )
+{
+	return CreateMainContext( rInitParameters );
+}
+
+/// @copydoc Renderer::GetMainContext()
+RRenderContext* NullRenderer::GetMainContext()
+{
+	return m_spMainContext;
+}
+
+/// @copydoc Renderer::CreateSubContext()
+RRenderContext* NullRenderer::CreateSubContext( const ContextInitParameters& rInitParameters )
+{
+	NullRenderContext* pContext = new NullRenderContext( rInitParameters.displayWidth, rInitParameters.displayHeight );
+	HELIUM_ASSERT( pContext );
+
+	return pContext;
+}
+
+/// @copydoc Renderer::GetStatus()
+Renderer::EStatus NullRenderer::GetStatus()
+{
+	return STATUS_READY;
+}
+
+/// @copydoc Renderer::Reset()
+Renderer::EStatus NullRenderer::Reset()
+{
+	return STATUS_READY;
+}
+
+/// @copydoc Renderer::CreateRasterizerState()
+RRasterizerState* NullRenderer::CreateRasterizerState( const RRasterizerState::Description& rDescription )
+{
+	AddResourceUpload( 0, true );
+
+	return new NullRasterizerState( rDescription );
+}
+
+/// @copydoc Renderer::CreateBlendState()
+RBlendState* NullRenderer::CreateBlendState( const RBlendState::Description& rDescription )
+{
+	AddResourceUpload( 0, true );
+
+	return new NullBlendState( rDescription );
+}
+
+/// @copydoc Renderer::CreateDepthStencilState()
+RDepthStencilState* NullRenderer::CreateDepthStencilState( const RDepthStencilState::Description& rDescription )
+{
+	AddResourceUpload( 0, true );
+
+	return new NullDepthStencilState( rDescription );
+}
+
+/// @copydoc Renderer::CreateSamplerState()
+RSamplerState* NullRenderer::CreateSamplerState( const RSamplerState::Description& rDescription )
+{
+	AddResourceUpload( 0, true );
+
+	return new NullSamplerState( rDescription );
+}
+
+/// @copydoc Renderer::CreateDepthStencilSurface()
+RSurface* NullRenderer::CreateDepthStencilSurface(
+	uint32_t width,
+	uint32_t height,
+	ERendererSurfaceFormat /*format*/,
+	uint32_t /*multisampleCount*/ )
+{
+	AddResourceUpload( 0, true );
+
+	return new NullSurface( width, height );
+}
+
+/// @copydoc Renderer::CreateVertexShader()
+RVertexShader* NullRenderer::CreateVertexShader( size_t size, const void* pData )
+{
+	AddResourceUpload( pData ? size : 0, true );
+
+	return new NullVertexShader( size, pData );
+}
+
+/// @copydoc Renderer::CreatePixelShader()
+RPixelShader* NullRenderer::CreatePixelShader( size_t size, const void* pData )
+{
+	AddResourceUpload( pData ? size : 0, true );
+
+	return new NullPixelShader( size, pData );
+}
+
+/// @copydoc Renderer::CreateVertexBuffer()
+RVertexBuffer* NullRenderer::CreateVertexBuffer( size_t size, ERendererBufferUsage /*usage*/, const void* pData )
+{
+	AddResourceUpload( pData ? size : 0, true );
+
+	return new NullVertexBuffer( size, pData );
+}
+
+/// @copydoc Renderer::CreateIndexBuffer()
+RIndexBuffer* NullRenderer::CreateIndexBuffer(
+	size_t size,
+	ERendererBufferUsage /*usage*/,
+	ERendererIndexFormat format,
+	const void* pData )
+{
+	AddResourceUpload( pData ? size : 0, true );
+
+	return new NullIndexBuffer( size, format, pData );
+}
+
+/// @copydoc Renderer::CreateConstantBuffer()
+RConstantBuffer* NullRenderer::CreateConstantBuffer( size_t size, ERendererBufferUsage /*usage*/, const void* pData )
+{
+	AddResourceUpload( pData ? size : 0, true );
+
+	return new NullConstantBuffer( size, pData );
+}
+
+/// @copydoc Renderer::CreateVertexDescription()
+RVertexDescription* NullRenderer::CreateVertexDescription(
+	const RVertexDescription::Element* pElements,
+	size_t elementCount )
+{
+	AddResourceUpload( 0, true );
+
+	return new NullVertexDescription( pElements, elementCount );
+}
+
+/// @copydoc Renderer::CreateVertexInputLayout()
+RVertexInputLayout* NullRenderer::CreateVertexInputLayout(
+	RVertexDescription* pDescription,
+	RVertexShader* /*pShader*/ )
+{
+	HELIUM_ASSERT( pDescription );
+
+	AddResourceUpload( 0, true );
+
+	return new NullVertexInputLayout( pDescription );
+}
+
+/// @copydoc Renderer::CreateTexture2d()
+RTexture2d* NullRenderer::CreateTexture2d(
+	uint32_t width,
+	uint32_t height,
+	uint32_t mipCount,
+	ERendererPixelFormat format,
+	ERendererBufferUsage usage,
+	const RTexture2d::CreateData* pData )
+{
+	HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+	HELIUM_ASSERT( static_cast< size_t >( usage ) < static_cast< size_t >( RENDERER_BUFFER_USAGE_MAX ) );
+	HELIUM_UNREF( usage );
+
+	NullTexture2d* pTexture = new NullTexture2d( width, height, mipCount, format );
+	HELIUM_ASSERT( pTexture );
+
+	// Copy the initial texture data one row at a time, as the source pitch may include padding.
+	size_t uploadedBytes = 0;
+	if( pData )
+	{
+		for( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+		{
+			const RTexture2d::CreateData& rCreateData = pData[ mipIndex ];
+			const uint8_t* pSource = static_cast< const uint8_t* >( rCreateData.pData );
+			HELIUM_ASSERT( pSource );
+
+			size_t pitch = 0;
+			uint8_t* pDest = static_cast< uint8_t* >( pTexture->Map( mipIndex, pitch, RENDERER_BUFFER_MAP_HINT_NONE ) );
+			HELIUM_ASSERT( pDest );
+
+			size_t rowSize = Min( pitch, rCreateData.pitch );
+			size_t rowCount = pTexture->GetMipSize( mipIndex ) / pitch;
+			for( size_t rowIndex = 0; rowIndex < rowCount; ++rowIndex )
+			{
+				MemoryCopy( pDest, pSource, rowSize );
+				pDest += pitch;
+				pSource += rCreateData.pitch;
+			}
+
+			uploadedBytes += pTexture->GetMipSize( mipIndex );
+		}
+	}
+
+	AddResourceUpload( uploadedBytes, true );
+
+	return pTexture;
+}
+
+/// @copydoc Renderer::CreateFence()
+RFence* NullRenderer::CreateFence()
+{
+	AddResourceUpload( 0, true );
+
+	return new NullFence;
+}
+
+/// @copydoc Renderer::SyncFence()
+void NullRenderer::SyncFence( RFence* /*pFence*/ )
+{
+}
+
+/// @copydoc Renderer::TrySyncFence()
+bool NullRenderer::TrySyncFence( RFence* /*pFence*/ )
+{
+	// Commands complete as soon as they are issued.
+	return true;
+}
+
+/// @copydoc Renderer::GetImmediateCommandProxy()
+RRenderCommandProxy* NullRenderer::GetImmediateCommandProxy()
+{
+	return m_spImmediateCommandProxy;
+}
+
+/// @copydoc Renderer::CreateDeferredCommandProxy()
+RRenderCommandProxy* NullRenderer::CreateDeferredCommandProxy()
+{
+	RDeferredCommandProxy* pCommandProxy = new RDeferredCommandProxy;
+	HELIUM_ASSERT( pCommandProxy );
+
+	return pCommandProxy;
+}
+
+/// @copydoc Renderer::Flush()
+void NullRenderer::Flush()
+{
+}
+
+/// Get a snapshot of the statistics accumulated since the renderer was initialized or the statistics were last reset.
+///
+/// This should be called from the thread issuing immediate rendering commands.
+///
+/// @param[out] rStatistics  Renderer statistics.
+///
+/// @see ResetStatistics()
+void NullRenderer::GetStatistics( Statistics& rStatistics ) const
+{
+	rStatistics = m_renderThreadStatistics;
+
+	MutexScopeLock scopeLock( m_resourceStatisticsLock );
+	rStatistics.resourceCreateCount = m_resourceCreateCount;
+	rStatistics.uploadedBytes = m_uploadedBytes;
+}
+
+/// Reset all renderer statistics to zero.
+///
+/// This should be called from the thread issuing immediate rendering commands.
+///
+/// @see GetStatistics()
+void NullRenderer::ResetStatistics()
+{
+	m_renderThreadStatistics.Reset();
+
+	MutexScopeLock scopeLock( m_resourceStatisticsLock );
+	m_resourceCreateCount = 0;
+	m_uploadedBytes = 0;
+}
+
+/// Update the resource statistics for a resource creation or update.
+///
+/// This can be called from any thread.
+///
+/// @param[in] byteCount  Number of bytes of resource data written.
+/// @param[in] bCreated   True if a resource was created, false if an existing resource was updated.
+void NullRenderer::AddResourceUpload( size_t byteCount, bool bCreated )
+{
+	MutexScopeLock scopeLock( m_resourceStatisticsLock );
+	m_uploadedBytes += byteCount;
+	if( bCreated )
+	{
+		++m_resourceCreateCount;
+	}
+}
+
+/// Create the static renderer instance as a NullRenderer.
+///
+/// @see Shutdown()
+void NullRenderer::Startup()
+{
+	if( ++g_InitCount == 1 )
+	{
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new NullRenderer;
+		HELIUM_ASSERT( sm_pInstance );
+		if( !HELIUM_VERIFY( sm_pInstance->Initialize() ) )
+		{
+			Shutdown();
+		}
+	}
+}
+
+/// Destroy the global renderer instance if one exists.
+///
+/// @see Startup()
+void NullRenderer::Shutdown()
+{
+	if( --g_InitCount == 0 )
+	{
+		HELIUM_ASSERT( sm_pInstance );
+		sm_pInstance->Cleanup();
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
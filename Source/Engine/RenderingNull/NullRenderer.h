@@ -0,0 +1,205 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/Renderer.h"
+
+#include "Platform/Locks.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( NullImmediateCommandProxy );
+	HELIUM_DECLARE_RPTR( NullRenderContext );
+
+	/// Null renderer implementation.
+	///
+	/// This renderer does not talk to any graphics API.  Buffers, textures, and shaders are kept in system memory, and
+	/// the immediate command proxy simply counts the commands issued through it, allowing the full rendering path to be
+	/// run and measured on machines without a GPU.
+	class NullRenderer : public Renderer
+	{
+	public:
+		/// Render state categories tracked by the renderer statistics.
+		enum EStateType
+		{
+			STATE_TYPE_FIRST   =  0,
+			STATE_TYPE_INVALID = -1,
+
+			/// Rasterizer state.
+			STATE_TYPE_RASTERIZER,
+			/// Blend state.
+			STATE_TYPE_BLEND,
+			/// Depth-stencil state.
+			STATE_TYPE_DEPTH_STENCIL,
+			/// Sampler state (counted per sampler).
+			STATE_TYPE_SAMPLER,
+			/// Render target and depth-stencil surfaces.
+			STATE_TYPE_RENDER_SURFACES,
+			/// Viewport.
+			STATE_TYPE_VIEWPORT,
+			/// Vertex shader.
+			STATE_TYPE_VERTEX_SHADER,
+			/// Pixel shader.
+			STATE_TYPE_PIXEL_SHADER,
+			/// Vertex input layout.
+			STATE_TYPE_VERTEX_INPUT_LAYOUT,
+			/// Vertex buffer (counted per buffer).
+			STATE_TYPE_VERTEX_BUFFER,
+			/// Index buffer.
+			STATE_TYPE_INDEX_BUFFER,
+			/// Vertex shader constant buffer (counted per buffer).
+			STATE_TYPE_VERTEX_CONSTANT_BUFFER,
+			/// Pixel shader constant buffer (counted per buffer).
+			STATE_TYPE_PIXEL_CONSTANT_BUFFER,
+			/// Texture (counted per texture).
+			STATE_TYPE_TEXTURE,
+
+			STATE_TYPE_MAX,
+			STATE_TYPE_LAST = STATE_TYPE_MAX - 1
+		};
+
+		/// Counters accumulated as commands are issued and resources are updated.
+		struct HELIUM_RENDERING_NULL_API Statistics
+		{
+			/// Number of render contexts swapped.
+			uint64_t swapCount;
+			/// Number of BeginScene() calls.
+			uint64_t sceneCount;
+			/// Number of Clear() calls.
+			uint64_t clearCount;
+			/// Number of draw calls.
+			uint64_t drawCount;
+			/// Number of primitives drawn (counting each instance of instanced draws).
+			uint64_t primitiveCount;
+			/// Number of instanced draw calls (also counted in drawCount).
+			uint64_t instancedDrawCount;
+			/// Number of instances drawn by instanced draw calls.
+			uint64_t instanceCount;
+			/// Number of command lists executed.
+			uint64_t commandListCount;
+
+			/// Number of times each state type was set.
+			uint64_t stateChangeCounts[ STATE_TYPE_MAX ];
+			/// Number of times each state type was set to the value that was already bound.
+			uint64_t redundantStateChangeCounts[ STATE_TYPE_MAX ];
+
+			/// Number of render resources created.
+			uint64_t resourceCreateCount;
+			/// Number of bytes written to buffers, textures, and shaders, either on creation or through mapping.
+			uint64_t uploadedBytes;
+
+			/// @name Construction/Destruction
+			//@{
+			Statistics();
+			//@}
+
+			/// @name Data Access
+			//@{
+			void Reset();
+
+			uint64_t GetStateChangeCount() const;
+			uint64_t GetRedundantStateChangeCount() const;
+			//@}
+		};
+
+		/// @name Initialization
+		//@{
+		bool Initialize();
+		void Cleanup();
+		//@}
+
+		/// @name Display Initialization
+		//@{
+		bool CreateMainContext( const ContextInitParameters& rInitParameters );
+		bool ResetMainContext( const ContextInitParameters& rInitParameters );
+		RRenderContext* GetMainContext();
+
+		RRenderContext* CreateSubContext( const ContextInitParameters& rInitParameters );
+
+		EStatus GetStatus();
+		EStatus Reset();
+		//@}
+
+		/// @name State Object Creation
+		//@{
+		RRasterizerState* CreateRasterizerState( const RRasterizerState::Description& rDescription );
+		RBlendState* CreateBlendState( const RBlendState::Description& rDescription );
+		RDepthStencilState* CreateDepthStencilState( const RDepthStencilState::Description& rDescription );
+		RSamplerState* CreateSamplerState( const RSamplerState::Description& rDescription );
+		//@}
+
+		/// @name Resource Allocation
+		//@{
+		RSurface* CreateDepthStencilSurface(
+			uint32_t width, uint32_t height, ERendererSurfaceFormat format, uint32_t multisampleCount );
+
+		RVertexShader* CreateVertexShader( size_t size, const void* pData );
+		RPixelShader* CreatePixelShader( size_t size, const void* pData );
+
+		RVertexBuffer* CreateVertexBuffer( size_t size, ERendererBufferUsage usage, const void* pData );
+		RIndexBuffer* CreateIndexBuffer(
+			size_t size, ERendererBufferUsage usage, ERendererIndexFormat format, const void* pData );
+		RConstantBuffer* CreateConstantBuffer( size_t size, ERendererBufferUsage usage, const void* pData );
+
+		RVertexDescription* CreateVertexDescription( const RVertexDescription::Element* pElements, size_t elementCount );
+		RVertexInputLayout* CreateVertexInputLayout( RVertexDescription* pDescription, RVertexShader* pShader );
+
+		RTexture2d* CreateTexture2d(
+			uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format, ERendererBufferUsage usage,
+			const RTexture2d::CreateData* pData );
+		//@}
+
+		/// @name Deferred Query Allocation
+		//@{
+		RFence* CreateFence();
+		void SyncFence( RFence* pFence );
+		bool TrySyncFence( RFence* pFence );
+		//@}
+
+		/// @name Command Interfaces
+		//@{
+		RRenderCommandProxy* GetImmediateCommandProxy();
+		RRenderCommandProxy* CreateDeferredCommandProxy();
+
+		void Flush();
+		//@}
+
+		/// @name Statistics
+		//@{
+		HELIUM_RENDERING_NULL_API void GetStatistics( Statistics& rStatistics ) const;
+		HELIUM_RENDERING_NULL_API void ResetStatistics();
+
+		inline Statistics& GetRenderThreadStatistics();
+		void AddResourceUpload( size_t byteCount, bool bCreated );
+		//@}
+
+		/// @name Static Initialization
+		//@{
+		HELIUM_RENDERING_NULL_API static void Startup();
+		HELIUM_RENDERING_NULL_API static void Shutdown();
+		//@}
+
+	private:
+		/// Immediate render command proxy.
+		NullImmediateCommandProxyPtr m_spImmediateCommandProxy;
+		/// Main rendering context.
+		NullRenderContextPtr m_spMainContext;
+
+		/// Command and state statistics (only updated from the thread issuing immediate commands).
+		Statistics m_renderThreadStatistics;
+
+		/// Number of render resources created.
+		uint64_t m_resourceCreateCount;
+		/// Number of bytes written to render resources.
+		uint64_t m_uploadedBytes;
+		/// Synchronization for resource creation and upload statistics, which can be updated from any thread.
+		mutable Mutex m_resourceStatisticsLock;
+
+		/// @name Construction/Destruction
+		//@{
+		NullRenderer();
+		virtual ~NullRenderer();
+		//@}
+	};
+}
+
+#include "RenderingNull/NullRenderer.inl"
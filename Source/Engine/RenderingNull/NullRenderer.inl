@@ -0,0 +1,14 @@
+namespace Helium
+{
+	/// Get the statistics updated by the immediate command proxy and render contexts.
+	///
+	/// This should only be accessed from the thread issuing immediate rendering commands.
+	///
+	/// @return  Render thread statistics.
+	///
+	/// @see GetStatistics(), AddResourceUpload()
+	NullRenderer::Statistics& NullRenderer::GetRenderThreadStatistics()
+	{
+		return m_renderThreadStatistics;
+	}
+}
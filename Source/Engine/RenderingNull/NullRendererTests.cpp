@@ -0,0 +1,178 @@
+#include "RenderingNull/NullRenderer.h"
+
+#include "Rendering/RConstantBuffer.h"
+#include "Rendering/RRenderCommandList.h"
+#include "Rendering/RRenderCommandProxy.h"
+#include "Rendering/RVertexBuffer.h"
+
+#include "gtest/gtest.h"
+
+using namespace Helium;
+
+namespace
+{
+	/// Starts up the null renderer with cleared statistics for each test.
+	class NullRendererTest : public testing::Test
+	{
+	protected:
+		virtual void SetUp()
+		{
+			NullRenderer::Startup();
+
+			m_pRenderer = static_cast< NullRenderer* >( Renderer::GetInstance() );
+			ASSERT_TRUE( m_pRenderer != NULL );
+
+			m_spCommandProxy = m_pRenderer->GetImmediateCommandProxy();
+			ASSERT_TRUE( m_spCommandProxy );
+
+			m_pRenderer->ResetStatistics();
+		}
+
+		virtual void TearDown()
+		{
+			m_spCommandProxy.Release();
+
+			NullRenderer::Shutdown();
+		}
+
+		NullRenderer* m_pRenderer;
+		RRenderCommandProxyPtr m_spCommandProxy;
+	};
+}
+
+TEST_F( NullRendererTest, ReportsInstancingSupport )
+{
+	EXPECT_TRUE( m_pRenderer->SupportsAnyFeature( RENDERER_FEATURE_FLAG_INSTANCING ) );
+}
+
+TEST_F( NullRendererTest, CountsScenesDrawsAndPrimitives )
+{
+	m_spCommandProxy->BeginScene();
+	m_spCommandProxy->Clear( RENDERER_CLEAR_FLAG_ALL, Color( 0xff000000 ) );
+	m_spCommandProxy->DrawIndexed( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST, 0, 0, 3, 0, 1 );
+	m_spCommandProxy->DrawUnindexed( RENDERER_PRIMITIVE_TYPE_TRIANGLE_STRIP, 0, 2 );
+	m_spCommandProxy->DrawIndexedInstanced( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST, 0, 0, 24, 0, 12, 8 );
+	m_spCommandProxy->EndScene();
+
+	NullRenderer::Statistics statistics;
+	m_pRenderer->GetStatistics( statistics );
+
+	EXPECT_EQ( 1u, statistics.sceneCount );
+	EXPECT_EQ( 1u, statistics.clearCount );
+	EXPECT_EQ( 3u, statistics.drawCount );
+	EXPECT_EQ( 1u, statistics.instancedDrawCount );
+	EXPECT_EQ( 8u, statistics.instanceCount );
+	EXPECT_EQ( 1u + 2u + 12u * 8u, statistics.primitiveCount );
+}
+
+TEST_F( NullRendererTest, CountsRedundantStateChanges )
+{
+	RVertexBufferPtr spVertexBuffer = m_pRenderer->CreateVertexBuffer( 64, RENDERER_BUFFER_USAGE_STATIC );
+	ASSERT_TRUE( spVertexBuffer );
+
+	RConstantBufferPtr spConstantBuffers[ 2 ];
+	spConstantBuffers[ 0 ] = m_pRenderer->CreateConstantBuffer( 64, RENDERER_BUFFER_USAGE_DYNAMIC );
+	spConstantBuffers[ 1 ] = m_pRenderer->CreateConstantBuffer( 64, RENDERER_BUFFER_USAGE_DYNAMIC );
+	ASSERT_TRUE( spConstantBuffers[ 0 ] );
+	ASSERT_TRUE( spConstantBuffers[ 1 ] );
+
+	uint32_t stride = 16;
+	uint32_t offset = 0;
+	m_spCommandProxy->SetVertexBuffers( 0, 1, &spVertexBuffer, &stride, &offset );
+	m_spCommandProxy->SetVertexBuffers( 0, 1, &spVertexBuffer, &stride, &offset );
+	m_spCommandProxy->SetVertexBuffers( 1, 1, &spVertexBuffer, &stride, &offset );
+
+	RConstantBuffer* pConstantBuffer = spConstantBuffers[ 0 ];
+	m_spCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
+	m_spCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
+	pConstantBuffer = spConstantBuffers[ 1 ];
+	m_spCommandProxy->SetVertexConstantBuffers( 0, 1, &pConstantBuffer );
+
+	m_spCommandProxy->SetViewport( 0, 0, 640, 480 );
+	m_spCommandProxy->SetViewport( 0, 0, 640, 480 );
+
+	NullRenderer::Statistics statistics;
+	m_pRenderer->GetStatistics( statistics );
+
+	EXPECT_EQ( 3u, statistics.stateChangeCounts[ NullRenderer::STATE_TYPE_VERTEX_BUFFER ] );
+	EXPECT_EQ( 1u, statistics.redundantStateChangeCounts[ NullRenderer::STATE_TYPE_VERTEX_BUFFER ] );
+	EXPECT_EQ( 3u, statistics.stateChangeCounts[ NullRenderer::STATE_TYPE_VERTEX_CONSTANT_BUFFER ] );
+	EXPECT_EQ( 1u, statistics.redundantStateChangeCounts[ NullRenderer::STATE_TYPE_VERTEX_CONSTANT_BUFFER ] );
+	EXPECT_EQ( 2u, statistics.stateChangeCounts[ NullRenderer::STATE_TYPE_VIEWPORT ] );
+	EXPECT_EQ( 1u, statistics.redundantStateChangeCounts[ NullRenderer::STATE_TYPE_VIEWPORT ] );
+
+	EXPECT_EQ( 8u, statistics.GetStateChangeCount() );
+	EXPECT_EQ( 3u, statistics.GetRedundantStateChangeCount() );
+}
+
+TEST_F( NullRendererTest, CountsResourceCreationAndUploads )
+{
+	uint8_t vertexData[ 256 ] = {};
+	RVertexBufferPtr spVertexBuffer =
+		m_pRenderer->CreateVertexBuffer( sizeof( vertexData ), RENDERER_BUFFER_USAGE_DYNAMIC, vertexData );
+	ASSERT_TRUE( spVertexBuffer );
+
+	RConstantBufferPtr spConstantBuffer = m_pRenderer->CreateConstantBuffer( 64, RENDERER_BUFFER_USAGE_DYNAMIC );
+	ASSERT_TRUE( spConstantBuffer );
+
+	NullRenderer::Statistics statistics;
+	m_pRenderer->GetStatistics( statistics );
+	EXPECT_EQ( 2u, statistics.resourceCreateCount );
+	EXPECT_EQ( 256u, statistics.uploadedBytes );
+
+	// Each unmap counts the whole buffer as uploaded.
+	void* pMappedData = spVertexBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD );
+	ASSERT_TRUE( pMappedData != NULL );
+	spVertexBuffer->Unmap();
+
+	pMappedData = spConstantBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD );
+	ASSERT_TRUE( pMappedData != NULL );
+	spConstantBuffer->Unmap();
+
+	m_pRenderer->GetStatistics( statistics );
+	EXPECT_EQ( 2u, statistics.resourceCreateCount );
+	EXPECT_EQ( 256u + 256u + 64u, statistics.uploadedBytes );
+
+	m_pRenderer->ResetStatistics();
+	m_pRenderer->GetStatistics( statistics );
+	EXPECT_EQ( 0u, statistics.resourceCreateCount );
+	EXPECT_EQ( 0u, statistics.uploadedBytes );
+}
+
+TEST_F( NullRendererTest, CountsCommandsWhenRecordedListsExecute )
+{
+	RRenderCommandProxyPtr spDeferredCommandProxy = m_pRenderer->CreateDeferredCommandProxy();
+	ASSERT_TRUE( spDeferredCommandProxy );
+
+	RVertexBufferPtr spVertexBuffer = m_pRenderer->CreateVertexBuffer( 64, RENDERER_BUFFER_USAGE_STATIC );
+	ASSERT_TRUE( spVertexBuffer );
+
+	uint32_t stride = 16;
+	uint32_t offset = 0;
+	spDeferredCommandProxy->SetVertexBuffers( 0, 1, &spVertexBuffer, &stride, &offset );
+	spDeferredCommandProxy->SetVertexBuffers( 0, 1, &spVertexBuffer, &stride, &offset );
+	spDeferredCommandProxy->DrawIndexed( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST, 0, 0, 3, 0, 1 );
+	spDeferredCommandProxy->DrawIndexedInstanced( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST, 0, 0, 3, 0, 1, 4 );
+
+	RRenderCommandListPtr spCommandList;
+	spDeferredCommandProxy->FinishCommandList( spCommandList );
+	ASSERT_TRUE( spCommandList );
+
+	// Nothing is counted until the list is played back through the immediate proxy.
+	NullRenderer::Statistics statistics;
+	m_pRenderer->GetStatistics( statistics );
+	EXPECT_EQ( 0u, statistics.drawCount );
+	EXPECT_EQ( 0u, statistics.GetStateChangeCount() );
+
+	m_spCommandProxy->ExecuteCommandList( spCommandList );
+	m_spCommandProxy->ExecuteCommandList( spCommandList );
+
+	m_pRenderer->GetStatistics( statistics );
+	EXPECT_EQ( 2u, statistics.commandListCount );
+	EXPECT_EQ( 4u, statistics.drawCount );
+	EXPECT_EQ( 2u, statistics.instancedDrawCount );
+	EXPECT_EQ( 8u, statistics.instanceCount );
+	EXPECT_EQ( 2u + 8u, statistics.primitiveCount );
+	EXPECT_EQ( 4u, statistics.stateChangeCounts[ NullRenderer::STATE_TYPE_VERTEX_BUFFER ] );
+	EXPECT_EQ( 3u, statistics.redundantStateChangeCounts[ NullRenderer::STATE_TYPE_VERTEX_BUFFER ] );
+}
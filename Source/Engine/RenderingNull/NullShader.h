@@ -0,0 +1,52 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RVertexShader.h"
+#include "Rendering/RPixelShader.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	/// Null renderer shader.
+	///
+	/// Compiled shader code is stored in system memory.  The template parameter specifies the shader interface being
+	/// implemented (RVertexShader or RPixelShader).
+	template< typename BaseT >
+	class NullShader : public BaseT
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullShader( size_t size, const void* pData );
+		//@}
+
+		/// @name Loading
+		//@{
+		void* Lock();
+		bool Unlock();
+		//@}
+
+		/// @name Data Access
+		//@{
+		const void* GetData() const;
+		size_t GetSize() const;
+		//@}
+
+	private:
+		/// Compiled shader code.
+		DynamicArray< uint8_t > m_data;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullShader();
+		//@}
+	};
+
+	/// Null renderer vertex shader.
+	typedef NullShader< RVertexShader > NullVertexShader;
+	/// Null renderer pixel shader.
+	typedef NullShader< RPixelShader > NullPixelShader;
+}
+
+#include "RenderingNull/NullShader.inl"
@@ -0,0 +1,59 @@
+namespace Helium
+{
+	/// Constructor.
+	///
+	/// @param[in] size   Size of the compiled shader code, in bytes.
+	/// @param[in] pData  Compiled shader code (can be null if the code will be provided later using Lock() and
+	///                   Unlock()).
+	template< typename BaseT >
+	NullShader< BaseT >::NullShader( size_t size, const void* pData )
+	{
+		m_data.Resize( size );
+		if( pData )
+		{
+			MemoryCopy( m_data.GetData(), pData, size );
+		}
+	}
+
+	/// Destructor.
+	template< typename BaseT >
+	NullShader< BaseT >::~NullShader()
+	{
+	}
+
+	/// @copydoc RShader::Lock()
+	template< typename BaseT >
+	void* NullShader< BaseT >::Lock()
+	{
+		return m_data.GetData();
+	}
+
+	/// @copydoc RShader::Unlock()
+	template< typename BaseT >
+	bool NullShader< BaseT >::Unlock()
+	{
+		return true;
+	}
+
+	/// Get the compiled shader code.
+	///
+	/// @return  Shader code.
+	///
+	/// @see GetSize()
+	template< typename BaseT >
+	const void* NullShader< BaseT >::GetData() const
+	{
+		return m_data.GetData();
+	}
+
+	/// Get the size of the compiled shader code.
+	///
+	/// @return  Shader code size, in bytes.
+	///
+	/// @see GetData()
+	template< typename BaseT >
+	size_t NullShader< BaseT >::GetSize() const
+	{
+		return m_data.GetSize();
+	}
+}
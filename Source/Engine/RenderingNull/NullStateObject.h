@@ -0,0 +1,53 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RRasterizerState.h"
+#include "Rendering/RBlendState.h"
+#include "Rendering/RDepthStencilState.h"
+#include "Rendering/RSamplerState.h"
+
+namespace Helium
+{
+	/// Null renderer state object.
+	///
+	/// State objects in the null renderer simply hold onto the description with which they were created.  The template
+	/// parameter specifies the state object interface being implemented (RRasterizerState, RBlendState,
+	/// RDepthStencilState, or RSamplerState).
+	template< typename BaseT >
+	class NullStateObject : public BaseT
+	{
+	public:
+		/// Description type.
+		typedef typename BaseT::Description Description;
+
+		/// @name Construction/Destruction
+		//@{
+		explicit NullStateObject( const Description& rDescription );
+		//@}
+
+		/// @name State Information
+		//@{
+		void GetDescription( Description& rDescription ) const;
+		//@}
+
+	private:
+		/// State description.
+		Description m_description;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullStateObject();
+		//@}
+	};
+
+	/// Null renderer rasterizer state.
+	typedef NullStateObject< RRasterizerState > NullRasterizerState;
+	/// Null renderer blend state.
+	typedef NullStateObject< RBlendState > NullBlendState;
+	/// Null renderer depth-stencil state.
+	typedef NullStateObject< RDepthStencilState > NullDepthStencilState;
+	/// Null renderer sampler state.
+	typedef NullStateObject< RSamplerState > NullSamplerState;
+}
+
+#include "RenderingNull/NullStateObject.inl"
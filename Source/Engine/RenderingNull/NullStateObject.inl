@@ -0,0 +1,26 @@
+namespace Helium
+{
+	/// Constructor.
+	///
+	/// @param[in] rDescription  State description.
+	template< typename BaseT >
+	NullStateObject< BaseT >::NullStateObject( const Description& rDescription )
+		: m_description( rDescription )
+	{
+	}
+
+	/// Destructor.
+	template< typename BaseT >
+	NullStateObject< BaseT >::~NullStateObject()
+	{
+	}
+
+	/// Get the description of this state object.
+	///
+	/// @param[out] rDescription  State description.
+	template< typename BaseT >
+	void NullStateObject< BaseT >::GetDescription( Description& rDescription ) const
+	{
+		rDescription = m_description;
+	}
+}
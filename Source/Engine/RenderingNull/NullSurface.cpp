@@ -0,0 +1,19 @@
+#include "Precompile.h"
+#include "RenderingNull/NullSurface.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] width   Surface width, in pixels.
+/// @param[in] height  Surface height, in pixels.
+NullSurface::NullSurface( uint32_t width, uint32_t height )
+: m_width( width )
+, m_height( height )
+{
+}
+
+/// Destructor.
+NullSurface::~NullSurface()
+{
+}
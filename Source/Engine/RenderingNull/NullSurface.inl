@@ -0,0 +1,22 @@
+namespace Helium
+{
+	/// Get the width of this surface.
+	///
+	/// @return  Surface width, in pixels.
+	///
+	/// @see GetHeight()
+	uint32_t NullSurface::GetWidth() const
+	{
+		return m_width;
+	}
+
+	/// Get the height of this surface.
+	///
+	/// @return  Surface height, in pixels.
+	///
+	/// @see GetWidth()
+	uint32_t NullSurface::GetHeight() const
+	{
+		return m_height;
+	}
+}
@@ -0,0 +1,184 @@
+#include "Precompile.h"
+#include "RenderingNull/NullTexture2d.h"
+
+#include "RenderingNull/NullSurface.h"
+#include "Rendering/RendererUtil.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// The texture contents are initially zeroed.
+///
+/// @param[in] width     Texture width, in pixels.
+/// @param[in] height    Texture height, in pixels.
+/// @param[in] mipCount  Number of mip levels.
+/// @param[in] format    Pixel format.
+NullTexture2d::NullTexture2d( uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format )
+: m_width( width )
+, m_height( height )
+, m_mipCount( mipCount )
+, m_format( format )
+{
+	HELIUM_ASSERT( width != 0 );
+	HELIUM_ASSERT( height != 0 );
+	HELIUM_ASSERT( mipCount != 0 );
+	HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+
+	m_mipOffsets.Reserve( mipCount );
+
+	size_t dataSize = 0;
+	for( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+	{
+		m_mipOffsets.Push( dataSize );
+		dataSize += GetMipSize( mipIndex );
+	}
+
+	m_data.Resize( dataSize );
+	MemoryZero( m_data.GetData(), dataSize );
+
+	m_surfaces.Resize( mipCount );
+}
+
+/// Destructor.
+NullTexture2d::~NullTexture2d()
+{
+}
+
+/// @copydoc RTexture::GetMipCount()
+uint32_t NullTexture2d::GetMipCount() const
+{
+	return m_mipCount;
+}
+
+/// @copydoc RTexture2d::Map()
+void* NullTexture2d::Map( uint32_t mipLevel, size_t& rPitch, ERendererBufferMapHint /*hint*/ )
+{
+	if( mipLevel >= m_mipCount )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"NullTexture2d::Map(): Invalid mip level %" PRIu32 " specified.\n",
+			mipLevel );
+
+		return NULL;
+	}
+
+	rPitch = GetPitch( mipLevel );
+
+	return m_data.GetData() + m_mipOffsets[ mipLevel ];
+}
+
+/// @copydoc RTexture2d::Unmap()
+void NullTexture2d::Unmap( uint32_t mipLevel )
+{
+	HELIUM_ASSERT( mipLevel < m_mipCount );
+
+	NullRenderer* pRenderer = static_cast< NullRenderer* >( Renderer::GetInstance() );
+	HELIUM_ASSERT( pRenderer );
+	pRenderer->AddResourceUpload( GetMipSize( mipLevel ), false );
+}
+
+/// @copydoc RTexture2d::CanMapWholeResource()
+bool NullTexture2d::CanMapWholeResource() const
+{
+	return true;
+}
+
+/// @copydoc RTexture2d::GetWidth()
+uint32_t NullTexture2d::GetWidth( uint32_t mipLevel ) const
+{
+	return ( mipLevel < 32 ? Max< uint32_t >( m_width >> mipLevel, 1 ) : 1 );
+}
+
+/// @copydoc RTexture2d::GetHeight()
+uint32_t NullTexture2d::GetHeight( uint32_t mipLevel ) const
+{
+	return ( mipLevel < 32 ? Max< uint32_t >( m_height >> mipLevel, 1 ) : 1 );
+}
+
+/// @copydoc RTexture2d::GetPixelFormat()
+ERendererPixelFormat NullTexture2d::GetPixelFormat() const
+{
+	return m_format;
+}
+
+/// @copydoc RTexture2d::GetSurface()
+RSurface* NullTexture2d::GetSurface( uint32_t mipLevel )
+{
+	if( mipLevel >= m_mipCount )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"NullTexture2d::GetSurface(): Invalid mip level %" PRIu32 " specified.\n",
+			mipLevel );
+
+		return NULL;
+	}
+
+	NullSurfacePtr& rspSurface = m_surfaces[ mipLevel ];
+	if( !rspSurface )
+	{
+		rspSurface = new NullSurface( GetWidth( mipLevel ), GetHeight( mipLevel ) );
+		HELIUM_ASSERT( rspSurface );
+	}
+
+	return rspSurface;
+}
+
+/// Get the number of bytes in each row of pixels (or blocks, for block-compressed formats) of a mip level.
+///
+/// @param[in] mipLevel  Mip level index.
+///
+/// @return  Row pitch, in bytes.
+///
+/// @see GetMipSize()
+size_t NullTexture2d::GetPitch( uint32_t mipLevel ) const
+{
+	uint32_t width = GetWidth( mipLevel );
+	if( RendererUtil::IsCompressedFormat( m_format ) )
+	{
+		width = ( width + 3 ) / 4;
+	}
+
+	return static_cast< size_t >( width ) * GetFormatBlockSize( m_format );
+}
+
+/// Get the total size of the contents of a mip level.
+///
+/// @param[in] mipLevel  Mip level index.
+///
+/// @return  Mip level size, in bytes.
+///
+/// @see GetPitch()
+size_t NullTexture2d::GetMipSize( uint32_t mipLevel ) const
+{
+	return GetPitch( mipLevel ) * RendererUtil::PixelToBlockRowCount( GetHeight( mipLevel ), m_format );
+}
+
+/// Get the size of each pixel (or block, for block-compressed formats) of a given pixel format.
+///
+/// @param[in] format  Pixel format.
+///
+/// @return  Pixel or block size, in bytes.
+size_t NullTexture2d::GetFormatBlockSize( ERendererPixelFormat format )
+{
+	static const size_t BLOCK_SIZES[ RENDERER_PIXEL_FORMAT_MAX ] =
+	{
+		4,   // RENDERER_PIXEL_FORMAT_R8G8B8A8
+		4,   // RENDERER_PIXEL_FORMAT_R8G8B8A8_SRGB
+		1,   // RENDERER_PIXEL_FORMAT_R8
+		8,   // RENDERER_PIXEL_FORMAT_BC1
+		8,   // RENDERER_PIXEL_FORMAT_BC1_SRGB
+		16,  // RENDERER_PIXEL_FORMAT_BC2
+		16,  // RENDERER_PIXEL_FORMAT_BC2_SRGB
+		16,  // RENDERER_PIXEL_FORMAT_BC3
+		16,  // RENDERER_PIXEL_FORMAT_BC3_SRGB
+		8,   // RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT
+		4    // RENDERER_PIXEL_FORMAT_DEPTH
+	};
+
+	HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
+
+	return BLOCK_SIZES[ format ];
+}
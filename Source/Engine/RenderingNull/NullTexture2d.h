@@ -0,0 +1,72 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RTexture2d.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( NullSurface );
+
+	/// Null renderer 2D texture.
+	///
+	/// The contents of each mip level are kept in system memory using the same row layout as provided when creating
+	/// the texture (pixel rows for uncompressed formats, block rows for block-compressed formats).
+	class NullTexture2d : public RTexture2d
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullTexture2d( uint32_t width, uint32_t height, uint32_t mipCount, ERendererPixelFormat format );
+		//@}
+
+		/// @name Base Texture Information
+		//@{
+		uint32_t GetMipCount() const;
+		//@}
+
+		/// @name Data Access
+		//@{
+		void* Map( uint32_t mipLevel, size_t& rPitch, ERendererBufferMapHint hint );
+		void Unmap( uint32_t mipLevel );
+		bool CanMapWholeResource() const;
+
+		uint32_t GetWidth( uint32_t mipLevel ) const;
+		uint32_t GetHeight( uint32_t mipLevel ) const;
+		ERendererPixelFormat GetPixelFormat() const;
+
+		RSurface* GetSurface( uint32_t mipLevel );
+
+		size_t GetPitch( uint32_t mipLevel ) const;
+		size_t GetMipSize( uint32_t mipLevel ) const;
+		//@}
+
+		/// @name Static Utility Functions
+		//@{
+		static size_t GetFormatBlockSize( ERendererPixelFormat format );
+		//@}
+
+	private:
+		/// Texture width, in pixels.
+		uint32_t m_width;
+		/// Texture height, in pixels.
+		uint32_t m_height;
+		/// Number of mip levels.
+		uint32_t m_mipCount;
+		/// Pixel format.
+		ERendererPixelFormat m_format;
+
+		/// Texture contents, with each mip level stored back to back.
+		DynamicArray< uint8_t > m_data;
+		/// Offset of each mip level within the texture contents.
+		DynamicArray< size_t > m_mipOffsets;
+		/// Surface for each mip level (created on demand).
+		DynamicArray< NullSurfacePtr > m_surfaces;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullTexture2d();
+		//@}
+	};
+}
@@ -0,0 +1,34 @@
+#include "Precompile.h"
+#include "RenderingNull/NullVertexDescription.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] pElements     Vertex elements.
+/// @param[in] elementCount  Number of vertex elements.
+NullVertexDescription::NullVertexDescription( const Element* pElements, size_t elementCount )
+{
+	HELIUM_ASSERT( pElements || elementCount == 0 );
+
+	m_elements.AddArray( pElements, elementCount );
+}
+
+/// Destructor.
+NullVertexDescription::~NullVertexDescription()
+{
+}
+
+/// Constructor.
+///
+/// @param[in] pDescription  Vertex description for which the layout is being created.
+NullVertexInputLayout::NullVertexInputLayout( RVertexDescription* pDescription )
+: m_spDescription( pDescription )
+{
+	HELIUM_ASSERT( pDescription );
+}
+
+/// Destructor.
+NullVertexInputLayout::~NullVertexInputLayout()
+{
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+#include "Rendering/RVertexDescription.h"
+#include "Rendering/RVertexInputLayout.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	HELIUM_DECLARE_RPTR( RVertexDescription );
+
+	/// Null renderer vertex description.
+	class NullVertexDescription : public RVertexDescription
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		NullVertexDescription( const Element* pElements, size_t elementCount );
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline const Element* GetElements() const;
+		inline size_t GetElementCount() const;
+		//@}
+
+	private:
+		/// Vertex elements.
+		DynamicArray< Element > m_elements;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullVertexDescription();
+		//@}
+	};
+
+	/// Null renderer vertex input layout.
+	class NullVertexInputLayout : public RVertexInputLayout
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		explicit NullVertexInputLayout( RVertexDescription* pDescription );
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline RVertexDescription* GetDescription() const;
+		//@}
+
+	private:
+		/// Vertex description for which this layout was created.
+		RVertexDescriptionPtr m_spDescription;
+
+		/// @name Construction/Destruction
+		//@{
+		~NullVertexInputLayout();
+		//@}
+	};
+}
+
+#include "RenderingNull/NullVertexDescription.inl"
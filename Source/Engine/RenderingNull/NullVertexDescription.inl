@@ -0,0 +1,30 @@
+namespace Helium
+{
+	/// Get the vertex elements in this description.
+	///
+	/// @return  Vertex elements.
+	///
+	/// @see GetElementCount()
+	const RVertexDescription::Element* NullVertexDescription::GetElements() const
+	{
+		return m_elements.GetData();
+	}
+
+	/// Get the number of vertex elements in this description.
+	///
+	/// @return  Vertex element count.
+	///
+	/// @see GetElements()
+	size_t NullVertexDescription::GetElementCount() const
+	{
+		return m_elements.GetSize();
+	}
+
+	/// Get the vertex description for which this layout was created.
+	///
+	/// @return  Vertex description.
+	RVertexDescription* NullVertexInputLayout::GetDescription() const
+	{
+		return m_spDescription;
+	}
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "RenderingNull/RenderingNull.h"
+
+#include "Platform/Assert.h"
+#include "Platform/Trace.h"
+#include "Platform/MemoryHeap.h"
+#include "Engine/Asset.h"
+#include "RenderingNull/NullRenderer.h"
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Platform/System.h"
+
+#if HELIUM_SHARED
+    #ifdef HELIUM_RENDERING_NULL_EXPORTS
+        #define HELIUM_RENDERING_NULL_API HELIUM_API_EXPORT
+    #else
+        #define HELIUM_RENDERING_NULL_API HELIUM_API_IMPORT
+    #endif
+#else
+    #define HELIUM_RENDERING_NULL_API
+#endif
@@ -78,6 +78,7 @@ struct HELIUM_WINDOWING_API WindowManagerUpdateTask : public TaskDefinition
 	virtual void DefineContract(TaskContract &rContract)
 	{
 		rContract.ExecuteAfter< Helium::StandardDependencies::Render >();
+		rContract.ExecuteOnMainThread();
 	}
 };
 
@@ -33,6 +33,11 @@ project( prefix .. "Engine" )
 		"Source/Engine/Engine/*",
 	}
 
+	excludes
+	{
+		"Source/Engine/Engine/*Tests.*",
+	}
+
 	configuration "SharedLib"
 		links
 		{
@@ -46,6 +51,30 @@ project( prefix .. "Engine" )
 			prefix .. "Platform",
 		}
 
+	configuration {}
+
+project( prefix .. "EngineTests" )
+
+	Helium.DoTestsProjectSettings()
+
+	files
+	{
+		"Source/Engine/Engine/*Tests.*",
+	}
+
+	links
+	{
+		prefix .. "Engine",
+		prefix .. "MathSimd",
+
+		-- core
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
 project( prefix .. "EngineJobs" )
 
 	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "EngineJobs", "ENGINE_JOBS" )
@@ -203,6 +232,64 @@ project( prefix .. "RenderingGL" )
 
 end
 
+project( prefix .. "RenderingNull" )
+
+	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "RenderingNull", "RENDERING_NULL" )
+	Helium.DoGraphicsProjectSettings()
+
+	files
+	{
+		"Source/Engine/RenderingNull/*",
+	}
+
+	excludes
+	{
+		"Source/Engine/RenderingNull/*Tests.*",
+	}
+
+	configuration "SharedLib"
+		links
+		{
+			prefix .. "Engine",
+			prefix .. "EngineJobs",
+			prefix .. "Rendering",
+			prefix .. "MathSimd",
+
+			-- core
+			prefix .. "Math",
+			prefix .. "Persist",
+			prefix .. "Reflect",
+			prefix .. "Foundation",
+			prefix .. "Platform",
+		}
+
+	configuration {}
+
+project( prefix .. "RenderingNullTests" )
+
+	Helium.DoTestsProjectSettings()
+
+	files
+	{
+		"Source/Engine/RenderingNull/*Tests.*",
+	}
+
+	links
+	{
+		prefix .. "RenderingNull",
+		prefix .. "Rendering",
+		prefix .. "Engine",
+		prefix .. "EngineJobs",
+		prefix .. "MathSimd",
+
+		-- core
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
 project( prefix .. "GraphicsTypes" )
 
 	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "GraphicsTypes", "GRAPHICS_TYPES" )
@@ -266,6 +353,11 @@ project( prefix .. "Graphics" )
 		"Source/Engine/Graphics/*",
 	}
 
+	excludes
+	{
+		"Source/Engine/Graphics/*Tests.*",
+	}
+
 	configuration "SharedLib"
 		links
 		{
@@ -285,6 +377,37 @@ project( prefix .. "Graphics" )
 			prefix .. "Platform",
 		}
 
+	configuration {}
+
+project( prefix .. "GraphicsTests" )
+
+	Helium.DoTestsProjectSettings()
+
+	files
+	{
+		"Source/Engine/Graphics/*Tests.*",
+	}
+
+	links
+	{
+		prefix .. "Graphics",
+		prefix .. "RenderingNull",
+		prefix .. "Engine",
+		prefix .. "Framework",
+		prefix .. "EngineJobs",
+		prefix .. "Rendering",
+		prefix .. "GraphicsTypes",
+		prefix .. "GraphicsJobs",
+		prefix .. "MathSimd",
+
+		-- core
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
 project( prefix .. "Components" )
 
 	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "Components", "COMPONENTS" )
@@ -396,6 +519,11 @@ project( prefix .. "Framework" )
 		"Source/Engine/Framework/*",
 	}
 
+	excludes
+	{
+		"Source/Engine/Framework/*Tests.*",
+	}
+
 	configuration "SharedLib"
 		links
 		{
@@ -411,6 +539,32 @@ project( prefix .. "Framework" )
 			prefix .. "Platform",
 		}
 
+	configuration {}
+
+project( prefix .. "FrameworkTests" )
+
+	Helium.DoTestsProjectSettings()
+
+	files
+	{
+		"Source/Engine/Framework/*Tests.*",
+	}
+
+	links
+	{
+		prefix .. "Framework",
+		prefix .. "Engine",
+		prefix .. "EngineJobs",
+		prefix .. "MathSimd",
+
+		-- core
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
 project( prefix .. "FrameworkImpl" )
 
 	Helium.DoModuleProjectSettings( "Source/Engine", "HELIUM", "FrameworkImpl", "FRAMEWORK_IMPL" )
@@ -489,6 +643,7 @@ project( prefix .. "FrameworkImpl" )
 			prefix .. "EngineJobs",
 			prefix .. "Windowing",
 			prefix .. "Rendering",
+			prefix .. "RenderingNull",
 			prefix .. "GraphicsTypes",
 			prefix .. "GraphicsJobs",
 			prefix .. "Graphics",
@@ -555,6 +710,7 @@ project( prefix .. "GameLibrary" )
 			prefix .. "EngineJobs",
 			prefix .. "Windowing",
 			prefix .. "Rendering",
+			prefix .. "RenderingNull",
 			prefix .. "GraphicsTypes",
 			prefix .. "GraphicsJobs",
 			prefix .. "Graphics",
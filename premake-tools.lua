@@ -241,6 +241,7 @@ project( prefix .. "Editor" )
 		prefix .. "Graphics",
 		prefix .. "GraphicsJobs",
 		prefix .. "GraphicsTypes",
+		prefix .. "RenderingNull",
 		prefix .. "Rendering",
 		prefix .. "Windowing",
 		prefix .. "EngineJobs",
@@ -111,6 +111,13 @@ Helium.DoBasicProjectSettings = function()
 		}
 	end
 
+	if _OPTIONS[ "component-index-32" ] then
+		defines
+		{
+			"HELIUM_COMPONENT_INDEX_32=1",
+		}
+	end
+
 	if tools then
 		defines
 		{
@@ -394,6 +401,7 @@ Helium.DoGameProjectSettings = function( name )
 		prefix .. "Graphics",
 		prefix .. "GraphicsJobs",
 		prefix .. "GraphicsTypes",
+		prefix .. "RenderingNull",
 		prefix .. "Rendering",
 		prefix .. "Windowing",
 		prefix .. "EngineJobs",
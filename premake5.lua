@@ -51,6 +51,12 @@ if not _OPTIONS[ "pch" ] then
 	end
 end
 
+newoption
+{
+	trigger = "component-index-32",
+	description = "Use 32-bit component indices (allows more than 65,535 components of a type per world)",
+}
+
 newoption
 {
 	trigger	= "gfxapi",